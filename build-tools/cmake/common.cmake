@@ -31,3 +31,16 @@ if("${CMAKE_TOOLCHAIN_FILE}" STREQUAL "")
 else()
   include(${CMAKE_TOOLCHAIN_FILE})
 endif()
+
+#-------------------------------------------------------------------------------
+# Functions to build.
+#-------------------------------------------------------------------------------
+
+# config.h written by build-tools/code-generator/generate_config.py replaces
+# include/nnablart/config.h, so only functions used by a model are built.
+set(NNABLART_CONFIG_H "" CACHE FILEPATH "config.h which selects functions")
+if(NOT "${NNABLART_CONFIG_H}" STREQUAL "")
+  configure_file(${NNABLART_CONFIG_H}
+    ${CMAKE_BINARY_DIR}/config/nnablart/config.h COPYONLY)
+  include_directories(BEFORE ${CMAKE_BINARY_DIR}/config)
+endif()
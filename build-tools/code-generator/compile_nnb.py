@@ -0,0 +1,655 @@
+# Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+'''
+Compile one NNB into standalone C source.
+
+    python3 compile_nnb.py model.nnb model
+
+writes model.c and model.h. Functions are called in order of NNB with
+shapes, strides and loop bounds written as constants, variables are placed
+in one static array, and parameters are const arrays. Generated source needs
+only libm, and does no allocation or dispatch at run time.
+
+Float variables with dense parameters are supported, and functions listed
+in EMITTERS. Others are reported and nothing is written.
+'''
+
+from os.path import abspath, basename, dirname, join, splitext
+import argparse
+import math
+import re
+import struct
+import sys
+import yaml
+
+NETWORK_HEADER = struct.Struct('<II2i2i2i2i2iII')
+VARIABLE = struct.Struct('<I2iIi')
+FUNCTION_COMMON_SIZE = 20
+DATA_TYPE_FLOAT = 0
+DATA_LAYOUT_DENSE = 0
+ALIGNMENT = 4  # In float, 16 bytes.
+
+
+class CompileError(Exception):
+    pass
+
+
+def load_function_info():
+    with open(join(dirname(abspath(__file__)), 'functions.yaml'), 'r') as f:
+        info = yaml.safe_load(f)
+    functions = {}
+    for cat in info.values():
+        for name, func in cat.items():
+            functions[func['id']] = (name, func)
+    return functions
+
+
+class Network:
+    '''Reader of NNB following nn_network_t in network.h.'''
+
+    def __init__(self, data, function_info):
+        self.data = data
+        h = NETWORK_HEADER.unpack_from(data, 0)
+        self.version = h[0]
+        num_of_data = h[12]
+        self.index = struct.unpack_from(
+            '<{}i'.format(num_of_data), data, NETWORK_HEADER.size)
+        self.base = NETWORK_HEADER.size + 4 * num_of_data
+        self.buffers = self.read_list(h[2], h[3])
+        self.variables = [self.read_variable(i)
+                          for i in self.read_list(h[4], h[5])]
+        self.functions = [self.read_function(i, function_info)
+                          for i in self.read_list(h[6], h[7])]
+        self.inputs = self.read_list(h[8], h[9])
+        self.outputs = self.read_list(h[10], h[11])
+
+    def offset(self, index):
+        return self.base + self.index[index]
+
+    def read_list(self, size, index):
+        if size == 0:
+            return []
+        return list(struct.unpack_from(
+            '<{}i'.format(size), self.data, self.offset(index)))
+
+    def read_variable(self, index):
+        vid, shape_size, shape_index, bits, data_index = VARIABLE.unpack_from(
+            self.data, self.offset(index))
+        v = {'id': vid,
+             'shape': self.read_list(shape_size, shape_index),
+             'type': bits & 0xf,
+             'layout': (bits >> 8) & 0xf,
+             'data_index': data_index}
+        v['size'] = 1
+        for d in v['shape']:
+            v['size'] *= d
+        return v
+
+    def read_function(self, index, function_info):
+        position = self.offset(index)
+        common = struct.unpack_from('<I4i', self.data, position)
+        fid = common[0] & 0xffff
+        name, func = function_info.get(fid, ('Unknown{}'.format(fid), None))
+        f = {'name': name, 'inputs': self.read_list(common[1], common[2]),
+             'outputs': self.read_list(common[3], common[4]),
+             'current': func is not None and func['id'] == fid}
+        if not f['current']:
+            return f
+        # Members follow C layout of nn_function_*_t.
+        offset = FUNCTION_COMMON_SIZE
+        for an, arg in (func.get('arguments') or {}).items():
+            t = arg['type']
+            if t == 'bool':
+                f[an] = self.data[position + offset] != 0
+                offset += 1
+                continue
+            offset = (offset + 3) & ~3
+            if t in ('double', 'float'):
+                f[an] = struct.unpack_from(
+                    '<f', self.data, position + offset)[0]
+                offset += 4
+            elif t == 'int64':
+                f[an] = struct.unpack_from(
+                    '<i', self.data, position + offset)[0]
+                offset += 4
+            elif t in ('repeated int64', 'Shape'):
+                size, list_index = struct.unpack_from(
+                    '<2i', self.data, position + offset)
+                f[an] = self.read_list(size, list_index)
+                offset += 8
+            else:
+                offset += 4
+        return f
+
+    def parameter(self, v):
+        p = self.offset(v['data_index'])
+        return struct.unpack_from('<{}f'.format(v['size']), self.data, p)
+
+
+def product(values):
+    p = 1
+    for v in values:
+        p *= v
+    return p
+
+
+class Compiler:
+    def __init__(self, network, name, source_name):
+        self.n = network
+        self.name = name
+        self.source_name = source_name
+        self.offsets = {}
+        self.arena_size = 0
+
+    def variable(self, vid):
+        return self.n.variables[vid]
+
+    def check(self):
+        errors = []
+        for i, f in enumerate(self.n.functions):
+            if not f['current'] or f['name'] not in EMITTERS:
+                errors.append('{}: {} is not supported'.format(i, f['name']))
+                continue
+            for vid in f['inputs'] + f['outputs']:
+                v = self.variable(vid)
+                if v['type'] != DATA_TYPE_FLOAT or (
+                        v['data_index'] >= 0 and
+                        v['layout'] != DATA_LAYOUT_DENSE):
+                    errors.append('{}: {} has variable {} which is not '
+                                  'dense float'.format(i, f['name'], vid))
+        if errors:
+            raise CompileError('\n'.join(errors))
+
+    def plan(self):
+        '''Place buffer variables as runtime does, by lifetime and size.'''
+        last = len(self.n.functions)
+        lifetime = {}
+        for i, f in enumerate(self.n.functions):
+            for vid in f['inputs'] + f['outputs']:
+                if self.variable(vid)['data_index'] < 0:
+                    first, end = lifetime.get(vid, (i, i))
+                    lifetime[vid] = (min(first, i), max(end, i))
+        for vid in self.n.inputs + self.n.outputs:
+            lifetime[vid] = (0, last)
+        order = sorted(lifetime, key=lambda v: (
+            -self.variable(v)['size'], v))
+        placed = []
+        for vid in order:
+            size = (self.variable(vid)['size'] + ALIGNMENT - 1) & \
+                ~(ALIGNMENT - 1)
+            first, end = lifetime[vid]
+            offset = 0
+            for p_offset, p_size, p_first, p_end in sorted(placed):
+                if p_first > end or first > p_end:
+                    continue
+                if p_offset >= offset + size:
+                    break
+                offset = max(offset, p_offset + p_size)
+            placed.append((offset, size, first, end))
+            self.offsets[vid] = offset
+            self.arena_size = max(self.arena_size, offset + size)
+
+    def pointer(self, vid):
+        v = self.variable(vid)
+        if v['data_index'] >= 0:
+            return '{}_variable_{}'.format(self.name, vid)
+        return '({}_arena + {})'.format(self.name, self.offsets[vid])
+
+    def parameters(self):
+        l = []
+        used = set()
+        for f in self.n.functions:
+            used.update(v for v in f['inputs']
+                        if self.variable(v)['data_index'] >= 0)
+        for vid in sorted(used):
+            v = self.variable(vid)
+            values = [format_float(x) for x in self.n.parameter(v)]
+            l.append('static const float {}_variable_{}[{}] = {{'.format(
+                self.name, vid, v['size']))
+            for i in range(0, len(values), 6):
+                l.append('    ' + ', '.join(values[i:i + 6]) + ',')
+            l.append('};')
+            l.append('')
+        return l
+
+    def source(self, header):
+        l = [GENERATED.format(self.source_name)]
+        l.append('#include "{}"'.format(header))
+        l.append('')
+        l.append('#include <math.h>')
+        l.append('#include <string.h>')
+        l.append('')
+        l += self.parameters()
+        l.append('static float {}_arena[{}];'.format(
+            self.name, max(self.arena_size, 1)))
+        l.append('')
+        for i, f in enumerate(self.n.functions):
+            body = EMITTERS[f['name']](self, f)
+            l.append('// {}: {}'.format(i, f['name']))
+            l.append('static void {}_function_{}(void) {{'.format(
+                self.name, i))
+            l += ['  ' + line if line else '' for line in body]
+            l.append('}')
+            l.append('')
+        for kind, ids in (('input', self.n.inputs), ('output', self.n.outputs)):
+            l.append('float *{}_{}_buffer(int index) {{'.format(
+                self.name, kind))
+            l.append('  switch (index) {')
+            for i, vid in enumerate(ids):
+                l.append('  case {}:'.format(i))
+                l.append('    return {};'.format(self.pointer(vid)))
+            l.append('  default:')
+            l.append('    return 0;')
+            l.append('  }')
+            l.append('}')
+            l.append('')
+        l.append('void {}_forward(void) {{'.format(self.name))
+        for i in range(len(self.n.functions)):
+            l.append('  {}_function_{}();'.format(self.name, i))
+        l.append('}')
+        return '\n'.join(l) + '\n'
+
+    def header(self):
+        guard = 'H_{}_H_'.format(self.name.upper())
+        upper = self.name.upper()
+        l = [GENERATED.format(self.source_name)]
+        l.append('#ifndef {}'.format(guard))
+        l.append('#define {}'.format(guard))
+        l.append('')
+        l.append('#ifdef __cplusplus')
+        l.append('extern "C" {')
+        l.append('#endif /* __cplusplus */')
+        l.append('')
+        l.append('#define {}_NUM_OF_INPUTS ({})'.format(
+            upper, len(self.n.inputs)))
+        for i, vid in enumerate(self.n.inputs):
+            l.append('#define {}_INPUT_{}_SIZE ({})'.format(
+                upper, i, self.variable(vid)['size']))
+        l.append('#define {}_NUM_OF_OUTPUTS ({})'.format(
+            upper, len(self.n.outputs)))
+        for i, vid in enumerate(self.n.outputs):
+            l.append('#define {}_OUTPUT_{}_SIZE ({})'.format(
+                upper, i, self.variable(vid)['size']))
+        l.append('')
+        l.append('/// @brief Input at index, or NULL.')
+        l.append('float *{}_input_buffer(int index);'.format(self.name))
+        l.append('')
+        l.append('/// @brief Output at index, or NULL.')
+        l.append('float *{}_output_buffer(int index);'.format(self.name))
+        l.append('')
+        l.append('/// @brief Calculate outputs from inputs.')
+        l.append('void {}_forward(void);'.format(self.name))
+        l.append('')
+        l.append('#ifdef __cplusplus')
+        l.append('}')
+        l.append('#endif /* __cplusplus */')
+        l.append('')
+        l.append('#endif // {}'.format(guard))
+        return '\n'.join(l) + '\n'
+
+
+GENERATED = '''// *WARNING*
+// THIS FILE IS AUTO-GENERATED BY compile_nnb.py FROM {}.
+'''
+
+
+def format_float(x):
+    if math.isnan(x):
+        return 'NAN'
+    if math.isinf(x):
+        return 'INFINITY' if x > 0 else '-INFINITY'
+    s = '{:.9g}'.format(x)
+    if 'e' not in s and '.' not in s:
+        s += '.0'
+    return s + 'f'
+
+
+def io(c, f):
+    '''Declarations of pointers to inputs and outputs of function.'''
+    l = []
+    for i, vid in enumerate(f['inputs']):
+        l.append('const float *x{} = {};'.format(i, c.pointer(vid)))
+    for i, vid in enumerate(f['outputs']):
+        l.append('float *y{} = {};'.format(i, c.pointer(vid)))
+    return l
+
+
+def unary(expression):
+    def emit(c, f):
+        size = c.variable(f['outputs'][0])['size']
+        return io(c, f) + [
+            'for (int i = 0; i < {}; i++) {{'.format(size),
+            '  const float x = x0[i];',
+            '  y0[i] = {};'.format(expression(f)),
+            '}']
+    return emit
+
+
+def binary(operator):
+    def emit(c, f):
+        a, b = (c.variable(v) for v in f['inputs'][:2])
+        if a['shape'] != b['shape']:
+            raise CompileError('{} with broadcast is not supported'.format(
+                f['name']))
+        return io(c, f) + [
+            'for (int i = 0; i < {}; i++) {{'.format(a['size']),
+            '  y0[i] = {};'.format(operator),
+            '}']
+    return emit
+
+
+def emit_copy(c, f):
+    x, y = f['inputs'][0], f['outputs'][0]
+    if c.variable(x)['data_index'] < 0 and \
+            c.variable(y)['data_index'] < 0 and \
+            c.offsets[x] == c.offsets[y]:
+        return ['// Output is placed on input.']
+    return io(c, f) + ['memcpy(y0, x0, sizeof(float) * {});'.format(
+        c.variable(y)['size'])]
+
+
+def emit_affine(c, f):
+    x = c.variable(f['inputs'][0])
+    base_axis = f['base_axis']
+    rows = product(x['shape'][:base_axis])
+    inner = product(x['shape'][base_axis:])
+    outer = c.variable(f['outputs'][0])['size'] // rows
+    # Weight is stored transposed in NNB, one row for each output.
+    l = io(c, f)
+    l.append('for (int m = 0; m < {}; m++) {{'.format(rows))
+    l.append('  const float *x = x0 + m * {};'.format(inner))
+    l.append('  for (int n = 0; n < {}; n++) {{'.format(outer))
+    l.append('    const float *w = x1 + n * {};'.format(inner))
+    l.append('    float acc = 0.0f;')
+    l.append('    for (int k = 0; k < {}; k++) {{'.format(inner))
+    l.append('      acc += x[k] * w[k];')
+    l.append('    }')
+    l.append('    y0[m * {} + n] = {};'.format(
+        outer, 'acc + x2[n]' if len(f['inputs']) > 2 else 'acc'))
+    l.append('  }')
+    l.append('}')
+    return l
+
+
+def spatial(c, f, dims):
+    '''Batch, channel and 2D spatial sizes, 1D being height of 1.'''
+    x = c.variable(f['inputs'][0])['shape']
+    y = c.variable(f['outputs'][0])['shape']
+    if dims == 1:
+        return x[:-1] + [1, x[-1]], y[:-1] + [1, y[-1]]
+    return x, y
+
+
+def in_range(out_size, in_size, stride, offset):
+    '''Outputs o for which 0 <= o * stride + offset < in_size.'''
+    begin = 0
+    while begin < out_size and begin * stride + offset < 0:
+        begin += 1
+    end = begin
+    while end < out_size and end * stride + offset < in_size:
+        end += 1
+    return begin, end
+
+
+def emit_convolution(c, f):
+    dims = len(f['pad'])
+    base_axis = f['base_axis']
+    x_shape = c.variable(f['inputs'][0])['shape']
+    if f['channel_last'] or dims not in (1, 2) or \
+            len(x_shape) != base_axis + 1 + dims:
+        raise CompileError('Convolution must be 1D or 2D channel first')
+    pad = ([0] if dims == 1 else []) + f['pad']
+    stride = ([1] if dims == 1 else []) + f['stride']
+    dilation = ([1] if dims == 1 else []) + f['dilation']
+    batch = product(x_shape[:base_axis])
+    channels = x_shape[base_axis]
+    x, y = spatial(c, f, dims)
+    h, w = x[-2:]
+    oh, ow = y[-2:]
+    outputs = y[base_axis]
+    group = f['group']
+    kh, kw = c.variable(f['inputs'][1])['shape'][-2:] if dims == 2 else \
+        (1, c.variable(f['inputs'][1])['shape'][-1])
+    group_in = channels // group
+    group_out = outputs // group
+    rows = [in_range(oh, h, stride[0], k * dilation[0] - pad[0])
+            for k in range(kh)]
+    cols = [in_range(ow, w, stride[1], k * dilation[1] - pad[1])
+            for k in range(kw)]
+    l = io(c, f)
+    l.append('static const int row_begin[{0}] = {{{1}}};'.format(
+        kh, ', '.join(str(r[0]) for r in rows)))
+    l.append('static const int row_end[{0}] = {{{1}}};'.format(
+        kh, ', '.join(str(r[1]) for r in rows)))
+    l.append('static const int column_begin[{0}] = {{{1}}};'.format(
+        kw, ', '.join(str(r[0]) for r in cols)))
+    l.append('static const int column_end[{0}] = {{{1}}};'.format(
+        kw, ', '.join(str(r[1]) for r in cols)))
+    l.append('for (int b = 0; b < {}; b++) {{'.format(batch))
+    l.append('  for (int o = 0; o < {}; o++) {{'.format(outputs))
+    l.append('    float *y = y0 + (b * {} + o) * {};'.format(
+        outputs, oh * ow))
+    l.append('    for (int i = 0; i < {}; i++) {{'.format(oh * ow))
+    l.append('      y[i] = {};'.format(
+        'x2[o]' if len(f['inputs']) > 2 else '0.0f'))
+    l.append('    }')
+    l.append('    for (int ci = 0; ci < {}; ci++) {{'.format(group_in))
+    l.append('      const float *x = x0 + (b * {} + o / {} * {} + ci) * {};'
+             .format(channels, group_out, group_in, h * w))
+    l.append('      const float *k = x1 + (o * {} + ci) * {};'.format(
+        group_in, kh * kw))
+    l.append('      for (int ky = 0; ky < {}; ky++) {{'.format(kh))
+    l.append('        for (int kx = 0; kx < {}; kx++) {{'.format(kw))
+    l.append('          const float a = k[ky * {} + kx];'.format(kw))
+    l.append('          for (int oy = row_begin[ky]; oy < row_end[ky]; oy++) {')
+    l.append('            const float *xr = x + (oy * {} + ky * {} - {}) * {} +'
+             .format(stride[0], dilation[0], pad[0], w))
+    l.append('                              kx * {} - {};'.format(
+        dilation[1], pad[1]))
+    l.append('            float *yr = y + oy * {};'.format(ow))
+    l.append('            for (int ox = column_begin[kx]; ox < column_end[kx]; '
+             'ox++) {')
+    l.append('              yr[ox] += a * xr[ox * {}];'.format(stride[1]))
+    l.append('            }')
+    l.append('          }')
+    l.append('        }')
+    l.append('      }')
+    l.append('    }')
+    l.append('  }')
+    l.append('}')
+    return l
+
+
+def pooling(operator):
+    def emit(c, f):
+        if f['channel_last'] or len(f['kernel']) != 2:
+            raise CompileError('{} must be 2D channel first'.format(
+                f['name']))
+        x = c.variable(f['inputs'][0])['shape']
+        y = c.variable(f['outputs'][0])['shape']
+        h, w = x[-2:]
+        oh, ow = y[-2:]
+        kh, kw = f['kernel']
+        sh, sw = f['stride']
+        ph, pw = f['pad']
+        planes = product(x[:-2])
+        l = io(c, f)
+        l.append('for (int p = 0; p < {}; p++) {{'.format(planes))
+        l.append('  const float *x = x0 + p * {};'.format(h * w))
+        l.append('  float *y = y0 + p * {};'.format(oh * ow))
+        l.append('  for (int oy = 0; oy < {}; oy++) {{'.format(oh))
+        l.append('    int hstart = oy * {} - {};'.format(sh, ph))
+        l.append('    int hend = hstart + {0} < {1} ? hstart + {0} : {1};'
+                 .format(kh, h + ph))
+        l.append('    for (int ox = 0; ox < {}; ox++) {{'.format(ow))
+        l.append('      int wstart = ox * {} - {};'.format(sw, pw))
+        l.append('      int wend = wstart + {0} < {1} ? wstart + {0} : {1};'
+                 .format(kw, w + pw))
+        l.append('      float pool_size = (float)((hend - hstart) * '
+                 '(wend - wstart));')
+        l.append('      int y0s = hstart > 0 ? hstart : 0;')
+        l.append('      int x0s = wstart > 0 ? wstart : 0;')
+        l.append('      int y1s = hend < {0} ? hend : {0};'.format(h))
+        l.append('      int x1s = wend < {0} ? wend : {0};'.format(w))
+        if operator == 'max':
+            l.append('      float acc = x[y0s * {} + x0s];'.format(w))
+        else:
+            l.append('      float acc = 0.0f;')
+        l.append('      for (int iy = y0s; iy < y1s; iy++) {')
+        l.append('        for (int ix = x0s; ix < x1s; ix++) {')
+        l.append('          const float v = x[iy * {} + ix];'.format(w))
+        if operator == 'max':
+            l.append('          acc = v > acc ? v : acc;')
+        else:
+            l.append('          acc += v;')
+        l.append('        }')
+        l.append('      }')
+        if operator == 'average':
+            if not f['including_pad']:
+                l.append('      pool_size = (float)((y1s - y0s) * '
+                         '(x1s - x0s));')
+            l.append('      acc /= pool_size;')
+        else:
+            l.append('      (void)pool_size;')
+        l.append('      y[oy * {} + ox] = acc;'.format(ow))
+        l.append('    }')
+        l.append('  }')
+        l.append('}')
+        return l
+    return emit
+
+
+def emit_global_average_pooling(c, f):
+    x = c.variable(f['inputs'][0])['shape']
+    planes = product(x[:2])
+    size = product(x[2:])
+    return io(c, f) + [
+        'for (int p = 0; p < {}; p++) {{'.format(planes),
+        '  float acc = 0.0f;',
+        '  for (int i = 0; i < {}; i++) {{'.format(size),
+        '    acc += x0[p * {} + i];'.format(size),
+        '  }',
+        '  y0[p] = acc / {};'.format(format_float(float(size))),
+        '}']
+
+
+def emit_softmax(c, f):
+    x = c.variable(f['inputs'][0])['shape']
+    axis = f['axis']
+    outer = product(x[:axis])
+    size = x[axis]
+    inner = product(x[axis + 1:])
+    return io(c, f) + [
+        'for (int o = 0; o < {}; o++) {{'.format(outer),
+        '  for (int j = 0; j < {}; j++) {{'.format(inner),
+        '    const float *x = x0 + o * {} + j;'.format(size * inner),
+        '    float *y = y0 + o * {} + j;'.format(size * inner),
+        '    float max = x[0];',
+        '    float sum = 0.0f;',
+        '    for (int i = 1; i < {}; i++) {{'.format(size),
+        '      max = x[i * {0}] > max ? x[i * {0}] : max;'.format(inner),
+        '    }',
+        '    for (int i = 0; i < {}; i++) {{'.format(size),
+        '      y[i * {0}] = expf(x[i * {0}] - max);'.format(inner),
+        '      sum += y[i * {}];'.format(inner),
+        '    }',
+        '    for (int i = 0; i < {}; i++) {{'.format(size),
+        '      y[i * {}] /= sum;'.format(inner),
+        '    }',
+        '  }',
+        '}']
+
+
+def emit_batch_normalization(c, f):
+    if f['batch_stat'] or len(f['axes']) != 1:
+        raise CompileError('BatchNormalization must use stored statistics '
+                           'on one axis')
+    x = c.variable(f['inputs'][0])['shape']
+    axis = f['axes'][0]
+    outer = product(x[:axis])
+    channels = x[axis]
+    inner = product(x[axis + 1:])
+    return io(c, f) + [
+        'for (int o = 0; o < {}; o++) {{'.format(outer),
+        '  for (int ch = 0; ch < {}; ch++) {{'.format(channels),
+        '    const float stdvar = sqrtf(x4[ch] + {});'.format(
+            format_float(f['eps'])),
+        '    const float *x = x0 + (o * {} + ch) * {};'.format(
+            channels, inner),
+        '    float *y = y0 + (o * {} + ch) * {};'.format(channels, inner),
+        '    for (int i = 0; i < {}; i++) {{'.format(inner),
+        '      y[i] = (x[i] - x3[ch]) / stdvar * x2[ch] + x1[ch];',
+        '    }',
+        '  }',
+        '}']
+
+
+EMITTERS = {
+    'Affine': emit_affine,
+    'Convolution': emit_convolution,
+    'MaxPooling': pooling('max'),
+    'AveragePooling': pooling('average'),
+    'SumPooling': pooling('sum'),
+    'GlobalAveragePooling': emit_global_average_pooling,
+    'ReLU': unary(lambda f: 'x > 0.0f ? x : 0.0f'),
+    'LeakyReLU': unary(lambda f: 'x > 0.0f ? x : {} * x'.format(
+        format_float(f['alpha']))),
+    'ELU': unary(lambda f: 'x >= 0.0f ? x : {} * (expf(x) - 1.0f)'.format(
+        format_float(f['alpha']))),
+    'Sigmoid': unary(lambda f: '1.0f / (1.0f + expf(-x))'),
+    'Tanh': unary(lambda f: 'tanhf(x)'),
+    'Add2': binary('x0[i] + x1[i]'),
+    'Sub2': binary('x0[i] - x1[i]'),
+    'Mul2': binary('x0[i] * x1[i]'),
+    'Div2': binary('x0[i] / x1[i]'),
+    'Softmax': emit_softmax,
+    'BatchNormalization': emit_batch_normalization,
+    'Reshape': emit_copy,
+    'Identity': emit_copy,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compile NNB into standalone C source.')
+    parser.add_argument('nnb', help='NNB file')
+    parser.add_argument('output', help='Output path without extension, '
+                        'OUTPUT.c and OUTPUT.h are written')
+    parser.add_argument('-n', '--name', help='Prefix of generated symbols, '
+                        'base name of output by default')
+    args = parser.parse_args()
+
+    name = args.name or re.sub(r'\W', '_', basename(args.output))
+    with open(args.nnb, 'rb') as f:
+        network = Network(f.read(), load_function_info())
+    compiler = Compiler(network, name, basename(args.nnb))
+    try:
+        compiler.check()
+        compiler.plan()
+        header = basename(args.output) + '.h'
+        source = compiler.source(header)
+    except CompileError as e:
+        print('Cannot compile {}:\n{}'.format(args.nnb, e), file=sys.stderr)
+        return 1
+    with open(args.output + '.h', 'w', encoding='utf-8') as f:
+        f.write(compiler.header())
+    with open(args.output + '.c', 'w', encoding='utf-8') as f:
+        f.write(source)
+    print('Generated [{}.c] and [{}.h].'.format(args.output, args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,170 @@
+# Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+'''
+Write config.h enabling only functions used by given NNB files.
+
+    python3 generate_config.py model.nnb [model2.nnb ...] -o config.h
+
+A function gets its FLOAT32 variant when all of its inputs and outputs are
+float, and GENERIC variant otherwise, which is the rule functions use to
+select their implementation. Kernel sizes and strides of float 2D
+Convolution, DepthwiseConvolution and pooling are listed as shapes of
+specialized kernels, see src/functions/utilities/specialized.h. Give the
+result to cmake with -DNNABLART_CONFIG_H=config.h.
+'''
+
+from os.path import abspath, dirname, join
+import argparse
+import sys
+import yaml
+
+from compile_nnb import DATA_TYPE_FLOAT, Network
+
+HEADER = '''\
+// Copyright (c) 2017 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *WARNING*
+// THIS FILE IS AUTO-GENERATED BY generate_config.py FROM
+'''
+
+
+def load_function_info():
+    '''Map every function id, including older versions, to its function.'''
+    with open(join(dirname(abspath(__file__)), 'functions.yaml'), 'r') as f:
+        info = yaml.safe_load(f)
+    functions = {}
+    for cat in info.values():
+        for name, func in cat.items():
+            for fid in func['function_ids'].values():
+                functions[fid] = (name, func)
+    return functions
+
+
+POOLING = ('MaxPooling', 'AveragePooling', 'SumPooling')
+
+
+def square_2d(kernel, stride, dilation=(1, 1)):
+    '''(kernel, stride) of square 2D window with same stride, or None.'''
+    if len(kernel) != 2 or kernel[0] != kernel[1] or len(stride) != 2 or \
+            stride[0] != stride[1] or list(dilation) != [1, 1]:
+        return None
+    return kernel[0], stride[0]
+
+
+def specialized_shape(network, f):
+    '''Name of specialized kernel list and its entry for float function f.'''
+    if not f['current']:
+        # Arguments are not read from older versions.
+        return None, None
+    if f['name'] == 'Convolution' and not f['channel_last']:
+        weight = network.variables[f['inputs'][1]]['shape']
+        shape = square_2d(weight[2:], f['stride'], f['dilation'])
+        if shape is None:
+            return None, None
+        maps = weight[0] // f['group']
+        block = next(b for b in (4, 2, 1) if maps % b == 0)
+        return 'CONVOLUTION', shape + (block,)
+    if f['name'] == 'DepthwiseConvolution':
+        weight = network.variables[f['inputs'][1]]['shape']
+        return 'DEPTHWISE_CONVOLUTION', square_2d(weight[1:], f['stride'],
+                                                  f['dilation'])
+    if f['name'] in POOLING and not f['channel_last']:
+        return 'POOLING', square_2d(f['kernel'], f['stride'] or f['kernel'])
+    return None, None
+
+
+def used_configs(network, function_info, errors, shapes):
+    configs = set()
+    for f in network.functions:
+        if f['name'].startswith('Unknown'):
+            errors.append('{} is not in functions.yaml.'.format(f['name']))
+            continue
+        types = function_info[f['name']]['func_type']
+        if 'None' in types:
+            errors.append('{} is not implemented.'.format(f['name']))
+            continue
+        variables = [network.variables[i] for i in f['inputs'] + f['outputs']]
+        is_float = all(v['type'] == DATA_TYPE_FLOAT for v in variables)
+        name = f['name'].upper()
+        configs.add(name)
+        if is_float and ('ALL' in types or 'FLOAT32' in types):
+            configs.add(name + '_FLOAT32')
+            kernels, shape = specialized_shape(network, f)
+            if shape is not None:
+                shapes[kernels].add(shape)
+        elif not is_float and ('ALL' in types or 'FIXED8' in types or
+                               'FIXED16' in types):
+            configs.add(name + '_GENERIC')
+        else:
+            errors.append('{} is not implemented for {} variables.'.format(
+                f['name'], 'float' if is_float else 'fixed point'))
+    return configs
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Write config.h with functions used by NNB.')
+    parser.add_argument('nnb', nargs='+', help='NNB files.')
+    parser.add_argument('-o', '--output', default='config.h',
+                        help='Output file, config.h by default.')
+    args = parser.parse_args()
+
+    function_info = load_function_info()
+    by_name = {name: func for name, func in function_info.values()}
+    configs = set()
+    errors = []
+    shapes = {'CONVOLUTION': set(), 'DEPTHWISE_CONVOLUTION': set(),
+              'POOLING': set()}
+    for filename in args.nnb:
+        with open(filename, 'rb') as f:
+            network = Network(f.read(), function_info)
+        configs |= used_configs(network, by_name, errors, shapes)
+    if errors:
+        for e in sorted(set(errors)):
+            print('Error: {}'.format(e), file=sys.stderr)
+        return 1
+
+    lines = [HEADER.rstrip('\n')]
+    lines += ['//   {}'.format(n) for n in args.nnb]
+    lines += ['', '#ifndef __INCLUDE_CONFIG_H', '#define __INCLUDE_CONFIG_H',
+              '']
+    lines += ['#define CONFIG_{} 1'.format(n) for n in sorted(configs)]
+    lines += ['']
+    for kernels, entries in sorted(shapes.items()):
+        lines.append('#define NNABLART_SPECIALIZED_{}(X) {}'.format(
+            kernels, ' '.join('X({})'.format(', '.join(str(v) for v in e))
+                              for e in sorted(entries))).rstrip())
+    lines += ['', '#endif /* __INCLUDE_CONFIG_H */', '']
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(lines))
+    print('Enabled {} functions.'.format(
+        len([n for n in configs
+             if not n.endswith(('_FLOAT32', '_GENERIC'))])))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -36,6 +36,9 @@ def _generate_context_code(fn, func, fid_num, arg_fmt, fid):
             '      nn_function_{0}_t *f = (nn_function_{0}_t*)function;'.format(func['snake_name']))
         l.append(
             '      {0}_local_context_t *ctx = rt_malloc_func(sizeof({0}_local_context_t));'.format(func['snake_name']))
+        l.append('      if (ctx == 0) {')
+        l.append('        return RT_FUNCTION_ERROR_MALLOC;')
+        l.append('      }')
 
         n = 0
         for an, arg in func['arguments'].items():
@@ -76,8 +79,8 @@ def _generate_context_code(fn, func, fid_num, arg_fmt, fid):
     else:
         l.append('      function_context->func.local_context = 0;')
     l.append(
-        '      allocate_{}_local_context(&function_context->func);'.format(func['snake_name']))
-    l.append('    } break;')
+        '      return allocate_{}_local_context(&function_context->func);'.format(func['snake_name']))
+    l.append('    }')
     return l
 
 
@@ -137,6 +137,18 @@ bwd-nnabla-c-runtime-test-all-functions: nnabla-c-runtime-docker_image_test
 	&& docker run $(NNABLA_C_RUNTIME_DOCKER_RUN_OPTS) \
 		$(NNABLA_C_RUNTIME_DOCKER_IMAGE_TEST) make nnabla-c-runtime-test-all-functions
 
+.PHONY: bwd-nnabla-c-runtime-bench-functions
+bwd-nnabla-c-runtime-bench-functions: nnabla-c-runtime-docker_image_test
+	cd $(NNABLA_C_RUNTIME_DIRECTORY) \
+	&& docker run $(NNABLA_C_RUNTIME_DOCKER_RUN_OPTS) \
+		$(NNABLA_C_RUNTIME_DOCKER_IMAGE_TEST) make nnabla-c-runtime-bench-functions
+
+.PHONY: bwd-nnabla-c-runtime-bench-samples
+bwd-nnabla-c-runtime-bench-samples: nnabla-c-runtime-docker_image_test
+	cd $(NNABLA_C_RUNTIME_DIRECTORY) \
+	&& docker run $(NNABLA_C_RUNTIME_DOCKER_RUN_OPTS) \
+		$(NNABLA_C_RUNTIME_DOCKER_IMAGE_TEST) make nnabla-c-runtime-bench-samples
+
 ifneq ("$(NNABLA_EXAMPLES_DIRECTORY)","")
 
 .PHONY: bwd-nnabla-c-runtime-generate-mnist-test
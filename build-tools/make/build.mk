@@ -24,6 +24,8 @@ export NNABLA_C_RUNTIME_REFERENCE_DIRECTORY
 export NNABLA_C_RUNTIME_TEST_DIRECTORY
 export CRUNTIME_TEST_FUNCTION_LIST
 export CRUNTIME_TEST_FUNCTION_EXCLUDE_LIST
+export CRUNTIME_BENCH_WARMUP
+export CRUNTIME_BENCH_ITERATIONS
 
 ########################################################################################################################
 # Build
@@ -98,6 +100,15 @@ nnabla-c-runtime-test-all-functions: nnabla-c-runtime-build nnabla-install
 	 NNABLA_C_RUNTIME_TEST_DIRECTORY=$(NNABLA_C_RUNTIME_TEST_DIRECTORY) \
 		$(MAKE) -k -j1 -f $(NNABLA_C_RUNTIME_TEST_DIRECTORY)/nnabla-c-runtime/test_functions.mk
 
+.PHONY: nnabla-c-runtime-bench-functions
+nnabla-c-runtime-bench-functions: nnabla-c-runtime-build nnabla-install
+	@rm -rf $(NNABLA_C_RUNTIME_TEST_DIRECTORY)/nnabla-c-runtime/bench
+	@python3 build-tools/test/scripts/bench_functions.py
+
+.PHONY: nnabla-c-runtime-bench-samples
+nnabla-c-runtime-bench-samples: nnabla-c-runtime-build nnabla-install
+	@python3 build-tools/test/scripts/bench_samples.py
+
 ifneq ("$(NNABLA_EXAMPLES_DIRECTORY)","")
 
 .PHONY: nnabla-c-runtime-generate-mnist-test
@@ -0,0 +1,591 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Affine and BatchMatmul kernels compared with dot products in double.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define TOLERANCE (1e-4f)
+
+typedef struct {
+  const char *name;
+  int ndim;
+  int shape[3]; // Shape of x.
+  int base_axis;
+  int outputs; // Outputs of each sample.
+  int has_bias;
+} affine_t;
+
+static int batch_of(const affine_t *k) {
+  int batch = 1;
+  int d; // Iterator
+  for (d = 0; d < k->base_axis; d++) {
+    batch *= k->shape[d];
+  }
+  return batch;
+}
+
+static int inputs_of(const affine_t *k) {
+  int inputs = 1;
+  int d; // Iterator
+  for (d = k->base_axis; d < k->ndim; d++) {
+    inputs *= k->shape[d];
+  }
+  return inputs;
+}
+
+// Row j of weight holds inputs of output j.
+static void affine_reference(const affine_t *k, const float *x,
+                             const float *w, const float *b, double *y) {
+  int batch = batch_of(k), inputs = inputs_of(k);
+  int i, j, l; // Iterators
+
+  for (i = 0; i < batch; i++) {
+    for (j = 0; j < k->outputs; j++) {
+      double sum = k->has_bias ? b[j] : 0;
+      for (l = 0; l < inputs; l++) {
+        sum += (double)x[i * inputs + l] * w[j * inputs + l];
+      }
+      y[i * k->outputs + j] = sum;
+    }
+  }
+}
+
+static void to_float(const double *values, int size, float *result) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    result[i] = (float)values[i];
+  }
+}
+
+// Variables of x, w, b and y of network of case.
+typedef struct {
+  nn_data_type_t type[4];
+  int fp_pos[4];
+  const void *data[3]; // Data of parameters w and b, x has none.
+} affine_variables_t;
+
+static nn_network_t *build_affine(const affine_t *k,
+                                  const affine_variables_t *av) {
+  test_network_t n;
+  int w_shape[2] = {k->outputs, inputs_of(k)};
+  int b_shape[1] = {k->outputs};
+  int y_shape[3];
+  int v[4];
+  nn_function_affine_t affine;
+
+  memcpy(y_shape, k->shape, sizeof(int) * k->base_axis);
+  y_shape[k->base_axis] = k->outputs;
+  test_network_init(&n);
+  v[0] = test_typed_variable(&n, k->shape, k->ndim, av->type[0],
+                             av->fp_pos[0], 0);
+  v[1] = test_typed_variable(&n, w_shape, 2, av->type[1], av->fp_pos[1],
+                             av->data[1]);
+  v[2] = test_typed_variable(&n, b_shape, 1, av->type[2], av->fp_pos[2],
+                             av->data[2]);
+  v[3] = test_typed_variable(&n, y_shape, k->base_axis + 1, av->type[3],
+                             av->fp_pos[3], 0);
+  memset(&affine, 0, sizeof(affine));
+  affine.base_axis = k->base_axis;
+  test_function(&n, &affine, sizeof(affine), NN_FUNCTION_AFFINE, v,
+                2 + k->has_bias, v + 3, 1);
+  return test_build(&n, v, 1, v + 3, 1);
+}
+
+static void test_float(const affine_t *k, unsigned seed) {
+  affine_variables_t av = {{NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT,
+                            NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT},
+                           {0, 0, 0, 0},
+                           {0, 0, 0}};
+  int x_size = batch_of(k) * inputs_of(k);
+  int w_size = k->outputs * inputs_of(k);
+  int y_size = batch_of(k) * k->outputs;
+  float *x = malloc(sizeof(float) * x_size);
+  float *w = malloc(sizeof(float) * w_size);
+  float *b = malloc(sizeof(float) * k->outputs);
+  float *y = malloc(sizeof(float) * y_size);
+  double *reference = malloc(sizeof(double) * y_size);
+
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->outputs, seed + 2, 1.0f);
+  affine_reference(k, x, w, b, reference);
+  to_float(reference, y_size, y);
+  av.data[1] = w;
+  av.data[2] = b;
+  test_check_network(k->name, build_affine(k, &av), (const void *const[]){x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(reference);
+}
+
+static void to_fixed(const float *values, int size, nn_data_type_t type,
+                     int fp_pos, void *result) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    if (type == NN_DATA_TYPE_INT8) {
+      ((int8_t *)result)[i] = (int8_t)ldexpf(values[i], fp_pos);
+    } else {
+      ((int16_t *)result)[i] = (int16_t)ldexpf(values[i], fp_pos);
+    }
+  }
+}
+
+// int8 or int16 input and weight, whose accumulator is converted to output
+// type once.
+static void test_fixed(const affine_t *k, nn_data_type_t x_type,
+                       nn_data_type_t w_type, nn_data_type_t y_type,
+                       unsigned seed) {
+  int x_fp = x_type == NN_DATA_TYPE_INT8 ? 4 : 8;
+  int w_fp = w_type == NN_DATA_TYPE_INT8 ? 6 : 10;
+  int y_fp = y_type == NN_DATA_TYPE_INT8 ? 3 : 8;
+  affine_variables_t av = {{x_type, w_type, NN_DATA_TYPE_FLOAT, y_type},
+                           {x_fp, w_fp, 0, y_fp},
+                           {0, 0, 0}};
+  int x_size = batch_of(k) * inputs_of(k);
+  int w_size = k->outputs * inputs_of(k);
+  int y_size = batch_of(k) * k->outputs;
+  float *x = malloc(sizeof(float) * x_size);
+  float *w = malloc(sizeof(float) * w_size);
+  float *b = malloc(sizeof(float) * k->outputs);
+  float *y = malloc(sizeof(float) * y_size);
+  double *reference = malloc(sizeof(double) * y_size);
+  void *xf = malloc(test_data_size(x_type, x_size));
+  void *wf = malloc(test_data_size(w_type, w_size));
+  char name[96];
+  int i; // Iterator
+
+  test_fill(x, x_size, seed, x_type == NN_DATA_TYPE_INT8 ? 15.0f : 100.0f);
+  test_fill(w, w_size, seed + 1, w_type == NN_DATA_TYPE_INT8 ? 3.9f : 4.0f);
+  test_fill(b, k->outputs, seed + 2, 8.0f);
+  test_round(x, x_size, x_fp);
+  test_round(w, w_size, w_fp);
+  to_fixed(x, x_size, x_type, x_fp, xf);
+  to_fixed(w, w_size, w_type, w_fp, wf);
+  av.data[1] = wf;
+  av.data[2] = b;
+  // Bias is rounded to fixed point position of accumulator.
+  test_round(b, k->outputs, x_fp + w_fp);
+  affine_reference(k, x, w, b, reference);
+  if (y_type != NN_DATA_TYPE_FLOAT) {
+    double max = ldexp(y_type == NN_DATA_TYPE_INT8 ? 127 : 32767, -y_fp);
+    double min = -max - ldexp(1, -y_fp);
+    for (i = 0; i < y_size; i++) {
+      double value = ldexp(trunc(ldexp(reference[i], y_fp)), -y_fp);
+      reference[i] = value > max ? max : value < min ? min : value;
+    }
+  }
+  to_float(reference, y_size, y);
+  sprintf(name, "%s of types %d, %d to %d", k->name, x_type, w_type, y_type);
+  test_check_network(name, build_affine(k, &av), (const void *const[]){xf},
+                     (const float *const[]){y}, 1e-6f);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(reference);
+  free(xf);
+  free(wf);
+}
+
+static void pack_sign(const float *values, int size, uint32_t *bits) {
+  int i; // Iterator
+  memset(bits, 0, test_data_size(NN_DATA_TYPE_SIGN, size));
+  for (i = 0; i < size; i++) {
+    if (values[i] > 0) {
+      bits[i / 32] |= 1u << (i % 32);
+    }
+  }
+}
+
+static void to_sign(float *values, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    values[i] = values[i] >= 0 ? 1.0f : -1.0f;
+  }
+}
+
+// SIGN binary weight read by Affine, BinaryConnectAffine or
+// BinaryWeightAffine, whose input is float or SIGN.
+static void test_sign(const affine_t *k, int type, nn_data_type_t x_type,
+                      unsigned seed) {
+  test_network_t n;
+  int inputs = inputs_of(k);
+  int x_size = batch_of(k) * inputs;
+  int w_size = k->outputs * inputs;
+  int y_size = batch_of(k) * k->outputs;
+  int w_shape[2] = {k->outputs, inputs};
+  int b_shape[1] = {k->outputs};
+  int y_shape[3], v[6], in[5];
+  int num_of_inputs = 0;
+  float *x = malloc(sizeof(float) * x_size);
+  float *w = malloc(sizeof(float) * w_size);
+  float *alpha = malloc(sizeof(float) * k->outputs);
+  float *b = malloc(sizeof(float) * k->outputs);
+  float *y = malloc(sizeof(float) * y_size);
+  double *reference = malloc(sizeof(double) * y_size);
+  uint32_t *xs = malloc(test_data_size(NN_DATA_TYPE_SIGN, x_size));
+  uint32_t *ws = malloc(test_data_size(NN_DATA_TYPE_SIGN, w_size));
+  nn_function_affine_t affine;
+  nn_function_binary_connect_affine_t connect;
+  nn_function_binary_weight_affine_t weight;
+  char name[96];
+  int i; // Iterator
+
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(alpha, k->outputs, seed + 2, 1.0f);
+  test_fill(b, k->outputs, seed + 3, 4.0f);
+  if (x_type == NN_DATA_TYPE_SIGN) {
+    to_sign(x, x_size);
+    pack_sign(x, x_size, xs);
+  }
+  to_sign(w, w_size);
+  pack_sign(w, w_size, ws);
+  affine_reference(k, x, w, b, reference);
+  if (type == NN_FUNCTION_BINARY_WEIGHT_AFFINE) {
+    for (i = 0; i < y_size; i++) {
+      int j = i % k->outputs;
+      reference[i] = (reference[i] - b[j]) * alpha[j] + b[j];
+    }
+  }
+  to_float(reference, y_size, y);
+
+  memcpy(y_shape, k->shape, sizeof(int) * k->base_axis);
+  y_shape[k->base_axis] = k->outputs;
+  test_network_init(&n);
+  v[0] = test_typed_variable(&n, k->shape, k->ndim, x_type, 0, 0);
+  v[1] = test_variable(&n, w_shape, 2, w);
+  v[2] = test_typed_variable(&n, w_shape, 2, NN_DATA_TYPE_SIGN, 0, ws);
+  v[3] = test_variable(&n, b_shape, 1, alpha);
+  v[4] = test_variable(&n, b_shape, 1, b);
+  v[5] = test_variable(&n, y_shape, k->base_axis + 1, 0);
+  in[num_of_inputs++] = v[0];
+  if (type != NN_FUNCTION_AFFINE) {
+    in[num_of_inputs++] = v[1];
+  }
+  in[num_of_inputs++] = v[2];
+  if (type == NN_FUNCTION_BINARY_WEIGHT_AFFINE) {
+    in[num_of_inputs++] = v[3];
+  }
+  in[num_of_inputs++] = v[4];
+  if (type == NN_FUNCTION_AFFINE) {
+    memset(&affine, 0, sizeof(affine));
+    affine.base_axis = k->base_axis;
+    test_function(&n, &affine, sizeof(affine), type, in, num_of_inputs,
+                  v + 5, 1);
+  } else if (type == NN_FUNCTION_BINARY_CONNECT_AFFINE) {
+    memset(&connect, 0, sizeof(connect));
+    connect.base_axis = k->base_axis;
+    test_function(&n, &connect, sizeof(connect), type, in, num_of_inputs,
+                  v + 5, 1);
+  } else {
+    memset(&weight, 0, sizeof(weight));
+    weight.base_axis = k->base_axis;
+    test_function(&n, &weight, sizeof(weight), type, in, num_of_inputs,
+                  v + 5, 1);
+  }
+  sprintf(name, "%s of function %d and input type %d", k->name, type,
+          x_type);
+  test_check_network(name, test_build(&n, v, 1, v + 5, 1),
+                     (const void *const[]){x_type == NN_DATA_TYPE_SIGN
+                                               ? (const void *)xs
+                                               : (const void *)x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(alpha);
+  free(b);
+  free(y);
+  free(reference);
+  free(xs);
+  free(ws);
+}
+
+// Weight whose blocks of 4 inputs are zero except one of three.
+static void test_sparse(const affine_t *k, unsigned seed) {
+  test_network_t n;
+  int inputs = inputs_of(k);
+  int x_size = batch_of(k) * inputs;
+  int w_size = k->outputs * inputs;
+  int y_size = batch_of(k) * k->outputs;
+  int w_shape[2] = {k->outputs, inputs};
+  int b_shape[1] = {k->outputs};
+  int y_shape[3], v[4];
+  float *x = malloc(sizeof(float) * x_size);
+  float *w = malloc(sizeof(float) * w_size);
+  float *b = malloc(sizeof(float) * k->outputs);
+  float *y = malloc(sizeof(float) * y_size);
+  double *reference = malloc(sizeof(double) * y_size);
+  nn_function_affine_t affine;
+  int i; // Iterator
+
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->outputs, seed + 2, 1.0f);
+  for (i = 0; i < w_size; i++) {
+    if ((i % inputs / 4 + i / inputs) % 3) {
+      w[i] = 0;
+    }
+  }
+  affine_reference(k, x, w, b, reference);
+  to_float(reference, y_size, y);
+
+  memcpy(y_shape, k->shape, sizeof(int) * k->base_axis);
+  y_shape[k->base_axis] = k->outputs;
+  test_network_init(&n);
+  v[0] = test_variable(&n, k->shape, k->ndim, 0);
+  v[1] = test_sparse_variable(&n, w_shape, 2, w, 4);
+  v[2] = test_variable(&n, b_shape, 1, b);
+  v[3] = test_variable(&n, y_shape, k->base_axis + 1, 0);
+  memset(&affine, 0, sizeof(affine));
+  affine.base_axis = k->base_axis;
+  test_function(&n, &affine, sizeof(affine), NN_FUNCTION_AFFINE, v,
+                2 + k->has_bias, v + 3, 1);
+  test_check_network(k->name, test_build(&n, v, 1, v + 3, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(reference);
+}
+
+// Weight stored as FLOAT16 or BFLOAT16, reference uses rounded weight.
+static void test_half(const affine_t *k, nn_data_type_t type,
+                      unsigned seed) {
+  affine_variables_t av = {
+      {NN_DATA_TYPE_FLOAT, type, NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT},
+      {0, 0, 0, 0},
+      {0, 0, 0}};
+  int x_size = batch_of(k) * inputs_of(k);
+  int w_size = k->outputs * inputs_of(k);
+  int y_size = batch_of(k) * k->outputs;
+  float *x = malloc(sizeof(float) * x_size);
+  float *w = malloc(sizeof(float) * w_size);
+  float *b = malloc(sizeof(float) * k->outputs);
+  float *y = malloc(sizeof(float) * y_size);
+  double *reference = malloc(sizeof(double) * y_size);
+  uint16_t *half = malloc(sizeof(uint16_t) * w_size);
+  char name[96];
+  int i; // Iterator
+
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->outputs, seed + 2, 1.0f);
+  for (i = 0; i < w_size; i++) {
+    half[i] = test_to_half(type, w[i]);
+    w[i] = test_from_half(type, half[i]);
+  }
+  affine_reference(k, x, w, b, reference);
+  to_float(reference, y_size, y);
+  av.data[1] = half;
+  av.data[2] = b;
+  sprintf(name, "%s of weight type %d", k->name, type);
+  test_check_network(name, build_affine(k, &av), (const void *const[]){x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(reference);
+  free(half);
+}
+
+typedef struct {
+  const char *name;
+  int samples;
+  int rows;    // Rows of output.
+  int columns; // Columns of output.
+  int inner;   // Length of dot products.
+  int transpose_a;
+  int transpose_b;
+  int transposed_input; // a is given by Transpose of last two axes.
+} matmul_t;
+
+static void test_batch_matmul(const matmul_t *k, unsigned seed) {
+  test_network_t n;
+  int a_size = k->samples * k->rows * k->inner;
+  int b_size = k->samples * k->inner * k->columns;
+  int y_size = k->samples * k->rows * k->columns;
+  int a_shape[3], b_shape[3];
+  int y_shape[3] = {k->samples, k->rows, k->columns};
+  int v[4];
+  float *a = malloc(sizeof(float) * a_size);
+  float *b = malloc(sizeof(float) * b_size);
+  float *y = malloc(sizeof(float) * y_size);
+  nn_function_batch_matmul_t matmul;
+  int s, i, j, l; // Iterators
+
+  test_fill(a, a_size, seed, 4.0f);
+  test_fill(b, b_size, seed + 1, 1.0f);
+  for (s = 0; s < k->samples; s++) {
+    for (i = 0; i < k->rows; i++) {
+      for (j = 0; j < k->columns; j++) {
+        double sum = 0;
+        for (l = 0; l < k->inner; l++) {
+          int ai = k->transpose_a ? l * k->rows + i : i * k->inner + l;
+          int bi = k->transpose_b ? j * k->inner + l : l * k->columns + j;
+          sum += (double)a[s * k->rows * k->inner + ai] *
+                 b[s * k->inner * k->columns + bi];
+        }
+        y[(s * k->rows + i) * k->columns + j] = (float)sum;
+      }
+    }
+  }
+
+  a_shape[0] = b_shape[0] = k->samples;
+  a_shape[1] = k->transpose_a ? k->inner : k->rows;
+  a_shape[2] = k->transpose_a ? k->rows : k->inner;
+  b_shape[1] = k->transpose_b ? k->columns : k->inner;
+  b_shape[2] = k->transpose_b ? k->inner : k->columns;
+  test_network_init(&n);
+  memset(&matmul, 0, sizeof(matmul));
+  matmul.transpose_a = k->transpose_a;
+  matmul.transpose_b = k->transpose_b;
+  if (k->transposed_input) {
+    // Input x is a with last two axes swapped, a is output of Transpose.
+    static const int axes[3] = {0, 2, 1};
+    int x_shape[3] = {a_shape[0], a_shape[2], a_shape[1]};
+    float *x = malloc(sizeof(float) * a_size);
+    nn_function_transpose_t transpose;
+    int t[2];
+    for (s = 0; s < k->samples; s++) {
+      for (i = 0; i < a_shape[1]; i++) {
+        for (l = 0; l < a_shape[2]; l++) {
+          x[(s * a_shape[2] + l) * a_shape[1] + i] =
+              a[(s * a_shape[1] + i) * a_shape[2] + l];
+        }
+      }
+    }
+    v[0] = test_variable(&n, x_shape, 3, 0);
+    v[1] = test_variable(&n, a_shape, 3, 0);
+    v[2] = test_variable(&n, b_shape, 3, b);
+    v[3] = test_variable(&n, y_shape, 3, 0);
+    memset(&transpose, 0, sizeof(transpose));
+    transpose.axes = test_list(&n, axes, 3);
+    test_function(&n, &transpose, sizeof(transpose), NN_FUNCTION_TRANSPOSE,
+                  v, 1, v + 1, 1);
+    t[0] = v[1];
+    t[1] = v[2];
+    test_function(&n, &matmul, sizeof(matmul), NN_FUNCTION_BATCH_MATMUL, t,
+                  2, v + 3, 1);
+    test_check_network(k->name, test_build(&n, v, 1, v + 3, 1),
+                       (const void *const[]){x}, (const float *const[]){y},
+                       TOLERANCE);
+    free(x);
+    free(a);
+    free(b);
+    free(y);
+    return;
+  }
+  v[0] = test_variable(&n, a_shape, 3, 0);
+  v[1] = test_variable(&n, b_shape, 3, b);
+  v[2] = test_variable(&n, y_shape, 3, 0);
+  test_function(&n, &matmul, sizeof(matmul), NN_FUNCTION_BATCH_MATMUL, v, 2,
+                v + 2, 1);
+  test_check_network(k->name, test_build(&n, v, 1, v + 2, 1),
+                     (const void *const[]){a}, (const float *const[]){y},
+                     TOLERANCE);
+  free(a);
+  free(b);
+  free(y);
+}
+
+// name, ndim, shape, base_axis, outputs, has_bias
+static const affine_t float_cases[] = {
+    {"Affine", 2, {4, 10}, 1, 7, 1},
+    {"Affine without bias", 2, {5, 13}, 1, 9, 0},
+    {"Affine of base axis 2", 3, {2, 3, 11}, 2, 6, 1},
+    {"Affine of flattened inputs", 3, {3, 4, 5}, 1, 5, 1},
+    // Blocks of depth and columns of GEMM with partial panels.
+    {"Affine in blocks", 2, {9, 300}, 1, 150, 1},
+    {"Affine of batch 1", 2, {1, 37}, 1, 21, 1},
+    {"Affine of batch 1 in rows of 8", 2, {1, 500}, 1, 203, 0},
+};
+
+// name, samples, rows, columns, inner, transpose_a, transpose_b
+static const matmul_t matmul_cases[] = {
+    {"BatchMatmul", 2, 7, 9, 11, 0, 0},
+    {"BatchMatmul of transposed a", 3, 6, 5, 13, 1, 0},
+    {"BatchMatmul of transposed b", 2, 9, 10, 7, 0, 1},
+    {"BatchMatmul of transposed a and b", 2, 5, 11, 8, 1, 1},
+    {"BatchMatmul in blocks", 2, 37, 70, 150, 0, 0},
+    {"Transpose to BatchMatmul", 2, 7, 9, 11, 0, 0, 1},
+    {"Transpose to BatchMatmul of transposed a", 2, 6, 5, 13, 1, 1, 1},
+};
+
+int main(void) {
+  static const affine_t fixed_case = {"Fixed Affine", 2, {3, 37}, 1, 11, 1};
+  static const nn_data_type_t types[] = {NN_DATA_TYPE_INT8,
+                                         NN_DATA_TYPE_INT16};
+  static const nn_data_type_t outputs[] = {
+      NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_INT8, NN_DATA_TYPE_INT16};
+  int x, w, y; // Iterators of types
+  static const affine_t sign_cases[] = {
+      {"SIGN Affine", 2, {3, 45}, 1, 7, 1},
+      {"SIGN Affine of words", 2, {2, 64}, 1, 9, 1},
+  };
+  static const int sign_functions[] = {NN_FUNCTION_AFFINE,
+                                       NN_FUNCTION_BINARY_CONNECT_AFFINE,
+                                       NN_FUNCTION_BINARY_WEIGHT_AFFINE};
+  int f, t; // Iterators of functions and input types
+  static const affine_t sparse_cases[] = {
+      {"Sparse Affine", 2, {5, 48}, 1, 13, 1},
+      {"Sparse Affine of batch 1", 2, {1, 64}, 1, 10, 0},
+  };
+  static const affine_t half_case = {"Affine", 2, {5, 140}, 1, 70, 1};
+  int i; // Iterator
+
+  for (i = 0; i < (int)(sizeof(float_cases) / sizeof(float_cases[0])); i++) {
+    test_float(float_cases + i, 10 + i);
+  }
+  for (i = 0; i < (int)(sizeof(matmul_cases) / sizeof(matmul_cases[0]));
+       i++) {
+    test_batch_matmul(matmul_cases + i, 30 + i);
+  }
+  for (x = 0; x < 2; x++) {
+    for (w = 0; w < 2; w++) {
+      for (y = 0; y < 3; y++) {
+        test_fixed(&fixed_case, types[x], types[w], outputs[y],
+                   50 + x * 6 + w * 3 + y);
+      }
+    }
+  }
+  for (i = 0; i < 2; i++) {
+    for (f = 0; f < 3; f++) {
+      for (t = 0; t < 2; t++) {
+        test_sign(sign_cases + i, sign_functions[f],
+                  t ? NN_DATA_TYPE_SIGN : NN_DATA_TYPE_FLOAT,
+                  70 + i * 6 + f * 2 + t);
+      }
+    }
+  }
+  for (i = 0; i < 2; i++) {
+    test_sparse(sparse_cases + i, 90 + i);
+  }
+  test_half(&half_case, NN_DATA_TYPE_FLOAT16, 95);
+  test_half(&half_case, NN_DATA_TYPE_BFLOAT16, 96);
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Functions moving values compared with mapping of each output position.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define MAX_NDIM (6)
+
+static int size_of(const int *shape, int ndim) {
+  int size = 1;
+  int d; // Iterator
+  for (d = 0; d < ndim; d++) {
+    size *= shape[d];
+  }
+  return size;
+}
+
+static void to_position(int index, const int *shape, int ndim,
+                        int *position) {
+  int d; // Iterator
+  for (d = ndim - 1; d >= 0; d--) {
+    position[d] = index % shape[d];
+    index /= shape[d];
+  }
+}
+
+static int to_index(const int *position, const int *shape, int ndim) {
+  int index = 0;
+  int d; // Iterator
+  for (d = 0; d < ndim; d++) {
+    index = index * shape[d] + position[d];
+  }
+  return index;
+}
+
+// Network of one function of x added to n, which has lists of function.
+// Values are moved exactly.
+static void check_function(const char *name, test_network_t *n,
+                           void *function, size_t size, int type,
+                           const int *x_shape, int x_ndim, const float *x,
+                           const int *y_shape, int y_ndim, const float *y) {
+  int v[2];
+
+  v[0] = test_variable(n, x_shape, x_ndim, 0);
+  v[1] = test_variable(n, y_shape, y_ndim, 0);
+  test_function(n, function, size, type, v, 1, v + 1, 1);
+  test_check_network(name, test_build(n, v, 1, v + 1, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     0);
+}
+
+static void test_transpose(const int *shape, int ndim, const int *axes,
+                           unsigned seed) {
+  test_network_t n;
+  int size = size_of(shape, ndim);
+  int y_shape[MAX_NDIM], position[MAX_NDIM], source[MAX_NDIM];
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  nn_function_transpose_t f;
+  char name[96];
+  int i, d; // Iterators
+
+  test_fill(x, size, seed, 8.0f);
+  for (d = 0; d < ndim; d++) {
+    y_shape[d] = shape[axes[d]];
+  }
+  for (i = 0; i < size; i++) {
+    to_position(i, y_shape, ndim, position);
+    for (d = 0; d < ndim; d++) {
+      source[axes[d]] = position[d];
+    }
+    y[i] = x[to_index(source, shape, ndim)];
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.axes = test_list(&n, axes, ndim);
+  sprintf(name, "Transpose of %d axes to", ndim);
+  for (d = 0; d < ndim; d++) {
+    sprintf(name + strlen(name), " %d", axes[d]);
+  }
+  check_function(name, &n, &f, sizeof(f), NN_FUNCTION_TRANSPOSE, shape, ndim,
+                 x, y_shape, ndim, y);
+  free(x);
+  free(y);
+}
+
+// Flip of axes whose bits are set in mask.
+static void test_flip(const int *shape, int ndim, unsigned mask,
+                      unsigned seed) {
+  test_network_t n;
+  int size = size_of(shape, ndim);
+  int axes[MAX_NDIM], position[MAX_NDIM];
+  int num_axes = 0;
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  nn_function_flip_t f;
+  char name[64];
+  int i, d; // Iterators
+
+  test_fill(x, size, seed, 8.0f);
+  for (d = 0; d < ndim; d++) {
+    if (mask >> d & 1) {
+      axes[num_axes++] = d;
+    }
+  }
+  for (i = 0; i < size; i++) {
+    to_position(i, shape, ndim, position);
+    for (d = 0; d < ndim; d++) {
+      if (mask >> d & 1) {
+        position[d] = shape[d] - 1 - position[d];
+      }
+    }
+    y[i] = x[to_index(position, shape, ndim)];
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.axes = test_list(&n, axes, num_axes);
+  sprintf(name, "Flip of %d axes of mask %x", ndim, mask);
+  check_function(name, &n, &f, sizeof(f), NN_FUNCTION_FLIP, shape, ndim, x,
+                 shape, ndim, y);
+  free(x);
+  free(y);
+}
+
+// Shift of last axes by shifts, border cells are nearest or reflected.
+static void test_shift(const int *shape, int ndim, const int *shifts,
+                       int num_shifts, int border_mode, unsigned seed) {
+  test_network_t n;
+  int size = size_of(shape, ndim);
+  int position[MAX_NDIM];
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  nn_function_shift_t f;
+  char name[64];
+  int i, d; // Iterators
+
+  test_fill(x, size, seed, 8.0f);
+  for (i = 0; i < size; i++) {
+    to_position(i, shape, ndim, position);
+    for (d = ndim - num_shifts; d < ndim; d++) {
+      int s = shape[d];
+      int j = position[d] - shifts[d - ndim + num_shifts];
+      if (border_mode == SHIFT_BORDER_MODE_REFLECT) {
+        j = s > 1 ? abs(j + 2 * s) % (2 * s) : 0;
+        j = j >= s ? 2 * s - 1 - j : j;
+      } else {
+        j = j < 0 ? 0 : j >= s ? s - 1 : j;
+      }
+      position[d] = j;
+    }
+    y[i] = x[to_index(position, shape, ndim)];
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.shifts = test_list(&n, shifts, num_shifts);
+  f.border_mode = border_mode;
+  sprintf(name, "Shift of %d axes by %d%s", ndim, shifts[0],
+          border_mode == SHIFT_BORDER_MODE_REFLECT ? " reflected" : "");
+  check_function(name, &n, &f, sizeof(f), NN_FUNCTION_SHIFT, shape, ndim, x,
+                 shape, ndim, y);
+  free(x);
+  free(y);
+}
+
+// Stack of inputs inputs of shape at axis.
+static void test_stack(const int *shape, int ndim, int inputs, int axis,
+                       unsigned seed) {
+  test_network_t n;
+  int size = size_of(shape, ndim);
+  int inner = size_of(shape + axis, ndim - axis);
+  int y_shape[MAX_NDIM], v[8];
+  float *x[7];
+  float *y = malloc(sizeof(float) * size * inputs);
+  nn_function_stack_t f;
+  char name[64];
+  int i, j; // Iterators
+
+  for (j = 0; j < inputs; j++) {
+    x[j] = malloc(sizeof(float) * size);
+    test_fill(x[j], size, seed + j, 8.0f);
+  }
+  for (i = 0; i < size; i++) {
+    for (j = 0; j < inputs; j++) {
+      y[(i / inner * inputs + j) * inner + i % inner] = x[j][i];
+    }
+  }
+  memcpy(y_shape, shape, sizeof(int) * axis);
+  y_shape[axis] = inputs;
+  memcpy(y_shape + axis + 1, shape + axis, sizeof(int) * (ndim - axis));
+  test_network_init(&n);
+  for (j = 0; j < inputs; j++) {
+    v[j] = test_variable(&n, shape, ndim, 0);
+  }
+  v[inputs] = test_variable(&n, y_shape, ndim + 1, 0);
+  memset(&f, 0, sizeof(f));
+  f.axis = axis;
+  test_function(&n, &f, sizeof(f), NN_FUNCTION_STACK, v, inputs, v + inputs,
+                1);
+  sprintf(name, "Stack of %d inputs at axis %d", inputs, axis);
+  test_check_network(name, test_build(&n, v, inputs, v + inputs, 1),
+                     (const void *const *)x, (const float *const[]){y}, 0);
+  for (j = 0; j < inputs; j++) {
+    free(x[j]);
+  }
+  free(y);
+}
+
+typedef struct {
+  int ndim;
+  int shape[MAX_NDIM];
+  int axes[MAX_NDIM];
+} transpose_t;
+
+static const transpose_t transpose_cases[] = {
+    {2, {37, 45}, {1, 0}},
+    {2, {70, 100}, {1, 0}}, // Tiles of 32 x 32 and partial tiles.
+    {4, {2, 3, 5, 7}, {0, 2, 3, 1}}, // NCHW to NHWC.
+    {4, {2, 5, 7, 3}, {0, 3, 1, 2}}, // NHWC to NCHW.
+    {4, {2, 3, 5, 7}, {1, 0, 2, 3}}, // Contiguous rows.
+    {4, {3, 1, 4, 5}, {2, 1, 0, 3}}, // Axis of size 1.
+    {3, {4, 6, 5}, {2, 0, 1}},
+    {5, {2, 3, 2, 4, 3}, {4, 2, 0, 3, 1}},
+    {6, {2, 2, 3, 2, 3, 2}, {5, 1, 3, 0, 4, 2}},
+};
+
+int main(void) {
+  static const int shape[4] = {3, 4, 5, 33};
+  static const int shifts[][4] = {{0, 0, 0, 3}, {0, 1, -2, 0},
+                                  {2, -1, 3, -40}, {0, 0, 0, -7}};
+  unsigned mask;
+  int s; // Iterator
+  int i; // Iterator
+
+  for (i = 0; i < (int)(sizeof(transpose_cases) / sizeof(transpose_cases[0]));
+       i++) {
+    const transpose_t *t = transpose_cases + i;
+    test_transpose(t->shape, t->ndim, t->axes, 10 + i);
+  }
+  for (mask = 1; mask < 16; mask++) {
+    test_flip(shape, 4, mask, 30 + mask);
+  }
+  for (s = 0; s < 4; s++) {
+    test_shift(shape, 4, shifts[s], 4, SHIFT_BORDER_MODE_NEAREST, 50 + s);
+    test_shift(shape, 4, shifts[s], 4, SHIFT_BORDER_MODE_REFLECT, 60 + s);
+  }
+  test_shift(shape, 4, shifts[1] + 2, 2, SHIFT_BORDER_MODE_NEAREST, 70);
+  for (i = 0; i < 4; i++) {
+    test_stack(shape, 4, 3, i, 80 + 10 * i);
+    test_stack(shape + 2, 2, 5, i % 3, 120 + 10 * i);
+  }
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
@@ -0,0 +1,647 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Convolution kernels compared with direct loops over output positions.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define TOLERANCE (1e-4f)
+
+typedef struct {
+  const char *name;
+  int type;     // Convolution, DepthwiseConvolution or Deconvolution.
+  int batch;    // Batch size.
+  int channels; // Input channels.
+  int maps;     // Output channels.
+  int group;    // Group, or multiplier of DepthwiseConvolution.
+  int ndim;     // Spatial dimensions.
+  int size[3];
+  int kernel[3];
+  int stride[3];
+  int pad[3];
+  int dilation[3];
+  int channel_last;
+  int has_bias;
+} conv_t;
+
+static int spatial_size(const int *shape, int ndim) {
+  int size = 1;
+  int d; // Iterator
+  for (d = 0; d < ndim; d++) {
+    size *= shape[d];
+  }
+  return size;
+}
+
+static void output_shape(const conv_t *k, int *shape) {
+  int d; // Iterator
+  for (d = 0; d < k->ndim; d++) {
+    int extent = k->dilation[d] * (k->kernel[d] - 1) + 1;
+    if (k->type == NN_FUNCTION_DECONVOLUTION) {
+      shape[d] = (k->size[d] - 1) * k->stride[d] - 2 * k->pad[d] + extent;
+      continue;
+    }
+    shape[d] = (k->size[d] + 2 * k->pad[d] - extent) / k->stride[d] + 1;
+  }
+}
+
+static int groups_of(const conv_t *k) {
+  return k->type == NN_FUNCTION_DEPTHWISE_CONVOLUTION ? k->channels
+                                                      : k->group;
+}
+
+// Position on each spatial axis of index in shape.
+static void to_position(int index, const int *shape, int ndim, int *position) {
+  int d; // Iterator
+  for (d = ndim - 1; d >= 0; d--) {
+    position[d] = index % shape[d];
+    index /= shape[d];
+  }
+}
+
+// Input index read by kernel tap at output position, or -1 outside input.
+static int input_index(const conv_t *k, const int *out, const int *tap) {
+  int index = 0;
+  int d; // Iterator
+  for (d = 0; d < k->ndim; d++) {
+    int i = out[d] * k->stride[d] - k->pad[d] + tap[d] * k->dilation[d];
+    if (k->type == NN_FUNCTION_DECONVOLUTION) {
+      i = out[d] + k->pad[d] - tap[d] * k->dilation[d];
+      if (i % k->stride[d] != 0) {
+        return -1;
+      }
+      i /= k->stride[d];
+    }
+    if (i < 0 || i >= k->size[d]) {
+      return -1;
+    }
+    index = index * k->size[d] + i;
+  }
+  return index;
+}
+
+static void conv_reference(const conv_t *k, const float *x, const float *w,
+                           const float *b, float *y) {
+  int out_shape[3], out[3], tap[3];
+  int in_size = spatial_size(k->size, k->ndim);
+  int kernel_size = spatial_size(k->kernel, k->ndim);
+  int out_size;
+  int cg = k->channels / groups_of(k), mg = k->maps / groups_of(k);
+  int n, m, o, c, q; // Iterators
+
+  output_shape(k, out_shape);
+  out_size = spatial_size(out_shape, k->ndim);
+  for (n = 0; n < k->batch; n++) {
+    for (m = 0; m < k->maps; m++) {
+      int g = m / mg;
+      for (o = 0; o < out_size; o++) {
+        double sum = k->has_bias ? b[m] : 0;
+        to_position(o, out_shape, k->ndim, out);
+        for (c = 0; c < cg; c++) {
+          int ci = g * cg + c;
+          for (q = 0; q < kernel_size; q++) {
+            int i, wi;
+            to_position(q, k->kernel, k->ndim, tap);
+            i = input_index(k, out, tap);
+            if (i < 0) {
+              continue;
+            }
+            wi = k->channel_last ? (m * kernel_size + q) * cg + c
+                                 : (m * cg + c) * kernel_size + q;
+            if (k->type == NN_FUNCTION_DECONVOLUTION) {
+              wi = (ci * mg + m % mg) * kernel_size + q;
+            }
+            sum += w[wi] * (double)(k->channel_last
+                                        ? x[(n * in_size + i) * k->channels +
+                                            ci]
+                                        : x[(n * k->channels + ci) * in_size +
+                                            i]);
+          }
+        }
+        y[k->channel_last ? (n * out_size + o) * k->maps + m
+                          : (n * k->maps + m) * out_size + o] = (float)sum;
+      }
+    }
+  }
+}
+
+// Shape of batch, channels and spatial axes in order of layout.
+static int io_shape(const conv_t *k, int channels, const int *spatial,
+                    int *shape) {
+  int d; // Iterator
+  shape[0] = k->batch;
+  for (d = 0; d < k->ndim; d++) {
+    shape[k->channel_last ? d + 1 : d + 2] = spatial[d];
+  }
+  shape[k->channel_last ? k->ndim + 1 : 1] = channels;
+  return k->ndim + 2;
+}
+
+static int weight_shape(const conv_t *k, int *shape) {
+  int cg = k->channels / groups_of(k);
+  int ndim = 0;
+  int d; // Iterator
+
+  if (k->type == NN_FUNCTION_DEPTHWISE_CONVOLUTION) {
+    shape[ndim++] = k->maps;
+  } else if (k->type == NN_FUNCTION_DECONVOLUTION) {
+    shape[ndim++] = k->channels;
+    shape[ndim++] = k->maps / k->group;
+  } else {
+    shape[ndim++] = k->maps;
+    if (!k->channel_last) {
+      shape[ndim++] = cg;
+    }
+  }
+  for (d = 0; d < k->ndim; d++) {
+    shape[ndim++] = k->kernel[d];
+  }
+  if (k->channel_last) {
+    shape[ndim++] = cg;
+  }
+  return ndim;
+}
+
+// Variables of x, w, b and y of network of case.
+typedef struct {
+  nn_data_type_t type[4];
+  int fp_pos[4];
+  const void *data[3]; // Data of parameters w and b, x has none.
+  const float *mean;    // Mean subtracted from input before x, or NULL.
+} conv_variables_t;
+
+static nn_network_t *build_conv(const conv_t *k, const conv_variables_t *cv) {
+  test_network_t n;
+  int x_shape[5], w_shape[5], b_shape[1] = {k->maps}, y_shape[5];
+  int out_shape[3];
+  int x_ndim, w_ndim, y_ndim, v[4], input;
+  nn_function_convolution_t conv;
+  nn_function_depthwise_convolution_t depthwise;
+  nn_function_deconvolution_t deconv;
+  nn_list_t pad, stride, dilation;
+
+  output_shape(k, out_shape);
+  x_ndim = io_shape(k, k->channels, k->size, x_shape);
+  w_ndim = weight_shape(k, w_shape);
+  y_ndim = io_shape(k, k->maps, out_shape, y_shape);
+
+  test_network_init(&n);
+  pad = test_list(&n, k->pad, k->ndim);
+  stride = test_list(&n, k->stride, k->ndim);
+  dilation = test_list(&n, k->dilation, k->ndim);
+  v[0] = test_typed_variable(&n, x_shape, x_ndim, cv->type[0], cv->fp_pos[0],
+                             0);
+  input = v[0];
+  if (cv->mean) {
+    static const float count[1] = {100};
+    static const int count_shape[1] = {1};
+    nn_function_mean_subtraction_t ms;
+    int ms_v[3];
+    ms_v[0] = input;
+    ms_v[1] = test_variable(&n, x_shape + 1, x_ndim - 1, cv->mean);
+    ms_v[2] = test_variable(&n, count_shape, 1, count);
+    v[0] = test_variable(&n, x_shape, x_ndim, 0);
+    memset(&ms, 0, sizeof(ms));
+    ms.base_axis = 1;
+    test_function(&n, &ms, sizeof(ms), NN_FUNCTION_MEAN_SUBTRACTION, ms_v, 3,
+                  v, 1);
+  }
+  v[1] = test_typed_variable(&n, w_shape, w_ndim, cv->type[1], cv->fp_pos[1],
+                             cv->data[1]);
+  v[2] = test_typed_variable(&n, b_shape, 1, cv->type[2], cv->fp_pos[2],
+                             cv->data[2]);
+  v[3] = test_typed_variable(&n, y_shape, y_ndim, cv->type[3], cv->fp_pos[3],
+                             0);
+  if (k->type == NN_FUNCTION_DEPTHWISE_CONVOLUTION) {
+    memset(&depthwise, 0, sizeof(depthwise));
+    depthwise.base_axis = 1;
+    depthwise.pad = pad;
+    depthwise.stride = stride;
+    depthwise.dilation = dilation;
+    depthwise.multiplier = k->group;
+    test_function(&n, &depthwise, sizeof(depthwise), k->type, v,
+                  2 + k->has_bias, v + 3, 1);
+  } else if (k->type == NN_FUNCTION_DECONVOLUTION) {
+    memset(&deconv, 0, sizeof(deconv));
+    deconv.base_axis = 1;
+    deconv.pad = pad;
+    deconv.stride = stride;
+    deconv.dilation = dilation;
+    deconv.group = k->group;
+    test_function(&n, &deconv, sizeof(deconv), k->type, v, 2 + k->has_bias,
+                  v + 3, 1);
+  } else {
+    memset(&conv, 0, sizeof(conv));
+    conv.base_axis = 1;
+    conv.pad = pad;
+    conv.stride = stride;
+    conv.dilation = dilation;
+    conv.group = k->group;
+    conv.channel_last = k->channel_last;
+    test_function(&n, &conv, sizeof(conv), k->type, v, 2 + k->has_bias,
+                  v + 3, 1);
+  }
+  return test_build(&n, &input, 1, v + 3, 1);
+}
+
+static void sizes_of(const conv_t *k, int *x_size, int *w_size,
+                     int *y_size) {
+  int out_shape[3];
+  output_shape(k, out_shape);
+  *x_size = k->batch * k->channels * spatial_size(k->size, k->ndim);
+  *w_size = k->maps * k->channels / groups_of(k) *
+            spatial_size(k->kernel, k->ndim);
+  *y_size = k->batch * k->maps * spatial_size(out_shape, k->ndim);
+}
+
+static void test_float(const conv_t *k, unsigned seed) {
+  conv_variables_t cv = {{NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT,
+                          NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT},
+                         {0, 0, 0, 0},
+                         {0, 0, 0}};
+  int x_size, w_size, y_size;
+  float *x, *w, *b, *y;
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->maps, seed + 2, 1.0f);
+  conv_reference(k, x, w, b, y);
+  cv.data[1] = w;
+  cv.data[2] = b;
+  test_check_network(k->name, build_conv(k, &cv), (const void *const[]){x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+}
+
+// MeanSubtraction before Convolution. Mean constant over each channel is
+// folded into bias by fusion, mean of each pixel is not.
+static void test_mean_subtraction(const conv_t *k, int per_pixel,
+                                  unsigned seed) {
+  conv_variables_t cv = {{NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT,
+                          NN_DATA_TYPE_FLOAT, NN_DATA_TYPE_FLOAT},
+                         {0, 0, 0, 0},
+                         {0, 0, 0}};
+  int map = spatial_size(k->size, k->ndim);
+  int x_size, w_size, y_size;
+  float *x, *mean, *subtracted, *w, *b, *y;
+  char name[96];
+  int i; // Iterator
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  mean = malloc(sizeof(float) * k->channels * map);
+  subtracted = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(x, x_size, seed, 4.0f);
+  for (i = 0; i < k->channels * map; i++) {
+    mean[i] = 0.5f * (i / map) + (per_pixel ? 0.25f * (i % 7) : 0.0f);
+  }
+  for (i = 0; i < x_size; i++) {
+    subtracted[i] = x[i] - mean[i % (k->channels * map)];
+  }
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->maps, seed + 2, 1.0f);
+  conv_reference(k, subtracted, w, b, y);
+  cv.data[1] = w;
+  cv.data[2] = b;
+  cv.mean = mean;
+  sprintf(name, "MeanSubtraction of each %s and %s",
+          per_pixel ? "pixel" : "channel", k->name);
+  test_check_network(name, build_conv(k, &cv), (const void *const[]){x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(mean);
+  free(subtracted);
+  free(w);
+  free(b);
+  free(y);
+}
+
+// int8 input and weight, whose accumulator is converted to output type once.
+static void test_fixed8(const conv_t *k, nn_data_type_t type, int fp_pos,
+                        unsigned seed) {
+  conv_variables_t cv = {
+      {NN_DATA_TYPE_INT8, NN_DATA_TYPE_INT8, NN_DATA_TYPE_FLOAT, type},
+      {4, 6, 0, fp_pos},
+      {0, 0, 0}};
+  int x_size, w_size, y_size;
+  float *x, *w, *b, *y;
+  int8_t *xi, *wi;
+  char name[64];
+  int i; // Iterator
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  xi = malloc(x_size);
+  wi = malloc(w_size);
+  test_fill(x, x_size, seed, 15.0f);
+  test_fill(w, w_size, seed + 1, 3.9f);
+  test_fill(b, k->maps, seed + 2, 8.0f);
+  test_round(x, x_size, 4);
+  test_round(w, w_size, 6);
+  for (i = 0; i < x_size; i++) {
+    xi[i] = (int8_t)ldexpf(x[i], 4);
+  }
+  for (i = 0; i < w_size; i++) {
+    wi[i] = (int8_t)ldexpf(w[i], 6);
+  }
+  cv.data[1] = wi;
+  cv.data[2] = b;
+  // Bias is rounded to fixed point position of accumulator.
+  test_round(b, k->maps, 10);
+  conv_reference(k, x, w, b, y);
+  if (type != NN_DATA_TYPE_FLOAT) {
+    float max = ldexpf(type == NN_DATA_TYPE_INT8 ? 127 : 32767, -fp_pos);
+    for (i = 0; i < y_size; i++) {
+      y[i] = ldexpf(truncf(ldexpf(y[i], fp_pos)), -fp_pos);
+      y[i] = y[i] > max ? max : y[i] < -max - ldexpf(1, -fp_pos)
+                                     ? -max - ldexpf(1, -fp_pos)
+                                     : y[i];
+    }
+  }
+  sprintf(name, "%s to type %d", k->name, type);
+  test_check_network(name, build_conv(k, &cv), (const void *const[]){xi},
+                     (const float *const[]){y}, 1e-6f);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(xi);
+  free(wi);
+}
+
+static void pack_sign(const float *values, int size, uint32_t *bits) {
+  int i; // Iterator
+  memset(bits, 0, test_data_size(NN_DATA_TYPE_SIGN, size));
+  for (i = 0; i < size; i++) {
+    if (values[i] > 0) {
+      bits[i / 32] |= 1u << (i % 32);
+    }
+  }
+}
+
+// SIGN input and weight, padded taps do not contribute.
+static void test_sign(const conv_t *k, unsigned seed) {
+  conv_variables_t cv = {
+      {NN_DATA_TYPE_SIGN, NN_DATA_TYPE_SIGN, NN_DATA_TYPE_FLOAT,
+       NN_DATA_TYPE_FLOAT},
+      {0, 0, 0, 0},
+      {0, 0, 0}};
+  int x_size, w_size, y_size;
+  float *x, *w, *b, *y;
+  uint32_t *xs, *ws;
+  int i; // Iterator
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  xs = malloc(test_data_size(NN_DATA_TYPE_SIGN, x_size));
+  ws = malloc(test_data_size(NN_DATA_TYPE_SIGN, w_size));
+  test_fill(x, x_size, seed, 1.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->maps, seed + 2, 4.0f);
+  for (i = 0; i < x_size; i++) {
+    x[i] = x[i] >= 0 ? 1.0f : -1.0f;
+  }
+  for (i = 0; i < w_size; i++) {
+    w[i] = w[i] >= 0 ? 1.0f : -1.0f;
+  }
+  pack_sign(x, x_size, xs);
+  pack_sign(w, w_size, ws);
+  conv_reference(k, x, w, b, y);
+  cv.data[1] = ws;
+  cv.data[2] = b;
+  test_check_network(k->name, build_conv(k, &cv), (const void *const[]){xs},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(xs);
+  free(ws);
+}
+
+// Pointwise convolution whose weight has zero blocks.
+static void test_sparse(const conv_t *k, unsigned seed) {
+  int x_size, w_size, y_size;
+  int x_shape[5], w_shape[5], b_shape[1] = {k->maps}, y_shape[5];
+  int out_shape[3], x_ndim, w_ndim, y_ndim, v[4];
+  float *x, *w, *b, *y;
+  test_network_t n;
+  nn_function_convolution_t conv;
+  int i; // Iterator
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->maps, seed + 2, 1.0f);
+  // Two of three blocks of 4 columns are zero.
+  for (i = 0; i < w_size; i++) {
+    if (i / 4 % 3) {
+      w[i] = 0;
+    }
+  }
+  conv_reference(k, x, w, b, y);
+
+  output_shape(k, out_shape);
+  x_ndim = io_shape(k, k->channels, k->size, x_shape);
+  w_ndim = weight_shape(k, w_shape);
+  y_ndim = io_shape(k, k->maps, out_shape, y_shape);
+  test_network_init(&n);
+  memset(&conv, 0, sizeof(conv));
+  conv.base_axis = 1;
+  conv.pad = test_list(&n, k->pad, k->ndim);
+  conv.stride = test_list(&n, k->stride, k->ndim);
+  conv.dilation = test_list(&n, k->dilation, k->ndim);
+  conv.group = k->group;
+  v[0] = test_variable(&n, x_shape, x_ndim, 0);
+  v[1] = test_sparse_variable(&n, w_shape, w_ndim, w, 4);
+  v[2] = test_variable(&n, b_shape, 1, b);
+  v[3] = test_variable(&n, y_shape, y_ndim, 0);
+  test_function(&n, &conv, sizeof(conv), NN_FUNCTION_CONVOLUTION, v, 3,
+                v + 3, 1);
+  test_check_network(k->name, test_build(&n, v, 1, v + 3, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+}
+
+// Weight stored as FLOAT16 or BFLOAT16, reference uses rounded weight.
+static void test_half(const conv_t *k, nn_data_type_t type, unsigned seed) {
+  conv_variables_t cv = {{NN_DATA_TYPE_FLOAT, type, NN_DATA_TYPE_FLOAT,
+                          NN_DATA_TYPE_FLOAT},
+                         {0, 0, 0, 0},
+                         {0, 0, 0}};
+  int x_size, w_size, y_size;
+  float *x, *w, *b, *y;
+  uint16_t *half;
+  char name[64];
+  int i; // Iterator
+
+  sizes_of(k, &x_size, &w_size, &y_size);
+  x = malloc(sizeof(float) * x_size);
+  w = malloc(sizeof(float) * w_size);
+  b = malloc(sizeof(float) * k->maps);
+  y = malloc(sizeof(float) * y_size);
+  half = malloc(sizeof(uint16_t) * w_size);
+  test_fill(x, x_size, seed, 4.0f);
+  test_fill(w, w_size, seed + 1, 1.0f);
+  test_fill(b, k->maps, seed + 2, 1.0f);
+  for (i = 0; i < w_size; i++) {
+    half[i] = test_to_half(type, w[i]);
+    w[i] = test_from_half(type, half[i]);
+  }
+  conv_reference(k, x, w, b, y);
+  cv.data[1] = half;
+  cv.data[2] = b;
+  sprintf(name, "%s of weight type %d", k->name, type);
+  test_check_network(name, build_conv(k, &cv), (const void *const[]){x},
+                     (const float *const[]){y}, TOLERANCE);
+  free(x);
+  free(w);
+  free(b);
+  free(y);
+  free(half);
+}
+
+#define CONV NN_FUNCTION_CONVOLUTION
+#define DEPTHWISE NN_FUNCTION_DEPTHWISE_CONVOLUTION
+#define DECONV NN_FUNCTION_DECONVOLUTION
+
+// name, type, batch, channels, maps, group, ndim, size, kernel, stride, pad,
+// dilation, channel_last, has_bias
+static const conv_t float_cases[] = {
+    {"Convolution 3x3", CONV, 2, 3, 4, 1, 2, {8, 9}, {3, 3}, {1, 1},
+     {1, 1}, {1, 1}, 0, 1},
+    {"Convolution without bias", CONV, 1, 3, 5, 1, 2, {7, 6}, {2, 3},
+     {1, 1}, {0, 1}, {1, 1}, 0, 0},
+    {"Convolution with groups and stride", CONV, 2, 4, 6, 2, 2, {9, 10},
+     {3, 2}, {2, 2}, {1, 0}, {1, 1}, 0, 1},
+    {"Convolution with dilation", CONV, 1, 3, 5, 1, 2, {11, 12}, {3, 3},
+     {1, 2}, {2, 2}, {2, 2}, 0, 1},
+    {"Convolution 1D", CONV, 2, 3, 4, 1, 1, {17}, {5}, {2}, {2}, {1}, 0, 1},
+    {"Convolution 3D", CONV, 1, 2, 3, 1, 3, {5, 6, 7}, {3, 2, 3},
+     {1, 2, 1}, {1, 1, 1}, {1, 1, 1}, 0, 1},
+    // im2col buffer of 144 rows and 9216 columns exceeds its limit.
+    {"Convolution in tiles", CONV, 1, 16, 8, 1, 2, {100, 100}, {3, 3},
+     {1, 1}, {0, 0}, {2, 2}, 0, 1},
+    {"DepthwiseConvolution", DEPTHWISE, 2, 3, 6, 2, 2, {9, 8}, {3, 3},
+     {1, 1}, {1, 1}, {1, 1}, 0, 1},
+    {"Winograd with groups", CONV, 2, 4, 6, 2, 2, {9, 11}, {3, 3}, {1, 1},
+     {0, 0}, {1, 1}, 0, 1},
+    {"Winograd with odd outputs", CONV, 1, 5, 3, 1, 2, {7, 9}, {3, 3},
+     {1, 1}, {1, 1}, {1, 1}, 0, 0},
+    {"Winograd in tiles", CONV, 1, 16, 8, 1, 2, {100, 100}, {3, 3},
+     {1, 1}, {1, 1}, {1, 1}, 0, 1},
+    {"Convolution channel last", CONV, 2, 3, 4, 1, 2, {8, 9}, {3, 3},
+     {1, 1}, {1, 1}, {1, 1}, 1, 1},
+    {"Convolution channel last with groups", CONV, 1, 4, 6, 2, 2, {9, 10},
+     {3, 2}, {2, 1}, {1, 0}, {1, 2}, 1, 1},
+    {"Convolution channel last 1x1", CONV, 2, 8, 5, 1, 2, {5, 6}, {1, 1},
+     {1, 1}, {0, 0}, {1, 1}, 1, 0},
+    {"DepthwiseConvolution 3x3", DEPTHWISE, 2, 5, 5, 1, 2, {20, 20},
+     {3, 3}, {1, 1}, {1, 1}, {1, 1}, 0, 1},
+    {"DepthwiseConvolution 3x3 stride 2", DEPTHWISE, 1, 4, 8, 2, 2,
+     {21, 21}, {3, 3}, {2, 2}, {1, 1}, {1, 1}, 0, 1},
+    {"DepthwiseConvolution 5x5", DEPTHWISE, 1, 3, 3, 1, 2, {19, 19},
+     {5, 5}, {1, 1}, {2, 2}, {1, 1}, 0, 0},
+    {"DepthwiseConvolution 5x5 stride 2", DEPTHWISE, 2, 3, 6, 2, 2,
+     {22, 22}, {5, 5}, {2, 2}, {2, 2}, {1, 1}, 0, 1},
+    {"Deconvolution", DECONV, 2, 3, 4, 1, 2, {5, 6}, {3, 3}, {1, 1},
+     {1, 1}, {1, 1}, 0, 1},
+    {"Deconvolution with stride", DECONV, 1, 4, 6, 2, 2, {5, 7}, {4, 3},
+     {2, 2}, {1, 0}, {1, 1}, 0, 1},
+    {"Deconvolution with dilation", DECONV, 1, 2, 3, 1, 2, {6, 5}, {3, 2},
+     {2, 1}, {1, 1}, {2, 2}, 0, 0},
+    {"Deconvolution 1D", DECONV, 2, 3, 2, 1, 1, {9}, {4}, {3}, {1}, {1},
+     0, 1},
+    {"Convolution 1x1", CONV, 2, 16, 12, 1, 2, {7, 9}, {1, 1}, {1, 1},
+     {0, 0}, {1, 1}, 0, 1},
+    {"Convolution 1x1 with groups", CONV, 1, 8, 6, 2, 2, {5, 5}, {1, 1},
+     {1, 1}, {0, 0}, {1, 1}, 0, 0},
+    {"Convolution 1x1 stride 2", CONV, 1, 4, 3, 1, 2, {9, 8}, {1, 1},
+     {2, 2}, {0, 0}, {1, 1}, 0, 1},
+};
+
+static const conv_t mean_subtraction_case = {
+    "Convolution with groups", CONV, 2, 4, 6, 2, 2, {9, 10}, {3, 2},
+    {2, 1}, {0, 0}, {1, 1}, 0, 1};
+
+static const conv_t fixed8_case = {
+    "Convolution int8", CONV, 2, 4, 6, 2, 2, {7, 8}, {3, 3}, {1, 1},
+    {1, 1}, {1, 1}, 0, 1};
+
+static const conv_t sign_cases[] = {
+    {"Convolution SIGN", CONV, 2, 5, 4, 1, 2, {7, 8}, {3, 3}, {1, 1},
+     {1, 1}, {1, 1}, 0, 1},
+    {"Convolution SIGN with groups", CONV, 1, 40, 6, 2, 2, {6, 5}, {3, 3},
+     {2, 1}, {0, 1}, {1, 1}, 0, 0},
+};
+
+static const conv_t sparse_case = {
+    "Convolution 1x1 block sparse", CONV, 2, 24, 10, 1, 2, {6, 7}, {1, 1},
+    {1, 1}, {0, 0}, {1, 1}, 0, 1};
+
+static const conv_t half_case = {
+    "Convolution", CONV, 2, 6, 8, 1, 2, {9, 10}, {3, 3}, {1, 1}, {1, 1},
+    {1, 1}, 0, 1};
+
+int main(void) {
+  int i; // Iterator
+
+  for (i = 0; i < (int)(sizeof(float_cases) / sizeof(float_cases[0]));
+       i++) {
+    test_float(float_cases + i, 100 + 3 * i);
+  }
+  test_mean_subtraction(&mean_subtraction_case, 0, 70);
+  test_mean_subtraction(&mean_subtraction_case, 1, 73);
+  test_fixed8(&fixed8_case, NN_DATA_TYPE_FLOAT, 0, 10);
+  test_fixed8(&fixed8_case, NN_DATA_TYPE_INT16, 8, 20);
+  test_fixed8(&fixed8_case, NN_DATA_TYPE_INT8, 3, 30);
+  for (i = 0; i < (int)(sizeof(sign_cases) / sizeof(sign_cases[0])); i++) {
+    test_sign(sign_cases + i, 40 + 3 * i);
+  }
+  test_sparse(&sparse_case, 50);
+  test_half(&half_case, NN_DATA_TYPE_FLOAT16, 60);
+  test_half(&half_case, NN_DATA_TYPE_BFLOAT16, 63);
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
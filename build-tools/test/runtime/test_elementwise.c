@@ -0,0 +1,501 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Element wise and normalizing functions compared with loops in double.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define TOLERANCE (1e-5f)
+
+static int size_of(const int *shape, int ndim) {
+  int size = 1;
+  int d; // Iterator
+  for (d = 0; d < ndim; d++) {
+    size *= shape[d];
+  }
+  return size;
+}
+
+// Network of one function of x, followed by parameters.
+static void check_function(const char *name, void *function, size_t size,
+                           int type, const int *x_shape, const float *x,
+                           const float *const *parameters,
+                           const int *const *shapes, int num_of_parameters,
+                           const int *y_shape, const float *y, int ndim) {
+  test_network_t n;
+  int v[8];
+  int i; // Iterator
+
+  test_network_init(&n);
+  v[0] = test_variable(&n, x_shape, ndim, 0);
+  for (i = 0; i < num_of_parameters; i++) {
+    v[i + 1] = test_variable(&n, shapes[i], ndim, parameters[i]);
+  }
+  v[num_of_parameters + 1] = test_variable(&n, y_shape, ndim, 0);
+  test_function(&n, function, size, type, v, num_of_parameters + 1,
+                v + num_of_parameters + 1, 1);
+  test_check_network(name,
+                     test_build(&n, v, 1, v + num_of_parameters + 1, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     TOLERANCE);
+}
+
+// Arithmetic of two inputs broadcast to output
+
+typedef enum {
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_POW,
+  OP_MAXIMUM,
+  OP_MINIMUM,
+  END_OF_OP
+} op_t;
+
+static const int op_types[END_OF_OP] = {
+    NN_FUNCTION_ADD2, NN_FUNCTION_SUB2,     NN_FUNCTION_MUL2,
+    NN_FUNCTION_DIV2, NN_FUNCTION_POW2,     NN_FUNCTION_MAXIMUM2,
+    NN_FUNCTION_MINIMUM2};
+
+static const char *op_names[END_OF_OP] = {"Add2", "Sub2",     "Mul2",
+                                          "Div2", "Pow2",     "Maximum2",
+                                          "Minimum2"};
+
+static double calc(op_t op, double a, double b) {
+  switch (op) {
+  case OP_ADD:
+    return a + b;
+  case OP_SUB:
+    return a - b;
+  case OP_MUL:
+    return a * b;
+  case OP_DIV:
+    return a / b;
+  case OP_POW:
+    return pow(a, b);
+  case OP_MAXIMUM:
+    return a > b ? a : b;
+  default:
+    return a < b ? a : b;
+  }
+}
+
+// Index of input of shape at position of output, broadcast axes of size 1.
+static int broadcast_index(const int *shape, const int *position) {
+  int index = 0;
+  int d; // Iterator
+  for (d = 0; d < 4; d++) {
+    index = index * shape[d] + (shape[d] == 1 ? 0 : position[d]);
+  }
+  return index;
+}
+
+static void test_arithmetic(op_t op, const int *a_shape, const int *b_shape,
+                            unsigned seed) {
+  int y_shape[4], position[4];
+  int a_size = size_of(a_shape, 4), b_size = size_of(b_shape, 4);
+  int y_size;
+  float *a = malloc(sizeof(float) * a_size);
+  float *b = malloc(sizeof(float) * b_size);
+  float *y;
+  nn_function_add2_t f; // Others have no argument.
+  char name[96];
+  int i, d; // Iterators
+
+  for (d = 0; d < 4; d++) {
+    y_shape[d] = a_shape[d] > b_shape[d] ? a_shape[d] : b_shape[d];
+  }
+  y_size = size_of(y_shape, 4);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(a, a_size, seed, 8.0f);
+  test_fill(b, b_size, seed + 1, 4.0f);
+  for (i = 0; op == OP_POW && i < a_size; i++) {
+    a[i] = fabsf(a[i]) + 0.5f;
+  }
+  for (i = 0; op == OP_DIV && i < b_size; i++) {
+    b[i] += b[i] < 0 ? -0.5f : 0.5f;
+  }
+  for (i = 0; i < y_size; i++) {
+    int t = i;
+    for (d = 3; d >= 0; d--) {
+      position[d] = t % y_shape[d];
+      t /= y_shape[d];
+    }
+    y[i] = (float)calc(op, a[broadcast_index(a_shape, position)],
+                       b[broadcast_index(b_shape, position)]);
+  }
+  memset(&f, 0, sizeof(f));
+  sprintf(name, "%s of (%d,%d,%d,%d) and (%d,%d,%d,%d)", op_names[op],
+          a_shape[0], a_shape[1], a_shape[2], a_shape[3], b_shape[0],
+          b_shape[1], b_shape[2], b_shape[3]);
+  check_function(name, &f,
+                 op == OP_ADD ? sizeof(nn_function_add2_t)
+                              : sizeof(nn_function_sub2_t),
+                 op_types[op], a_shape, a, (const float *const[]){b},
+                 (const int *const[]){b_shape}, 1, y_shape, y, 4);
+  free(a);
+  free(b);
+  free(y);
+}
+
+// Transcendental activations
+
+typedef enum {
+  ACT_EXP,
+  ACT_LOG,
+  ACT_SIGMOID,
+  ACT_TANH,
+  ACT_SWISH,
+  ACT_ELU,
+  ACT_SELU,
+  ACT_CELU,
+  END_OF_ACT
+} act_t;
+
+static const int act_types[END_OF_ACT] = {
+    NN_FUNCTION_EXP,   NN_FUNCTION_LOG, NN_FUNCTION_SIGMOID,
+    NN_FUNCTION_TANH,  NN_FUNCTION_SWISH, NN_FUNCTION_ELU,
+    NN_FUNCTION_SELU, NN_FUNCTION_CELU};
+
+static const char *act_names[END_OF_ACT] = {
+    "Exp", "Log", "Sigmoid", "Tanh", "Swish", "ELU", "SELU", "CELU"};
+
+#define ALPHA (1.3f)
+#define SCALE (1.05f)
+
+static double elu(double x) { return x > 0 ? x : ALPHA * (exp(x) - 1); }
+
+static double activate(act_t act, double x) {
+  switch (act) {
+  case ACT_EXP:
+    return exp(x);
+  case ACT_LOG:
+    return log(x);
+  case ACT_SIGMOID:
+    return 1 / (1 + exp(-x));
+  case ACT_TANH:
+    return tanh(x);
+  case ACT_SWISH:
+    return x / (1 + exp(-x));
+  case ACT_SELU:
+    return SCALE * elu(x);
+  default:
+    return elu(x);
+  }
+}
+
+static void test_activation(act_t act, int size, unsigned seed) {
+  // CELU concatenates ELU of x and -x along axis 1.
+  int x_shape[2] = {3, size}, y_shape[2] = {3, act == ACT_CELU ? 2 * size
+                                                               : size};
+  float *x = malloc(sizeof(float) * 3 * size);
+  float *y = malloc(sizeof(float) * 3 * y_shape[1]);
+  union {
+    nn_function_elu_t elu;
+    nn_function_selu_t selu;
+    nn_function_celu_t celu;
+  } f;
+  char name[64];
+  int i, j; // Iterators
+
+  test_fill(x, 3 * size, seed, 24.0f);
+  for (i = 0; act == ACT_LOG && i < 3 * size; i++) {
+    x[i] = fabsf(x[i]) + 1e-3f;
+  }
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < size; j++) {
+      double v = x[i * size + j];
+      y[i * y_shape[1] + j] = (float)activate(act, v);
+      if (act == ACT_CELU) {
+        y[i * y_shape[1] + size + j] = (float)activate(act, -v);
+      }
+    }
+  }
+  memset(&f, 0, sizeof(f));
+  if (act == ACT_ELU) {
+    f.elu.alpha = ALPHA;
+  } else if (act == ACT_SELU) {
+    f.selu.scale = SCALE;
+    f.selu.alpha = ALPHA;
+  } else if (act == ACT_CELU) {
+    f.celu.alpha = ALPHA;
+    f.celu.axis = 1;
+  }
+  sprintf(name, "%s of %d values", act_names[act], size);
+  check_function(name, &f, sizeof(f), act_types[act], x_shape, x, 0, 0, 0,
+                 y_shape, y, 2);
+  free(x);
+  free(y);
+}
+
+// Softmax and LogSoftmax along axis of 4D shape.
+static void test_softmax(int type, const int *shape, int axis,
+                         unsigned seed) {
+  int size = size_of(shape, 4);
+  int inner = size_of(shape + axis + 1, 3 - axis);
+  int outer = size / (inner * shape[axis]);
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  nn_function_softmax_t f; // LogSoftmax has same arguments.
+  char name[96];
+  int o, i, c; // Iterators
+
+  test_fill(x, size, seed, 30.0f);
+  for (o = 0; o < outer; o++) {
+    for (i = 0; i < inner; i++) {
+      const float *xr = x + o * shape[axis] * inner + i;
+      float *yr = y + o * shape[axis] * inner + i;
+      double max = xr[0], sum = 0;
+      for (c = 1; c < shape[axis]; c++) {
+        max = xr[c * inner] > max ? xr[c * inner] : max;
+      }
+      for (c = 0; c < shape[axis]; c++) {
+        sum += exp(xr[c * inner] - max);
+      }
+      for (c = 0; c < shape[axis]; c++) {
+        double v = xr[c * inner] - max;
+        yr[c * inner] = (float)(type == NN_FUNCTION_SOFTMAX ? exp(v) / sum
+                                                            : v - log(sum));
+      }
+    }
+  }
+  memset(&f, 0, sizeof(f));
+  f.axis = axis;
+  sprintf(name, "%s of (%d,%d,%d,%d) along axis %d",
+          type == NN_FUNCTION_SOFTMAX ? "Softmax" : "LogSoftmax", shape[0],
+          shape[1], shape[2], shape[3], axis);
+  check_function(name, &f, sizeof(f), type, shape, x, 0, 0, 0, shape, y, 4);
+  free(x);
+  free(y);
+}
+
+// BatchNormalization along axis of 4D shape, with running statistics or
+// statistics of batch.
+static void test_batch_normalization(const int *shape, int axis,
+                                     int batch_stat, unsigned seed) {
+  const float eps = 1e-5f;
+  int size = size_of(shape, 4);
+  int channels = shape[axis];
+  int inner = size_of(shape + axis + 1, 3 - axis);
+  int outer = size / (inner * channels);
+  int stat_shape[4] = {1, 1, 1, 1};
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  float *stats = malloc(sizeof(float) * 4 * channels);
+  float *beta = stats, *gamma = stats + channels;
+  float *mean = stats + 2 * channels, *var = stats + 3 * channels;
+  nn_function_batch_normalization_t f;
+  test_network_t n;
+  char name[96];
+  int v[6];
+  int o, i, c; // Iterators
+
+  test_fill(x, size, seed, 8.0f);
+  test_fill(stats, 4 * channels, seed + 1, 2.0f);
+  for (c = 0; c < channels; c++) {
+    mean[c] *= 2.0f;
+    var[c] += 1.5f;
+  }
+  for (c = 0; c < channels; c++) {
+    double m = mean[c], s = var[c];
+    if (batch_stat) {
+      m = s = 0;
+      for (o = 0; o < outer; o++) {
+        for (i = 0; i < inner; i++) {
+          m += x[(o * channels + c) * inner + i];
+        }
+      }
+      m /= outer * inner;
+      for (o = 0; o < outer; o++) {
+        for (i = 0; i < inner; i++) {
+          double d = x[(o * channels + c) * inner + i] - m;
+          s += d * d;
+        }
+      }
+      s /= outer * inner;
+    }
+    for (o = 0; o < outer; o++) {
+      for (i = 0; i < inner; i++) {
+        int index = (o * channels + c) * inner + i;
+        y[index] = (float)((x[index] - m) / sqrt(s + eps) * gamma[c] +
+                           beta[c]);
+      }
+    }
+  }
+
+  stat_shape[axis] = channels;
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.axes = test_list(&n, &axis, 1);
+  f.decay_rate = 0.9f;
+  f.eps = eps;
+  f.batch_stat = batch_stat;
+  v[0] = test_variable(&n, shape, 4, 0);
+  v[1] = test_variable(&n, stat_shape, 4, beta);
+  v[2] = test_variable(&n, stat_shape, 4, gamma);
+  v[3] = test_variable(&n, stat_shape, 4, mean);
+  v[4] = test_variable(&n, stat_shape, 4, var);
+  v[5] = test_variable(&n, shape, 4, 0);
+  test_function(&n, &f, sizeof(f), NN_FUNCTION_BATCH_NORMALIZATION, v, 5,
+                v + 5, 1);
+  sprintf(name, "BatchNormalization of (%d,%d,%d,%d) along axis %d%s",
+          shape[0], shape[1], shape[2], shape[3], axis,
+          batch_stat ? " with batch stat" : "");
+  test_check_network(name, test_build(&n, v, 1, v + 5, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     1e-4f);
+  free(x);
+  free(y);
+  free(stats);
+}
+
+// PReLU of slope of each channel at base axis, or one slope if base_axis
+// is negative.
+static void test_prelu(const int *shape, int base_axis, unsigned seed) {
+  int size = size_of(shape, 4);
+  int channels = base_axis < 0 ? 1 : shape[base_axis];
+  int inner = base_axis < 0 ? 1 : size_of(shape + base_axis + 1,
+                                          3 - base_axis);
+  int slope_shape[4] = {1, 1, 1, 1};
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  float *slope = malloc(sizeof(float) * channels);
+  nn_function_prelu_t f;
+  char name[96];
+  int i; // Iterator
+
+  test_fill(x, size, seed, 8.0f);
+  test_fill(slope, channels, seed + 1, 1.0f);
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] >= 0 ? x[i] : x[i] * slope[i / inner % channels];
+  }
+  memset(&f, 0, sizeof(f));
+  f.base_axis = base_axis < 0 ? 1 : base_axis;
+  slope_shape[f.base_axis] = channels;
+  sprintf(name, "PReLU of (%d,%d,%d,%d) at base axis %d", shape[0],
+          shape[1], shape[2], shape[3], base_axis);
+  check_function(name, &f, sizeof(f), NN_FUNCTION_PRELU, shape, x,
+                 (const float *const[]){slope},
+                 (const int *const[]){slope_shape}, 1, shape, y, 4);
+  free(x);
+  free(y);
+  free(slope);
+}
+
+static void test_leaky_relu(int size, unsigned seed) {
+  int shape[1] = {size};
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * size);
+  nn_function_leaky_relu_t f;
+  char name[64];
+  int i; // Iterator
+
+  test_fill(x, size, seed, 8.0f);
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] > 0 ? x[i] : x[i] * 0.1f;
+  }
+  memset(&f, 0, sizeof(f));
+  f.alpha = 0.1f;
+  sprintf(name, "LeakyReLU of %d values", size);
+  check_function(name, &f, sizeof(f), NN_FUNCTION_LEAKY_RELU, shape, x, 0, 0,
+                 0, shape, y, 1);
+  free(x);
+  free(y);
+}
+
+// CReLU concatenates ReLU of x and -x along axis.
+static void test_crelu(const int *shape, int axis, unsigned seed) {
+  int size = size_of(shape, 4);
+  int row = size_of(shape + axis, 4 - axis);
+  int y_shape[4];
+  float *x = malloc(sizeof(float) * size);
+  float *y = malloc(sizeof(float) * 2 * size);
+  nn_function_crelu_t f;
+  char name[96];
+  int i; // Iterator
+
+  test_fill(x, size, seed, 8.0f);
+  for (i = 0; i < size; i++) {
+    int o = i / row, j = i % row;
+    y[2 * o * row + j] = x[i] > 0 ? x[i] : 0;
+    y[(2 * o + 1) * row + j] = x[i] < 0 ? -x[i] : 0;
+  }
+  memcpy(y_shape, shape, sizeof(y_shape));
+  y_shape[axis] *= 2;
+  memset(&f, 0, sizeof(f));
+  f.axis = axis;
+  sprintf(name, "CReLU of (%d,%d,%d,%d) along axis %d", shape[0], shape[1],
+          shape[2], shape[3], axis);
+  check_function(name, &f, sizeof(f), NN_FUNCTION_CRELU, shape, x, 0, 0, 0,
+                 y_shape, y, 4);
+  free(x);
+  free(y);
+}
+
+int main(void) {
+  // Pairs of shapes of a and b.
+  static const int shapes[][2][4] = {
+      {{2, 3, 4, 5}, {2, 3, 4, 5}}, {{2, 3, 4, 5}, {1, 3, 1, 5}},
+      {{2, 1, 4, 1}, {1, 3, 1, 5}}, {{2, 3, 4, 5}, {2, 3, 4, 1}},
+      {{3, 1, 7, 9}, {1, 1, 1, 1}}, {{1, 1, 1, 37}, {4, 5, 1, 37}},
+  };
+  static const int sizes[] = {1, 7, 37, 1000};
+  int a, s; // Iterators
+  static const int softmax_shape[4] = {2, 5, 3, 7};
+  static const int row_shape[4] = {3, 4, 1, 1037};
+  static const int bn_shapes[][4] = {{2, 5, 3, 4}, {3, 2, 4, 16}};
+  static const int prelu_shape[4] = {2, 6, 5, 7};
+  static const int last_shape[4] = {2, 5, 7, 6};
+  int op, i; // Iterators
+
+  for (op = 0; op < END_OF_OP; op++) {
+    for (i = 0; i < (int)(sizeof(shapes) / sizeof(shapes[0])); i++) {
+      test_arithmetic((op_t)op, shapes[i][0], shapes[i][1], op * 10 + i);
+    }
+  }
+  for (a = 0; a < END_OF_ACT; a++) {
+    for (s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+      test_activation((act_t)a, sizes[s], 100 + a * 10 + s);
+    }
+  }
+  for (i = 0; i < 4; i++) {
+    test_softmax(NN_FUNCTION_SOFTMAX, softmax_shape, i, 200 + i);
+    test_softmax(NN_FUNCTION_LOG_SOFTMAX, softmax_shape, i, 210 + i);
+  }
+  test_softmax(NN_FUNCTION_SOFTMAX, row_shape, 3, 220);
+  test_softmax(NN_FUNCTION_LOG_SOFTMAX, row_shape, 3, 221);
+  for (i = 0; i < 2; i++) {
+    test_batch_normalization(bn_shapes[i], 1, 0, 230 + i);
+    test_batch_normalization(bn_shapes[i], 3, 0, 232 + i);
+    test_batch_normalization(bn_shapes[i], 1, 1, 234 + i);
+  }
+  test_prelu(prelu_shape, 1, 240);
+  test_prelu(last_shape, 3, 241);
+  test_prelu(prelu_shape, 2, 242);
+  test_prelu(prelu_shape, -1, 243);
+  for (i = 0; i < 4; i++) {
+    test_leaky_relu(i == 3 ? 1037 : 1 + 5 * i, 250 + i);
+  }
+  test_crelu(prelu_shape, 1, 260);
+  test_crelu(prelu_shape, 3, 261);
+  test_crelu(last_shape, 0, 262);
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
@@ -0,0 +1,930 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Functions compared with naive references, run plain, with planning, fusion
+// and simplification, and with threads.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define TOLERANCE (1e-4f)
+
+// Network of one function whose inputs are network inputs or parameters.
+static nn_network_t *single_function(test_network_t *n, void *function,
+                                     size_t size, int type, const int *inputs,
+                                     int num_of_inputs,
+                                     int num_of_network_inputs,
+                                     const int *outputs, int num_of_outputs) {
+  test_function(n, function, size, type, inputs, num_of_inputs, outputs,
+                num_of_outputs);
+  return test_build(n, inputs, num_of_network_inputs, outputs,
+                    num_of_outputs);
+}
+
+// Reductions
+
+typedef enum {
+  REDUCE_SUM,
+  REDUCE_MEAN,
+  REDUCE_PROD,
+  REDUCE_MAX,
+  REDUCE_MIN,
+  END_OF_REDUCE
+} reduce_t;
+
+static const int reduce_types[END_OF_REDUCE] = {
+    NN_FUNCTION_SUM, NN_FUNCTION_MEAN, NN_FUNCTION_PROD, NN_FUNCTION_MAX,
+    NN_FUNCTION_MIN};
+static const char *reduce_names[END_OF_REDUCE] = {"Sum", "Mean", "Prod",
+                                                  "Max", "Min"};
+
+// Reduce 4D x along axes in mask. Index is position of max or min in order
+// of reduced axes.
+static void reduce_reference(reduce_t op, const int *shape, unsigned mask,
+                             const float *x, float *y, float *index) {
+  int total = shape[0] * shape[1] * shape[2] * shape[3];
+  int outer = 1, count;
+  int i, a; // Iterators
+
+  for (a = 0; a < 4; a++) {
+    outer *= (mask >> a & 1) ? 1 : shape[a];
+  }
+  count = total / outer;
+  for (i = 0; i < total; i++) {
+    int pos[4], t = i, o = 0, r = 0;
+    for (a = 3; a >= 0; a--) {
+      pos[a] = t % shape[a];
+      t /= shape[a];
+    }
+    for (a = 0; a < 4; a++) {
+      if (mask >> a & 1) {
+        r = r * shape[a] + pos[a];
+      } else {
+        o = o * shape[a] + pos[a];
+      }
+    }
+    if (r == 0) {
+      y[o] = x[i];
+      index[o] = 0;
+    } else if (op == REDUCE_SUM || op == REDUCE_MEAN) {
+      y[o] += x[i];
+    } else if (op == REDUCE_PROD) {
+      y[o] *= x[i];
+    } else if (op == REDUCE_MAX ? x[i] > y[o] : x[i] < y[o]) {
+      y[o] = x[i];
+      index[o] = (float)r;
+    }
+  }
+  if (op == REDUCE_MEAN) {
+    for (i = 0; i < outer; i++) {
+      y[i] /= count;
+    }
+  }
+}
+
+static void test_reductions(void) {
+  static const int shape[4] = {2, 3, 8, 5};
+  static const unsigned masks[] = {1, 2, 4, 8, 5, 6, 10, 12, 14, 15};
+  const int total = shape[0] * shape[1] * shape[2] * shape[3];
+  float x[2 * 3 * 8 * 5], y[2 * 3 * 8 * 5], index[2 * 3 * 8 * 5];
+  int m, i, a; // Iterators
+  reduce_t op;
+
+  for (m = 0; m < (int)(sizeof(masks) / sizeof(masks[0])); m++) {
+    for (op = REDUCE_SUM; op < END_OF_REDUCE; op++) {
+      int indexed = op == REDUCE_MAX || op == REDUCE_MIN;
+      int variant; // keep_dims, with_index or only_index
+      for (i = 0; i < total; i++) {
+        x[i] = op == REDUCE_PROD ? 1.0f + 0.01f * sinf((float)i)
+                                 : (float)((i * 37) % 101) - 50.0f +
+                                       0.25f * (i % 3);
+      }
+      reduce_reference(op, shape, masks[m], x, y, index);
+      for (variant = 0; variant < (indexed ? 4 : 2); variant++) {
+        test_network_t n;
+        nn_function_max_t f; // Same layout as others with less members.
+        int axes[4], out_shape[4], num_axes = 0, out_ndim = 0;
+        int keep_dims = variant == 1;
+        const float *references[2];
+        int v[3], num_of_outputs = 1;
+        char name[64];
+
+        for (a = 0; a < 4; a++) {
+          if (masks[m] >> a & 1) {
+            axes[num_axes++] = a;
+            if (keep_dims) {
+              out_shape[out_ndim++] = 1;
+            }
+          } else {
+            out_shape[out_ndim++] = shape[a];
+          }
+        }
+        test_network_init(&n);
+        memset(&f, 0, sizeof(f));
+        f.axes = test_list(&n, axes, num_axes);
+        f.keep_dims = keep_dims;
+        f.with_index = variant == 2;
+        f.only_index = variant == 3;
+        v[0] = test_variable(&n, shape, 4, 0);
+        v[1] = test_variable(&n, out_shape, out_ndim, 0);
+        references[0] = variant == 3 ? index : y;
+        references[1] = index;
+        if (variant == 2) {
+          v[2] = test_variable(&n, out_shape, out_ndim, 0);
+          num_of_outputs = 2;
+        }
+        sprintf(name, "%s of axes %x variant %d", reduce_names[op], masks[m],
+                variant);
+        test_check_network(name,
+                           single_function(&n, &f, sizeof(f),
+                                           reduce_types[op], v, 1, 1, v + 1,
+                                           num_of_outputs),
+                           (const void *const[]){x}, references, 1e-5f);
+      }
+      if ((op == REDUCE_SUM || op == REDUCE_MEAN) && masks[m] == 15) {
+        test_network_t n;
+        nn_function_t f;
+        int one[1] = {1}, v[2];
+
+        memset(&f, 0, sizeof(f));
+        test_network_init(&n);
+        v[0] = test_variable(&n, shape, 4, 0);
+        v[1] = test_variable(&n, one, 1, 0);
+        test_check_network(op == REDUCE_SUM ? "ReduceSum" : "ReduceMean",
+                           single_function(&n, &f, sizeof(f),
+                                           op == REDUCE_SUM
+                                               ? NN_FUNCTION_REDUCE_SUM
+                                               : NN_FUNCTION_REDUCE_MEAN,
+                                           v, 1, 1, v + 1, 1),
+                           (const void *const[]){x},
+                           (const float *const[]){y}, 1e-5f);
+      }
+    }
+  }
+}
+
+// Sum of long rows, whose error stays small only if it is not accumulated
+// one value after another.
+static void test_long_sum(void) {
+  enum { ROWS = 2, LENGTH = 1 << 17 };
+  int x_shape[2] = {ROWS, LENGTH}, y_shape[1] = {ROWS}, axes[1] = {1};
+  float *x = malloc(sizeof(float) * ROWS * LENGTH), y[ROWS];
+  test_network_t n;
+  nn_function_sum_t f;
+  int v[2];
+  int r, i; // Iterators
+
+  test_fill(x, ROWS * LENGTH, 70, 0.5f);
+  for (r = 0; r < ROWS; r++) {
+    double sum = 0;
+    for (i = 0; i < LENGTH; i++) {
+      x[r * LENGTH + i] += 1.0f;
+      sum += x[r * LENGTH + i];
+    }
+    y[r] = (float)sum;
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.axes = test_list(&n, axes, 1);
+  v[0] = test_variable(&n, x_shape, 2, 0);
+  v[1] = test_variable(&n, y_shape, 1, 0);
+  test_check_network("Sum of long rows",
+                     single_function(&n, &f, sizeof(f), NN_FUNCTION_SUM, v, 1,
+                                     1, v + 1, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     1e-5f);
+  free(x);
+}
+
+// TopKData
+
+// k largest values of each sample by value or by abs, earlier one of equal
+// values first, in descending order if reduce, otherwise at their positions.
+static void top_k_reference(const float *x, int samples, int size, int k,
+                            int by_abs, int reduce, float *y) {
+  int s, i, j; // Iterators
+
+  for (s = 0; s < samples; s++) {
+    const float *xs = x + s * size;
+    float *ys = y + s * (reduce ? k : size);
+    uint8_t taken[64] = {0};
+    if (!reduce) {
+      memset(ys, 0, sizeof(float) * size);
+    }
+    for (j = 0; j < k; j++) {
+      int best = -1;
+      for (i = 0; i < size; i++) {
+        float v = by_abs ? fabsf(xs[i]) : xs[i];
+        if (!taken[i] &&
+            (best < 0 || v > (by_abs ? fabsf(xs[best]) : xs[best]))) {
+          best = i;
+        }
+      }
+      taken[best] = 1;
+      if (reduce) {
+        ys[j] = xs[best];
+      } else {
+        ys[best] = xs[best];
+      }
+    }
+  }
+}
+
+static void softmax_reference(const float *x, int samples, int size,
+                              float *y) {
+  int s, i; // Iterators
+  for (s = 0; s < samples; s++) {
+    double max = x[s * size], sum = 0;
+    for (i = 1; i < size; i++) {
+      max = fmax(max, x[s * size + i]);
+    }
+    for (i = 0; i < size; i++) {
+      sum += exp(x[s * size + i] - max);
+    }
+    for (i = 0; i < size; i++) {
+      y[s * size + i] = (float)(exp(x[s * size + i] - max) / sum);
+    }
+  }
+}
+
+static void test_top_k_data(void) {
+  enum { SAMPLES = 3, SIZE = 40, K = 5 };
+  float x[SAMPLES * SIZE], p[SAMPLES * SIZE], y[SAMPLES * SIZE];
+  int variant, i; // Iterators
+
+  for (i = 0; i < SAMPLES * SIZE; i++) {
+    // Equal values in each sample.
+    x[i] = (float)((i * 7) % 23) - 11.0f;
+  }
+  softmax_reference(x, SAMPLES, SIZE, p);
+  // abs, reduce and Softmax before TopKData.
+  for (variant = 0; variant < 8; variant++) {
+    test_network_t n;
+    nn_function_top_k_data_t f;
+    nn_function_softmax_t softmax;
+    int by_abs = variant & 1, reduce = variant >> 1 & 1;
+    int has_softmax = variant >> 2;
+    int x_shape[2] = {SAMPLES, SIZE}, y_shape[2] = {SAMPLES, reduce ? K : SIZE};
+    int v[3];
+    char name[64];
+
+    test_network_init(&n);
+    v[0] = test_variable(&n, x_shape, 2, 0);
+    v[1] = v[0];
+    if (has_softmax) {
+      memset(&softmax, 0, sizeof(softmax));
+      softmax.axis = 1;
+      v[1] = test_variable(&n, x_shape, 2, 0);
+      test_function(&n, &softmax, sizeof(softmax), NN_FUNCTION_SOFTMAX, v, 1,
+                    v + 1, 1);
+    }
+    memset(&f, 0, sizeof(f));
+    f.k = K;
+    f.abs = by_abs;
+    f.reduce = reduce;
+    f.base_axis = 1;
+    v[2] = test_variable(&n, y_shape, 2, 0);
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_TOP_K_DATA, v + 1, 1, v + 2,
+                  1);
+    top_k_reference(has_softmax ? p : x, SAMPLES, SIZE, K, by_abs, reduce, y);
+    sprintf(name, "TopKData abs %d reduce %d softmax %d", by_abs, reduce,
+            has_softmax);
+    test_check_network(name, test_build(&n, v, 1, v + 2, 1),
+                       (const void *const[]){x}, (const float *const[]){y},
+                       1e-5f);
+  }
+}
+
+// Interpolate
+
+static float interpolate_scale(int in, int out, int align_corners) {
+  if (out <= 1) {
+    return 0;
+  }
+  return align_corners ? (float)(in - 1) / (out - 1) : (float)in / out;
+}
+
+static float interpolate_source(float scale, int i, int align_corners) {
+  return align_corners ? scale * i : fmaxf(0, scale * (i + 0.5f) - 0.5f);
+}
+
+static void interpolate_reference(const float *x, int maps, int h, int w,
+                                  int oh, int ow, int linear,
+                                  int align_corners, float *y) {
+  float sy = interpolate_scale(h, oh, align_corners);
+  float sx = interpolate_scale(w, ow, align_corners);
+  int m, oy, ox; // Iterators
+
+  for (m = 0; m < maps; m++) {
+    const float *xm = x + m * h * w;
+    for (oy = 0; oy < oh; oy++) {
+      for (ox = 0; ox < ow; ox++) {
+        float *o = y + (m * oh + oy) * ow + ox;
+        if (linear) {
+          float fy = interpolate_source(sy, oy, align_corners);
+          float fx = interpolate_source(sx, ox, align_corners);
+          int y0 = (int)fminf((float)(int)fy, (float)(h - 1));
+          int x0 = (int)fminf((float)(int)fx, (float)(w - 1));
+          int y1 = y0 + (y0 < h - 1), x1 = x0 + (x0 < w - 1);
+          float ly = fy - y0, lx = fx - x0;
+          *o = (1 - ly) * ((1 - lx) * xm[y0 * w + x0] + lx * xm[y0 * w + x1]) +
+               ly * ((1 - lx) * xm[y1 * w + x0] + lx * xm[y1 * w + x1]);
+        } else {
+          int iy = (int)fminf((float)(int)(sy * oy), (float)(h - 1));
+          int ix = (int)fminf((float)(int)(sx * ox), (float)(w - 1));
+          *o = xm[iy * w + ix];
+        }
+      }
+    }
+  }
+}
+
+static void test_interpolate(void) {
+  // h, w, output h, output w, linear, align_corners
+  static const int cases[][6] = {{5, 7, 10, 14, 1, 1}, {5, 7, 10, 14, 1, 0},
+                                 {6, 9, 4, 5, 1, 0},   {6, 9, 13, 4, 0, 0},
+                                 {3, 3, 7, 1, 1, 1},   {6, 9, 4, 18, 0, 1}};
+  float x[2 * 3 * 6 * 9], y[2 * 3 * 13 * 18];
+  int t; // Iterator
+
+  for (t = 0; t < (int)(sizeof(cases) / sizeof(cases[0])); t++) {
+    const int *k = cases[t];
+    test_network_t n;
+    nn_function_interpolate_t f;
+    int x_shape[4] = {2, 3, k[0], k[1]}, y_shape[4] = {2, 3, k[2], k[3]};
+    int v[2];
+    char name[64];
+
+    test_fill(x, 2 * 3 * k[0] * k[1], 20 + t, 6.0f);
+    interpolate_reference(x, 6, k[0], k[1], k[2], k[3], k[4], k[5], y);
+    test_network_init(&n);
+    memset(&f, 0, sizeof(f));
+    f.output_size = test_list(&n, k + 2, 2);
+    f.mode = k[4] ? INTERPOLATE_MODE_LINEAR : INTERPOLATE_MODE_NEAREST;
+    f.align_corners = k[5];
+    v[0] = test_variable(&n, x_shape, 4, 0);
+    v[1] = test_variable(&n, y_shape, 4, 0);
+    sprintf(name, "Interpolate case %d", t);
+    test_check_network(name,
+                       single_function(&n, &f, sizeof(f),
+                                       NN_FUNCTION_INTERPOLATE, v, 1, 1, v + 1,
+                                       1),
+                       (const void *const[]){x}, (const float *const[]){y},
+                       1e-5f);
+  }
+}
+
+// Embed
+
+static void test_embed(void) {
+  enum { INDICES = 6, WORDS = 10, DIMENSION = 7 };
+  float x[INDICES] = {3, 0, 9, 2, 9, 5};
+  float w[WORDS * DIMENSION], y[INDICES * DIMENSION];
+  int x_shape[2] = {2, INDICES / 2}, w_shape[2] = {WORDS, DIMENSION};
+  int y_shape[3] = {2, INDICES / 2, DIMENSION};
+  test_network_t n;
+  nn_function_t f;
+  int v[3];
+  int i; // Iterator
+
+  test_fill(w, WORDS * DIMENSION, 30, 2.0f);
+  for (i = 0; i < INDICES; i++) {
+    memcpy(y + i * DIMENSION, w + (int)x[i] * DIMENSION,
+           sizeof(float) * DIMENSION);
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  v[0] = test_variable(&n, x_shape, 2, 0);
+  v[1] = test_variable(&n, w_shape, 2, w);
+  v[2] = test_variable(&n, y_shape, 3, 0);
+  test_check_network("Embed",
+                     single_function(&n, &f, sizeof(f), NN_FUNCTION_EMBED, v,
+                                     2, 1, v + 2, 1),
+                     (const void *const[]){x}, (const float *const[]){y}, 0);
+}
+
+// NmsDetection2d
+
+#define NMS_BATCH (2)
+#define NMS_BOXES (60)
+#define NMS_CLASSES (3)
+#define NMS_CHANNELS (5 + NMS_CLASSES)
+
+static float box_iou(const float *a, const float *b) {
+  float left = fmaxf(a[0] - a[2] / 2, b[0] - b[2] / 2);
+  float right = fminf(a[0] + a[2] / 2, b[0] + b[2] / 2);
+  float top = fmaxf(a[1] - a[3] / 2, b[1] - b[3] / 2);
+  float bottom = fminf(a[1] + a[3] / 2, b[1] + b[3] / 2);
+  float w = right - left, h = bottom - top;
+  float overlap = (w < 0 || h < 0) ? 0 : w * h;
+  return overlap / (a[2] * a[3] + b[2] * b[3] - overlap);
+}
+
+// Box has nonzero probability of class k, or of any class if k < 0.
+static int has_score(const float *box, int k) {
+  int j; // Iterator
+  for (j = 0; j < NMS_CLASSES; j++) {
+    if ((k < 0 || j == k) && box[5 + j] != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Probabilities below thresh become 0, then candidates are visited by
+// descending score, earlier box first, and boxes overlapping a kept one
+// lose their probabilities.
+static void nms_reference(float *y, int per_class, float thresh, float nms) {
+  int b, k, i, j; // Iterators
+
+  for (b = 0; b < NMS_BATCH; b++) {
+    float *boxes = y + b * NMS_BOXES * NMS_CHANNELS;
+    for (i = 0; i < NMS_BOXES * NMS_CHANNELS; i++) {
+      if (i % NMS_CHANNELS >= 5 && boxes[i] < thresh) {
+        boxes[i] = 0;
+      }
+    }
+    for (k = 0; k < (per_class ? NMS_CLASSES : 1); k++) {
+      int column = per_class ? 5 + k : 4, order[NMS_BOXES], count = 0;
+      for (i = 0; i < NMS_BOXES; i++) {
+        if (has_score(boxes + i * NMS_CHANNELS, per_class ? k : -1)) {
+          order[count++] = i;
+        }
+      }
+      // Insertion sort keeps earlier box first among equal scores.
+      for (i = 1; i < count; i++) {
+        int box = order[i];
+        float score = boxes[box * NMS_CHANNELS + column];
+        for (j = i; j > 0 && boxes[order[j - 1] * NMS_CHANNELS + column] <
+                                 score;
+             j--) {
+          order[j] = order[j - 1];
+        }
+        order[j] = box;
+      }
+      for (i = 0; i < count; i++) {
+        const float *kept = boxes + order[i] * NMS_CHANNELS;
+        if (!has_score(kept, per_class ? k : -1)) {
+          continue;
+        }
+        for (j = i + 1; j < count; j++) {
+          float *other = boxes + order[j] * NMS_CHANNELS;
+          if (box_iou(kept, other) > nms) {
+            int c; // Iterator
+            for (c = 0; c < NMS_CLASSES; c++) {
+              if (!per_class || c == k) {
+                other[5 + c] = 0;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+static void test_nms_detection2d(void) {
+  float x[NMS_BATCH * NMS_BOXES * NMS_CHANNELS];
+  float y[NMS_BATCH * NMS_BOXES * NMS_CHANNELS];
+  int shape[3] = {NMS_BATCH, NMS_BOXES, NMS_CHANNELS};
+  unsigned seed = 40;
+  int per_class, i; // Iterators
+
+  for (i = 0; i < NMS_BATCH * NMS_BOXES; i++) {
+    float *box = x + i * NMS_CHANNELS;
+    int j; // Iterator
+    box[0] = test_random(&seed) + 0.5f;
+    box[1] = test_random(&seed) + 0.5f;
+    box[2] = 0.2f + 0.3f * test_random(&seed);
+    box[3] = 0.2f + 0.3f * test_random(&seed);
+    for (j = 4; j < NMS_CHANNELS; j++) {
+      box[j] = test_random(&seed) + 0.5f;
+    }
+  }
+  for (per_class = 0; per_class < 2; per_class++) {
+    test_network_t n;
+    nn_function_nms_detection2d_t f;
+    int v[2];
+
+    memcpy(y, x, sizeof(x));
+    nms_reference(y, per_class, 0.3f, 0.45f);
+    test_network_init(&n);
+    memset(&f, 0, sizeof(f));
+    f.thresh = 0.3f;
+    f.nms = 0.45f;
+    f.nms_per_class = per_class;
+    v[0] = test_variable(&n, shape, 3, 0);
+    v[1] = test_variable(&n, shape, 3, 0);
+    test_check_network(
+        per_class ? "NmsDetection2d per class" : "NmsDetection2d",
+        single_function(&n, &f, sizeof(f), NN_FUNCTION_NMS_DETECTION2D, v, 1,
+                        1, v + 1, 1),
+        (const void *const[]){x}, (const float *const[]){y}, 0);
+  }
+}
+
+// RNN, LSTM and GRU
+
+typedef enum {
+  CELL_RNN_TANH,
+  CELL_RNN_RELU,
+  CELL_LSTM,
+  CELL_GRU,
+  END_OF_CELL
+} cell_t;
+
+static const char *cell_names[END_OF_CELL] = {"RNN tanh", "RNN ReLU", "LSTM",
+                                              "GRU"};
+
+#define RNN_TIME (6)
+#define RNN_INPUT (5)
+#define RNN_HIDDEN (7)
+
+typedef struct {
+  cell_t cell;
+  int layers;
+  int directions;
+  int batch;
+  int gates;      // Rows of weight for each hidden unit.
+  int bias_gates; // Rows of bias, GRU has separate bias of hidden state.
+} recurrent_t;
+
+static float sigmoid(float x) { return 1 / (1 + expf(-x)); }
+
+// y is (T, B, D * H), h and c are (L, D, B, H).
+static void recurrent_reference(const recurrent_t *r, int time, const float *x,
+                                const float *h0, const float *c0,
+                                const float *w0, const float *w,
+                                const float *bias, float *y, float *hn,
+                                float *cn) {
+  const int H = RNN_HIDDEN, B = r->batch, D = r->directions;
+  int size = RNN_INPUT > D * H ? RNN_INPUT : D * H;
+  float *in = malloc(sizeof(float) * time * B * size);
+  float *out = malloc(sizeof(float) * time * B * D * H);
+  int l, d, s, b, g, j, k; // Iterators
+
+  memcpy(in, x, sizeof(float) * time * B * RNN_INPUT);
+  size = RNN_INPUT;
+  for (l = 0; l < r->layers; l++) {
+    for (d = 0; d < D; d++) {
+      int ld = l * D + d;
+      const float *weight =
+          l == 0 ? w0 + d * r->gates * H * (size + H)
+                 : w + (ld - D) * r->gates * H * (size + H);
+      const float *bb = bias + ld * r->bias_gates * H;
+      float *h = hn + ld * B * H;
+      float *c = cn + ld * B * H;
+      memcpy(h, h0 + ld * B * H, sizeof(float) * B * H);
+      memcpy(c, c0 + ld * B * H, sizeof(float) * B * H);
+      for (s = 0; s < time; s++) {
+        int t = d ? time - 1 - s : s;
+        for (b = 0; b < B; b++) {
+          const float *xv = in + (t * B + b) * size;
+          float *hv = h + b * H;
+          float a[4][RNN_HIDDEN], an[RNN_HIDDEN], next[RNN_HIDDEN];
+          for (g = 0; g < r->gates; g++) {
+            for (j = 0; j < H; j++) {
+              const float *row = weight + (g * H + j) * (size + H);
+              double ax = 0, ah = 0;
+              for (k = 0; k < size; k++) {
+                ax += row[k] * xv[k];
+              }
+              for (k = 0; k < H; k++) {
+                ah += row[size + k] * hv[k];
+              }
+              a[g][j] = (float)(bb[g * H + j] + ax + ah);
+              if (r->cell == CELL_GRU && g == 2) {
+                a[g][j] = (float)(bb[2 * H + j] + ax);
+                an[j] = (float)(bb[3 * H + j] + ah);
+              }
+            }
+          }
+          for (j = 0; j < H; j++) {
+            if (r->cell == CELL_RNN_TANH) {
+              next[j] = tanhf(a[0][j]);
+            } else if (r->cell == CELL_RNN_RELU) {
+              next[j] = a[0][j] > 0 ? a[0][j] : 0;
+            } else if (r->cell == CELL_LSTM) {
+              float cell = sigmoid(a[1][j]) * c[b * H + j] +
+                           sigmoid(a[0][j]) * tanhf(a[2][j]);
+              c[b * H + j] = cell;
+              next[j] = sigmoid(a[3][j]) * tanhf(cell);
+            } else {
+              float reset = sigmoid(a[0][j]), update = sigmoid(a[1][j]);
+              float candidate = tanhf(a[2][j] + reset * an[j]);
+              next[j] = (1 - update) * candidate + update * hv[j];
+            }
+          }
+          memcpy(hv, next, sizeof(float) * H);
+          memcpy(out + (t * B + b) * D * H + d * H, next, sizeof(float) * H);
+        }
+      }
+    }
+    memcpy(in, out, sizeof(float) * time * B * D * H);
+    size = D * H;
+  }
+  memcpy(y, out, sizeof(float) * time * B * D * H);
+  free(in);
+  free(out);
+}
+
+typedef struct {
+  float *x, *h0, *c0, *w0, *w, *bias;
+  float *y, *hn, *cn;
+  int state_size;
+} recurrent_data_t;
+
+static void allocate_recurrent_data(const recurrent_t *r,
+                                    recurrent_data_t *data) {
+  const int H = RNN_HIDDEN, D = r->directions;
+  int w0_size = D * r->gates * H * (RNN_INPUT + H);
+  int w_size = (r->layers - 1) * D * r->gates * H * (D * H + H);
+  int bias_size = r->layers * D * r->bias_gates * H;
+  int x_size = RNN_TIME * r->batch * RNN_INPUT;
+
+  data->state_size = r->layers * D * r->batch * H;
+  data->x = malloc(sizeof(float) * x_size);
+  data->h0 = malloc(sizeof(float) * data->state_size);
+  data->c0 = malloc(sizeof(float) * data->state_size);
+  data->w0 = malloc(sizeof(float) * w0_size);
+  data->w = malloc(sizeof(float) * (w_size + 1));
+  data->bias = malloc(sizeof(float) * bias_size);
+  data->y = malloc(sizeof(float) * RNN_TIME * r->batch * D * H);
+  data->hn = malloc(sizeof(float) * data->state_size);
+  data->cn = malloc(sizeof(float) * data->state_size);
+  test_fill(data->x, x_size, 50, 6.0f);
+  test_fill(data->h0, data->state_size, 51, 1.0f);
+  test_fill(data->c0, data->state_size, 52, 1.0f);
+  test_fill(data->w0, w0_size, 53, 1.0f);
+  test_fill(data->w, w_size + 1, 54, 1.0f);
+  test_fill(data->bias, bias_size, 55, 1.0f);
+}
+
+static void free_recurrent_data(recurrent_data_t *data) {
+  free(data->x);
+  free(data->h0);
+  free(data->c0);
+  free(data->w0);
+  free(data->w);
+  free(data->bias);
+  free(data->y);
+  free(data->hn);
+  free(data->cn);
+}
+
+// Network of recurrent function over time steps, whose inputs are x, and
+// h and c of LSTM if state_inputs, otherwise h and c are parameters.
+static nn_network_t *build_recurrent(const recurrent_t *r,
+                                     const recurrent_data_t *data, int time,
+                                     int state_inputs) {
+  const int H = RNN_HIDDEN, D = r->directions;
+  int x_shape[3] = {time, r->batch, RNN_INPUT};
+  int state_shape[4] = {r->layers, D, r->batch, H};
+  int w0_shape[5] = {1, D, r->gates, H, RNN_INPUT + H};
+  int w_shape[5] = {r->layers - 1, D, r->gates, H, D * H + H};
+  int bias_shape[4] = {r->layers, D, r->bias_gates, H};
+  int y_shape[3] = {time, r->batch, D * H};
+  int inputs[6], outputs[3], num_of_inputs = 0;
+  int num_of_outputs = r->cell == CELL_LSTM ? 3 : 2;
+  test_network_t n;
+
+  test_network_init(&n);
+  inputs[num_of_inputs++] = test_variable(&n, x_shape, 3, 0);
+  inputs[num_of_inputs++] =
+      test_variable(&n, state_shape, 4, state_inputs ? 0 : data->h0);
+  if (r->cell == CELL_LSTM) {
+    inputs[num_of_inputs++] =
+        test_variable(&n, state_shape, 4, state_inputs ? 0 : data->c0);
+  }
+  inputs[num_of_inputs++] = test_variable(&n, w0_shape, 5, data->w0);
+  if (r->layers > 1) {
+    inputs[num_of_inputs++] = test_variable(&n, w_shape, 5, data->w);
+  }
+  inputs[num_of_inputs++] = test_variable(&n, bias_shape, 4, data->bias);
+  outputs[0] = test_variable(&n, y_shape, 3, 0);
+  outputs[1] = test_variable(&n, state_shape, 4, 0);
+  outputs[2] = test_variable(&n, state_shape, 4, 0);
+
+  if (r->cell == CELL_RNN_TANH || r->cell == CELL_RNN_RELU) {
+    nn_function_rnn_t f;
+    memset(&f, 0, sizeof(f));
+    f.num_layers = r->layers;
+    f.nonlinearity = r->cell == CELL_RNN_TANH ? RNN_NONLINEARITY_TANH
+                                              : RNN_NONLINEARITY_RELU;
+    f.bidirectional = D == 2;
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_RNN, inputs, num_of_inputs,
+                  outputs, num_of_outputs);
+  } else if (r->cell == CELL_LSTM) {
+    nn_function_lstm_t f;
+    memset(&f, 0, sizeof(f));
+    f.num_layers = r->layers;
+    f.bidirectional = D == 2;
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_LSTM, inputs, num_of_inputs,
+                  outputs, num_of_outputs);
+  } else {
+    nn_function_gru_t f;
+    memset(&f, 0, sizeof(f));
+    f.num_layers = r->layers;
+    f.bidirectional = D == 2;
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_GRU, inputs, num_of_inputs,
+                  outputs, num_of_outputs);
+  }
+  return test_build(&n, inputs,
+                    state_inputs ? (r->cell == CELL_LSTM ? 3 : 2) : 1,
+                    outputs, num_of_outputs);
+}
+
+// Frames given one at a time with recurrent streaming, and state kept
+// between runs, are same as whole sequence.
+static void check_recurrent_streaming(const recurrent_t *r,
+                                      const recurrent_data_t *data,
+                                      const char *name) {
+  nn_network_t *net = build_recurrent(r, data, 1, 0);
+  const int frame = r->batch * RNN_INPUT, output = r->batch * RNN_HIDDEN;
+  rt_context_pointer c = 0;
+  int run, t; // Iterators
+
+  rt_allocate_context(&c);
+  if (!test_check(rt_set_recurrent_streaming(c, 1) == RT_RET_NOERROR &&
+                      rt_initialize_context(c, net) == RT_RET_NOERROR,
+                  "%s streaming: initialize", name)) {
+    rt_free_context(&c);
+    free(net);
+    return;
+  }
+  // Second run after reset starts from initial state again.
+  for (run = 0; run < 2; run++) {
+    float error = 0;
+    rt_reset_recurrent_state(c);
+    for (t = 0; t < RNN_TIME; t++) {
+      memcpy(rt_input_buffer(c, 0), data->x + t * frame,
+             sizeof(float) * frame);
+      if (!test_check(rt_forward(c) == RT_RET_NOERROR,
+                      "%s streaming: forward", name)) {
+        break;
+      }
+      error = fmaxf(error, test_max_error(data->y + t * output,
+                                          rt_output_buffer(c, 0), output));
+    }
+    error =
+        fmaxf(error, test_max_error(data->hn, rt_output_buffer(c, 1),
+                                    data->state_size));
+    test_check(error <= TOLERANCE, "%s streaming run %d: error %g", name, run,
+               error);
+  }
+  rt_free_context(&c);
+  free(net);
+}
+
+static void test_recurrent(void) {
+  // layers, directions, batch
+  static const int shapes[][3] = {{1, 1, 1}, {1, 1, 3}, {2, 1, 2},
+                                  {1, 2, 2}, {2, 2, 3}};
+  cell_t cell;
+  int s; // Iterator
+
+  for (cell = CELL_RNN_TANH; cell < END_OF_CELL; cell++) {
+    for (s = 0; s < (int)(sizeof(shapes) / sizeof(shapes[0])); s++) {
+      recurrent_t r;
+      recurrent_data_t data;
+      const void *inputs[3];
+      const float *references[3];
+      char name[64];
+
+      r.cell = cell;
+      r.layers = shapes[s][0];
+      r.directions = shapes[s][1];
+      r.batch = shapes[s][2];
+      r.gates = cell == CELL_LSTM ? 4 : cell == CELL_GRU ? 3 : 1;
+      r.bias_gates = cell == CELL_GRU ? 4 : r.gates;
+      allocate_recurrent_data(&r, &data);
+      recurrent_reference(&r, RNN_TIME, data.x, data.h0, data.c0, data.w0,
+                          data.w, data.bias, data.y, data.hn, data.cn);
+      sprintf(name, "%s layers %d directions %d batch %d", cell_names[cell],
+              r.layers, r.directions, r.batch);
+      inputs[0] = data.x;
+      inputs[1] = data.h0;
+      inputs[2] = data.c0;
+      references[0] = data.y;
+      references[1] = data.hn;
+      references[2] = data.cn;
+      test_check_network(name, build_recurrent(&r, &data, RNN_TIME, 1),
+                         inputs, references, TOLERANCE);
+      if (r.directions == 1) {
+        check_recurrent_streaming(&r, &data, name);
+      }
+      free_recurrent_data(&data);
+    }
+  }
+}
+
+// Broadcast and Tile, alone and read by arithmetic
+
+static void test_repeat(void) {
+  enum { A = 2, B = 3, C = 4 };
+  float x[B], z[A * B * C], tile_input[B * C];
+  float t[2 * B * 3 * C], y[2 * B * 3 * C], tiled[2 * B * 3 * C];
+  int x_shape[3] = {1, B, 1}, full_shape[3] = {A, B, C};
+  int half_shape[3] = {1, B, C}, reps[3] = {2, 1, 3};
+  int tiled_shape[3] = {2, B, 3 * C};
+  int arithmetic, i, j, k; // Iterators
+
+  test_fill(x, B, 60, 4.0f);
+  test_fill(z, A * B * C, 61, 4.0f);
+  test_fill(tile_input, B * C, 62, 4.0f);
+  for (arithmetic = 0; arithmetic < 2; arithmetic++) {
+    test_network_t n;
+    nn_function_broadcast_t f;
+    nn_function_t add;
+    int v[4];
+
+    for (i = 0; i < A * B * C; i++) {
+      y[i] = x[i / C % B] + (arithmetic ? z[i] : 0);
+    }
+    test_network_init(&n);
+    memset(&f, 0, sizeof(f));
+    f.shape = test_list(&n, full_shape, 3);
+    v[0] = test_variable(&n, x_shape, 3, 0);
+    v[1] = test_variable(&n, full_shape, 3, 0);
+    v[2] = test_variable(&n, full_shape, 3, 0);
+    v[3] = test_variable(&n, full_shape, 3, 0);
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_BROADCAST, v, 1, v + 1, 1);
+    if (arithmetic) {
+      int operands[2] = {v[1], v[2]};
+      memset(&add, 0, sizeof(add));
+      test_function(&n, &add, sizeof(add), NN_FUNCTION_ADD2, operands, 2,
+                    v + 3, 1);
+    }
+    test_check_network(arithmetic ? "Broadcast read by Add2" : "Broadcast",
+                       test_build(&n, (int[]){v[0], v[2]}, 1 + arithmetic,
+                                  v + (arithmetic ? 3 : 1), 1),
+                       (const void *const[]){x, z}, (const float *const[]){y},
+                       0);
+  }
+
+  for (i = 0; i < 2; i++) {
+    for (j = 0; j < B; j++) {
+      for (k = 0; k < 3 * C; k++) {
+        tiled[(i * B + j) * 3 * C + k] = tile_input[j * C + k % C];
+      }
+    }
+  }
+  for (arithmetic = 0; arithmetic < 2; arithmetic++) {
+    test_network_t n;
+    nn_function_tile_t f;
+    nn_function_t mul;
+    int v[4];
+
+    test_fill(t, 2 * B * 3 * C, 63, 4.0f);
+    for (i = 0; i < 2 * B * 3 * C; i++) {
+      y[i] = tiled[i] * (arithmetic ? t[i] : 1);
+    }
+    test_network_init(&n);
+    memset(&f, 0, sizeof(f));
+    f.reps = test_list(&n, reps, 3);
+    v[0] = test_variable(&n, half_shape, 3, 0);
+    v[1] = test_variable(&n, tiled_shape, 3, 0);
+    v[2] = test_variable(&n, tiled_shape, 3, 0);
+    v[3] = test_variable(&n, tiled_shape, 3, 0);
+    test_function(&n, &f, sizeof(f), NN_FUNCTION_TILE, v, 1, v + 1, 1);
+    if (arithmetic) {
+      int operands[2] = {v[2], v[1]};
+      memset(&mul, 0, sizeof(mul));
+      test_function(&n, &mul, sizeof(mul), NN_FUNCTION_MUL2, operands, 2,
+                    v + 3, 1);
+    }
+    test_check_network(arithmetic ? "Tile read by Mul2" : "Tile",
+                       test_build(&n, (int[]){v[0], v[2]}, 1 + arithmetic,
+                                  v + (arithmetic ? 3 : 1), 1),
+                       (const void *const[]){tile_input, t},
+                       (const float *const[]){y}, 0);
+  }
+}
+
+int main(void) {
+  test_recurrent();
+  test_embed();
+  test_interpolate();
+  test_top_k_data();
+  test_nms_detection2d();
+  test_reductions();
+  test_long_sum();
+  test_repeat();
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
@@ -0,0 +1,456 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+static int failures = 0;
+
+static void *grow(void *list, int *capacity, int required, size_t item) {
+  if (required > *capacity) {
+    int capacity_new = *capacity ? *capacity : 64;
+    while (capacity_new < required) {
+      capacity_new *= 2;
+    }
+    list = realloc(list, capacity_new * item);
+    if (list == 0) {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+    }
+    *capacity = capacity_new;
+  }
+  return list;
+}
+
+// Returns index of copy of size bytes at data.
+static int add_data(test_network_t *n, const void *data, size_t size) {
+  size_t aligned = (size + 7) & ~(size_t)7;
+  int capacity = (int)n->data_capacity;
+
+  n->data = grow(n->data, &capacity, (int)(n->data_size + aligned), 1);
+  n->data_capacity = capacity;
+  n->offsets = grow(n->offsets, &n->offsets_capacity, n->num_of_data + 1,
+                    sizeof(int32_t));
+  memset(n->data + n->data_size, 0, aligned);
+  memcpy(n->data + n->data_size, data, size);
+  n->offsets[n->num_of_data] = (int32_t)n->data_size;
+  n->data_size += aligned;
+  return n->num_of_data++;
+}
+
+static void check_items(int num) {
+  if (num >= TEST_MAX_ITEMS) {
+    fprintf(stderr, "Too many items of network\n");
+    exit(1);
+  }
+}
+
+void test_network_init(test_network_t *n) { memset(n, 0, sizeof(*n)); }
+
+nn_list_t test_list(test_network_t *n, const int *values, int size) {
+  nn_list_t list;
+  int32_t empty = 0;
+  list.size = size;
+  list.list = add_data(n, size ? (const void *)values : &empty,
+                       size ? sizeof(int32_t) * size : sizeof(empty));
+  return list;
+}
+
+size_t test_data_size(nn_data_type_t type, int size) {
+  switch (type) {
+  case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return sizeof(int16_t) * size;
+  case NN_DATA_TYPE_INT8:
+    return size;
+  case NN_DATA_TYPE_SIGN:
+    return sizeof(uint32_t) * ((size + 31) / 32);
+  default:
+    return sizeof(float) * size;
+  }
+}
+
+int test_raw_variable(test_network_t *n, const int *shape, int ndim,
+                      nn_data_type_t type, int fp_pos, const void *data,
+                      size_t size) {
+  nn_variable_t v;
+
+  check_items(n->num_of_variables);
+  memset(&v, 0, sizeof(v));
+  v.id = n->num_of_variables;
+  v.shape = test_list(n, shape, ndim);
+  v.type = type;
+  v.fp_pos = fp_pos;
+  v.layout = NN_DATA_LAYOUT_DENSE;
+  v.quantization = -1;
+  if (data) {
+    v.data_index = add_data(n, data, size);
+  } else {
+    check_items(n->num_of_buffers);
+    n->buffers[n->num_of_buffers++] = (int32_t)size;
+    v.data_index = -n->num_of_buffers;
+  }
+  n->variables[n->num_of_variables] = add_data(n, &v, sizeof(v));
+  return n->num_of_variables++;
+}
+
+int test_typed_variable(test_network_t *n, const int *shape, int ndim,
+                        nn_data_type_t type, int fp_pos, const void *data) {
+  int size = 1;
+  int i; // Iterator
+  for (i = 0; i < ndim; i++) {
+    size *= shape[i];
+  }
+  return test_raw_variable(n, shape, ndim, type, fp_pos, data,
+                           test_data_size(type, size));
+}
+
+int test_variable(test_network_t *n, const int *shape, int ndim,
+                  const float *data) {
+  return test_typed_variable(n, shape, ndim, NN_DATA_TYPE_FLOAT, 0, data);
+}
+
+static int is_zero(const float *values, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    if (values[i] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int test_sparse_variable(test_network_t *n, const int *shape, int ndim,
+                         const float *dense, int block_size) {
+  nn_block_sparse_t header;
+  int32_t *arrays, *row_offsets, *block_columns;
+  float *values;
+  size_t size;
+  nn_variable_t *v;
+  int variable, blocks = 0;
+  int r, b, i; // Iterators
+
+  header.rows = shape[0];
+  header.columns = 1;
+  for (i = 1; i < ndim; i++) {
+    header.columns *= shape[i];
+  }
+  header.block_size = block_size;
+  size = sizeof(int32_t) * (header.rows + 1 + header.rows * header.columns) +
+         sizeof(float) * header.rows * header.columns;
+  arrays = malloc(sizeof(header) + size);
+  row_offsets = arrays + sizeof(header) / sizeof(int32_t);
+  block_columns = row_offsets + header.rows + 1;
+  values = malloc(sizeof(float) * header.rows * header.columns);
+  for (r = 0; r < header.rows; r++) {
+    row_offsets[r] = blocks;
+    for (b = 0; b < header.columns; b += block_size) {
+      const float *block = dense + r * header.columns + b;
+      if (!is_zero(block, block_size)) {
+        block_columns[blocks] = b;
+        memcpy(values + blocks * block_size, block,
+               sizeof(float) * block_size);
+        blocks++;
+      }
+    }
+  }
+  row_offsets[header.rows] = blocks;
+  header.num_of_blocks = blocks;
+  memcpy(arrays, &header, sizeof(header));
+  memcpy(block_columns + blocks, values, sizeof(float) * blocks * block_size);
+  size = sizeof(header) +
+         sizeof(int32_t) * (header.rows + 1 + blocks) +
+         sizeof(float) * blocks * block_size;
+  variable = test_raw_variable(n, shape, ndim, NN_DATA_TYPE_FLOAT, 0, arrays,
+                               size);
+  v = (nn_variable_t *)(n->data + n->offsets[n->variables[variable]]);
+  v->layout = NN_DATA_LAYOUT_BLOCK_SPARSE;
+  free(values);
+  free(arrays);
+  return variable;
+}
+
+int test_function(test_network_t *n, void *function, size_t size, int type,
+                  const int *inputs, int num_of_inputs, const int *outputs,
+                  int num_of_outputs) {
+  nn_function_t *f = (nn_function_t *)function;
+
+  check_items(n->num_of_functions);
+  f->type = (nn_function_type_t)type;
+  f->impl = NN_FUNCTION_IMPLEMENT_AUTO;
+  f->inputs = test_list(n, inputs, num_of_inputs);
+  f->outputs = test_list(n, outputs, num_of_outputs);
+  n->functions[n->num_of_functions] = add_data(n, function, size);
+  return n->num_of_functions++;
+}
+
+nn_network_t *test_build(test_network_t *n, const int *inputs,
+                         int num_of_inputs, const int *outputs,
+                         int num_of_outputs) {
+  nn_network_t h;
+  nn_network_t *net;
+  size_t index_size;
+
+  memset(&h, 0, sizeof(h));
+  h.version = NN_BINARY_FORMAT_VERSION;
+  h.api_level = NN_API_LEVEL;
+  h.buffers = test_list(n, n->buffers, n->num_of_buffers);
+  h.variables = test_list(n, n->variables, n->num_of_variables);
+  h.functions = test_list(n, n->functions, n->num_of_functions);
+  h.inputs = test_list(n, inputs, num_of_inputs);
+  h.outputs = test_list(n, outputs, num_of_outputs);
+  h.memory.num_of_data = n->num_of_data;
+  h.memory.data_size = n->data_size;
+
+  index_size = sizeof(int32_t) * n->num_of_data;
+  net = malloc(sizeof(h) + index_size + n->data_size);
+  if (net) {
+    memcpy(net, &h, sizeof(h));
+    memcpy((uint8_t *)net + sizeof(h), n->offsets, index_size);
+    memcpy((uint8_t *)net + sizeof(h) + index_size, n->data, n->data_size);
+  }
+  free(n->data);
+  free(n->offsets);
+  test_network_init(n);
+  return net;
+}
+
+// Item of built network.
+static const void *item(const nn_network_t *net, int index) {
+  const int32_t *offsets = (const int32_t *)(net + 1);
+  return (const uint8_t *)(offsets + net->memory.num_of_data) +
+         offsets[index];
+}
+
+// Variable of input or output list of built network.
+static const nn_variable_t *io_variable(const nn_network_t *net,
+                                        nn_list_t list, int index) {
+  const int32_t *variables = item(net, net->variables.list);
+  return item(net, variables[((const int32_t *)item(net, list.list))[index]]);
+}
+
+static int variable_size(const nn_network_t *net, const nn_variable_t *v) {
+  const int32_t *shape = item(net, v->shape.list);
+  int size = 1;
+  nn_size_t i; // Iterator
+  for (i = 0; i < v->shape.size; i++) {
+    size *= shape[i];
+  }
+  return size;
+}
+
+static float value_of(const nn_variable_t *v, const void *data, int i) {
+  switch (v->type) {
+  case NN_DATA_TYPE_INT16:
+    return ldexpf(((const int16_t *)data)[i], -(int)v->fp_pos);
+  case NN_DATA_TYPE_INT8:
+    return ldexpf(((const int8_t *)data)[i], -(int)v->fp_pos);
+  case NN_DATA_TYPE_SIGN:
+    return ((const uint32_t *)data)[i / 32] >> (i % 32) & 1 ? 1.0f : -1.0f;
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return test_from_half(v->type, ((const uint16_t *)data)[i]);
+  default:
+    return ((const float *)data)[i];
+  }
+}
+
+typedef enum {
+  SETTING_PLAIN,
+  SETTING_OPTIONS,
+  SETTING_THREADS,
+  END_OF_SETTING
+} setting_t;
+
+static const char *setting_names[END_OF_SETTING] = {"plain", "options",
+                                                    "threads",
+};
+
+static void apply_setting(rt_context_pointer c, setting_t setting) {
+  switch (setting) {
+  case SETTING_OPTIONS:
+    rt_set_buffer_planning(c, 1);
+    rt_set_function_fusion(c, 1);
+    rt_set_graph_simplification(c, 1);
+    break;
+  case SETTING_THREADS:
+    rt_set_graph_execution(c, 1);
+    rt_set_num_threads(c, 3);
+    break;
+  default:
+    break;
+  }
+}
+
+static void compare_outputs(const char *name, const char *setting,
+                            rt_context_pointer c, const nn_network_t *net,
+                            const float *const *references,
+                            float tolerance) {
+  int i, j; // Iterators
+
+  for (i = 0; i < rt_num_of_output(c); i++) {
+    const nn_variable_t *v = io_variable(net, net->outputs, i);
+    int size = variable_size(net, v);
+    float *output = malloc(sizeof(float) * size);
+    float error;
+    if (!test_check(rt_output_size(c, i) == size,
+                    "%s %s: output %d size %d, expected %d", name, setting,
+                    i, rt_output_size(c, i), size)) {
+      free(output);
+      continue;
+    }
+    for (j = 0; j < size; j++) {
+      output[j] = value_of(v, rt_output_buffer(c, i), j);
+    }
+    error = test_max_error(references[i], output, size);
+    test_check(error <= tolerance, "%s %s: output %d error %g", name,
+               setting, i, error);
+    free(output);
+  }
+}
+
+void test_check_network(const char *name, nn_network_t *net,
+                        const void *const *inputs,
+                        const float *const *references, float tolerance) {
+  setting_t setting;
+  int i; // Iterator
+
+  for (setting = SETTING_PLAIN; setting < END_OF_SETTING; setting++) {
+    const char *s = setting_names[setting];
+    rt_context_pointer c = 0;
+    rt_return_value_t ret;
+
+    rt_allocate_context(&c);
+    apply_setting(c, setting);
+    ret = rt_initialize_context(c, net);
+    if (!test_check(ret == RT_RET_NOERROR, "%s %s: initialize returned %d",
+                    name, s, ret)) {
+      rt_free_context(&c);
+      continue;
+    }
+    for (i = 0; i < rt_num_of_input(c); i++) {
+      const nn_variable_t *v = io_variable(net, net->inputs, i);
+      memcpy(rt_input_buffer(c, i), inputs[i],
+             test_data_size(v->type, variable_size(net, v)));
+    }
+    // Second forward finds inputs as they were set.
+    for (i = 0; i < 2; i++) {
+      ret = rt_forward(c);
+      if (!test_check(ret == RT_RET_NOERROR, "%s %s: forward returned %d",
+                      name, s, ret)) {
+        break;
+      }
+      compare_outputs(name, s, c, net, references, tolerance);
+    }
+    rt_free_context(&c);
+  }
+  free(net);
+}
+
+float test_random(unsigned *seed) {
+  *seed = *seed * 1103515245u + 12345u;
+  return ((*seed >> 8) & 0xffff) / 65536.0f - 0.5f;
+}
+
+void test_fill(float *data, int size, unsigned seed, float scale) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    data[i] = test_random(&seed) * scale;
+  }
+}
+
+void test_round(float *data, int size, int fp_pos) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    data[i] = ldexpf(floorf(ldexpf(data[i], fp_pos) + 0.5f), -fp_pos);
+  }
+}
+
+uint16_t test_to_half(nn_data_type_t type, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (type == NN_DATA_TYPE_BFLOAT16) {
+    // Round to nearest even.
+    return (uint16_t)((bits + 0x7fff + (bits >> 16 & 1)) >> 16);
+  } else {
+    uint16_t sign = (uint16_t)(bits >> 16 & 0x8000);
+    float a = fabsf(value);
+    int e;
+    if (a < ldexpf(1, -14)) {
+      // Subnormal, multiple of 2^-24.
+      return sign | (uint16_t)lrintf(ldexpf(a, 24));
+    }
+    frexpf(a, &e);
+    if (e > 16) {
+      return sign | 0x7c00;
+    }
+    // Mantissa with 11 bits, whose carry moves to exponent.
+    return sign | (uint16_t)(((e + 14) << 10) +
+                             lrintf(ldexpf(a, 11 - e)) - 0x400);
+  }
+}
+
+float test_from_half(nn_data_type_t type, uint16_t value) {
+  float result;
+  if (type == NN_DATA_TYPE_BFLOAT16) {
+    uint32_t bits = (uint32_t)value << 16;
+    memcpy(&result, &bits, sizeof(result));
+  } else {
+    int e = value >> 10 & 0x1f;
+    int m = value & 0x3ff;
+    result = e == 0    ? ldexpf((float)m, -24)
+             : e == 31 ? (m ? NAN : INFINITY)
+                       : ldexpf((float)(m | 0x400), e - 25);
+    if (value & 0x8000) {
+      result = -result;
+    }
+  }
+  return result;
+}
+
+float test_max_error(const float *a, const float *b, int size) {
+  float error = 0;
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    float e = fabsf(a[i] - b[i]) / fmaxf(1.0f, fabsf(a[i]));
+    if (e != e) {
+      return HUGE_VALF; // NaN
+    }
+    if (e > error) {
+      error = e;
+    }
+  }
+  return error;
+}
+
+int test_check(int ok, const char *format, ...) {
+  if (!ok) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "FAIL: ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    failures++;
+  }
+  return ok;
+}
+
+int test_failures(void) { return failures; }
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_TEST_NETWORK_H_261014180622_
+#define H_TEST_NETWORK_H_261014180622_
+
+#include <stddef.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#define TEST_MAX_ITEMS (256) // Variables, functions or buffers of network.
+
+/// Builder of networks in memory, same layout as NNB.
+typedef struct {
+  uint8_t *data; // Items of network, each aligned to 8 bytes.
+  size_t data_size;
+  size_t data_capacity;
+  int32_t *offsets; // Offset of each item in data.
+  int num_of_data;
+  int offsets_capacity;
+  int32_t variables[TEST_MAX_ITEMS];
+  int num_of_variables;
+  int32_t functions[TEST_MAX_ITEMS];
+  int num_of_functions;
+  int32_t buffers[TEST_MAX_ITEMS];
+  int num_of_buffers;
+} test_network_t;
+
+void test_network_init(test_network_t *n);
+
+nn_list_t test_list(test_network_t *n, const int *values, int size);
+
+/// Bytes of size values of type.
+size_t test_data_size(nn_data_type_t type, int size);
+
+/// Add variable of type. It is a parameter holding a copy of size bytes at
+/// data, or a buffer of size bytes if data is NULL. Returns index of
+/// variable.
+int test_raw_variable(test_network_t *n, const int *shape, int ndim,
+                      nn_data_type_t type, int fp_pos, const void *data,
+                      size_t size);
+
+/// Same as test_raw_variable() for values of shape in type.
+int test_typed_variable(test_network_t *n, const int *shape, int ndim,
+                        nn_data_type_t type, int fp_pos, const void *data);
+
+/// Same as test_typed_variable() for float.
+int test_variable(test_network_t *n, const int *shape, int ndim,
+                  const float *data);
+
+/// Add float parameter of dense values stored as NN_DATA_LAYOUT_BLOCK_SPARSE
+/// with blocks of block_size columns, skipping blocks which are all zero.
+int test_sparse_variable(test_network_t *n, const int *shape, int ndim,
+                         const float *dense, int block_size);
+
+/// Add function whose common part of size bytes at function is filled here.
+/// Returns index of function.
+int test_function(test_network_t *n, void *function, size_t size, int type,
+                  const int *inputs, int num_of_inputs, const int *outputs,
+                  int num_of_outputs);
+
+/// Make network to be released by free(), and release builder.
+nn_network_t *test_build(test_network_t *n, const int *inputs,
+                         int num_of_inputs, const int *outputs,
+                         int num_of_outputs);
+
+/// Run net plain and with settings of context the tests share, twice on the
+/// same inputs, and compare outputs with references. Inputs are given in
+/// types of input variables, outputs are compared as float. Network is
+/// released.
+void test_check_network(const char *name, nn_network_t *net,
+                        const void *const *inputs,
+                        const float *const *references, float tolerance);
+
+/// Uniform value in [-0.5, 0.5) from seed.
+float test_random(unsigned *seed);
+
+void test_fill(float *data, int size, unsigned seed, float scale);
+
+/// Round values to multiples of 2^-fp_pos.
+void test_round(float *data, int size, int fp_pos);
+
+/// Nearest FLOAT16 or BFLOAT16 value of float.
+uint16_t test_to_half(nn_data_type_t type, float value);
+
+float test_from_half(nn_data_type_t type, uint16_t value);
+
+/// Largest difference between a and b relative to largest of 1 and |a|.
+float test_max_error(const float *a, const float *b, int size);
+
+/// Count failure and print message if ok is 0. Returns ok.
+int test_check(int ok, const char *format, ...);
+
+/// Number of failures so far, exit status of tests.
+int test_failures(void);
+
+#endif // H_TEST_NETWORK_H_261014180622_
@@ -0,0 +1,1022 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Outputs of a network run with each option of context, compared with the
+// plain run. Function hooks tell which functions were merged or skipped.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_MMAP
+#include <sys/mman.h>
+#endif
+
+#include "test_network.h"
+
+#define BATCH (2)
+#define CHANNELS (4)
+#define SIZE (12)
+#define MAPS (8)
+#define OUTPUTS (10)
+#define INPUT_SIZE (BATCH * CHANNELS * SIZE * SIZE)
+#define OUTPUT_SIZE (BATCH * OUTPUTS)
+#define TOLERANCE (1e-4f)
+
+// Functions of network built by build_network().
+enum {
+  F_MEAN_SUBTRACTION,
+  F_CONVOLUTION_1,
+  F_BATCH_NORMALIZATION,
+  F_RELU_1,
+  F_CONVOLUTION_2,
+  F_RELU_2,
+  F_MAX_POOLING,
+  F_MUL_SCALAR,
+  F_ADD_SCALAR,
+  F_DEAD_SIGMOID,
+  F_WEIGHT_SCALE,
+  F_AFFINE,
+  NUM_OF_FUNCTIONS
+};
+
+#define BIT(f) (1u << (f))
+
+// Functions merged into others by function fusion.
+#define FUSED                                                                  \
+  (BIT(F_MEAN_SUBTRACTION) | BIT(F_BATCH_NORMALIZATION) | BIT(F_RELU_1) |      \
+   BIT(F_RELU_2) | BIT(F_ADD_SCALAR))
+
+// Functions removed by graph simplification.
+#define SIMPLIFIED (BIT(F_DEAD_SIGMOID) | BIT(F_WEIGHT_SCALE))
+
+static float input_a[INPUT_SIZE];
+static float input_b[INPUT_SIZE];
+static float reference_a[OUTPUT_SIZE];
+static float reference_b[OUTPUT_SIZE];
+
+// MeanSubtraction whose mean is constant over each channel, so that it can be
+// folded into bias of following Convolution, then two Convolutions with
+// BatchNormalization and activations, pooling, chain of element wise
+// functions, a dead branch and Affine whose weight is calculated from
+// parameters only.
+static nn_network_t *build_network(void) {
+  test_network_t n;
+  int one[2] = {1, 1}, zero[2] = {0, 0}, two[2] = {2, 2}, axis[1] = {1};
+  int x_shape[4] = {BATCH, CHANNELS, SIZE, SIZE};
+  int mean_shape[3] = {CHANNELS, SIZE, SIZE};
+  int count_shape[1] = {1};
+  int w1_shape[4] = {MAPS, CHANNELS, 3, 3};
+  int w2_shape[4] = {MAPS, MAPS, 3, 3};
+  int bias_shape[1] = {MAPS};
+  int bn_shape[4] = {1, MAPS, 1, 1};
+  int map_shape[4] = {BATCH, MAPS, SIZE - 2, SIZE - 2};
+  int pool_shape[4] = {BATCH, MAPS, (SIZE - 2) / 2, (SIZE - 2) / 2};
+  int w3_shape[2] = {MAPS * (SIZE - 2) / 2 * (SIZE - 2) / 2, OUTPUTS};
+  int b3_shape[1] = {OUTPUTS};
+  int y_shape[2] = {BATCH, OUTPUTS};
+  float mean[CHANNELS * SIZE * SIZE], count[1] = {100};
+  float w1[MAPS * CHANNELS * 9], w2[MAPS * MAPS * 9], b1[MAPS], b2[MAPS];
+  float bn[4][MAPS];
+  float w3[MAPS * (SIZE - 2) / 2 * (SIZE - 2) / 2 * OUTPUTS], b3[OUTPUTS];
+  int x, s, c1, n1, r1, c2, r2, p, m, a, d, w3r, w3v, y;
+  int v[8];
+  int i; // Iterator
+
+  nn_function_mean_subtraction_t ms;
+  nn_function_convolution_t conv;
+  nn_function_batch_normalization_t bnf;
+  nn_function_max_pooling_t pool;
+  nn_function_mul_scalar_t mul;
+  nn_function_add_scalar_t add;
+  nn_function_affine_t affine;
+  nn_function_t plain;
+
+  for (i = 0; i < CHANNELS * SIZE * SIZE; i++) {
+    mean[i] = 90.0f + 5.0f * (i / (SIZE * SIZE));
+  }
+  test_fill(w1, MAPS * CHANNELS * 9, 1, 0.5f);
+  test_fill(w2, MAPS * MAPS * 9, 2, 0.5f);
+  test_fill(b1, MAPS, 3, 1.0f);
+  test_fill(b2, MAPS, 4, 1.0f);
+  test_fill(w3, sizeof(w3) / sizeof(w3[0]), 5, 0.2f);
+  test_fill(b3, OUTPUTS, 6, 1.0f);
+  for (i = 0; i < MAPS; i++) {
+    bn[0][i] = 0.1f * i;        // beta
+    bn[1][i] = 1.0f + 0.1f * i; // gamma
+    bn[2][i] = 0.2f - 0.05f * i;
+    bn[3][i] = 0.5f + 0.25f * i;
+  }
+
+  test_network_init(&n);
+  x = test_variable(&n, x_shape, 4, 0);
+  v[0] = test_variable(&n, mean_shape, 3, mean);
+  v[1] = test_variable(&n, count_shape, 1, count);
+  s = test_variable(&n, x_shape, 4, 0);
+  memset(&ms, 0, sizeof(ms));
+  ms.base_axis = 1;
+  v[2] = x;
+  v[3] = v[0];
+  v[4] = v[1];
+  test_function(&n, &ms, sizeof(ms), NN_FUNCTION_MEAN_SUBTRACTION, v + 2, 3,
+                &s, 1);
+
+  memset(&conv, 0, sizeof(conv));
+  conv.base_axis = 1;
+  conv.pad = test_list(&n, zero, 2);
+  conv.stride = test_list(&n, one, 2);
+  conv.dilation = test_list(&n, one, 2);
+  conv.group = 1;
+  v[0] = s;
+  v[1] = test_variable(&n, w1_shape, 4, w1);
+  v[2] = test_variable(&n, bias_shape, 1, b1);
+  c1 = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &conv, sizeof(conv), NN_FUNCTION_CONVOLUTION, v, 3, &c1,
+                1);
+
+  memset(&bnf, 0, sizeof(bnf));
+  bnf.axes = test_list(&n, axis, 1);
+  bnf.decay_rate = 0.9f;
+  bnf.eps = 1e-5f;
+  v[0] = c1;
+  for (i = 0; i < 4; i++) {
+    v[i + 1] = test_variable(&n, bn_shape, 4, bn[i]);
+  }
+  n1 = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &bnf, sizeof(bnf), NN_FUNCTION_BATCH_NORMALIZATION, v, 5,
+                &n1, 1);
+
+  memset(&plain, 0, sizeof(plain));
+  r1 = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &plain, sizeof(plain), NN_FUNCTION_RELU, &n1, 1, &r1, 1);
+
+  conv.pad = test_list(&n, one, 2);
+  v[0] = r1;
+  v[1] = test_variable(&n, w2_shape, 4, w2);
+  v[2] = test_variable(&n, bias_shape, 1, b2);
+  c2 = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &conv, sizeof(conv), NN_FUNCTION_CONVOLUTION, v, 3, &c2,
+                1);
+
+  r2 = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &plain, sizeof(plain), NN_FUNCTION_RELU, &c2, 1, &r2, 1);
+
+  memset(&pool, 0, sizeof(pool));
+  pool.kernel = test_list(&n, two, 2);
+  pool.stride = test_list(&n, two, 2);
+  pool.ignore_border = 1;
+  pool.pad = test_list(&n, zero, 2);
+  p = test_variable(&n, pool_shape, 4, 0);
+  test_function(&n, &pool, sizeof(pool), NN_FUNCTION_MAX_POOLING, &r2, 1, &p,
+                1);
+
+  memset(&mul, 0, sizeof(mul));
+  mul.val = 0.5f;
+  m = test_variable(&n, pool_shape, 4, 0);
+  test_function(&n, &mul, sizeof(mul), NN_FUNCTION_MUL_SCALAR, &p, 1, &m, 1);
+
+  memset(&add, 0, sizeof(add));
+  add.val = 0.25f;
+  a = test_variable(&n, pool_shape, 4, 0);
+  test_function(&n, &add, sizeof(add), NN_FUNCTION_ADD_SCALAR, &m, 1, &a, 1);
+
+  d = test_variable(&n, map_shape, 4, 0);
+  test_function(&n, &plain, sizeof(plain), NN_FUNCTION_SIGMOID, &r1, 1, &d,
+                1);
+
+  mul.val = 1.5f;
+  w3r = test_variable(&n, w3_shape, 2, w3);
+  w3v = test_variable(&n, w3_shape, 2, 0);
+  test_function(&n, &mul, sizeof(mul), NN_FUNCTION_MUL_SCALAR, &w3r, 1, &w3v,
+                1);
+
+  memset(&affine, 0, sizeof(affine));
+  affine.base_axis = 1;
+  v[0] = a;
+  v[1] = w3v;
+  v[2] = test_variable(&n, b3_shape, 1, b3);
+  y = test_variable(&n, y_shape, 2, 0);
+  test_function(&n, &affine, sizeof(affine), NN_FUNCTION_AFFINE, v, 3, &y,
+                1);
+
+  return test_build(&n, &x, 1, &y, 1);
+}
+
+static uint32_t called; // Functions whose pre hook was called.
+
+static void record_call(void *user_data, int index, nn_function_t *function) {
+  (void)user_data;
+  (void)function;
+  called |= BIT(index);
+}
+
+static void cancel_at(void *user_data, int index, nn_function_t *function) {
+  (void)function;
+  if (index == F_CONVOLUTION_2) {
+    rt_cancel_forward((rt_context_pointer)user_data);
+  }
+}
+
+static rt_return_value_t forward(rt_context_pointer c, const float *input) {
+  memcpy(rt_input_buffer(c, 0), input, sizeof(float) * INPUT_SIZE);
+  called = 0;
+  rt_set_function_hook(c, record_call, 0, 0);
+  return rt_forward(c);
+}
+
+// Forward of c is same as plain run within tolerance.
+static int check_output(rt_context_pointer c, const float *reference,
+                        float tolerance, const char *name) {
+  float error;
+  if (!test_check(rt_output_size(c, 0) == OUTPUT_SIZE,
+                  "%s: output size %d", name, rt_output_size(c, 0))) {
+    return 0;
+  }
+  error = test_max_error(reference, rt_output_buffer(c, 0), OUTPUT_SIZE);
+  return test_check(error <= tolerance, "%s: error %g", name, error);
+}
+
+static int check_forward(rt_context_pointer c, const float *input,
+                         const float *reference, float tolerance,
+                         const char *name) {
+  rt_return_value_t ret = forward(c, input);
+  if (!test_check(ret == RT_RET_NOERROR, "%s: forward returned %d", name,
+                  ret)) {
+    return 0;
+  }
+  return check_output(c, reference, tolerance, name);
+}
+
+typedef void (*setup_t)(rt_context_pointer c);
+
+static rt_context_pointer initialize(nn_network_t *net, setup_t setup,
+                                     const char *name) {
+  rt_context_pointer c = 0;
+  rt_return_value_t ret;
+  if (!test_check(rt_allocate_context(&c) == RT_RET_NOERROR,
+                  "%s: allocate context", name)) {
+    return 0;
+  }
+  if (setup) {
+    setup(c);
+  }
+  ret = rt_initialize_context(c, net);
+  if (!test_check(ret == RT_RET_NOERROR, "%s: initialize returned %d", name,
+                  ret)) {
+    rt_free_context(&c);
+    return 0;
+  }
+  return c;
+}
+
+static void set_planning(rt_context_pointer c) {
+  rt_set_buffer_planning(c, 1);
+}
+
+static void set_arena(rt_context_pointer c) {
+  rt_set_context_arena(c, 0, 0);
+}
+
+static void set_threads(rt_context_pointer c) { rt_set_num_threads(c, 3); }
+
+static void set_graph_execution(rt_context_pointer c) {
+  rt_set_graph_execution(c, 1);
+  rt_set_num_threads(c, 4);
+}
+
+static void set_fusion(rt_context_pointer c) { rt_set_function_fusion(c, 1); }
+
+static void set_no_prepack(rt_context_pointer c) {
+  rt_set_weight_prepack_limit(c, 0);
+}
+
+static void set_fast_math(rt_context_pointer c) { rt_set_fast_math(c, 1); }
+
+static void set_tuning(rt_context_pointer c) { rt_set_kernel_tuning(c, 1); }
+
+static void set_simplification(rt_context_pointer c) {
+  rt_set_graph_simplification(c, 1);
+}
+
+static void set_tiled(rt_context_pointer c) {
+  rt_set_buffer_planning(c, 1);
+  rt_set_tiled_execution(c, 4096);
+}
+
+// Options of context which change how the network is run.
+static void set_all(rt_context_pointer c) {
+  rt_set_buffer_planning(c, 1);
+  rt_set_function_fusion(c, 1);
+  rt_set_graph_simplification(c, 1);
+}
+
+typedef struct {
+  const char *name;
+  setup_t setup;
+  float tolerance;
+  uint32_t skipped; // Functions whose hooks are not called.
+} option_t;
+
+static const option_t options[] = {
+    {"buffer planning", set_planning, 0, 0},
+    {"context arena", set_arena, 0, 0},
+    {"threads", set_threads, TOLERANCE, 0},
+    {"graph execution", set_graph_execution, TOLERANCE, 0},
+    {"function fusion", set_fusion, TOLERANCE, FUSED},
+    {"combined options", set_all, TOLERANCE,
+     FUSED | SIMPLIFIED},
+    {"no weight prepack", set_no_prepack, TOLERANCE, 0},
+    {"fast math", set_fast_math, 1e-3f, 0},
+    {"kernel tuning", set_tuning, TOLERANCE, 0},
+    {"graph simplification", set_simplification, 0, SIMPLIFIED},
+    {"tiled execution", set_tiled, TOLERANCE,
+     BIT(F_CONVOLUTION_1) | BIT(F_BATCH_NORMALIZATION) |
+         BIT(F_CONVOLUTION_2) | BIT(F_RELU_2) | BIT(F_MAX_POOLING) |
+         BIT(F_MUL_SCALAR)},
+};
+
+static void test_option(nn_network_t *net, const option_t *o) {
+  rt_context_pointer c = initialize(net, o->setup, o->name);
+  uint32_t expected = (BIT(NUM_OF_FUNCTIONS) - 1) & ~o->skipped;
+  int run; // Iterator
+
+  if (c == 0) {
+    return;
+  }
+  // Second run checks that state of first one does not change result.
+  for (run = 0; run < 2; run++) {
+    const float *input = run ? input_b : input_a;
+    const float *reference = run ? reference_b : reference_a;
+    if (check_forward(c, input, reference, o->tolerance, o->name)) {
+      test_check(called == expected, "%s: called functions %x, expected %x",
+                 o->name, called, expected);
+    }
+  }
+  rt_free_context(&c);
+}
+
+// Context arena given as block of size measured by former initialization.
+static void test_arena_block(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_arena, "arena block");
+  size_t size;
+  void *block;
+
+  if (c == 0) {
+    return;
+  }
+  size = rt_context_arena_size(c);
+  rt_free_context(&c);
+  block = malloc(size);
+  rt_allocate_context(&c);
+  rt_set_context_arena(c, block, size);
+  if (test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+                 "arena block: initialize")) {
+    check_forward(c, input_a, reference_a, 0, "arena block");
+  }
+  rt_free_context(&c);
+  free(block);
+}
+
+// Clones, including a clone of clone, work after their source is freed.
+static void test_clone(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_all, "clone");
+  rt_context_pointer clone = 0, clone2 = 0;
+
+  if (c == 0) {
+    return;
+  }
+  if (!test_check(rt_clone_context(c, &clone) == RT_RET_NOERROR,
+                  "clone: clone")) {
+    rt_free_context(&c);
+    return;
+  }
+  if (!test_check(rt_clone_context(clone, &clone2) == RT_RET_NOERROR,
+                  "clone: clone of clone")) {
+    rt_free_context(&clone);
+    rt_free_context(&c);
+    return;
+  }
+  check_forward(clone, input_a, reference_a, TOLERANCE, "clone");
+  check_forward(c, input_b, reference_b, TOLERANCE, "clone source");
+  check_output(clone, reference_a, TOLERANCE, "clone after source run");
+  // Source is freed with its last clone.
+  rt_free_context(&c);
+  check_forward(clone2, input_b, reference_b, TOLERANCE, "clone of clone");
+  check_forward(clone, input_b, reference_b, TOLERANCE, "freed source");
+  rt_free_context(&clone2);
+  rt_free_context(&clone);
+}
+
+#ifdef HAS_MMAP
+#define ROWS (3)
+#define COLUMNS (5)
+#define DEPTH (4)
+
+// BatchMatmul of transposed parameter and transposed input, then
+// BatchNormalization with batch statistics, which used to write into their
+// parameters.
+static nn_network_t *build_writing_network(float *a, float *x, float *y) {
+  test_network_t n;
+  int a_shape[3] = {BATCH, DEPTH, ROWS}, x_shape[3] = {BATCH, COLUMNS, DEPTH};
+  int y_shape[3] = {BATCH, ROWS, COLUMNS}, bn_shape[3] = {1, ROWS, 1};
+  int axis[1] = {1};
+  float bn[4][ROWS];
+  int v[5], input, m, z;
+  nn_function_batch_matmul_t matmul;
+  nn_function_batch_normalization_t bnf;
+  int b, i, j, k; // Iterators
+
+  test_fill(a, BATCH * DEPTH * ROWS, 12, 2.0f);
+  test_fill(x, BATCH * COLUMNS * DEPTH, 13, 2.0f);
+  test_fill(bn[2], ROWS, 14, 1.0f);
+  for (i = 0; i < ROWS; i++) {
+    bn[0][i] = 0.5f * i;
+    bn[1][i] = 1.0f + 0.25f * i;
+    bn[3][i] = 1.0f;
+  }
+  // Reference, y = a^T x^T normalized over batch and columns.
+  for (i = 0; i < ROWS; i++) {
+    double sum = 0, square = 0, mean, var;
+    for (b = 0; b < BATCH; b++) {
+      for (j = 0; j < COLUMNS; j++) {
+        double value = 0;
+        for (k = 0; k < DEPTH; k++) {
+          value += a[(b * DEPTH + k) * ROWS + i] *
+                   x[(b * COLUMNS + j) * DEPTH + k];
+        }
+        y[(b * ROWS + i) * COLUMNS + j] = (float)value;
+        sum += value;
+      }
+    }
+    mean = sum / (BATCH * COLUMNS);
+    for (b = 0; b < BATCH; b++) {
+      for (j = 0; j < COLUMNS; j++) {
+        double d = y[(b * ROWS + i) * COLUMNS + j] - mean;
+        square += d * d;
+      }
+    }
+    var = square / (BATCH * COLUMNS);
+    for (b = 0; b < BATCH; b++) {
+      for (j = 0; j < COLUMNS; j++) {
+        float *o = y + (b * ROWS + i) * COLUMNS + j;
+        *o = (float)((*o - mean) / sqrt(var + 1e-5) * bn[1][i] + bn[0][i]);
+      }
+    }
+  }
+
+  test_network_init(&n);
+  v[0] = test_variable(&n, a_shape, 3, a);
+  v[1] = input = test_variable(&n, x_shape, 3, 0);
+  m = test_variable(&n, y_shape, 3, 0);
+  memset(&matmul, 0, sizeof(matmul));
+  matmul.transpose_a = 1;
+  matmul.transpose_b = 1;
+  test_function(&n, &matmul, sizeof(matmul), NN_FUNCTION_BATCH_MATMUL, v, 2,
+                &m, 1);
+  memset(&bnf, 0, sizeof(bnf));
+  bnf.axes = test_list(&n, axis, 1);
+  bnf.decay_rate = 0.9f;
+  bnf.eps = 1e-5f;
+  bnf.batch_stat = 1;
+  v[0] = m;
+  for (i = 0; i < 4; i++) {
+    v[i + 1] = test_variable(&n, bn_shape, 3, bn[i]);
+  }
+  z = test_variable(&n, y_shape, 3, 0);
+  test_function(&n, &bnf, sizeof(bnf), NN_FUNCTION_BATCH_NORMALIZATION, v, 5,
+                &z, 1);
+  return test_build(&n, &input, 1, &z, 1);
+}
+
+// Read only mapping of copy of net with api_level newer than runtime knows,
+// which runtime used to overwrite.
+static nn_network_t *map_read_only(const nn_network_t *net, size_t *size) {
+  void *map;
+  *size = sizeof(*net) + sizeof(int32_t) * net->memory.num_of_data +
+          net->memory.data_size;
+  map = mmap(0, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+             -1, 0);
+  if (map == MAP_FAILED) {
+    return 0;
+  }
+  memcpy(map, net, *size);
+  ((nn_network_t *)map)->api_level = NN_API_LEVEL_MAX + 1;
+  mprotect(map, *size, PROT_READ);
+  return (nn_network_t *)map;
+}
+
+static void test_read_only(const nn_network_t *net, const float *input,
+                           const float *reference, int input_size,
+                           int output_size, const char *name) {
+  size_t size;
+  nn_network_t *map = map_read_only(net, &size);
+  rt_context_pointer c = 0;
+  int run; // Iterator
+
+  if (!test_check(map != 0, "%s: map", name)) {
+    return;
+  }
+  rt_allocate_context(&c);
+  if (test_check(rt_initialize_context(c, map) == RT_RET_NOERROR,
+                 "%s: initialize", name)) {
+    for (run = 0; run < 2; run++) {
+      float error;
+      memcpy(rt_input_buffer(c, 0), input, sizeof(float) * input_size);
+      test_check(rt_forward(c) == RT_RET_NOERROR, "%s: forward", name);
+      error = test_max_error(reference, rt_output_buffer(c, 0), output_size);
+      test_check(error <= TOLERANCE, "%s: error %g", name, error);
+    }
+  }
+  rt_free_context(&c);
+  munmap(map, size);
+}
+
+static void test_read_only_networks(nn_network_t *net) {
+  float a[BATCH * DEPTH * ROWS], x[BATCH * COLUMNS * DEPTH];
+  float y[BATCH * ROWS * COLUMNS];
+  nn_network_t *writing = build_writing_network(a, x, y);
+
+  test_read_only(net, input_a, reference_a, INPUT_SIZE, OUTPUT_SIZE,
+                 "read only network");
+  test_read_only(writing, x, y, BATCH * COLUMNS * DEPTH,
+                 BATCH * ROWS * COLUMNS, "read only BatchMatmul");
+  free(writing);
+}
+#endif
+
+// Context in user block of size measured by former initialization.
+static void test_static_context(nn_network_t *net) {
+  rt_context_pointer c = 0;
+  size_t size;
+  void *block;
+
+  rt_allocate_static_context(&c, 0, 0);
+  set_all(c);
+  test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+             "static context: measuring initialization");
+  size = rt_static_context_size(c);
+  rt_free_context(&c);
+  if (!test_check(size > 0, "static context: size 0")) {
+    return;
+  }
+  block = malloc(size);
+  if (!test_check(rt_allocate_static_context(&c, block, size) ==
+                      RT_RET_NOERROR,
+                  "static context: allocate")) {
+    free(block);
+    return;
+  }
+  set_all(c);
+  if (test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+                 "static context: initialize")) {
+    check_forward(c, input_a, reference_a, TOLERANCE, "static context");
+    check_forward(c, input_b, reference_b, TOLERANCE, "static context");
+  }
+  rt_free_context(&c);
+  free(block);
+}
+
+static void set_plan_record(rt_context_pointer c) {
+  set_all(c);
+  rt_set_kernel_tuning(c, 1);
+  rt_set_plan_cache(c, 0, 0);
+}
+
+// Plan recorded by one context and reused by another.
+static void test_plan_cache(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_plan_record, "plan cache");
+  const void *plan;
+  void *copy;
+  size_t size;
+  int reused = -1;
+
+  if (c == 0) {
+    return;
+  }
+  if (!test_check(rt_get_plan_cache(c, &plan, &size, &reused) ==
+                      RT_RET_NOERROR,
+                  "plan cache: no plan recorded")) {
+    rt_free_context(&c);
+    return;
+  }
+  test_check(reused == 0, "plan cache: first plan reused");
+  copy = malloc(size);
+  memcpy(copy, plan, size);
+  rt_free_context(&c);
+
+  rt_allocate_context(&c);
+  set_all(c);
+  rt_set_kernel_tuning(c, 1);
+  rt_set_plan_cache(c, copy, size);
+  if (test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+                 "plan cache: initialize with plan")) {
+    rt_get_plan_cache(c, &plan, &size, &reused);
+    test_check(reused == 1, "plan cache: plan not reused");
+    check_forward(c, input_a, reference_a, TOLERANCE, "plan cache");
+  }
+  rt_free_context(&c);
+  free(copy);
+}
+
+// Kernels chosen by tuning and given to another context.
+static void test_kernel_choices(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_tuning, "kernel choices");
+  const uint8_t *choices;
+  uint8_t copy[NUM_OF_FUNCTIONS];
+  int num = 0;
+
+  if (c == 0) {
+    return;
+  }
+  rt_get_kernel_choices(c, &choices, &num);
+  if (num == NUM_OF_FUNCTIONS) {
+    memcpy(copy, choices, num);
+  }
+  rt_free_context(&c);
+  if (!test_check(num == NUM_OF_FUNCTIONS, "kernel choices: %d choices",
+                  num)) {
+    return;
+  }
+  rt_allocate_context(&c);
+  rt_set_kernel_choices(c, copy, num);
+  if (test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+                 "kernel choices: initialize")) {
+    check_forward(c, input_a, reference_a, TOLERANCE, "kernel choices");
+    rt_get_kernel_choices(c, &choices, &num);
+    test_check(num == NUM_OF_FUNCTIONS && memcmp(copy, choices, num) == 0,
+               "kernel choices: choices are not kept");
+  }
+  rt_free_context(&c);
+}
+
+static void test_result_caching(nn_network_t *net, rt_result_caching_t mode,
+                                const char *name) {
+  rt_context_pointer c = 0;
+
+  rt_allocate_context(&c);
+  rt_set_result_caching(c, mode);
+  if (!test_check(rt_initialize_context(c, net) == RT_RET_NOERROR,
+                  "%s: initialize", name)) {
+    rt_free_context(&c);
+    return;
+  }
+  check_forward(c, input_a, reference_a, 0, name);
+  if (mode == RT_RESULT_CACHING_MARKED) {
+    rt_mark_input_changed(c, 0);
+  }
+  check_forward(c, input_b, reference_b, 0, name);
+  // Unchanged input runs only functions which depend on nothing.
+  if (check_forward(c, input_b, reference_b, 0, name)) {
+    test_check((called & BIT(F_AFFINE)) == 0,
+               "%s: functions run with unchanged input %x", name, called);
+  }
+  rt_free_context(&c);
+}
+
+static void test_cancel(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_threads, "cancel");
+  rt_return_value_t ret;
+
+  if (c == 0) {
+    return;
+  }
+  memcpy(rt_input_buffer(c, 0), input_a, sizeof(input_a));
+  rt_set_function_hook(c, cancel_at, 0, c);
+  ret = rt_forward(c);
+  test_check(ret == RT_RET_ERROR_FORWARD_ABORTED, "cancel: forward returned %d",
+             ret);
+  // Later forward is not aborted.
+  check_forward(c, input_b, reference_b, TOLERANCE, "after cancel");
+  // Cancel before start aborts next forward only.
+  rt_cancel_forward(c);
+  ret = forward(c, input_a);
+  test_check(ret == RT_RET_ERROR_FORWARD_ABORTED,
+             "cancel before start: forward returned %d", ret);
+  test_check(called == 0, "cancel before start: called functions %x",
+             called);
+  check_forward(c, input_b, reference_b, TOLERANCE,
+                "after cancel before start");
+  rt_free_context(&c);
+}
+
+static void finish_async(void *user_data, rt_context_pointer context,
+                         rt_return_value_t result) {
+  (void)context;
+  *(rt_return_value_t *)user_data = result;
+}
+
+static void test_async(nn_network_t *net) {
+  rt_context_pointer c = initialize(net, set_threads, "async");
+  rt_return_value_t result = RT_RET_END_OF_VALUES;
+
+  if (c == 0) {
+    return;
+  }
+  memcpy(rt_input_buffer(c, 0), input_b, sizeof(input_b));
+  rt_set_function_hook(c, 0, 0, 0);
+  if (test_check(rt_forward_async(c, finish_async, &result) ==
+                     RT_RET_NOERROR,
+                 "async: start")) {
+    test_check(rt_wait_forward(c) == RT_RET_NOERROR, "async: wait");
+    test_check(result == RT_RET_NOERROR, "async: done got %d", result);
+    check_output(c, reference_b, TOLERANCE, "async");
+  }
+  rt_free_context(&c);
+}
+
+typedef struct {
+  const float *input;
+  const float *reference;
+  float error;
+  rt_return_value_t result;
+} request_data_t;
+
+static void prepare_request(void *user_data, rt_context_pointer context) {
+  request_data_t *r = (request_data_t *)user_data;
+  memcpy(rt_input_buffer(context, 0), r->input, sizeof(input_a));
+}
+
+static void finish_request(void *user_data, rt_context_pointer context,
+                           rt_return_value_t result) {
+  request_data_t *r = (request_data_t *)user_data;
+  r->result = result;
+  r->error = test_max_error(r->reference, rt_output_buffer(context, 0),
+                            OUTPUT_SIZE);
+}
+
+// Requests run by a queue of clones, each on own thread.
+static void test_request_queue(nn_network_t *net) {
+  rt_context_pointer contexts[2] = {0, 0};
+  rt_request_queue_pointer queue = 0;
+  request_data_t data[6];
+  rt_request_t request;
+  int i; // Iterator
+
+  contexts[0] = initialize(net, set_all, "request queue");
+  if (contexts[0] == 0) {
+    return;
+  }
+  rt_clone_context(contexts[0], &contexts[1]);
+  if (test_check(rt_create_request_queue(&queue, contexts, 2, 6) ==
+                     RT_RET_NOERROR,
+                 "request queue: create")) {
+    for (i = 0; i < 6; i++) {
+      data[i].input = i % 2 ? input_b : input_a;
+      data[i].reference = i % 2 ? reference_b : reference_a;
+      data[i].error = -1;
+      data[i].result = RT_RET_END_OF_VALUES;
+      request.prepare = prepare_request;
+      request.done = finish_request;
+      request.user_data = data + i;
+      test_check(rt_submit_request(queue, &request) == RT_RET_NOERROR,
+                 "request queue: submit %d", i);
+    }
+    rt_wait_requests(queue);
+    rt_destroy_request_queue(&queue);
+    for (i = 0; i < 6; i++) {
+      test_check(data[i].result == RT_RET_NOERROR &&
+                     data[i].error >= 0 && data[i].error <= TOLERANCE,
+                 "request queue: request %d returned %d, error %g", i,
+                 data[i].result, data[i].error);
+    }
+  }
+  rt_free_context(&contexts[1]);
+  rt_free_context(&contexts[0]);
+}
+
+#define WINDOW (16)
+#define HOP (4)
+#define WINDOWS (6)
+
+// Convolution along time, run on windows of a signal moved by HOP.
+static nn_network_t *build_window_network(void) {
+  test_network_t n;
+  int one[1] = {1};
+  int x_shape[3] = {1, 2, WINDOW}, w_shape[3] = {4, 2, 3};
+  int b_shape[1] = {4}, y_shape[3] = {1, 4, WINDOW};
+  float w[4 * 2 * 3], b[4];
+  int v[3], c, y;
+  nn_function_convolution_t conv;
+  nn_function_t relu;
+
+  test_fill(w, 4 * 2 * 3, 7, 1.0f);
+  test_fill(b, 4, 8, 1.0f);
+  test_network_init(&n);
+  v[0] = test_variable(&n, x_shape, 3, 0);
+  v[1] = test_variable(&n, w_shape, 3, w);
+  v[2] = test_variable(&n, b_shape, 1, b);
+  c = test_variable(&n, y_shape, 3, 0);
+  memset(&conv, 0, sizeof(conv));
+  conv.base_axis = 1;
+  conv.pad = test_list(&n, one, 1);
+  conv.stride = test_list(&n, one, 1);
+  conv.dilation = test_list(&n, one, 1);
+  conv.group = 1;
+  test_function(&n, &conv, sizeof(conv), NN_FUNCTION_CONVOLUTION, v, 3, &c,
+                1);
+  memset(&relu, 0, sizeof(relu));
+  y = test_variable(&n, y_shape, 3, 0);
+  test_function(&n, &relu, sizeof(relu), NN_FUNCTION_RELU, &c, 1, &y, 1);
+  return test_build(&n, v, 1, &y, 1);
+}
+
+static void test_streaming_window(void) {
+  nn_network_t *net = build_window_network();
+  float signal[2][WINDOW + HOP * WINDOWS];
+  rt_context_pointer plain = 0, stream = 0;
+  int k, ch; // Iterators
+
+  test_fill(signal[0], sizeof(signal) / sizeof(float), 9, 4.0f);
+  rt_allocate_context(&plain);
+  rt_allocate_context(&stream);
+  rt_set_streaming_window(stream, HOP);
+  if (test_check(rt_initialize_context(plain, net) == RT_RET_NOERROR &&
+                     rt_initialize_context(stream, net) == RT_RET_NOERROR,
+                 "streaming window: initialize")) {
+    for (k = 0; k < WINDOWS; k++) {
+      float *inputs[2] = {rt_input_buffer(plain, 0),
+                          rt_input_buffer(stream, 0)};
+      float error;
+      for (ch = 0; ch < 2; ch++) {
+        memcpy(inputs[0] + ch * WINDOW, signal[ch] + k * HOP,
+               sizeof(float) * WINDOW);
+        memcpy(inputs[1] + ch * WINDOW, signal[ch] + k * HOP,
+               sizeof(float) * WINDOW);
+      }
+      rt_forward(plain);
+      test_check(rt_forward(stream) == RT_RET_NOERROR,
+                 "streaming window: forward %d", k);
+      error = test_max_error(rt_output_buffer(plain, 0),
+                             rt_output_buffer(stream, 0), 4 * WINDOW);
+      test_check(error <= TOLERANCE, "streaming window %d: error %g", k,
+                 error);
+    }
+  }
+  rt_free_context(&stream);
+  rt_free_context(&plain);
+  free(net);
+}
+
+// Forward with batch of samples of input_a, each repeated times.
+static void check_reshaped(rt_context_pointer c, int batch, int times,
+                           const char *name) {
+  int shape[4] = {batch * times, CHANNELS, SIZE, SIZE};
+  int sample = INPUT_SIZE / BATCH;
+  float *input;
+  int i, k; // Iterators
+
+  if (!test_check(rt_reshape_input(c, 0, shape) == RT_RET_NOERROR,
+                  "%s: reshape", name) ||
+      !test_check(rt_output_size(c, 0) == batch * times * OUTPUTS,
+                  "%s: output size %d", name, rt_output_size(c, 0))) {
+    return;
+  }
+  input = rt_input_buffer(c, 0);
+  for (k = 0; k < times; k++) {
+    memcpy(input + k * batch * sample, input_a,
+           sizeof(float) * batch * sample);
+  }
+  test_check(rt_forward(c) == RT_RET_NOERROR, "%s: forward", name);
+  for (k = 0; k < times; k++) {
+    float *output = (float *)rt_output_buffer(c, 0) + k * batch * OUTPUTS;
+    for (i = 0; i < batch * OUTPUTS; i++) {
+      test_check(fabsf(output[i] - reference_a[i]) <= TOLERANCE,
+                 "%s: output %d is %g, expected %g", name, i, output[i],
+                 reference_a[i]);
+    }
+  }
+}
+
+// Transpose whose output has batch as second axis, then MulScalar.
+static nn_network_t *build_transposed_batch_network(void) {
+  test_network_t n;
+  int x_shape[2] = {2, 3}, y_shape[2] = {3, 2}, axes[2] = {1, 0};
+  int x, t, y;
+  nn_function_transpose_t transpose;
+  nn_function_mul_scalar_t mul;
+
+  test_network_init(&n);
+  x = test_variable(&n, x_shape, 2, 0);
+  t = test_variable(&n, y_shape, 2, 0);
+  y = test_variable(&n, y_shape, 2, 0);
+  memset(&transpose, 0, sizeof(transpose));
+  transpose.axes = test_list(&n, axes, 2);
+  test_function(&n, &transpose, sizeof(transpose), NN_FUNCTION_TRANSPOSE, &x,
+                1, &t, 1);
+  memset(&mul, 0, sizeof(mul));
+  mul.val = 2.0f;
+  test_function(&n, &mul, sizeof(mul), NN_FUNCTION_MUL_SCALAR, &t, 1, &y, 1);
+  return test_build(&n, &x, 1, &y, 1);
+}
+
+static void test_reshape(nn_network_t *net) {
+  nn_network_t *transposed = build_transposed_batch_network();
+  rt_context_pointer c = initialize(net, 0, "reshape");
+  int shape[2] = {4, 3};
+
+  if (c != 0) {
+    check_reshaped(c, 1, 1, "reshape to 1");
+    check_reshaped(c, BATCH, 2, "reshape to 4");
+    rt_free_context(&c);
+  }
+  // Shape of Transpose output cannot be derived.
+  c = initialize(transposed, 0, "reshape transposed batch");
+  if (c != 0) {
+    rt_return_value_t ret = rt_reshape_input(c, 0, shape);
+    test_check(ret == RT_RET_ERROR_INVALID_SHAPE,
+               "reshape transposed batch: returned %d", ret);
+    rt_free_context(&c);
+  }
+  free(transposed);
+}
+
+static void test_invalid_arguments(void) {
+  rt_allocator_t allocator = {0, 0, 0};
+  rt_trace_event_t event;
+  rt_context_pointer c = 0;
+  rt_return_value_t ret;
+
+  rt_allocate_context(&c);
+  ret = rt_set_context_allocator(c, &allocator);
+  test_check(ret == RT_RET_ERROR_INVALID_ARGUMENT,
+             "allocator without functions: returned %d", ret);
+  rt_free_context(&c);
+  rt_allocate_static_context(&c, 0, 0);
+  ret = rt_set_variable_allocator(c, 0);
+  test_check(ret == RT_RET_ERROR_INVALID_ARGUMENT,
+             "allocator of static context: returned %d", ret);
+  rt_free_context(&c);
+  rt_allocate_context(&c);
+  ret = rt_set_trace(c, 0, 4);
+  test_check(ret == RT_RET_ERROR_INVALID_ARGUMENT,
+             "trace without events: returned %d", ret);
+  ret = rt_set_trace(c, &event, -1);
+  test_check(ret == RT_RET_ERROR_INVALID_ARGUMENT,
+             "trace of negative capacity: returned %d", ret);
+  ret = rt_set_huge_pages(c, END_OF_RT_HUGE_PAGES);
+  test_check(ret == RT_RET_ERROR_INVALID_ARGUMENT,
+             "unknown huge pages: returned %d", ret);
+  rt_free_context(&c);
+}
+
+int main(void) {
+  nn_network_t *net = build_network();
+  rt_context_pointer c;
+  size_t i; // Iterator
+
+  test_fill(input_a, INPUT_SIZE, 10, 20.0f);
+  test_fill(input_b, INPUT_SIZE, 11, 20.0f);
+  for (i = 0; i < INPUT_SIZE; i++) {
+    input_a[i] += 100.0f;
+    input_b[i] += 100.0f;
+  }
+
+  c = initialize(net, 0, "plain");
+  if (c == 0) {
+    return 1;
+  }
+  forward(c, input_a);
+  test_check(called == BIT(NUM_OF_FUNCTIONS) - 1,
+             "plain: called functions %x", called);
+  memcpy(reference_a, rt_output_buffer(c, 0), sizeof(reference_a));
+  forward(c, input_b);
+  memcpy(reference_b, rt_output_buffer(c, 0), sizeof(reference_b));
+  rt_free_context(&c);
+
+  for (i = 0; i < sizeof(options) / sizeof(options[0]); i++) {
+    test_option(net, options + i);
+  }
+  test_arena_block(net);
+  test_clone(net);
+#ifdef HAS_MMAP
+  test_read_only_networks(net);
+#endif
+  test_plan_cache(net);
+  test_kernel_choices(net);
+  test_async(net);
+  test_request_queue(net);
+  test_streaming_window();
+  test_result_caching(net, RT_RESULT_CACHING_MARKED, "marked result caching");
+  test_result_caching(net, RT_RESULT_CACHING_HASHED, "hashed result caching");
+  test_static_context(net);
+  test_cancel(net);
+  test_reshape(net);
+  test_invalid_arguments();
+
+  free(net);
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
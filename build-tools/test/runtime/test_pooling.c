@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Pooling kernels compared with loops over windows of each output.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_network.h"
+
+#define TOLERANCE (1e-5f)
+
+typedef struct {
+  const char *name;
+  int type; // MaxPooling, AveragePooling or SumPooling.
+  int batch;
+  int channels;
+  int size[2];
+  int kernel[2];
+  int stride[2];
+  int pad[2];
+  int ignore_border;
+  int including_pad;
+  int channel_last;
+} pool_t;
+
+static void output_shape(const pool_t *k, int *shape) {
+  int d; // Iterator
+  for (d = 0; d < 2; d++) {
+    shape[d] = (k->size[d] + k->pad[d] -
+                (k->ignore_border ? k->kernel[d] - k->pad[d] : 1)) /
+                   k->stride[d] +
+               1;
+  }
+}
+
+// Index of x at (n, c, h, w) in layout of case.
+static int index_of(const pool_t *k, const int *shape, int n, int c, int h,
+                    int w) {
+  return k->channel_last
+             ? ((n * shape[0] + h) * shape[1] + w) * k->channels + c
+             : ((n * k->channels + c) * shape[0] + h) * shape[1] + w;
+}
+
+static void pool_reference(const pool_t *k, const float *x, float *y) {
+  int out[2];
+  int n, c, oh, ow, h, w; // Iterators
+
+  output_shape(k, out);
+  for (n = 0; n < k->batch; n++) {
+    for (c = 0; c < k->channels; c++) {
+      for (oh = 0; oh < out[0]; oh++) {
+        for (ow = 0; ow < out[1]; ow++) {
+          int h0 = oh * k->stride[0] - k->pad[0];
+          int w0 = ow * k->stride[1] - k->pad[1];
+          int h1 = h0 + k->kernel[0], w1 = w0 + k->kernel[1];
+          int count = 0, pool_size;
+          float value = 0;
+          h1 = h1 < k->size[0] + k->pad[0] ? h1 : k->size[0] + k->pad[0];
+          w1 = w1 < k->size[1] + k->pad[1] ? w1 : k->size[1] + k->pad[1];
+          pool_size = (h1 - h0) * (w1 - w0);
+          for (h = h0 < 0 ? 0 : h0; h < h1 && h < k->size[0]; h++) {
+            for (w = w0 < 0 ? 0 : w0; w < w1 && w < k->size[1]; w++) {
+              float v = x[index_of(k, k->size, n, c, h, w)];
+              if (k->type == NN_FUNCTION_MAX_POOLING) {
+                value = count == 0 || v > value ? v : value;
+              } else {
+                value += v;
+              }
+              count++;
+            }
+          }
+          if (k->type == NN_FUNCTION_AVERAGE_POOLING) {
+            value /= k->including_pad ? pool_size : count;
+          }
+          y[index_of(k, out, n, c, oh, ow)] = value;
+        }
+      }
+    }
+  }
+}
+
+static void test_pooling(const pool_t *k, unsigned seed) {
+  test_network_t n;
+  int out[2], x_shape[4], y_shape[4], v[2];
+  int x_size = k->batch * k->channels * k->size[0] * k->size[1];
+  int y_size;
+  float *x, *y;
+  nn_function_average_pooling_t f; // MaxPooling and SumPooling are prefix.
+
+  output_shape(k, out);
+  y_size = k->batch * k->channels * out[0] * out[1];
+  x = malloc(sizeof(float) * x_size);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(x, x_size, seed, 8.0f);
+  pool_reference(k, x, y);
+
+  x_shape[0] = y_shape[0] = k->batch;
+  x_shape[k->channel_last ? 3 : 1] = y_shape[k->channel_last ? 3 : 1] =
+      k->channels;
+  x_shape[k->channel_last ? 1 : 2] = k->size[0];
+  x_shape[k->channel_last ? 2 : 3] = k->size[1];
+  y_shape[k->channel_last ? 1 : 2] = out[0];
+  y_shape[k->channel_last ? 2 : 3] = out[1];
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.kernel = test_list(&n, k->kernel, 2);
+  f.stride = test_list(&n, k->stride, 2);
+  f.ignore_border = k->ignore_border;
+  f.pad = test_list(&n, k->pad, 2);
+  f.channel_last = k->channel_last;
+  f.including_pad = k->including_pad;
+  v[0] = test_variable(&n, x_shape, 4, 0);
+  v[1] = test_variable(&n, y_shape, 4, 0);
+  test_function(&n, &f,
+                k->type == NN_FUNCTION_AVERAGE_POOLING
+                    ? sizeof(nn_function_average_pooling_t)
+                    : sizeof(nn_function_max_pooling_t),
+                k->type, v, 1, v + 1, 1);
+  test_check_network(k->name, test_build(&n, v, 1, v + 1, 1),
+                     (const void *const[]){x}, (const float *const[]){y},
+                     TOLERANCE);
+  free(x);
+  free(y);
+}
+
+// Unpooling of x of shape repeating each value kernel times on last axes.
+static void test_unpooling(const char *name, const int *shape,
+                           const int *kernel, int kernel_size,
+                           unsigned seed) {
+  test_network_t n;
+  nn_function_unpooling_t f;
+  int y_shape[4], v[2];
+  int x_size = 1, y_size = 1;
+  int diff = 4 - kernel_size;
+  float *x, *y;
+  int i, d; // Iterators
+
+  for (d = 0; d < 4; d++) {
+    y_shape[d] = shape[d] * (d < diff ? 1 : kernel[d - diff]);
+    x_size *= shape[d];
+    y_size *= y_shape[d];
+  }
+  x = malloc(sizeof(float) * x_size);
+  y = malloc(sizeof(float) * y_size);
+  test_fill(x, x_size, seed, 8.0f);
+  for (i = 0; i < y_size; i++) {
+    int t = i, xi = 0, stride = 1;
+    for (d = 3; d >= 0; d--) {
+      int position = t % y_shape[d];
+      t /= y_shape[d];
+      xi += position / (y_shape[d] / shape[d]) * stride;
+      stride *= shape[d];
+    }
+    y[i] = x[xi];
+  }
+  test_network_init(&n);
+  memset(&f, 0, sizeof(f));
+  f.kernel = test_list(&n, kernel, kernel_size);
+  v[0] = test_variable(&n, shape, 4, 0);
+  v[1] = test_variable(&n, y_shape, 4, 0);
+  test_function(&n, &f, sizeof(f), NN_FUNCTION_UNPOOLING, v, 1, v + 1, 1);
+  test_check_network(name, test_build(&n, v, 1, v + 1, 1),
+                     (const void *const[]){x}, (const float *const[]){y}, 0);
+  free(x);
+  free(y);
+}
+
+#define MAX NN_FUNCTION_MAX_POOLING
+#define AVERAGE NN_FUNCTION_AVERAGE_POOLING
+#define SUM NN_FUNCTION_SUM_POOLING
+
+// name, type, batch, channels, size, kernel, stride, pad, ignore_border,
+// including_pad, channel_last
+static const pool_t cases[] = {
+    {"MaxPooling", MAX, 2, 3, {8, 9}, {2, 2}, {2, 2}, {0, 0}, 1, 0, 0},
+    {"MaxPooling with pad", MAX, 1, 2, {7, 9}, {3, 3}, {2, 2}, {1, 1}, 1, 0,
+     0},
+    {"AveragePooling", AVERAGE, 2, 3, {9, 8}, {3, 2}, {1, 2}, {1, 0}, 1, 1,
+     0},
+    {"AveragePooling excluding pad", AVERAGE, 1, 3, {7, 7}, {3, 3}, {2, 2},
+     {1, 1}, 1, 0, 0},
+    {"SumPooling", SUM, 1, 4, {6, 7}, {2, 3}, {2, 1}, {0, 1}, 1, 0, 0},
+    {"MaxPooling channel last", MAX, 2, 5, {8, 9}, {2, 2}, {2, 2}, {0, 0},
+     1, 0, 1},
+    {"AveragePooling channel last", AVERAGE, 1, 3, {7, 9}, {3, 3}, {2, 2},
+     {1, 1}, 1, 1, 1},
+    {"AveragePooling channel last excluding pad", AVERAGE, 2, 4, {7, 7},
+     {3, 3}, {1, 1}, {1, 1}, 1, 0, 1},
+    {"SumPooling channel last", SUM, 1, 6, {6, 8}, {2, 3}, {1, 2}, {0, 1},
+     1, 0, 1},
+    {"MaxPooling 2x2 rows", MAX, 2, 3, {20, 37}, {2, 2}, {2, 2}, {0, 0}, 1,
+     0, 0},
+    {"MaxPooling 3x3 stride 1", MAX, 1, 2, {19, 41}, {3, 3}, {1, 1},
+     {1, 1}, 1, 0, 0},
+    {"MaxPooling 3x3 not ignoring border", MAX, 1, 3, {21, 30}, {3, 3},
+     {2, 2}, {0, 0}, 0, 0, 0},
+    {"AveragePooling 2x2 stride 1", AVERAGE, 2, 2, {17, 33}, {2, 2},
+     {1, 1}, {0, 0}, 1, 0, 0},
+    {"AveragePooling 3x3 stride 2", AVERAGE, 1, 3, {24, 35}, {3, 3},
+     {2, 2}, {1, 1}, 1, 1, 0},
+    {"AveragePooling 3x3 excluding pad", AVERAGE, 1, 2, {23, 29}, {3, 3},
+     {2, 2}, {1, 1}, 0, 0, 0},
+    {"SumPooling 2x2", SUM, 1, 3, {16, 40}, {2, 2}, {2, 2}, {0, 0}, 1, 0,
+     0},
+    {"SumPooling 3x3 stride 1", SUM, 2, 2, {18, 27}, {3, 3}, {1, 1},
+     {1, 1}, 1, 0, 0},
+    {"MaxPooling 4x3", MAX, 1, 2, {22, 31}, {4, 3}, {3, 2}, {1, 1}, 1, 0,
+     0},
+};
+
+int main(void) {
+  static const int unpool_shape[4] = {2, 3, 5, 7};
+  static const int kernels[][3] = {{2, 2}, {2, 4}, {3, 3}, {1, 2},
+                                   {2, 1, 3}};
+  int i; // Iterator
+
+  for (i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) {
+    test_pooling(cases + i, 10 + i);
+  }
+  for (i = 0; i < (int)(sizeof(kernels) / sizeof(kernels[0])); i++) {
+    char name[64];
+    int kernel_size = i == 4 ? 3 : 2;
+    sprintf(name, "Unpooling of kernel %d", i);
+    test_unpooling(name, unpool_shape, kernels[i], kernel_size, 40 + i);
+  }
+  printf("%d failures\n", test_failures());
+  return test_failures() ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+# Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Build NNB of one function at realistic shapes, and measure it with
+# `nnablart bench` in FLOAT32, FIXED16 and FIXED8. Results are written to
+# nnabla-c-runtime/bench/functions.csv in NNABLA_C_RUNTIME_TEST_DIRECTORY.
+
+import os
+import re
+import subprocess
+import sys
+
+import nnabla as nn
+import nnabla.functions as F
+import nnabla.parametric_functions as PF
+from nnabla.utils.save import save
+
+
+def conv3x3(x):
+    return PF.convolution(x[0], 64, (3, 3), pad=(1, 1))
+
+
+def conv1x1(x):
+    return PF.convolution(x[0], 256, (1, 1))
+
+
+def depthwise3x3(x):
+    return PF.depthwise_convolution(x[0], (3, 3), pad=(1, 1))
+
+
+def deconv4x4(x):
+    return PF.deconvolution(x[0], 64, (4, 4), pad=(1, 1), stride=(2, 2))
+
+
+def affine(x):
+    return PF.affine(x[0], 1024)
+
+
+def batch_normalization(x):
+    return PF.batch_normalization(x[0], batch_stat=False)
+
+
+# Name, function, shapes of inputs
+cases = [
+    ('Convolution_3x3', conv3x3, [(1, 64, 56, 56)]),
+    ('Convolution_1x1', conv1x1, [(1, 256, 14, 14)]),
+    ('DepthwiseConvolution_3x3', depthwise3x3, [(1, 128, 28, 28)]),
+    ('Deconvolution_4x4', deconv4x4, [(1, 64, 28, 28)]),
+    ('Affine', affine, [(1, 1024)]),
+    ('BatchNormalization', batch_normalization, [(1, 64, 56, 56)]),
+    ('ReLU', lambda x: F.relu(x[0]), [(1, 64, 56, 56)]),
+    ('Sigmoid', lambda x: F.sigmoid(x[0]), [(1, 64, 56, 56)]),
+    ('Tanh', lambda x: F.tanh(x[0]), [(1, 64, 56, 56)]),
+    ('Add2', lambda x: F.add2(x[0], x[1]),
+     [(1, 64, 56, 56), (1, 64, 56, 56)]),
+    ('MaxPooling_2x2', lambda x: F.max_pooling(x[0], (2, 2)),
+     [(1, 64, 56, 56)]),
+    ('AveragePooling_2x2', lambda x: F.average_pooling(x[0], (2, 2)),
+     [(1, 64, 56, 56)]),
+    ('GlobalAveragePooling', lambda x: F.global_average_pooling(x[0]),
+     [(1, 512, 7, 7)]),
+    ('Softmax', lambda x: F.softmax(x[0]), [(1, 1000)]),
+]
+
+types = ['FLOAT32', 'FIXED16', 'FIXED8']
+
+bench_directory = '{}/nnabla-c-runtime/bench'.format(
+    os.environ['NNABLA_C_RUNTIME_TEST_DIRECTORY'])
+nnablart = os.environ.get('NNABLART', './build/src/nnablart/nnablart')
+warmup = os.environ.get('CRUNTIME_BENCH_WARMUP', '10')
+iterations = os.environ.get('CRUNTIME_BENCH_ITERATIONS', '100')
+
+func_list = []
+if 'CRUNTIME_TEST_FUNCTION_LIST' in os.environ:
+    func_list = ' '.join(
+        os.environ['CRUNTIME_TEST_FUNCTION_LIST'].split(',')).split()
+func_exclude_list = []
+if 'CRUNTIME_TEST_FUNCTION_EXCLUDE_LIST' in os.environ:
+    func_exclude_list = ' '.join(
+        os.environ['CRUNTIME_TEST_FUNCTION_EXCLUDE_LIST'].split(',')).split()
+
+
+def create_nnp(name, func, shapes):
+    nn.clear_parameters()
+    with nn.parameter_scope(name):
+        inputs = [nn.Variable(shape) for shape in shapes]
+        y = func(inputs)
+    names = {'x{}'.format(i): v for i, v in enumerate(inputs)}
+    contents = {
+        'networks': [
+            {'name': 'network',
+             'batch_size': 1,
+             'outputs': {'y': y},
+             'names': names}],
+        'executors': [
+            {'name': 'runtime',
+             'network': 'network',
+             'data': sorted(names),
+             'output': ['y']}]}
+    nnp = '{}/{}.nnp'.format(bench_directory, name)
+    save(nnp, contents)
+    return nnp
+
+
+def create_nnb(name, nnp, data_type):
+    nnb = '{}/{}_{}.nnb'.format(bench_directory, name, data_type.lower())
+    command = ['nnabla_cli', 'convert', nnp, nnb]
+    if data_type != 'FLOAT32':
+        # All variables in data_type.
+        template = '{}/{}_float32.yaml'.format(bench_directory, name)
+        settings = '{}/{}_{}.yaml'.format(bench_directory, name,
+                                          data_type.lower())
+        if not os.path.exists(template):
+            subprocess.check_call(['nnabla_cli', 'nnb_template', nnp,
+                                   template])
+        with open(template, 'r') as f:
+            data = f.read().replace('FLOAT32', data_type)
+        with open(settings, 'w') as f:
+            f.write(data)
+        command += ['-s', settings]
+    subprocess.check_call(command, stdout=subprocess.DEVNULL)
+    return nnb
+
+
+def bench(nnb):
+    output = subprocess.check_output(
+        [nnablart, 'bench', nnb, '-w', warmup, '-n', iterations]).decode()
+    init = re.search(r'Init:\s+([0-9.]+)', output)
+    latency = re.search(
+        r'min ([0-9.]+) mean ([0-9.]+) p50 ([0-9.]+) p90 ([0-9.]+) '
+        r'p99 ([0-9.]+) max ([0-9.]+)', output)
+    if init is None or latency is None:
+        raise RuntimeError(output)
+    return [init.group(1)] + list(latency.groups())
+
+
+os.makedirs(bench_directory, exist_ok=True)
+results = [
+    'Function, Type, Shape, Init(us), Min(us), Mean(us), P50(us), P90(us), '
+    'P99(us), Max(us)']
+failed = 0
+for name, func, shapes in cases:
+    function = name.split('_')[0]
+    if (func_list and function not in func_list) or \
+            function in func_exclude_list:
+        continue
+    shape = ' '.join('x'.join(str(s) for s in shape) for shape in shapes)
+    nnp = create_nnp(name, func, shapes)
+    for data_type in types:
+        print('Benchmarking {} {}'.format(name, data_type))
+        try:
+            times = bench(create_nnb(name, nnp, data_type))
+        except (subprocess.CalledProcessError, RuntimeError) as e:
+            sys.stderr.write('\t{} {} failed: {}\n'.format(
+                name, data_type, e))
+            failed += 1
+            continue
+        results.append(', '.join([name, data_type, shape] + times))
+
+with open('{}/functions.csv'.format(bench_directory), 'w') as f:
+    f.write('\n'.join(results) + '\n')
+print('\n'.join(results))
+sys.exit(1 if failed else 0)
@@ -0,0 +1,182 @@
+# Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Performance regression test of sample projects.
+#
+# Sample projects which pass in doc/SAMPLE_PROJECT_SUPPORT_STATUS.md are
+# converted to NNB as create_nnabla_c_runtime_mnists_test_makefile.py does,
+# and measured with `nnablart bench` and `nnablart dump --memory`. Results are
+# written to nnabla-c-runtime/bench/samples.csv in
+# NNABLA_C_RUNTIME_TEST_DIRECTORY, and compared with baseline CSV.
+#
+# Environment variables:
+#   CRUNTIME_BENCH_BASELINE   Baseline CSV (default samples_baseline.csv in
+#                             bench directory). Written if it does not exist.
+#   CRUNTIME_BENCH_UPDATE     Write baseline from this result if not empty.
+#   CRUNTIME_BENCH_THRESHOLD  Allowed regression in percent (default 10).
+#   CRUNTIME_BENCH_REFERENCE  Another nnablart to measure speedup against,
+#                             e.g. one built with generic functions only.
+#
+# Exit status is 1 if mean latency or peak memory is worse than baseline by
+# more than the threshold, or if any sample fails.
+
+import csv
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+test_directory = os.environ['NNABLA_C_RUNTIME_TEST_DIRECTORY']
+bench_directory = '{}/nnabla-c-runtime/bench'.format(test_directory)
+nnablart = os.environ.get('NNABLART', './build/src/nnablart/nnablart')
+reference = os.environ.get('CRUNTIME_BENCH_REFERENCE', '')
+warmup = os.environ.get('CRUNTIME_BENCH_WARMUP', '10')
+iterations = os.environ.get('CRUNTIME_BENCH_ITERATIONS', '100')
+threshold = float(os.environ.get('CRUNTIME_BENCH_THRESHOLD', '10'))
+baseline_csv = os.environ.get('CRUNTIME_BENCH_BASELINE',
+                              '{}/samples_baseline.csv'.format(
+                                  bench_directory))
+update_baseline = bool(os.environ.get('CRUNTIME_BENCH_UPDATE', ''))
+
+sample_list = []
+if 'CRUNTIME_TEST_SAMPLE_LIST' in os.environ:
+    sample_list = ' '.join(
+        os.environ['CRUNTIME_TEST_SAMPLE_LIST'].split(',')).split()
+
+header = ['Sample', 'Init(us)', 'Mean(us)', 'P50(us)', 'P99(us)',
+          'Peak(bytes)', 'Reference(us)', 'Speedup']
+
+
+def supported_samples():
+    # Rows of `| name | OK | OK | True |`.
+    status = os.path.join(os.path.dirname(__file__), '..', '..', '..',
+                          'doc', 'SAMPLE_PROJECT_SUPPORT_STATUS.md')
+    samples = []
+    with open(status, 'r') as f:
+        for line in f:
+            columns = [c.strip() for c in line.split('|')[1:-1]]
+            if len(columns) == 4 and columns[2] == 'OK' and \
+                    columns[3] == 'True':
+                samples.append(columns[0])
+    return samples
+
+
+def create_nnb(name, nnp):
+    nnb = '{}/{}.nnb'.format(bench_directory, name)
+    subprocess.check_call(['nnabla_cli', 'convert', '--nnp-expand-network',
+                           '-b', '1', nnp, nnb], stdout=subprocess.DEVNULL)
+    return nnb
+
+
+def bench(runtime, nnb):
+    output = subprocess.check_output(
+        [runtime, 'bench', nnb, '-w', warmup, '-n', iterations]).decode()
+    init = re.search(r'Init:\s+([0-9.]+)', output)
+    latency = re.search(
+        r'mean ([0-9.]+) p50 ([0-9.]+) p90 [0-9.]+ p99 ([0-9.]+)', output)
+    if init is None or latency is None:
+        raise RuntimeError(output)
+    return [float(init.group(1))] + [float(t) for t in latency.groups()]
+
+
+def peak_memory(nnb):
+    output = subprocess.check_output(
+        [nnablart, 'dump', nnb, '--memory']).decode()
+    peak = re.search(r'NNB: Memory peak\s+([0-9]+)', output)
+    if peak is None:
+        raise RuntimeError(output)
+    return int(peak.group(1))
+
+
+def read_baseline():
+    baseline = {}
+    if not os.path.exists(baseline_csv):
+        return baseline
+    with open(baseline_csv, 'r') as f:
+        for row in csv.DictReader(f, skipinitialspace=True):
+            baseline[row['Sample']] = row
+    return baseline
+
+
+def regression(name, row, base, key):
+    previous = float(base[key])
+    current = float(row[key])
+    if previous <= 0 or current <= previous * (1 + threshold / 100):
+        return False
+    sys.stderr.write('\t{} {} regressed: {} -> {} ({:+.1f}%)\n'.format(
+        name, key, base[key], row[key], (current / previous - 1) * 100))
+    return True
+
+
+nnps = {}
+for f in glob.glob('{}/reference/nnp/*.nnp'.format(
+        os.environ['NNABLA_SAMPLE_DATA_DIRECTORY'])):
+    nnps[os.path.splitext(os.path.basename(f))[0]] = f
+
+os.makedirs(bench_directory, exist_ok=True)
+baseline = read_baseline()
+results = []
+failed = 0
+regressed = 0
+for name in supported_samples():
+    if (sample_list and name not in sample_list) or name not in nnps:
+        continue
+    print('Benchmarking {}'.format(name))
+    try:
+        nnb = create_nnb(name, nnps[name])
+        init, mean, p50, p99 = bench(nnablart, nnb)
+        row = {'Sample': name,
+               'Init(us)': '{:.1f}'.format(init),
+               'Mean(us)': '{:.1f}'.format(mean),
+               'P50(us)': '{:.1f}'.format(p50),
+               'P99(us)': '{:.1f}'.format(p99),
+               'Peak(bytes)': str(peak_memory(nnb)),
+               'Reference(us)': '',
+               'Speedup': ''}
+        if reference:
+            reference_mean = bench(reference, nnb)[1]
+            row['Reference(us)'] = '{:.1f}'.format(reference_mean)
+            if mean > 0:
+                row['Speedup'] = '{:.2f}'.format(reference_mean / mean)
+    except (subprocess.CalledProcessError, RuntimeError) as e:
+        sys.stderr.write('\t{} failed: {}\n'.format(name, e))
+        failed += 1
+        continue
+    results.append(row)
+    if name in baseline:
+        for key in ['Mean(us)', 'Peak(bytes)']:
+            if regression(name, row, baseline[name], key):
+                regressed += 1
+
+
+def write_csv(filename, rows):
+    with open(filename, 'w') as f:
+        f.write(', '.join(header) + '\n')
+        for row in rows:
+            f.write(', '.join(row[key] for key in header) + '\n')
+
+
+write_csv('{}/samples.csv'.format(bench_directory), results)
+if update_baseline or not baseline:
+    write_csv(baseline_csv, results)
+    print('Baseline written to {}'.format(baseline_csv))
+
+with open('{}/samples.csv'.format(bench_directory), 'r') as f:
+    print(f.read(), end='')
+if regressed:
+    print('{} regression(s) over {:.0f}% from {}'.format(
+        regressed, threshold, baseline_csv))
+sys.exit(1 if failed or regressed else 0)
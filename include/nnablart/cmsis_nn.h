@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_CMSIS_NN_H_
+#define H_CMSIS_NN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <nnablart/runtime.h>
+
+/// @defgroup CmsisNn CMSIS-NN Backend
+/// @brief Backend running fixed point functions by q7 kernels of CMSIS-NN
+/// on Cortex-M, built as library nnablart_cmsis_nn.
+///
+/// It takes functions whose inputs, parameters and outputs are INT8 without
+/// per channel quantization, and whose fixed point positions shift products
+/// to output:
+/// - 2D Convolution without group and dilation
+/// - 2D DepthwiseConvolution with multiplier 1 and even channels
+/// - Affine
+/// - 2D MaxPooling and AveragePooling of square input, kernel, stride and
+///   pad, where AveragePooling does not count pad
+/// - ReLU
+///
+/// Other functions run by runtime. Activations of channel first layout are
+/// transposed to channel last around each kernel in buffers of local
+/// context, and weights are reordered when context is initialized.
+/// Results may differ from runtime by 1 in last bit, since CMSIS-NN rounds
+/// output to nearest while runtime truncates toward 0. MaxPooling gives
+/// maximum of each window, while that of runtime starts from 0, so they
+/// differ for windows of only negative values.
+/// @{
+
+/// @brief Backend to give to @ref rt_add_backend().
+/// @return Backend named "cmsis_nn", of priority 10.
+const rt_backend_t *rt_cmsis_nn_backend(void);
+
+/// @}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif // H_CMSIS_NN_H_
@@ -53,16 +53,32 @@ typedef enum {
   RT_BUFFER_ALLOCATE_TYPE_MALLOC = 0, ///< Allocated by runtime
   RT_BUFFER_ALLOCATE_TYPE_ALLOCATED,  ///< User allocated
   RT_BUFFER_ALLOCATE_TYPE_INITIAL,    ///< Shared buffers
+  RT_BUFFER_ALLOCATE_TYPE_PLANNED,    ///< Placed in planned variable arena
   END_OF_RT_BUFFER_ALLOCATE_TYPE      ///< Max num of rt_buffer_allocate_type_t
 } rt_buffer_allocate_type_t;
 
+/// @brief Per channel quantization of fixed point variable
+/// Value of element whose index on axis is c is
+/// scales[c] * (integer - zero_points[c]).
+typedef struct {
+  int axis;                   ///< Axis of channels
+  int channels;               ///< Size of axis
+  int inner;                  ///< Elements after axis, which share a channel
+  const float *scales;        ///< Scale of each channel
+  const int32_t *zero_points; ///< Zero point of each channel, or NULL if all
+                              ///< of them are 0
+} rt_quantization_t;
+
 /// @brief Variable
 typedef struct {
-  rt_list_t shape;         ///< Shape of variable
-  nn_data_type_t type : 4; ///< Type of param values
-  unsigned int fp_pos : 4; ///< Fixed point position
-  float coefficient;       ///< Coefficient value for convert int to float.
-  void *data;              ///< Pointer to real data of variable
+  rt_list_t shape;             ///< Shape of variable
+  nn_data_type_t type : 4;     ///< Type of param values
+  unsigned int fp_pos : 4;     ///< Fixed point position
+  nn_data_layout_t layout : 4; ///< Layout of data
+  float coefficient;           ///< Coefficient value for convert int to float.
+  void *data;                  ///< Pointer to real data of variable
+  const rt_quantization_t *quantization; ///< Used instead of coefficient for
+                                         ///< INT8 and INT16, or NULL.
 } rt_variable_t;
 
 /// @brief Function
@@ -89,6 +105,254 @@ extern void (*rt_variable_free_func)(
 extern void *(*rt_malloc_func)(size_t size); ///< malloc function pointer
 extern void (*rt_free_func)(void *ptr);      ///< free function pointer
 
+/// @brief Body of parallel loop. It processes iterations in [begin, end).
+typedef void (*rt_parallel_body_t)(void *arg, int begin, int end);
+
+/// @brief Executor of parallel loops used by functions.
+typedef struct {
+  /// Run body over [0, size) split into at most num_of_threads ranges, and
+  /// wait for completion.
+  void (*parallel_for)(void *pool, int size, rt_parallel_body_t body,
+                       void *arg);
+  void *pool;         ///< Executor specific data
+  int num_of_threads; ///< Number of threads
+} rt_parallel_executor_t;
+
+/// @brief Set executor of parallel loops used in calling thread.
+/// @param[in] executor Executor, NULL means that loops run serially.
+/// @return Previous executor.
+const rt_parallel_executor_t *
+rt_set_parallel_executor(const rt_parallel_executor_t *executor);
+
+/// @brief Run body over [0, size) with executor of calling thread.
+/// It runs serially if no executor is set, or if amount of work (size * cost)
+/// is too small to split.
+/// @param[in] size Number of iterations
+/// @param[in] cost Rough number of operations in one iteration
+/// @param[in] body Loop body
+/// @param[in] arg Argument passed to body
+void rt_parallel_for(int size, int cost, rt_parallel_body_t body, void *arg);
+
+/// @brief Check whether remaining work of functions is still needed.
+typedef struct {
+  /// Returns nonzero if work should stop. It can be called from any thread.
+  int (*is_canceled)(void *arg);
+  void *arg; ///< Passed to is_canceled.
+} rt_cancellation_t;
+
+/// @brief Set cancellation checked by loops of functions in calling thread.
+/// @ref rt_parallel_for() checks it between blocks of iterations and skips
+/// the rest when canceled, so outputs of the function are undefined then.
+/// @param[in] cancellation Check, NULL means that loops always finish.
+/// @return Previous cancellation.
+const rt_cancellation_t *
+rt_set_cancellation(const rt_cancellation_t *cancellation);
+
+/// @brief Set budget of packed weights for functions allocated in calling
+/// thread.
+/// Functions which reorder weights into layout of their kernels at allocation
+/// take size of the packed copy from budget, and use original weights if it
+/// does not fit.
+/// @param[in] budget Remaining bytes, NULL means no limit.
+/// @return Previous budget.
+size_t *rt_set_prepack_budget(size_t *budget);
+
+/// @brief Store of weights reordered into layouts of kernels, so that
+/// functions of another context running same network use them instead of
+/// making their own.
+typedef struct {
+  /// Returns copy of weight in layout, with size bytes, kept by another
+  /// context, or NULL.
+  void *(*find)(void *arg, const void *weight, int layout, size_t size);
+  /// Keep copy made by a function, which stays its owner.
+  void (*add)(void *arg, const void *weight, int layout, size_t size,
+              void *copy);
+  /// Forget copy which is not used by a function any more. Returns non zero
+  /// if copy is owned by another context, and must not be freed.
+  int (*release)(void *arg, void *copy);
+  void *arg; ///< Passed to callbacks.
+} rt_weight_copies_t;
+
+/// @brief Set store of weight copies for functions allocated and freed in
+/// calling thread.
+/// @param[in] copies Store, NULL means that each function makes its own.
+/// @return Previous store.
+const rt_weight_copies_t *
+rt_set_weight_copies(const rt_weight_copies_t *copies);
+
+/// @brief Accuracy of float math in functions.
+typedef enum {
+  RT_MATH_MODE_EXACT = 0, ///< Results do not depend on mode.
+  RT_MATH_MODE_FAST,      ///< Approximations within 1e-3 relative error.
+} rt_math_mode_t;
+
+/// @brief Set math mode of functions allocated in calling thread.
+/// In RT_MATH_MODE_FAST, float Sigmoid, Tanh, Softmax and LogSoftmax use
+/// approximate exp, and Softmax and BatchNormalization multiply by reciprocal
+/// instead of dividing.
+/// @param[in] mode Mode
+/// @return Previous mode.
+rt_math_mode_t rt_set_math_mode(rt_math_mode_t mode);
+
+/// @brief Expand NN_DATA_LAYOUT_BLOCK_SPARSE variable.
+/// @param[in] variable Variable whose data is block sparse.
+/// @param[out] dense Values of all elements in order of shape.
+void rt_expand_block_sparse(const rt_variable_t *variable, float *dense);
+
+/// @brief Element wise activation which a function applies to its outputs.
+typedef enum {
+  RT_EPILOGUE_NONE = 0,   ///< Outputs are not changed.
+  RT_EPILOGUE_RELU,       ///< max(x, 0)
+  RT_EPILOGUE_LEAKY_RELU, ///< x if x > 0, otherwise alpha * x
+  RT_EPILOGUE_RELU6,      ///< min(max(x, 0), 6)
+  RT_EPILOGUE_SWISH,      ///< x * sigmoid(x)
+  RT_EPILOGUE_SIGMOID,    ///< 1 / (1 + exp(-x))
+  RT_EPILOGUE_TANH,       ///< tanh(x)
+} rt_epilogue_type_t;
+
+/// @brief Epilogue of Convolution and Affine.
+typedef struct {
+  rt_epilogue_type_t type;
+  float alpha; ///< Slope of negative part for RT_EPILOGUE_LEAKY_RELU.
+} rt_epilogue_t;
+
+/// @brief Apply epilogue to outputs of allocated Convolution.
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if outputs are not calculated in
+/// float.
+rt_function_error_t set_convolution_epilogue(rt_function_t *f,
+                                             const rt_epilogue_t *epilogue);
+
+/// @brief Apply epilogue to outputs of allocated Affine.
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if outputs are not calculated in
+/// float.
+rt_function_error_t set_affine_epilogue(rt_function_t *f,
+                                        const rt_epilogue_t *epilogue);
+
+/// @brief Keep hidden state, and cell state of LSTM, of allocated RNN, LSTM or
+/// GRU between executions, so that a sequence can be given in parts, e.g. one
+/// frame at a time. Initial state inputs are read by first execution only,
+/// and again after reset_recurrent_state().
+/// @param[in] enable Non zero to keep state, 0 to start from initial state
+/// inputs in every execution (default).
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if function is not calculated in
+/// float, or it is bidirectional.
+rt_function_error_t set_recurrent_streaming(rt_function_t *f, int enable);
+
+/// @brief Start next execution of allocated RNN, LSTM or GRU from initial
+/// state inputs.
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if function is not calculated in
+/// float.
+rt_function_error_t reset_recurrent_state(rt_function_t *f);
+
+/// @brief Let allocated TopKData read logits of a Softmax over each of its
+/// samples, and output probabilities of the k largest logits. Softmax of
+/// other values is not calculated.
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if outputs are not calculated in
+/// float.
+rt_function_error_t set_top_k_data_softmax(rt_function_t *f);
+
+/// @brief Kernel which executes a function that has several kernels for same
+/// types and shapes.
+typedef enum {
+  RT_KERNEL_DEFAULT = 0, ///< Chosen by rule of function at allocation.
+  RT_KERNEL_DIRECT,      ///< Loops over outputs without work area.
+  RT_KERNEL_GEMM,        ///< im2col and GEMM, or GEMM on input of 1x1.
+  RT_KERNEL_WINOGRAD,    ///< Winograd F(2x2, 3x3).
+  RT_KERNEL_END,
+} rt_kernel_t;
+
+/// @brief Let functions allocated in calling thread keep work areas and
+/// packed weights of all kernels they can run, so that a kernel can be
+/// selected after allocation. Default is disabled.
+/// @param[in] enable Non zero to enable.
+/// @return Previous setting.
+int rt_set_kernel_candidates(int enable);
+
+/// @brief Kernels which can execute allocated float Convolution.
+/// Only the kernel chosen by rule is available unless Convolution was
+/// allocated after rt_set_kernel_candidates().
+/// @param[out] kernels RT_KERNEL_END kernels at most, current one first.
+/// @return Number of kernels, 0 if outputs are not calculated in float.
+int convolution_kernels(rt_function_t *f, rt_kernel_t *kernels);
+
+/// @brief Execute allocated Convolution by kernel.
+/// @param[in] kernel One of convolution_kernels().
+/// @param[in] keep Non zero to keep areas of other kernels to select again,
+/// otherwise they are freed.
+/// @return RT_FUNCTION_ERROR_UNIMPLEMENTED if kernel is not available.
+rt_function_error_t select_convolution_kernel(rt_function_t *f,
+                                              rt_kernel_t kernel, int keep);
+
+/// @brief Element wise operation of chain. x is value from former operation
+/// and a is alpha or element of operand.
+typedef enum {
+  RT_ELEMENTWISE_ADD = 0,    ///< x + a
+  RT_ELEMENTWISE_SUB,        ///< x - a
+  RT_ELEMENTWISE_RSUB,       ///< a - x
+  RT_ELEMENTWISE_MUL,        ///< x * a
+  RT_ELEMENTWISE_DIV,        ///< x / a
+  RT_ELEMENTWISE_RDIV,       ///< a / x
+  RT_ELEMENTWISE_POW,        ///< pow(x, a)
+  RT_ELEMENTWISE_RPOW,       ///< pow(a, x)
+  RT_ELEMENTWISE_MAXIMUM,    ///< max(x, a)
+  RT_ELEMENTWISE_MINIMUM,    ///< min(x, a)
+  RT_ELEMENTWISE_IDENTITY,   ///< x
+  RT_ELEMENTWISE_ABS,        ///< |x|
+  RT_ELEMENTWISE_EXP,        ///< exp(x)
+  RT_ELEMENTWISE_LOG,        ///< log(x)
+  RT_ELEMENTWISE_RELU,       ///< max(x, 0)
+  RT_ELEMENTWISE_LEAKY_RELU, ///< x if x > 0, otherwise alpha * x
+  RT_ELEMENTWISE_RELU6,      ///< min(max(x, 0), 6)
+  RT_ELEMENTWISE_SIGMOID,    ///< 1 / (1 + exp(-x))
+  RT_ELEMENTWISE_TANH,       ///< tanh(x)
+  RT_ELEMENTWISE_SWISH,      ///< x * sigmoid(x)
+  RT_ELEMENTWISE_ELU,        ///< scale * (x if x > 0, otherwise alpha *
+                             ///< (exp(x) - 1))
+} rt_elementwise_type_t;
+
+/// @brief One operation of element wise chain.
+typedef struct {
+  rt_elementwise_type_t type;
+  float alpha;                  ///< Scalar a, or alpha of activation.
+  float scale;                  ///< Scale of RT_ELEMENTWISE_ELU.
+  const rt_variable_t *operand; ///< Float variable of a, or NULL for alpha.
+} rt_elementwise_op_t;
+
+/// @brief Calculate element wise operations in order as one pass.
+/// Values are kept in cache between operations, and only y is written.
+/// @param[in] x Input of first operation.
+/// @param[out] y Output of last operation. It must not overlap operands.
+/// @param[in] size Number of elements of x, y and each operand.
+/// @param[in] ops Operations.
+/// @param[in] num_of_ops Number of operations.
+void calc_elementwise_chain(const float *x, float *y, int size,
+                            const rt_elementwise_op_t *ops, int num_of_ops);
+
+/// @brief Check if function can write its output over input 0.
+/// Kernel of such function reads each element of input 0 only before writing
+/// output element at the same position. Output must have same type and
+/// number of elements as input 0.
+/// @return Non zero if function is in place safe.
+int is_inplace_function(const nn_function_t *func);
+
+/// @brief Check if output of function is an exact copy of input 0.
+/// Such function is in place safe, and nothing is left to calculate when
+/// output shares memory with input 0.
+/// @return Non zero if output is same data as input 0.
+int is_alias_function(const nn_function_t *func);
+
+/// @brief Offset of output of Slice in its input, if the output is one
+/// contiguous part of input. It is when only one axis is partially taken
+/// with step 1, axes before it have size 1 in output, and axes after it are
+/// taken whole.
+/// @param[in] input_shape Shape of input
+/// @param[in] output_shape Shape of output
+/// @param[in] start Start of Slice, aligned to the last axes
+/// @param[in] step Step of Slice, aligned to the last axes
+/// @return Offset in number of elements, or -1 if output is not contiguous.
+int calc_slice_view_offset(rt_list_t input_shape, rt_list_t output_shape,
+                           rt_list_t start, rt_list_t step);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @defgroup NeuralNetworkLayer Neural Network Layer
 /// @{
@@ -341,6 +605,16 @@ rt_function_error_t free_global_average_pooling_local_context(rt_function_t *f);
 
 /// Exec GlobalAveragePooling
 rt_function_error_t exec_global_average_pooling(rt_function_t *f);
+
+/// @brief Average each of maps contiguous maps of x into y.
+/// Maps are split over threads, and each is summed by SIMD lanes then
+/// multiplied by 1 / map_size.
+/// @param[in] x maps * map_size values.
+/// @param[out] y maps values.
+/// @param[in] maps Number of maps, batch size * channels.
+/// @param[in] map_size Values of each map.
+void calc_global_average_pooling(const float *x, float *y, int maps,
+                                 int map_size);
 /// @}
 
 /// @defgroup SumPooling SumPooling
@@ -26,7 +26,7 @@ extern "C" {
 
 #define NN_C_RUNTIME_VERSION ("1.2.0.dev1_c1")
 #define NN_BINARY_FORMAT_MINIMUM_VERSION (2)
-#define NN_BINARY_FORMAT_VERSION (3)
+#define NN_BINARY_FORMAT_VERSION (4)
 #define NN_API_LEVEL (6)
 #define NN_API_LEVEL_MAX (5000)
 
@@ -45,22 +45,85 @@ typedef struct {
 
 /// @brief Data types.
 typedef enum {
-  NN_DATA_TYPE_FLOAT, ///< 32bit float.
-  NN_DATA_TYPE_INT16, ///< 16bit integer.
-  NN_DATA_TYPE_INT8,  ///<  8bit integer.
-  NN_DATA_TYPE_SIGN,  ///< Binary.
+  NN_DATA_TYPE_FLOAT,    ///< 32bit float.
+  NN_DATA_TYPE_INT16,    ///< 16bit integer.
+  NN_DATA_TYPE_INT8,     ///<  8bit integer.
+  NN_DATA_TYPE_SIGN,     ///< Binary.
+  NN_DATA_TYPE_FLOAT16,  ///< 16bit IEEE 754 half precision float.
+  NN_DATA_TYPE_BFLOAT16, ///< 16bit brain float, upper half of 32bit float.
   END_OF_NN_DATA_TYPE
 } nn_data_type_t;
 
+/// @brief Data layouts.
+typedef enum {
+  NN_DATA_LAYOUT_DENSE,        ///< All values in order of shape.
+  NN_DATA_LAYOUT_BLOCK_SPARSE, ///< Non zero blocks, see nn_block_sparse_t.
+  NN_DATA_LAYOUT_COMPRESSED,   ///< Compressed values, see nn_compressed_t.
+  END_OF_NN_DATA_LAYOUT
+} nn_data_layout_t;
+
+/// @brief Header of NN_DATA_LAYOUT_BLOCK_SPARSE data.
+/// Variable is seen as matrix of rows x columns, row is first axis of shape
+/// and column is all other axes. Each row keeps blocks of block_size
+/// consecutive columns which are not all zero. Header is followed by
+///   int32_t row_offsets[rows + 1];     // Blocks of row r are
+///                                      // [row_offsets[r], row_offsets[r+1])
+///   int32_t block_columns[num_of_blocks]; // First column of block
+///   float values[num_of_blocks * block_size];
+/// Only NN_DATA_TYPE_FLOAT parameters can be block sparse.
+typedef struct {
+  int32_t rows;          ///< Size of first axis.
+  int32_t columns;       ///< Size of other axes.
+  int32_t block_size;    ///< Columns in one block.
+  int32_t num_of_blocks; ///< Blocks in all rows.
+} nn_block_sparse_t;
+
+/// @brief Compression methods of NN_DATA_LAYOUT_COMPRESSED data.
+typedef enum {
+  NN_COMPRESSION_LZ4,     ///< LZ4 block format.
+  NN_COMPRESSION_PALETTE, ///< Indices into palette of values.
+  END_OF_NN_COMPRESSION
+} nn_compression_t;
+
+/// @brief Header of NN_DATA_LAYOUT_COMPRESSED data.
+/// Parameter is decompressed into dense values of its type at
+/// initialization. Header is followed by size bytes of
+///   uint8_t lz4_block[size];          // NN_COMPRESSION_LZ4
+/// or
+///   <type> palette[palette_size];     // NN_COMPRESSION_PALETTE
+///   uint8_t indices[];                // index_bits each, from LSB
+/// SIGN parameters can not be palettized.
+typedef struct {
+  int32_t method;       ///< nn_compression_t
+  int32_t size;         ///< Bytes following header.
+  int32_t palette_size; ///< Values in palette, up to 2^index_bits.
+  int32_t index_bits;   ///< 1, 2, 4 or 8.
+} nn_compressed_t;
+
+/// @brief Header of per channel quantization of NN_DATA_TYPE_INT8 or
+/// NN_DATA_TYPE_INT16 variable, which is used instead of fp_pos. Value of
+/// element whose index on axis is c is scale[c] * (integer - zero_point[c]).
+/// Header is followed by
+///   float scale[channels];
+///   int32_t zero_point[channels]; // Only if has_zero_point is not 0
+typedef struct {
+  int32_t axis;           ///< Axis of channels in shape.
+  int32_t channels;       ///< Size of axis.
+  int32_t has_zero_point; ///< Zero points follow scales, otherwise all 0.
+} nn_quantization_t;
+
 /// @brief Definition of Variable.
 typedef struct {
-  uint32_t id;             ///< Identifier
-  nn_list_t shape;         ///< Shape
-  nn_data_type_t type : 4; ///< Type of param values
-  unsigned int fp_pos : 4; ///< floating point position.
-  int32_t data_index;      ///< Location of data. If negative, it means data
-                           /// buffer index. Otherwise it means location of data
-  /// in memory.
+  uint32_t id;                 ///< Identifier
+  nn_list_t shape;             ///< Shape
+  nn_data_type_t type : 4;     ///< Type of param values
+  unsigned int fp_pos : 4;     ///< floating point position.
+  nn_data_layout_t layout : 4; ///< Layout of param values
+  int32_t data_index;          ///< Location of data. If negative, it means
+                               /// data buffer index. Otherwise it means
+                               /// location of data in memory.
+  int32_t quantization;        ///< Location of nn_quantization_t, or
+                               /// negative if there is none. Since version 4.
 } nn_variable_t;
 
 /// @brief Function types.
@@ -110,17 +110,89 @@ extern "C" {
 ///
 /// @ref Runtime provides following functions.
 /// - @ref rt_allocate_context()
+/// - @ref rt_allocate_static_context()
+/// - @ref rt_static_context_size()
+/// - @ref rt_context_required_size()
+/// - @ref rt_set_buffer_planning()
+/// - @ref rt_set_context_arena()
+/// - @ref rt_context_arena_size()
+/// - @ref rt_set_activation_arena()
+/// - @ref rt_activation_arena_size()
+/// - @ref rt_set_huge_pages()
+/// - @ref rt_set_context_allocator()
+/// - @ref rt_set_variable_allocator()
+/// - @ref rt_set_placement()
+/// - @ref rt_set_num_threads()
+/// - @ref rt_num_of_threads()
+/// - @ref rt_set_graph_execution()
+/// - @ref rt_set_function_fusion()
+/// - @ref rt_set_tiled_execution()
+/// - @ref rt_set_graph_simplification()
+/// - @ref rt_set_weight_prepack_limit()
+/// - @ref rt_set_fast_math()
+/// - @ref rt_set_recurrent_streaming()
+/// - @ref rt_reset_recurrent_state()
+/// - @ref rt_set_streaming_window()
+/// - @ref rt_reset_streaming_window()
+/// - @ref rt_set_result_caching()
+/// - @ref rt_mark_input_changed()
+/// - @ref rt_set_parameter_loader()
+/// - @ref rt_set_plan_cache()
+/// - @ref rt_set_kernel_tuning()
+/// - @ref rt_set_kernel_choices()
+/// - @ref rt_add_backend()
 /// - @ref rt_initialize_context()
+/// - @ref rt_get_plan_cache()
+/// - @ref rt_get_kernel_choices()
+/// - @ref rt_clone_context()
 /// - @ref rt_free_context()
 /// - @ref rt_num_of_input()
 /// - @ref rt_input_size()
 /// - @ref rt_input_dimension()
 /// - @ref rt_input_shape()
+/// - @ref rt_reshape_input()
 /// - @ref rt_num_of_output()
 /// - @ref rt_output_size()
 /// - @ref rt_output_dimension()
 /// - @ref rt_output_shape()
+/// - @ref rt_bind_input_buffer()
+/// - @ref rt_bind_output_buffer()
+/// - @ref rt_write_input_image()
+/// - @ref rt_variable_buffer()
+/// - @ref rt_parameter_alignment()
+/// - @ref rt_get_memory_stats()
+/// - @ref rt_function_private_size()
+/// - @ref rt_function_backend()
+/// - @ref rt_get_init_profile()
+/// - @ref rt_function_init_nsec()
 /// - @ref rt_forward()
+/// - @ref rt_set_forward_deadline()
+/// - @ref rt_cancel_forward()
+/// - @ref rt_forward_async()
+/// - @ref rt_wait_forward()
+/// - @ref rt_create_request_queue()
+/// - @ref rt_submit_request()
+/// - @ref rt_wait_requests()
+/// - @ref rt_destroy_request_queue()
+/// - @ref rt_create_batcher()
+/// - @ref rt_submit_batch_request()
+/// - @ref rt_destroy_batcher()
+/// - @ref rt_create_pipeline()
+/// - @ref rt_submit_frame()
+/// - @ref rt_wait_pipeline()
+/// - @ref rt_pipeline_stage()
+/// - @ref rt_destroy_pipeline()
+/// - @ref rt_num_of_functions()
+/// - @ref rt_forward_range()
+/// - @ref rt_forward_until()
+/// - @ref rt_set_profiling()
+/// - @ref rt_get_profile()
+/// - @ref rt_reset_profile()
+/// - @ref rt_set_profile_clock()
+/// - @ref rt_set_profile_counters()
+/// - @ref rt_set_trace()
+/// - @ref rt_num_of_trace_events()
+/// - @ref rt_set_function_hook()
 ///
 /// @{
 
@@ -129,6 +201,15 @@ extern "C" {
 
 #include <nnablart/functions.h>
 
+/// @brief Alignment in byte of variable data allocated by runtime.
+/// Buffers of variables, including those from the allocator set by @ref
+/// rt_set_variable_malloc(), are aligned to it by runtime whatever alignment
+/// the allocator gives. Build runtime with NNABLART_VARIABLE_ALIGNMENT of
+/// CMake to change it, to a power of two.
+#ifndef RT_VARIABLE_ALIGNMENT
+#define RT_VARIABLE_ALIGNMENT (16)
+#endif
+
 /// @brief Return values in @ref Runtime.
 typedef enum {
   RT_RET_ERROR_VERSION_UNMATCH = -899,   ///< 899
@@ -139,6 +220,18 @@ typedef enum {
   RT_RET_ERROR_INIT_VARIABLE,            ///< 894
   RT_RET_ERROR_UNKNOWN_FUNCTION,         ///< 893
   RT_RET_ERROR_NO_MATCHING_FUNCTION,     ///< 892
+  RT_RET_ERROR_NOT_INITIALIZED,          ///< 891
+  RT_RET_ERROR_CREATE_THREAD_POOL,       ///< 890
+  RT_RET_ERROR_INVALID_INDEX,            ///< 889
+  RT_RET_ERROR_INVALID_SHAPE,            ///< 888
+  RT_RET_ERROR_LOAD_PARAMETER,           ///< 887
+  RT_RET_ERROR_NO_PLAN_CACHE,            ///< 886
+  RT_RET_ERROR_NO_PROFILE_COUNTER,       ///< 885
+  RT_RET_ERROR_NO_KERNEL_CHOICES,        ///< 884
+  RT_RET_ERROR_QUEUE_FULL,               ///< 883
+  RT_RET_ERROR_FORWARD_ABORTED,          ///< 882
+  RT_RET_ERROR_CONTEXT_HAS_CLONES,       ///< 881
+  RT_RET_ERROR_INVALID_ARGUMENT,         ///< 880
   RT_RET_NOERROR = 0,                    ///< 0
   RT_RET_FUNCTION_MATCH,                 ///< 1
   RT_RET_FUNCTION_DONT_MATCH,            ///< 2
@@ -155,6 +248,45 @@ typedef void *rt_context_pointer;
 /// @return @ref rt_return_value_t
 rt_return_value_t rt_allocate_context(rt_context_pointer *context);
 
+/// @brief Create runtime context inside user allocated block.
+/// Context itself and all memory allocated for it later, i.e. lists,
+/// function I/O, local contexts, private data of functions, variable buffers,
+/// callbacks and backends, are taken from block, and heap is never used.
+/// @ref rt_initialize_context() returns RT_RET_ERROR_ALLOCATE_CONTEXT if block
+/// is exhausted, and @ref rt_free_context() releases nothing of block.
+/// Context and variable allocators cannot be set, and clones are allocated
+/// in normal way. Thread pool of @ref rt_set_num_threads(), profile counters,
+/// placement and queue of @ref rt_forward_async() are not included.
+/// If block is NULL, context is allocated in normal way and only measures
+/// required size, which is obtained by @ref rt_static_context_size() after
+/// it is initialized with same settings and network as static one.
+/// @param[out] context Pointer to created context. It must be freed by @ref
+/// rt_free_context()
+/// @param[in] block Memory of context, or NULL to measure its size.
+/// @param[in] size Size of block in byte.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_ALLOCATE_CONTEXT if block
+/// cannot hold context itself.
+rt_return_value_t rt_allocate_static_context(rt_context_pointer *context,
+                                             void *block, size_t size);
+
+/// @brief Size of block required by context created by @ref
+/// rt_allocate_static_context().
+/// It is the largest memory used so far including margin to align block,
+/// and it is same for every run of same build, unless kernels are timed by
+/// @ref rt_set_kernel_tuning(). Give fixed kernels by
+/// @ref rt_set_kernel_choices() to get same size.
+/// @param[in] context
+/// @return Size in byte, or 0 if context is not static.
+size_t rt_static_context_size(rt_context_pointer context);
+
+/// @brief Size of block for static context of network with default settings.
+/// It initializes a measuring context once, so call it where heap can still
+/// be used, e.g. in boot or in a build of same target on host, and give
+/// the size to @ref rt_allocate_static_context().
+/// @param[in] net
+/// @return Size in byte, or 0 if network cannot be initialized.
+size_t rt_context_required_size(nn_network_t *net);
+
 /// @brief Add callback function to runtime context.
 /// @param[in] context
 /// @param[in] type
@@ -165,6 +297,510 @@ rt_return_value_t rt_add_callback(
     rt_return_value_t (*allocate_local_context)(nn_network_t *net,
                                                 void *function_context));
 
+/// @brief Kernel of a backend for one function type, see @ref
+/// rt_add_backend().
+typedef struct {
+  nn_function_type_t type; ///< Function type executed by kernel.
+
+  /// Return non zero if kernel executes function, judged from info and from
+  /// types and shapes of inputs and outputs of f. NULL accepts all functions
+  /// of type.
+  int (*accept)(nn_network_t *net, const nn_function_t *info,
+                const rt_function_t *f, void *user_data);
+
+  /// Set local_context of f, which is NULL before. Arguments of function are
+  /// read from info, e.g. as nn_function_convolution_t, and its lists by
+  /// @ref rt_network_list(). Next kernel is tried if it fails. NULL if kernel
+  /// needs no local context.
+  rt_function_error_t (*allocate_local_context)(nn_network_t *net,
+                                                const nn_function_t *info,
+                                                rt_function_t *f,
+                                                void *user_data);
+
+  rt_function_error_t (*exec_func)(rt_function_t *f); ///< Execute function.
+
+  /// Release what allocate_local_context made, or NULL. local_context left
+  /// non NULL is freed by rt_free_func.
+  rt_function_error_t (*free_local_context_func)(rt_function_t *f);
+} rt_backend_kernel_t;
+
+/// @brief Kernels for many function types added by @ref rt_add_backend().
+typedef struct {
+  const char *name; ///< Name reported by @ref rt_function_backend().
+  int priority;     ///< Backends of higher priority are tried first.
+  const rt_backend_kernel_t *kernels; ///< Kernels alive while context is.
+  int num_of_kernels;                 ///< Number of kernels.
+  void *user_data;                    ///< Passed to accept and allocate.
+} rt_backend_t;
+
+/// @brief Add backend which executes functions instead of runtime.
+/// @ref rt_initialize_context() gives each function to the first kernel of
+/// its type which accepts it, in backends of higher priority first and in
+/// order of addition among same priority. Functions no backend accepts use
+/// callbacks by @ref rt_add_callback() marked in NNB, which are tried before
+/// backends, or runtime. Unlike callbacks, backends need no change of NNB.
+/// Functions of types which a backend has are not merged by
+/// @ref rt_set_function_fusion() and read dense parameters even if they are
+/// block sparse in NNB.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] backend Backend copied into context, its name and kernels must
+/// be alive until context is freed.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_add_backend(rt_context_pointer context,
+                                 const rt_backend_t *backend);
+
+/// @brief Integers of list in network, e.g. pad of nn_function_convolution_t,
+/// for backends to read arguments of functions.
+/// @param[in] net
+/// @param[in] list
+/// @return list.size integers.
+const int *rt_network_list(nn_network_t *net, nn_list_t list);
+
+/// @brief Enable liveness based planning of variable buffers.
+/// When enabled, @ref rt_initialize_context() analyzes the first and the last
+/// function which uses each variable, and packs all buffer backed variables
+/// into one arena. Variables which are never alive at the same time share
+/// same area. Output of element wise function takes area of its input when
+/// the input is not read after it. Output of Reshape, Identity, Dropout
+/// with p of 0, MulScalar by 1 and AddScalar of 0 shares area of its input
+/// even if the input is read later, and then the function is skipped in
+/// @ref rt_forward(). Inputs of Concatenate
+/// whose output has only size 1 axes before axis are placed at their
+/// position inside the output, so that it copies nothing. Likewise outputs
+/// of Split along such axis and Slice outputs that are contiguous in their
+/// input are placed inside the input. Network inputs and outputs are kept
+/// alive during whole @ref rt_forward(). It must be called
+/// before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable planning.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_buffer_planning(rt_context_pointer context,
+                                         int enable);
+
+/// @brief Allocate all context data from one arena.
+/// Lists, function I/O and local contexts allocated while @ref
+/// rt_initialize_context() are placed into one block, and they are released
+/// at once by @ref rt_free_context(). Variable buffers are not included.
+/// If arena is NULL, arena is allocated by chunks of growing size while
+/// initialization. Otherwise given block is used, and required size can be
+/// obtained with @ref rt_context_arena_size() after initialization with a
+/// NULL arena. If given block is too small, remaining data are taken from
+/// chunks.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] arena Pointer to user allocated block or NULL.
+/// @param[in] size Size of arena in byte.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_context_arena(rt_context_pointer context,
+                                       void *arena, size_t size);
+
+/// @brief Size of context arena used by initialization.
+/// @param[in] context
+/// @return Size in byte.
+size_t rt_context_arena_size(rt_context_pointer context);
+
+/// @brief Allocator of one context.
+typedef struct {
+  void *(*malloc_func)(void *user_data, size_t size); ///< Returns NULL if
+                                                      ///< memory is exhausted.
+  void (*free_func)(void *user_data, void *ptr);
+  void *user_data; ///< Passed to malloc_func and free_func, e.g. a pool.
+} rt_allocator_t;
+
+/// @brief Allocate context data of this context by allocator.
+/// Lists, function I/O, local contexts and context arena allocated by
+/// @ref rt_initialize_context() come from allocator instead of the one set
+/// by @ref rt_set_malloc(), so that each model can be placed in its own
+/// memory, e.g. tightly coupled memory. Context itself, callbacks and
+/// backends are allocated before it is set, by the global one.
+/// It must be called before @ref rt_initialize_context(), and clones take
+/// same allocator.
+/// @param[in] context
+/// @param[in] allocator Copied into context, or NULL to use global one.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_ARGUMENT if a
+/// function of allocator is NULL or context is static.
+rt_return_value_t rt_set_context_allocator(rt_context_pointer context,
+                                           const rt_allocator_t *allocator);
+
+/// @brief Allocate variable buffers of this context by allocator.
+/// It is used instead of the one set by @ref rt_set_variable_malloc() for
+/// variable buffers, decompressed and staged parameters. Runtime allocates a
+/// little more than it needs to align buffers to RT_VARIABLE_ALIGNMENT.
+/// It must be called before @ref rt_initialize_context(), and clones take
+/// same allocator.
+/// @param[in] context
+/// @param[in] allocator Copied into context, or NULL to use global one.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_ARGUMENT if a
+/// function of allocator is NULL or context is static.
+rt_return_value_t rt_set_variable_allocator(rt_context_pointer context,
+                                            const rt_allocator_t *allocator);
+
+/// @brief CPUs which a context runs on, see @ref rt_set_placement().
+typedef struct {
+  const int *cpus;       ///< CPU numbers, copied into context.
+  int num_of_cpus;       ///< Number of cpus, or 0 not to bind context.
+  int replicate_network; ///< Non zero to copy network into context memory.
+} rt_placement_t;
+
+/// @brief Bind context to CPUs, e.g. those of one NUMA node.
+/// @ref rt_initialize_context() runs on these CPUs, so that operating system
+/// places memory first touched there, e.g. variable buffers, packed weights
+/// and local contexts, on their node. Threads of @ref rt_set_num_threads()
+/// are bound to them too, while the thread calling @ref rt_forward() is
+/// left to caller. If replicate_network is set, network is copied by
+/// variable allocator when initialized, so that parameters are read from
+/// local memory. Network is read in place when parameters are loaded by
+/// @ref rt_set_parameter_loader(). It has effect only on Linux.
+/// It must be called before @ref rt_initialize_context(), and clones take
+/// same placement.
+/// @param[in] context
+/// @param[in] placement Copied into context, or NULL not to bind context.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_INDEX if a CPU
+/// number is invalid.
+rt_return_value_t rt_set_placement(rt_context_pointer context,
+                                   const rt_placement_t *placement);
+
+/// @brief Share memory of intermediate variables among contexts.
+/// Buffer planning is enabled, and planned variables except network inputs
+/// and outputs are placed in given arena, so that contexts of models run one
+/// after another, e.g. stages of a cascade, need memory of largest one only.
+/// Contexts sharing an arena must not run @ref rt_forward() at the same
+/// time, and data of intermediate variables is not kept between runs.
+/// Inputs and outputs are kept in memory of context.
+/// It must be called before @ref rt_initialize_context(), and clones
+/// allocate their own arena.
+/// @param[in] context
+/// @param[in] arena Memory shared by contexts, or NULL to let context
+/// allocate it, e.g. to get its size with @ref rt_activation_arena_size().
+/// @param[in] size Size of arena in byte.
+/// @return @ref rt_return_value_t, @ref rt_initialize_context() returns
+/// RT_RET_ERROR_ALLOCATE_CONTEXT if arena is too small.
+rt_return_value_t rt_set_activation_arena(rt_context_pointer context,
+                                          void *arena, size_t size);
+
+/// @brief Size of arena required by context in byte, see
+/// @ref rt_set_activation_arena().
+/// It includes margin to align arena, and is 0 before
+/// @ref rt_initialize_context().
+/// @param[in] context
+/// @return size
+size_t rt_activation_arena_size(rt_context_pointer context);
+
+/// @brief Pages backing memory of planned variables.
+typedef enum {
+  RT_HUGE_PAGES_NONE = 0,    ///< Memory of variable allocator (default).
+  RT_HUGE_PAGES_TRANSPARENT, ///< Mapping advised for transparent huge pages.
+  RT_HUGE_PAGES_EXPLICIT,    ///< Pages reserved in hugetlbfs pool.
+  END_OF_RT_HUGE_PAGES
+} rt_huge_pages_t;
+
+/// @brief Back memory of planned variables with 2 MB pages.
+/// Memory planned by @ref rt_set_buffer_planning() is mapped at a 2 MB
+/// boundary instead of taken from variable allocator, so that large feature
+/// maps need fewer TLB entries. RT_HUGE_PAGES_EXPLICIT takes pages reserved
+/// in /proc/sys/vm/nr_hugepages, and falls back to transparent ones if there
+/// are not enough of them. Memory smaller than a huge page, or which cannot
+/// be mapped, is taken from variable allocator. Areas of variables in
+/// planned memory are aligned to 64 byte cache lines in any mode. Arena
+/// given to @ref rt_set_activation_arena() is used as it is. It has effect
+/// only on Linux.
+/// It must be called before @ref rt_initialize_context(), and clones take
+/// same pages.
+/// @param[in] context
+/// @param[in] pages
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_ARGUMENT if pages
+/// is unknown.
+rt_return_value_t rt_set_huge_pages(rt_context_pointer context,
+                                    rt_huge_pages_t pages);
+
+/// @brief Set number of threads used by functions in @ref rt_forward().
+/// Heavy functions split their outer loops to a thread pool owned by the
+/// context, or to threads of OpenMP if runtime is built with
+/// NNABLART_USE_OPENMP. 1 means running in calling thread only (default).
+/// It must not be called while @ref rt_forward() is running.
+/// @param[in] context
+/// @param[in] num_of_threads Number of threads including calling thread.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_CREATE_THREAD_POOL if
+/// threads are not available.
+rt_return_value_t rt_set_num_threads(rt_context_pointer context,
+                                     int num_of_threads);
+
+/// @brief Get number of threads used by context.
+/// @param[in] context
+/// @return Number of threads.
+int rt_num_of_threads(rt_context_pointer context);
+
+/// @brief Run independent functions at the same time.
+/// When enabled, @ref rt_initialize_context() builds dependency between
+/// functions from memory that their inputs and outputs use, and @ref
+/// rt_forward() runs functions whose dependencies are finished on threads
+/// set by @ref rt_set_num_threads(). In this mode each function runs on one
+/// thread. Networks which have no independent functions run in normal way.
+/// Exec functions of callbacks must be thread safe.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_graph_execution(rt_context_pointer context,
+                                         int enable);
+
+/// @brief Merge functions into former Convolution or Affine.
+/// When enabled, @ref rt_initialize_context() folds BatchNormalization which
+/// uses constant mean and variance into copies of weight and bias of
+/// Convolution or Affine right before it, and applies following ReLU,
+/// LeakyReLU, ReLU6 or Swish inside the kernel. GlobalAveragePooling after
+/// Convolution is calculated by the Convolution right after its kernel, so
+/// that its feature map is not kept. Pad with constant zero on spatial axes,
+/// the same width before and after, is added to pad of following
+/// Convolution, DepthwiseConvolution, AveragePooling including pad or
+/// SumPooling, which then read input of the Pad. Transpose which swaps the
+/// last two axes of a BatchMatmul input is merged into transpose_a or
+/// transpose_b of the BatchMatmul. Softmax over samples of following
+/// TopKData is merged into it, which then normalizes only the k kept values.
+/// Broadcast, BroadcastTo or Tile read only by Add2, Sub2, Mul2, Div2, Pow2,
+/// Maximum2 or Minimum2 is not calculated, and the function reads its input
+/// with stride 0 on repeated axes. They are not folded by
+/// @ref rt_set_graph_simplification() then.
+/// Chain of element wise functions, such as
+/// MulScalar, AddScalar, Sub2 of same shape, Abs or activations, is calculated
+/// by its first function in one pass. Only float functions whose
+/// intermediate outputs are read by the next function only, and are neither
+/// network inputs nor outputs, are merged. Merged functions do nothing in
+/// @ref rt_forward(), and their intermediate outputs are not calculated.
+/// Parameters in network are not modified.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_function_fusion(rt_context_pointer context,
+                                         int enable);
+
+/// @brief Calculate chains of convolution by bands of rows.
+/// Consecutive float Convolution, DepthwiseConvolution, MaxPooling,
+/// AveragePooling or SumPooling over 2D maps with channel first layout, and
+/// element wise activations or inference mode BatchNormalization between
+/// them, form a group when each of them reads only output of former one.
+/// @ref rt_forward() runs the group band by band of output rows of its last
+/// function, and each function calculates only the rows which the next one
+/// reads, from a band of rows gathered from former one. Rows read by
+/// neighbouring bands are calculated again. Band height is chosen in
+/// @ref rt_initialize_context() so that bands of all functions of a group
+/// fit cache_size bytes, and intermediate maps of group are never written
+/// whole. Convolution merged with BatchNormalization and activation by
+/// @ref rt_set_function_fusion() is calculated as one function. Pooling must
+/// have no pad along rows. Groups need planned buffers,
+/// see @ref rt_set_buffer_planning(), and are not made with
+/// @ref rt_set_parameter_loader(), @ref rt_set_streaming_window() or
+/// @ref rt_set_result_caching(). Functions before last function of group are
+/// skipped, so profile and function hooks see group as its last function.
+/// Default is 0, which disables it.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] cache_size Bytes of bands of each group.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_tiled_execution(rt_context_pointer context,
+                                         size_t cache_size);
+
+/// @brief Remove functions which do not change outputs of network.
+/// Functions whose outputs are read neither by network outputs nor by other
+/// such functions, e.g. branches left from training, are dead. They get no
+/// local context, do nothing in @ref rt_forward(), and their outputs are not
+/// calculated and get no memory. Functions without outputs and those run by
+/// callbacks are kept. Functions whose inputs are parameters only, e.g.
+/// Transpose of a weight, are calculated once in
+/// @ref rt_initialize_context() into memory owned by context, and their
+/// outputs are parameters afterwards. Functions such as Identity or
+/// MulScalar by 1 are skipped by @ref rt_set_buffer_planning(), which this
+/// enables too. Nothing is removed with @ref rt_set_parameter_loader(),
+/// @ref rt_set_streaming_window() or @ref rt_set_result_caching().
+/// Default is disabled.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_graph_simplification(rt_context_pointer context,
+                                              int enable);
+
+/// @brief Limit memory of weights packed for kernels.
+/// @ref rt_initialize_context() lets float Convolution and Affine copy their
+/// weights into layout of their kernels, and 3x3 Convolution transform them
+/// for Winograd algorithm. Functions whose copies exceed remaining limit
+/// read original weights instead, with slower kernels. Weights of channel
+/// last Convolution are always packed. Default is no limit.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] limit Max total bytes of packed weights, 0 disables packing.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_weight_prepack_limit(rt_context_pointer context,
+                                              size_t limit);
+
+/// @brief Enable fast approximations of float functions.
+/// Sigmoid, Tanh, Softmax and LogSoftmax use approximated exp within 1e-4
+/// relative error, and Softmax and BatchNormalization multiply by reciprocals
+/// instead of dividing. See rt_set_math_mode(). Functions merged by
+/// @ref rt_set_function_fusion() keep exact calculation. Default is disabled.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_fast_math(rt_context_pointer context, int enable);
+
+/// @brief Keep state of RNN, LSTM and GRU between @ref rt_forward() runs.
+/// Hidden state, and cell state of LSTM, at the end of a run is initial
+/// state of next one, so that streaming input, e.g. audio, is given one frame
+/// at a time without running former frames again. Initial state inputs of
+/// network are read by first run only, and again after
+/// @ref rt_reset_recurrent_state(). Default is disabled. It can be called
+/// before or after @ref rt_initialize_context(), but not while
+/// @ref rt_forward() is running. Clones take same setting and have their own
+/// state.
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_NO_MATCHING_FUNCTION if a
+/// recurrent function is bidirectional or not calculated in float by
+/// runtime.
+rt_return_value_t rt_set_recurrent_streaming(rt_context_pointer context,
+                                             int enable);
+
+/// @brief Start next @ref rt_forward() from initial state inputs, e.g. at
+/// beginning of next utterance. See @ref rt_set_recurrent_streaming().
+/// @param[in] context
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_reset_recurrent_state(rt_context_pointer context);
+
+/// @brief Calculate only new columns of sliding window in each
+/// @ref rt_forward(). Last axis of every network input is time, and input of
+/// each run must be that of former run moved by hop columns toward beginning,
+/// with hop new columns at the end. Convolution and pooling along time keep
+/// their outputs, and calculate only columns depending on new input or on
+/// padding; other functions run as they are. Result is same as running whole
+/// window. Functions are not merged by function fusion. Default is 0, which
+/// disables it. It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] hop Columns moved in each run.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_streaming_window(rt_context_pointer context,
+                                          int hop);
+
+/// @brief Calculate whole window in next @ref rt_forward(), e.g. at beginning
+/// of next stream or after input is not moved by hop. See
+/// @ref rt_set_streaming_window().
+/// @param[in] context
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_reset_streaming_window(rt_context_pointer context);
+
+/// @brief How @ref rt_forward() finds inputs changed since former run.
+typedef enum {
+  RT_RESULT_CACHING_NONE = 0, ///< Every function runs.
+  RT_RESULT_CACHING_MARKED,   ///< Inputs given to rt_mark_input_changed().
+  RT_RESULT_CACHING_HASHED,   ///< Inputs whose data hash differs.
+} rt_result_caching_t;
+
+/// @brief Run only functions which depend on inputs changed since former
+/// @ref rt_forward(), and keep outputs of other functions. Functions which
+/// depend on no input run only once. Each variable has its own memory, so
+/// that outputs are kept, and functions are not merged by function fusion.
+/// First run, and run after @ref rt_forward_range() or after binding other
+/// output buffer, calculates all functions. Input changed by binding other
+/// buffer is found in every mode. Function hooks are called only for functions
+/// which run. It is not used with @ref rt_set_parameter_loader() or
+/// @ref rt_set_streaming_window(). Default is RT_RESULT_CACHING_NONE. It must
+/// be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] mode @ref rt_result_caching_t
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_result_caching(rt_context_pointer context,
+                                        rt_result_caching_t mode);
+
+/// @brief Mark input at index changed, so that functions depending on it run
+/// in next @ref rt_forward(). See @ref rt_set_result_caching().
+/// @param[in] context
+/// @param[in] index
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_mark_input_changed(rt_context_pointer context,
+                                        size_t index);
+
+/// @brief Reader of parameters given to @ref rt_set_parameter_loader().
+typedef struct {
+  /// Start copying size bytes at offset from beginning of NNB into buffer.
+  /// It may return before copy finishes, e.g. after starting DMA. Returns 0
+  /// on success.
+  int (*load)(void *user_data, size_t offset, void *buffer, size_t size);
+  /// Wait until all copies started by load finish, or NULL if load finishes
+  /// them before it returns. Returns 0 on success.
+  int (*wait)(void *user_data);
+  void *user_data; ///< Passed to load and wait.
+} rt_parameter_loader_t;
+
+/// @brief Load parameters on demand instead of reading them from network.
+/// Dense parameters are never read from network, so it may point to memory
+/// where they are not accessible, e.g. external flash. Two staging buffers as
+/// large as parameters of the largest function are allocated by variable
+/// malloc. Parameters of a function are loaded into one of them just before
+/// the function runs, and those of next function are loaded into the other
+/// while it runs. Functions are not merged by @ref rt_set_function_fusion()
+/// and run one by one even if @ref rt_set_graph_execution() is enabled.
+/// Functions which pack weights keep packed copies, set
+/// @ref rt_set_weight_prepack_limit() to 0 to avoid them.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] loader Loader which is copied, or NULL to read parameters from
+/// network.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_parameter_loader(rt_context_pointer context,
+                                          const rt_parameter_loader_t *loader);
+
+/// @brief Reuse plan of former initialization to start faster.
+/// @ref rt_initialize_context() analyzes whole network to find functions
+/// merged by @ref rt_set_function_fusion() and offsets of variables planned
+/// by @ref rt_set_buffer_planning(). After this is called, the result is
+/// recorded, and can be saved from @ref rt_get_plan_cache() and given here in
+/// later runs to skip the analysis. Plan is used only if it was made for
+/// network of same structure, same settings of context and callbacks, and
+/// runtime built for same instruction sets; otherwise it is ignored and the
+/// network is analyzed as usual. Values of parameters are not in plan, so a
+/// network with new parameters of same structure can use it. Kernels chosen
+/// with @ref rt_set_kernel_tuning() or @ref rt_set_kernel_choices() are
+/// recorded too, and used without timing unless other choices are given.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] plan Plan aligned to 4 bytes, which must be alive until
+/// @ref rt_initialize_context() returns, or NULL to only record plan.
+/// @param[in] size Size of plan in byte.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_plan_cache(rt_context_pointer context,
+                                    const void *plan, size_t size);
+
+/// @brief Choose kernels of functions by timing them.
+/// Functions which can run several kernels for their types and shapes, float
+/// Convolution for now, are executed a few times with each kernel in
+/// @ref rt_initialize_context(), on their inputs at that time and with threads
+/// set by @ref rt_set_num_threads(), and the fastest kernel is kept. Areas of
+/// other kernels are freed, but they take memory while functions are timed.
+/// Choices can be read by @ref rt_get_kernel_choices() and given to
+/// @ref rt_set_kernel_choices() on devices of same type to skip timing.
+/// Default is disabled, and each function chooses its kernel by fixed rule.
+/// It must be called before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_kernel_tuning(rt_context_pointer context, int enable);
+
+/// @brief Use kernels chosen by former @ref rt_set_kernel_tuning().
+/// Choices are used only if they were made for network of same number of
+/// functions. A function whose choice is not available for its shapes is
+/// timed if tuning is enabled, otherwise it uses its rule. It must be called
+/// before @ref rt_initialize_context().
+/// @param[in] context
+/// @param[in] choices rt_kernel_t of each function, which must be alive until
+/// @ref rt_initialize_context() returns, or NULL to clear.
+/// @param[in] num_of_functions Number of choices.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_kernel_choices(rt_context_pointer context,
+                                        const uint8_t *choices,
+                                        int num_of_functions);
+
 /// @brief Initialize runtime context with parsing @ref nn_network_t.
 /// Initialize all functions in context and prepare forward calculation.
 ///
@@ -194,6 +830,10 @@ rt_return_value_t rt_add_callback(
 ///
 /// @enduml
 ///
+/// Network is only read by runtime and functions, so it can be placed in read
+/// only memory such as a read only file mapping or flash. It must be alive
+/// until the context is freed.
+///
 /// @param[out] context Pointer to created context. It must be freed by @ref
 /// rt_free_context()
 /// @param[in] network
@@ -201,7 +841,27 @@ rt_return_value_t rt_add_callback(
 rt_return_value_t rt_initialize_context(rt_context_pointer context,
                                         nn_network_t *network);
 
+/// @brief Create another context for the network used by source.
+/// Created context shares the network and its parameters with source, and
+/// has its own variable buffers and function local contexts, so each
+/// context can be used by a different thread at the same time.
+/// Callbacks and options set to source are taken over, and arena size
+/// measured by source is reused without measuring again.
+/// Parameters derived by source, i.e. folded weights and constants,
+/// decompressed or expanded parameters and weights reordered for kernels,
+/// are used by clone without copying, so source is freed after its last
+/// clone and cannot be reshaped while clones are alive. A clone of a clone
+/// shares those of the first source. Contexts sharing a source are cloned
+/// and freed by one thread at a time.
+/// @param[in] source Initialized context.
+/// @param[out] context Pointer to created context. It must be freed by @ref
+/// rt_free_context()
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_clone_context(rt_context_pointer source,
+                                   rt_context_pointer *context);
+
 /// @brief Free context.
+/// Context whose clones are alive is freed with the last of them.
 /// @param[in] context
 /// @return @ref rt_return_value_t
 rt_return_value_t rt_free_context(rt_context_pointer *context);
@@ -231,6 +891,22 @@ int rt_input_dimension(rt_context_pointer context, size_t index);
 int rt_input_shape(rt_context_pointer context, size_t index,
                    size_t shape_index);
 
+/// @brief Change batch size of network with shape of input at index.
+/// Only first dimension (batch size) of shape can differ from network,
+/// all variables whose first dimension is batch size of network follow it.
+/// Shapes are not inferred, so every function reading such variables must
+/// write only such variables, and Transpose must keep batch as first axis.
+/// Context is initialized again, so pointers from @ref rt_input_buffer() and
+/// @ref rt_output_buffer() become invalid and bound buffers are released.
+/// @param[in] context
+/// @param[in] index
+/// @param[in] shape Array of @ref rt_input_dimension() sizes.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_SHAPE if shape or
+/// network cannot be reshaped, RT_RET_ERROR_CONTEXT_HAS_CLONES if context is
+/// source of alive clones of @ref rt_clone_context().
+rt_return_value_t rt_reshape_input(rt_context_pointer context, size_t index,
+                                   const int *shape);
+
 /// @brief Get input buffer at index
 /// NOTE: This function may use for debug purpose.
 /// @param[in] context
@@ -270,6 +946,67 @@ int rt_output_shape(rt_context_pointer context, size_t index,
 /// @return pointer
 void *rt_output_buffer(rt_context_pointer context, size_t index);
 
+/// @brief Use user allocated memory as input buffer at index.
+/// Functions read the input directly from buffer, so data does not need to
+/// be copied to @ref rt_input_buffer(). Buffer must be large enough for the
+/// input, must not overlap other bound buffers, and must be alive while @ref
+/// rt_forward() runs. It is not copied to contexts created by @ref
+/// rt_clone_context().
+/// @param[in] context
+/// @param[in] index
+/// @param[in] buffer User memory, or NULL to use runtime buffer again.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_bind_input_buffer(rt_context_pointer context,
+                                       size_t index, void *buffer);
+
+/// @brief Use user allocated memory as output buffer at index.
+/// Functions write the output directly to buffer. Same restrictions as @ref
+/// rt_bind_input_buffer() apply.
+/// @param[in] context
+/// @param[in] index
+/// @param[in] buffer User memory, or NULL to use runtime buffer again.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_bind_output_buffer(rt_context_pointer context,
+                                        size_t index, void *buffer);
+
+/// @brief Element type of image given to @ref rt_write_input_image().
+typedef enum {
+  RT_IMAGE_TYPE_UINT8 = 0, ///< Unsigned 8 bit values.
+  RT_IMAGE_TYPE_INT8       ///< Signed 8 bit values.
+} rt_image_type_t;
+
+/// @brief Layout of image given to @ref rt_write_input_image().
+typedef enum {
+  RT_IMAGE_LAYOUT_HWC = 0, ///< Channels of each pixel are adjacent.
+  RT_IMAGE_LAYOUT_CHW      ///< Planes of each channel, same as input.
+} rt_image_layout_t;
+
+/// @brief Format and normalization of image.
+typedef struct {
+  rt_image_type_t type;
+  rt_image_layout_t layout;
+  const float *mean; ///< Mean of each channel, or NULL for 0.
+  const float *std;  ///< Standard deviation of each channel, or NULL for 1.
+} rt_image_format_t;
+
+/// @brief Write 8 bit image into input at index with normalization.
+/// Last 3 axes of input are channels, height and width, and leading axes
+/// are number of images. Each value is written as (value - mean) / std of
+/// its channel. Since there are only 256 values, they are normalized into
+/// a table of each channel at first, and each pixel is converted and moved
+/// to channel planes by one lookup. Input must be float, or int8 or int16
+/// fixed point without quantization. The input is marked changed as @ref
+/// rt_mark_input_changed() does.
+/// @param[in] context
+/// @param[in] index
+/// @param[in] format
+/// @param[in] image Images of input size in format.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_write_input_image(rt_context_pointer context,
+                                       size_t index,
+                                       const rt_image_format_t *format,
+                                       const void *image);
+
 /// @brief Get input variable description at index
 /// This function obtains variable description such as data type,
 /// floating point position(e.g.0.5 means fp=1), and so on.
@@ -288,12 +1025,492 @@ nn_variable_t *rt_input_variable(rt_context_pointer context, size_t index);
 /// @return pointer to variable description.
 nn_variable_t *rt_output_variable(rt_context_pointer context, size_t index);
 
-/// @brief Execute feed forward calculation.
+/// @brief Get buffer of variable at index in network.
+/// Intermediate variables may share buffers when @ref rt_set_buffer_planning()
+/// is enabled, and are not written when they are merged by
+/// @ref rt_set_function_fusion(). Read them from a hook of
+/// @ref rt_set_function_hook() right after the function which writes them.
+/// @param[in] context
+/// @param[in] index Index of variable in network.
+/// @return Pointer to data, or NULL if index is out of range.
+void *rt_variable_buffer(rt_context_pointer context, int index);
+
+/// @brief Get plan recorded by @ref rt_initialize_context().
+/// Available when @ref rt_set_plan_cache() was called before initialization.
+/// It is owned by context and alive until context is freed.
+/// @param[in] context
+/// @param[out] plan Plan to be saved.
+/// @param[out] size Size of plan in byte.
+/// @param[out] reused Set to 1 if given plan was used, so that it does not
+/// need to be saved again, otherwise 0. It may be NULL.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_get_plan_cache(rt_context_pointer context,
+                                    const void **plan, size_t *size,
+                                    int *reused);
+
+/// @brief Get kernels used by functions after initialization.
+/// Available when @ref rt_set_kernel_tuning() or @ref rt_set_kernel_choices()
+/// was called before initialization. It is owned by context and alive until
+/// context is freed.
+/// @param[in] context
+/// @param[out] choices rt_kernel_t of each function, RT_KERNEL_DEFAULT if it
+/// has no choice.
+/// @param[out] num_of_functions Number of choices.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_get_kernel_choices(rt_context_pointer context,
+                                        const uint8_t **choices,
+                                        int *num_of_functions);
+
+/// @brief Get alignment of parameters read by functions.
+/// It is the largest power of two up to 64 which divides addresses of all
+/// parameters after @ref rt_initialize_context(). Parameters are read from
+/// network in place, so it is at least 16, 32 or 64 only if network is placed
+/// at such an address and its writer padded data to it as described in
+/// FILE_FORMAT.md. Parameters which runtime copies, e.g. by decompression or
+/// by @ref rt_set_parameter_loader(), are aligned to RT_VARIABLE_ALIGNMENT.
+/// @param[in] context
+/// @return Alignment in byte.
+size_t rt_parameter_alignment(rt_context_pointer context);
+
+/// @brief Memory of context, reported by @ref rt_get_memory_stats().
+/// Runtime allocates everything in @ref rt_initialize_context() and nothing in
+/// @ref rt_forward(), so peak_bytes is held during whole execution.
+typedef struct {
+  size_t parameter_bytes;  ///< Parameters in network, not allocated.
+  size_t activation_bytes; ///< Variable buffers, or arena of planned buffers.
+  size_t peak_activation_bytes; ///< Largest memory of variables alive at
+                                ///< once in order of functions.
+  size_t private_bytes; ///< Local contexts allocated by functions, including
+                        ///< their work area and packed weights.
+  size_t scratch_bytes; ///< Parameters decompressed, expanded, staged or
+                        ///< folded by runtime.
+  size_t context_bytes; ///< Everything else, e.g. lists and function I/O.
+  size_t peak_bytes;    ///< Sum of allocated ones above.
+} rt_memory_stats_t;
+
+/// @brief Get memory used by initialized context.
+/// Sizes are those requested to allocators without their overhead. Context
+/// data freed after initialization, e.g. by @ref rt_set_profiling(), is still
+/// counted, like in measurement of @ref rt_set_context_arena().
 /// @param[in] context
+/// @param[out] stats
 /// @return @ref rt_return_value_t
+rt_return_value_t rt_get_memory_stats(rt_context_pointer context,
+                                      rt_memory_stats_t *stats);
+
+/// @brief Get bytes allocated for local context of a function.
+/// @param[in] context
+/// @param[in] index Index of function in network.
+/// @return Size in byte, or 0 if index is out of range.
+size_t rt_function_private_size(rt_context_pointer context, int index);
+
+/// @brief Get backend which executes a function, see @ref rt_add_backend().
+/// @param[in] context
+/// @param[in] index Index of function in network.
+/// @return Name of backend, or NULL if runtime or callback executes function
+/// or index is out of range.
+const char *rt_function_backend(rt_context_pointer context, int index);
+
+/// @brief Phases of @ref rt_initialize_context() in @ref rt_init_profile_t.
+typedef enum {
+  RT_INIT_PHASE_VERSION_CHECK,     ///< Versions of format and API level.
+  RT_INIT_PHASE_ARENA_MEASUREMENT, ///< Not used, context arena grows while
+                                   ///< initialization.
+  RT_INIT_PHASE_VARIABLES,         ///< Variables, their decompression,
+                                   ///< quantization and plan cache.
+  RT_INIT_PHASE_FUNCTION_FUSION,   ///< Finding functions to merge.
+  RT_INIT_PHASE_BUFFER_PLANNING,   ///< Sizes and places of buffers.
+  RT_INIT_PHASE_BUFFER_ALLOCATION, ///< Allocating and clearing buffers.
+  RT_INIT_PHASE_PARAMETERS, ///< Staging, sparse expansion and folding of
+                            ///< parameters.
+  RT_INIT_PHASE_FUNCTION_IO, ///< Inputs and outputs of functions.
+  RT_INIT_PHASE_LOCAL_CONTEXT, ///< Local contexts of functions, including
+                               ///< packing of weights.
+  RT_INIT_PHASE_KERNEL_TUNING, ///< Choosing kernels of functions.
+  RT_INIT_PHASE_FINALIZATION,  ///< Profile and graph of functions.
+  RT_INIT_PHASE_END
+} rt_init_phase_t;
+
+/// @brief Time spent in @ref rt_initialize_context(), reported by @ref
+/// rt_get_init_profile().
+typedef struct {
+  uint64_t total_nsec; ///< Whole initialization in nano seconds.
+  uint64_t phase_nsec[RT_INIT_PHASE_END]; ///< Indexed by @ref
+                                          ///< rt_init_phase_t.
+} rt_init_profile_t;
+
+/// @brief Get time spent in each phase of initialization of context.
+/// It is always measured by the clock used for profiling, see @ref
+/// rt_set_profile_clock().
+/// @param[in] context
+/// @param[out] profile
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_get_init_profile(rt_context_pointer context,
+                                      rt_init_profile_t *profile);
+
+/// @brief Get time spent to allocate local context of a function and to
+/// choose its kernel.
+/// @param[in] context
+/// @param[in] index Index of function in network.
+/// @return Time in nano seconds, or 0 if index is out of range.
+uint64_t rt_function_init_nsec(rt_context_pointer context, int index);
+
+/// @brief Execute feed forward calculation.
+/// @param[in] context
+/// @return @ref rt_return_value_t, RT_RET_ERROR_FORWARD_ABORTED if deadline
+/// is passed or @ref rt_cancel_forward() is called.
 rt_return_value_t rt_forward(rt_context_pointer context);
 
+/// @brief Set time when forward of context is aborted.
+/// It is checked between functions and between blocks of loops inside
+/// functions, so forward returns soon after deadline. It applies to every
+/// following forward, including @ref rt_forward_async() and requests, until
+/// it is changed, e.g. by prepare of each request.
+/// @param[in] context
+/// @param[in] deadline_nsec Time by clock of profiling, see @ref
+/// rt_set_profile_clock(), or 0 for no deadline.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_forward_deadline(rt_context_pointer context,
+                                          uint64_t deadline_nsec);
+
+/// @brief Abort forward of context running now, or next one if none runs.
+/// It can be called from any thread. Forward returns
+/// RT_RET_ERROR_FORWARD_ABORTED, as when deadline is passed, and outputs and
+/// state kept between forwards, e.g. by @ref rt_set_recurrent_streaming() or
+/// @ref rt_set_streaming_window(), are undefined until they are reset.
+/// Cancel is cleared when a forward returns, so forwards after that one are
+/// not aborted.
+/// @param[in] context
+void rt_cancel_forward(rt_context_pointer context);
+
+/// @brief Callback called when rt_forward() of a request is finished.
+/// @param[in] user_data Pointer given with request.
+/// @param[in] context Context which ran request, whose outputs can be read.
+/// @param[in] result Return value of rt_forward().
+typedef void (*rt_forward_callback_t)(void *user_data,
+                                      rt_context_pointer context,
+                                      rt_return_value_t result);
+
+/// @brief Start @ref rt_forward() on a thread owned by context.
+/// Inputs must be set before, and inputs and outputs must not be touched
+/// until done is called or @ref rt_wait_forward() returns. Only one forward
+/// of a context runs at a time. Without threads, forward runs before return.
+/// @param[in] context
+/// @param[in] done Called on the thread when forward is finished, or NULL.
+/// @param[in] user_data Passed to done.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_QUEUE_FULL if a forward of
+/// context is running, RT_RET_ERROR_CREATE_THREAD_POOL if thread cannot be
+/// created.
+rt_return_value_t rt_forward_async(rt_context_pointer context,
+                                   rt_forward_callback_t done,
+                                   void *user_data);
+
+/// @brief Wait for forward started by @ref rt_forward_async().
+/// @param[in] context
+/// @return Return value of the last forward started by @ref
+/// rt_forward_async().
+rt_return_value_t rt_wait_forward(rt_context_pointer context);
+
+/// @brief Inference run by @ref rt_request_queue_pointer.
+typedef struct {
+  /// Called with context to run request before its forward, e.g. to set
+  /// inputs or to bind buffers, or NULL.
+  void (*prepare)(void *user_data, rt_context_pointer context);
+  /// Called after forward to read outputs, or NULL. Context is given to next
+  /// request after it returns.
+  rt_forward_callback_t done;
+  void *user_data; ///< Passed to prepare and done.
+} rt_request_t;
+
+/// @brief Queue running requests with contexts of a pool, each on own
+/// thread.
+typedef void *rt_request_queue_pointer;
+
+/// @brief Create queue of requests run by initialized contexts.
+/// Contexts, e.g. made by @ref rt_clone_context(), must not be used by others
+/// or freed until queue is destroyed.
+/// @param[out] queue
+/// @param[in] contexts Contexts copied into queue.
+/// @param[in] num_of_contexts Number of contexts and threads.
+/// @param[in] capacity Max number of requests submitted and not finished.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_create_request_queue(rt_request_queue_pointer *queue,
+                                          rt_context_pointer *contexts,
+                                          int num_of_contexts, int capacity);
+
+/// @brief Add request run by the first free context, in order of submission.
+/// It can be called from any thread and from callbacks of requests. Without
+/// threads, request runs before return.
+/// @param[in] queue
+/// @param[in] request Request copied into queue.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_QUEUE_FULL if capacity is
+/// reached.
+rt_return_value_t rt_submit_request(rt_request_queue_pointer queue,
+                                    const rt_request_t *request);
+
+/// @brief Wait until all submitted requests are finished.
+/// @param[in] queue
+/// @return Return value of rt_forward() of the last finished request.
+rt_return_value_t rt_wait_requests(rt_request_queue_pointer queue);
+
+/// @brief Finish submitted requests, stop threads and free queue.
+/// It must not be called from callbacks of requests.
+/// @param[in] queue
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_destroy_request_queue(rt_request_queue_pointer *queue);
+
+/// @brief Settings of @ref rt_create_batcher().
+typedef struct {
+  int num_of_contexts; ///< Batches run at the same time, each on own thread.
+  int max_batch_size;  ///< Batch size of contexts.
+  uint32_t max_delay_usec; ///< Longest time the first request of a batch
+                           ///< waits for others.
+  int capacity; ///< Max number of requests submitted and not finished.
+} rt_batcher_config_t;
+
+/// @brief One sample run by @ref rt_batcher_pointer.
+typedef struct {
+  /// Data of one sample for each input of network. The array and data are
+  /// read until done is called.
+  const void *const *inputs;
+  /// Buffers of one sample for each output of network, written before done.
+  /// The array is read until done is called.
+  void *const *outputs;
+  /// Called when outputs are written, or NULL.
+  void (*done)(void *user_data, rt_return_value_t result);
+  void *user_data; ///< Passed to done.
+} rt_batch_request_t;
+
+/// @brief Batcher which runs single samples together as one batch.
+typedef void *rt_batcher_pointer;
+
+/// @brief Create batcher running requests with contexts cloned from an
+/// initialized context and reshaped to max_batch_size by @ref
+/// rt_reshape_input(). A batch runs when max_batch_size requests are pending
+/// or when its first request has waited for max_delay_usec. Inputs of
+/// requests are copied into batched inputs, and their rows of batched outputs
+/// are copied to their outputs. Batches of fewer requests still run at
+/// max_batch_size, and their other rows are not read.
+/// @param[out] batcher
+/// @param[in] context Initialized context whose inputs and outputs are all
+/// batched in their first dimension. It can be freed after this returns.
+/// @param[in] config
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_SHAPE if an input or
+/// output is not batched.
+rt_return_value_t rt_create_batcher(rt_batcher_pointer *batcher,
+                                    rt_context_pointer context,
+                                    const rt_batcher_config_t *config);
+
+/// @brief Add request to the next batch.
+/// It can be called from any thread and from callbacks of requests. Without
+/// threads, request runs alone before return.
+/// @param[in] batcher
+/// @param[in] request Request copied into batcher.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_QUEUE_FULL if capacity is
+/// reached.
+rt_return_value_t rt_submit_batch_request(rt_batcher_pointer batcher,
+                                          const rt_batch_request_t *request);
+
+/// @brief Finish submitted requests, stop threads and free batcher with its
+/// contexts. It must not be called from callbacks of requests.
+/// @param[in] batcher
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_destroy_batcher(rt_batcher_pointer *batcher);
+
+/// @brief Settings of @ref rt_create_pipeline().
+typedef struct {
+  int num_of_stages; ///< Number of threads, each running a range of functions.
+  const int *cores;  ///< CPU to pin thread of each stage on, or NULL not to
+                     ///< pin them. It is ignored except on Linux.
+  int capacity;      ///< Max number of frames submitted and not finished.
+} rt_pipeline_config_t;
+
+/// @brief Pointer of pipeline.
+typedef void *rt_pipeline_pointer;
+
+/// @brief Create pipeline running stages of network on their own threads.
+/// Functions are split into num_of_stages contiguous ranges of about the same
+/// time, measured by @ref rt_set_profiling() in one @ref rt_forward(). Each
+/// stage runs its range with its own clone of context, so that a stage runs
+/// the next frame while later stages run earlier frames. Variables read by
+/// later stages are copied to the next stage through one buffer per stage,
+/// so a stage waits only when the next stage has not taken the last frame.
+/// Each stage allocates variables of whole network.
+/// @param[out] pipeline
+/// @param[in] context Initialized context. It can be freed after this
+/// returns.
+/// @param[in] config
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_INDEX if there are
+/// more stages than functions.
+rt_return_value_t rt_create_pipeline(rt_pipeline_pointer *pipeline,
+                                     rt_context_pointer context,
+                                     const rt_pipeline_config_t *config);
+
+/// @brief Add frame after submitted frames.
+/// prepare of request is called with context of first stage on its thread,
+/// and done with context of last stage on its thread, whose outputs are those
+/// of the frame. Frames are finished in order of submission. Without
+/// threads, frame runs by @ref rt_forward() before return.
+/// @param[in] pipeline
+/// @param[in] request Request copied into pipeline.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_QUEUE_FULL if capacity is
+/// reached.
+rt_return_value_t rt_submit_frame(rt_pipeline_pointer pipeline,
+                                  const rt_request_t *request);
+
+/// @brief Wait until all submitted frames are finished.
+/// @param[in] pipeline
+/// @return Result of the last finished frame.
+rt_return_value_t rt_wait_pipeline(rt_pipeline_pointer pipeline);
+
+/// @brief Get range of functions run by a stage.
+/// @param[in] pipeline
+/// @param[in] stage
+/// @param[out] first Index of first function.
+/// @param[out] last Index after last function.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_pipeline_stage(rt_pipeline_pointer pipeline, int stage,
+                                    int *first, int *last);
+
+/// @brief Finish submitted frames, stop threads and free pipeline with its
+/// contexts. It must not be called from callbacks of requests.
+/// @param[in] pipeline
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_destroy_pipeline(rt_pipeline_pointer *pipeline);
+
+/// @brief Get number of functions in network.
+/// @param[in] context
+/// @return Number of functions
+int rt_num_of_functions(rt_context_pointer context);
+
+/// @brief Execute functions from first to last - 1 in order of network.
+/// Network can be split into stages which run on different threads, as long
+/// as a stage starts after its former stage finished. Functions run one by
+/// one even if @ref rt_set_graph_execution() is enabled.
+/// @param[in] context
+/// @param[in] first Index of first function to execute.
+/// @param[in] last Index next to last function to execute.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_forward_range(rt_context_pointer context, int first,
+                                   int last);
+
+/// @brief Execute functions until variable is calculated.
+/// Functions after last function which writes the variable are not executed.
+/// @param[in] context
+/// @param[in] variable Index of variable in network.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_forward_until(rt_context_pointer context, int variable);
+
+/// @brief Hardware counters read by @ref rt_set_profile_counters().
+typedef enum {
+  RT_PROFILE_COUNTER_CYCLES,       ///< CPU cycles.
+  RT_PROFILE_COUNTER_INSTRUCTIONS, ///< Retired instructions.
+  RT_PROFILE_COUNTER_L1D_MISSES,   ///< Level 1 data cache read misses.
+  RT_PROFILE_COUNTER_LLC_MISSES,   ///< Last level cache misses.
+  RT_PROFILE_COUNTER_END
+} rt_profile_counter_t;
+
+/// @brief Execution statistics of a function measured in @ref rt_forward().
+typedef struct {
+  nn_function_type_t type;      ///< Type of function.
+  nn_function_implement_t impl; ///< Implementation of function.
+  uint32_t call_count;          ///< Number of executions.
+  uint64_t total_nsec;          ///< Total wall time in nano seconds.
+  uint64_t max_nsec;            ///< Longest wall time in nano seconds.
+  uint64_t counters[RT_PROFILE_COUNTER_END]; ///< Total of hardware counters
+                                             ///< indexed by @ref
+                                             ///< rt_profile_counter_t.
+} rt_function_profile_t;
+
+/// @brief Callback called before and after each function in @ref
+/// rt_forward().
+/// @param[in] user_data Pointer given to @ref rt_set_function_hook().
+/// @param[in] index Index of function in network.
+/// @param[in] function Function description.
+typedef void (*rt_function_hook_t)(void *user_data, int index,
+                                   nn_function_t *function);
+
+/// @brief Enable measuring time of each function.
+/// Counters are cleared when profiling is enabled. It can be called before
+/// or after @ref rt_initialize_context(), but not while @ref rt_forward() is
+/// running.
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t
+rt_return_value_t rt_set_profiling(rt_context_pointer context, int enable);
+
+/// @brief Get execution statistics.
+/// @param[in] context
+/// @param[out] num_of_functions Number of elements of returned array.
+/// @return Array of statistics indexed by function index, or NULL if
+/// profiling is not enabled.
+const rt_function_profile_t *rt_get_profile(rt_context_pointer context,
+                                            int *num_of_functions);
+
+/// @brief Clear execution statistics.
+/// @param[in] context
+void rt_reset_profile(rt_context_pointer context);
+
+/// @brief Read hardware counters around each function in profile.
+/// They are added to counters of @ref rt_function_profile_t while
+/// @ref rt_set_profiling() is enabled. Counters count the thread which runs
+/// the function, not work given by it to other threads of
+/// @ref rt_set_num_threads(). Counters which the CPU or the system does not
+/// provide stay 0. It is available on Linux with perf_event_open(), for ARM
+/// through the same interface to its PMU.
+/// @param[in] context
+/// @param[in] enable Non zero to enable.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_NO_PROFILE_COUNTER if no
+/// counter can be read.
+rt_return_value_t rt_set_profile_counters(rt_context_pointer context,
+                                          int enable);
+
+/// @brief Replace clock used for profiling.
+/// By default monotonic clock of the platform is used.
+/// @param[in] clock_nsec Function returns current time in nano seconds, or
+/// NULL to use default clock.
+void rt_set_profile_clock(uint64_t (*clock_nsec)(void));
+
+/// @brief Execution of a function recorded by @ref rt_set_trace().
+typedef struct {
+  int function;        ///< Index of function, or -1 if it did not run.
+  int thread;          ///< 0 for thread which called @ref rt_forward(), 1 or
+                       ///< more for threads of @ref rt_set_num_threads().
+  uint64_t start_nsec; ///< Start time by clock of profiling.
+  uint64_t end_nsec;   ///< End time by clock of profiling.
+} rt_trace_event_t;
+
+/// @brief Record when and where each function runs.
+/// Each call of @ref rt_forward() or @ref rt_forward_range() takes as many
+/// events as functions, indexed by function, until capacity is used up.
+/// Functions skipped by fusion or buffer planning leave their event with
+/// function of -1. Events are not copied by @ref rt_clone_context().
+/// @param[in] context
+/// @param[in] events Array of events owned by caller, or NULL to stop.
+/// @param[in] capacity Number of elements of events.
+/// @return @ref rt_return_value_t, RT_RET_ERROR_INVALID_ARGUMENT if capacity
+/// is negative, or events is NULL and capacity is not 0.
+rt_return_value_t rt_set_trace(rt_context_pointer context,
+                               rt_trace_event_t *events, int capacity);
+
+/// @brief Get number of events used since @ref rt_set_trace().
+/// @param[in] context
+/// @return Number of events.
+int rt_num_of_trace_events(rt_context_pointer context);
+
+/// @brief Set callbacks called before and after each function.
+/// Hooks are copied to contexts created by @ref rt_clone_context(). With
+/// @ref rt_set_graph_execution() they may be called from several threads.
+/// @param[in] context
+/// @param[in] pre Called before function, or NULL.
+/// @param[in] post Called after function, or NULL.
+/// @param[in] user_data Passed to pre and post.
+void rt_set_function_hook(rt_context_pointer context, rt_function_hook_t pre,
+                          rt_function_hook_t post, void *user_data);
+
 /// @brief user set variable malloc func.
+/// Runtime allocates a little more than it needs from user_malloc to align
+/// buffers to RT_VARIABLE_ALIGNMENT.
 /// @param[in] user_malloc
 void rt_set_variable_malloc(void *(*user_malloc)(size_t size));
 
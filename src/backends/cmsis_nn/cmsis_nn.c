@@ -0,0 +1,654 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/cmsis_nn.h>
+#include <nnablart/functions.h>
+
+#include <arm_nnfunctions.h>
+
+// Kernels of CMSIS-NN take one image of (H, W, C) with uint16_t sizes, so
+// functions are accepted only if their sizes fit, and samples of batch are
+// given to kernel in turn. Values of fixed point position p are integer /
+// 2^p, so product of x and w is shifted right by x.p + w.p - y.p to output,
+// and bias left by x.p + w.p - b.p to product.
+
+#define MAX_SIZE (0xffff) // Largest size kernels take
+
+typedef struct {
+  int batch;        ///< Number of samples
+  int channel_last; ///< Activations are (H, W, C) already
+  uint16_t in_x, in_y, in_c;
+  uint16_t out_x, out_y, out_c;
+  uint16_t kernel_x, kernel_y;
+  uint16_t pad_x, pad_y;
+  uint16_t stride_x, stride_y;
+  uint16_t bias_shift, out_shift;
+  int fast;           ///< Convolution meets constraints of fast kernel
+  int copy_input;     ///< Kernel overwrites input, so it works on a copy
+  size_t buffer_size; ///< Byte size of work buffer of kernel
+
+  q7_t *weight; ///< Weight reordered for kernel, or NULL to use input
+  q7_t *zeros;  ///< Bias of function which has none, or NULL
+  q15_t *buffer;
+  q7_t *input;  ///< (H, W, C) of a sample of input, or NULL
+  q7_t *output; ///< (H, W, C) of a sample of output, or NULL
+} layer_t;
+
+typedef arm_status (*image_kernel_t)(const rt_function_t *f, layer_t *l,
+                                     q7_t *x, q7_t *y);
+
+////////////////////////////////////////////////////////////////////////////////
+// Arguments
+
+static int fits(int value) { return value > 0 && value <= MAX_SIZE; }
+
+static int is_fixed8(const rt_variable_t *v) {
+  return v->type == NN_DATA_TYPE_INT8 && v->quantization == 0;
+}
+
+static int all_fixed8(const rt_function_t *f) {
+  int i; // Iterator
+  for (i = 0; i < f->num_of_inputs; i++) {
+    if (!is_fixed8(f->inputs[i])) {
+      return 0;
+    }
+  }
+  for (i = 0; i < f->num_of_outputs; i++) {
+    if (!is_fixed8(f->outputs[i])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static int shape_size(const rt_list_t *shape, int begin) {
+  int size = 1;
+  int i; // Iterator
+  for (i = begin; i < shape->size; i++) {
+    size *= shape->data[i];
+  }
+  return size;
+}
+
+static int is_ones(nn_network_t *net, nn_list_t list) {
+  const int *values = rt_network_list(net, list);
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (values[i] != 1) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Batch and (C, H, W), or (H, W, C) if channel_last, after base_axis of x
+// and y.
+static int read_images(const rt_function_t *f, int base_axis,
+                       int channel_last, layer_t *l) {
+  const rt_list_t *xs = &f->inputs[0]->shape;
+  const rt_list_t *ys = &f->outputs[0]->shape;
+  const int c = channel_last ? 2 : 0;
+  const int h = channel_last ? 0 : 1;
+  const int w = channel_last ? 1 : 2;
+  int i; // Iterator
+
+  if (base_axis < 0 || xs->size != base_axis + 3 ||
+      ys->size != base_axis + 3) {
+    return 0;
+  }
+  l->batch = 1;
+  for (i = 0; i < base_axis; i++) {
+    if (xs->data[i] != ys->data[i]) {
+      return 0;
+    }
+    l->batch *= xs->data[i];
+  }
+  const int *x = xs->data + base_axis;
+  const int *y = ys->data + base_axis;
+  for (i = 0; i < 3; i++) {
+    if (!fits(x[i]) || !fits(y[i])) {
+      return 0;
+    }
+  }
+  l->channel_last = channel_last;
+  l->in_c = x[c];
+  l->in_y = x[h];
+  l->in_x = x[w];
+  l->out_c = y[c];
+  l->out_y = y[h];
+  l->out_x = y[w];
+  return 1;
+}
+
+static int read_window(nn_network_t *net, nn_list_t pad, nn_list_t stride,
+                       layer_t *l) {
+  if (pad.size != 2 || stride.size != 2) {
+    return 0;
+  }
+  const int *p = rt_network_list(net, pad);
+  const int *s = rt_network_list(net, stride);
+  if (p[0] < 0 || p[0] > MAX_SIZE || p[1] < 0 || p[1] > MAX_SIZE ||
+      !fits(s[0]) || !fits(s[1])) {
+    return 0;
+  }
+  l->pad_y = p[0];
+  l->pad_x = p[1];
+  l->stride_y = s[0];
+  l->stride_x = s[1];
+  return 1;
+}
+
+static int read_shifts(const rt_function_t *f, layer_t *l) {
+  const int product = (int)f->inputs[0]->fp_pos + (int)f->inputs[1]->fp_pos;
+  const int out_shift = product - (int)f->outputs[0]->fp_pos;
+  const int bias_shift =
+      f->num_of_inputs > 2 ? product - (int)f->inputs[2]->fp_pos : 0;
+
+  // Kernels round by adding 1 << (out_shift - 1).
+  if (out_shift < 1 || bias_shift < 0) {
+    return 0;
+  }
+  l->out_shift = out_shift;
+  l->bias_shift = bias_shift;
+  return 1;
+}
+
+static int has_inputs(const rt_function_t *f, int least, int most) {
+  return f->num_of_inputs >= least && f->num_of_inputs <= most &&
+         f->num_of_outputs == 1 && all_fixed8(f);
+}
+
+// Bias must have a value for each output channel.
+static int read_bias(const rt_function_t *f, int channels) {
+  return f->num_of_inputs < 3 ||
+         shape_size(&f->inputs[2]->shape, 0) == channels;
+}
+
+static int setup_convolution(nn_network_t *net, const nn_function_t *info,
+                             const rt_function_t *f, layer_t *l) {
+  const nn_function_convolution_t *a =
+      (const nn_function_convolution_t *)info;
+  memset(l, 0, sizeof(layer_t));
+  if (!has_inputs(f, 2, 3) || a->group != 1 || !is_ones(net, a->dilation) ||
+      !read_images(f, a->base_axis, a->channel_last, l) ||
+      !read_window(net, a->pad, a->stride, l) || !read_shifts(f, l) ||
+      !read_bias(f, l->out_c)) {
+    return 0;
+  }
+
+  // Weight is (out, in, H, W), or (out, H, W, in) if channel_last.
+  const rt_list_t *w = &f->inputs[1]->shape;
+  if (w->size != 4 || w->data[0] != l->out_c ||
+      w->data[a->channel_last ? 3 : 1] != l->in_c ||
+      !fits(w->data[a->channel_last ? 1 : 2]) ||
+      !fits(w->data[a->channel_last ? 2 : 3])) {
+    return 0;
+  }
+  l->kernel_y = w->data[a->channel_last ? 1 : 2];
+  l->kernel_x = w->data[a->channel_last ? 2 : 3];
+  l->fast = l->in_c % 4 == 0 && l->out_c % 2 == 0;
+  // Windows of input are expanded to q15.
+  l->buffer_size = sizeof(q15_t) * 2 * l->in_c * l->kernel_x * l->kernel_y;
+  return 1;
+}
+
+static int setup_depthwise_convolution(nn_network_t *net,
+                                       const nn_function_t *info,
+                                       const rt_function_t *f, layer_t *l) {
+  const nn_function_depthwise_convolution_t *a =
+      (const nn_function_depthwise_convolution_t *)info;
+  memset(l, 0, sizeof(layer_t));
+  if (!has_inputs(f, 2, 3) || a->multiplier != 1 ||
+      !is_ones(net, a->dilation) || !read_images(f, a->base_axis, 0, l) ||
+      l->in_c != l->out_c || l->in_c % 2 != 0 ||
+      !read_window(net, a->pad, a->stride, l) || !read_shifts(f, l) ||
+      !read_bias(f, l->out_c)) {
+    return 0;
+  }
+
+  // Weight is (C, H, W).
+  const rt_list_t *w = &f->inputs[1]->shape;
+  if (w->size != 3 || w->data[0] != l->out_c || !fits(w->data[1]) ||
+      !fits(w->data[2])) {
+    return 0;
+  }
+  l->kernel_y = w->data[1];
+  l->kernel_x = w->data[2];
+  l->buffer_size = sizeof(q15_t) * 2 * l->in_c * l->kernel_x * l->kernel_y;
+  return 1;
+}
+
+static int setup_affine(nn_network_t *net, const nn_function_t *info,
+                        const rt_function_t *f, layer_t *l) {
+  const nn_function_affine_t *a = (const nn_function_affine_t *)info;
+  memset(l, 0, sizeof(layer_t));
+  if (!has_inputs(f, 2, 3) || !read_shifts(f, l)) {
+    return 0;
+  }
+  const rt_list_t *xs = &f->inputs[0]->shape;
+  if (a->base_axis < 0 || a->base_axis > xs->size ||
+      !fits(shape_size(xs, a->base_axis))) {
+    return 0;
+  }
+  // Weight is stored transposed in NNB, one row for each output.
+  const int in = shape_size(xs, a->base_axis);
+  const int batch = shape_size(xs, 0) / in;
+  const int out = batch ? shape_size(&f->outputs[0]->shape, 0) / batch : 0;
+  if (!fits(out) || shape_size(&f->inputs[1]->shape, 0) != in * out ||
+      !read_bias(f, out)) {
+    return 0;
+  }
+  l->batch = batch;
+  l->in_c = in;
+  l->out_c = out;
+  // Input vector is expanded to q15.
+  l->buffer_size = sizeof(q15_t) * in;
+  return 1;
+}
+
+// Kernels take square images and windows.
+static int setup_pooling(nn_network_t *net, nn_list_t kernel,
+                         nn_list_t stride, nn_list_t pad, int channel_last,
+                         const rt_function_t *f, layer_t *l) {
+  memset(l, 0, sizeof(layer_t));
+  if (!has_inputs(f, 1, 1) ||
+      f->inputs[0]->fp_pos != f->outputs[0]->fp_pos || kernel.size != 2 ||
+      !read_images(f, f->inputs[0]->shape.size - 3, channel_last, l) ||
+      l->in_c != l->out_c ||
+      !read_window(net, pad, stride.size ? stride : kernel, l)) {
+    return 0;
+  }
+  const int *k = rt_network_list(net, kernel);
+  if (!fits(k[0]) || k[0] != k[1] || l->in_x != l->in_y ||
+      l->out_x != l->out_y || l->pad_x != l->pad_y ||
+      l->stride_x != l->stride_y) {
+    return 0;
+  }
+  l->kernel_y = l->kernel_x = k[0];
+  l->copy_input = 1;
+  return 1;
+}
+
+static int setup_max_pooling(nn_network_t *net, const nn_function_t *info,
+                             const rt_function_t *f, layer_t *l) {
+  const nn_function_max_pooling_t *a = (const nn_function_max_pooling_t *)info;
+  return setup_pooling(net, a->kernel, a->stride, a->pad, a->channel_last, f,
+                       l);
+}
+
+static int setup_average_pooling(nn_network_t *net, const nn_function_t *info,
+                                 const rt_function_t *f, layer_t *l) {
+  const nn_function_average_pooling_t *a =
+      (const nn_function_average_pooling_t *)info;
+  if (!setup_pooling(net, a->kernel, a->stride, a->pad, a->channel_last, f,
+                     l)) {
+    return 0;
+  }
+  // Kernel divides sums by number of values inside input, which is same
+  // as including pad when there is none.
+  if (a->including_pad && (l->pad_x != 0 || l->pad_y != 0)) {
+    return 0;
+  }
+  // Rows of sums are q15.
+  l->buffer_size = sizeof(q15_t) * 2 * l->out_x * l->in_c;
+  return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Local context
+
+static void release(void *p) {
+  if (p) {
+    rt_free_func(p);
+  }
+}
+
+static rt_function_error_t free_layer(rt_function_t *f) {
+  layer_t *l = f->local_context;
+  if (l) {
+    release(l->weight);
+    release(l->zeros);
+    release(l->buffer);
+    release(l->input);
+    release(l->output);
+    rt_free_func(l);
+    f->local_context = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static void *allocate_zeros(size_t size) {
+  void *p = rt_malloc_func(size);
+  if (p) {
+    memset(p, 0, size);
+  }
+  return p;
+}
+
+// Local context of setup, with buffers which its kernel needs.
+static rt_function_error_t allocate_layer(rt_function_t *f,
+                                          const layer_t *setup) {
+  const int images = setup->in_x != 0;
+  layer_t *l = rt_malloc_func(sizeof(layer_t));
+  if (l == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  *l = *setup;
+  f->local_context = l;
+
+  if ((f->num_of_inputs == 2 && (l->zeros = allocate_zeros(l->out_c)) == 0) ||
+      (l->buffer_size && (l->buffer = rt_malloc_func(l->buffer_size)) == 0) ||
+      (images && (l->copy_input || !l->channel_last) &&
+       (l->input = rt_malloc_func(l->in_x * l->in_y * l->in_c)) == 0) ||
+      (images && !l->channel_last &&
+       (l->output = rt_malloc_func(l->out_x * l->out_y * l->out_c)) == 0)) {
+    free_layer(f);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Weight is copied to l->weight where src[i][j][k] moves to dst[i][k][j],
+// i.e. axes j and k of sizes n and m are swapped in each of outer blocks.
+static rt_function_error_t reorder_weight(rt_function_t *f, int outer, int n,
+                                          int m) {
+  layer_t *l = f->local_context;
+  const q7_t *src = f->inputs[1]->data;
+  int i, j, k; // Iterators
+
+  l->weight = rt_malloc_func(outer * n * m);
+  if (l->weight == 0) {
+    free_layer(f);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  for (i = 0; i < outer; i++) {
+    q7_t *dst = l->weight + i * n * m;
+    for (j = 0; j < n; j++) {
+      for (k = 0; k < m; k++) {
+        dst[k * n + j] = src[(i * n + j) * m + k];
+      }
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Execution
+
+static const q7_t *weight_of(const rt_function_t *f, const layer_t *l) {
+  return l->weight ? l->weight : f->inputs[1]->data;
+}
+
+static const q7_t *bias_of(const rt_function_t *f, const layer_t *l) {
+  return f->num_of_inputs > 2 ? f->inputs[2]->data : l->zeros;
+}
+
+// (C, N) of x to (N, C) of y.
+static void transpose(const q7_t *x, q7_t *y, int c, int n) {
+  int i, j; // Iterators
+  for (i = 0; i < c; i++) {
+    for (j = 0; j < n; j++) {
+      y[j * c + i] = x[i * n + j];
+    }
+  }
+}
+
+// Each sample of input is given to kernel in (H, W, C), and its output is
+// transposed back unless function is channel last.
+static rt_function_error_t exec_images(rt_function_t *f,
+                                       image_kernel_t kernel) {
+  layer_t *l = f->local_context;
+  const int in_size = l->in_x * l->in_y * l->in_c;
+  const int out_size = l->out_x * l->out_y * l->out_c;
+  q7_t *x = f->inputs[0]->data;
+  q7_t *y = f->outputs[0]->data;
+  int n; // Iterator
+
+  for (n = 0; n < l->batch; n++, x += in_size, y += out_size) {
+    q7_t *input = x;
+    if (l->input) {
+      if (l->channel_last) {
+        memcpy(l->input, x, in_size);
+      } else {
+        transpose(x, l->input, l->in_c, l->in_x * l->in_y);
+      }
+      input = l->input;
+    }
+    if (kernel(f, l, input, l->output ? l->output : y) != ARM_MATH_SUCCESS) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+    if (l->output) {
+      transpose(l->output, y, l->out_x * l->out_y, l->out_c);
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static arm_status convolution_kernel(const rt_function_t *f, layer_t *l,
+                                     q7_t *x, q7_t *y) {
+  if (l->fast) {
+    return arm_convolve_HWC_q7_fast_nonsquare(
+        x, l->in_x, l->in_y, l->in_c, weight_of(f, l), l->out_c, l->kernel_x,
+        l->kernel_y, l->pad_x, l->pad_y, l->stride_x, l->stride_y,
+        bias_of(f, l), l->bias_shift, l->out_shift, y, l->out_x, l->out_y,
+        l->buffer, 0);
+  }
+  return arm_convolve_HWC_q7_basic_nonsquare(
+      x, l->in_x, l->in_y, l->in_c, weight_of(f, l), l->out_c, l->kernel_x,
+      l->kernel_y, l->pad_x, l->pad_y, l->stride_x, l->stride_y,
+      bias_of(f, l), l->bias_shift, l->out_shift, y, l->out_x, l->out_y,
+      l->buffer, 0);
+}
+
+static arm_status depthwise_convolution_kernel(const rt_function_t *f,
+                                               layer_t *l, q7_t *x, q7_t *y) {
+  return arm_depthwise_separable_conv_HWC_q7_nonsquare(
+      x, l->in_x, l->in_y, l->in_c, weight_of(f, l), l->out_c, l->kernel_x,
+      l->kernel_y, l->pad_x, l->pad_y, l->stride_x, l->stride_y,
+      bias_of(f, l), l->bias_shift, l->out_shift, y, l->out_x, l->out_y,
+      l->buffer, 0);
+}
+
+static arm_status max_pooling_kernel(const rt_function_t *f, layer_t *l,
+                                     q7_t *x, q7_t *y) {
+  arm_maxpool_q7_HWC(x, l->in_x, l->in_c, l->kernel_x, l->pad_x, l->stride_x,
+                     l->out_x, 0, y);
+  return ARM_MATH_SUCCESS;
+}
+
+static arm_status average_pooling_kernel(const rt_function_t *f, layer_t *l,
+                                         q7_t *x, q7_t *y) {
+  arm_avepool_q7_HWC(x, l->in_x, l->in_c, l->kernel_x, l->pad_x, l->stride_x,
+                     l->out_x, (q7_t *)l->buffer, y);
+  return ARM_MATH_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Kernels
+
+static int cmsis_accept_convolution(nn_network_t *net,
+                                    const nn_function_t *info,
+                                    const rt_function_t *f, void *user_data) {
+  layer_t l;
+  return setup_convolution(net, info, f, &l);
+}
+
+static rt_function_error_t
+cmsis_allocate_convolution(nn_network_t *net, const nn_function_t *info,
+                           rt_function_t *f, void *user_data) {
+  layer_t l;
+  if (!setup_convolution(net, info, f, &l)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  rt_function_error_t ret = allocate_layer(f, &l);
+  if (ret != RT_FUNCTION_ERROR_NOERROR || l.channel_last) {
+    return ret;
+  }
+  // (out, in, H, W) to (out, H, W, in)
+  return reorder_weight(f, l.out_c, l.in_c, l.kernel_x * l.kernel_y);
+}
+
+static rt_function_error_t cmsis_exec_convolution(rt_function_t *f) {
+  return exec_images(f, convolution_kernel);
+}
+
+static int cmsis_accept_depthwise_convolution(nn_network_t *net,
+                                              const nn_function_t *info,
+                                              const rt_function_t *f,
+                                              void *user_data) {
+  layer_t l;
+  return setup_depthwise_convolution(net, info, f, &l);
+}
+
+static rt_function_error_t
+cmsis_allocate_depthwise_convolution(nn_network_t *net,
+                                     const nn_function_t *info,
+                                     rt_function_t *f, void *user_data) {
+  layer_t l;
+  if (!setup_depthwise_convolution(net, info, f, &l)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  rt_function_error_t ret = allocate_layer(f, &l);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    return ret;
+  }
+  // (C, H, W) to (H, W, C)
+  return reorder_weight(f, 1, l.out_c, l.kernel_x * l.kernel_y);
+}
+
+static rt_function_error_t
+cmsis_exec_depthwise_convolution(rt_function_t *f) {
+  return exec_images(f, depthwise_convolution_kernel);
+}
+
+static int cmsis_accept_affine(nn_network_t *net, const nn_function_t *info,
+                               const rt_function_t *f, void *user_data) {
+  layer_t l;
+  return setup_affine(net, info, f, &l);
+}
+
+static rt_function_error_t cmsis_allocate_affine(nn_network_t *net,
+                                                 const nn_function_t *info,
+                                                 rt_function_t *f,
+                                                 void *user_data) {
+  layer_t l;
+  if (!setup_affine(net, info, f, &l)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  return allocate_layer(f, &l);
+}
+
+static rt_function_error_t cmsis_exec_affine(rt_function_t *f) {
+  layer_t *l = f->local_context;
+  const q7_t *x = f->inputs[0]->data;
+  q7_t *y = f->outputs[0]->data;
+  int n; // Iterator
+
+  for (n = 0; n < l->batch; n++, x += l->in_c, y += l->out_c) {
+    if (arm_fully_connected_q7(x, weight_of(f, l), l->in_c, l->out_c,
+                               l->bias_shift, l->out_shift, bias_of(f, l), y,
+                               l->buffer) != ARM_MATH_SUCCESS) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static int cmsis_accept_max_pooling(nn_network_t *net,
+                                    const nn_function_t *info,
+                                    const rt_function_t *f, void *user_data) {
+  layer_t l;
+  return setup_max_pooling(net, info, f, &l);
+}
+
+static rt_function_error_t
+cmsis_allocate_max_pooling(nn_network_t *net, const nn_function_t *info,
+                           rt_function_t *f, void *user_data) {
+  layer_t l;
+  if (!setup_max_pooling(net, info, f, &l)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  return allocate_layer(f, &l);
+}
+
+static rt_function_error_t cmsis_exec_max_pooling(rt_function_t *f) {
+  return exec_images(f, max_pooling_kernel);
+}
+
+static int cmsis_accept_average_pooling(nn_network_t *net,
+                                        const nn_function_t *info,
+                                        const rt_function_t *f,
+                                        void *user_data) {
+  layer_t l;
+  return setup_average_pooling(net, info, f, &l);
+}
+
+static rt_function_error_t
+cmsis_allocate_average_pooling(nn_network_t *net, const nn_function_t *info,
+                               rt_function_t *f, void *user_data) {
+  layer_t l;
+  if (!setup_average_pooling(net, info, f, &l)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  return allocate_layer(f, &l);
+}
+
+static rt_function_error_t cmsis_exec_average_pooling(rt_function_t *f) {
+  return exec_images(f, average_pooling_kernel);
+}
+
+static int cmsis_accept_relu(nn_network_t *net, const nn_function_t *info,
+                             const rt_function_t *f, void *user_data) {
+  return has_inputs(f, 1, 1) &&
+         f->inputs[0]->fp_pos == f->outputs[0]->fp_pos &&
+         shape_size(&f->inputs[0]->shape, 0) ==
+             shape_size(&f->outputs[0]->shape, 0);
+}
+
+// Kernel works in place, on at most MAX_SIZE values at once.
+static rt_function_error_t cmsis_exec_relu(rt_function_t *f) {
+  const int size = shape_size(&f->inputs[0]->shape, 0);
+  q7_t *y = f->outputs[0]->data;
+  int i; // Iterator
+
+  if (f->inputs[0]->data != y) {
+    memcpy(y, f->inputs[0]->data, size);
+  }
+  for (i = 0; i < size; i += MAX_SIZE) {
+    arm_relu_q7(y + i, size - i < MAX_SIZE ? size - i : MAX_SIZE);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static const rt_backend_kernel_t kernels[] = {
+    {NN_FUNCTION_CONVOLUTION, cmsis_accept_convolution,
+     cmsis_allocate_convolution, cmsis_exec_convolution, free_layer},
+    {NN_FUNCTION_DEPTHWISE_CONVOLUTION, cmsis_accept_depthwise_convolution,
+     cmsis_allocate_depthwise_convolution, cmsis_exec_depthwise_convolution,
+     free_layer},
+    {NN_FUNCTION_AFFINE, cmsis_accept_affine, cmsis_allocate_affine,
+     cmsis_exec_affine, free_layer},
+    {NN_FUNCTION_MAX_POOLING, cmsis_accept_max_pooling,
+     cmsis_allocate_max_pooling, cmsis_exec_max_pooling, free_layer},
+    {NN_FUNCTION_AVERAGE_POOLING, cmsis_accept_average_pooling,
+     cmsis_allocate_average_pooling, cmsis_exec_average_pooling, free_layer},
+    {NN_FUNCTION_RELU, cmsis_accept_relu, 0, cmsis_exec_relu, 0},
+};
+
+static const rt_backend_t backend = {
+    "cmsis_nn", 10, kernels, sizeof(kernels) / sizeof(kernels[0]), 0};
+
+const rt_backend_t *rt_cmsis_nn_backend(void) { return &backend; }
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 
 #include <assert.h>
 #include <math.h>
@@ -56,6 +57,10 @@ rt_function_error_t allocate_celu_local_context(rt_function_t *f) {
   p->set_output = select_setter(p->output);
   p->output_size = calc_shape_size(f->outputs[0]->shape);
   p->in_shape = clone_list(f->inputs[0]->shape);
+  if (p->in_shape.data == 0) {
+    rt_free_func(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   if (p->input_size * 2 != p->output_size) {
     free_list(p->in_shape);
@@ -99,13 +104,15 @@ rt_function_error_t exec_celu(rt_function_t *f) {
   }
   s1 = p->input_size / s0;
 
+  // Second half is ELU of -x, calculated in place after negation.
   for (i = 0; i < s1; ++i) {
+    const float *x = (float *)(p->input->data) + i * s0;
+    float *y = (float *)(p->output->data) + i * s0 * 2;
+    vector_elu(x, y, s0, c->alpha, 1.0f);
     for (j = 0; j < s0; ++j) {
-      float x = *((float *)(p->input->data) + i * s0 + j);
-      float *y = (float *)(p->output->data);
-      *(y + i * s0 * 2 + j) = x > 0.0f ? x : c->alpha * (expf(x) - 1.0f);
-      *(y + i * s0 * 2 + s0 + j) = x < 0.0f ? -x : c->alpha * (expf(-x) - 1.0f);
+      y[s0 + j] = -x[j];
     }
+    vector_elu(y + s0, y + s0, s0, c->alpha, 1.0f);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
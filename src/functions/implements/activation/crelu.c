@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 
 #include <assert.h>
 #include <math.h>
@@ -57,6 +58,10 @@ rt_function_error_t allocate_crelu_local_context(rt_function_t *f) {
   p->set_output = select_setter(p->output);
   p->output_size = calc_shape_size(f->outputs[0]->shape);
   p->in_shape = clone_list(f->inputs[0]->shape);
+  if (p->in_shape.data == 0) {
+    rt_free_func(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   if (p->input_size * 2 != p->output_size) {
     free_list(p->in_shape);
@@ -93,20 +98,18 @@ rt_function_error_t free_crelu_local_context(rt_function_t *f) {
 rt_function_error_t exec_crelu(rt_function_t *f) {
   crelu_local_context_t *c = (crelu_local_context_t *)(f->local_context);
   crelu_private_t *p = (crelu_private_t *)(c->data);
-  int i, j, s0 = 1, s1;
+  int i, s0 = 1, s1;
 
   for (i = c->axis; i < p->in_shape.size; ++i) {
     s0 *= p->in_shape.data[i];
   }
   s1 = p->input_size / s0;
 
+  // Both halves of each row are written from one read of input.
   for (i = 0; i < s1; ++i) {
-    for (j = 0; j < s0; ++j) {
-      float x = *((float *)(p->input->data) + i * s0 + j);
-      float *y = (float *)(p->output->data);
-      *(y + i * s0 * 2 + j) = x > 0.0f ? x : 0.0f;
-      *(y + i * s0 * 2 + s0 + j) = x < 0.0f ? -x : 0.0f;
-    }
+    const float *x = (float *)(p->input->data) + i * s0;
+    float *y = (float *)(p->output->data) + i * s0 * 2;
+    vector_crelu(x, y, y + s0, s0);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <math.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -46,11 +47,7 @@ rt_function_error_t exec_elu(rt_function_t *f) {
   const float *x = (float *)(f->inputs[0]->data);
   float *y = (float *)(f->outputs[0]->data);
   const int size = calc_shape_size(f->inputs[0]->shape);
-  int s;
-  for (s = 0; s < size; s++) {
-    y[s] = (float)(x[s] > (float)0 ? x[s]
-                                   : context->alpha * (expf(x[s]) - (float)1));
-  }
+  vector_elu(x, y, size, context->alpha, 1.0f);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_ELU_FLOAT32 */
@@ -58,19 +55,11 @@ rt_function_error_t exec_elu(rt_function_t *f) {
 #ifdef CONFIG_ELU_GENERIC
 rt_function_error_t exec_elu_generic(rt_function_t *f) {
   elu_local_context_t *context = (elu_local_context_t *)(f->local_context);
-  rt_variable_t *input = f->inputs[0];
-  rt_variable_getter get_input = select_getter(input);
-  rt_variable_t *output = f->outputs[0];
-  rt_variable_setter set_output = select_setter(output);
   const int size = calc_shape_size(f->inputs[0]->shape);
-  int s;
-  for (s = 0; s < size; s++) {
-    float val_x = get_input(input, s);
-    float val_y =
-        (float)(val_x > (float)0 ? val_x
-                                 : context->alpha * (expf(val_x) - (float)1));
-    set_output(output, s, val_y);
-  }
+
+  FOR_EACH_BLOCK(
+      f->inputs[0], f->outputs[0], size,
+      (float)(x > (float)0 ? x : context->alpha * (expf(x) - (float)1)));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_ELU_GENERIC */
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <assert.h>
 #include <math.h>
 #include <nnablart/config.h>
@@ -64,11 +65,8 @@ rt_function_error_t exec_leaky_relu(rt_function_t *f) {
   const float *x = (float *)(f->inputs[0]->data);
   float *y = (float *)(f->outputs[0]->data);
   const int output_size = calc_shape_size(f->inputs[0]->shape);
-  int i;
 
-  for (i = 0; i < output_size; ++i) {
-    y[i] = x[i] > 0.0f ? x[i] : x[i] * c->alpha;
-  }
+  vector_leaky_relu(x, y, output_size, c->alpha);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_LEAKYRELU_FLOAT32 */
@@ -77,18 +75,10 @@ rt_function_error_t exec_leaky_relu(rt_function_t *f) {
 rt_function_error_t exec_leaky_relu_generic(rt_function_t *f) {
   leaky_relu_local_context_t *c =
       (leaky_relu_local_context_t *)(f->local_context);
-  rt_variable_t *input = f->inputs[0];
-  rt_variable_getter get_input = select_getter(input);
-  rt_variable_t *output = f->outputs[0];
-  rt_variable_setter set_output = select_setter(output);
   const int output_size = calc_shape_size(f->inputs[0]->shape);
-  int i;
 
-  for (i = 0; i < output_size; ++i) {
-    float val_x = get_input(input, i);
-    float val_y = val_x > 0.0f ? val_x : val_x * c->alpha;
-    set_output(output, i, val_y);
-  }
+  FOR_EACH_BLOCK(f->inputs[0], f->outputs[0], output_size,
+                 x > 0.0f ? x : x * c->alpha);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_LEAKYRELU_GENERIC */
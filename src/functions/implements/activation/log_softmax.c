@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#include "../../utilities/softmax.h"
+
+#ifdef CONFIG_LOGSOFTMAX
+
+rt_function_error_t exec_log_softmax_generic(rt_function_t *f);
+
+rt_function_error_t allocate_log_softmax_local_context(rt_function_t *f) {
+  log_softmax_local_context_t *context =
+      (log_softmax_local_context_t *)(f->local_context);
+  const int is_float = f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+                       f->outputs[0]->type == NN_DATA_TYPE_FLOAT;
+  softmax_param_t *p = rt_malloc_func(sizeof(softmax_param_t));
+  rt_function_error_t ret;
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  context->data = 0;
+  ret = allocate_softmax_param(f, context->axis, 1, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    rt_free_func(p);
+    return ret;
+  }
+  context->data = (void *)p;
+  if (is_float) {
+#ifdef CONFIG_LOGSOFTMAX_FLOAT32
+    f->exec_func = exec_log_softmax;
+#endif /* CONFIG_LOGSOFTMAX_FLOAT32 */
+  } else {
+#ifdef CONFIG_LOGSOFTMAX_GENERIC
+    f->exec_func = exec_log_softmax_generic;
+#endif /* CONFIG_LOGSOFTMAX_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_log_softmax_local_context(rt_function_t *f) {
+  log_softmax_local_context_t *context =
+      (log_softmax_local_context_t *)(f->local_context);
+  softmax_param_t *p = (softmax_param_t *)context->data;
+  if (p) {
+    free_softmax_param(p);
+    rt_free_func(p);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_LOGSOFTMAX_FLOAT32
+rt_function_error_t exec_log_softmax(rt_function_t *f) {
+  log_softmax_local_context_t *context =
+      (log_softmax_local_context_t *)(f->local_context);
+  softmax_param_t *p = (softmax_param_t *)context->data;
+  calc_softmax(p, (const float *)(f->inputs[0]->data),
+               (float *)(f->outputs[0]->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_LOGSOFTMAX_FLOAT32 */
+
+#ifdef CONFIG_LOGSOFTMAX_GENERIC
+rt_function_error_t exec_log_softmax_generic(rt_function_t *f) {
+  log_softmax_local_context_t *context =
+      (log_softmax_local_context_t *)(f->local_context);
+  softmax_param_t *p = (softmax_param_t *)context->data;
+  calc_softmax_generic(p, f->inputs[0], f->outputs[0]);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_LOGSOFTMAX_GENERIC */
+
+#endif /* CONFIG_LOGSOFTMAX */
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
 
@@ -58,6 +59,9 @@ rt_function_error_t allocate_prelu_local_context(rt_function_t *f) {
   p->set_output = select_setter(p->output);
   p->in_shape = clone_list(f->inputs[0]->shape);
   p->in_stride = calc_contiguous_strides(f->inputs[0]->shape);
+  if (p->in_shape.data == 0 || p->in_stride.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->weight->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT) {
@@ -82,6 +86,9 @@ rt_function_error_t free_prelu_local_context(rt_function_t *f) {
 }
 
 #ifdef CONFIG_PRELU_FLOAT32
+// Input is (outer, channels, inner) with a slope for each channel. Each row
+// of inner values has one slope, and slopes are read as a row when inner is
+// 1.
 rt_function_error_t exec_prelu(rt_function_t *f) {
   prelu_local_context_t *context = (prelu_local_context_t *)(f->local_context);
   prelu_private_t *p = (prelu_private_t *)(context->data);
@@ -90,15 +97,20 @@ rt_function_error_t exec_prelu(rt_function_t *f) {
   float *y = (float *)(p->output->data);
   int base_shape = p->in_shape.data[context->base_axis];
   int base_stride = p->in_stride.data[context->base_axis];
+  int outer = p->input_size / (base_shape * base_stride);
+  int i, c; // Iterators
 
   if (p->weight_size == 1) {
-    for (int s = 0; s < p->input_size; ++s) {
-      y[s] = (x[s] >= 0) ? x[s] : x[s] * (*w);
+    vector_leaky_relu(x, y, p->input_size, *w);
+  } else if (base_stride == 1) {
+    for (i = 0; i < outer; i++, x += base_shape, y += base_shape) {
+      vector_prelu(x, w, y, base_shape);
     }
   } else {
-    for (int s = 0; s < p->input_size; ++s) {
-      int iw = (s / base_stride) % base_shape;
-      y[s] = (x[s] >= 0) ? x[s] : x[s] * w[iw];
+    for (i = 0; i < outer; i++) {
+      for (c = 0; c < base_shape; c++, x += base_stride, y += base_stride) {
+        vector_leaky_relu(x, y, base_stride, w[c]);
+      }
     }
   }
   return RT_FUNCTION_ERROR_NOERROR;
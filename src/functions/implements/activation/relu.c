@@ -16,7 +16,10 @@
 #include <nnablart/functions.h>
 
 #include "../../utilities/accessor.h"
+#include "../../utilities/fixed.h"
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/x86.h"
 
 #include <math.h>
 
@@ -32,6 +35,15 @@ typedef struct {
 } relu_private_t;
 
 rt_function_error_t exec_relu_generic(rt_function_t *f);
+#ifdef CONFIG_RELU_GENERIC
+static rt_function_error_t exec_relu_fixed(rt_function_t *f);
+#endif
+#if defined(CONFIG_RELU_FLOAT32) && defined(NNABLART_NEON)
+static rt_function_error_t exec_relu_neon(rt_function_t *f);
+#endif
+#if defined(CONFIG_RELU_FLOAT32) && defined(NNABLART_X86_DISPATCH)
+static rt_function_error_t exec_relu_avx2(rt_function_t *f);
+#endif
 
 // Relu
 rt_function_error_t allocate_relu_local_context(rt_function_t *f) {
@@ -63,11 +75,24 @@ rt_function_error_t allocate_relu_local_context(rt_function_t *f) {
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_RELU_FLOAT32
+#ifdef NNABLART_NEON
+    f->exec_func = exec_relu_neon;
+#else
     f->exec_func = exec_relu;
+#endif /* NNABLART_NEON */
+#ifdef NNABLART_X86_DISPATCH
+    if (x86_cpu_features() & X86_FEATURE_AVX2) {
+      f->exec_func = exec_relu_avx2;
+    }
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_RELU_FLOAT32 */
   } else {
 #ifdef CONFIG_RELU_GENERIC
-    f->exec_func = exec_relu_generic;
+    if (is_fixed_point(p->input) && is_fixed_point(p->output)) {
+      f->exec_func = exec_relu_fixed;
+    } else {
+      f->exec_func = exec_relu_generic;
+    }
 #endif /* CONFIG_RELU_GENERIC */
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -91,6 +116,28 @@ rt_function_error_t exec_relu(rt_function_t *f) {
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
+
+#ifdef NNABLART_NEON
+static rt_function_error_t exec_relu_neon(rt_function_t *f) {
+  relu_local_context_t *context = (relu_local_context_t *)(f->local_context);
+  relu_private_t *p = (relu_private_t *)(context->data);
+
+  neon_relu((const float *)(p->input->data), (float *)(p->output->data),
+            p->output_size);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* NNABLART_NEON */
+
+#ifdef NNABLART_X86_DISPATCH
+static rt_function_error_t exec_relu_avx2(rt_function_t *f) {
+  relu_local_context_t *context = (relu_local_context_t *)(f->local_context);
+  relu_private_t *p = (relu_private_t *)(context->data);
+
+  avx2_relu((const float *)(p->input->data), (float *)(p->output->data),
+            p->output_size);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_RELU_FLOAT32 */
 
 #ifdef CONFIG_RELU_GENERIC
@@ -98,10 +145,18 @@ rt_function_error_t exec_relu_generic(rt_function_t *f) {
   relu_local_context_t *context = (relu_local_context_t *)(f->local_context);
   relu_private_t *p = (relu_private_t *)(context->data);
 
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, (x > 0.0f) ? x : 0.0f);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static rt_function_error_t exec_relu_fixed(rt_function_t *f) {
+  relu_local_context_t *context = (relu_local_context_t *)(f->local_context);
+  relu_private_t *p = (relu_private_t *)(context->data);
   int i; // Iterator
+
   for (i = 0; i < p->output_size; i++) {
-    float x = p->get_input(p->input, i);
-    p->set_output(p->output, i, ((x > 0.0f) ? x : 0.0f));
+    int32_t x = get_fixed(p->input, i);
+    set_fixed(p->output, i, x > 0 ? x : 0, p->input->fp_pos);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
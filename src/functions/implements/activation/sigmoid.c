@@ -17,6 +17,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <assert.h>
 #include <math.h>
 
@@ -32,6 +33,9 @@ typedef struct {
 } sigmoid_local_context_t;
 
 rt_function_error_t exec_sigmoid_generic(rt_function_t *f);
+#ifdef CONFIG_SIGMOID_FLOAT32
+static rt_function_error_t exec_sigmoid_fast(rt_function_t *f);
+#endif /* CONFIG_SIGMOID_FLOAT32 */
 
 // Sigmoid
 rt_function_error_t allocate_sigmoid_local_context(rt_function_t *f) {
@@ -63,7 +67,7 @@ rt_function_error_t allocate_sigmoid_local_context(rt_function_t *f) {
   if (f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_SIGMOID_FLOAT32
-    f->exec_func = exec_sigmoid;
+    f->exec_func = is_fast_math() ? exec_sigmoid_fast : exec_sigmoid;
 #endif /* CONFIG_SIGMOID_FLOAT32 */
   } else {
 #ifdef CONFIG_SIGMOID_GENERIC
@@ -81,13 +85,17 @@ rt_function_error_t free_sigmoid_local_context(rt_function_t *f) {
 #ifdef CONFIG_SIGMOID_FLOAT32
 rt_function_error_t exec_sigmoid(rt_function_t *f) {
   sigmoid_local_context_t *c = (sigmoid_local_context_t *)(f->local_context);
-  float *x = (float *)(c->input->data);
-  float *y = (float *)(c->output->data);
 
-  int i; // Iterator
-  for (i = 0; i < c->output_size; i++) {
-    y[i] = 1.0f / (1.0f + expf(-x[i]));
-  }
+  vector_sigmoid((const float *)(c->input->data), (float *)(c->output->data),
+                 c->output_size);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static rt_function_error_t exec_sigmoid_fast(rt_function_t *f) {
+  sigmoid_local_context_t *c = (sigmoid_local_context_t *)(f->local_context);
+
+  vector_sigmoid_fast((const float *)(c->input->data),
+                      (float *)(c->output->data), c->output_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SIGMOID_FLOAT32 */
@@ -96,12 +104,8 @@ rt_function_error_t exec_sigmoid(rt_function_t *f) {
 rt_function_error_t exec_sigmoid_generic(rt_function_t *f) {
   sigmoid_local_context_t *c = (sigmoid_local_context_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < c->output_size; i++) {
-    float val_x = c->get_input(c->input, i);
-    float val_y = 1.0f / (1.0f + expf(-val_x));
-    c->set_output(c->output, i, val_y);
-  }
+  FOR_EACH_BLOCK(c->input, c->output, c->output_size,
+                 1.0f / (1.0f + expf(-x)));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SIGMOID_GENERIC */
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
 
@@ -80,13 +81,9 @@ rt_function_error_t free_swish_local_context(rt_function_t *f) {
 #ifdef CONFIG_SWISH_FLOAT32
 rt_function_error_t exec_swish(rt_function_t *f) {
   swish_local_context_t *c = (swish_local_context_t *)(f->local_context);
-  float *x = (float *)(c->input->data);
-  float *y = (float *)(c->output->data);
 
-  int i; // Iterator
-  for (i = 0; i < c->output_size; i++) {
-    y[i] = x[i] * (1.0f / (1.0f + expf(-x[i])));
-  }
+  vector_swish((const float *)(c->input->data), (float *)(c->output->data),
+               c->output_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SWISH_FLOAT32 */
@@ -95,12 +92,8 @@ rt_function_error_t exec_swish(rt_function_t *f) {
 rt_function_error_t exec_swish_generic(rt_function_t *f) {
   swish_local_context_t *c = (swish_local_context_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < c->output_size; i++) {
-    float x = c->get_input(c->input, i);
-    float y = x * (1.0f / (1.0f + expf(-x)));
-    c->set_output(c->output, i, y);
-  }
+  FOR_EACH_BLOCK(c->input, c->output, c->output_size,
+                 x * (1.0f / (1.0f + expf(-x))));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SWISH_GENERIC */
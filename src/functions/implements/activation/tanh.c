@@ -17,6 +17,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <assert.h>
 #include <math.h>
 
@@ -32,6 +33,9 @@ typedef struct {
 } tanh_local_context_t;
 
 rt_function_error_t exec_tanh_generic(rt_function_t *f);
+#ifdef CONFIG_TANH_FLOAT32
+static rt_function_error_t exec_tanh_fast(rt_function_t *f);
+#endif /* CONFIG_TANH_FLOAT32 */
 
 // Tanh
 rt_function_error_t allocate_tanh_local_context(rt_function_t *f) {
@@ -58,7 +62,7 @@ rt_function_error_t allocate_tanh_local_context(rt_function_t *f) {
   if (c->input->type == NN_DATA_TYPE_FLOAT &&
       c->output->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_TANH_FLOAT32
-    f->exec_func = exec_tanh;
+    f->exec_func = is_fast_math() ? exec_tanh_fast : exec_tanh;
 #endif /* CONFIG_TANH_FLOAT32 */
   } else {
 #ifdef CONFIG_TANH_GENERIC
@@ -75,13 +79,17 @@ rt_function_error_t free_tanh_local_context(rt_function_t *f) {
 #ifdef CONFIG_TANH_FLOAT32
 rt_function_error_t exec_tanh(rt_function_t *f) {
   tanh_local_context_t *c = (tanh_local_context_t *)(f->local_context);
-  float *x = (float *)(c->input->data);
-  float *y = (float *)(c->output->data);
 
-  int i; // Iterator
-  for (i = 0; i < c->input_size; i++) {
-    y[i] = tanhf(x[i]);
-  }
+  vector_tanh((const float *)(c->input->data), (float *)(c->output->data),
+              c->input_size);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static rt_function_error_t exec_tanh_fast(rt_function_t *f) {
+  tanh_local_context_t *c = (tanh_local_context_t *)(f->local_context);
+
+  vector_tanh_fast((const float *)(c->input->data),
+                   (float *)(c->output->data), c->input_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_TANH_FLOAT32 */
@@ -90,11 +98,7 @@ rt_function_error_t exec_tanh(rt_function_t *f) {
 rt_function_error_t exec_tanh_generic(rt_function_t *f) {
   tanh_local_context_t *c = (tanh_local_context_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < c->input_size; i++) {
-    float x = c->get_input(c->input, i);
-    c->set_output(c->output, i, tanhf(x));
-  }
+  FOR_EACH_BLOCK(c->input, c->output, c->input_size, tanhf(x));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_TANH_GENERIC */
@@ -11,7 +11,10 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include "../../utilities/fixed.h"
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/x86.h"
 #include "arithmetic.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -19,9 +22,19 @@
 #ifdef CONFIG_ADD2
 
 rt_function_error_t exec_add2_generic(rt_function_t *f);
+#ifdef CONFIG_ADD2_GENERIC
+static rt_function_error_t exec_add2_fixed(rt_function_t *f);
+#endif
+#if defined(CONFIG_ADD2_FLOAT32) && defined(NNABLART_NEON)
+static rt_function_error_t exec_add2_neon(rt_function_t *f);
+#endif
+#if defined(CONFIG_ADD2_FLOAT32) && defined(NNABLART_X86_DISPATCH)
+static rt_function_error_t exec_add2_avx2(rt_function_t *f);
+#endif
 
 // Add2
 rt_function_error_t allocate_add2_local_context(rt_function_t *f) {
+  ((add2_local_context_t *)(f->local_context))->data = 0;
   if (f->num_of_inputs != 2) {
     return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
   }
@@ -39,11 +52,32 @@ rt_function_error_t allocate_add2_local_context(rt_function_t *f) {
       f->inputs[1]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_ADD2_FLOAT32
+    rt_function_error_t ret = allocate_arithmetic_broadcast(
+        f, &((add2_local_context_t *)(f->local_context))->data);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
     f->exec_func = exec_add2;
+#ifdef NNABLART_NEON
+    if (is_elementwise_arithmetic(f)) {
+      f->exec_func = exec_add2_neon;
+    }
+#endif /* NNABLART_NEON */
+#ifdef NNABLART_X86_DISPATCH
+    if (is_elementwise_arithmetic(f) &&
+        (x86_cpu_features() & X86_FEATURE_AVX2)) {
+      f->exec_func = exec_add2_avx2;
+    }
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_ADD2_FLOAT32 */
   } else {
 #ifdef CONFIG_ADD2_GENERIC
-    f->exec_func = exec_add2_generic;
+    if (is_fixed_point(f->inputs[0]) && is_fixed_point(f->inputs[1]) &&
+        is_fixed_point(f->outputs[0]) && is_elementwise_arithmetic(f)) {
+      f->exec_func = exec_add2_fixed;
+    } else {
+      f->exec_func = exec_add2_generic;
+    }
 #endif /* CONFIG_ADD2_GENERIC */
   }
 
@@ -51,14 +85,38 @@ rt_function_error_t allocate_add2_local_context(rt_function_t *f) {
 }
 
 rt_function_error_t free_add2_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  add2_local_context_t *context = (add2_local_context_t *)(f->local_context);
+  if (context->data) {
+    rt_free_func(context->data);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
 }
 
 #ifdef CONFIG_ADD2_FLOAT32
 rt_function_error_t exec_add2(rt_function_t *f) {
-  calc_arithmetic(f, calc_add);
+  calc_arithmetic_broadcast(
+      f, ((add2_local_context_t *)(f->local_context))->data, ARITHMETIC_ADD);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef NNABLART_NEON
+static rt_function_error_t exec_add2_neon(rt_function_t *f) {
+  neon_add((const float *)(f->inputs[0]->data),
+           (const float *)(f->inputs[1]->data), (float *)(f->outputs[0]->data),
+           calc_shape_size(f->outputs[0]->shape));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* NNABLART_NEON */
+
+#ifdef NNABLART_X86_DISPATCH
+static rt_function_error_t exec_add2_avx2(rt_function_t *f) {
+  avx2_add((const float *)(f->inputs[0]->data),
+           (const float *)(f->inputs[1]->data), (float *)(f->outputs[0]->data),
+           calc_shape_size(f->outputs[0]->shape));
   return RT_FUNCTION_ERROR_NOERROR;
 }
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_ADD_FLOAT32 */
 
 #ifdef CONFIG_ADD2_GENERIC
@@ -66,6 +124,25 @@ rt_function_error_t exec_add2_generic(rt_function_t *f) {
   calc_arithmetic_generic(f, calc_add);
   return RT_FUNCTION_ERROR_NOERROR;
 }
+
+// Inputs are aligned to the larger fixed point position of them, so that
+// their sum is exact before it is stored.
+static rt_function_error_t exec_add2_fixed(rt_function_t *f) {
+  rt_variable_t *x0 = f->inputs[0];
+  rt_variable_t *x1 = f->inputs[1];
+  int fp_pos = x0->fp_pos > x1->fp_pos ? x0->fp_pos : x1->fp_pos;
+  int shift0 = fp_pos - x0->fp_pos;
+  int shift1 = fp_pos - x1->fp_pos;
+  int size = calc_shape_size(f->outputs[0]->shape);
+  int i; // Iterator
+
+  for (i = 0; i < size; i++) {
+    int64_t sum = get_fixed(x0, i) * ((int64_t)1 << shift0) +
+                  get_fixed(x1, i) * ((int64_t)1 << shift1);
+    set_fixed(f->outputs[0], i, sum, fp_pos);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
 #endif /* CONFIG_ADD2_GENERIC */
 
 #endif /* CONFIG_ADD2 */
@@ -13,9 +13,42 @@
 // limitations under the License.
 
 #include "arithmetic.h"
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
 #include <math.h>
 
+#if defined(__SSE__) || defined(_M_X64) ||                                     \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ARITHMETIC_SIMD
+typedef __m128 vector_t;
+#define VECTOR_LOAD(p) _mm_loadu_ps(p)
+#define VECTOR_STORE(p, v) _mm_storeu_ps(p, v)
+#define VECTOR_SET(x) _mm_set1_ps(x)
+#define VECTOR_ADD(a, b) _mm_add_ps(a, b)
+#define VECTOR_SUB(a, b) _mm_sub_ps(a, b)
+#define VECTOR_MUL(a, b) _mm_mul_ps(a, b)
+#define VECTOR_DIV(a, b) _mm_div_ps(a, b)
+#define VECTOR_MAX(a, b) _mm_max_ps(a, b)
+#define VECTOR_MIN(a, b) _mm_min_ps(a, b)
+#elif defined(NNABLART_NEON)
+#define ARITHMETIC_SIMD
+typedef float32x4_t vector_t;
+#define VECTOR_LOAD(p) vld1q_f32(p)
+#define VECTOR_STORE(p, v) vst1q_f32(p, v)
+#define VECTOR_SET(x) vdupq_n_f32(x)
+#define VECTOR_ADD(a, b) vaddq_f32(a, b)
+#define VECTOR_SUB(a, b) vsubq_f32(a, b)
+#define VECTOR_MUL(a, b) vmulq_f32(a, b)
+#if defined(__aarch64__)
+#define VECTOR_DIV(a, b) vdivq_f32(a, b)
+#endif
+#define VECTOR_MAX(a, b) vmaxq_f32(a, b)
+#define VECTOR_MIN(a, b) vminq_f32(a, b)
+#endif
+
+#define VECTOR_LANES (4)
+
 // Common algorithm for arithmetic calculation between two vectors has same
 // dimension.
 void calc_dim_arithmetic(rt_variable_t *output, rt_variable_t *input1,
@@ -50,6 +83,235 @@ void calc_arithmetic(rt_function_t *f, float (*calc_func)(float, float)) {
                       calc_func);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Broadcast engine.
+//
+// Output dimensions of size 1 are dropped, and adjacent dimensions where each
+// input is either broadcast in both or in neither are collapsed into one, so
+// element wise calculation has single dimension, and broadcast of bias like
+// (N, C, H, W) + (1, C, 1, 1) has 3. Input tiled like Tile is broadcast in
+// dimension of repeats. Innermost dimension is calculated by row kernel of
+// each operation, which uses SIMD if an input is contiguous.
+
+// Row kernel, y[i] = op(x1[i * stride1], x2[i * stride2]) for i in [0, size).
+typedef void (*arithmetic_row_t)(const float *x1, int stride1, const float *x2,
+                                 int stride2, float *y, int size);
+
+#define SCALAR_ADD(a, b) ((a) + (b))
+#define SCALAR_SUB(a, b) ((a) - (b))
+#define SCALAR_MUL(a, b) ((a) * (b))
+#define SCALAR_DIV(a, b) ((a) / (b))
+#define SCALAR_POW(a, b) powf(a, b)
+#define SCALAR_MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define SCALAR_MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+#define ARITHMETIC_ROW_SCALAR_LOOP(SCALAR)                                     \
+  for (; i < size; i++) {                                                      \
+    y[i] = SCALAR(x1[i * stride1], x2[i * stride2]);                           \
+  }
+
+#define DEFINE_ARITHMETIC_ROW_SCALAR(name, SCALAR)                             \
+  static void name(const float *x1, int stride1, const float *x2,              \
+                   int stride2, float *y, int size) {                          \
+    int i = 0;                                                                 \
+    ARITHMETIC_ROW_SCALAR_LOOP(SCALAR)                                         \
+  }
+
+#ifdef ARITHMETIC_SIMD
+#define DEFINE_ARITHMETIC_ROW(name, SCALAR, VECTOR)                            \
+  static void name(const float *x1, int stride1, const float *x2,              \
+                   int stride2, float *y, int size) {                          \
+    int i = 0;                                                                 \
+    if (stride1 == 1 && stride2 == 1) {                                        \
+      for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                    \
+        VECTOR_STORE(y + i, VECTOR(VECTOR_LOAD(x1 + i), VECTOR_LOAD(x2 + i))); \
+      }                                                                        \
+    } else if (stride1 == 1) {                                                 \
+      vector_t v2 = VECTOR_SET(*x2);                                           \
+      for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                    \
+        VECTOR_STORE(y + i, VECTOR(VECTOR_LOAD(x1 + i), v2));                  \
+      }                                                                        \
+    } else if (stride2 == 1) {                                                 \
+      vector_t v1 = VECTOR_SET(*x1);                                           \
+      for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                    \
+        VECTOR_STORE(y + i, VECTOR(v1, VECTOR_LOAD(x2 + i)));                  \
+      }                                                                        \
+    }                                                                          \
+    ARITHMETIC_ROW_SCALAR_LOOP(SCALAR)                                         \
+  }
+#else
+#define DEFINE_ARITHMETIC_ROW(name, SCALAR, VECTOR)                            \
+  DEFINE_ARITHMETIC_ROW_SCALAR(name, SCALAR)
+#endif
+
+DEFINE_ARITHMETIC_ROW(row_add, SCALAR_ADD, VECTOR_ADD)
+DEFINE_ARITHMETIC_ROW(row_sub, SCALAR_SUB, VECTOR_SUB)
+DEFINE_ARITHMETIC_ROW(row_mul, SCALAR_MUL, VECTOR_MUL)
+#if !defined(ARITHMETIC_SIMD) || defined(VECTOR_DIV)
+DEFINE_ARITHMETIC_ROW(row_div, SCALAR_DIV, VECTOR_DIV)
+#else
+DEFINE_ARITHMETIC_ROW_SCALAR(row_div, SCALAR_DIV)
+#endif
+DEFINE_ARITHMETIC_ROW_SCALAR(row_pow, SCALAR_POW)
+DEFINE_ARITHMETIC_ROW(row_max, SCALAR_MAX, VECTOR_MAX)
+DEFINE_ARITHMETIC_ROW(row_min, SCALAR_MIN, VECTOR_MIN)
+
+// Indexed by arithmetic_op_t.
+static const arithmetic_row_t arithmetic_rows[] = {
+    row_add, row_sub, row_mul, row_div, row_pow, row_max, row_min};
+static float (*const arithmetic_funcs[])(float, float) = {
+    calc_add, calc_sub, calc_mul, calc_div, calc_pow, select_max, select_min};
+
+// Size of one repeat of input in output dimension of size out, which is
+// out if not repeated, or 0 if input size does not divide out.
+static int get_repeated_size(int in, int out) {
+  return in == 1 ? out : out % in == 0 ? in : 0;
+}
+
+// Append dimension of size, collapsing it into the last one if each input is
+// broadcast in both or in neither. stride1 and stride2 keep whether input is
+// broadcast until strides are calculated.
+static void append_broadcast_dim(arithmetic_broadcast_t *b, int *num_of_dims,
+                                 int size, int broadcast1, int broadcast2) {
+  const int last = *num_of_dims - 1;
+  if (size == 1) {
+    return;
+  }
+  if (last >= 0 && b->stride1[last] == broadcast1 &&
+      b->stride2[last] == broadcast2) {
+    b->shape[last] *= size;
+    return;
+  }
+  b->shape[last + 1] = size;
+  b->stride1[last + 1] = broadcast1;
+  b->stride2[last + 1] = broadcast2;
+  (*num_of_dims)++;
+}
+
+rt_function_error_t allocate_arithmetic_broadcast(rt_function_t *f,
+                                                  void **broadcast) {
+  rt_list_t out = f->outputs[0]->shape;
+  rt_list_t in1 = f->inputs[0]->shape;
+  rt_list_t in2 = f->inputs[1]->shape;
+  int num_of_dims = 0;
+  int d; // Iterator
+
+  *broadcast = 0;
+  if (in1.size != out.size || in2.size != out.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (d = 0; d < out.size; d++) {
+    // Inputs tiled by sizes which do not divide output, or two inputs tiled
+    // by different sizes, are left to calc_arithmetic().
+    int repeated1 = get_repeated_size(in1.data[d], out.data[d]);
+    int repeated2 = get_repeated_size(in2.data[d], out.data[d]);
+    if (repeated1 == 0 || repeated2 == 0 ||
+        (repeated1 != out.data[d] && repeated2 != out.data[d] &&
+         repeated1 != repeated2)) {
+      return RT_FUNCTION_ERROR_NOERROR;
+    }
+  }
+
+  arithmetic_broadcast_t *b = rt_malloc_func(
+      sizeof(arithmetic_broadcast_t) + sizeof(int) * 8 * (out.size + 1));
+  if (b == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  b->shape = (int *)(b + 1);
+  b->stride_y = b->shape + 2 * (out.size + 1);
+  b->stride1 = b->stride_y + 2 * (out.size + 1);
+  b->stride2 = b->stride1 + 2 * (out.size + 1);
+
+  // Dimension where input is tiled is split into repeats and size of input,
+  // and the input is broadcast in repeats like Tile of stride 0.
+  for (d = 0; d < out.size; d++) {
+    int repeated1 = get_repeated_size(in1.data[d], out.data[d]);
+    int repeated2 = get_repeated_size(in2.data[d], out.data[d]);
+    int tile = repeated1 != out.data[d] ? repeated1 : repeated2;
+    if (tile != out.data[d]) {
+      append_broadcast_dim(b, &num_of_dims, out.data[d] / tile,
+                           in1.data[d] != out.data[d],
+                           in2.data[d] != out.data[d]);
+      append_broadcast_dim(b, &num_of_dims, tile, in1.data[d] == 1,
+                           in2.data[d] == 1);
+    } else {
+      append_broadcast_dim(b, &num_of_dims, out.data[d],
+                           in1.data[d] != out.data[d],
+                           in2.data[d] != out.data[d]);
+    }
+  }
+  if (num_of_dims == 0) {
+    b->shape[0] = 1;
+    b->stride1[0] = 0;
+    b->stride2[0] = 0;
+    num_of_dims = 1;
+  }
+  b->num_of_dims = num_of_dims;
+
+  int size_y = 1;
+  int size1 = 1;
+  int size2 = 1;
+  for (d = num_of_dims - 1; d >= 0; d--) {
+    b->stride_y[d] = size_y;
+    size_y *= b->shape[d];
+    if (b->stride1[d]) {
+      b->stride1[d] = 0;
+    } else {
+      b->stride1[d] = size1;
+      size1 *= b->shape[d];
+    }
+    if (b->stride2[d]) {
+      b->stride2[d] = 0;
+    } else {
+      b->stride2[d] = size2;
+      size2 *= b->shape[d];
+    }
+  }
+
+  *broadcast = b;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static void calc_dim_broadcast(const arithmetic_broadcast_t *b, int dim,
+                               const float *x1, const float *x2, float *y,
+                               arithmetic_row_t row) {
+  int size = b->shape[dim];
+  int i; // Iterator
+  if (dim + 1 == b->num_of_dims) {
+    row(x1, b->stride1[dim], x2, b->stride2[dim], y, size);
+    return;
+  }
+  for (i = 0; i < size; i++) {
+    calc_dim_broadcast(b, dim + 1, x1 + i * b->stride1[dim],
+                       x2 + i * b->stride2[dim], y + i * b->stride_y[dim],
+                       row);
+  }
+}
+
+void calc_arithmetic_broadcast(rt_function_t *f, const void *broadcast,
+                               arithmetic_op_t op) {
+  const arithmetic_broadcast_t *b = broadcast;
+  if (b == 0) {
+    calc_arithmetic(f, arithmetic_funcs[op]);
+    return;
+  }
+  calc_dim_broadcast(b, 0, f->inputs[0]->data, f->inputs[1]->data,
+                     f->outputs[0]->data, arithmetic_rows[op]);
+}
+
+// Two inputs and output have same shape, values are calculated without
+// broadcast.
+int is_elementwise_arithmetic(rt_function_t *f) {
+  int i; // Iterator
+  for (i = 0; i < f->outputs[0]->shape.size; i++) {
+    if (f->inputs[0]->shape.data[i] != f->outputs[0]->shape.data[i] ||
+        f->inputs[1]->shape.data[i] != f->outputs[0]->shape.data[i]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
 // Common algorithm for arithmetic calculation between vector and scalar value.
 void calc_scalar(rt_function_t *f, float value,
                  float (*calc_func)(float, float)) {
@@ -17,7 +17,39 @@
 
 #include <nnablart/functions.h>
 
+/// Operations calculated by calc_arithmetic_broadcast().
+typedef enum {
+  ARITHMETIC_ADD = 0,
+  ARITHMETIC_SUB,
+  ARITHMETIC_MUL,
+  ARITHMETIC_DIV,
+  ARITHMETIC_POW,
+  ARITHMETIC_MAX,
+  ARITHMETIC_MIN,
+} arithmetic_op_t;
+
+/// Broadcast of two float inputs to output, precomputed at allocation.
+/// Dimensions are collapsed as far as broadcast allows, and strides of an
+/// input are 0 in dimensions where it is broadcast.
+typedef struct {
+  int num_of_dims; ///< Number of collapsed dimensions, at least 1.
+  int *shape;      ///< Collapsed shape of output.
+  int *stride_y;   ///< Distance between output elements in each dimension.
+  int *stride1;    ///< Distance between elements of input 1.
+  int *stride2;    ///< Distance between elements of input 2.
+} arithmetic_broadcast_t;
+
+/// Allocate arithmetic_broadcast_t for shapes of f into broadcast, which is
+/// released by rt_free_func(). Input whose size divides output is repeated
+/// like Tile. It is left NULL if size of an input does not divide output, or
+/// two inputs are tiled by different sizes, then calc_arithmetic_broadcast()
+/// uses calc_arithmetic().
+rt_function_error_t allocate_arithmetic_broadcast(rt_function_t *f,
+                                                  void **broadcast);
+void calc_arithmetic_broadcast(rt_function_t *f, const void *broadcast,
+                               arithmetic_op_t op);
 void calc_arithmetic(rt_function_t *f, float (*calc_func)(float, float));
+int is_elementwise_arithmetic(rt_function_t *f);
 void calc_arithmetic_generic(rt_function_t *f,
                              float (*calc_func)(float, float));
 void calc_scalar(rt_function_t *f, float value,
@@ -48,6 +48,24 @@ void calc_dim_arithmetic_generic(rt_variable_t *output, rt_variable_t *input1,
 // Common algorithm for arithmetic calculation between two vectors.
 void calc_arithmetic_generic(rt_function_t *f,
                              float (*calc_func)(float, float)) {
+  if (is_elementwise_arithmetic(f)) {
+    int out_size = calc_shape_size(f->outputs[0]->shape);
+    float x1[ACCESSOR_BLOCK_SIZE], x2[ACCESSOR_BLOCK_SIZE];
+    int i, k; // Iterator
+    for (i = 0; i < out_size; i += ACCESSOR_BLOCK_SIZE) {
+      int n = out_size - i;
+      if (n > ACCESSOR_BLOCK_SIZE) {
+        n = ACCESSOR_BLOCK_SIZE;
+      }
+      get_variable_block(f->inputs[0], i, n, x1);
+      get_variable_block(f->inputs[1], i, n, x2);
+      for (k = 0; k < n; k++) {
+        x1[k] = calc_func(x1[k], x2[k]);
+      }
+      set_variable_block(f->outputs[0], i, n, x1);
+    }
+    return;
+  }
   calc_dim_arithmetic_generic(f->outputs[0], f->inputs[0], f->inputs[1], 0, 0,
                               0, 0, calc_func);
 }
@@ -56,14 +74,6 @@ void calc_arithmetic_generic(rt_function_t *f,
 void calc_scalar_generic(rt_function_t *f, float value,
                          float (*calc_func)(float, float)) {
   int out_size = calc_shape_size(f->outputs[0]->shape);
-  rt_variable_t *input = f->inputs[0];
-  rt_variable_getter get_input = select_getter(input);
-  rt_variable_t *output = f->outputs[0];
-  rt_variable_setter set_output = select_setter(output);
 
-  int i; // Iterator
-  for (i = 0; i < out_size; i++) {
-    float x = get_input(input, i);
-    set_output(output, i, calc_func(x, value));
-  }
+  FOR_EACH_BLOCK(f->inputs[0], f->outputs[0], out_size, calc_func(x, value));
 }
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/x86.h"
 #include "arithmetic.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -20,6 +22,12 @@
 #ifdef CONFIG_MUL2
 
 rt_function_error_t exec_mul2_generic(rt_function_t *f);
+#if defined(CONFIG_MUL2_FLOAT32) && defined(NNABLART_NEON)
+static rt_function_error_t exec_mul2_neon(rt_function_t *f);
+#endif
+#if defined(CONFIG_MUL2_FLOAT32) && defined(NNABLART_X86_DISPATCH)
+static rt_function_error_t exec_mul2_avx2(rt_function_t *f);
+#endif
 
 // Mul2
 rt_function_error_t allocate_mul2_local_context(rt_function_t *f) {
@@ -39,7 +47,23 @@ rt_function_error_t allocate_mul2_local_context(rt_function_t *f) {
       f->inputs[1]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_MUL2_FLOAT32
+    rt_function_error_t ret =
+        allocate_arithmetic_broadcast(f, &f->local_context);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
     f->exec_func = exec_mul2;
+#ifdef NNABLART_NEON
+    if (is_elementwise_arithmetic(f)) {
+      f->exec_func = exec_mul2_neon;
+    }
+#endif /* NNABLART_NEON */
+#ifdef NNABLART_X86_DISPATCH
+    if (is_elementwise_arithmetic(f) &&
+        (x86_cpu_features() & X86_FEATURE_AVX2)) {
+      f->exec_func = exec_mul2_avx2;
+    }
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_MUL2_FLOAT32 */
   } else {
 #ifdef CONFIG_MUL2_GENERIC
@@ -55,9 +79,27 @@ rt_function_error_t free_mul2_local_context(rt_function_t *f) {
 
 #ifdef CONFIG_MUL2_FLOAT32
 rt_function_error_t exec_mul2(rt_function_t *f) {
-  calc_arithmetic(f, calc_mul);
+  calc_arithmetic_broadcast(f, f->local_context, ARITHMETIC_MUL);
   return RT_FUNCTION_ERROR_NOERROR;
 }
+
+#ifdef NNABLART_NEON
+static rt_function_error_t exec_mul2_neon(rt_function_t *f) {
+  neon_mul((const float *)(f->inputs[0]->data),
+           (const float *)(f->inputs[1]->data), (float *)(f->outputs[0]->data),
+           calc_shape_size(f->outputs[0]->shape));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* NNABLART_NEON */
+
+#ifdef NNABLART_X86_DISPATCH
+static rt_function_error_t exec_mul2_avx2(rt_function_t *f) {
+  avx2_mul((const float *)(f->inputs[0]->data),
+           (const float *)(f->inputs[1]->data), (float *)(f->outputs[0]->data),
+           calc_shape_size(f->outputs[0]->shape));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* NNABLART_X86_DISPATCH */
 #endif /* CONFIG_MUL2_FLOAT32 */
 
 #ifdef CONFIG_MUL2_GENERIC
@@ -39,6 +39,11 @@ rt_function_error_t allocate_sub2_local_context(rt_function_t *f) {
       f->inputs[1]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_SUB2_FLOAT32
+    rt_function_error_t ret =
+        allocate_arithmetic_broadcast(f, &f->local_context);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
     f->exec_func = exec_sub2;
 #endif /* CONFIG_SUB2_FLOAT32 */
   } else {
@@ -55,7 +60,7 @@ rt_function_error_t free_sub2_local_context(rt_function_t *f) {
 
 #ifdef CONFIG_SUB2_FLOAT32
 rt_function_error_t exec_sub2(rt_function_t *f) {
-  calc_arithmetic(f, calc_sub);
+  calc_arithmetic_broadcast(f, f->local_context, ARITHMETIC_SUB);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SUB2_FLOAT32 */
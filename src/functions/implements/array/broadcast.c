@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/repeat.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_BROADCAST
+
+rt_function_error_t exec_broadcast_generic(rt_function_t *f);
+
+// Broadcast
+rt_function_error_t allocate_broadcast_local_context(rt_function_t *f) {
+  broadcast_local_context_t *context =
+      (broadcast_local_context_t *)(f->local_context);
+  int i; // Iterator
+
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *y = f->outputs[0];
+  if (x->shape.size != context->shape.size ||
+      y->shape.size != context->shape.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < context->shape.size; i++) {
+    if (y->shape.data[i] != context->shape.data[i] ||
+        (x->shape.data[i] != 1 && x->shape.data[i] != y->shape.data[i])) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+
+  const int is_float =
+      x->type == NN_DATA_TYPE_FLOAT && y->type == NN_DATA_TYPE_FLOAT;
+  repeat_param_t *p = rt_malloc_func(sizeof(repeat_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  rt_function_error_t ret =
+      allocate_repeat_param(x->shape, 0, y->shape, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    rt_free_func(p);
+    return ret;
+  }
+  if (is_float) {
+#ifdef CONFIG_BROADCAST_FLOAT32
+    f->exec_func = exec_broadcast;
+#endif /* CONFIG_BROADCAST_FLOAT32 */
+  } else {
+#ifdef CONFIG_BROADCAST_GENERIC
+    f->exec_func = exec_broadcast_generic;
+#endif /* CONFIG_BROADCAST_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_broadcast_local_context(rt_function_t *f) {
+  broadcast_local_context_t *context =
+      (broadcast_local_context_t *)(f->local_context);
+  if (context->data) {
+    free_repeat_param((repeat_param_t *)(context->data));
+    rt_free_func(context->data);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_BROADCAST_FLOAT32
+rt_function_error_t exec_broadcast(rt_function_t *f) {
+  calc_repeat(
+      (repeat_param_t *)(((broadcast_local_context_t *)(f->local_context))
+                             ->data),
+      (const float *)(f->inputs[0]->data), (float *)(f->outputs[0]->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_BROADCAST_FLOAT32 */
+
+#ifdef CONFIG_BROADCAST_GENERIC
+rt_function_error_t exec_broadcast_generic(rt_function_t *f) {
+  calc_repeat_generic(
+      (repeat_param_t *)(((broadcast_local_context_t *)(f->local_context))
+                             ->data),
+      f->inputs[0], f->outputs[0]);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_BROADCAST_GENERIC */
+
+#endif /* CONFIG_BROADCAST */
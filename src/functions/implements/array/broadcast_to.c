@@ -0,0 +1,113 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/repeat.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_BROADCASTTO
+
+rt_function_error_t exec_broadcast_to_generic(rt_function_t *f);
+
+// BroadcastTo, y is broadcast to shape of x. Axes of y are axes of x from
+// axis, or the last axes of x if axis is negative.
+rt_function_error_t allocate_broadcast_to_local_context(rt_function_t *f) {
+  broadcast_to_local_context_t *context =
+      (broadcast_to_local_context_t *)(f->local_context);
+  int i; // Iterator
+
+  context->data = 0;
+  if (f->num_of_inputs != 2) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *y = f->inputs[1];
+  rt_variable_t *z = f->outputs[0];
+  const int axis =
+      context->axis < 0 ? x->shape.size - y->shape.size : context->axis;
+  if (z->shape.size != x->shape.size || axis < 0 ||
+      axis + y->shape.size > x->shape.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < x->shape.size; i++) {
+    if (z->shape.data[i] != x->shape.data[i]) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+  for (i = 0; i < y->shape.size; i++) {
+    if (y->shape.data[i] != 1 && y->shape.data[i] != x->shape.data[axis + i]) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+
+  const int is_float =
+      y->type == NN_DATA_TYPE_FLOAT && z->type == NN_DATA_TYPE_FLOAT;
+  repeat_param_t *p = rt_malloc_func(sizeof(repeat_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  rt_function_error_t ret =
+      allocate_repeat_param(y->shape, axis, z->shape, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    rt_free_func(p);
+    return ret;
+  }
+  if (is_float) {
+#ifdef CONFIG_BROADCASTTO_FLOAT32
+    f->exec_func = exec_broadcast_to;
+#endif /* CONFIG_BROADCASTTO_FLOAT32 */
+  } else {
+#ifdef CONFIG_BROADCASTTO_GENERIC
+    f->exec_func = exec_broadcast_to_generic;
+#endif /* CONFIG_BROADCASTTO_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_broadcast_to_local_context(rt_function_t *f) {
+  broadcast_to_local_context_t *context =
+      (broadcast_to_local_context_t *)(f->local_context);
+  if (context->data) {
+    free_repeat_param((repeat_param_t *)(context->data));
+    rt_free_func(context->data);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_BROADCASTTO_FLOAT32
+rt_function_error_t exec_broadcast_to(rt_function_t *f) {
+  calc_repeat(
+      (repeat_param_t *)(((broadcast_to_local_context_t *)(f->local_context))
+                             ->data),
+      (const float *)(f->inputs[1]->data), (float *)(f->outputs[0]->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_BROADCASTTO_FLOAT32 */
+
+#ifdef CONFIG_BROADCASTTO_GENERIC
+rt_function_error_t exec_broadcast_to_generic(rt_function_t *f) {
+  calc_repeat_generic(
+      (repeat_param_t *)(((broadcast_to_local_context_t *)(f->local_context))
+                             ->data),
+      f->inputs[1], f->outputs[0]);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_BROADCASTTO_GENERIC */
+
+#endif /* CONFIG_BROADCASTTO */
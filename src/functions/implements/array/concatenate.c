@@ -15,6 +15,7 @@
 #include "../../utilities/shape.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
+#include <string.h>
 
 #ifdef CONFIG_CONCATENATE
 
@@ -63,8 +64,14 @@ rt_function_error_t allocate_concatenate_local_context(rt_function_t *f) {
   p->inner_total_size = 0;
   p->in_shape =
       (rt_list_t *)rt_malloc_func(sizeof(rt_list_t) * f->num_of_inputs);
+  if (p->in_shape == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   for (int i = 0; i < f->num_of_inputs; i++) {
     p->in_shape[i] = clone_list(f->inputs[i]->shape);
+    if (p->in_shape[i].data == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     const int inner_size = calc_size(p->in_shape[i], c->axis);
     p->inner_total_size += inner_size;
 
@@ -102,9 +109,11 @@ rt_function_error_t exec_concatenate(rt_function_t *f) {
   for (int i = 0; i < f->num_of_inputs; i++) {
     const float *x = (float *)(f->inputs[i]->data);
     const int inner_size = calc_size(f->inputs[i]->shape, c->axis);
-    for (int j = 0; j < p->outer_size; ++j) {
-      for (int k = 0; k < inner_size; k++) {
-        y[j * p->inner_total_size + inner_offset + k] = x[j * inner_size + k];
+    // Buffer planning may place input at its position inside output.
+    if (p->outer_size != 1 || x != y + inner_offset) {
+      for (int j = 0; j < p->outer_size; ++j) {
+        memcpy(y + j * p->inner_total_size + inner_offset, x + j * inner_size,
+               sizeof(float) * inner_size);
       }
     }
     inner_offset += inner_size;
@@ -119,18 +128,24 @@ rt_function_error_t exec_concatenate_generic(rt_function_t *f) {
       (concatenate_local_context_t *)(f->local_context);
   concatenate_private_t *p = (concatenate_private_t *)(c->data);
   rt_variable_t *output = f->outputs[0];
-  rt_variable_setter set_output = select_setter(output);
 
   int inner_offset = 0;
   for (int i = 0; i < f->num_of_inputs; i++) {
     rt_variable_t *input = f->inputs[i];
-    rt_variable_getter get_input = select_getter(input);
-    const int inner_size = calc_size(p->in_shape[i], c->axis);
+    const int inner_size = calc_size(input->shape, c->axis);
+    // Buffer planning places input with same type inside output only when
+    // outer_size is 1, at the byte offset of its first element.
+    if (p->outer_size == 1 && input->type == output->type &&
+        get_element_size(output->type) > 0 &&
+        (const uint8_t *)input->data ==
+            (const uint8_t *)output->data +
+                (size_t)inner_offset * get_element_size(output->type)) {
+      inner_offset += inner_size;
+      continue;
+    }
     for (int j = 0; j < p->outer_size; ++j) {
-      for (int k = 0; k < inner_size; k++) {
-        const float x = get_input(input, j * inner_size + k);
-        set_output(output, j * p->inner_total_size + inner_offset + k, x);
-      }
+      copy_variable_block(input, j * inner_size, output,
+                          j * p->inner_total_size + inner_offset, inner_size);
     }
     inner_offset += inner_size;
   }
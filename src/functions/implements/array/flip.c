@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
 #include <stdint.h>
@@ -29,6 +30,9 @@ typedef struct {
   rt_list_t out_position;
   uint8_t *flip;
   int output_size;
+  int axis;      // Last flipped axis, or -1.
+  int axis_size; // Size of axis.
+  int inner;     // Size of contiguous block after axis.
 } flip_private_t;
 
 rt_function_error_t exec_flip_generic(rt_function_t *f);
@@ -53,6 +57,9 @@ rt_function_error_t allocate_flip_local_context(rt_function_t *f) {
   }
   ((flip_local_context_t *)(f->local_context))->data = (void *)p;
   p->flip = rt_malloc_func(sizeof(uint8_t) * (f->inputs[0]->shape.size));
+  if (p->flip == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   memset(p->flip, 0, sizeof(uint8_t) * (f->inputs[0]->shape.size));
   p->input = f->inputs[0];
   p->get_input = select_getter(p->input);
@@ -60,11 +67,27 @@ rt_function_error_t allocate_flip_local_context(rt_function_t *f) {
   p->set_output = select_setter(p->output);
   p->in_position = allocate_list(p->input->shape.size);
   p->out_position = allocate_list(p->output->shape.size);
+  if (p->in_position.data == 0 || p->out_position.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->output_size = calc_shape_size(p->output->shape);
 
   for (int i = 0; i < c->axes.size; i++) {
     p->flip[c->axes.data[i]] = 1;
   }
+
+  // Axes after the last flipped one are copied as contiguous blocks.
+  p->axis = -1;
+  p->axis_size = 1;
+  p->inner = p->output_size;
+  for (int i = p->input->shape.size - 1; i >= 0; i--) {
+    if (p->flip[i] && p->input->shape.data[i] > 1) {
+      p->axis = i;
+      p->axis_size = p->input->shape.data[i];
+      p->inner = shape_product_of(p->input, i + 1, p->input->shape.size);
+      break;
+    }
+  }
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
@@ -79,24 +102,44 @@ rt_function_error_t free_flip_local_context(rt_function_t *f) {
 }
 
 #ifdef CONFIG_FLIP_FLOAT32
+// Offset in input of row whose first element is output o. Flipped axes
+// before p->axis are mirrored, and p->axis and later axes start at 0.
+static int flipped_row_offset(flip_private_t *p, int o) {
+  pos_to_shape(p->out_position, p->output->shape, o);
+  for (int i = 0; i < p->input->shape.size; i++) {
+    if (i >= p->axis) {
+      p->in_position.data[i] = 0;
+    } else if (p->flip[i]) {
+      p->in_position.data[i] =
+          p->input->shape.data[i] - p->out_position.data[i] - 1;
+    } else {
+      p->in_position.data[i] = p->out_position.data[i];
+    }
+  }
+  return shape_to_pos(p->input->shape, p->in_position);
+}
+
 rt_function_error_t exec_flip(rt_function_t *f) {
   flip_local_context_t *c = (flip_local_context_t *)(f->local_context);
   flip_private_t *p = (flip_private_t *)(c->data);
   const float *x = (float *)(p->input->data);
   float *y = (float *)(p->output->data);
+  const int row_size = p->axis_size * p->inner;
 
-  for (int o = 0; o < p->output_size; o++) {
-    pos_to_shape(p->out_position, p->output->shape, o);
-    for (int i = 0; i < p->input->shape.size; i++) {
-      if (p->flip[i]) {
-        p->in_position.data[i] =
-            p->input->shape.data[i] - p->out_position.data[i] - 1;
-      } else {
-        p->in_position.data[i] = p->out_position.data[i];
-      }
+  if (p->axis < 0) {
+    memcpy(y, x, sizeof(float) * p->output_size);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  for (int o = 0; o < p->output_size; o += row_size) {
+    const float *row = x + flipped_row_offset(p, o);
+    if (p->inner == 1) {
+      vector_reverse(row, y + o, p->axis_size);
+      continue;
+    }
+    for (int j = 0; j < p->axis_size; j++) {
+      memcpy(y + o + j * p->inner, row + (p->axis_size - 1 - j) * p->inner,
+             sizeof(float) * p->inner);
     }
-    int index = shape_to_pos(p->input->shape, p->in_position);
-    y[o] = x[index];
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -63,6 +63,12 @@ rt_function_error_t allocate_pad_local_context(rt_function_t *f) {
   p->pad_width[1] = allocate_list(p->output_shape.size);
   p->output_size = calc_shape_size(p->output_shape);
   p->out_position = allocate_list(p->output_shape.size);
+  if (p->input_shape.data == 0 || p->output_shape.data == 0 ||
+      p->input_strides.data == 0 || p->output_strides.data == 0 ||
+      p->pad_width[0].data == 0 || p->pad_width[1].data == 0 ||
+      p->out_position.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   int i, j;
   for (i = 0; i < p->output_shape.size - context->pad_width.size / 2; i++) {
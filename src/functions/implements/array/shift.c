@@ -33,6 +33,10 @@ typedef struct {
   rt_variable_t *output;
   rt_variable_setter set_output;
   int output_size;
+  int axis;        // Last axis which is shifted, or -1.
+  int inner;       // Size of contiguous block after axis.
+  int num_of_runs; // Runs of one row along axis.
+  int *runs;       // Output offset, input offset and size of each run.
 } shift_private_t;
 
 #define MAX(a, b) ((a > b) ? a : b)
@@ -66,11 +70,19 @@ rt_function_error_t allocate_shift_local_context(rt_function_t *f) {
   p->output_size = calc_shape_size(p->output->shape);
 
   p->table = rt_malloc_func(sizeof(int *) * p->input_shape.size);
+  if (p->input_shape.data == 0 || p->output_shape.data == 0 ||
+      p->input_strides.data == 0 || p->out_position.data == 0 ||
+      p->table == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   for (int i = 0; i < p->input_shape.size; i++) {
     const int stride = p->input_strides.data[i];
     const int size = p->input_shape.data[i];
     p->table[i] = rt_malloc_func(size * sizeof(int));
+    if (p->table[i] == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     const int shift_index = context->shifts.size - p->input_shape.size + i;
     const int shift = shift_index >= 0 ? -context->shifts.data[shift_index] : 0;
 
@@ -85,6 +97,44 @@ rt_function_error_t allocate_shift_local_context(rt_function_t *f) {
       }
     }
   }
+
+  // Axes after the last shifted one are not moved, so they are copied as
+  // contiguous blocks. Blocks along axis whose input is next to former one
+  // are merged into a run, one row has a few runs besides border.
+  p->axis = -1;
+  p->inner = 1;
+  p->num_of_runs = 0;
+  p->runs = 0;
+  for (int i = p->input_shape.size - 1; i >= 0 && p->axis < 0; i--) {
+    for (int j = 0; j < p->input_shape.data[i]; j++) {
+      if (p->table[i][j] != j * p->input_strides.data[i]) {
+        p->axis = i;
+        break;
+      }
+    }
+  }
+  if (p->axis >= 0) {
+    const int size = p->input_shape.data[p->axis];
+    const int *table = p->table[p->axis];
+    p->inner = p->input_strides.data[p->axis];
+    p->runs = rt_malloc_func(sizeof(int) * 3 * size);
+    if (p->runs == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    for (int j = 0; j < size; j++) {
+      int *last = p->runs + (p->num_of_runs - 1) * 3;
+      if (p->num_of_runs > 0 && last[1] + last[2] == table[j]) {
+        last[2] += p->inner;
+      } else {
+        int *run = p->runs + p->num_of_runs * 3;
+        run[0] = j * p->inner;
+        run[1] = table[j];
+        run[2] = p->inner;
+        p->num_of_runs++;
+      }
+    }
+  }
+
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_SHIFT_FLOAT32
@@ -109,6 +159,9 @@ rt_function_error_t free_shift_local_context(rt_function_t *f) {
     rt_free_func(p->table[i]);
   }
   rt_free_func(p->table);
+  if (p->runs) {
+    rt_free_func(p->runs);
+  }
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -120,13 +173,21 @@ rt_function_error_t exec_shift(rt_function_t *f) {
   const float *x = (float *)(p->input->data);
   float *y = (float *)(p->output->data);
 
-  for (int o = 0; o < p->output_size; o++) {
+  if (p->axis < 0) {
+    memcpy(y, x, sizeof(float) * p->output_size);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  const int row_size = p->input_shape.data[p->axis] * p->inner;
+  for (int o = 0; o < p->output_size; o += row_size) {
     int index = 0;
     pos_to_shape(p->out_position, p->output->shape, o);
-    for (int i = 0; i < p->input_shape.size; i++) {
+    for (int i = 0; i < p->axis; i++) {
       index += p->table[i][p->out_position.data[i]];
     }
-    y[o] = x[index];
+    for (int k = 0; k < p->num_of_runs; k++) {
+      const int *run = p->runs + k * 3;
+      memcpy(y + o + run[0], x + index + run[1], sizeof(float) * run[2]);
+    }
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
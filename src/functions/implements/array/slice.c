@@ -17,6 +17,7 @@
 #include <limits.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
+#include <string.h>
 
 #ifdef CONFIG_SLICE
 
@@ -27,9 +28,10 @@ typedef struct {
   rt_variable_getter get_input;
   rt_variable_t *output;
   rt_variable_setter set_output;
-  rt_list_t in_position;
-  rt_list_t out_position;
+  rt_list_t out_position; ///< Odometer of output rows.
   int output_size;
+  rt_list_t in_strides;
+  int view_offset; ///< Offset of output in input if it is contiguous, or -1.
 } slice_private_t;
 
 rt_function_error_t exec_slice_generic(rt_function_t *f);
@@ -55,9 +57,15 @@ rt_function_error_t allocate_slice_local_context(rt_function_t *f) {
   p->set_output = select_setter(p->output);
   p->start = allocate_list(p->input->shape.size);
   p->step = allocate_list(p->input->shape.size);
-  p->in_position = allocate_list(p->input->shape.size);
   p->out_position = allocate_list(p->output->shape.size);
   p->output_size = calc_shape_size(p->output->shape);
+  p->in_strides = calc_contiguous_strides(p->input->shape);
+  if (p->start.data == 0 || p->step.data == 0 || p->out_position.data == 0 ||
+      p->in_strides.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->view_offset = calc_slice_view_offset(p->input->shape, p->output->shape,
+                                          context->start, context->step);
 
   int i, j;
   int diff = p->input->shape.size - context->start.size - 1;
@@ -95,27 +103,74 @@ rt_function_error_t free_slice_local_context(rt_function_t *f) {
       (slice_private_t *)(((slice_local_context_t *)(f->local_context))->data);
   free_list(p->start);
   free_list(p->step);
-  free_list(p->in_position);
   free_list(p->out_position);
+  free_list(p->in_strides);
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+#if defined(CONFIG_SLICE_FLOAT32) || defined(CONFIG_SLICE_GENERIC)
+// Output is a view of input placed by buffer planning.
+static int is_view(const slice_private_t *p) {
+  const size_t element_size = get_element_size(p->input->type);
+  return p->view_offset >= 0 && p->input->type == p->output->type &&
+         element_size > 0 &&
+         (const uint8_t *)p->output->data ==
+             (const uint8_t *)p->input->data + p->view_offset * element_size;
+}
+
+// Copy rows of the last axis. Input offset of each row is stepped by
+// odometer kept in out_position.
+static void copy_rows(slice_private_t *p, int is_float) {
+  const int ndim = p->output->shape.size;
+  const int row_size = ndim > 0 ? p->output->shape.data[ndim - 1] : 1;
+  const int row_stride = ndim > 0 ? p->step.data[ndim - 1] : 1;
+  int offset = 0;
+  int d; // Iterator
+
+  for (d = 0; d < ndim; d++) {
+    p->out_position.data[d] = 0;
+    offset += p->start.data[d] * p->in_strides.data[d];
+  }
+  for (int o = 0; o < p->output_size; o += row_size) {
+    if (is_float) {
+      const float *x = (const float *)(p->input->data) + offset;
+      float *y = (float *)(p->output->data) + o;
+      if (row_stride == 1) {
+        memcpy(y, x, sizeof(float) * row_size);
+      } else {
+        for (int k = 0; k < row_size; k++) {
+          y[k] = x[k * row_stride];
+        }
+      }
+    } else if (row_stride == 1) {
+      copy_variable_block(p->input, offset, p->output, o, row_size);
+    } else {
+      for (int k = 0; k < row_size; k++) {
+        float x = p->get_input(p->input, offset + k * row_stride);
+        p->set_output(p->output, o + k, x);
+      }
+    }
+    for (d = ndim - 2; d >= 0; d--) {
+      const int stride = p->step.data[d] * p->in_strides.data[d];
+      offset += stride;
+      if (++p->out_position.data[d] < p->output->shape.data[d]) {
+        break;
+      }
+      offset -= p->out_position.data[d] * stride;
+      p->out_position.data[d] = 0;
+    }
+  }
+}
+#endif /* CONFIG_SLICE_FLOAT32 || CONFIG_SLICE_GENERIC */
+
 #ifdef CONFIG_SLICE_FLOAT32
 rt_function_error_t exec_slice(rt_function_t *f) {
   slice_local_context_t *context = (slice_local_context_t *)(f->local_context);
   slice_private_t *p = (slice_private_t *)(context->data);
-  const float *x = (float *)(p->input->data);
-  float *y = (float *)(p->output->data);
-
-  for (int o = 0; o < p->output_size; o++) {
-    pos_to_shape(p->out_position, p->output->shape, o);
-    for (int i = 0; i < p->input->shape.size; i++) {
-      p->in_position.data[i] =
-          p->out_position.data[i] * p->step.data[i] + p->start.data[i];
-    }
-    int index = shape_to_pos(p->input->shape, p->in_position);
-    y[o] = x[index];
+
+  if (p->output_size > 0 && !is_view(p)) {
+    copy_rows(p, 1);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -126,15 +181,8 @@ rt_function_error_t exec_slice_generic(rt_function_t *f) {
   slice_local_context_t *context = (slice_local_context_t *)(f->local_context);
   slice_private_t *p = (slice_private_t *)(context->data);
 
-  for (int o = 0; o < p->output_size; o++) {
-    pos_to_shape(p->out_position, p->output->shape, o);
-    for (int i = 0; i < p->input->shape.size; i++) {
-      p->in_position.data[i] =
-          p->out_position.data[i] * p->step.data[i] + p->start.data[i];
-    }
-    int index = shape_to_pos(p->input->shape, p->in_position);
-    float x = p->get_input(p->input, index);
-    p->set_output(p->output, o, x);
+  if (p->output_size > 0 && !is_view(p)) {
+    copy_rows(p, 0);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -16,6 +16,7 @@
 #include "../../utilities/shape.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
+#include <string.h>
 
 #ifdef CONFIG_SPLIT
 
@@ -76,6 +77,20 @@ rt_function_error_t free_split_local_context(rt_function_t *f) {
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+#if defined(CONFIG_SPLIT_FLOAT32) || defined(CONFIG_SPLIT_GENERIC)
+// Output i is a view of input placed by buffer planning.
+static int is_view(rt_function_t *f, split_private_t *p, int i) {
+  const rt_variable_t *input = f->inputs[0];
+  const rt_variable_t *output = f->outputs[i];
+  const size_t element_size = get_element_size(input->type);
+  return p->outer_size == 1 && input->type == output->type &&
+         element_size > 0 &&
+         (const uint8_t *)output->data ==
+             (const uint8_t *)input->data +
+                 (size_t)i * p->inner_size * element_size;
+}
+#endif /* CONFIG_SPLIT_FLOAT32 || CONFIG_SPLIT_GENERIC */
+
 #ifdef CONFIG_SPLIT_FLOAT32
 rt_function_error_t exec_split(rt_function_t *f) {
   split_local_context_t *c = (split_local_context_t *)(f->local_context);
@@ -84,11 +99,13 @@ rt_function_error_t exec_split(rt_function_t *f) {
   const float *x = (float *)(f->inputs[0]->data);
   for (int i = 0; i < p->num_outputs; i++) {
     float *y = (float *)(f->outputs[i]->data);
+    if (is_view(f, p, i)) {
+      continue;
+    }
     for (int j = 0; j < p->outer_size; j++) {
-      for (int k = 0; k < p->inner_size; k++) {
-        y[j * p->inner_size + k] =
-            x[j * (p->inner_size * p->num_outputs) + i * p->inner_size + k];
-      }
+      memcpy(y + j * p->inner_size,
+             x + j * (p->inner_size * p->num_outputs) + i * p->inner_size,
+             sizeof(float) * p->inner_size);
     }
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -100,17 +117,16 @@ rt_function_error_t exec_split_generic(rt_function_t *f) {
   split_local_context_t *c = (split_local_context_t *)(f->local_context);
   split_private_t *p = (split_private_t *)(c->data);
   rt_variable_t *input = f->inputs[0];
-  rt_variable_getter get_input = select_getter(input);
 
   for (int i = 0; i < p->num_outputs; i++) {
-    rt_variable_t *output = f->outputs[i];
-    rt_variable_setter set_output = select_setter(output);
+    if (is_view(f, p, i)) {
+      continue;
+    }
     for (int j = 0; j < p->outer_size; j++) {
-      for (int k = 0; k < p->inner_size; k++) {
-        float x = get_input(input, j * (p->inner_size * p->num_outputs) +
-                                       i * p->inner_size + k);
-        set_output(output, j * p->inner_size + k, x);
-      }
+      copy_variable_block(input,
+                          j * (p->inner_size * p->num_outputs) +
+                              i * p->inner_size,
+                          f->outputs[i], j * p->inner_size, p->inner_size);
     }
   }
   return RT_FUNCTION_ERROR_NOERROR;
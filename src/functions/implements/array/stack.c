@@ -16,6 +16,7 @@
 #include "../../utilities/shape.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
+#include <string.h>
 
 #ifdef CONFIG_STACK
 
@@ -78,14 +79,13 @@ rt_function_error_t exec_stack(rt_function_t *f) {
   stack_local_context_t *c = (stack_local_context_t *)(f->local_context);
   stack_private_t *p = (stack_private_t *)(c->data);
 
+  // Output is written in order, one block of each input at a time.
   float *y = (float *)(f->outputs[0]->data);
-  for (int i = 0; i < f->num_of_inputs; i++) {
-    const float *x = (float *)(f->inputs[i]->data);
-    for (int j = 0; j < p->outer_size; j++) {
-      for (int k = 0; k < p->inner_size; k++) {
-        y[j * (p->inner_size * f->num_of_inputs) + i * p->inner_size + k] =
-            x[j * p->inner_size + k];
-      }
+  for (int j = 0; j < p->outer_size; j++) {
+    for (int i = 0; i < f->num_of_inputs; i++) {
+      const float *x = (float *)(f->inputs[i]->data);
+      memcpy(y, x + j * p->inner_size, sizeof(float) * p->inner_size);
+      y += p->inner_size;
     }
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -0,0 +1,108 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/repeat.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_TILE
+
+rt_function_error_t exec_tile_generic(rt_function_t *f);
+
+// Tile, x and reps are aligned to the last axes of output, and the other
+// axes are 1.
+rt_function_error_t allocate_tile_local_context(rt_function_t *f) {
+  tile_local_context_t *context = (tile_local_context_t *)(f->local_context);
+  int i; // Iterator
+
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *y = f->outputs[0];
+  const int ndim = x->shape.size > context->reps.size ? x->shape.size
+                                                      : context->reps.size;
+  if (y->shape.size != ndim) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < ndim; i++) {
+    const int in = i >= ndim - x->shape.size
+                       ? x->shape.data[i - (ndim - x->shape.size)]
+                       : 1;
+    const int reps = i >= ndim - context->reps.size
+                         ? context->reps.data[i - (ndim - context->reps.size)]
+                         : 1;
+    if (y->shape.data[i] != in * reps) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+
+  const int is_float =
+      x->type == NN_DATA_TYPE_FLOAT && y->type == NN_DATA_TYPE_FLOAT;
+  repeat_param_t *p = rt_malloc_func(sizeof(repeat_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  rt_function_error_t ret = allocate_repeat_param(
+      x->shape, ndim - x->shape.size, y->shape, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    rt_free_func(p);
+    return ret;
+  }
+  if (is_float) {
+#ifdef CONFIG_TILE_FLOAT32
+    f->exec_func = exec_tile;
+#endif /* CONFIG_TILE_FLOAT32 */
+  } else {
+#ifdef CONFIG_TILE_GENERIC
+    f->exec_func = exec_tile_generic;
+#endif /* CONFIG_TILE_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_tile_local_context(rt_function_t *f) {
+  tile_local_context_t *context = (tile_local_context_t *)(f->local_context);
+  if (context->data) {
+    free_repeat_param((repeat_param_t *)(context->data));
+    rt_free_func(context->data);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_TILE_FLOAT32
+rt_function_error_t exec_tile(rt_function_t *f) {
+  calc_repeat(
+      (repeat_param_t *)(((tile_local_context_t *)(f->local_context))->data),
+      (const float *)(f->inputs[0]->data), (float *)(f->outputs[0]->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_TILE_FLOAT32 */
+
+#ifdef CONFIG_TILE_GENERIC
+rt_function_error_t exec_tile_generic(rt_function_t *f) {
+  calc_repeat_generic(
+      (repeat_param_t *)(((tile_local_context_t *)(f->local_context))->data),
+      f->inputs[0], f->outputs[0]);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_TILE_GENERIC */
+
+#endif /* CONFIG_TILE */
@@ -19,16 +19,24 @@
 
 #ifdef CONFIG_TRANSPOSE
 
+#include <string.h>
+
+// Counters of odometer are kept on stack up to this number of merged axes.
+#define TRANSPOSE_MAX_NDIM (16)
+
+// Size of square tiles when contiguous input axis is moved next to last.
+#define TRANSPOSE_TILE (32)
+
 typedef struct {
   rt_variable_t *input;
   rt_variable_getter get_input;
   rt_variable_t *output;
   rt_variable_setter set_output;
   int output_size;
-  rt_list_t input_strides;
-  rt_list_t output_strides;
-  rt_list_t input_shape;
-  rt_list_t output_shape;
+  rt_list_t shape;   ///< Output shape without size 1 axes, and axes which
+                     ///< are contiguous in both input and output are merged.
+  rt_list_t strides; ///< Input stride of each axis of shape.
+  int tile; ///< Non zero if next to last axis of shape is contiguous in input.
 } transpose_private_t;
 
 rt_function_error_t exec_transpose_generic(rt_function_t *f);
@@ -41,23 +49,59 @@ rt_function_error_t allocate_transpose_local_context(rt_function_t *f) {
   if (f->num_of_outputs != 1) {
     return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
   }
+  transpose_local_context_t *c =
+      (transpose_local_context_t *)(f->local_context);
+  const rt_list_t input_shape = f->inputs[0]->shape;
+  if (c->axes.size != input_shape.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
 
   transpose_private_t *p = rt_malloc_func(sizeof(transpose_private_t));
   if (p == 0) {
     return RT_FUNCTION_ERROR_MALLOC;
   }
 
-  ((transpose_local_context_t *)(f->local_context))->data = (void *)p;
+  c->data = (void *)p;
   p->input = f->inputs[0];
   p->get_input = select_getter(p->input);
-  p->input_shape = clone_list(f->inputs[0]->shape);
-  p->input_strides = calc_contiguous_strides(f->inputs[0]->shape);
   p->output = f->outputs[0];
   p->set_output = select_setter(p->output);
-  p->output_shape = clone_list(f->outputs[0]->shape);
-  p->output_strides = calc_contiguous_strides(f->outputs[0]->shape);
   p->output_size = calc_shape_size(f->outputs[0]->shape);
 
+  // Merge output axes in order, where next axis follows in input too.
+  rt_list_t input_strides = calc_contiguous_strides(input_shape);
+  p->shape = allocate_list(input_shape.size > 0 ? input_shape.size : 1);
+  p->strides = allocate_list(input_shape.size > 0 ? input_shape.size : 1);
+  if (input_strides.data == 0 || p->shape.data == 0 || p->strides.data == 0) {
+    free_list(input_strides);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  int ndim = 0;
+  for (int d = 0; d < input_shape.size; ++d) {
+    const int size = input_shape.data[c->axes.data[d]];
+    const int stride = input_strides.data[c->axes.data[d]];
+    if (size == 1) {
+      continue;
+    }
+    if (ndim > 0 && p->strides.data[ndim - 1] == size * stride) {
+      p->shape.data[ndim - 1] *= size;
+      p->strides.data[ndim - 1] = stride;
+    } else {
+      p->shape.data[ndim] = size;
+      p->strides.data[ndim] = stride;
+      ndim++;
+    }
+  }
+  if (ndim == 0) {
+    p->shape.data[0] = 1;
+    p->strides.data[0] = 1;
+    ndim = 1;
+  }
+  p->shape.size = ndim;
+  p->strides.size = ndim;
+  free_list(input_strides);
+  p->tile = ndim >= 2 && p->strides.data[ndim - 2] == 1;
+
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_TRANSPOSE_FLOAT32
@@ -75,30 +119,133 @@ rt_function_error_t free_transpose_local_context(rt_function_t *f) {
   transpose_private_t *p =
       (transpose_private_t *)(((transpose_local_context_t *)(f->local_context))
                                   ->data);
-  free_list(p->input_shape);
-  free_list(p->output_shape);
-  free_list(p->input_strides);
-  free_list(p->output_strides);
+  free_list(p->shape);
+  free_list(p->strides);
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+// Input offset of index over first ndim axes of shape. Counter of each axis
+// is stored to index_of_axis unless it is NULL.
+static int start_offset(const transpose_private_t *p, int index, int ndim,
+                        int *index_of_axis) {
+  int offset = 0;
+  for (int d = ndim - 1; d >= 0; --d) {
+    const int k = index % p->shape.data[d];
+    index /= p->shape.data[d];
+    if (index_of_axis) {
+      index_of_axis[d] = k;
+    }
+    offset += k * p->strides.data[d];
+  }
+  return offset;
+}
+
+// Step odometer of first ndim axes to next index, and return its offset.
+static int next_offset(const transpose_private_t *p, int ndim,
+                       int *index_of_axis, int offset) {
+  for (int d = ndim - 1; d >= 0; --d) {
+    offset += p->strides.data[d];
+    if (++index_of_axis[d] < p->shape.data[d]) {
+      return offset;
+    }
+    offset -= index_of_axis[d] * p->strides.data[d];
+    index_of_axis[d] = 0;
+  }
+  return offset;
+}
+
+// Process output rows in [begin, end), each row is last axis of shape.
+static void transpose_rows(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  transpose_private_t *p =
+      (transpose_private_t *)(((transpose_local_context_t *)(f->local_context))
+                                  ->data);
+  const int outer_ndim = p->shape.size - 1;
+  const int row_size = p->shape.data[outer_ndim];
+  const int stride = p->strides.data[outer_ndim];
+  int index_of_axis[TRANSPOSE_MAX_NDIM];
+  int *const odometer = outer_ndim <= TRANSPOSE_MAX_NDIM ? index_of_axis : 0;
+  int offset = start_offset(p, begin, outer_ndim, odometer);
+
+  for (int row = begin; row < end; ++row) {
+    const int o = row * row_size;
 #ifdef CONFIG_TRANSPOSE_FLOAT32
-rt_function_error_t exec_transpose(rt_function_t *f) {
-  transpose_local_context_t *c =
-      (transpose_local_context_t *)(f->local_context);
-  transpose_private_t *p = (transpose_private_t *)(c->data);
-  float *x = (float *)p->input->data;
-  float *y = (float *)p->output->data;
-
-  for (int o = 0; o < p->output_size; ++o) {
-    int i = 0;
-    for (int d = 0; d < p->input_shape.size; ++d) {
-      const int k =
-          (int)(o / p->output_strides.data[d]) % p->output_shape.data[d];
-      i += k * p->input_strides.data[c->axes.data[d]];
+    if (p->output->type == NN_DATA_TYPE_FLOAT &&
+        p->input->type == NN_DATA_TYPE_FLOAT) {
+      const float *x = (const float *)p->input->data + offset;
+      float *y = (float *)p->output->data + o;
+      if (stride == 1) {
+        memcpy(y, x, sizeof(float) * row_size);
+      } else {
+        for (int j = 0; j < row_size; ++j) {
+          y[j] = x[j * stride];
+        }
+      }
+    } else
+#endif /* CONFIG_TRANSPOSE_FLOAT32 */
+    {
+      for (int j = 0; j < row_size; ++j) {
+        const float x = p->get_input(p->input, offset + j * stride);
+        p->set_output(p->output, o + j, x);
+      }
+    }
+    offset = odometer ? next_offset(p, outer_ndim, odometer, offset)
+                      : start_offset(p, row + 1, outer_ndim, 0);
+  }
+}
+
+#ifdef CONFIG_TRANSPOSE_FLOAT32
+// Process tiles of TRANSPOSE_TILE output rows in [begin, end). Next to last
+// axis of shape is contiguous in input, so reads and writes of a square tile
+// stay in cache.
+static void transpose_tiles(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  transpose_private_t *p =
+      (transpose_private_t *)(((transpose_local_context_t *)(f->local_context))
+                                  ->data);
+  const int outer_ndim = p->shape.size - 2;
+  const int rows = p->shape.data[outer_ndim];
+  const int cols = p->shape.data[outer_ndim + 1];
+  const int stride = p->strides.data[outer_ndim + 1];
+  const int row_tiles = (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+
+  for (int t = begin; t < end; ++t) {
+    const int outer = t / row_tiles;
+    const int r0 = (t % row_tiles) * TRANSPOSE_TILE;
+    const int r1 = r0 + TRANSPOSE_TILE < rows ? r0 + TRANSPOSE_TILE : rows;
+    const float *x = (const float *)p->input->data +
+                     start_offset(p, outer, outer_ndim, 0);
+    float *y = (float *)p->output->data + outer * rows * cols;
+    for (int c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE) {
+      const int c1 = c0 + TRANSPOSE_TILE < cols ? c0 + TRANSPOSE_TILE : cols;
+      for (int r = r0; r < r1; ++r) {
+        for (int col = c0; col < c1; ++col) {
+          y[r * cols + col] = x[r + col * stride];
+        }
+      }
     }
-    y[o] = x[i];
+  }
+}
+
+rt_function_error_t exec_transpose(rt_function_t *f) {
+  transpose_private_t *p =
+      (transpose_private_t *)(((transpose_local_context_t *)(f->local_context))
+                                  ->data);
+  const int ndim = p->shape.size;
+
+  if (p->output_size == 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (p->tile) {
+    const int rows = p->shape.data[ndim - 2];
+    const int cols = p->shape.data[ndim - 1];
+    const int row_tiles = (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+    rt_parallel_for(p->output_size / rows / cols * row_tiles,
+                    TRANSPOSE_TILE * cols, transpose_tiles, f);
+  } else {
+    const int row_size = p->shape.data[ndim - 1];
+    rt_parallel_for(p->output_size / row_size, row_size, transpose_rows, f);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -106,20 +253,17 @@ rt_function_error_t exec_transpose(rt_function_t *f) {
 
 #ifdef CONFIG_TRANSPOSE_GENERIC
 rt_function_error_t exec_transpose_generic(rt_function_t *f) {
-  transpose_local_context_t *c =
-      (transpose_local_context_t *)(f->local_context);
-  transpose_private_t *p = (transpose_private_t *)(c->data);
-
-  for (int o = 0; o < p->output_size; ++o) {
-    int i = 0;
-    for (int d = 0; d < p->input_shape.size; ++d) {
-      const int k =
-          (int)(o / p->output_strides.data[d]) % p->output_shape.data[d];
-      i += k * p->input_strides.data[c->axes.data[d]];
-    }
-    const float x = p->get_input(p->input, i);
-    p->set_output(p->output, o, x);
+  transpose_private_t *p =
+      (transpose_private_t *)(((transpose_local_context_t *)(f->local_context))
+                                  ->data);
+  const int row_size = p->shape.data[p->shape.size - 1];
+
+  if (p->output_size == 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
   }
+  // Getters and setters of packed types may share words, so rows run
+  // serially.
+  transpose_rows(f, 0, p->output_size / row_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_TRANSPOSE_GENERIC */
@@ -39,6 +39,11 @@ rt_function_error_t allocate_maximum2_local_context(rt_function_t *f) {
       f->inputs[1]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_MAXIMUM2_FLOAT32
+    rt_function_error_t ret =
+        allocate_arithmetic_broadcast(f, &f->local_context);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
     f->exec_func = exec_maximum2;
 #endif /* CONFIG_MAXIMUM2_FLOAT32 */
   } else {
@@ -55,7 +60,7 @@ rt_function_error_t free_maximum2_local_context(rt_function_t *f) {
 
 #ifdef CONFIG_MAXIMUM2_FLOAT32
 rt_function_error_t exec_maximum2(rt_function_t *f) {
-  calc_arithmetic(f, select_max);
+  calc_arithmetic_broadcast(f, f->local_context, ARITHMETIC_MAX);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_MAXIMUM2_FLOAT32 */
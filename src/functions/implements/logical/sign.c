@@ -58,18 +58,10 @@ rt_function_error_t exec_sign(rt_function_t *f) {
 #ifdef CONFIG_SIGN_GENERIC
 rt_function_error_t exec_sign_generic(rt_function_t *f) {
   sign_local_context_t *c = (sign_local_context_t *)(f->local_context);
-  rt_variable_t *input = f->inputs[0];
-  rt_variable_getter get_input = select_getter(input);
-  rt_variable_t *output = f->outputs[0];
-  rt_variable_setter set_output = select_setter(output);
-
   const int output_size = calc_shape_size(f->inputs[0]->shape);
-  int i;
-  for (i = 0; i < output_size; ++i) {
-    float x = get_input(input, i);
-    float y = (x > 0) ? 1 : ((x < 0) ? -1 : c->alpha);
-    set_output(output, i, y);
-  }
+
+  FOR_EACH_BLOCK(f->inputs[0], f->outputs[0], output_size,
+                 (x > 0) ? 1 : ((x < 0) ? -1 : c->alpha));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_SIGN_GENERIC */
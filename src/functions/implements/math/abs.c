@@ -95,11 +95,7 @@ rt_function_error_t exec_abs(rt_function_t *f) {
 rt_function_error_t exec_abs_generic(rt_function_t *f) {
   abs_private_t *p = (abs_private_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    float x = p->get_input(p->input, i);
-    p->set_output(p->output, i, fabsf(x));
-  }
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, fabsf(x));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_ABS_GENERIC */
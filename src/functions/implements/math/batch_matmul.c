@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "../../utilities/accessor.h"
+#include "../../utilities/sgemm.h"
 #include "../../utilities/shape.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -31,6 +32,11 @@ typedef struct {
   int offset_a;
   int offset_b;
   int offset_y;
+  int inner;          ///< Length of dot product.
+  int stride_a_row;   ///< Distance between rows of op(A).
+  int stride_a_inner; ///< Distance between columns of op(A).
+  int stride_b_inner; ///< Distance between rows of op(B).
+  int stride_b_col;   ///< Distance between columns of op(B).
   rt_variable_t *input_a;
   rt_variable_getter get_input_a;
   rt_variable_t *input_b;
@@ -69,6 +75,16 @@ rt_function_error_t allocate_batch_matmul_local_context(rt_function_t *f) {
   p->offset_b = p->row_b * p->col_b;
   p->offset_y = p->row_y * p->col_y;
 
+  // Transposition is done by strides, so inputs are never modified.
+  p->inner = context->transpose_a ? p->row_a : p->col_a;
+  p->stride_a_row = context->transpose_a ? 1 : p->col_a;
+  p->stride_a_inner = context->transpose_a ? p->col_a : 1;
+  p->stride_b_inner = context->transpose_b ? 1 : p->col_b;
+  p->stride_b_col = context->transpose_b ? p->col_b : 1;
+  if ((context->transpose_b ? p->col_b : p->row_b) != p->inner) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
   p->input_a = f->inputs[0];
   p->get_input_a = select_getter(p->input_a);
   p->input_b = f->inputs[1];
@@ -111,75 +127,37 @@ rt_function_error_t free_batch_matmul_local_context(rt_function_t *f) {
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
-static int get_next(int i, int m, int n) { return (i % n) * m + i / n; }
-
-static int get_pre(int i, int m, int n) { return (i % m) * n + i / m; }
-
-static void move_data(float *mtx, int i, int m, int n) {
-  float temp = mtx[i];
-  int cur = i;
-  int pre = get_pre(cur, m, n);
-  while (pre != i) {
-    mtx[cur] = mtx[pre];
-    cur = pre;
-    pre = get_pre(cur, m, n);
-  }
-  mtx[cur] = temp;
-}
-
-static void transpose(float *mtx, int m, int n) {
-  for (int i = 0; i < m * n; i++) {
-    int next = get_next(i, m, n);
-    while (next > i)
-      next = get_next(next, m, n);
-    if (next == i)
-      move_data(mtx, i, m, n);
+#ifdef CONFIG_BATCHMATMUL_FLOAT32
+// Process panels of SGEMM_MR rows in [begin, end), index is
+// sample * panels + panel.
+static void batch_matmul_range(void *arg, int begin, int end) {
+  batch_matmul_private_t *p = (batch_matmul_private_t *)arg;
+  const float *input_a = (float *)(p->input_a->data);
+  const float *input_b = (float *)(p->input_b->data);
+  float *output = (float *)(p->output->data);
+  int panels = (p->row_y + SGEMM_MR - 1) / SGEMM_MR;
+
+  // Consecutive panels of a sample are multiplied at once.
+  for (int index = begin; index < end;) {
+    int i = index / panels;
+    int last = end - i * panels < panels ? end - i * panels : panels;
+    int j = (index % panels) * SGEMM_MR;
+    int rows = (last * SGEMM_MR < p->row_y ? last * SGEMM_MR : p->row_y) - j;
+    sgemm(rows, p->col_y, p->inner,
+          input_a + p->offset_a * i + p->stride_a_row * j, p->stride_a_row,
+          p->stride_a_inner, input_b + p->offset_b * i, p->stride_b_inner,
+          p->stride_b_col, output + p->offset_y * i + p->col_y * j, p->col_y);
+    index = i * panels + last;
   }
 }
 
-#ifdef CONFIG_BATCHMATMUL_FLOAT32
 rt_function_error_t exec_batch_matmul(rt_function_t *f) {
   batch_matmul_local_context_t *context =
       (batch_matmul_local_context_t *)(f->local_context);
   batch_matmul_private_t *p = (batch_matmul_private_t *)(context->data);
-  float *input_a = (float *)(p->input_a->data);
-  float *input_b = (float *)(p->input_b->data);
-  float *output = (float *)(p->output->data);
 
-  int i;
-  if (context->transpose_a) {
-    for (i = 0; i < p->samples; i++) {
-      transpose(input_a + p->offset_a * i, p->row_a, p->col_a);
-    }
-    p->row_a = p->row_a ^ p->col_a;
-    p->col_a = p->row_a ^ p->col_a;
-    p->row_a = p->row_a ^ p->col_a;
-  }
-  if (context->transpose_b) {
-    for (i = 0; i < p->samples; i++) {
-      transpose(input_b + p->offset_b * i, p->row_b, p->col_b);
-    }
-    p->row_b = p->row_b ^ p->col_b;
-    p->col_b = p->row_b ^ p->col_b;
-    p->row_b = p->row_b ^ p->col_b;
-  }
-  for (i = 0; i < p->samples; i++) {
-    float *mtx_y = output + p->offset_y * i;
-    float *mtx_a = input_a + p->offset_a * i;
-    float *mtx_b = input_b + p->offset_b * i;
-    int row_a = p->row_a;
-    int col_b = p->col_b;
-    int col_a = p->col_a;
-    for (int j = 0; j < row_a; j++) {
-      for (int k = 0; k < col_b; k++) {
-        for (int l = 0; l < col_a; l++) {
-          float a = *(mtx_a + col_a * j + l);
-          float b = *(mtx_b + col_b * l + k);
-          *(mtx_y + col_b * j + k) += a * b;
-        }
-      }
-    }
-  }
+  rt_parallel_for(p->samples * ((p->row_y + SGEMM_MR - 1) / SGEMM_MR),
+                  SGEMM_MR * p->col_y * p->inner, batch_matmul_range, p);
 
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -190,39 +168,19 @@ rt_function_error_t exec_batch_matmul_generic(rt_function_t *f) {
   batch_matmul_local_context_t *context =
       (batch_matmul_local_context_t *)(f->local_context);
   batch_matmul_private_t *p = (batch_matmul_private_t *)(context->data);
-  float *input_a = (float *)(p->input_a->data);
-  float *input_b = (float *)(p->input_b->data);
 
-  int i;
-  if (context->transpose_a) {
-    for (i = 0; i < p->samples; i++) {
-      transpose(input_a + p->offset_a * i, p->row_a, p->col_a);
-    }
-    p->row_a = p->row_a ^ p->col_a;
-    p->col_a = p->row_a ^ p->col_a;
-    p->row_a = p->row_a ^ p->col_a;
-  }
-  if (context->transpose_b) {
-    for (i = 0; i < p->samples; i++) {
-      transpose(input_b + p->offset_b * i, p->row_b, p->col_b);
-    }
-    p->row_b = p->row_b ^ p->col_b;
-    p->col_b = p->row_b ^ p->col_b;
-    p->row_b = p->row_b ^ p->col_b;
-  }
-  for (i = 0; i < p->samples; i++) {
-    int row_a = p->row_a;
-    int col_b = p->col_b;
-    int col_a = p->col_a;
-    for (int j = 0; j < row_a; j++) {
-      for (int k = 0; k < col_b; k++) {
-        for (int l = 0; l < col_a; l++) {
-          float a = p->get_input_a(p->input_a, p->offset_y * i + col_a * j + l);
-          float b = p->get_input_b(p->input_b, p->offset_b * i + col_b * l + k);
-          float y = p->get_output(p->output, p->offset_y * i + col_b * j + k);
+  for (int i = 0; i < p->samples; i++) {
+    for (int j = 0; j < p->row_y; j++) {
+      int pos_a = p->offset_a * i + p->stride_a_row * j;
+      for (int k = 0; k < p->col_y; k++) {
+        int pos_b = p->offset_b * i + p->stride_b_col * k;
+        float y = 0.0f;
+        for (int l = 0; l < p->inner; l++) {
+          float a = p->get_input_a(p->input_a, pos_a + p->stride_a_inner * l);
+          float b = p->get_input_b(p->input_b, pos_b + p->stride_b_inner * l);
           y += a * b;
-          p->set_output(p->output, p->offset_y * i + col_b * j + k, y);
         }
+        p->set_output(p->output, p->offset_y * i + p->col_y * j + k, y);
       }
     }
   }
@@ -17,6 +17,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 
 #include <math.h>
 
@@ -79,13 +80,9 @@ rt_function_error_t free_exp_local_context(rt_function_t *f) {
 #ifdef CONFIG_EXP_FLOAT32
 rt_function_error_t exec_exp(rt_function_t *f) {
   exp_private_t *p = (exp_private_t *)(f->local_context);
-  float *x = (float *)(p->input->data);
-  float *y = (float *)(p->output->data);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    y[i] = expf(x[i]);
-  }
+  vector_exp((const float *)(p->input->data), (float *)(p->output->data),
+             p->output_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_EXP_FLOAT32 */
@@ -94,11 +91,7 @@ rt_function_error_t exec_exp(rt_function_t *f) {
 rt_function_error_t exec_exp_generic(rt_function_t *f) {
   exp_private_t *p = (exp_private_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    float x = p->get_input(p->input, i);
-    p->set_output(p->output, i, expf(x));
-  }
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, expf(x));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_EXP_GENERIC */
@@ -89,10 +89,8 @@ rt_function_error_t exec_identity(rt_function_t *f) {
 rt_function_error_t exec_identity_generic(rt_function_t *f) {
   identity_private_context_t *p =
       (identity_private_context_t *)(f->local_context);
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    p->set_output(p->output, i, p->get_input(p->input, i));
-  }
+
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, x);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_IDENTITY_GENERIC */
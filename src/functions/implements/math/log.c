@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
 
@@ -78,13 +79,9 @@ rt_function_error_t free_log_local_context(rt_function_t *f) {
 #ifdef CONFIG_LOG_FLOAT32
 rt_function_error_t exec_log(rt_function_t *f) {
   log_private_t *p = (log_private_t *)(f->local_context);
-  float *x = (float *)(p->input->data);
-  float *y = (float *)(p->output->data);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    y[i] = logf(x[i]);
-  }
+  vector_log((const float *)(p->input->data), (float *)(p->output->data),
+             p->output_size);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_LOG_FLOAT32 */
@@ -93,11 +90,7 @@ rt_function_error_t exec_log(rt_function_t *f) {
 rt_function_error_t exec_log_generic(rt_function_t *f) {
   log_private_t *p = (log_private_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    float x = p->get_input(p->input, i);
-    p->set_output(p->output, i, logf(x));
-  }
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, logf(x));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_LOG_GENERIC */
@@ -93,11 +93,7 @@ rt_function_error_t exec_round(rt_function_t *f) {
 rt_function_error_t exec_round_generic(rt_function_t *f) {
   round_private_t *p = (round_private_t *)(f->local_context);
 
-  int i; // Iterator
-  for (i = 0; i < p->output_size; i++) {
-    float x = p->get_input(p->input, i);
-    p->set_output(p->output, i, roundf(x));
-  }
+  FOR_EACH_BLOCK(p->input, p->output, p->output_size, roundf(x));
   return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_ROUND_GENERIC */
@@ -52,6 +52,14 @@ rt_function_error_t allocate_affine_local_context(rt_function_t *f) {
   }
 
   p->alpha = 0;
+  p->panel_weight = 0;
+  p->fixed_bias = 0;
+  p->fixed_scale = 0;
+  p->sign_weight = 0;
+  p->sign_input = 0;
+  p->dense_weight.data = 0;
+  p->epilogue.type = RT_EPILOGUE_NONE;
+  p->epilogue.alpha = 0.0f;
 
   p->output_size = calc_shape_size(p->output->shape);
 
@@ -73,11 +81,44 @@ rt_function_error_t allocate_affine_local_context(rt_function_t *f) {
     p->output_loop_size *= p->output->shape.data[i];
   }
 
-  if (p->input->type == NN_DATA_TYPE_FLOAT &&
-      p->output->type == NN_DATA_TYPE_FLOAT &&
-      p->weight->type == NN_DATA_TYPE_FLOAT &&
-      ((p->bias && p->bias->type == NN_DATA_TYPE_FLOAT) || !p->bias)) {
-    f->exec_func = exec_affine;
+  if (p->weight->layout == NN_DATA_LAYOUT_BLOCK_SPARSE &&
+      !is_sparse_affine(p)) {
+    // Other kernels read dense weight.
+    if (expand_sparse_variable(p->weight, &p->dense_weight) !=
+        RT_FUNCTION_ERROR_NOERROR) {
+      rt_free_func(p);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    p->weight = &p->dense_weight;
+    p->get_weight = select_getter(p->weight);
+  }
+
+  if (p->weight->layout == NN_DATA_LAYOUT_BLOCK_SPARSE) {
+    f->exec_func = exec_affine_sparse;
+  } else if (p->input->type == NN_DATA_TYPE_FLOAT &&
+             p->output->type == NN_DATA_TYPE_FLOAT &&
+             (p->weight->type == NN_DATA_TYPE_FLOAT ||
+              is_half_type(p->weight->type)) &&
+             ((p->bias && p->bias->type == NN_DATA_TYPE_FLOAT) || !p->bias)) {
+    if (p->weight->type != NN_DATA_TYPE_FLOAT) {
+      // 16bit weight is converted while blocks of it are packed by GEMM.
+      f->exec_func = exec_affine;
+    } else if (p->base_loop_size == 1) {
+      // Rows of weight are read directly by dot products.
+      f->exec_func = exec_affine_gemv;
+    } else {
+      f->exec_func = exec_affine;
+      // Weight is read from network if it is not packed.
+      p->panel_weight = pack_weight_panels(
+          (const float *)(p->weight->data), 1, p->output_loop_size,
+          p->input_loop_size, SGEMM_NR);
+    }
+  } else if (is_sign_affine(p) &&
+             allocate_affine_sign(p) == RT_FUNCTION_ERROR_NOERROR) {
+    f->exec_func = exec_affine_sign;
+  } else if (is_fixed_affine(p) &&
+             allocate_affine_fixed(p) == RT_FUNCTION_ERROR_NOERROR) {
+    f->exec_func = exec_affine_fixed;
   } else {
     f->exec_func = exec_affine_generic;
   }
@@ -87,56 +128,114 @@ rt_function_error_t allocate_affine_local_context(rt_function_t *f) {
 }
 
 rt_function_error_t free_affine_local_context(rt_function_t *f) {
-  rt_free_func((((affine_local_context_t *)(f->local_context))->data));
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+  free_weight_copy(p->panel_weight);
+  if (p->fixed_bias != 0) {
+    rt_free_func(p->fixed_bias);
+  }
+  if (p->fixed_scale != 0) {
+    rt_free_func(p->fixed_scale);
+  }
+  free_affine_sign(p);
+  free_dense_variable(&p->dense_weight);
+  rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+rt_function_error_t set_affine_epilogue(rt_function_t *f,
+                                        const rt_epilogue_t *epilogue) {
+  if (f->exec_func != exec_affine && f->exec_func != exec_affine_gemv &&
+      f->exec_func != exec_affine_sparse) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+  p->epilogue = *epilogue;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Process output columns of panels [begin, end) for all rows of batch, each
+// panel has SGEMM_NR columns. Output is product of input and transposed
+// weight, alpha and bias are applied while it is stored.
+static void affine_range(void *arg, int begin, int end) {
+  affine_private_t *p = (affine_private_t *)arg;
+  int n = p->output_loop_size;
+  int k = p->input_loop_size;
+  int j0 = begin * SGEMM_NR;
+  int j1 = end * SGEMM_NR < n ? end * SGEMM_NR : n;
+  const float *input = (float *)(p->input->data);
+  float *output = (float *)(p->output->data) + j0;
+  const float *alpha = p->alpha ? (float *)(p->alpha->data) + j0 : 0;
+  const float *bias = p->bias ? (float *)(p->bias->data) + j0 : 0;
+  int i; // Iterator
+
+  if (p->panel_weight) {
+    // Each panel of weight is reused by all rows of batch.
+    sgemm_packed_b_scaled(p->base_loop_size, j1 - j0, k, input, k, 1,
+                          p->panel_weight + begin * k * SGEMM_NR, alpha, bias,
+                          output, n);
+  } else if (p->weight->type != NN_DATA_TYPE_FLOAT) {
+    sgemm_half_b_scaled(p->base_loop_size, j1 - j0, k, input, k, 1,
+                        (uint16_t *)(p->weight->data) + j0 * k,
+                        p->weight->type, 1, k, alpha, bias, output, n);
+  } else {
+    sgemm_scaled(p->base_loop_size, j1 - j0, k, input, k, 1,
+                 (float *)(p->weight->data) + j0 * k, 1, k, alpha, bias,
+                 output, n);
+  }
+  if (p->epilogue.type != RT_EPILOGUE_NONE) {
+    for (i = 0; i < p->base_loop_size; i++) {
+      apply_epilogue(&p->epilogue, output + i * n, j1 - j0);
+    }
+  }
+}
+
 rt_function_error_t exec_affine(rt_function_t *f) {
   affine_private_t *p =
       (affine_private_t *)(((affine_local_context_t *)(f->local_context))
                                ->data);
-  int i, j, k; // Iterators.
-  float *input = (float *)(p->input->data);
-  float *weight = (float *)(p->weight->data);
-  float *output = (float *)(p->output->data);
-  float *alpha = 0;
 
+  rt_parallel_for((p->output_loop_size + SGEMM_NR - 1) / SGEMM_NR,
+                  SGEMM_NR * p->base_loop_size * p->input_loop_size,
+                  affine_range, p);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Calculate outputs [begin, end) of single row batch. Each output is dot
+// product of input and one row of weight, sgemv() shares loads of input
+// among several rows.
+static void affine_gemv_range(void *arg, int begin, int end) {
+  affine_private_t *p = (affine_private_t *)arg;
+  int k = p->input_loop_size;
+  float *y = (float *)(p->output->data);
+  int j; // Iterator
+
+  sgemv(end - begin, k, (float *)(p->weight->data) + begin * k, k,
+        (float *)(p->input->data), y + begin);
   if (p->alpha) {
-    alpha = (float *)p->alpha->data;
-  }
-
-  // Clear output
-  memset(output, 0, sizeof(float) * p->output_size);
-
-  for (k = 0; k < p->base_loop_size; k++) {
-    int output_offset = k * p->output_loop_size;
-    int input_offset = k * p->input_loop_size;
-    float *o_addr = output + output_offset;
-    float *alpha_addr = alpha;
-
-    for (j = 0; j < p->output_loop_size; ++j) {
-      int weight_offset = j * p->input_loop_size;
-
-      float *i_addr = input + input_offset;
-      float *w_addr = weight + weight_offset;
-      for (i = 0; i < p->input_loop_size; ++i) {
-        *o_addr += (*i_addr++) * (*w_addr++);
-      }
-      if (alpha) {
-        *o_addr *= *alpha_addr++;
-      }
-      ++o_addr;
+    const float *alpha = (float *)(p->alpha->data);
+    for (j = begin; j < end; j++) {
+      y[j] *= alpha[j];
     }
-
-    // Bias
-    if (p->bias) {
-      float *bias = (float *)(p->bias->data);
-      for (i = 0; i < p->output_loop_size; i++) {
-        int opos = output_offset + i;
-        int bpos = i;
-        *(output + opos) = *(output + opos) + *(bias + bpos);
-      }
+  }
+  if (p->bias) {
+    const float *bias = (float *)(p->bias->data);
+    for (j = begin; j < end; j++) {
+      y[j] += bias[j];
     }
   }
+  apply_epilogue(&p->epilogue, y + begin, end - begin);
+}
+
+rt_function_error_t exec_affine_gemv(rt_function_t *f) {
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+
+  rt_parallel_for(p->output_loop_size, p->input_loop_size, affine_gemv_range,
+                  p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -0,0 +1,197 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+
+#include <math.h>
+
+#include "affine_internal.h"
+
+/*
+ * Affine of int8 or int16 input and weight. Products are accumulated in
+ * integers with fixed point position of input plus weight, and each output
+ * is converted to its own type once at the end. int8 products are summed
+ * in int32 for blocks short enough not to overflow, others in int64.
+ * Weight with per channel quantization has a scale for each output instead
+ * of fixed point position, and accumulators are converted with it.
+ */
+
+#define FIXED8_BLOCK (1 << 16) // int8 products summed in int32 at once
+
+typedef int64_t (*fixed_dot_t)(const void *x, const void *w, int size);
+
+static int64_t dot_int8_int8(const void *x, const void *w, int size) {
+  const int8_t *a = (const int8_t *)x;
+  const int8_t *b = (const int8_t *)w;
+  int64_t sum = 0;
+  int i, j; // Iterator
+
+  for (i = 0; i < size; i += FIXED8_BLOCK) {
+    int end = size - i < FIXED8_BLOCK ? size : i + FIXED8_BLOCK;
+    int32_t acc = 0;
+    for (j = i; j < end; j++) {
+      acc += (int32_t)a[j] * b[j];
+    }
+    sum += acc;
+  }
+  return sum;
+}
+
+#define DEFINE_FIXED_DOT(name, x_type, w_type)                                 \
+  static int64_t name(const void *x, const void *w, int size) {                \
+    const x_type *a = (const x_type *)x;                                       \
+    const w_type *b = (const w_type *)w;                                       \
+    int64_t acc = 0;                                                           \
+    int i;                                                                     \
+    for (i = 0; i < size; i++) {                                               \
+      acc += (int32_t)a[i] * b[i];                                             \
+    }                                                                          \
+    return acc;                                                                \
+  }
+
+DEFINE_FIXED_DOT(dot_int8_int16, int8_t, int16_t)
+DEFINE_FIXED_DOT(dot_int16_int8, int16_t, int8_t)
+DEFINE_FIXED_DOT(dot_int16_int16, int16_t, int16_t)
+
+static size_t fixed_element_size(nn_data_type_t type) {
+  return type == NN_DATA_TYPE_INT8 ? sizeof(int8_t) : sizeof(int16_t);
+}
+
+static int is_fixed_type(nn_data_type_t type) {
+  return type == NN_DATA_TYPE_INT8 || type == NN_DATA_TYPE_INT16;
+}
+
+int is_fixed_affine(affine_private_t *p) {
+  nn_data_type_t y = p->output->type;
+  if (p->alpha || !is_fixed_type(p->input->type) ||
+      !is_fixed_type(p->weight->type)) {
+    return 0;
+  }
+  if (p->bias && p->bias->type == NN_DATA_TYPE_SIGN) {
+    return 0;
+  }
+  if (p->input->quantization || p->output->quantization ||
+      !has_row_scales(p->weight, p->input_loop_size)) {
+    return 0;
+  }
+  return y == NN_DATA_TYPE_FLOAT || is_fixed_type(y);
+}
+
+rt_function_error_t allocate_affine_fixed(affine_private_t *p) {
+  int fp_pos = p->input->fp_pos + p->weight->fp_pos;
+  int i; // Iterator
+
+  if (p->weight->quantization) {
+    p->fixed_scale = rt_malloc_func(sizeof(float) * p->output_loop_size);
+    if (p->fixed_scale == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    for (i = 0; i < p->output_loop_size; i++) {
+      p->fixed_scale[i] = p->input->coefficient *
+                          get_row_scale(p->weight, i, p->input_loop_size);
+    }
+  }
+
+  // Bias is converted to fixed point position or scale of accumulator.
+  if (p->bias) {
+    p->fixed_bias = rt_malloc_func(sizeof(int64_t) * p->output_loop_size);
+    if (p->fixed_bias == 0) {
+      if (p->fixed_scale) {
+        rt_free_func(p->fixed_scale);
+        p->fixed_scale = 0;
+      }
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    for (i = 0; i < p->output_loop_size; i++) {
+      double bias = p->get_bias(p->bias, i);
+      bias = p->fixed_scale ? bias / p->fixed_scale[i] : ldexp(bias, fp_pos);
+      bias = bias >= (double)INT64_MAX
+                 ? (double)INT64_MAX
+                 : bias <= (double)INT64_MIN ? (double)INT64_MIN : bias;
+      p->fixed_bias[i] = (int64_t)floor(bias + 0.5);
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Convert accumulator of output j to output type with truncation and
+// saturation same as setters of variables.
+static void store_fixed_output(affine_private_t *p, int pos, int j,
+                               int64_t acc) {
+  rt_variable_t *y = p->output;
+  int shift = p->input->fp_pos + p->weight->fp_pos - y->fp_pos;
+  int64_t min = y->type == NN_DATA_TYPE_INT8 ? INT8_MIN : INT16_MIN;
+  int64_t max = y->type == NN_DATA_TYPE_INT8 ? INT8_MAX : INT16_MAX;
+
+  if (p->fixed_scale) {
+    p->set_output(y, pos, (float)acc * p->fixed_scale[j]);
+    return;
+  }
+  if (y->type == NN_DATA_TYPE_FLOAT) {
+    ((float *)(y->data))[pos] =
+        (float)acc * p->input->coefficient * p->weight->coefficient;
+    return;
+  }
+  if (shift > 0) {
+    // Round toward zero.
+    acc = (acc + (acc < 0 ? ((int64_t)1 << shift) - 1 : 0)) >> shift;
+  } else if (acc <= max && acc >= min) {
+    acc *= (int64_t)1 << -shift;
+  }
+  acc = acc > max ? max : acc < min ? min : acc;
+  if (y->type == NN_DATA_TYPE_INT8) {
+    ((int8_t *)(y->data))[pos] = (int8_t)acc;
+  } else {
+    ((int16_t *)(y->data))[pos] = (int16_t)acc;
+  }
+}
+
+// Calculate outputs [begin, end) for all rows of batch. Each row of weight is
+// reused by all rows of batch.
+static void affine_fixed_range(void *arg, int begin, int end) {
+  affine_private_t *p = (affine_private_t *)arg;
+  int n = p->output_loop_size;
+  int k = p->input_loop_size;
+  size_t x_size = fixed_element_size(p->input->type);
+  size_t w_size = fixed_element_size(p->weight->type);
+  const uint8_t *input = (const uint8_t *)(p->input->data);
+  const uint8_t *weight = (const uint8_t *)(p->weight->data);
+  fixed_dot_t dot;
+  int i, j; // Iterator
+
+  if (p->input->type == NN_DATA_TYPE_INT8) {
+    dot = p->weight->type == NN_DATA_TYPE_INT8 ? dot_int8_int8 : dot_int8_int16;
+  } else {
+    dot = p->weight->type == NN_DATA_TYPE_INT8 ? dot_int16_int8
+                                               : dot_int16_int16;
+  }
+  for (j = begin; j < end; j++) {
+    const void *w = weight + (size_t)j * k * w_size;
+    int64_t bias = p->fixed_bias ? p->fixed_bias[j] : 0;
+    for (i = 0; i < p->base_loop_size; i++) {
+      store_fixed_output(p, i * n + j, j,
+                         bias + dot(input + (size_t)i * k * x_size, w, k));
+    }
+  }
+}
+
+rt_function_error_t exec_affine_fixed(rt_function_t *f) {
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+
+  rt_parallel_for(p->output_loop_size, p->base_loop_size * p->input_loop_size,
+                  affine_fixed_range, p);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
@@ -20,7 +20,8 @@ rt_function_error_t exec_affine_generic(rt_function_t *f) {
   affine_private_t *p =
       (affine_private_t *)(((affine_local_context_t *)(f->local_context))
                                ->data);
-  int i, j, k; // Iterators.
+  float x[ACCESSOR_BLOCK_SIZE], w[ACCESSOR_BLOCK_SIZE];
+  int i, j, k, b; // Iterators.
 
   // Clear output
   for (i = 0; i < p->output_size; i++) {
@@ -31,19 +32,25 @@ rt_function_error_t exec_affine_generic(rt_function_t *f) {
     int output_offset = k * p->output_loop_size;
     int input_offset = k * p->input_loop_size;
 
-    // Weight
+    // Weight, converted ACCESSOR_BLOCK_SIZE elements at a time.
     for (j = 0; j < p->output_loop_size; ++j) {
       int opos = output_offset + j;
       int weight_offset = j * p->input_loop_size;
       float y0 = p->get_output(p->output, opos);
 
-      for (i = 0; i < p->input_loop_size; ++i) {
-        int ipos = input_offset + i;
-        int wpos = weight_offset + i;
-
-        float w = p->get_weight(p->weight, wpos);
-        float x = p->get_input(p->input, ipos);
-        y0 += x * w;
+      for (b = 0; b < p->input_loop_size; b += ACCESSOR_BLOCK_SIZE) {
+        int n = p->input_loop_size - b;
+        if (n > ACCESSOR_BLOCK_SIZE) {
+          n = ACCESSOR_BLOCK_SIZE;
+        }
+        // Input which fits in one block is read once for all outputs.
+        if (j == 0 || p->input_loop_size > ACCESSOR_BLOCK_SIZE) {
+          get_variable_block(p->input, input_offset + b, n, x);
+        }
+        get_variable_block(p->weight, weight_offset + b, n, w);
+        for (i = 0; i < n; ++i) {
+          y0 += x[i] * w[i];
+        }
       }
 
       if (p->alpha) {
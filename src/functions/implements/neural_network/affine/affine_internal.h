@@ -16,7 +16,12 @@
 #define H_AFFINE_INTERNAL_H_171218154530_
 
 #include "../../../utilities/accessor.h"
+#include "../../../utilities/epilogue.h"
+#include "../../../utilities/half.h"
+#include "../../../utilities/prepack.h"
+#include "../../../utilities/sgemm.h"
 #include "../../../utilities/shape.h"
+#include "../../../utilities/sparse.h"
 
 typedef struct {
   rt_variable_t *input;
@@ -40,6 +45,32 @@ typedef struct {
   int input_loop_size;
   int output_loop_size;
 
+  rt_epilogue_t epilogue; ///< Activation applied to outputs.
+  float *panel_weight;    ///< Weight packed into panels of outputs, or NULL.
+  int64_t *fixed_bias;    ///< Bias in fixed point position of accumulator of
+                          ///< int8/int16 affine, or NULL.
+  float *fixed_scale;     ///< Scale of accumulator of each output of int8/int16
+                          ///< affine with per channel weight, or NULL.
+  uint32_t *sign_weight;  ///< Rows of SIGN weight aligned to words, or NULL.
+  uint32_t *sign_input;   ///< Rows of SIGN input aligned to words, or NULL.
+
+  /// Expanded copy of block sparse weight for kernels other than sparse one.
+  rt_variable_t dense_weight;
+
 } affine_private_t;
 
+rt_function_error_t exec_affine_gemv(rt_function_t *f);
+
+int is_fixed_affine(affine_private_t *p);
+rt_function_error_t allocate_affine_fixed(affine_private_t *p);
+rt_function_error_t exec_affine_fixed(rt_function_t *f);
+
+int is_sign_affine(affine_private_t *p);
+rt_function_error_t allocate_affine_sign(affine_private_t *p);
+rt_function_error_t exec_affine_sign(rt_function_t *f);
+void free_affine_sign(affine_private_t *p);
+
+int is_sparse_affine(affine_private_t *p);
+rt_function_error_t exec_affine_sparse(rt_function_t *f);
+
 #endif // H_AFFINE_INTERNAL_H_171218154530_
@@ -0,0 +1,183 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+
+#include "../../../utilities/sign.h"
+#include "affine_internal.h"
+
+/*
+ * Affine of SIGN weight. Weight values are +1 for set bits and -1 for
+ * cleared bits, so float input is added or subtracted without
+ * multiplication. When input is SIGN as well, product of n values packed
+ * into words is
+ *   n - 2 * popcount(x ^ w).
+ * Rows of weight and input are read from words starting at a word boundary,
+ * so they are repacked unless their size is a multiple of 32.
+ */
+
+int is_sign_affine(affine_private_t *p) {
+  return p->weight->type == NN_DATA_TYPE_SIGN &&
+         (p->input->type == NN_DATA_TYPE_FLOAT ||
+          p->input->type == NN_DATA_TYPE_SIGN) &&
+         (!p->alpha || p->alpha->type != NN_DATA_TYPE_SIGN) &&
+         (!p->bias || p->bias->type != NN_DATA_TYPE_SIGN);
+}
+
+rt_function_error_t allocate_affine_sign(affine_private_t *p) {
+  int words = SIGN_WORDS(p->input_loop_size);
+  size_t size = sizeof(uint32_t) * p->output_loop_size * words;
+  const uint32_t *weight = (const uint32_t *)(p->weight->data);
+
+  if (p->input_loop_size % 32 == 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  p->sign_weight = find_weight_copy(weight, WEIGHT_COPY_SIGN, size);
+  if (p->sign_weight == 0) {
+    p->sign_weight = rt_malloc_func(size);
+    if (p->sign_weight == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    pack_sign_rows(weight, p->output_loop_size, p->input_loop_size,
+                   p->sign_weight);
+    add_weight_copy(weight, WEIGHT_COPY_SIGN, size, p->sign_weight);
+  }
+  if (p->input->type == NN_DATA_TYPE_SIGN) {
+    p->sign_input =
+        rt_malloc_func(sizeof(uint32_t) * p->base_loop_size * words);
+    if (p->sign_input == 0) {
+      free_weight_copy(p->sign_weight);
+      p->sign_weight = 0;
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#define SIGN_LANES (8) // Partial sums of signed_sum()
+
+// Sum of x added at set bits of w and subtracted at cleared bits. Sign bit
+// of each x is flipped by its bit of w, partial sums of lanes are kept
+// independent so that they are calculated together.
+static float signed_sum(const float *x, const uint32_t *w, int size) {
+  float lane[SIGN_LANES] = {0.0f};
+  float sum = 0.0f;
+  int i, b, l; // Iterator
+
+  for (i = 0; i + 32 <= size; i += 32) {
+    uint32_t bits = ~w[i / 32];
+    for (b = 0; b < 32; b += SIGN_LANES) {
+      for (l = 0; l < SIGN_LANES; l++) {
+        union {
+          uint32_t u;
+          float f;
+        } v;
+        v.f = x[i + b + l];
+        v.u ^= ((bits >> (b + l)) & 1) << 31;
+        lane[l] += v.f;
+      }
+    }
+  }
+  for (; i < size; i++) {
+    sum += SIGN_BIT(w, i) ? x[i] : -x[i];
+  }
+  for (l = 0; l < SIGN_LANES; l++) {
+    sum += lane[l];
+  }
+  return sum;
+}
+
+static int sign_product(const uint32_t *x, const uint32_t *w, int size) {
+  int words = SIGN_WORDS(size);
+  int mismatches = 0;
+  int i; // Iterator
+
+  for (i = 0; i < words; i++) {
+    mismatches += POPCOUNT32(x[i] ^ w[i]);
+  }
+  return size - 2 * mismatches;
+}
+
+static void store_sign_affine_output(affine_private_t *p, int pos, int j,
+                                     float y) {
+  if (p->alpha) {
+    y *= p->get_alpha(p->alpha, j);
+  }
+  if (p->bias) {
+    y += p->get_bias(p->bias, j);
+  }
+  if (p->output->type == NN_DATA_TYPE_FLOAT) {
+    ((float *)(p->output->data))[pos] = y;
+  } else {
+    p->set_output(p->output, pos, y);
+  }
+}
+
+// Calculate outputs [begin, end) for all rows of batch.
+static void affine_sign_range(void *arg, int begin, int end) {
+  affine_private_t *p = (affine_private_t *)arg;
+  int n = p->output_loop_size;
+  int k = p->input_loop_size;
+  int words = SIGN_WORDS(k);
+  const uint32_t *weight =
+      p->sign_weight ? p->sign_weight : (const uint32_t *)(p->weight->data);
+  int i, j; // Iterator
+
+  for (j = begin; j < end; j++) {
+    const uint32_t *w = weight + j * words;
+    for (i = 0; i < p->base_loop_size; i++) {
+      float y;
+      if (p->input->type == NN_DATA_TYPE_SIGN) {
+        const uint32_t *x = p->sign_input
+                                ? p->sign_input
+                                : (const uint32_t *)(p->input->data);
+        y = (float)sign_product(x + i * words, w, k);
+      } else {
+        y = signed_sum((const float *)(p->input->data) + i * k, w, k);
+      }
+      store_sign_affine_output(p, i * n + j, j, y);
+    }
+  }
+}
+
+rt_function_error_t exec_affine_sign(rt_function_t *f) {
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+  int k = p->input_loop_size;
+
+  if (p->sign_input) {
+    pack_sign_rows((const uint32_t *)(p->input->data), p->base_loop_size, k,
+                   p->sign_input);
+  }
+  // Bits of SIGN output share words, so they are written by one thread.
+  if (p->output->type == NN_DATA_TYPE_SIGN) {
+    affine_sign_range(p, 0, p->output_loop_size);
+  } else {
+    rt_parallel_for(p->output_loop_size, p->base_loop_size * k,
+                    affine_sign_range, p);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_affine_sign(affine_private_t *p) {
+  if (p->sign_weight != 0) {
+    free_weight_copy(p->sign_weight);
+    p->sign_weight = 0;
+  }
+  if (p->sign_input != 0) {
+    rt_free_func(p->sign_input);
+    p->sign_input = 0;
+  }
+}
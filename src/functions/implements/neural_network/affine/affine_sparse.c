@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+
+#include "affine_internal.h"
+
+/*
+ * Affine of block sparse weight. Row j of weight keeps blocks of inputs
+ * which are not all zero, so output j of each row of batch is bias plus
+ * products of those blocks only.
+ */
+
+int is_sparse_affine(affine_private_t *p) {
+  block_sparse_t s;
+
+  if (p->weight->layout != NN_DATA_LAYOUT_BLOCK_SPARSE ||
+      p->input->type != NN_DATA_TYPE_FLOAT ||
+      p->output->type != NN_DATA_TYPE_FLOAT ||
+      p->weight->type != NN_DATA_TYPE_FLOAT || p->alpha ||
+      (p->bias && p->bias->type != NN_DATA_TYPE_FLOAT)) {
+    return 0;
+  }
+  get_block_sparse(p->weight, &s);
+  return s.rows == p->output_loop_size && s.columns == p->input_loop_size;
+}
+
+// Calculate outputs [begin, end) for all rows of batch. Blocks of each row
+// of weight are reused by all rows of batch.
+static void affine_sparse_range(void *arg, int begin, int end) {
+  affine_private_t *p = (affine_private_t *)arg;
+  int n = p->output_loop_size;
+  int k = p->input_loop_size;
+  const float *input = (const float *)(p->input->data);
+  float *output = (float *)(p->output->data);
+  const float *bias = p->bias ? (const float *)(p->bias->data) : 0;
+  block_sparse_t s;
+  int i, j, b, t; // Iterator
+
+  get_block_sparse(p->weight, &s);
+  for (j = begin; j < end; j++) {
+    for (i = 0; i < p->base_loop_size; i++) {
+      const float *x = input + i * k;
+      float y = bias ? bias[j] : 0.0f;
+      for (b = s.row_offsets[j]; b < s.row_offsets[j + 1]; b++) {
+        const float *w = s.values + b * s.block_size;
+        const float *xb = x + s.block_columns[b];
+        for (t = 0; t < s.block_size; t++) {
+          y += w[t] * xb[t];
+        }
+      }
+      output[i * n + j] = y;
+    }
+  }
+  if (p->epilogue.type != RT_EPILOGUE_NONE) {
+    for (i = 0; i < p->base_loop_size; i++) {
+      apply_epilogue(&p->epilogue, output + i * n + begin, end - begin);
+    }
+  }
+}
+
+rt_function_error_t exec_affine_sparse(rt_function_t *f) {
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+  block_sparse_t s;
+  int non_zeros;
+
+  get_block_sparse(p->weight, &s);
+  non_zeros = s.row_offsets[s.rows] * s.block_size;
+  rt_parallel_for(p->output_loop_size,
+                  p->base_loop_size * (non_zeros / p->output_loop_size + 1),
+                  affine_sparse_range, p);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
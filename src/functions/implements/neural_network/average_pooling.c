@@ -22,8 +22,8 @@ rt_function_error_t allocate_average_pooling_local_context(rt_function_t *f) {
   average_pooling_local_context_t *context =
       (average_pooling_local_context_t *)(f->local_context);
   pooling_private_t *p = rt_malloc_func(sizeof(pooling_private_t));
-  rt_function_error_t ret =
-      allocate_pooling(f, (pooling_context_t *)context, p);
+  rt_function_error_t ret = allocate_pooling(f, (pooling_context_t *)context,
+                                             p, context->including_pad);
 
   ((average_pooling_local_context_t *)(f->local_context))->data = (void *)p;
   f->exec_func = exec_average_pooling;
@@ -51,7 +51,9 @@ rt_function_error_t exec_average_pooling(rt_function_t *f) {
   } else {
 #ifdef CONFIG_AVERAGEPOOLING_GENERIC
     return exec_pooling_generic(f, (pooling_context_t *)context, p,
-                                calc_average_generic);
+                                is_fixed_point(p->calc_context.x)
+                                    ? calc_average_fixed
+                                    : calc_average_generic);
 #endif /* CONFIG_AVERAGEPOOLING_GENERIC */
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -45,7 +45,7 @@ allocate_binary_weight_convolution_local_context(rt_function_t *f) {
   }
 #endif /* CONFIG_BINARYWEIGHTCONVOLUTION_GENERIC */
   return allocate_convolution_local_context_common(f, X, WEIGHT, BIAS, ALPHA,
-                                                   Y0);
+                                                   Y0, 0);
 }
 
 rt_function_error_t
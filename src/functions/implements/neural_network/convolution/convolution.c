@@ -38,7 +38,9 @@ rt_function_error_t allocate_convolution_local_context(rt_function_t *f) {
 
 #ifdef CONFIG_CONVOLUTION_GENERIC
   for (int i = 0; i < f->num_of_inputs; i++) {
-    if (f->inputs[i]->type != NN_DATA_TYPE_FLOAT) {
+    // 16bit float weight is converted to float by common allocation.
+    if (f->inputs[i]->type != NN_DATA_TYPE_FLOAT &&
+        !(i == WEIGHT && is_half_type(f->inputs[i]->type))) {
       f->exec_func = exec_convolution_generic;
       break;
     }
@@ -47,14 +49,58 @@ rt_function_error_t allocate_convolution_local_context(rt_function_t *f) {
     f->exec_func = exec_convolution_generic;
   }
 #endif /* CONFIG_CONVOLUTION_GENERIC */
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)(f->local_context);
   return allocate_convolution_local_context_common(f, X, WEIGHT, BIAS, ALPHA,
-                                                   Y0);
+                                                   Y0, c->channel_last);
 }
 
 rt_function_error_t free_convolution_local_context(rt_function_t *f) {
   return free_convolution_local_context_common(f);
 }
 
+rt_function_error_t set_convolution_epilogue(rt_function_t *f,
+                                             const rt_epilogue_t *epilogue) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  if (f->exec_func == exec_convolution) {
+    convolution_local_context_t *c =
+        (convolution_local_context_t *)(f->local_context);
+    convolution_private_t *p = (convolution_private_t *)(c->data);
+    p->epilogue = *epilogue;
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+}
+
+int convolution_kernels(rt_function_t *f, rt_kernel_t *kernels) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  if (f->exec_func == exec_convolution) {
+    convolution_local_context_t *c =
+        (convolution_local_context_t *)(f->local_context);
+    return convolution_float_kernels((convolution_private_t *)(c->data),
+                                     kernels);
+  }
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+  (void)kernels;
+  return 0;
+}
+
+rt_function_error_t select_convolution_kernel(rt_function_t *f,
+                                              rt_kernel_t kernel, int keep) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  if (f->exec_func == exec_convolution) {
+    convolution_local_context_t *c =
+        (convolution_local_context_t *)(f->local_context);
+    return select_convolution_float_kernel((convolution_private_t *)(c->data),
+                                           kernel, keep);
+  }
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+  (void)kernel;
+  (void)keep;
+  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+}
+
 #ifdef CONFIG_CONVOLUTION_FLOAT32
 rt_function_error_t exec_convolution(rt_function_t *f) {
   return exec_convolution_float(f);
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "convolution_internal.h"
+
+#include "../../../utilities/shape.h"
+
+#include <nnablart/functions.h>
+#include <string.h>
+
+/*
+ * Convolution with channel last layout, input is (batch..., spatial...,
+ * channel) and weight is (out, kernel..., in).
+ * Each row of im2col buffer holds all input values for one output
+ * position, so output row is calculated as im2col row multiplied with
+ * weight packed as [group][kernel][in][out]. Innermost loops run over
+ * channels which are contiguous in memory.
+ */
+
+typedef struct {
+  convolution_local_context_t *c;
+  convolution_private_t *p;
+  float *input;     ///< Input of current batch.
+  float *output;    ///< Output of current batch.
+  const float *col; ///< im2col buffer, or input of pointwise convolution.
+  int group;        ///< Current group.
+  int first;        ///< First output position in im2col buffer.
+} convolution_channel_last_job_t;
+
+rt_function_error_t
+allocate_convolution_channel_last(convolution_local_context_t *c,
+                                  convolution_private_t *p) {
+  int in_vars = p->in_var.shape.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int rows = in_vars * calc_shape_size(p->kernel_shape);
+  const float *weight = (const float *)(p->w_var.v->data);
+  size_t size = sizeof(float) * c->group * rows * out_vars;
+  int g, o, k;
+
+  p->packed_weight = find_weight_copy(weight, WEIGHT_COPY_CHANNEL_LAST, size);
+  if (p->packed_weight != 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  p->packed_weight = rt_malloc_func(size);
+  if (p->packed_weight == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  for (g = 0; g < c->group; g++) {
+    float *packed = p->packed_weight + g * rows * out_vars;
+    for (o = 0; o < out_vars; o++) {
+      const float *w = weight + (g * out_vars + o) * rows;
+      for (k = 0; k < rows; k++) {
+        packed[k * out_vars + o] = w[k];
+      }
+    }
+  }
+  add_weight_copy(weight, WEIGHT_COPY_CHANNEL_LAST, size, p->packed_weight);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Fill rows [begin, end) of im2col buffer for output positions from first.
+static void im2col_channel_last_range(void *arg, int begin, int end) {
+  convolution_channel_last_job_t *job = (convolution_channel_last_job_t *)arg;
+  convolution_local_context_t *c = job->c;
+  convolution_private_t *p = job->p;
+  int in_vars = p->in_var.shape.data[I];
+  int channels = in_vars * c->group;
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int rows = in_vars * kernel_size;
+  const float *x = job->input + job->group * in_vars;
+  int kernel_position_data[CONV_MAX_SPATIAL_DIMS];
+  int out_position_data[CONV_MAX_SPATIAL_DIMS];
+  int in_position_data[CONV_MAX_SPATIAL_DIMS];
+  rt_list_t kernel_position = {p->spatial_dims, kernel_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  int o, k, j;
+
+  for (o = begin; o < end; o++) {
+    float *col = p->col + o * rows;
+    pos_to_shape(out_position, p->output_shape, job->first + o);
+    for (k = 0; k < kernel_size; k++, col += in_vars) {
+      uint8_t condition = 1;
+      pos_to_shape(kernel_position, p->kernel_shape, k);
+      for (j = 0; j < p->spatial_dims; j++) {
+        in_position_data[j] = out_position_data[j] * c->stride.data[j] -
+                              c->pad.data[j] +
+                              kernel_position_data[j] * c->dilation.data[j];
+        if (in_position_data[j] < 0 ||
+            in_position_data[j] >= p->input_shape.data[j]) {
+          condition = 0;
+          break;
+        }
+      }
+      if (condition) {
+        memcpy(col, x + shape_to_pos(p->input_shape, in_position) * channels,
+               sizeof(float) * in_vars);
+      } else {
+        memset(col, 0, sizeof(float) * in_vars);
+      }
+    }
+  }
+}
+
+// Calculate outputs of im2col rows [begin, end), then apply alpha, bias and
+// epilogue.
+static void gemm_channel_last_range(void *arg, int begin, int end) {
+  convolution_channel_last_job_t *job = (convolution_channel_last_job_t *)arg;
+  convolution_local_context_t *c = job->c;
+  convolution_private_t *p = job->p;
+  int out_vars = p->out_var.shape.data[I];
+  int channels = out_vars * c->group;
+  int rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  const float *weight = p->packed_weight + job->group * rows * out_vars;
+  const float *alpha =
+      p->a_var.v ? (float *)(p->a_var.v->data) + job->group * out_vars : 0;
+  const float *bias =
+      p->b_var.v ? (float *)(p->b_var.v->data) + job->group * out_vars : 0;
+  float *output = job->output + job->first * channels + job->group * out_vars;
+  int o, j;
+
+  sgemm(end - begin, out_vars, rows, job->col + begin * rows, rows, 1, weight,
+        out_vars, 1, output + begin * channels, channels);
+  for (o = begin; o < end; o++) {
+    float *y = output + o * channels;
+    if (alpha) {
+      for (j = 0; j < out_vars; j++) {
+        y[j] *= alpha[j];
+      }
+    }
+    if (bias) {
+      for (j = 0; j < out_vars; j++) {
+        y[j] += bias[j];
+      }
+    }
+    apply_epilogue(&p->epilogue, y, out_vars);
+  }
+}
+
+void exec_convolution_channel_last(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int output_size = calc_shape_size(p->output_shape);
+  int out_vars = p->out_var.shape.data[I];
+  convolution_channel_last_job_t job;
+  int b;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->out_var.shape.data[B]; b++) {
+    job.input = (float *)(p->in_var.v->data) + b * p->in_var.stride.data[B];
+    job.output = (float *)(p->out_var.v->data) + b * p->out_var.stride.data[B];
+    for (job.group = 0; job.group < c->group; job.group++) {
+      for (job.first = 0; job.first < output_size;
+           job.first += p->col_columns) {
+        int columns = output_size - job.first < p->col_columns
+                          ? output_size - job.first
+                          : p->col_columns;
+        if (p->pointwise) {
+          // Whole input is one tile, its rows are im2col rows of group 1.
+          job.col = job.input;
+        } else {
+          job.col = p->col;
+          rt_parallel_for(columns, rows, im2col_channel_last_range, &job);
+        }
+        rt_parallel_for(columns, rows * out_vars, gemm_channel_last_range,
+                        &job);
+      }
+    }
+  }
+}
@@ -17,9 +17,62 @@
 #include <math.h>
 #include <nnablart/functions.h>
 
+// Output positions of im2col buffer which fit in CONV_IM2COL_MAX_SIZE.
+static size_t fit_columns(size_t rows, size_t columns) {
+  if (rows * columns * sizeof(float) > CONV_IM2COL_MAX_SIZE) {
+    return CONV_IM2COL_MAX_SIZE / (rows * sizeof(float));
+  }
+  return columns;
+}
+
+int is_square_conv2d(convolution_local_context_t *c, convolution_private_t *p) {
+  return p->spatial_dims == 2 &&
+         p->kernel_shape.data[0] == p->kernel_shape.data[1] &&
+         c->stride.data[0] == c->stride.data[1] && c->dilation.data[0] == 1 &&
+         c->dilation.data[1] == 1;
+}
+
+// Range [begin, end) of outputs whose window of size kernel does not cross
+// borders of input of size in.
+static void interior_range(int in, int out, int pad, int kernel, int stride,
+                           int *begin, int *end) {
+  *begin = (pad + stride - 1) / stride;
+  *end = in - kernel + pad >= 0 ? (in - kernel + pad) / stride + 1 : 0;
+  if (*end > out) {
+    *end = out;
+  }
+  if (*begin > out) {
+    *begin = out;
+  }
+  if (*end < *begin) {
+    *end = *begin;
+  }
+}
+
+void init_conv2d_job(conv2d_job_t *job, rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+
+  job->f = f;
+  job->ih = p->input_shape.data[0];
+  job->iw = p->input_shape.data[1];
+  job->oh = p->output_shape.data[0];
+  job->ow = p->output_shape.data[1];
+  job->pad_y = c->pad.data[0];
+  job->pad_x = c->pad.data[1];
+  job->kernel = p->kernel_shape.data[0];
+  job->stride = c->stride.data[0];
+  interior_range(job->ih, job->oh, job->pad_y, job->kernel, job->stride,
+                 &job->y_begin, &job->y_end);
+  interior_range(job->iw, job->ow, job->pad_x, job->kernel, job->stride,
+                 &job->x_begin, &job->x_end);
+}
+
 rt_function_error_t
 allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
-                                          int bias, int alpha, int y0) {
+                                          int bias, int alpha, int y0,
+                                          int channel_last) {
   convolution_local_context_t *c =
       (convolution_local_context_t *)(f->local_context);
   int i;
@@ -35,10 +88,18 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
   rt_list_t in_shape = f->inputs[x]->shape;
   rt_list_t w_shape = f->inputs[weight]->shape;
   int spatial_dims = in_shape.size - c->base_axis - 1;
+  // Input is (batch..., channel, spatial...) or (batch..., spatial...,
+  // channel), weight is (out, in, kernel...) or (out, kernel..., in).
+  int channel_axis = channel_last ? in_shape.size - 1 : c->base_axis;
+  int spatial_axis = channel_last ? c->base_axis : c->base_axis + 1;
+  int kernel_axis = channel_last ? 1 : 2;
 
   if (c->base_axis >= in_shape.size - 1) {
     return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
   }
+  if (spatial_dims > CONV_MAX_SPATIAL_DIMS) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
 
   convolution_private_t *p = rt_malloc_func(sizeof(convolution_private_t));
   if (p == 0) {
@@ -46,27 +107,31 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
   }
   c->data = (void *)p;
 
-  if (in_shape.data[c->base_axis] % c->group != 0) {
+  if (in_shape.data[channel_axis] % c->group != 0) {
     return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
   }
 
   p->in_var.shape = allocate_list(spatial_dims + 3);
+  p->out_var.shape = allocate_list(spatial_dims + 3);
+  p->w_var.shape = allocate_list(spatial_dims + 3);
+  if (p->in_var.shape.data == 0 || p->out_var.shape.data == 0 ||
+      p->w_var.shape.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->in_var.shape.data[B] = 1;
   for (i = 0; i < c->base_axis; ++i) {
     p->in_var.shape.data[B] *= in_shape.data[i];
   }
   p->in_var.shape.data[G] = c->group;
-  p->in_var.shape.data[I] = in_shape.data[c->base_axis] / c->group;
+  p->in_var.shape.data[I] = in_shape.data[channel_axis] / c->group;
 
-  p->out_var.shape = allocate_list(spatial_dims + 3);
   p->out_var.shape.data[B] = p->in_var.shape.data[B];
   p->out_var.shape.data[G] = c->group;
   p->out_var.shape.data[I] = w_shape.data[0] / c->group;
 
   for (i = 0; i < spatial_dims; ++i) {
-    int k = w_shape.data[i + 2];
-    int dims = p->in_var.shape.data[i + 3] =
-        in_shape.data[c->base_axis + 1 + i];
+    int k = w_shape.data[kernel_axis + i];
+    int dims = p->in_var.shape.data[i + 3] = in_shape.data[spatial_axis + i];
     int ks = c->dilation.data[i] * (k - 1) + 1;
     int o = (dims + 2 * c->pad.data[i] - ks) / c->stride.data[i] + 1;
     p->out_var.shape.data[i + 3] = o;
@@ -84,12 +149,11 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
   p->w_var.v = f->inputs[weight];
   p->w_var.get = select_getter(f->inputs[weight]);
   p->w_var.offset = 0;
-  p->w_var.shape = allocate_list(spatial_dims + 3);
   p->w_var.shape.data[KG] = c->group;
   p->w_var.shape.data[KO] = w_shape.data[0] / c->group;
-  p->w_var.shape.data[KI] = w_shape.data[1];
+  p->w_var.shape.data[KI] = w_shape.data[channel_last ? spatial_dims + 1 : 1];
   for (i = 0; i < spatial_dims; i++) {
-    p->w_var.shape.data[i + 3] = w_shape.data[i + 2];
+    p->w_var.shape.data[i + 3] = w_shape.data[kernel_axis + i];
   }
   p->w_var.stride = calc_contiguous_strides(p->w_var.shape);
 
@@ -98,6 +162,9 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
     p->b_var.get = select_getter(f->inputs[bias]);
     p->b_var.offset = 0;
     p->b_var.shape = allocate_list(2);
+    if (p->b_var.shape.data == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     p->b_var.shape.data[KG] = c->group;
     p->b_var.shape.data[KO] = f->inputs[bias]->shape.data[0] / c->group;
     p->b_var.stride = calc_contiguous_strides(p->b_var.shape);
@@ -110,6 +177,9 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
     p->a_var.get = select_getter(f->inputs[alpha]);
     p->a_var.offset = 0;
     p->a_var.shape = allocate_list(2);
+    if (p->a_var.shape.data == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     p->a_var.shape.data[KG] = c->group;
     p->a_var.shape.data[KO] = f->inputs[alpha]->shape.data[0] / c->group;
     p->a_var.stride = calc_contiguous_strides(p->a_var.shape);
@@ -122,12 +192,149 @@ allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
   p->output_shape = allocate_list(p->spatial_dims);
   p->in_position = allocate_list(p->spatial_dims);
   p->out_position = allocate_list(p->spatial_dims);
+  if (p->in_var.stride.data == 0 || p->out_var.stride.data == 0 ||
+      p->w_var.stride.data == 0 ||
+      (p->b_var.v && p->b_var.stride.data == 0) ||
+      (p->a_var.v && p->a_var.stride.data == 0) ||
+      p->input_shape.data == 0 || p->kernel_shape.data == 0 ||
+      p->output_shape.data == 0 || p->in_position.data == 0 ||
+      p->out_position.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   for (i = 0; i < p->spatial_dims; i++) {
     p->kernel_shape.data[i] = p->w_var.shape.data[i + 3];
     p->input_shape.data[i] = p->in_var.shape.data[i + 3];
     p->output_shape.data[i] = p->out_var.shape.data[i + 3];
   }
+
+  p->epilogue.type = RT_EPILOGUE_NONE;
+  p->epilogue.alpha = 0.0f;
+  p->kernel = RT_KERNEL_DEFAULT;
+  p->depthwise_map = 0;
+
+  // Float 3x3 convolution with stride 1 is executed by Winograd algorithm,
+  // 1x1 convolution as GEMM of weight and input, others as GEMM of weight and
+  // im2col of input.
+  p->channel_last = channel_last;
+  p->col = 0;
+  p->winograd_weight = 0;
+  p->winograd_tiles = 0;
+  p->packed_weight = 0;
+  p->pointwise = 0;
+  p->panel_weight = 0;
+  p->fixed_col = 0;
+  p->fixed_bias = 0;
+  p->fixed_scale = 0;
+  p->fixed_dot = 0;
+  p->fixed_weight = 0;
+  p->sign_weight = 0;
+  p->sign_col = 0;
+  p->dense_weight.data = 0;
+  select_conv2d_direct(c, p);
+  int is_float = f->outputs[y0]->type == NN_DATA_TYPE_FLOAT;
+  for (i = 0; i < f->num_of_inputs; i++) {
+    if (f->inputs[i]->type != NN_DATA_TYPE_FLOAT &&
+        !(i == weight && is_half_type(f->inputs[i]->type))) {
+      is_float = 0;
+    }
+  }
+  if (is_float && is_half_type(p->w_var.v->type)) {
+    // Float kernels read weight converted once here.
+    rt_function_error_t ret =
+        expand_half_variable(p->w_var.v, &p->dense_weight);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
+    p->w_var.v = &p->dense_weight;
+    p->w_var.get = select_getter(p->w_var.v);
+  }
+  if (p->w_var.v->layout == NN_DATA_LAYOUT_BLOCK_SPARSE) {
+    if (is_float && is_sparse_convolution(c, p)) {
+      return RT_FUNCTION_ERROR_NOERROR;
+    }
+    // Other kernels read dense weight.
+    rt_function_error_t ret =
+        expand_sparse_variable(p->w_var.v, &p->dense_weight);
+    if (ret != RT_FUNCTION_ERROR_NOERROR) {
+      return ret;
+    }
+    p->w_var.v = &p->dense_weight;
+    p->w_var.get = select_getter(p->w_var.v);
+  }
+  if (!is_float && is_fixed8_convolution(p)) {
+    // Convolution is executed with getters and setters if allocation failed.
+    allocate_convolution_fixed8(c, p);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (is_sign_convolution(p)) {
+    // Same as above.
+    allocate_convolution_sign(c, p);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (is_float && is_pointwise_convolution(c, p)) {
+    p->pointwise = 1;
+    p->col_columns = calc_shape_size(p->output_shape);
+    if (channel_last) {
+      return allocate_convolution_channel_last(c, p);
+    }
+    allocate_convolution_panels(c, p);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  // Winograd transformed weight is 16/9 times larger than weight, GEMM is
+  // used if it does not fit in prepack budget.
+  int is_winograd =
+      is_float && !channel_last && is_winograd_convolution(c, p) &&
+      reserve_prepack_budget(sizeof(float) * WINOGRAD_TILE_SIZE * c->group *
+                             p->in_var.shape.data[I] *
+                             p->out_var.shape.data[I]);
+  // GEMM shares buffer with Winograd only if both are kept to select one.
+  int candidates = keep_kernel_candidates() && !channel_last;
+  size_t rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  size_t columns = fit_columns(rows, calc_shape_size(p->output_shape));
+  size_t winograd_rows = WINOGRAD_TILE_SIZE * p->in_var.shape.data[I];
+  size_t tiles = 0;
+  if (channel_last && columns == 0) {
+    // Channel last is executed only by GEMM.
+    columns = 1;
+  }
+  if (is_winograd) {
+    tiles = fit_columns(winograd_rows, ((p->output_shape.data[0] + 1) / 2) *
+                                           ((p->output_shape.data[1] + 1) / 2));
+  }
+  size_t size = 0;
+  if (tiles > 0) {
+    size = winograd_rows * tiles;
+  }
+  if (!is_winograd || candidates) {
+    size = rows * columns > size ? rows * columns : size;
+  } else {
+    columns = 0;
+  }
+  p->col_columns = columns;
+  p->winograd_tiles = tiles;
+  if (is_float && size > 0) {
+    // Convolution is executed directly if allocation failed.
+    p->col = rt_malloc_func(size * sizeof(float));
+    if (p->col != 0 && tiles > 0 &&
+        allocate_convolution_winograd(c, p) != RT_FUNCTION_ERROR_NOERROR &&
+        columns == 0) {
+      rt_free_func(p->col);
+      p->col = 0;
+    }
+    if (p->col != 0 && channel_last &&
+        allocate_convolution_channel_last(c, p) != RT_FUNCTION_ERROR_NOERROR) {
+      rt_free_func(p->col);
+      p->col = 0;
+    }
+    if (p->col != 0 && columns > 0 && !channel_last) {
+      allocate_convolution_panels(c, p);
+    }
+  }
+  if (channel_last && p->col == 0) {
+    return is_float ? RT_FUNCTION_ERROR_MALLOC
+                    : RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
@@ -152,6 +359,27 @@ rt_function_error_t free_convolution_local_context_common(rt_function_t *f) {
   free_list(p->in_position);
   free_list(p->out_position);
   free_list(p->output_shape);
+  if (p->col != 0) {
+    rt_free_func(p->col);
+  }
+  free_weight_copy(p->winograd_weight);
+  free_weight_copy(p->packed_weight);
+  free_weight_copy(p->panel_weight);
+  if (p->fixed_col != 0) {
+    rt_free_func(p->fixed_col);
+  }
+  if (p->fixed_bias != 0) {
+    rt_free_func(p->fixed_bias);
+  }
+  if (p->fixed_scale != 0) {
+    rt_free_func(p->fixed_scale);
+  }
+  free_weight_copy(p->fixed_weight);
+  free_weight_copy(p->sign_weight);
+  if (p->sign_col != 0) {
+    rt_free_func(p->sign_col);
+  }
+  free_dense_variable(&p->dense_weight);
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -0,0 +1,458 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "convolution_internal.h"
+
+#include "../../../utilities/neon.h"
+#include "../../../utilities/shape.h"
+#include "../../../utilities/x86.h"
+
+#include <math.h>
+#include <nnablart/functions.h>
+#include <string.h>
+
+/*
+ * Convolution of int8 input and int8 weight. Input is copied into int8
+ * im2col buffer and multiplied with weight accumulating products in int32.
+ * Accumulator has fixed point position of input plus weight, each output is
+ * converted to its own type once at the end. Weight with per channel
+ * quantization has a scale for each output map instead of fixed point
+ * position, and accumulators are converted with it.
+ *
+ * With dot product instructions, i.e. sdot of ARMv8.2 or vpdpbusd of
+ * AVX-512 VNNI selected at run time, each 4 rows of im2col buffer are
+ * interleaved so that 4 bytes of a column are multiplied with 4 bytes of a
+ * weight row at once. Rows are padded to a multiple of 4 with zero weight.
+ * vpdpbusd multiplies unsigned with signed bytes, so im2col buffer holds
+ * input plus 128 and 128 times sum of each weight row is taken from bias.
+ */
+
+#define GEMM_BLOCK_N (256) // Output positions accumulated at once
+#define DOT_ROWS (4)       // Output maps multiplied at once by dot products
+#define DOT_COLUMNS (16)   // Columns of im2col buffer are multiple of this
+
+#if defined(NNABLART_NEON) && defined(__ARM_FEATURE_DOTPROD)
+#define FIXED8_SDOT
+#endif
+
+#if defined(FIXED8_SDOT) || defined(NNABLART_X86_DISPATCH)
+#define FIXED8_DOT
+#endif
+
+enum { FIXED8_DOT_NONE = 0, FIXED8_DOT_SDOT = 1, FIXED8_DOT_VNNI = 2 };
+
+typedef struct {
+  convolution_local_context_t *c;
+  convolution_private_t *p;
+  const int8_t *input;  ///< Input maps of current batch and group.
+  const int8_t *weight; ///< Weight of current group.
+  int output;           ///< Offset of output maps of current batch and group.
+  int group;            ///< Current group.
+  int first;            ///< First output position in im2col buffer.
+  int columns;          ///< Number of output positions in im2col buffer.
+  int ldb;              ///< Columns rounded up to DOT_COLUMNS with fixed_dot.
+} convolution_fixed8_job_t;
+
+int is_fixed8_convolution(convolution_private_t *p) {
+  nn_data_type_t y = p->out_var.v->type;
+  if (p->channel_last || p->a_var.v ||
+      p->in_var.v->type != NN_DATA_TYPE_INT8 ||
+      p->w_var.v->type != NN_DATA_TYPE_INT8) {
+    return 0;
+  }
+  if (p->b_var.v && p->b_var.v->type == NN_DATA_TYPE_SIGN) {
+    return 0;
+  }
+  if (p->in_var.v->quantization || p->out_var.v->quantization ||
+      !has_row_scales(p->w_var.v, p->in_var.shape.data[I] *
+                                      calc_shape_size(p->kernel_shape))) {
+    return 0;
+  }
+  return y == NN_DATA_TYPE_FLOAT || y == NN_DATA_TYPE_INT16 ||
+         y == NN_DATA_TYPE_INT8;
+}
+
+static int select_fixed8_dot(void) {
+#if defined(FIXED8_SDOT)
+  return FIXED8_DOT_SDOT;
+#elif defined(NNABLART_X86_DISPATCH)
+  return x86_cpu_features() & X86_FEATURE_VNNI ? FIXED8_DOT_VNNI
+                                               : FIXED8_DOT_NONE;
+#else
+  return FIXED8_DOT_NONE;
+#endif
+}
+
+static rt_function_error_t free_fixed8_areas(convolution_private_t *p) {
+  if (p->fixed_col) {
+    rt_free_func(p->fixed_col);
+    p->fixed_col = 0;
+  }
+  if (p->fixed_scale) {
+    rt_free_func(p->fixed_scale);
+    p->fixed_scale = 0;
+  }
+  if (p->fixed_bias) {
+    rt_free_func(p->fixed_bias);
+    p->fixed_bias = 0;
+  }
+  free_weight_copy(p->fixed_weight);
+  p->fixed_weight = 0;
+  return RT_FUNCTION_ERROR_MALLOC;
+}
+
+// Copy weight into rows of k4 bytes unless rows already are.
+static int pad_fixed8_weight(convolution_private_t *p, int num_of_outputs,
+                             int rows, int k4) {
+  const int8_t *weight = (const int8_t *)(p->w_var.v->data);
+  size_t size = (size_t)num_of_outputs * k4;
+  int i; // Iterator
+
+  if (rows == k4) {
+    return 1;
+  }
+  p->fixed_weight = find_weight_copy(weight, WEIGHT_COPY_FIXED8_DOT, size);
+  if (p->fixed_weight) {
+    return 1;
+  }
+  p->fixed_weight = rt_malloc_func(size);
+  if (p->fixed_weight == 0) {
+    return 0;
+  }
+  for (i = 0; i < num_of_outputs; i++) {
+    memcpy(p->fixed_weight + i * k4, weight + i * rows, rows);
+    memset(p->fixed_weight + i * k4 + rows, 0, k4 - rows);
+  }
+  add_weight_copy(weight, WEIGHT_COPY_FIXED8_DOT, size, p->fixed_weight);
+  return 1;
+}
+
+rt_function_error_t
+allocate_convolution_fixed8(convolution_local_context_t *c,
+                            convolution_private_t *p) {
+  size_t rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  size_t columns = calc_shape_size(p->output_shape);
+  size_t size;
+  int num_of_outputs = c->group * p->out_var.shape.data[I];
+  int fp_pos = p->in_var.v->fp_pos + p->w_var.v->fp_pos;
+  int i; // Iterator
+
+  if (rows * columns > CONV_IM2COL_MAX_SIZE) {
+    columns = CONV_IM2COL_MAX_SIZE / rows;
+  }
+  if (columns == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->fixed_dot = select_fixed8_dot();
+  size = rows * columns;
+  if (p->fixed_dot) {
+    // Padding rows stay zero, padding columns are not stored.
+    size_t k4 = (rows + 3) / 4 * 4;
+    if (!pad_fixed8_weight(p, num_of_outputs, (int)rows, (int)k4)) {
+      return free_fixed8_areas(p);
+    }
+    size = k4 * ((columns + DOT_COLUMNS - 1) / DOT_COLUMNS * DOT_COLUMNS);
+  }
+  p->fixed_col = rt_malloc_func(size);
+  if (p->fixed_col == 0) {
+    return free_fixed8_areas(p);
+  }
+  memset(p->fixed_col, 0, size);
+  p->col_columns = columns;
+
+  if (p->w_var.v->quantization) {
+    p->fixed_scale = rt_malloc_func(sizeof(float) * num_of_outputs);
+    if (p->fixed_scale == 0) {
+      return free_fixed8_areas(p);
+    }
+    for (i = 0; i < num_of_outputs; i++) {
+      p->fixed_scale[i] = p->in_var.v->coefficient *
+                          get_row_scale(p->w_var.v, i, (int)rows);
+    }
+  }
+
+  // Bias is converted to fixed point position or scale of accumulator.
+  if (p->b_var.v || p->fixed_dot == FIXED8_DOT_VNNI) {
+    p->fixed_bias = rt_malloc_func(sizeof(int32_t) * num_of_outputs);
+    if (p->fixed_bias == 0) {
+      return free_fixed8_areas(p);
+    }
+    for (i = 0; i < num_of_outputs; i++) {
+      double bias = p->b_var.v ? p->b_var.get(p->b_var.v, i) : 0;
+      bias = p->fixed_scale ? bias / p->fixed_scale[i] : ldexp(bias, fp_pos);
+      bias = bias >= INT32_MAX ? INT32_MAX : bias <= INT32_MIN ? INT32_MIN
+                                                               : bias;
+      p->fixed_bias[i] = (int32_t)floor(bias + 0.5);
+    }
+  }
+  if (p->fixed_dot == FIXED8_DOT_VNNI) {
+    const int8_t *weight = (const int8_t *)(p->w_var.v->data);
+    size_t l; // Iterator
+    for (i = 0; i < num_of_outputs; i++) {
+      int32_t sum = 0;
+      for (l = 0; l < rows; l++) {
+        sum += weight[i * rows + l];
+      }
+      p->fixed_bias[i] -= 128 * sum;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Fill rows [begin, end) of im2col buffer. Row (im * kernel_size + k) holds
+// input values multiplied with kernel position k of input map im, with
+// fixed_dot each 4 rows are interleaved in groups of job->ldb columns.
+static void im2col_fixed8_range(void *arg, int begin, int end) {
+  convolution_fixed8_job_t *job = (convolution_fixed8_job_t *)arg;
+  convolution_local_context_t *c = job->c;
+  convolution_private_t *p = job->p;
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int input_size = p->in_var.stride.data[I];
+  int *pad = c->pad.data;
+  int *stride = c->stride.data;
+  int *dilation = c->dilation.data;
+  int kernel_position_data[CONV_MAX_SPATIAL_DIMS];
+  int out_position_data[CONV_MAX_SPATIAL_DIMS];
+  int in_position_data[CONV_MAX_SPATIAL_DIMS];
+  rt_list_t kernel_position = {p->spatial_dims, kernel_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  int step = p->fixed_dot ? 4 : 1;
+  uint8_t offset = p->fixed_dot == FIXED8_DOT_VNNI ? 0x80 : 0;
+  int r, o, j;
+
+  for (r = begin; r < end; r++) {
+    const uint8_t *x =
+        (const uint8_t *)job->input + (r / kernel_size) * input_size;
+    uint8_t *col = (uint8_t *)p->fixed_col +
+                   (p->fixed_dot ? r / 4 * job->ldb * 4 + r % 4
+                                 : r * job->columns);
+    pos_to_shape(kernel_position, p->kernel_shape, r % kernel_size);
+    for (o = 0; o < job->columns; o++) {
+      uint8_t condition = 1;
+      pos_to_shape(out_position, p->output_shape, job->first + o);
+      for (j = 0; j < p->spatial_dims; j++) {
+        in_position_data[j] = out_position_data[j] * stride[j] - pad[j] +
+                              kernel_position_data[j] * dilation[j];
+        if (in_position_data[j] < 0 ||
+            in_position_data[j] >= p->input_shape.data[j]) {
+          condition = 0;
+          break;
+        }
+      }
+      col[o * step] =
+          (condition ? x[shape_to_pos(p->input_shape, in_position)] : 0) ^
+          offset;
+    }
+  }
+}
+
+// Convert accumulators of output map to output type with truncation and
+// saturation same as setters of variables.
+static void store_fixed8_outputs(convolution_private_t *p, int map,
+                                 int offset, const int32_t *acc, int size) {
+  rt_variable_t *y = p->out_var.v;
+  int shift = p->in_var.v->fp_pos + p->w_var.v->fp_pos - y->fp_pos;
+  int32_t min = y->type == NN_DATA_TYPE_INT8 ? INT8_MIN : INT16_MIN;
+  int32_t max = y->type == NN_DATA_TYPE_INT8 ? INT8_MAX : INT16_MAX;
+  int j; // Iterator
+
+  if (p->fixed_scale) {
+    float block[GEMM_BLOCK_N];
+    for (j = 0; j < size; j++) {
+      block[j] = acc[j] * p->fixed_scale[map];
+    }
+    set_variable_block(y, offset, size, block);
+    return;
+  }
+  if (y->type == NN_DATA_TYPE_FLOAT) {
+    float scale = p->in_var.v->coefficient * p->w_var.v->coefficient;
+    float *output = (float *)(y->data) + offset;
+    for (j = 0; j < size; j++) {
+      output[j] = acc[j] * scale;
+    }
+    return;
+  }
+  for (j = 0; j < size; j++) {
+    int64_t v = acc[j];
+    if (shift > 0) {
+      // Round toward zero.
+      v = (v + (v < 0 ? ((int64_t)1 << shift) - 1 : 0)) >> shift;
+    } else {
+      v *= (int64_t)1 << -shift;
+    }
+    v = v > max ? max : v < min ? min : v;
+    if (y->type == NN_DATA_TYPE_INT8) {
+      ((int8_t *)(y->data))[offset + j] = (int8_t)v;
+    } else {
+      ((int16_t *)(y->data))[offset + j] = (int16_t)v;
+    }
+  }
+}
+
+// Calculate output maps [begin, end) at positions in im2col buffer as
+// product of weight and im2col buffer.
+static void gemm_fixed8_range(void *arg, int begin, int end) {
+  convolution_fixed8_job_t *job = (convolution_fixed8_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int n = job->columns;
+  int k = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int32_t acc[GEMM_BLOCK_N];
+  int om, jb, j, l;
+
+  for (om = begin; om < end; om++) {
+    const int8_t *w = job->weight + om * k;
+    int32_t bias =
+        p->fixed_bias ? p->fixed_bias[job->group * out_vars + om] : 0;
+    for (jb = 0; jb < n; jb += GEMM_BLOCK_N) {
+      int m = n - jb < GEMM_BLOCK_N ? n - jb : GEMM_BLOCK_N;
+      for (j = 0; j < m; j++) {
+        acc[j] = bias;
+      }
+      for (l = 0; l < k; l++) {
+        const int32_t a = w[l];
+        const int8_t *col = p->fixed_col + l * n + jb;
+        for (j = 0; j < m; j++) {
+          acc[j] += a * col[j];
+        }
+      }
+      store_fixed8_outputs(p, job->group * out_vars + om,
+                           job->output + om * output_size + job->first + jb,
+                           acc, m);
+    }
+  }
+}
+
+#ifdef FIXED8_DOT
+#ifdef FIXED8_SDOT
+// Same as vnni_gemm_u8s8() of x86.h for signed b and n multiple of 8.
+static void sdot_gemm_s8(int rows, int n, int k4, const int8_t *a, int lda,
+                         const int8_t *b, int ldb, int32_t *c, int ldc) {
+  int j, l, r;
+  for (j = 0; j < n; j += 8) {
+    int32x4_t acc[DOT_ROWS][2];
+    for (r = 0; r < DOT_ROWS; r++) {
+      acc[r][0] = acc[r][1] = vdupq_n_s32(0);
+    }
+    for (l = 0; l < k4; l += 4) {
+      int8x16_t b0 = vld1q_s8(b + l * ldb + j * 4);
+      int8x16_t b1 = vld1q_s8(b + l * ldb + j * 4 + 16);
+      for (r = 0; r < DOT_ROWS; r++) {
+        // Missing rows repeat last one and are not stored.
+        int32_t w;
+        int8x16_t a0;
+        memcpy(&w, a + (r < rows ? r : rows - 1) * lda + l, sizeof(w));
+        a0 = vreinterpretq_s8_s32(vdupq_n_s32(w));
+        acc[r][0] = vdotq_s32(acc[r][0], b0, a0);
+        acc[r][1] = vdotq_s32(acc[r][1], b1, a0);
+      }
+    }
+    for (r = 0; r < rows; r++) {
+      int32_t *y = c + r * ldc + j;
+      vst1q_s32(y, vaddq_s32(vld1q_s32(y), acc[r][0]));
+      vst1q_s32(y + 4, vaddq_s32(vld1q_s32(y + 4), acc[r][1]));
+    }
+  }
+}
+#endif
+
+// Same as gemm_fixed8_range() for DOT_ROWS output maps at once with
+// fixed_dot.
+static void gemm_fixed8_dot_range(void *arg, int begin, int end) {
+  convolution_fixed8_job_t *job = (convolution_fixed8_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int n = job->columns;
+  int k = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int k4 = (k + 3) / 4 * 4;
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int32_t acc[DOT_ROWS][GEMM_BLOCK_N];
+  int om, jb, r, j;
+
+  for (om = begin; om < end; om += DOT_ROWS) {
+    int rows = end - om < DOT_ROWS ? end - om : DOT_ROWS;
+    const int8_t *w = job->weight + om * k4;
+    const int8_t *col = p->fixed_col;
+    for (jb = 0; jb < n; jb += GEMM_BLOCK_N) {
+      int m = n - jb < GEMM_BLOCK_N ? n - jb : GEMM_BLOCK_N;
+      int width = (m + DOT_COLUMNS - 1) / DOT_COLUMNS * DOT_COLUMNS;
+      for (r = 0; r < rows; r++) {
+        int32_t bias =
+            p->fixed_bias ? p->fixed_bias[job->group * out_vars + om + r] : 0;
+        for (j = 0; j < width; j++) {
+          acc[r][j] = bias;
+        }
+      }
+#ifdef FIXED8_SDOT
+      sdot_gemm_s8(rows, width, k4, w, k4, col + jb * 4, job->ldb, acc[0],
+                   GEMM_BLOCK_N);
+#else
+      vnni_gemm_u8s8(rows, width, k4, w, k4, (const uint8_t *)col + jb * 4,
+                     job->ldb, acc[0], GEMM_BLOCK_N);
+#endif
+      for (r = 0; r < rows; r++) {
+        store_fixed8_outputs(
+            p, job->group * out_vars + om + r,
+            job->output + (om + r) * output_size + job->first + jb, acc[r],
+            m);
+      }
+    }
+  }
+}
+#endif
+
+void exec_convolution_fixed8(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  convolution_fixed8_job_t job;
+  int b, g;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->out_var.shape.data[B]; b++) {
+    for (g = 0; g < c->group; g++) {
+      job.group = g;
+      job.input = (int8_t *)(p->in_var.v->data) + b * p->in_var.stride.data[B] +
+                  g * p->in_var.stride.data[G];
+      job.weight = (int8_t *)(p->w_var.v->data) + g * p->w_var.stride.data[KG];
+      if (p->fixed_weight) {
+        job.weight = p->fixed_weight + (g * out_vars) * ((rows + 3) / 4 * 4);
+      }
+      job.output =
+          b * p->out_var.stride.data[B] + g * p->out_var.stride.data[G];
+      for (job.first = 0; job.first < output_size;
+           job.first += p->col_columns) {
+        job.columns = output_size - job.first < p->col_columns
+                          ? output_size - job.first
+                          : p->col_columns;
+        job.ldb = (job.columns + DOT_COLUMNS - 1) / DOT_COLUMNS * DOT_COLUMNS;
+        rt_parallel_for(rows, job.columns, im2col_fixed8_range, &job);
+#ifdef FIXED8_DOT
+        if (p->fixed_dot) {
+          rt_parallel_for(out_vars, rows * job.columns, gemm_fixed8_dot_range,
+                          &job);
+          continue;
+        }
+#endif
+        rt_parallel_for(out_vars, rows * job.columns, gemm_fixed8_range, &job);
+      }
+    }
+  }
+}
@@ -16,6 +16,7 @@
 
 #include "../../../utilities/list.h"
 #include "../../../utilities/shape.h"
+#include "../../../utilities/specialized.h"
 
 #include <assert.h>
 #include <math.h>
@@ -139,7 +140,25 @@ static inline void mul_alpha(var_t *out, var_t *a) {
   }
 }
 
-rt_function_error_t exec_convolution_float(rt_function_t *f) {
+// Apply alpha, bias and epilogue to output map om of group g at out_var.
+static void finish_output_map(convolution_private_t *p, var_t *out_var,
+                              var_t *b_var, var_t *a_var, int g, int om) {
+  int b_pos[] = {g, om};
+  if (p->a_var.v) {
+    var_setpos(a_var, b_pos, _S(b_pos));
+    mul_alpha(out_var, a_var);
+  }
+  if (p->b_var.v) {
+    var_setpos(b_var, b_pos, _S(b_pos));
+    add_bias(out_var, b_var);
+  }
+  apply_epilogue(&p->epilogue, (float *)(out_var->v->data) + out_var->offset,
+                 out_var->stride.data[I]);
+}
+
+// Process output maps in [begin, end), index is (b * group + g) * out_vars + om
+static void convolution_float_range(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
   convolution_local_context_t *c =
       (convolution_local_context_t *)f->local_context;
   convolution_private_t *p = (convolution_private_t *)(c->data);
@@ -147,78 +166,522 @@ rt_function_error_t exec_convolution_float(rt_function_t *f) {
   nn_size_t group = c->group;
   nn_size_t in_vars = p->in_var.shape.data[I];
   nn_size_t out_vars = p->out_var.shape.data[I];
-  nn_size_t batch_size;
   nn_size_t om, im, g, b;
-  var_t *out_var = &p->out_var;
-  var_t *in_var = &p->in_var;
-  var_t *w_var = &p->w_var;
-  var_t *b_var = &p->b_var;
-  var_t *a_var = &p->a_var;
+  int index;
 
-  int output_size = calc_shape_size(p->out_var.shape);
+  // Each range works on its own copy of offsets and positions.
+  var_t out_var = p->out_var;
+  var_t in_var = p->in_var;
+  var_t w_var = p->w_var;
+  var_t b_var = p->b_var;
+  var_t a_var = p->a_var;
+  int in_position_data[CONV_MAX_SPATIAL_DIMS];
+  int out_position_data[CONV_MAX_SPATIAL_DIMS];
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
 
-  memset(out_var->v->data, 0, sizeof(float) * output_size);
-
-  batch_size = p->in_var.shape.data[0];
-  if (p->spatial_dims == 2) {
-    for (b = 0; b < batch_size; ++b) {
-      for (g = 0; g < group; ++g) {
-        for (om = 0; om < out_vars; ++om) {
-          int o_pos[] = {b, g, om};
-          var_setpos(out_var, o_pos, _S(o_pos));
-          for (im = 0; im < in_vars; ++im) {
-            int i_pos[] = {b, g, im};
-            int w_pos[] = {g, om, im};
-            var_setpos(in_var, i_pos, _S(i_pos));
-            var_setpos(w_var, w_pos, _S(w_pos));
-            conv2d(out_var, in_var, w_var, p->input_shape, p->output_shape,
-                   p->kernel_shape, p->in_position, p->out_position, c->pad,
-                   c->stride, c->dilation, p->spatial_dims);
-          }
-          {
-            int b_pos[] = {g, om};
-            if (p->a_var.v) {
-              var_setpos(a_var, b_pos, _S(b_pos));
-              mul_alpha(out_var, a_var);
-            }
-            if (p->b_var.v) {
-              var_setpos(b_var, b_pos, _S(b_pos));
-              add_bias(out_var, b_var);
-            }
-          }
+  for (index = begin; index < end; index++) {
+    om = index % out_vars;
+    g = (index / out_vars) % group;
+    b = index / (out_vars * group);
+    {
+      int o_pos[] = {b, g, om};
+      var_setpos(&out_var, o_pos, _S(o_pos));
+      for (im = 0; im < in_vars; ++im) {
+        int i_pos[] = {b, g, im};
+        int w_pos[] = {g, om, im};
+        var_setpos(&in_var, i_pos, _S(i_pos));
+        var_setpos(&w_var, w_pos, _S(w_pos));
+        if (p->spatial_dims == 2) {
+          conv2d(&out_var, &in_var, &w_var, p->input_shape, p->output_shape,
+                 p->kernel_shape, in_position, out_position, c->pad,
+                 c->stride, c->dilation, p->spatial_dims);
+        } else {
+          convnd(&out_var, &in_var, &w_var, p->input_shape, p->output_shape,
+                 p->kernel_shape, in_position, out_position, c->pad,
+                 c->stride, c->dilation, p->spatial_dims);
         }
       }
     }
-  } else {
-    for (b = 0; b < batch_size; ++b) {
-      for (g = 0; g < group; ++g) {
-        for (om = 0; om < out_vars; ++om) {
-          int o_pos[] = {b, g, om};
-          var_setpos(out_var, o_pos, _S(o_pos));
-          for (im = 0; im < in_vars; ++im) {
-            int i_pos[] = {b, g, im};
-            int w_pos[] = {g, om, im};
-            var_setpos(in_var, i_pos, _S(i_pos));
-            var_setpos(w_var, w_pos, _S(w_pos));
-            convnd(out_var, in_var, w_var, p->input_shape, p->output_shape,
-                   p->kernel_shape, p->in_position, p->out_position, c->pad,
-                   c->stride, c->dilation, p->spatial_dims);
-          }
-          {
-            int b_pos[] = {g, om};
-            if (p->a_var.v) {
-              var_setpos(a_var, b_pos, _S(b_pos));
-              mul_alpha(out_var, a_var);
-            }
-            if (p->b_var.v) {
-              var_setpos(b_var, b_pos, _S(b_pos));
-              add_bias(out_var, b_var);
-            }
+    finish_output_map(p, &out_var, &b_var, &a_var, g, om);
+  }
+}
+
+/*
+ * Direct 2D convolution for shapes listed in NNABLART_SPECIALIZED_CONVOLUTION.
+ * Each task calculates block output maps of a group. Output positions whose
+ * window is inside of input load each input value once for all block maps,
+ * with kernel size, stride and block as constants, so loops over taps and
+ * maps are unrolled and outputs are vectorized. Positions near borders check
+ * bounds for each tap.
+ */
+
+static void conv2d_direct_border(const conv2d_job_t *job, const float *x,
+                                 const float *w, int w_map, float *y,
+                                 int block, int oy, int ox) {
+  const int map = job->oh * job->ow;
+  int iy0 = oy * job->stride - job->pad_y;
+  int ix0 = ox * job->stride - job->pad_x;
+  int ky, kx, m;
+  for (ky = 0; ky < job->kernel; ky++) {
+    int iy = iy0 + ky;
+    if (iy < 0 || iy >= job->ih) {
+      continue;
+    }
+    for (kx = 0; kx < job->kernel; kx++) {
+      int ix = ix0 + kx;
+      if (ix >= 0 && ix < job->iw) {
+        const float v = x[iy * job->iw + ix];
+        for (m = 0; m < block; m++) {
+          y[m * map + oy * job->ow + ox] +=
+              v * w[m * w_map + ky * job->kernel + kx];
+        }
+      }
+    }
+  }
+}
+
+static inline void conv2d_direct(const conv2d_job_t *job, const float *x,
+                                 const float *w, int w_map, float *y,
+                                 const int kernel, const int stride,
+                                 const int block) {
+  const int map = job->oh * job->ow;
+  int oy, ox, ky, kx, m, j;
+
+  for (oy = 0; oy < job->oh; oy++) {
+    if (oy < job->y_begin || oy >= job->y_end) {
+      for (ox = 0; ox < job->ow; ox++) {
+        conv2d_direct_border(job, x, w, w_map, y, block, oy, ox);
+      }
+      continue;
+    }
+    for (ox = 0; ox < job->x_begin; ox++) {
+      conv2d_direct_border(job, x, w, w_map, y, block, oy, ox);
+    }
+    for (ox = job->x_end; ox < job->ow; ox++) {
+      conv2d_direct_border(job, x, w, w_map, y, block, oy, ox);
+    }
+
+    float *out = y + oy * job->ow + job->x_begin;
+    const float *in = x + (oy * stride - job->pad_y) * job->iw +
+                      job->x_begin * stride - job->pad_x;
+    for (j = 0; j < job->x_end - job->x_begin; j++) {
+      float acc[SPECIALIZED_CONVOLUTION_MAX_BLOCK];
+      for (m = 0; m < block; m++) {
+        acc[m] = out[m * map + j];
+      }
+      for (ky = 0; ky < kernel; ky++) {
+        for (kx = 0; kx < kernel; kx++) {
+          const float v = in[ky * job->iw + kx + j * stride];
+          for (m = 0; m < block; m++) {
+            acc[m] += v * w[m * w_map + ky * kernel + kx];
           }
         }
       }
+      for (m = 0; m < block; m++) {
+        out[m * map + j] = acc[m];
+      }
     }
   }
+}
+
+#define CONV2D_DIRECT(K, S, BLOCK)                                             \
+  typedef char conv2d_direct_block_##K##_##S##_##BLOCK                         \
+      [(BLOCK) <= SPECIALIZED_CONVOLUTION_MAX_BLOCK ? 1 : -1];                 \
+  static void conv2d_direct_##K##_##S##_##BLOCK(                               \
+      const conv2d_job_t *job, const float *x, const float *w, int w_map,      \
+      float *y) {                                                              \
+    conv2d_direct(job, x, w, w_map, y, K, S, BLOCK);                           \
+  }
+NNABLART_SPECIALIZED_CONVOLUTION(CONV2D_DIRECT)
+#undef CONV2D_DIRECT
+
+void select_conv2d_direct(convolution_local_context_t *c,
+                          convolution_private_t *p) {
+  int kernel = p->kernel_shape.data[0];
+  int stride = c->stride.data[0];
+  int maps = p->out_var.shape.data[I];
+
+  p->conv2d_direct = 0;
+  p->conv2d_block = 0;
+  if (p->channel_last || !is_square_conv2d(c, p)) {
+    return;
+  }
+#define CONV2D_DIRECT(K, S, BLOCK)                                             \
+  if (p->conv2d_direct == 0 && kernel == (K) && stride == (S) &&               \
+      maps % (BLOCK) == 0) {                                                   \
+    p->conv2d_direct = conv2d_direct_##K##_##S##_##BLOCK;                      \
+    p->conv2d_block = (BLOCK);                                                 \
+  }
+  NNABLART_SPECIALIZED_CONVOLUTION(CONV2D_DIRECT)
+#undef CONV2D_DIRECT
+  (void)kernel;
+  (void)stride;
+  (void)maps;
+}
+
+// Process blocks of output maps in [begin, end), index is
+// (b * group + g) * (out_vars / block) + om / block
+static void conv2d_direct_range(void *arg, int begin, int end) {
+  conv2d_job_t *job = (conv2d_job_t *)arg;
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)job->f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  const int block = p->conv2d_block;
+  const int blocks = p->out_var.shape.data[I] / block;
+  const int in_vars = p->in_var.shape.data[I];
+  const float *input = (const float *)(p->in_var.v->data);
+  const float *weight = (const float *)(p->w_var.v->data);
+  float *output = (float *)(p->out_var.v->data);
+  var_t out_var = p->out_var;
+  var_t b_var = p->b_var;
+  var_t a_var = p->a_var;
+  int index, im, m;
+
+  for (index = begin; index < end; index++) {
+    int om = (index % blocks) * block;
+    int g = (index / blocks) % c->group;
+    int b = index / (blocks * c->group);
+    int o_pos[] = {b, g, om};
+    int w_pos[] = {g, om};
+    var_setpos(&out_var, o_pos, _S(o_pos));
+    const float *x = input + b * p->in_var.stride.data[B] +
+                     g * p->in_var.stride.data[G];
+    const float *w = weight + var_calc_offset(&p->w_var, w_pos, _S(w_pos));
+    float *y = output + out_var.offset;
+
+    for (im = 0; im < in_vars; im++) {
+      p->conv2d_direct(job, x + im * p->in_var.stride.data[I],
+                       w + im * p->w_var.stride.data[KI],
+                       p->w_var.stride.data[KO], y);
+    }
+    for (m = 0; m < block; m++) {
+      int map_pos[] = {b, g, om + m};
+      var_setpos(&out_var, map_pos, _S(map_pos));
+      finish_output_map(p, &out_var, &b_var, &a_var, g, om + m);
+    }
+  }
+}
+
+static void exec_convolution_direct(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int num_of_tasks = p->out_var.shape.data[B] * c->group *
+                     (p->out_var.shape.data[I] / p->conv2d_block);
+  conv2d_job_t job;
+
+  init_conv2d_job(&job, f);
+  memset(p->out_var.v->data, 0,
+         sizeof(float) * calc_shape_size(p->out_var.shape));
+  rt_parallel_for(num_of_tasks,
+                  p->conv2d_block * job.oh * job.ow * p->in_var.shape.data[I] *
+                      job.kernel * job.kernel,
+                  conv2d_direct_range, &job);
+}
+
+int is_pointwise_convolution(convolution_local_context_t *c,
+                             convolution_private_t *p) {
+  int i; // Iterator
+  if (p->channel_last && c->group != 1) {
+    // Input positions of a group are not contiguous.
+    return 0;
+  }
+  for (i = 0; i < p->spatial_dims; i++) {
+    if (p->kernel_shape.data[i] != 1 || c->stride.data[i] != 1 ||
+        c->pad.data[i] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Columns of GEMM result processed at once, alpha, bias and epilogue are
+// applied while they are in cache.
+#define GEMM_BLOCK_N (256)
+
+typedef struct {
+  convolution_local_context_t *c;
+  convolution_private_t *p;
+  float *input;     ///< Input maps of current batch and group.
+  float *weight;    ///< Weight of current group.
+  float *output;    ///< Output maps of current batch and group.
+  const float *col; ///< im2col buffer, or input of pointwise convolution.
+  int group;        ///< Current group.
+  int first;        ///< First output position in im2col buffer.
+  int columns;      ///< Number of output positions in im2col buffer.
+} convolution_gemm_job_t;
+
+// Fill rows [begin, end) of im2col buffer. Row (im * kernel_size + k) holds
+// input values multiplied with kernel position k of input map im.
+static void im2col_range(void *arg, int begin, int end) {
+  convolution_gemm_job_t *job = (convolution_gemm_job_t *)arg;
+  convolution_local_context_t *c = job->c;
+  convolution_private_t *p = job->p;
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int input_size = p->in_var.stride.data[I];
+  int *pad = c->pad.data;
+  int *stride = c->stride.data;
+  int *dilation = c->dilation.data;
+  int kernel_position_data[CONV_MAX_SPATIAL_DIMS];
+  int out_position_data[CONV_MAX_SPATIAL_DIMS];
+  int in_position_data[CONV_MAX_SPATIAL_DIMS];
+  rt_list_t kernel_position = {p->spatial_dims, kernel_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  int r, o, j;
+
+  for (r = begin; r < end; r++) {
+    const float *x = job->input + (r / kernel_size) * input_size;
+    float *col = p->col + r * job->columns;
+    pos_to_shape(kernel_position, p->kernel_shape, r % kernel_size);
+
+    if (p->spatial_dims == 2) {
+      int ih = p->input_shape.data[0];
+      int iw = p->input_shape.data[1];
+      int ow = p->output_shape.data[1];
+      int ky = kernel_position_data[0] * dilation[0] - pad[0];
+      int kx = kernel_position_data[1] * dilation[1] - pad[1];
+      int oy = job->first / ow;
+      int ox = job->first % ow;
+      for (o = 0; o < job->columns; o++) {
+        int iy = oy * stride[0] + ky;
+        int ix = ox * stride[1] + kx;
+        col[o] = (iy >= 0 && iy < ih && ix >= 0 && ix < iw) ? x[iy * iw + ix]
+                                                            : 0.0f;
+        if (++ox == ow) {
+          ox = 0;
+          oy++;
+        }
+      }
+      continue;
+    }
+
+    for (o = 0; o < job->columns; o++) {
+      uint8_t condition = 1;
+      pos_to_shape(out_position, p->output_shape, job->first + o);
+      for (j = 0; j < p->spatial_dims; j++) {
+        in_position_data[j] = out_position_data[j] * stride[j] - pad[j] +
+                              kernel_position_data[j] * dilation[j];
+        if (in_position_data[j] < 0 ||
+            in_position_data[j] >= p->input_shape.data[j]) {
+          condition = 0;
+          break;
+        }
+      }
+      col[o] = condition ? x[shape_to_pos(p->input_shape, in_position)] : 0.0f;
+    }
+  }
+}
+
+void allocate_convolution_panels(convolution_local_context_t *c,
+                                 convolution_private_t *p) {
+  // GEMM reads original weight if it is not packed.
+  p->panel_weight = pack_weight_panels(
+      (const float *)(p->w_var.v->data), c->group, p->out_var.shape.data[I],
+      p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape), SGEMM_MR);
+}
+
+// Calculate output maps of panels [begin, end) at positions in im2col buffer
+// as product of weight and im2col buffer, then apply alpha, bias and
+// epilogue. Each panel has SGEMM_MR output maps.
+static void gemm_range(void *arg, int begin, int end) {
+  convolution_gemm_job_t *job = (convolution_gemm_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int n = job->columns;
+  int k = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int panels = (out_vars + SGEMM_MR - 1) / SGEMM_MR;
+  int om0 = begin * SGEMM_MR;
+  int om1 = end * SGEMM_MR < out_vars ? end * SGEMM_MR : out_vars;
+  float *output = job->output + job->first + om0 * output_size;
+  int om, jb, j;
+
+  for (jb = 0; jb < n; jb += GEMM_BLOCK_N) {
+    int m = n - jb < GEMM_BLOCK_N ? n - jb : GEMM_BLOCK_N;
+    if (p->panel_weight) {
+      sgemm_packed_a(om1 - om0, m, k,
+                     p->panel_weight +
+                         (job->group * panels + begin) * k * SGEMM_MR,
+                     job->col + jb, n, 1, output + jb, output_size);
+    } else {
+      sgemm(om1 - om0, m, k, job->weight + om0 * k, k, 1, job->col + jb, n, 1,
+            output + jb, output_size);
+    }
+    for (om = om0; om < om1; om++) {
+      float *y = output + (om - om0) * output_size + jb;
+      int index = job->group * out_vars + om;
+      float alpha = p->a_var.v ? ((float *)(p->a_var.v->data))[index] : 1.0f;
+      float bias = p->b_var.v ? ((float *)(p->b_var.v->data))[index] : 0.0f;
+      if (p->a_var.v || p->b_var.v) {
+        for (j = 0; j < m; j++) {
+          y[j] = y[j] * alpha + bias;
+        }
+      }
+      apply_epilogue(&p->epilogue, y, m);
+    }
+  }
+}
+
+static void exec_convolution_gemm(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  convolution_gemm_job_t job;
+  int b, g;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->out_var.shape.data[B]; b++) {
+    for (g = 0; g < c->group; g++) {
+      job.group = g;
+      job.input = (float *)(p->in_var.v->data) + b * p->in_var.stride.data[B] +
+                  g * p->in_var.stride.data[G];
+      job.weight = (float *)(p->w_var.v->data) + g * p->w_var.stride.data[KG];
+      job.output = (float *)(p->out_var.v->data) +
+                   b * p->out_var.stride.data[B] +
+                   g * p->out_var.stride.data[G];
+      for (job.first = 0; job.first < output_size;
+           job.first += p->col_columns) {
+        job.columns = output_size - job.first < p->col_columns
+                          ? output_size - job.first
+                          : p->col_columns;
+        if (p->pointwise) {
+          // Whole input is one tile.
+          job.col = job.input;
+        } else {
+          job.col = p->col;
+          rt_parallel_for(rows, job.columns, im2col_range, &job);
+        }
+        rt_parallel_for((out_vars + SGEMM_MR - 1) / SGEMM_MR,
+                        SGEMM_MR * rows * job.columns, gemm_range, &job);
+      }
+    }
+  }
+}
+
+// Winograd is preferred to GEMM, and GEMM to direct convolution, when
+// their areas are allocated.
+static rt_kernel_t current_kernel(convolution_private_t *p) {
+  if (p->kernel != RT_KERNEL_DEFAULT) {
+    return p->kernel;
+  }
+  if (p->winograd_weight) {
+    return RT_KERNEL_WINOGRAD;
+  }
+  if (p->col || p->pointwise) {
+    return RT_KERNEL_GEMM;
+  }
+  return RT_KERNEL_DIRECT;
+}
+
+static int is_available_kernel(convolution_private_t *p, rt_kernel_t kernel) {
+  switch (kernel) {
+  case RT_KERNEL_DIRECT:
+    return 1;
+  case RT_KERNEL_GEMM:
+    return p->pointwise || (p->col && p->col_columns > 0);
+  case RT_KERNEL_WINOGRAD:
+    return p->col && p->winograd_weight && p->winograd_tiles > 0;
+  default:
+    return 0;
+  }
+}
+
+int convolution_float_kernels(convolution_private_t *p, rt_kernel_t *kernels) {
+  rt_kernel_t current = current_kernel(p);
+  int num_of_kernels = 0;
+  int k; // Iterator
+
+  kernels[num_of_kernels++] = current;
+  if (p->channel_last ||
+      p->w_var.v->layout == NN_DATA_LAYOUT_BLOCK_SPARSE) {
+    // Executed by their own kernels.
+    return num_of_kernels;
+  }
+  for (k = RT_KERNEL_DIRECT; k < RT_KERNEL_END; k++) {
+    if (k != (int)current && is_available_kernel(p, (rt_kernel_t)k)) {
+      kernels[num_of_kernels++] = (rt_kernel_t)k;
+    }
+  }
+  return num_of_kernels;
+}
+
+rt_function_error_t select_convolution_float_kernel(convolution_private_t *p,
+                                                    rt_kernel_t kernel,
+                                                    int keep) {
+  if (p->channel_last ||
+      p->w_var.v->layout == NN_DATA_LAYOUT_BLOCK_SPARSE) {
+    return kernel == current_kernel(p) ? RT_FUNCTION_ERROR_NOERROR
+                                       : RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  if (!is_available_kernel(p, kernel)) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  p->kernel = kernel;
+  if (keep) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (kernel != RT_KERNEL_WINOGRAD && p->winograd_weight) {
+    free_weight_copy(p->winograd_weight);
+    p->winograd_weight = 0;
+  }
+  if (kernel != RT_KERNEL_GEMM && p->panel_weight) {
+    free_weight_copy(p->panel_weight);
+    p->panel_weight = 0;
+  }
+  if (kernel == RT_KERNEL_DIRECT && p->col) {
+    rt_free_func(p->col);
+    p->col = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t exec_convolution_float(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+
+  if (p->w_var.v->layout == NN_DATA_LAYOUT_BLOCK_SPARSE) {
+    exec_convolution_sparse(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (p->channel_last) {
+    if (p->col == 0 && !p->pointwise) {
+      return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+    }
+    exec_convolution_channel_last(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  switch (current_kernel(p)) {
+  case RT_KERNEL_WINOGRAD:
+    exec_convolution_winograd(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  case RT_KERNEL_GEMM:
+    exec_convolution_gemm(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  default:
+    break;
+  }
+  if (p->conv2d_direct) {
+    exec_convolution_direct(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+
+  int output_size = calc_shape_size(p->out_var.shape);
+  int num_of_maps = p->out_var.shape.data[B] * c->group *
+                    p->out_var.shape.data[I];
+
+  memset(p->out_var.v->data, 0, sizeof(float) * output_size);
+
+  rt_parallel_for(num_of_maps,
+                  (output_size / num_of_maps) * p->in_var.shape.data[I] *
+                      calc_shape_size(p->kernel_shape),
+                  convolution_float_range, f);
 
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -91,6 +91,48 @@ static inline void convnd(var_t *out, var_t *in, var_t *we,
   }
 }
 
+// conv2d() for rows and kernel which fit in ACCESSOR_BLOCK_SIZE, converting a
+// row at a time. Sums are added in same order as conv2d().
+static inline void conv2d_block(var_t *out, var_t *in, var_t *we,
+                                rt_list_t input_shape, rt_list_t output_shape,
+                                rt_list_t kernel_shape, rt_list_t pad,
+                                rt_list_t stride, rt_list_t dilation) {
+  float w[ACCESSOR_BLOCK_SIZE], x[ACCESSOR_BLOCK_SIZE];
+  float sum[ACCESSOR_BLOCK_SIZE], o[ACCESSOR_BLOCK_SIZE];
+  int ix, iy, ox, oy, kx, ky;
+
+  get_variable_block(we->v, we->offset, calc_shape_size(kernel_shape), w);
+  for (iy = -pad.data[0], oy = 0; oy < output_shape.data[0];
+       ++oy, iy += stride.data[0]) {
+    nn_size_t opos = out->offset + oy * output_shape.data[1];
+    for (ox = 0; ox < output_shape.data[1]; ++ox) {
+      sum[ox] = 0.0f;
+    }
+    for (ky = 0; ky < kernel_shape.data[0]; ++ky) {
+      int iky = ky * dilation.data[0] + iy;
+      if (iky < 0 || iky >= input_shape.data[0]) {
+        continue;
+      }
+      get_variable_block(in->v, in->offset + iky * input_shape.data[1],
+                         input_shape.data[1], x);
+      for (ix = -pad.data[1], ox = 0; ox < output_shape.data[1];
+           ++ox, ix += stride.data[1]) {
+        for (kx = 0; kx < kernel_shape.data[1]; ++kx) {
+          int ikx = kx * dilation.data[1] + ix;
+          if (ikx >= 0 && ikx < input_shape.data[1]) {
+            sum[ox] += x[ikx] * w[ky * kernel_shape.data[1] + kx];
+          }
+        }
+      }
+    }
+    get_variable_block(out->v, opos, output_shape.data[1], o);
+    for (ox = 0; ox < output_shape.data[1]; ++ox) {
+      o[ox] += sum[ox];
+    }
+    set_variable_block(out->v, opos, output_shape.data[1], o);
+  }
+}
+
 static inline void conv2d(var_t *out, var_t *in, var_t *we,
                           rt_list_t input_shape, rt_list_t output_shape,
                           rt_list_t kernel_shape, rt_list_t in_position,
@@ -99,6 +141,13 @@ static inline void conv2d(var_t *out, var_t *in, var_t *we,
                           int spatial_dims) {
   int ix, iy, ox, oy, kx, ky;
 
+  if (calc_shape_size(kernel_shape) <= ACCESSOR_BLOCK_SIZE &&
+      input_shape.data[1] <= ACCESSOR_BLOCK_SIZE &&
+      output_shape.data[1] <= ACCESSOR_BLOCK_SIZE) {
+    conv2d_block(out, in, we, input_shape, output_shape, kernel_shape, pad,
+                 stride, dilation);
+    return;
+  }
   for (iy = -pad.data[0], oy = 0; oy < output_shape.data[0];
        ++oy, iy += stride.data[0]) {
     for (ix = -pad.data[1], ox = 0; ox < output_shape.data[1];
@@ -125,23 +174,31 @@ static inline void conv2d(var_t *out, var_t *in, var_t *we,
 
 static inline void add_bias(var_t *out, var_t *b) {
   int size = out->stride.data[I];
-  int i;
   float bias = var_get(b, b->offset);
-  for (i = 0; i < size; ++i) {
-    float x = var_get(out, out->offset + i);
-    x += bias;
-    var_set(out, out->offset + i, x);
+  float x[ACCESSOR_BLOCK_SIZE];
+  int i, k;
+  for (i = 0; i < size; i += ACCESSOR_BLOCK_SIZE) {
+    int n = size - i < ACCESSOR_BLOCK_SIZE ? size - i : ACCESSOR_BLOCK_SIZE;
+    get_variable_block(out->v, out->offset + i, n, x);
+    for (k = 0; k < n; ++k) {
+      x[k] += bias;
+    }
+    set_variable_block(out->v, out->offset + i, n, x);
   }
 }
 
 static inline void mul_alpha(var_t *out, var_t *a) {
   int size = out->stride.data[I];
-  int i;
   float alpha = var_get(a, a->offset);
-  for (i = 0; i < size; ++i) {
-    float x = var_get(out, out->offset + i);
-    x *= alpha;
-    var_set(out, out->offset + i, x);
+  float x[ACCESSOR_BLOCK_SIZE];
+  int i, k;
+  for (i = 0; i < size; i += ACCESSOR_BLOCK_SIZE) {
+    int n = size - i < ACCESSOR_BLOCK_SIZE ? size - i : ACCESSOR_BLOCK_SIZE;
+    get_variable_block(out->v, out->offset + i, n, x);
+    for (k = 0; k < n; ++k) {
+      x[k] *= alpha;
+    }
+    set_variable_block(out->v, out->offset + i, n, x);
   }
 }
 
@@ -149,6 +206,17 @@ rt_function_error_t exec_convolution_generic(rt_function_t *f) {
   convolution_local_context_t *c =
       (convolution_local_context_t *)f->local_context;
   convolution_private_t *p = (convolution_private_t *)(c->data);
+  if (p->channel_last) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  if (p->fixed_col) {
+    exec_convolution_fixed8(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  if (p->sign_col) {
+    exec_convolution_sign(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
 
   nn_size_t group = c->group;
   nn_size_t in_vars = p->in_var.shape.data[I];
@@ -13,6 +13,11 @@
 // limitations under the License.
 
 #include "../../../utilities/accessor.h"
+#include "../../../utilities/epilogue.h"
+#include "../../../utilities/half.h"
+#include "../../../utilities/prepack.h"
+#include "../../../utilities/sgemm.h"
+#include "../../../utilities/sparse.h"
 #include <nnablart/functions.h>
 
 #ifndef H_CONVOLUTION_INTERNAL_H_171218154530_
@@ -20,6 +25,31 @@
 
 typedef rt_function_error_t (*exec_conv_func_t)(rt_function_t *f);
 
+/// Sizes of 2D convolution with square kernel and same stride for both axes,
+/// and ranges of output positions whose windows are inside of input.
+typedef struct {
+  rt_function_t *f;
+  int ih, iw;  ///< Input map size.
+  int oh, ow;  ///< Output map size.
+  int pad_y;   ///< Padding of height.
+  int pad_x;   ///< Padding of width.
+  int y_begin; ///< First interior output row.
+  int y_end;   ///< End of interior output rows.
+  int x_begin; ///< First interior output column.
+  int x_end;   ///< End of interior output columns.
+  int kernel;  ///< Kernel size for both of height and width.
+  int stride;  ///< Stride for both of height and width.
+} conv2d_job_t;
+
+/// Add convolution of input map x into block output maps from y, whose
+/// weights are w_map apart from w.
+typedef void (*conv2d_direct_func_t)(const conv2d_job_t *job, const float *x,
+                                     const float *w, int w_map, float *y);
+
+/// Write depthwise convolution of input map x with bias into output map y.
+typedef void (*depthwise_map_func_t)(const conv2d_job_t *job, const float *x,
+                                     const float *w, float bias, float *y);
+
 typedef struct {
   rt_variable_t *v;
   rt_list_t shape;
@@ -41,6 +71,41 @@ typedef struct {
   rt_list_t output_shape;
   rt_list_t in_position;
   rt_list_t out_position;
+  float *col;             ///< im2col buffer, or NULL to convolve directly.
+  int col_columns;        ///< Number of output positions in im2col buffer.
+  float *winograd_weight; ///< Transformed weight to use Winograd, or NULL.
+  int winograd_tiles;     ///< Number of Winograd tiles in im2col buffer.
+  int channel_last;       ///< Channel is last axis of input and output.
+  float *packed_weight;   ///< Weight as [group][kernel][in][out] for channel
+                          ///< last, or NULL.
+  int pointwise;          ///< 1x1 convolution without stride and pad, input
+                          ///< is used as im2col buffer.
+  float *panel_weight;    ///< Weight of each group packed into panels of
+                          ///< output maps for GEMM, or NULL.
+  int8_t *fixed_col;      ///< im2col buffer of int8 convolution, or NULL.
+  int32_t *fixed_bias;    ///< Bias in fixed point position of int8
+                          ///< accumulator, or NULL.
+  float *fixed_scale;     ///< Scale of int8 accumulator of each output map
+                          ///< with per channel weight, or NULL.
+  int fixed_dot;          ///< Dot product instructions of int8 GEMM, or 0.
+  int8_t *fixed_weight;   ///< Int8 weight with rows padded for fixed_dot, or
+                          ///< NULL to use weight itself.
+  uint32_t *sign_weight;  ///< Weight bits of binary convolution with each
+                          ///< output map aligned to word, or NULL.
+  uint32_t *sign_col;     ///< im2col bits and valid tap masks of binary
+                          ///< convolution, or NULL.
+  rt_epilogue_t epilogue; ///< Activation applied to outputs.
+  rt_kernel_t kernel;     ///< Float kernel selected after allocation, or
+                          ///< RT_KERNEL_DEFAULT.
+  conv2d_direct_func_t conv2d_direct; ///< Direct kernel specialized for
+                                      ///< shape, or NULL.
+  int conv2d_block;                   ///< Output maps of conv2d_direct.
+  depthwise_map_func_t depthwise_map; ///< Depthwise kernel specialized for
+                                      ///< shape, or NULL.
+
+  /// Expanded copy of block sparse weight for kernels other than sparse one,
+  /// or float copy of 16bit float weight.
+  rt_variable_t dense_weight;
 } convolution_private_t;
 
 #define B (0) // batch dimension of input or output
@@ -55,14 +120,59 @@ typedef struct {
 #define KH (3) // height of kernel
 #define KW (4) // width of kernel
 
+#define CONV_MAX_SPATIAL_DIMS (8) // Max number of spatial dimensions
+
+// Max bytes of im2col or Winograd buffer. Output positions are processed in
+// tiles which fit in it.
+#ifndef CONV_IM2COL_MAX_SIZE
+#define CONV_IM2COL_MAX_SIZE (4 * 1024 * 1024)
+#endif
+
+#define WINOGRAD_TILE_SIZE (16) // Elements of Winograd F(2x2, 3x3) tile
+
 #define SPH (0) // height of stride/pad
 #define SPW (1) // width of stride/pad
 
+int is_square_conv2d(convolution_local_context_t *c, convolution_private_t *p);
+void init_conv2d_job(conv2d_job_t *job, rt_function_t *f);
+void select_conv2d_direct(convolution_local_context_t *c,
+                          convolution_private_t *p);
 rt_function_error_t exec_convolution_generic(rt_function_t *f);
 rt_function_error_t exec_convolution_float(rt_function_t *f);
+int convolution_float_kernels(convolution_private_t *p, rt_kernel_t *kernels);
+rt_function_error_t select_convolution_float_kernel(convolution_private_t *p,
+                                                    rt_kernel_t kernel,
+                                                    int keep);
+int is_winograd_convolution(convolution_local_context_t *c,
+                            convolution_private_t *p);
+int is_pointwise_convolution(convolution_local_context_t *c,
+                             convolution_private_t *p);
+void allocate_convolution_panels(convolution_local_context_t *c,
+                                 convolution_private_t *p);
+rt_function_error_t
+allocate_convolution_winograd(convolution_local_context_t *c,
+                              convolution_private_t *p);
+void exec_convolution_winograd(rt_function_t *f);
+rt_function_error_t
+allocate_convolution_channel_last(convolution_local_context_t *c,
+                                  convolution_private_t *p);
+void exec_convolution_channel_last(rt_function_t *f);
+int is_fixed8_convolution(convolution_private_t *p);
+rt_function_error_t
+allocate_convolution_fixed8(convolution_local_context_t *c,
+                            convolution_private_t *p);
+void exec_convolution_fixed8(rt_function_t *f);
+int is_sign_convolution(convolution_private_t *p);
+rt_function_error_t allocate_convolution_sign(convolution_local_context_t *c,
+                                              convolution_private_t *p);
+void exec_convolution_sign(rt_function_t *f);
+int is_sparse_convolution(convolution_local_context_t *c,
+                          convolution_private_t *p);
+void exec_convolution_sparse(rt_function_t *f);
 rt_function_error_t
 allocate_convolution_local_context_common(rt_function_t *f, int x, int weight,
-                                          int bias, int alpha, int y0);
+                                          int bias, int alpha, int y0,
+                                          int channel_last);
 rt_function_error_t free_convolution_local_context_common(rt_function_t *f);
 
 #endif // H_CONVOLUTION_INTERNAL_H_171218154530_
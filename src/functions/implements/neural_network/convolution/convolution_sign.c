@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "convolution_internal.h"
+
+#include "../../../utilities/shape.h"
+#include "../../../utilities/sign.h"
+
+#include <nnablart/functions.h>
+#include <string.h>
+
+/*
+ * Convolution of SIGN input and SIGN weight. Values are +1 for set bits and
+ * -1 for cleared bits, so dot product of n values packed into words is
+ *   2 * popcount(~(x ^ w)) - n.
+ * Each output position has one row of im2col bits and one row of bits which
+ * mark taps inside input, taps on padding do not contribute.
+ */
+
+typedef struct {
+  convolution_local_context_t *c;
+  convolution_private_t *p;
+  int input;   ///< Bit position of input maps of current batch and group.
+  int output;  ///< Position of output maps of current batch and group.
+  int group;   ///< Current group.
+  int first;   ///< First output position in im2col buffer.
+  int columns; ///< Number of output positions in im2col buffer.
+} convolution_sign_job_t;
+
+static int sign_words(convolution_private_t *p) {
+  return SIGN_WORDS(p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape));
+}
+
+int is_sign_convolution(convolution_private_t *p) {
+  return !p->channel_last && p->in_var.v->type == NN_DATA_TYPE_SIGN &&
+         p->w_var.v->type == NN_DATA_TYPE_SIGN;
+}
+
+rt_function_error_t allocate_convolution_sign(convolution_local_context_t *c,
+                                              convolution_private_t *p) {
+  int rows = p->in_var.shape.data[I] * calc_shape_size(p->kernel_shape);
+  int words = sign_words(p);
+  int num_of_outputs = c->group * p->out_var.shape.data[I];
+  size_t columns = calc_shape_size(p->output_shape);
+  size_t size = sizeof(uint32_t) * num_of_outputs * words;
+  const uint32_t *weight = (const uint32_t *)(p->w_var.v->data);
+
+  if (columns * words * 2 * sizeof(uint32_t) > CONV_IM2COL_MAX_SIZE) {
+    columns = CONV_IM2COL_MAX_SIZE / (words * 2 * sizeof(uint32_t));
+  }
+  if (columns == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->sign_col = rt_malloc_func(sizeof(uint32_t) * columns * words * 2);
+  if (p->sign_col == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->col_columns = columns;
+  p->sign_weight = find_weight_copy(weight, WEIGHT_COPY_SIGN, size);
+  if (p->sign_weight != 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  p->sign_weight = rt_malloc_func(size);
+  if (p->sign_weight == 0) {
+    rt_free_func(p->sign_col);
+    p->sign_col = 0;
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+
+  // Each output map starts at a word boundary.
+  pack_sign_rows(weight, num_of_outputs, rows, p->sign_weight);
+  add_weight_copy(weight, WEIGHT_COPY_SIGN, size, p->sign_weight);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Fill im2col bits of output positions [begin, end).
+static void im2col_sign_range(void *arg, int begin, int end) {
+  convolution_sign_job_t *job = (convolution_sign_job_t *)arg;
+  convolution_local_context_t *c = job->c;
+  convolution_private_t *p = job->p;
+  const uint32_t *x = (const uint32_t *)(p->in_var.v->data);
+  int in_vars = p->in_var.shape.data[I];
+  int input_size = p->in_var.stride.data[I];
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int words = sign_words(p);
+  int kernel_position_data[CONV_MAX_SPATIAL_DIMS];
+  int out_position_data[CONV_MAX_SPATIAL_DIMS];
+  int in_position_data[CONV_MAX_SPATIAL_DIMS];
+  rt_list_t kernel_position = {p->spatial_dims, kernel_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  int o, k, im, j;
+
+  for (o = begin; o < end; o++) {
+    uint32_t *col = p->sign_col + o * words * 2;
+    uint32_t *mask = col + words;
+    memset(col, 0, sizeof(uint32_t) * words * 2);
+    pos_to_shape(out_position, p->output_shape, job->first + o);
+    for (k = 0; k < kernel_size; k++) {
+      uint8_t condition = 1;
+      pos_to_shape(kernel_position, p->kernel_shape, k);
+      for (j = 0; j < p->spatial_dims; j++) {
+        in_position_data[j] = out_position_data[j] * c->stride.data[j] -
+                              c->pad.data[j] +
+                              kernel_position_data[j] * c->dilation.data[j];
+        if (in_position_data[j] < 0 ||
+            in_position_data[j] >= p->input_shape.data[j]) {
+          condition = 0;
+          break;
+        }
+      }
+      if (!condition) {
+        continue;
+      }
+      int pos = job->input + shape_to_pos(p->input_shape, in_position);
+      for (im = 0; im < in_vars; im++, pos += input_size) {
+        int r = im * kernel_size + k;
+        col[r / 32] |= (uint32_t)SIGN_BIT(x, pos) << (r % 32);
+        mask[r / 32] |= (uint32_t)1 << (r % 32);
+      }
+    }
+  }
+}
+
+// Calculate output maps [begin, end) at positions in im2col buffer, then
+// apply alpha and bias.
+static void xnor_range(void *arg, int begin, int end) {
+  convolution_sign_job_t *job = (convolution_sign_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int words = sign_words(p);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int om, o, j;
+
+  for (om = begin; om < end; om++) {
+    int index = job->group * out_vars + om;
+    const uint32_t *w = p->sign_weight + index * words;
+    float alpha = p->a_var.v ? p->a_var.get(p->a_var.v, index) : 1.0f;
+    float bias = p->b_var.v ? p->b_var.get(p->b_var.v, index) : 0.0f;
+    int position = job->output + om * output_size + job->first;
+    for (o = 0; o < job->columns; o++) {
+      const uint32_t *col = p->sign_col + o * words * 2;
+      const uint32_t *mask = col + words;
+      int same = 0;
+      int valid = 0;
+      for (j = 0; j < words; j++) {
+        same += POPCOUNT32(~(col[j] ^ w[j]) & mask[j]);
+        valid += POPCOUNT32(mask[j]);
+      }
+      p->out_var.set(p->out_var.v, position + o,
+                     (2 * same - valid) * alpha + bias);
+    }
+  }
+}
+
+void exec_convolution_sign(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int output_size = p->out_var.stride.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int words = sign_words(p);
+  convolution_sign_job_t job;
+  int b, g;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->out_var.shape.data[B]; b++) {
+    for (g = 0; g < c->group; g++) {
+      job.group = g;
+      job.input = b * p->in_var.stride.data[B] + g * p->in_var.stride.data[G];
+      job.output =
+          b * p->out_var.stride.data[B] + g * p->out_var.stride.data[G];
+      for (job.first = 0; job.first < output_size;
+           job.first += p->col_columns) {
+        job.columns = output_size - job.first < p->col_columns
+                          ? output_size - job.first
+                          : p->col_columns;
+        rt_parallel_for(job.columns, p->in_var.shape.data[I] *
+                                         calc_shape_size(p->kernel_shape),
+                        im2col_sign_range, &job);
+        if (p->out_var.v->type == NN_DATA_TYPE_SIGN) {
+          // Output maps may share words of output.
+          xnor_range(&job, 0, out_vars);
+        } else {
+          rt_parallel_for(out_vars, words * job.columns, xnor_range, &job);
+        }
+      }
+    }
+  }
+}
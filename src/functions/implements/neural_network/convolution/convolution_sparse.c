@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "convolution_internal.h"
+
+#include "../../../utilities/shape.h"
+#include "../../../utilities/sparse.h"
+
+#include <nnablart/functions.h>
+
+/*
+ * 1x1 convolution of block sparse weight. Row o of weight keeps blocks of
+ * input maps which are not all zero, so output map o is bias plus input
+ * maps of those blocks scaled by their weights. Zero blocks are skipped.
+ */
+
+int is_sparse_convolution(convolution_local_context_t *c,
+                          convolution_private_t *p) {
+  block_sparse_t s;
+
+  if (p->channel_last || p->a_var.v || !is_pointwise_convolution(c, p)) {
+    return 0;
+  }
+  get_block_sparse(p->w_var.v, &s);
+  return s.rows == c->group * p->out_var.shape.data[I] &&
+         s.columns == p->in_var.shape.data[I];
+}
+
+// Calculate output maps [begin, end) of all batches, then apply bias and
+// epilogue.
+static void convolution_sparse_range(void *arg, int begin, int end) {
+  convolution_private_t *p = (convolution_private_t *)arg;
+  int out_vars = p->out_var.shape.data[I];
+  int maps = p->out_var.shape.data[G] * out_vars;
+  int size = calc_shape_size(p->output_shape);
+  const float *bias = p->b_var.v ? (const float *)(p->b_var.v->data) : 0;
+  block_sparse_t s;
+  int m, b, t, k; // Iterator
+
+  get_block_sparse(p->w_var.v, &s);
+  for (m = begin; m < end; m++) {
+    int o = m % maps;
+    const float *x = (const float *)(p->in_var.v->data) +
+                     (m / maps) * p->in_var.stride.data[B] +
+                     (o / out_vars) * p->in_var.stride.data[G];
+    float *y = (float *)(p->out_var.v->data) +
+               (m / maps) * p->out_var.stride.data[B] + o * size;
+    float value = bias ? bias[o] : 0.0f;
+
+    for (k = 0; k < size; k++) {
+      y[k] = value;
+    }
+    for (b = s.row_offsets[o]; b < s.row_offsets[o + 1]; b++) {
+      const float *w = s.values + b * s.block_size;
+      for (t = 0; t < s.block_size; t++) {
+        const float *xm = x + (s.block_columns[b] + t) * size;
+        const float a = w[t];
+        for (k = 0; k < size; k++) {
+          y[k] += a * xm[k];
+        }
+      }
+    }
+    apply_epilogue(&p->epilogue, y, size);
+  }
+}
+
+void exec_convolution_sparse(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int maps = c->group * p->out_var.shape.data[I];
+  block_sparse_t s;
+
+  get_block_sparse(p->w_var.v, &s);
+  rt_parallel_for(p->out_var.shape.data[B] * maps,
+                  calc_shape_size(p->output_shape) *
+                      (s.row_offsets[s.rows] * s.block_size / maps + 1),
+                  convolution_sparse_range, p);
+}
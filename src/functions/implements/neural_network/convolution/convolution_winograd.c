@@ -0,0 +1,240 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "convolution_internal.h"
+
+#include <nnablart/functions.h>
+#include <string.h>
+
+/*
+ * Winograd F(2x2, 3x3): each 2x2 output tile is calculated from 4x4 input
+ * tile d and 3x3 kernel g as
+ *   Y = A^T [(G g G^T) * (B^T d B)] A
+ * where * is element wise product. It takes 16 multiplications per tile
+ * instead of 36.
+ *
+ *   B^T = | 1  0 -1  0 |   G = | 1    0    0   |   A^T = | 1  1  1  0 |
+ *         | 0  1  1  0 |       | 1/2  1/2  1/2 |         | 0  1 -1 -1 |
+ *         | 0 -1  1  0 |       | 1/2 -1/2  1/2 |
+ *         | 0  1  0 -1 |       | 0    0    1   |
+ */
+
+#define WINOGRAD_BLOCK (64) // Tiles accumulated at once
+
+typedef struct {
+  convolution_local_context_t *c;
+  convolution_private_t *p;
+  float *input;  ///< Input maps of current batch and group.
+  float *output; ///< Output maps of current batch and group.
+  int group;     ///< Current group.
+  int first;     ///< First tile in transform buffer.
+  int tiles;     ///< Number of tiles in transform buffer.
+} winograd_job_t;
+
+int is_winograd_convolution(convolution_local_context_t *c,
+                            convolution_private_t *p) {
+  int i; // Iterator
+  if (p->spatial_dims != 2) {
+    return 0;
+  }
+  for (i = 0; i < 2; i++) {
+    if (p->kernel_shape.data[i] != 3 || c->stride.data[i] != 1 ||
+        c->dilation.data[i] != 1) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// U = G g G^T for all kernels. Layout is [group][out][16][in] so that
+// multiply-accumulate over input maps reads contiguous memory.
+rt_function_error_t
+allocate_convolution_winograd(convolution_local_context_t *c,
+                              convolution_private_t *p) {
+  int in_vars = p->in_var.shape.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  const float *weight = (const float *)(p->w_var.v->data);
+  size_t size =
+      sizeof(float) * c->group * out_vars * in_vars * WINOGRAD_TILE_SIZE;
+  int g, om, im, i, j;
+
+  p->winograd_weight = find_weight_copy(weight, WEIGHT_COPY_WINOGRAD, size);
+  if (p->winograd_weight != 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  p->winograd_weight = rt_malloc_func(size);
+  if (p->winograd_weight == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  for (g = 0; g < c->group; g++) {
+    for (om = 0; om < out_vars; om++) {
+      float *u = p->winograd_weight +
+                 (g * out_vars + om) * WINOGRAD_TILE_SIZE * in_vars;
+      for (im = 0; im < in_vars; im++) {
+        const float *k = weight + g * p->w_var.stride.data[KG] +
+                         om * p->w_var.stride.data[KO] +
+                         im * p->w_var.stride.data[KI];
+        float t[4][3]; // G g
+        for (j = 0; j < 3; j++) {
+          t[0][j] = k[j];
+          t[1][j] = 0.5f * (k[j] + k[3 + j] + k[6 + j]);
+          t[2][j] = 0.5f * (k[j] - k[3 + j] + k[6 + j]);
+          t[3][j] = k[6 + j];
+        }
+        for (i = 0; i < 4; i++) {
+          u[(i * 4 + 0) * in_vars + im] = t[i][0];
+          u[(i * 4 + 1) * in_vars + im] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+          u[(i * 4 + 2) * in_vars + im] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+          u[(i * 4 + 3) * in_vars + im] = t[i][2];
+        }
+      }
+    }
+  }
+  add_weight_copy(weight, WEIGHT_COPY_WINOGRAD, size, p->winograd_weight);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// V = B^T d B for input maps [begin, end). Layout is [16][in][tile].
+static void input_transform_range(void *arg, int begin, int end) {
+  winograd_job_t *job = (winograd_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int ih = p->input_shape.data[0];
+  int iw = p->input_shape.data[1];
+  int tiles_x = (p->output_shape.data[1] + 1) / 2;
+  int in_vars = p->in_var.shape.data[I];
+  int im, t, i, j;
+
+  for (im = begin; im < end; im++) {
+    const float *x = job->input + im * p->in_var.stride.data[I];
+    float *v = p->col + im * job->tiles;
+    for (t = 0; t < job->tiles; t++) {
+      int y0 = ((job->first + t) / tiles_x) * 2 - job->c->pad.data[0];
+      int x0 = ((job->first + t) % tiles_x) * 2 - job->c->pad.data[1];
+      float d[4][4], s[4][4];
+      for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) {
+          int y = y0 + i;
+          int x1 = x0 + j;
+          d[i][j] =
+              (y >= 0 && y < ih && x1 >= 0 && x1 < iw) ? x[y * iw + x1] : 0.0f;
+        }
+      }
+      for (j = 0; j < 4; j++) {
+        s[0][j] = d[0][j] - d[2][j];
+        s[1][j] = d[1][j] + d[2][j];
+        s[2][j] = d[2][j] - d[1][j];
+        s[3][j] = d[1][j] - d[3][j];
+      }
+      for (i = 0; i < 4; i++) {
+        float *row = v + (i * 4) * in_vars * job->tiles + t;
+        row[0] = s[i][0] - s[i][2];
+        row[in_vars * job->tiles] = s[i][1] + s[i][2];
+        row[2 * in_vars * job->tiles] = s[i][2] - s[i][1];
+        row[3 * in_vars * job->tiles] = s[i][1] - s[i][3];
+      }
+    }
+  }
+}
+
+// Y = A^T (U * V) A for output maps [begin, end), then apply alpha, bias and
+// epilogue.
+static void output_transform_range(void *arg, int begin, int end) {
+  winograd_job_t *job = (winograd_job_t *)arg;
+  convolution_private_t *p = job->p;
+  int oh = p->output_shape.data[0];
+  int ow = p->output_shape.data[1];
+  int tiles_x = (ow + 1) / 2;
+  int in_vars = p->in_var.shape.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  float m[WINOGRAD_TILE_SIZE][WINOGRAD_BLOCK];
+  int om, tb, xi, im, t;
+
+  for (om = begin; om < end; om++) {
+    const float *u = p->winograd_weight + (job->group * out_vars + om) *
+                                              WINOGRAD_TILE_SIZE * in_vars;
+    float *y = job->output + om * p->out_var.stride.data[I];
+    int index = job->group * out_vars + om;
+    float alpha = p->a_var.v ? ((float *)(p->a_var.v->data))[index] : 1.0f;
+    float bias = p->b_var.v ? ((float *)(p->b_var.v->data))[index] : 0.0f;
+
+    for (tb = 0; tb < job->tiles; tb += WINOGRAD_BLOCK) {
+      int n = job->tiles - tb < WINOGRAD_BLOCK ? job->tiles - tb
+                                               : WINOGRAD_BLOCK;
+      for (xi = 0; xi < WINOGRAD_TILE_SIZE; xi++) {
+        float *acc = m[xi];
+        memset(acc, 0, sizeof(float) * n);
+        for (im = 0; im < in_vars; im++) {
+          const float a = u[xi * in_vars + im];
+          const float *v = p->col + (xi * in_vars + im) * job->tiles + tb;
+          for (t = 0; t < n; t++) {
+            acc[t] += a * v[t];
+          }
+        }
+      }
+      for (t = 0; t < n; t++) {
+        int ty = ((job->first + tb + t) / tiles_x) * 2;
+        int tx = ((job->first + tb + t) % tiles_x) * 2;
+        float s[2][4];
+        int i;
+        for (i = 0; i < 4; i++) {
+          s[0][i] = m[i][t] + m[4 + i][t] + m[8 + i][t];
+          s[1][i] = m[4 + i][t] - m[8 + i][t] - m[12 + i][t];
+        }
+        for (i = 0; i < 2 && ty + i < oh; i++) {
+          float *row = y + (ty + i) * ow + tx;
+          row[0] = (s[i][0] + s[i][1] + s[i][2]) * alpha + bias;
+          if (tx + 1 < ow) {
+            row[1] = (s[i][1] - s[i][2] - s[i][3]) * alpha + bias;
+          }
+          apply_epilogue(&p->epilogue, row, tx + 1 < ow ? 2 : 1);
+        }
+      }
+    }
+  }
+}
+
+void exec_convolution_winograd(rt_function_t *f) {
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int in_vars = p->in_var.shape.data[I];
+  int out_vars = p->out_var.shape.data[I];
+  int num_of_tiles =
+      ((p->output_shape.data[0] + 1) / 2) * ((p->output_shape.data[1] + 1) / 2);
+  winograd_job_t job;
+  int b, g;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->out_var.shape.data[B]; b++) {
+    for (g = 0; g < c->group; g++) {
+      job.group = g;
+      job.input = (float *)(p->in_var.v->data) + b * p->in_var.stride.data[B] +
+                  g * p->in_var.stride.data[G];
+      job.output = (float *)(p->out_var.v->data) +
+                   b * p->out_var.stride.data[B] +
+                   g * p->out_var.stride.data[G];
+      for (job.first = 0; job.first < num_of_tiles;
+           job.first += p->winograd_tiles) {
+        job.tiles = num_of_tiles - job.first < p->winograd_tiles
+                        ? num_of_tiles - job.first
+                        : p->winograd_tiles;
+        rt_parallel_for(in_vars, job.tiles * WINOGRAD_TILE_SIZE,
+                        input_transform_range, &job);
+        rt_parallel_for(out_vars, job.tiles * in_vars * WINOGRAD_TILE_SIZE,
+                        output_transform_range, &job);
+      }
+    }
+  }
+}
@@ -11,15 +11,31 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include "../../../utilities/neon.h"
 #include "../../../utilities/shape.h"
+#include "../../../utilities/specialized.h"
 #include "convolution_internal.h"
 #include <assert.h>
 #include <math.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
 
+#if defined(__AVX2__)
+#define DEPTHWISE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DEPTHWISE_SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef CONFIG_DEPTHWISECONVOLUTION
 
+#ifdef CONFIG_DEPTHWISECONVOLUTION_FLOAT32
+static depthwise_map_func_t
+select_depthwise_map(convolution_local_context_t *c, convolution_private_t *p);
+#endif /* CONFIG_DEPTHWISECONVOLUTION_FLOAT32 */
+
 rt_function_error_t
 allocate_depthwise_convolution_local_context(rt_function_t *f) {
   const int bias = 2;
@@ -47,6 +63,9 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
   if (c->base_axis >= in_shape.size - 1) {
     return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
   }
+  if (spatial_dims > CONV_MAX_SPATIAL_DIMS) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
 
   convolution_private_t *p = rt_malloc_func(sizeof(convolution_private_t));
   if (p == 0) {
@@ -55,6 +74,12 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
   c->data = (void *)p;
 
   p->in_var.shape = allocate_list(spatial_dims + 3);
+  p->out_var.shape = allocate_list(spatial_dims + 3);
+  p->w_var.shape = allocate_list(spatial_dims + 3);
+  if (p->in_var.shape.data == 0 || p->out_var.shape.data == 0 ||
+      p->w_var.shape.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->in_var.shape.data[B] = 1;
   for (i = 0; i < c->base_axis; ++i) {
     p->in_var.shape.data[B] *= in_shape.data[i];
@@ -65,7 +90,6 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
   // c->multiplier is used as c->group.
   group = c->multiplier = in_shape.data[c->base_axis];
 
-  p->out_var.shape = allocate_list(spatial_dims + 3);
   p->out_var.shape.data[B] = p->in_var.shape.data[B];
   p->out_var.shape.data[G] = group;
   p->out_var.shape.data[I] = multiplier;
@@ -91,7 +115,6 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
   p->w_var.v = f->inputs[weight];
   p->w_var.get = select_getter(f->inputs[weight]);
   p->w_var.offset = 0;
-  p->w_var.shape = allocate_list(spatial_dims + 3);
   p->w_var.shape.data[KG] = group;
   p->w_var.shape.data[KO] = multiplier;
   p->w_var.shape.data[KI] = 1;
@@ -105,6 +128,9 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
     p->b_var.get = select_getter(f->inputs[bias]);
     p->b_var.offset = 0;
     p->b_var.shape = allocate_list(2);
+    if (p->b_var.shape.data == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     p->b_var.shape.data[KG] = group;
     p->b_var.shape.data[KO] = multiplier;
     p->b_var.stride = calc_contiguous_strides(p->b_var.shape);
@@ -119,12 +145,38 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
   p->output_shape = allocate_list(p->spatial_dims);
   p->in_position = allocate_list(p->spatial_dims);
   p->out_position = allocate_list(p->spatial_dims);
+  if (p->in_var.stride.data == 0 || p->out_var.stride.data == 0 ||
+      p->w_var.stride.data == 0 ||
+      (p->b_var.v && p->b_var.stride.data == 0) ||
+      p->input_shape.data == 0 || p->kernel_shape.data == 0 ||
+      p->output_shape.data == 0 || p->in_position.data == 0 ||
+      p->out_position.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   for (i = 0; i < p->spatial_dims; i++) {
     p->kernel_shape.data[i] = p->w_var.shape.data[i + 3];
     p->input_shape.data[i] = p->in_var.shape.data[i + 3];
     p->output_shape.data[i] = p->out_var.shape.data[i + 3];
   }
+  p->col = 0;
+  p->winograd_weight = 0;
+  p->winograd_tiles = 0;
+  p->channel_last = 0;
+  p->packed_weight = 0;
+  p->pointwise = 0;
+  p->panel_weight = 0;
+  p->fixed_col = 0;
+  p->fixed_bias = 0;
+  p->fixed_scale = 0;
+  p->fixed_dot = 0;
+  p->fixed_weight = 0;
+  p->sign_weight = 0;
+  p->sign_col = 0;
+  p->dense_weight.data = 0;
+  p->epilogue.type = RT_EPILOGUE_NONE;
+  p->epilogue.alpha = 0.0f;
+  p->kernel = RT_KERNEL_DEFAULT;
 
 #ifdef CONFIG_DEPTHWISECONVOLUTION_FLOAT32
   f->exec_func = exec_depthwise_convolution;
@@ -144,6 +196,14 @@ allocate_depthwise_convolution_local_context(rt_function_t *f) {
 
   c->multiplier = group;
 
+  // Kernels read group from multiplier through convolution_local_context_t.
+  select_conv2d_direct((convolution_local_context_t *)c, p);
+#ifdef CONFIG_DEPTHWISECONVOLUTION_FLOAT32
+  p->depthwise_map = select_depthwise_map((convolution_local_context_t *)c, p);
+#else
+  p->depthwise_map = 0;
+#endif /* CONFIG_DEPTHWISECONVOLUTION_FLOAT32 */
+
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
@@ -173,8 +233,224 @@ rt_function_error_t free_depthwise_convolution_local_context(rt_function_t *f) {
 }
 
 #ifdef CONFIG_DEPTHWISECONVOLUTION_FLOAT32
+/*
+ * 2D depthwise convolution for shapes listed in
+ * NNABLART_SPECIALIZED_DEPTHWISE_CONVOLUTION. Output positions whose window
+ * is inside of input are calculated without bounds checks, as each kernel
+ * tap multiplied with a run of input row. With stride 1 or 2 the run is
+ * calculated by 8 (AVX2) or 4 (SSE2, NEON) outputs at once, and the rest by
+ * scalar loop whose kernel size and stride are constants. Only positions
+ * near borders check bounds for each tap.
+ */
+
+#if defined(DEPTHWISE_AVX2)
+#ifdef __FMA__
+#define DEPTHWISE_FMADD(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define DEPTHWISE_FMADD(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+// x[0], x[2], ..., x[14]
+static inline __m256 load_even_avx2(const float *x) {
+  __m256 even = _mm256_shuffle_ps(_mm256_loadu_ps(x), _mm256_loadu_ps(x + 8),
+                                  _MM_SHUFFLE(2, 0, 2, 0));
+  return _mm256_castpd_ps(
+      _mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+#endif /* DEPTHWISE_AVX2 */
+
+#if defined(DEPTHWISE_AVX2) || defined(DEPTHWISE_SSE2)
+// x[0], x[2], x[4], x[6]
+static inline __m128 load_even_sse(const float *x) {
+  return _mm_shuffle_ps(_mm_loadu_ps(x), _mm_loadu_ps(x + 4),
+                        _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif
+
+static float depthwise_border(const conv2d_job_t *job, const float *x,
+                              const float *w, int oy, int ox) {
+  int iy0 = oy * job->stride - job->pad_y;
+  int ix0 = ox * job->stride - job->pad_x;
+  float sum = 0.0f;
+  int ky, kx;
+  for (ky = 0; ky < job->kernel; ky++) {
+    int iy = iy0 + ky;
+    if (iy < 0 || iy >= job->ih) {
+      continue;
+    }
+    for (kx = 0; kx < job->kernel; kx++) {
+      int ix = ix0 + kx;
+      if (ix >= 0 && ix < job->iw) {
+        sum += x[iy * job->iw + ix] * w[ky * job->kernel + kx];
+      }
+    }
+  }
+  return sum;
+}
+
+static inline void depthwise_map(const conv2d_job_t *job, const float *x,
+                                 const float *w, float bias, float *y,
+                                 const int kernel, const int stride) {
+  int n = job->x_end - job->x_begin;
+  int oy, ox, ky, kx, j;
+
+  for (oy = 0; oy < job->oh; oy++) {
+    float *row = y + oy * job->ow;
+    if (oy < job->y_begin || oy >= job->y_end) {
+      for (ox = 0; ox < job->ow; ox++) {
+        row[ox] = depthwise_border(job, x, w, oy, ox) + bias;
+      }
+      continue;
+    }
+    for (ox = 0; ox < job->x_begin; ox++) {
+      row[ox] = depthwise_border(job, x, w, oy, ox) + bias;
+    }
+    for (ox = job->x_end; ox < job->ow; ox++) {
+      row[ox] = depthwise_border(job, x, w, oy, ox) + bias;
+    }
+
+    float *out = row + job->x_begin;
+    const float *in = x + (oy * stride - job->pad_y) * job->iw +
+                      job->x_begin * stride - job->pad_x;
+    int first = 0;
+#if defined(DEPTHWISE_AVX2)
+    // Stride 2 loads 16 values and takes even ones, last group is left to
+    // narrower loops not to read beyond the row.
+    for (; (stride == 1 || stride == 2) && first + 8 <= n &&
+           (stride == 1 || first + 8 < n);
+         first += 8) {
+      __m256 acc = _mm256_set1_ps(bias);
+      for (ky = 0; ky < kernel; ky++) {
+        for (kx = 0; kx < kernel; kx++) {
+          const float *xr = in + ky * job->iw + kx + first * stride;
+          __m256 v = stride == 1 ? _mm256_loadu_ps(xr) : load_even_avx2(xr);
+          acc = DEPTHWISE_FMADD(v, _mm256_set1_ps(w[ky * kernel + kx]), acc);
+        }
+      }
+      _mm256_storeu_ps(out + first, acc);
+    }
+#endif /* DEPTHWISE_AVX2 */
+#if defined(DEPTHWISE_AVX2) || defined(DEPTHWISE_SSE2)
+    for (; (stride == 1 || stride == 2) && first + 4 <= n &&
+           (stride == 1 || first + 4 < n);
+         first += 4) {
+      __m128 acc = _mm_set1_ps(bias);
+      for (ky = 0; ky < kernel; ky++) {
+        for (kx = 0; kx < kernel; kx++) {
+          const float *xr = in + ky * job->iw + kx + first * stride;
+          __m128 v = stride == 1 ? _mm_loadu_ps(xr) : load_even_sse(xr);
+          __m128 a = _mm_set1_ps(w[ky * kernel + kx]);
+          acc = _mm_add_ps(acc, _mm_mul_ps(v, a));
+        }
+      }
+      _mm_storeu_ps(out + first, acc);
+    }
+#endif
+#ifdef NNABLART_NEON
+    // 4 outputs at once. Stride 2 loads 8 values and takes even ones, last
+    // group is left to scalar loop not to read beyond the row.
+    for (; (stride == 1 || stride == 2) && first + 4 <= n &&
+           (stride == 1 || first + 4 < n);
+         first += 4) {
+      float32x4_t acc = vdupq_n_f32(bias);
+      for (ky = 0; ky < kernel; ky++) {
+        for (kx = 0; kx < kernel; kx++) {
+          const float *xr = in + ky * job->iw + kx + first * stride;
+          float32x4_t v = stride == 1 ? vld1q_f32(xr) : vld2q_f32(xr).val[0];
+          acc = vmlaq_n_f32(acc, v, w[ky * kernel + kx]);
+        }
+      }
+      vst1q_f32(out + first, acc);
+    }
+#endif /* NNABLART_NEON */
+    for (j = first; j < n; j++) {
+      out[j] = bias;
+    }
+    for (ky = 0; ky < kernel; ky++) {
+      for (kx = 0; kx < kernel; kx++) {
+        const float a = w[ky * kernel + kx];
+        const float *xr = in + ky * job->iw + kx;
+        for (j = first; j < n; j++) {
+          out[j] += a * xr[j * stride];
+        }
+      }
+    }
+  }
+}
+
+#define DEPTHWISE_MAP(K, S)                                                    \
+  static void depthwise_map_##K##_##S(const conv2d_job_t *job,                 \
+                                      const float *x, const float *w,          \
+                                      float bias, float *y) {                  \
+    depthwise_map(job, x, w, bias, y, K, S);                                   \
+  }
+NNABLART_SPECIALIZED_DEPTHWISE_CONVOLUTION(DEPTHWISE_MAP)
+#undef DEPTHWISE_MAP
+
+static depthwise_map_func_t
+select_depthwise_map(convolution_local_context_t *c, convolution_private_t *p) {
+  int kernel = p->kernel_shape.data[0];
+  int stride = c->stride.data[0];
+
+  if (!is_square_conv2d(c, p)) {
+    return 0;
+  }
+#define DEPTHWISE_MAP(K, S)                                                    \
+  if (kernel == (K) && stride == (S)) {                                        \
+    return depthwise_map_##K##_##S;                                            \
+  }
+  NNABLART_SPECIALIZED_DEPTHWISE_CONVOLUTION(DEPTHWISE_MAP)
+#undef DEPTHWISE_MAP
+  (void)kernel;
+  (void)stride;
+  return 0;
+}
+
+// Process output maps [begin, end), index is (b * group + g) * multiplier + m
+static void depthwise_2d_range(void *arg, int begin, int end) {
+  conv2d_job_t *job = (conv2d_job_t *)arg;
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)job->f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  int multiplier = p->out_var.shape.data[I];
+  int group = c->group;
+  int kernel_size = job->kernel * job->kernel;
+  const float *input = (const float *)(p->in_var.v->data);
+  const float *weight = (const float *)(p->w_var.v->data);
+  const float *bias = p->b_var.v ? (const float *)(p->b_var.v->data) : 0;
+  float *output = (float *)(p->out_var.v->data);
+  int index;
+
+  for (index = begin; index < end; index++) {
+    int b = index / (group * multiplier);
+    int g = (index / multiplier) % group;
+    const float *x =
+        input + b * p->in_var.stride.data[B] + g * p->in_var.stride.data[G];
+    const float *w = weight + (index % (group * multiplier)) * kernel_size;
+    float *y = output + index * p->out_var.stride.data[I];
+    float bias_value = bias ? bias[index % (group * multiplier)] : 0.0f;
+
+    p->depthwise_map(job, x, w, bias_value, y);
+    apply_epilogue(&p->epilogue, y, job->oh * job->ow);
+  }
+}
+
 rt_function_error_t exec_depthwise_convolution(rt_function_t *f) {
-  return exec_convolution_float(f);
+  convolution_local_context_t *c =
+      (convolution_local_context_t *)f->local_context;
+  convolution_private_t *p = (convolution_private_t *)(c->data);
+  conv2d_job_t job;
+
+  if (p->depthwise_map == 0) {
+    return exec_convolution_float(f);
+  }
+  init_conv2d_job(&job, f);
+
+  int num_of_maps =
+      p->out_var.shape.data[B] * c->group * p->out_var.shape.data[I];
+  rt_parallel_for(num_of_maps, job.oh * job.ow * job.kernel * job.kernel,
+                  depthwise_2d_range, &job);
+  return RT_FUNCTION_ERROR_NOERROR;
 }
 #endif /* CONFIG_DEPTHWISECONVOLUTION_FLOAT32 */
 
@@ -16,11 +16,20 @@
 #include <nnablart/functions.h>
 
 #include "../../utilities/accessor.h"
+#include "../../utilities/sgemm.h"
 #include "../../utilities/shape.h"
 #include <string.h>
 
 #ifdef CONFIG_DECONVOLUTION
 
+#define DECONV_MAX_SPATIAL_DIMS (8) // Max number of spatial dimensions
+
+// Max bytes of GEMM result buffer. Input positions are processed in tiles
+// which fit in it.
+#ifndef DECONV_COL_MAX_SIZE
+#define DECONV_COL_MAX_SIZE (4 * 1024 * 1024)
+#endif
+
 typedef struct {
   rt_variable_t *input;
   rt_variable_getter get_input;
@@ -43,6 +52,9 @@ typedef struct {
 
   int spatial_dims;
   int base_loop_size;
+
+  float *col;      ///< GEMM result buffer, or NULL to deconvolve directly.
+  int col_columns; ///< Number of input positions in GEMM result buffer.
 } deconvolution_private_t;
 
 rt_function_error_t exec_deconvolution_generic(rt_function_t *f);
@@ -87,12 +99,20 @@ rt_function_error_t allocate_deconvolution_local_context(rt_function_t *f) {
     p->base_loop_size *= p->input->shape.data[i];
   }
   p->spatial_dims = p->input->shape.size - c->base_axis - 1;
+  if (p->spatial_dims > DECONV_MAX_SPATIAL_DIMS) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
 
   p->input_shape = allocate_list(p->spatial_dims);
   p->kernel_shape = allocate_list(p->spatial_dims);
   p->output_shape = allocate_list(p->spatial_dims);
   p->in_position = allocate_list(p->spatial_dims);
   p->out_position = allocate_list(p->spatial_dims);
+  if (p->input_shape.data == 0 || p->kernel_shape.data == 0 ||
+      p->output_shape.data == 0 || p->in_position.data == 0 ||
+      p->out_position.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
 
   for (int i = 0; i < p->spatial_dims; i++) {
     p->kernel_shape.data[i] = p->weight->shape.data[i + 2];
@@ -100,12 +120,26 @@ rt_function_error_t allocate_deconvolution_local_context(rt_function_t *f) {
     p->output_shape.data[i] = p->output->shape.data[i + c->base_axis + 1];
   }
 
+  p->col = 0;
+  p->col_columns = 0;
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT &&
       p->weight->type == NN_DATA_TYPE_FLOAT &&
       ((p->bias && p->bias->type == NN_DATA_TYPE_FLOAT) || !p->bias)) {
 #ifdef CONFIG_DECONVOLUTION_FLOAT32
     f->exec_func = exec_deconvolution;
+
+    // Float deconvolution is executed as GEMM of transposed weight and input
+    // followed by col2im, or directly if allocation failed.
+    size_t rows = p->weight->shape.data[1] * calc_shape_size(p->kernel_shape);
+    size_t columns = calc_shape_size(p->input_shape);
+    if (rows * columns * sizeof(float) > DECONV_COL_MAX_SIZE) {
+      columns = DECONV_COL_MAX_SIZE / (rows * sizeof(float));
+    }
+    if (columns > 0) {
+      p->col = rt_malloc_func(rows * columns * sizeof(float));
+      p->col_columns = columns;
+    }
 #endif /* CONFIG_DECONVOLUTION_FLOAT32 */
   } else {
 #ifdef CONFIG_DECONVOLUTION_GENERIC
@@ -124,12 +158,17 @@ rt_function_error_t free_deconvolution_local_context(rt_function_t *f) {
   free_list(p->kernel_shape);
   free_list(p->in_position);
   free_list(p->out_position);
+  if (p->col != 0) {
+    rt_free_func(p->col);
+  }
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
 #ifdef CONFIG_DECONVOLUTION_FLOAT32
-rt_function_error_t exec_deconvolution(rt_function_t *f) {
+// Process output maps in [begin, end), index is (b * group + g) * maps + om
+static void deconvolution_range(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
   deconvolution_local_context_t *c =
       (deconvolution_local_context_t *)(f->local_context);
   deconvolution_private_t *p = (deconvolution_private_t *)(c->data);
@@ -137,67 +176,237 @@ rt_function_error_t exec_deconvolution(rt_function_t *f) {
   int output_size = calc_shape_size(p->output_shape);
   int kernel_size = calc_shape_size(p->kernel_shape);
   int input_size = calc_shape_size(p->input_shape);
+  int maps = p->weight->shape.data[1];
+
+  // Each range works on its own positions.
+  int in_position_data[DECONV_MAX_SPATIAL_DIMS];
+  int out_position_data[DECONV_MAX_SPATIAL_DIMS];
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+
+  for (int index = begin; index < end; index++) {
+    int om = index % maps;
+    int g = (index / maps) % c->group;
+    int b = index / (maps * c->group);
+    int output_offset = (b * c->group * maps + g * maps + om) * output_size;
+    for (int im = 0; im < p->weight->shape.data[0] / c->group; im++) {
+      int input_offset = (b * p->weight->shape.data[0] +
+                          g * p->weight->shape.data[0] / c->group + im) *
+                         input_size;
+      int kernel_offset =
+          (g * maps * p->weight->shape.data[0] / c->group + im * maps + om) *
+          kernel_size;
+      for (int o = 0; o < output_size; o++) {
+        float sum = 0.0f;
+        pos_to_shape(out_position, p->output_shape, o);
+        for (int k = 0; k < kernel_size; k++) {
+          pos_to_shape(in_position, p->kernel_shape, k);
+          uint8_t condition = 1;
+          for (int j = 0; j < p->spatial_dims; j++) {
+            int k1 = c->dilation.data[j] * (p->kernel_shape.data[j] - 1) + 1;
+            in_position.data[j] *= c->dilation.data[j];
+            in_position.data[j] -= k1 - c->pad.data[j] - 1;
+            in_position.data[j] += out_position.data[j];
+            if (in_position.data[j] % c->stride.data[j] != 0) {
+              condition = 0;
+              break;
+            }
+            in_position.data[j] = in_position.data[j] / c->stride.data[j];
+            if (in_position.data[j] < 0 ||
+                in_position.data[j] >= p->input_shape.data[j]) {
+              condition = 0;
+              break;
+            }
+          }
+          if (condition) {
+            float x = *((float *)(p->input->data) + input_offset +
+                        shape_to_pos(p->input_shape, in_position));
+            float w = *((float *)(p->weight->data) + kernel_offset +
+                        (kernel_size - k - 1));
+            sum += x * w;
+          }
+        }
+        *((float *)(p->output->data) + output_offset + o) += sum;
+      }
+    }
+    if (p->bias) {
+      for (int o = 0; o < output_size; o++) {
+        *((float *)(p->output->data) + output_offset + o) +=
+            *((float *)(p->bias->data) + g * maps + om);
+      }
+    }
+  }
+}
 
-  memset(p->output->data, 0, sizeof(float) * calc_shape_size(p->output->shape));
+typedef struct {
+  deconvolution_local_context_t *c;
+  deconvolution_private_t *p;
+  const float *input;  ///< Input maps of current batch and group.
+  const float *weight; ///< Weight of current group.
+  float *output;       ///< Output maps of current batch and group.
+  int first;           ///< First input position in GEMM result buffer.
+  int columns;         ///< Number of input positions in GEMM result buffer.
+} deconvolution_gemm_job_t;
+
+// Calculate rows [begin, end) of GEMM result buffer. Row (om * kernel_size +
+// k) holds contributions of input positions to kernel position k of output
+// map om, it is product of transposed weight and input.
+static void deconvolution_gemm_range(void *arg, int begin, int end) {
+  deconvolution_gemm_job_t *job = (deconvolution_gemm_job_t *)arg;
+  deconvolution_private_t *p = job->p;
+  int n = job->columns;
+  int rows = p->weight->shape.data[1] * calc_shape_size(p->kernel_shape);
+  int in_maps = p->weight->shape.data[0] / job->c->group;
+  int input_size = calc_shape_size(p->input_shape);
 
-  for (int b = 0; b < p->base_loop_size; b++) {
-    for (int g = 0; g < c->group; g++) {
-      for (int om = 0; om < p->weight->shape.data[1]; om++) {
-        int output_offset = (b * c->group * p->weight->shape.data[1] +
-                             g * p->weight->shape.data[1] + om) *
-                            output_size;
-        for (int im = 0; im < p->weight->shape.data[0] / c->group; im++) {
-          int input_offset = (b * p->weight->shape.data[0] +
-                              g * p->weight->shape.data[0] / c->group + im) *
-                             input_size;
-          int kernel_offset = (g * p->weight->shape.data[1] *
-                                   p->weight->shape.data[0] / c->group +
-                               im * p->weight->shape.data[1] + om) *
-                              kernel_size;
-          for (int o = 0; o < output_size; o++) {
-            float sum = 0.0f;
-            pos_to_shape(p->out_position, p->output_shape, o);
-            for (int k = 0; k < kernel_size; k++) {
-              pos_to_shape(p->in_position, p->kernel_shape, k);
-              uint8_t condition = 1;
-              for (int j = 0; j < p->spatial_dims; j++) {
-                int k1 =
-                    c->dilation.data[j] * (p->kernel_shape.data[j] - 1) + 1;
-                p->in_position.data[j] *= c->dilation.data[j];
-                p->in_position.data[j] -= k1 - c->pad.data[j] - 1;
-                p->in_position.data[j] += p->out_position.data[j];
-                if (p->in_position.data[j] % c->stride.data[j] != 0) {
-                  condition = 0;
-                  break;
-                }
-                p->in_position.data[j] =
-                    p->in_position.data[j] / c->stride.data[j];
-                if (p->in_position.data[j] < 0 ||
-                    p->in_position.data[j] >= p->input_shape.data[j]) {
-                  condition = 0;
-                  break;
-                }
-              }
-              if (condition) {
-                float x = *((float *)(p->input->data) + input_offset +
-                            shape_to_pos(p->input_shape, p->in_position));
-                float w = *((float *)(p->weight->data) + kernel_offset +
-                            (kernel_size - k - 1));
-                sum += x * w;
-              }
-            }
-            *((float *)(p->output->data) + output_offset + o) += sum;
+  sgemm(end - begin, n, in_maps, job->weight + begin, 1, rows,
+        job->input + job->first, input_size, 1, p->col + begin * n, n);
+}
+
+// Scatter-add GEMM result buffer to output maps [begin, end).
+static void col2im_range(void *arg, int begin, int end) {
+  deconvolution_gemm_job_t *job = (deconvolution_gemm_job_t *)arg;
+  deconvolution_local_context_t *c = job->c;
+  deconvolution_private_t *p = job->p;
+  int n = job->columns;
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int output_size = calc_shape_size(p->output_shape);
+  int *pad = c->pad.data;
+  int *stride = c->stride.data;
+  int *dilation = c->dilation.data;
+  int kernel_position_data[DECONV_MAX_SPATIAL_DIMS];
+  int in_position_data[DECONV_MAX_SPATIAL_DIMS];
+  int out_position_data[DECONV_MAX_SPATIAL_DIMS];
+  rt_list_t kernel_position = {p->spatial_dims, kernel_position_data};
+  rt_list_t in_position = {p->spatial_dims, in_position_data};
+  rt_list_t out_position = {p->spatial_dims, out_position_data};
+  int om, k, i, j;
+
+  for (om = begin; om < end; om++) {
+    float *y = job->output + om * output_size;
+    for (k = 0; k < kernel_size; k++) {
+      const float *col = p->col + (om * kernel_size + k) * n;
+      pos_to_shape(kernel_position, p->kernel_shape, k);
+
+      if (p->spatial_dims == 2) {
+        int iw = p->input_shape.data[1];
+        int oh = p->output_shape.data[0];
+        int ow = p->output_shape.data[1];
+        int ky = kernel_position_data[0] * dilation[0] - pad[0];
+        int kx = kernel_position_data[1] * dilation[1] - pad[1];
+        int iy = job->first / iw;
+        int ix = job->first % iw;
+        for (i = 0; i < n; i++) {
+          int oy = iy * stride[0] + ky;
+          int ox = ix * stride[1] + kx;
+          if (oy >= 0 && oy < oh && ox >= 0 && ox < ow) {
+            y[oy * ow + ox] += col[i];
+          }
+          if (++ix == iw) {
+            ix = 0;
+            iy++;
           }
         }
-        if (p->bias) {
-          for (int o = 0; o < output_size; o++) {
-            *((float *)(p->output->data) + output_offset + o) +=
-                *((float *)(p->bias->data) + g * p->weight->shape.data[1] + om);
+        continue;
+      }
+
+      for (i = 0; i < n; i++) {
+        uint8_t condition = 1;
+        pos_to_shape(in_position, p->input_shape, job->first + i);
+        for (j = 0; j < p->spatial_dims; j++) {
+          out_position_data[j] = in_position_data[j] * stride[j] - pad[j] +
+                                 kernel_position_data[j] * dilation[j];
+          if (out_position_data[j] < 0 ||
+              out_position_data[j] >= p->output_shape.data[j]) {
+            condition = 0;
+            break;
           }
         }
+        if (condition) {
+          y[shape_to_pos(p->output_shape, out_position)] += col[i];
+        }
+      }
+    }
+  }
+}
+
+// Add bias to output maps [begin, end), index is (b * group + g) * maps + om
+static void deconvolution_bias_range(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  deconvolution_local_context_t *c =
+      (deconvolution_local_context_t *)(f->local_context);
+  deconvolution_private_t *p = (deconvolution_private_t *)(c->data);
+  int output_size = calc_shape_size(p->output_shape);
+  int channels = c->group * p->weight->shape.data[1];
+  int index, o;
+
+  for (index = begin; index < end; index++) {
+    float *y = (float *)(p->output->data) + index * output_size;
+    float bias = *((float *)(p->bias->data) + index % channels);
+    for (o = 0; o < output_size; o++) {
+      y[o] += bias;
+    }
+  }
+}
+
+static void exec_deconvolution_gemm(rt_function_t *f) {
+  deconvolution_local_context_t *c =
+      (deconvolution_local_context_t *)(f->local_context);
+  deconvolution_private_t *p = (deconvolution_private_t *)(c->data);
+  int maps = p->weight->shape.data[1];
+  int in_maps = p->weight->shape.data[0] / c->group;
+  int kernel_size = calc_shape_size(p->kernel_shape);
+  int input_size = calc_shape_size(p->input_shape);
+  int output_size = calc_shape_size(p->output_shape);
+  int rows = maps * kernel_size;
+  deconvolution_gemm_job_t job;
+  int b, g;
+
+  job.c = c;
+  job.p = p;
+  for (b = 0; b < p->base_loop_size; b++) {
+    for (g = 0; g < c->group; g++) {
+      job.input = (float *)(p->input->data) +
+                  (b * c->group + g) * in_maps * input_size;
+      job.weight = (float *)(p->weight->data) + g * in_maps * rows;
+      job.output = (float *)(p->output->data) +
+                   (b * c->group + g) * maps * output_size;
+      for (job.first = 0; job.first < input_size;
+           job.first += p->col_columns) {
+        job.columns = input_size - job.first < p->col_columns
+                          ? input_size - job.first
+                          : p->col_columns;
+        rt_parallel_for(rows, in_maps * job.columns, deconvolution_gemm_range,
+                        &job);
+        rt_parallel_for(maps, kernel_size * job.columns, col2im_range, &job);
       }
     }
   }
+  if (p->bias) {
+    rt_parallel_for(p->base_loop_size * c->group * maps, output_size,
+                    deconvolution_bias_range, f);
+  }
+}
+
+rt_function_error_t exec_deconvolution(rt_function_t *f) {
+  deconvolution_local_context_t *c =
+      (deconvolution_local_context_t *)(f->local_context);
+  deconvolution_private_t *p = (deconvolution_private_t *)(c->data);
+
+  memset(p->output->data, 0, sizeof(float) * calc_shape_size(p->output->shape));
+
+  if (p->col) {
+    exec_deconvolution_gemm(f);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+
+  int num_of_maps = p->base_loop_size * c->group * p->weight->shape.data[1];
+
+  rt_parallel_for(num_of_maps,
+                  calc_shape_size(p->output_shape) *
+                      calc_shape_size(p->kernel_shape) *
+                      (p->weight->shape.data[0] / c->group),
+                  deconvolution_range, f);
 
   return RT_FUNCTION_ERROR_NOERROR;
 }
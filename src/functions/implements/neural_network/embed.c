@@ -0,0 +1,183 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/accessor.h"
+#include "../../utilities/shape.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <string.h>
+
+#ifdef CONFIG_EMBED
+
+#define EMBED_CACHE_LINE (64) // Bytes of each prefetch of next row
+
+#if defined(__GNUC__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p)
+#endif
+
+// Output is row of weight w[x0[i]] for each index x0[i]. Rows of weight are
+// copied as bytes whenever weight and output have the same format, so that
+// tables of INT8, INT16, FLOAT16 or BFLOAT16 are read without conversion.
+typedef struct {
+  rt_variable_getter get_index;
+  rt_variable_setter set_output;
+  int num_of_indices;
+  int num_of_rows;
+  int row_size;
+  size_t row_bytes; ///< Bytes of row copied as is, or 0 to convert values.
+} embed_local_context_t;
+
+rt_function_error_t exec_embed_generic(rt_function_t *f);
+
+// Same representation of values, without scales of each channel.
+static int is_same_format(const rt_variable_t *w, const rt_variable_t *y) {
+  if (w->type != y->type || w->quantization || y->quantization) {
+    return 0;
+  }
+  switch (w->type) {
+  case NN_DATA_TYPE_INT8:
+  case NN_DATA_TYPE_INT16:
+    return w->fp_pos == y->fp_pos;
+  case NN_DATA_TYPE_SIGN:
+    return 0;
+  default:
+    return 1;
+  }
+}
+
+// Index of row, or -1 if value is out of weight.
+static inline int get_row(embed_local_context_t *c, float value) {
+  int row = (int)value;
+  return row >= 0 && row < c->num_of_rows ? row : -1;
+}
+
+static inline void prefetch_row(const uint8_t *row, size_t bytes) {
+  size_t k; // Iterator
+  for (k = 0; k < bytes; k += EMBED_CACHE_LINE) {
+    PREFETCH(row + k);
+  }
+}
+
+// Embed
+rt_function_error_t allocate_embed_local_context(rt_function_t *f) {
+  if (f->num_of_inputs != 2) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *w = f->inputs[1];
+  rt_variable_t *y = f->outputs[0];
+  if (w->shape.size < 1 || w->shape.data[0] < 1) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
+  embed_local_context_t *c = rt_malloc_func(sizeof(embed_local_context_t));
+  if (c == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  f->local_context = (void *)c;
+  c->get_index = select_getter(x);
+  c->set_output = select_setter(y);
+  c->num_of_indices = calc_shape_size(x->shape);
+  c->num_of_rows = w->shape.data[0];
+  c->row_size = calc_shape_size(w->shape) / c->num_of_rows;
+  if (c->num_of_indices * c->row_size != calc_shape_size(y->shape)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  c->row_bytes = is_same_format(w, y)
+                     ? get_element_size(w->type) * (size_t)c->row_size
+                     : 0;
+
+  if (x->type == NN_DATA_TYPE_FLOAT && w->type == NN_DATA_TYPE_FLOAT &&
+      y->type == NN_DATA_TYPE_FLOAT) {
+#ifdef CONFIG_EMBED_FLOAT32
+    f->exec_func = exec_embed;
+#endif /* CONFIG_EMBED_FLOAT32 */
+  } else {
+#ifdef CONFIG_EMBED_GENERIC
+    f->exec_func = exec_embed_generic;
+#endif /* CONFIG_EMBED_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_embed_local_context(rt_function_t *f) {
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Indices out of weight give rows of 0.
+#ifdef CONFIG_EMBED_FLOAT32
+rt_function_error_t exec_embed(rt_function_t *f) {
+  embed_local_context_t *c = (embed_local_context_t *)(f->local_context);
+  const float *x = (const float *)(f->inputs[0]->data);
+  const float *w = (const float *)(f->inputs[1]->data);
+  float *y = (float *)(f->outputs[0]->data);
+  int next = c->num_of_indices > 0 ? get_row(c, x[0]) : -1;
+  int i; // Iterator
+
+  for (i = 0; i < c->num_of_indices; i++, y += c->row_size) {
+    int row = next;
+    next = i + 1 < c->num_of_indices ? get_row(c, x[i + 1]) : -1;
+    if (next >= 0) {
+      prefetch_row((const uint8_t *)(w + next * c->row_size), c->row_bytes);
+    }
+    if (row < 0) {
+      memset(y, 0, sizeof(float) * c->row_size);
+    } else {
+      memcpy(y, w + row * c->row_size, sizeof(float) * c->row_size);
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_EMBED_FLOAT32 */
+
+#ifdef CONFIG_EMBED_GENERIC
+rt_function_error_t exec_embed_generic(rt_function_t *f) {
+  embed_local_context_t *c = (embed_local_context_t *)(f->local_context);
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *w = f->inputs[1];
+  rt_variable_t *y = f->outputs[0];
+  const uint8_t *data = (const uint8_t *)(w->data);
+  int next = c->num_of_indices > 0 ? get_row(c, c->get_index(x, 0)) : -1;
+  int i, k; // Iterators
+
+  for (i = 0; i < c->num_of_indices; i++) {
+    int row = next;
+    nn_size_t pos = (nn_size_t)i * c->row_size;
+    next = i + 1 < c->num_of_indices ? get_row(c, c->get_index(x, i + 1))
+                                     : -1;
+    if (next >= 0 && c->row_bytes > 0) {
+      prefetch_row(data + (size_t)next * c->row_bytes, c->row_bytes);
+    }
+    if (row < 0) {
+      for (k = 0; k < c->row_size; k++) {
+        c->set_output(y, pos + k, 0.0f);
+      }
+    } else if (c->row_bytes > 0) {
+      memcpy((uint8_t *)(y->data) + (size_t)i * c->row_bytes,
+             data + (size_t)row * c->row_bytes, c->row_bytes);
+    } else {
+      copy_variable_block(w, (nn_size_t)row * c->row_size, y, pos,
+                          c->row_size);
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_EMBED_GENERIC */
+
+#endif /* CONFIG_EMBED */
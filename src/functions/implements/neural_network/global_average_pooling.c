@@ -0,0 +1,133 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#include "../../utilities/accessor.h"
+#include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
+
+#ifdef CONFIG_GLOBALAVERAGEPOOLING
+
+// Each of output elements is average of one contiguous map of input, which
+// is all axes after channel. GlobalAveragePooling has no parameter, so sizes
+// are taken from shapes at exec.
+
+typedef struct {
+  const float *x;
+  float *y;
+  int map_size;
+  float scale;
+} global_average_pooling_job_t;
+
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_GENERIC
+static rt_function_error_t
+exec_global_average_pooling_generic(rt_function_t *f);
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_GENERIC */
+
+rt_function_error_t
+allocate_global_average_pooling_local_context(rt_function_t *f) {
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  const int input_size = calc_shape_size(f->inputs[0]->shape);
+  const int output_size = calc_shape_size(f->outputs[0]->shape);
+  if (f->inputs[0]->shape.size < 2 || output_size <= 0 ||
+      output_size != f->inputs[0]->shape.data[0] *
+                         f->inputs[0]->shape.data[1] ||
+      input_size % output_size != 0) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
+  if (f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+      f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_FLOAT32
+    f->exec_func = exec_global_average_pooling;
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_FLOAT32 */
+  } else {
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_GENERIC
+    f->exec_func = exec_global_average_pooling_generic;
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t
+free_global_average_pooling_local_context(rt_function_t *f) {
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static void average_maps(void *arg, int begin, int end) {
+  const global_average_pooling_job_t *job =
+      (const global_average_pooling_job_t *)arg;
+  int i; // Iterator
+  for (i = begin; i < end; i++) {
+    job->y[i] =
+        vector_sum(job->x + (nn_size_t)i * job->map_size, job->map_size) *
+        job->scale;
+  }
+}
+
+void calc_global_average_pooling(const float *x, float *y, int maps,
+                                 int map_size) {
+  global_average_pooling_job_t job;
+  job.x = x;
+  job.y = y;
+  job.map_size = map_size;
+  job.scale = 1.0f / map_size;
+  rt_parallel_for(maps, map_size, average_maps, &job);
+}
+
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_FLOAT32
+rt_function_error_t exec_global_average_pooling(rt_function_t *f) {
+  const int maps = calc_shape_size(f->outputs[0]->shape);
+  calc_global_average_pooling((const float *)(f->inputs[0]->data),
+                              (float *)(f->outputs[0]->data), maps,
+                              calc_shape_size(f->inputs[0]->shape) / maps);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_FLOAT32 */
+
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_GENERIC
+static rt_function_error_t
+exec_global_average_pooling_generic(rt_function_t *f) {
+  const int maps = calc_shape_size(f->outputs[0]->shape);
+  const int map_size = calc_shape_size(f->inputs[0]->shape) / maps;
+  const float scale = 1.0f / map_size;
+  float block[ACCESSOR_BLOCK_SIZE];
+  int i, begin; // Iterator
+
+  for (i = 0; i < maps; i++) {
+    float sum = 0.0f;
+    for (begin = 0; begin < map_size; begin += ACCESSOR_BLOCK_SIZE) {
+      int n = map_size - begin;
+      if (n > ACCESSOR_BLOCK_SIZE) {
+        n = ACCESSOR_BLOCK_SIZE;
+      }
+      get_variable_block(f->inputs[0], (nn_size_t)i * map_size + begin, n,
+                         block);
+      sum += vector_sum(block, n);
+    }
+    sum *= scale;
+    set_variable_block(f->outputs[0], i, 1, &sum);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_GENERIC */
+
+#endif /* CONFIG_GLOBALAVERAGEPOOLING */
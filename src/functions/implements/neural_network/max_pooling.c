@@ -26,7 +26,7 @@ rt_function_error_t allocate_max_pooling_local_context(rt_function_t *f) {
       (max_pooling_local_context_t *)(f->local_context);
   pooling_private_t *p = rt_malloc_func(sizeof(pooling_private_t));
   rt_function_error_t ret =
-      allocate_pooling(f, (pooling_context_t *)context, p);
+      allocate_pooling(f, (pooling_context_t *)context, p, 0);
   ((max_pooling_local_context_t *)(f->local_context))->data = (void *)p;
   f->exec_func = exec_max_pooling;
   return ret;
@@ -53,7 +53,9 @@ rt_function_error_t exec_max_pooling(rt_function_t *f) {
   } else {
 #ifdef CONFIG_MAXPOOLING_GENERIC
     return exec_pooling_generic(f, (pooling_context_t *)context, p,
-                                calc_max_generic);
+                                is_fixed_point(p->calc_context.x)
+                                    ? calc_max_fixed
+                                    : calc_max_generic);
 #endif /* CONFIG_MAXPOOLING_GENERIC */
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -13,20 +13,40 @@
 // limitations under the License.
 
 #include "pooling.h"
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
-#include <math.h>
+#include "../../utilities/specialized.h"
+#include <string.h>
+
+#define POOLING_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define POOLING_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+static pooling_row_func_t select_pooling_row(const pooling_context_t *context);
 
 rt_function_error_t allocate_pooling(rt_function_t *f,
                                      pooling_context_t *context,
-                                     pooling_private_t *p) {
+                                     pooling_private_t *p,
+                                     uint8_t including_pad) {
   if (p == 0) {
     return RT_FUNCTION_ERROR_MALLOC;
   }
   p->input_shape = clone_list(f->inputs[0]->shape);
   p->output_shape = clone_list(f->outputs[0]->shape);
-  p->input_n_kernel_size_diff = p->input_shape.size - context->kernel.size;
+  if (p->input_shape.data == 0 || p->output_shape.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  // Kernel is applied to axes from input_n_kernel_size_diff, which are
+  // followed by channel axis if channel_last.
+  p->input_n_kernel_size_diff = p->input_shape.size - context->kernel.size -
+                                (context->channel_last ? 1 : 0);
+  if (p->input_n_kernel_size_diff < 0) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
   if (context->stride.size == 0) {
     context->stride = clone_list(context->kernel);
+    if (context->stride.data == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
   } else {
     if (context->kernel.size != context->stride.size) {
       return RT_FUNCTION_ERROR_INVALID_SHAPE;
@@ -41,10 +61,16 @@ rt_function_error_t allocate_pooling(rt_function_t *f,
   if (context->kernel.size != context->pad.size) {
     return RT_FUNCTION_ERROR_INVALID_SHAPE;
   }
+  if (context->channel_last && context->kernel.size != 2) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
 
   // Calc and set output shape.
   rt_list_t shape = allocate_list(context->kernel.size);
   int i;
+  if (shape.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   for (i = 0; i < shape.size; i++) {
     int _w = p->input_shape.data[i + p->input_n_kernel_size_diff];
     int _k = context->kernel.data[i];
@@ -53,7 +79,8 @@ rt_function_error_t allocate_pooling(rt_function_t *f,
     shape.data[i] = (_w + _p - (context->ignore_border ? _k - _p : 1)) / _s + 1;
   }
   for (i = 0; i < p->input_shape.size; i++) {
-    if (i < p->input_n_kernel_size_diff) {
+    if (i < p->input_n_kernel_size_diff ||
+        i >= p->input_n_kernel_size_diff + shape.size) {
       p->output_shape.data[i] = p->input_shape.data[i];
     } else {
       p->output_shape.data[i] = shape.data[i - p->input_n_kernel_size_diff];
@@ -64,6 +91,9 @@ rt_function_error_t allocate_pooling(rt_function_t *f,
   // Calc x_map_size and y_map_size.
   p->input_strides = calc_contiguous_strides(f->inputs[0]->shape);
   p->output_strides = calc_contiguous_strides(f->outputs[0]->shape);
+  if (p->input_strides.data == 0 || p->output_strides.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->x_map_size = (p->input_n_kernel_size_diff == 0)
                       ? calc_shape_size(f->inputs[0]->shape)
                       : p->input_strides.data[p->input_n_kernel_size_diff - 1];
@@ -83,7 +113,8 @@ rt_function_error_t allocate_pooling(rt_function_t *f,
   p->calc_context.get_x = select_getter(p->calc_context.x);
   p->calc_context.y = f->outputs[0];
   p->calc_context.set_y = select_setter(p->calc_context.y);
-  p->calc_context.including_pad = context->including_pad;
+  p->calc_context.including_pad = including_pad;
+  p->row_inside = select_pooling_row(context);
 
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -97,10 +128,269 @@ rt_function_error_t free_pooling(pooling_private_t *p) {
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
-rt_function_error_t exec_pooling(rt_function_t *f, pooling_context_t *context,
-                                 pooling_private_t *p,
-                                 exec_pooling_func_t exec) {
-  float *y = (float *)(p->calc_context.y->data);
+typedef struct {
+  pooling_context_t *context;
+  pooling_private_t *p;
+  exec_pooling_func_t exec;
+} pooling_job_t;
+
+// Operation of exec, so that float kernels calculate windows without calling
+// it for each output.
+typedef enum {
+  POOLING_OP_OTHER,
+  POOLING_OP_MAX,
+  POOLING_OP_SUM,
+  POOLING_OP_AVERAGE,
+} pooling_op_t;
+
+static pooling_op_t pooling_op(exec_pooling_func_t exec) {
+  if (exec == calc_max) {
+    return POOLING_OP_MAX;
+  } else if (exec == calc_sum) {
+    return POOLING_OP_SUM;
+  } else if (exec == calc_average) {
+    return POOLING_OP_AVERAGE;
+  }
+  return POOLING_OP_OTHER;
+}
+
+#if defined(NNABLART_NEON)
+#define POOLING_SIMD
+typedef float32x4_t pooling_vf_t;
+static inline pooling_vf_t pooling_load(const float *p, int stride) {
+  return stride == 1 ? vld1q_f32(p) : vld2q_f32(p).val[0];
+}
+static inline pooling_vf_t pooling_set(float a) { return vdupq_n_f32(a); }
+static inline pooling_vf_t pooling_add(pooling_vf_t a, pooling_vf_t b) {
+  return vaddq_f32(a, b);
+}
+static inline pooling_vf_t pooling_max(pooling_vf_t a, pooling_vf_t b) {
+  return vmaxq_f32(a, b);
+}
+static inline pooling_vf_t pooling_div(pooling_vf_t a, pooling_vf_t b) {
+  float va[4], vb[4];
+  int l;
+  vst1q_f32(va, a);
+  vst1q_f32(vb, b);
+  for (l = 0; l < 4; l++) {
+    va[l] /= vb[l];
+  }
+  return vld1q_f32(va);
+}
+static inline void pooling_store(float *p, pooling_vf_t a) { vst1q_f32(p, a); }
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POOLING_SIMD
+#include <emmintrin.h>
+typedef __m128 pooling_vf_t;
+static inline pooling_vf_t pooling_load(const float *p, int stride) {
+  if (stride == 1) {
+    return _mm_loadu_ps(p);
+  }
+  return _mm_shuffle_ps(_mm_loadu_ps(p), _mm_loadu_ps(p + 4),
+                        _MM_SHUFFLE(2, 0, 2, 0));
+}
+static inline pooling_vf_t pooling_set(float a) { return _mm_set1_ps(a); }
+static inline pooling_vf_t pooling_add(pooling_vf_t a, pooling_vf_t b) {
+  return _mm_add_ps(a, b);
+}
+// Keeps a when b is NaN, same as comparison in calc_max().
+static inline pooling_vf_t pooling_max(pooling_vf_t a, pooling_vf_t b) {
+  return _mm_max_ps(b, a);
+}
+static inline pooling_vf_t pooling_div(pooling_vf_t a, pooling_vf_t b) {
+  return _mm_div_ps(a, b);
+}
+static inline void pooling_store(float *p, pooling_vf_t a) {
+  _mm_storeu_ps(p, a);
+}
+#endif
+
+// Calculate size outputs y of a 2D row whose windows are all inside input.
+// x is top left of window of y[0], and avail is number of input columns from
+// it to the end of row. Values are accumulated in same order as calc_max(),
+// calc_sum() and calc_average(), so results are same as theirs.
+static inline void pooling_row_inside(pooling_op_t op, const float *x, int wx,
+                                      int avail, int hkernel, int wkernel,
+                                      int wstride, float *y, int size) {
+  const float pool_size = (float)(hkernel * wkernel);
+  int j = 0;
+  int ix, jx;
+
+#ifdef POOLING_SIMD
+  if (wstride == 1 || wstride == 2) {
+    // Stride 2 loads one more value after window, it must be in the row too.
+    for (; j + 4 <= size && (j + 3) * wstride + wkernel + wstride - 1 <= avail;
+         j += 4) {
+      const float *xs = x + j * wstride;
+      pooling_vf_t acc =
+          op == POOLING_OP_MAX ? pooling_load(xs, wstride) : pooling_set(0.0f);
+      for (ix = 0; ix < hkernel; ix++) {
+        for (jx = 0; jx < wkernel; jx++) {
+          pooling_vf_t v = pooling_load(xs + ix * wx + jx, wstride);
+          acc = op == POOLING_OP_MAX ? pooling_max(acc, v)
+                                     : pooling_add(acc, v);
+        }
+      }
+      if (op == POOLING_OP_AVERAGE) {
+        acc = pooling_div(acc, pooling_set(pool_size));
+      }
+      pooling_store(y + j, acc);
+    }
+  }
+#endif /* POOLING_SIMD */
+  for (; j < size; j++) {
+    const float *xs = x + j * wstride;
+    float acc = op == POOLING_OP_MAX ? xs[0] : 0.0f;
+    for (ix = 0; ix < hkernel; ix++) {
+      for (jx = 0; jx < wkernel; jx++) {
+        const float v = xs[ix * wx + jx];
+        if (op != POOLING_OP_MAX) {
+          acc += v;
+        } else if (acc < v) {
+          acc = v;
+        }
+      }
+    }
+    y[j] = op == POOLING_OP_AVERAGE ? acc / pool_size : acc;
+  }
+}
+
+static void pooling_row_any(int op, const float *x, int wx, int avail,
+                            int hkernel, int wkernel, int wstride, float *y,
+                            int size) {
+  pooling_row_inside((pooling_op_t)op, x, wx, avail, hkernel, wkernel, wstride,
+                     y, size);
+}
+
+// Copies of pooling_row_inside() for shapes listed in
+// NNABLART_SPECIALIZED_POOLING, which ignore sizes given at run time.
+#define POOLING_ROW(K, S)                                                      \
+  static void pooling_row_##K##_##S(int op, const float *x, int wx,            \
+                                    int avail, int hkernel, int wkernel,       \
+                                    int wstride, float *y, int size) {         \
+    (void)hkernel;                                                             \
+    (void)wkernel;                                                             \
+    (void)wstride;                                                             \
+    pooling_row_inside((pooling_op_t)op, x, wx, avail, K, K, S, y, size);      \
+  }
+NNABLART_SPECIALIZED_POOLING(POOLING_ROW)
+#undef POOLING_ROW
+
+static pooling_row_func_t select_pooling_row(const pooling_context_t *context) {
+  if (context->kernel.size != 2 ||
+      context->kernel.data[0] != context->kernel.data[1]) {
+    return pooling_row_any;
+  }
+#define POOLING_ROW(K, S)                                                      \
+  if (context->kernel.data[0] == (K) && context->stride.data[1] == (S)) {      \
+    return pooling_row_##K##_##S;                                              \
+  }
+  NNABLART_SPECIALIZED_POOLING(POOLING_ROW)
+#undef POOLING_ROW
+  return pooling_row_any;
+}
+
+// Calculate one 2D output whose window starts at (hstart, wstart), which may
+// be outside input.
+static float pooling_window(const pooling_job_t *job, pooling_op_t op,
+                            pooling_calc_context_t *calc, int hstart,
+                            int wstart) {
+  const pooling_context_t *context = job->context;
+  const pooling_private_t *p = job->p;
+  const float *x = (const float *)(calc->x->data) + calc->offset_x;
+  const int hx = p->input_shape.data[p->input_n_kernel_size_diff + 0];
+  const int wx = p->input_shape.data[p->input_n_kernel_size_diff + 1];
+  int hend = hstart + context->kernel.data[0];
+  int wend = wstart + context->kernel.data[1];
+  int ix, jx;
+
+  hend = POOLING_MIN(hend, hx + context->pad.data[0]);
+  wend = POOLING_MIN(wend, wx + context->pad.data[1]);
+  calc->pool_size = (hend - hstart) * (wend - wstart);
+  calc->hstart = POOLING_MAX(hstart, 0);
+  calc->wstart = POOLING_MAX(wstart, 0);
+  calc->hend = POOLING_MIN(hend, hx);
+  calc->wend = POOLING_MIN(wend, wx);
+  if (op == POOLING_OP_OTHER) {
+    calc->hstride = wx;
+    return job->exec(*calc);
+  }
+
+  float acc = op == POOLING_OP_MAX ? x[calc->hstart * wx + calc->wstart] : 0.0f;
+  for (ix = calc->hstart; ix < calc->hend; ix++) {
+    for (jx = calc->wstart; jx < calc->wend; jx++) {
+      const float v = x[ix * wx + jx];
+      if (op != POOLING_OP_MAX) {
+        acc += v;
+      } else if (acc < v) {
+        acc = v;
+      }
+    }
+  }
+  if (op == POOLING_OP_AVERAGE) {
+    if (!calc->including_pad) {
+      calc->pool_size =
+          (calc->hend - calc->hstart) * (calc->wend - calc->wstart);
+    }
+    acc /= calc->pool_size;
+  }
+  return acc;
+}
+
+// Calculate output row iy of a 2D map. Columns whose windows are inside input
+// are calculated by row_inside kernel specialized for the window, and the
+// others on borders by pooling_window().
+static void pooling_row(const pooling_job_t *job, pooling_op_t op,
+                        pooling_calc_context_t *calc, int iy) {
+  const pooling_context_t *context = job->context;
+  const pooling_private_t *p = job->p;
+  const float *x = (const float *)(calc->x->data) + calc->offset_x;
+  float *y = (float *)(calc->y->data) + calc->offset_y +
+             iy * p->output_strides.data[p->input_n_kernel_size_diff + 0];
+  const int hx = p->input_shape.data[p->input_n_kernel_size_diff + 0];
+  const int wx = p->input_shape.data[p->input_n_kernel_size_diff + 1];
+  const int wy = p->output_shape.data[p->input_n_kernel_size_diff + 1];
+  const int hkernel = context->kernel.data[0];
+  const int wkernel = context->kernel.data[1];
+  const int wstride = context->stride.data[1];
+  const int wpad = context->pad.data[1];
+  const int hstart = iy * context->stride.data[0] - context->pad.data[0];
+  int begin = 0;
+  int end = 0;
+  int jy;
+
+  if (op != POOLING_OP_OTHER && hstart >= 0 && hstart + hkernel <= hx) {
+    // Columns [begin, end) have windows in [0, wx).
+    begin = (wpad + wstride - 1) / wstride;
+    end = wx + wpad >= wkernel ? (wx + wpad - wkernel) / wstride + 1 : 0;
+    end = POOLING_MIN(end, wy);
+  }
+  if (begin < end) {
+    const int wstart = begin * wstride - wpad;
+    const float *xs = x + hstart * wx + wstart;
+    p->row_inside(op, xs, wx, wx - wstart, hkernel, wkernel, wstride,
+                  y + begin, end - begin);
+  } else {
+    begin = 0;
+    end = 0;
+  }
+  for (jy = 0; jy < begin; jy++) {
+    y[jy] = pooling_window(job, op, calc, hstart, jy * wstride - wpad);
+  }
+  for (jy = end; jy < wy; jy++) {
+    y[jy] = pooling_window(job, op, calc, hstart, jy * wstride - wpad);
+  }
+}
+
+// Process maps in [begin, end). Each range works on its own calc context.
+static void pooling_range(void *arg, int begin, int end) {
+  pooling_job_t *job = (pooling_job_t *)arg;
+  pooling_context_t *context = job->context;
+  pooling_private_t *p = job->p;
+  exec_pooling_func_t exec = job->exec;
+  pooling_calc_context_t calc = p->calc_context;
+  float *y = (float *)(calc.y->data);
   const int hx = p->input_shape.data[p->input_n_kernel_size_diff + 0];
   const int wx = p->input_shape.data[p->input_n_kernel_size_diff + 1];
   const int hy = p->output_shape.data[p->input_n_kernel_size_diff + 0];
@@ -111,34 +401,18 @@ rt_function_error_t exec_pooling(rt_function_t *f, pooling_context_t *context,
   const int wstride = context->stride.data[1];
   const int hpad = context->pad.data[0];
   const int wpad = context->pad.data[1];
-  const int n_map = calc_shape_size(f->inputs[0]->shape) / p->x_map_size;
-  p->calc_context.offset_x = 0;
-  p->calc_context.offset_y = 0;
-  p->calc_context.kernel_size = context->kernel.size;
+  calc.offset_x = (nn_size_t)begin * p->x_map_size;
+  calc.offset_y = (nn_size_t)begin * p->y_map_size;
+  calc.kernel_size = context->kernel.size;
 
   if (context->kernel.size == 2) {
-    for (int n = 0; n < n_map; n++) {
+    const pooling_op_t op = pooling_op(exec);
+    for (int n = begin; n < end; n++) {
       for (int iy = 0; iy < hy; iy++) {
-        for (int jy = 0; jy < wy; jy++) {
-          int hstart = iy * hstride - hpad;
-          int wstart = jy * wstride - wpad;
-          int hend = (int)fminf((float)(hstart + hkernel), (float)(hx + hpad));
-          int wend = (int)fminf((float)(wstart + wkernel), (float)(wx + wpad));
-          p->calc_context.pool_size = (hend - hstart) * (wend - wstart);
-          p->calc_context.hstart = (int)fmaxf((float)hstart, 0);
-          p->calc_context.wstart = (int)fmaxf((float)wstart, 0);
-          p->calc_context.hend = (int)fminf((float)hend, (float)hx);
-          p->calc_context.wend = (int)fminf((float)wend, (float)wx);
-          p->calc_context.hstride =
-              p->input_strides.data[p->input_n_kernel_size_diff + 0];
-          int k =
-              iy * p->output_strides.data[p->input_n_kernel_size_diff + 0] + jy;
-          float val = exec(p->calc_context);
-          *(y + k + p->calc_context.offset_y) = val;
-        }
+        pooling_row(job, op, &calc, iy);
       }
-      p->calc_context.offset_x += p->x_map_size;
-      p->calc_context.offset_y += p->y_map_size;
+      calc.offset_x += p->x_map_size;
+      calc.offset_y += p->y_map_size;
     }
   } else if (context->kernel.size == 3) {
     const int dx = p->input_shape.data[p->input_n_kernel_size_diff + 2];
@@ -147,44 +421,144 @@ rt_function_error_t exec_pooling(rt_function_t *f, pooling_context_t *context,
     const int dstride = context->stride.data[2];
     const int dpad = context->pad.data[2];
 
-    for (int n = 0; n < n_map; n++) {
+    for (int n = begin; n < end; n++) {
       for (int iy = 0; iy < hy; iy++) {
         for (int jy = 0; jy < wy; jy++) {
           for (int ky = 0; ky < dy; ky++) {
             int hstart = iy * hstride - hpad;
             int wstart = jy * wstride - wpad;
             int dstart = ky * dstride - dpad;
-            int hend =
-                (int)fminf((float)(hstart + hkernel), (float)(hx + hpad));
-            int wend =
-                (int)fminf((float)(wstart + wkernel), (float)(wx + wpad));
-            int dend =
-                (int)fminf((float)(dstart + dkernel), (float)(dx + dpad));
-            p->calc_context.pool_size =
+            int hend = POOLING_MIN(hstart + hkernel, hx + hpad);
+            int wend = POOLING_MIN(wstart + wkernel, wx + wpad);
+            int dend = POOLING_MIN(dstart + dkernel, dx + dpad);
+            calc.pool_size =
                 (hend - hstart) * (wend - wstart) * (dend - dstart);
-            p->calc_context.hstart = (int)fmaxf((float)hstart, 0);
-            p->calc_context.wstart = (int)fmaxf((float)wstart, 0);
-            p->calc_context.dstart = (int)fmaxf((float)dstart, 0);
-            p->calc_context.hend = (int)fminf((float)hend, (float)hx);
-            p->calc_context.wend = (int)fminf((float)wend, (float)wx);
-            p->calc_context.dend = (int)fminf((float)dend, (float)dx);
-            p->calc_context.hstride =
+            calc.hstart = POOLING_MAX(hstart, 0);
+            calc.wstart = POOLING_MAX(wstart, 0);
+            calc.dstart = POOLING_MAX(dstart, 0);
+            calc.hend = POOLING_MIN(hend, hx);
+            calc.wend = POOLING_MIN(wend, wx);
+            calc.dend = POOLING_MIN(dend, dx);
+            calc.hstride =
                 p->input_strides.data[p->input_n_kernel_size_diff + 0];
-            p->calc_context.wstride =
+            calc.wstride =
                 p->input_strides.data[p->input_n_kernel_size_diff + 1];
             int k =
                 iy * p->output_strides.data[p->input_n_kernel_size_diff + 0] +
                 jy * p->output_strides.data[p->input_n_kernel_size_diff + 1] +
                 ky;
-            float val = exec(p->calc_context);
-            *(y + k + p->calc_context.offset_y) = val;
+            float val = exec(calc);
+            *(y + k + calc.offset_y) = val;
           }
         }
       }
-      p->calc_context.offset_x += p->x_map_size;
-      p->calc_context.offset_y += p->y_map_size;
+      calc.offset_x += p->x_map_size;
+      calc.offset_y += p->y_map_size;
     }
   }
+}
+
+// Process rows of output [begin, end) with channel last layout. Index is
+// n * height + y, innermost loops run over contiguous channels.
+static void pooling_channel_last_range(void *arg, int begin, int end) {
+  pooling_job_t *job = (pooling_job_t *)arg;
+  pooling_context_t *context = job->context;
+  pooling_private_t *p = job->p;
+  const float *x = (const float *)(p->calc_context.x->data);
+  float *y = (float *)(p->calc_context.y->data);
+  const int hx = p->input_shape.data[p->input_n_kernel_size_diff + 0];
+  const int wx = p->input_shape.data[p->input_n_kernel_size_diff + 1];
+  const int hy = p->output_shape.data[p->input_n_kernel_size_diff + 0];
+  const int wy = p->output_shape.data[p->input_n_kernel_size_diff + 1];
+  const int channels = p->input_shape.data[p->input_shape.size - 1];
+  const int hkernel = context->kernel.data[0];
+  const int wkernel = context->kernel.data[1];
+  const int hstride = context->stride.data[0];
+  const int wstride = context->stride.data[1];
+  const int hpad = context->pad.data[0];
+  const int wpad = context->pad.data[1];
+  int r, jy, ix, jx, c;
+
+  for (r = begin; r < end; r++) {
+    int n = r / hy;
+    int iy = r % hy;
+    const float *xn = x + (nn_size_t)n * hx * wx * channels;
+    float *yr = y + ((nn_size_t)n * hy + iy) * wy * channels;
+    for (jy = 0; jy < wy; jy++, yr += channels) {
+      int hstart = iy * hstride - hpad;
+      int wstart = jy * wstride - wpad;
+      int hend = hstart + hkernel < hx + hpad ? hstart + hkernel : hx + hpad;
+      int wend = wstart + wkernel < wx + wpad ? wstart + wkernel : wx + wpad;
+      int pool_size = (hend - hstart) * (wend - wstart);
+      hstart = hstart > 0 ? hstart : 0;
+      wstart = wstart > 0 ? wstart : 0;
+      hend = hend < hx ? hend : hx;
+      wend = wend < wx ? wend : wx;
+
+      if (job->exec == calc_max) {
+        memcpy(yr, xn + ((nn_size_t)hstart * wx + wstart) * channels,
+               sizeof(float) * channels);
+      } else {
+        memset(yr, 0, sizeof(float) * channels);
+      }
+      for (ix = hstart; ix < hend; ix++) {
+        for (jx = wstart; jx < wend; jx++) {
+          const float *xp = xn + ((nn_size_t)ix * wx + jx) * channels;
+#ifdef NNABLART_NEON
+          if (job->exec == calc_max) {
+            neon_max(xp, yr, yr, channels);
+          } else {
+            neon_add(xp, yr, yr, channels);
+          }
+#else
+          if (job->exec == calc_max) {
+            for (c = 0; c < channels; c++) {
+              yr[c] = xp[c] > yr[c] ? xp[c] : yr[c];
+            }
+          } else {
+            for (c = 0; c < channels; c++) {
+              yr[c] += xp[c];
+            }
+          }
+#endif /* NNABLART_NEON */
+        }
+      }
+      if (job->exec == calc_average) {
+        if (!p->calc_context.including_pad) {
+          pool_size = (hend - hstart) * (wend - wstart);
+        }
+        for (c = 0; c < channels; c++) {
+          yr[c] /= pool_size;
+        }
+      }
+    }
+  }
+}
+
+rt_function_error_t exec_pooling(rt_function_t *f, pooling_context_t *context,
+                                 pooling_private_t *p,
+                                 exec_pooling_func_t exec) {
+  if (context->channel_last) {
+    const int n_rows =
+        calc_shape_size(p->output_shape) /
+        (p->output_shape.data[p->input_n_kernel_size_diff + 1] *
+         p->output_shape.data[p->input_shape.size - 1]);
+    pooling_job_t job = {context, p, exec};
+    rt_parallel_for(n_rows,
+                    calc_shape_size(p->output_shape) / n_rows *
+                        calc_shape_size(context->kernel),
+                    pooling_channel_last_range, &job);
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+
+  const int n_map = calc_shape_size(f->inputs[0]->shape) / p->x_map_size;
+  int kernel_size = 1;
+  for (int i = 0; i < context->kernel.size; i++) {
+    kernel_size *= context->kernel.data[i];
+  }
+  pooling_job_t job = {context, p, exec};
+
+  rt_parallel_for(n_map, p->y_map_size * kernel_size, pooling_range, &job);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
@@ -192,6 +566,9 @@ rt_function_error_t exec_pooling_generic(rt_function_t *f,
                                          pooling_context_t *context,
                                          pooling_private_t *p,
                                          exec_pooling_func_t exec) {
+  if (context->channel_last) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
   const int hx = p->input_shape.data[p->input_n_kernel_size_diff + 0];
   const int wx = p->input_shape.data[p->input_n_kernel_size_diff + 1];
   const int hy = p->output_shape.data[p->input_n_kernel_size_diff + 0];
@@ -213,13 +590,13 @@ rt_function_error_t exec_pooling_generic(rt_function_t *f,
         for (int jy = 0; jy < wy; jy++) {
           int hstart = iy * hstride - hpad;
           int wstart = jy * wstride - wpad;
-          int hend = (int)fminf((float)(hstart + hkernel), (float)(hx + hpad));
-          int wend = (int)fminf((float)(wstart + wkernel), (float)(wx + wpad));
+          int hend = POOLING_MIN(hstart + hkernel, hx + hpad);
+          int wend = POOLING_MIN(wstart + wkernel, wx + wpad);
           p->calc_context.pool_size = (hend - hstart) * (wend - wstart);
-          p->calc_context.hstart = (int)fmaxf((float)hstart, 0);
-          p->calc_context.wstart = (int)fmaxf((float)wstart, 0);
-          p->calc_context.hend = (int)fminf((float)hend, (float)hx);
-          p->calc_context.wend = (int)fminf((float)wend, (float)wx);
+          p->calc_context.hstart = POOLING_MAX(hstart, 0);
+          p->calc_context.wstart = POOLING_MAX(wstart, 0);
+          p->calc_context.hend = POOLING_MIN(hend, hx);
+          p->calc_context.wend = POOLING_MIN(wend, wx);
           p->calc_context.hstride =
               p->input_strides.data[p->input_n_kernel_size_diff + 0];
           int k =
@@ -246,20 +623,17 @@ rt_function_error_t exec_pooling_generic(rt_function_t *f,
             int hstart = iy * hstride - hpad;
             int wstart = jy * wstride - wpad;
             int dstart = ky * dstride - dpad;
-            int hend =
-                (int)fminf((float)(hstart + hkernel), (float)(hx + hpad));
-            int wend =
-                (int)fminf((float)(wstart + wkernel), (float)(wx + wpad));
-            int dend =
-                (int)fminf((float)(dstart + dkernel), (float)(dx + dpad));
+            int hend = POOLING_MIN(hstart + hkernel, hx + hpad);
+            int wend = POOLING_MIN(wstart + wkernel, wx + wpad);
+            int dend = POOLING_MIN(dstart + dkernel, dx + dpad);
             p->calc_context.pool_size =
                 (hend - hstart) * (wend - wstart) * (dend - dstart);
-            p->calc_context.hstart = (int)fmaxf((float)hstart, 0);
-            p->calc_context.wstart = (int)fmaxf((float)wstart, 0);
-            p->calc_context.dstart = (int)fmaxf((float)dstart, 0);
-            p->calc_context.hend = (int)fminf((float)hend, (float)hx);
-            p->calc_context.wend = (int)fminf((float)wend, (float)wx);
-            p->calc_context.dend = (int)fminf((float)dend, (float)dx);
+            p->calc_context.hstart = POOLING_MAX(hstart, 0);
+            p->calc_context.wstart = POOLING_MAX(wstart, 0);
+            p->calc_context.dstart = POOLING_MAX(dstart, 0);
+            p->calc_context.hend = POOLING_MIN(hend, hx);
+            p->calc_context.wend = POOLING_MIN(wend, wx);
+            p->calc_context.dend = POOLING_MIN(dend, dx);
             p->calc_context.hstride =
                 p->input_strides.data[p->input_n_kernel_size_diff + 0];
             p->calc_context.wstride =
@@ -450,3 +824,45 @@ float calc_average_generic(pooling_calc_context_t calc) {
   average_val = val / calc.pool_size;
   return average_val;
 }
+
+// Sum or max of integers in window of fixed point input. Max starts from 0
+// same as calc_max_generic().
+static int64_t calc_window_fixed(const pooling_calc_context_t *calc,
+                                 int is_max) {
+  int64_t acc = 0;
+  for (int ix = calc->hstart; ix < calc->hend; ix++) {
+    for (int jx = calc->wstart; jx < calc->wend; jx++) {
+      nn_size_t pos = ix * calc->hstride + calc->offset_x;
+      if (calc->kernel_size == 2) {
+        int32_t val = get_fixed(calc->x, pos + jx);
+        acc = is_max ? (val > acc ? val : acc) : acc + val;
+        continue;
+      }
+      pos += jx * calc->wstride;
+      for (int kx = calc->dstart; kx < calc->dend; kx++) {
+        int32_t val = get_fixed(calc->x, pos + kx);
+        acc = is_max ? (val > acc ? val : acc) : acc + val;
+      }
+    }
+  }
+  return acc;
+}
+
+float calc_max_fixed(pooling_calc_context_t calc) {
+  return (float)calc_window_fixed(&calc, 1) * calc.x->coefficient;
+}
+
+float calc_sum_fixed(pooling_calc_context_t calc) {
+  return (float)calc_window_fixed(&calc, 0) * calc.x->coefficient;
+}
+
+float calc_average_fixed(pooling_calc_context_t calc) {
+  if (!calc.including_pad) {
+    calc.pool_size = (calc.hend - calc.hstart) * (calc.wend - calc.wstart);
+    if (calc.kernel_size == 3) {
+      calc.pool_size *= calc.dend - calc.dstart;
+    }
+  }
+  return (float)calc_window_fixed(&calc, 0) * calc.x->coefficient /
+         calc.pool_size;
+}
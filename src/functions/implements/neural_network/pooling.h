@@ -16,15 +16,16 @@
 #define H_POOLING_H_
 
 #include "../../utilities/accessor.h"
+#include "../../utilities/fixed.h"
 #include <nnablart/functions.h>
 
+/// Common head of local contexts of pooling functions.
 typedef struct {
   rt_list_t kernel; ///< Original type is [Shape]
   rt_list_t stride; ///< Original type is [Shape]
   uint8_t ignore_border;
   rt_list_t pad; ///< Original type is [Shape]
-  uint8_t including_pad;
-  void *data;
+  uint8_t channel_last;
 } pooling_context_t;
 
 typedef struct {
@@ -47,6 +48,12 @@ typedef struct {
   uint8_t including_pad;
 } pooling_calc_context_t;
 
+/// Calculate size outputs y of a 2D row whose windows are all inside input,
+/// op is one of pooling_op_t in pooling.c.
+typedef void (*pooling_row_func_t)(int op, const float *x, int wx, int avail,
+                                   int hkernel, int wkernel, int wstride,
+                                   float *y, int size);
+
 typedef struct {
   rt_list_t input_shape;
   rt_list_t output_shape;
@@ -56,13 +63,16 @@ typedef struct {
   rt_list_t input_strides;
   rt_list_t output_strides;
   pooling_calc_context_t calc_context;
+  pooling_row_func_t row_inside; ///< Kernel specialized for window of 2D
+                                 ///< float pooling.
 } pooling_private_t;
 
 typedef float (*exec_pooling_func_t)(pooling_calc_context_t);
 
 rt_function_error_t allocate_pooling(rt_function_t *f,
                                      pooling_context_t *context,
-                                     pooling_private_t *p);
+                                     pooling_private_t *p,
+                                     uint8_t including_pad);
 rt_function_error_t free_pooling(pooling_private_t *p);
 rt_function_error_t exec_pooling(rt_function_t *f, pooling_context_t *context,
                                  pooling_private_t *p,
@@ -90,4 +100,14 @@ float calc_sum_generic(pooling_calc_context_t calc);
 /// Calculate average value.
 float calc_average_generic(pooling_calc_context_t calc);
 
+/// Calculate max value of INT8 or INT16 input scaled by fp_pos only, reading
+/// integers of window and converting only the result.
+float calc_max_fixed(pooling_calc_context_t calc);
+
+/// Calculate sum value of fixed point input.
+float calc_sum_fixed(pooling_calc_context_t calc);
+
+/// Calculate average value of fixed point input.
+float calc_average_fixed(pooling_calc_context_t calc);
+
 #endif // H_POOLING_H_
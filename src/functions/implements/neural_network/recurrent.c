@@ -0,0 +1,499 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#include <string.h>
+
+#include "../../utilities/sgemm.h"
+#include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
+
+/*
+ * RNN, LSTM and GRU share one implementation. Weights of all gates of a
+ * layer and direction are rows of one (gates * hidden) x (input + hidden)
+ * matrix, so that
+ * - projections of inputs of all steps are calculated by one product before
+ *   the first step, and
+ * - each step needs one product of hidden state and the hidden part of the
+ *   matrix, followed by element wise update of gates.
+ *
+ * Gates are i, f, g, o for LSTM and r, z, n for GRU. Bias of GRU has 4 rows,
+ * the last one is added to hidden projection of n before it is multiplied
+ * with r.
+ */
+
+#if defined(CONFIG_RNN) || defined(CONFIG_LSTM) || defined(CONFIG_GRU)
+
+typedef void (*recurrent_activation_t)(const float *x, float *y, int size);
+
+typedef enum {
+  RECURRENT_RNN_TANH = 0,
+  RECURRENT_RNN_RELU,
+  RECURRENT_LSTM,
+  RECURRENT_GRU,
+} recurrent_cell_t;
+
+typedef struct {
+  recurrent_cell_t cell;
+  int gates; ///< Rows of hidden size in weight of each layer and direction.
+  int num_layers;
+  int directions;
+  int seq_len;
+  int batch;
+  int input_size;
+  int hidden;
+
+  rt_variable_t *x;
+  rt_variable_t *h;
+  rt_variable_t *c; ///< Initial cell state of LSTM, otherwise NULL.
+  const float *weight_l0;
+  const float *weight; ///< Weight of layers after first one, or NULL.
+  const float *bias;   ///< NULL if function has no bias.
+  rt_variable_t *y;
+  rt_variable_t *h_n;
+  rt_variable_t *c_n; ///< Last cell state of LSTM, otherwise NULL.
+
+  recurrent_activation_t sigmoid;
+  recurrent_activation_t tanh;
+
+  float *projection; ///< Input projections of all steps of a direction.
+  float *step;       ///< Hidden projection of one step.
+  float *sequence;   ///< Outputs of a layer read by next one, or NULL.
+  float *state;      ///< Hidden state of each layer and direction, followed
+                     ///< by cell state of LSTM.
+  int state_size;    ///< Elements of hidden state of all layers.
+
+  int streaming;  ///< Keep state between executions.
+  int keep_state; ///< state is result of former execution.
+} recurrent_private_t;
+
+typedef struct {
+  int m;
+  int n;
+  int k;
+  const float *a;
+  int lda;
+  const float *w; ///< Row j of w is column j of B.
+  int ldw;
+  const float *bias; ///< Added to each row of C, or NULL.
+  float *c;          ///< m x n
+} recurrent_gemm_t;
+
+// Columns of panels [begin, end) of C, each panel has SGEMM_NR columns.
+static void recurrent_gemm_range(void *arg, int begin, int end) {
+  recurrent_gemm_t *g = (recurrent_gemm_t *)arg;
+  int j0 = begin * SGEMM_NR;
+  int j1 = end * SGEMM_NR < g->n ? end * SGEMM_NR : g->n;
+  int j; // Iterator
+
+  if (g->m == 1) {
+    // Streaming step of single sample reads each row of weight once.
+    sgemv(j1 - j0, g->k, g->w + j0 * g->ldw, g->ldw, g->a, g->c + j0);
+    if (g->bias) {
+      for (j = j0; j < j1; j++) {
+        g->c[j] += g->bias[j];
+      }
+    }
+  } else {
+    sgemm_scaled(g->m, j1 - j0, g->k, g->a, g->lda, 1, g->w + j0 * g->ldw, 1,
+                 g->ldw, 0, g->bias ? g->bias + j0 : 0, g->c + j0, g->n);
+  }
+}
+
+static void recurrent_gemm(recurrent_gemm_t *g) {
+  rt_parallel_for((g->n + SGEMM_NR - 1) / SGEMM_NR, SGEMM_NR * g->m * g->k,
+                  recurrent_gemm_range, g);
+}
+
+static void relu(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : 0.0f;
+  }
+}
+
+// Update state of one sample from gates q, which holds hidden projection and
+// gets input projection x added.
+static void update_cell(recurrent_private_t *p, const float *x, float *q,
+                        float *h, float *c, const float *hidden_bias) {
+  int size = p->hidden;
+  int j; // Iterator
+
+  switch (p->cell) {
+  case RECURRENT_RNN_TANH:
+  case RECURRENT_RNN_RELU:
+    for (j = 0; j < size; j++) {
+      q[j] += x[j];
+    }
+    if (p->cell == RECURRENT_RNN_TANH) {
+      p->tanh(q, h, size);
+    } else {
+      relu(q, h, size);
+    }
+    break;
+  case RECURRENT_LSTM:
+    for (j = 0; j < 4 * size; j++) {
+      q[j] += x[j];
+    }
+    p->sigmoid(q, q, 2 * size);
+    p->tanh(q + 2 * size, q + 2 * size, size);
+    p->sigmoid(q + 3 * size, q + 3 * size, size);
+    for (j = 0; j < size; j++) {
+      c[j] = q[size + j] * c[j] + q[j] * q[2 * size + j];
+    }
+    // g is no longer used, its area takes tanh(c).
+    p->tanh(c, q + 2 * size, size);
+    for (j = 0; j < size; j++) {
+      h[j] = q[3 * size + j] * q[2 * size + j];
+    }
+    break;
+  case RECURRENT_GRU:
+    for (j = 0; j < 2 * size; j++) {
+      q[j] += x[j];
+    }
+    p->sigmoid(q, q, 2 * size);
+    for (j = 0; j < size; j++) {
+      float n = q[2 * size + j] + (hidden_bias ? hidden_bias[j] : 0.0f);
+      q[2 * size + j] = x[2 * size + j] + q[j] * n;
+    }
+    p->tanh(q + 2 * size, q + 2 * size, size);
+    for (j = 0; j < size; j++) {
+      float n = q[2 * size + j];
+      h[j] = n + q[size + j] * (h[j] - n);
+    }
+    break;
+  }
+}
+
+// Run direction d of layer l over input sequence whose rows have in_size
+// elements. Hidden state of each step is written to columns of direction in
+// rows of out.
+static void run_direction(recurrent_private_t *p, int l, int d,
+                          const float *in, int in_size, float *out) {
+  int size = p->hidden;
+  int batch = p->batch;
+  int gates = p->gates * size;
+  int ldw = in_size + size;
+  int bias_rows = p->cell == RECURRENT_GRU ? 4 : p->gates;
+  const float *w =
+      l == 0 ? p->weight_l0 + d * gates * ldw
+             : p->weight + ((l - 1) * p->directions + d) * gates * ldw;
+  const float *bias =
+      p->bias ? p->bias + (l * p->directions + d) * bias_rows * size : 0;
+  const float *hidden_bias =
+      bias && p->cell == RECURRENT_GRU ? bias + 3 * size : 0;
+  float *h = p->state + (l * p->directions + d) * batch * size;
+  float *c = p->cell == RECURRENT_LSTM ? h + p->state_size : 0;
+  recurrent_gemm_t g;
+  int s, b; // Iterator
+
+  g.m = p->seq_len * batch;
+  g.n = gates;
+  g.k = in_size;
+  g.a = in;
+  g.lda = in_size;
+  g.w = w;
+  g.ldw = ldw;
+  g.bias = bias;
+  g.c = p->projection;
+  recurrent_gemm(&g);
+
+  g.m = batch;
+  g.k = size;
+  g.a = h;
+  g.lda = size;
+  g.w = w + in_size;
+  g.bias = 0;
+  g.c = p->step;
+  for (s = 0; s < p->seq_len; s++) {
+    int t = d == 0 ? s : p->seq_len - 1 - s;
+    recurrent_gemm(&g);
+    for (b = 0; b < batch; b++) {
+      float *hb = h + b * size;
+      update_cell(p, p->projection + (t * batch + b) * gates,
+                  p->step + b * gates, hb, c ? c + b * size : 0, hidden_bias);
+      memcpy(out + ((t * batch + b) * p->directions + d) * size, hb,
+             sizeof(float) * size);
+    }
+  }
+}
+
+static rt_function_error_t exec_recurrent(recurrent_private_t *p) {
+  int l, d; // Iterator
+
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  if (!p->streaming || !p->keep_state) {
+    memcpy(p->state, p->h->data, sizeof(float) * p->state_size);
+    if (p->c) {
+      memcpy(p->state + p->state_size, p->c->data,
+             sizeof(float) * p->state_size);
+    }
+  }
+  for (l = 0; l < p->num_layers; l++) {
+    // Layers write y and sequence by turns so that the last one writes y.
+    float *out = (p->num_layers - 1 - l) % 2 == 0 ? (float *)(p->y->data)
+                                                   : p->sequence;
+    const float *in = l == 0 ? (const float *)(p->x->data)
+                             : (out == p->sequence ? (float *)(p->y->data)
+                                                   : p->sequence);
+    int in_size = l == 0 ? p->input_size : p->directions * p->hidden;
+    for (d = 0; d < p->directions; d++) {
+      run_direction(p, l, d, in, in_size, out);
+    }
+  }
+  memcpy(p->h_n->data, p->state, sizeof(float) * p->state_size);
+  if (p->c_n) {
+    memcpy(p->c_n->data, p->state + p->state_size,
+           sizeof(float) * p->state_size);
+  }
+  p->keep_state = 1;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static int is_float_dense(const rt_variable_t *v) {
+  return v && v->type == NN_DATA_TYPE_FLOAT &&
+         v->layout == NN_DATA_LAYOUT_DENSE && !v->quantization;
+}
+
+static void free_recurrent(recurrent_private_t *p) {
+  if (p == 0) {
+    return;
+  }
+  rt_free_func(p->projection);
+  rt_free_func(p->step);
+  if (p->sequence) {
+    rt_free_func(p->sequence);
+  }
+  rt_free_func(p->state);
+  rt_free_func(p);
+}
+
+// Inputs are x, h, c of LSTM, weight_l0, weight if num_layers > 1 and
+// optional bias. Outputs are y, h_n and c_n of LSTM.
+static rt_function_error_t allocate_recurrent(rt_function_t *f,
+                                              recurrent_cell_t cell,
+                                              int num_layers,
+                                              int bidirectional,
+                                              recurrent_private_t **private) {
+  int lstm = cell == RECURRENT_LSTM;
+  int weight_index = lstm ? 4 : 3;
+  int num_of_weights = weight_index + (num_layers > 1 ? 1 : 0);
+  int i; // Iterator
+
+  *private = 0;
+  if (f->num_of_inputs != num_of_weights &&
+      f->num_of_inputs != num_of_weights + 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != (lstm ? 3 : 2)) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  for (i = 0; i < f->num_of_inputs; i++) {
+    if (!is_float_dense(f->inputs[i])) {
+      return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+    }
+  }
+  for (i = 0; i < f->num_of_outputs; i++) {
+    if (!is_float_dense(f->outputs[i])) {
+      return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+    }
+  }
+
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *h = f->inputs[1];
+  if (num_layers < 1 || x->shape.size != 3 || h->shape.size != 4) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  int directions = bidirectional ? 2 : 1;
+  int gates = cell == RECURRENT_LSTM ? 4 : cell == RECURRENT_GRU ? 3 : 1;
+  int bias_rows = cell == RECURRENT_GRU ? 4 : gates;
+  int seq_len = x->shape.data[0];
+  int batch = x->shape.data[1];
+  int input_size = x->shape.data[2];
+  int hidden = h->shape.data[3];
+  int state_size = num_layers * directions * batch * hidden;
+  int hidden_input = directions * hidden + hidden;
+
+  if (h->shape.data[0] != num_layers || h->shape.data[1] != directions ||
+      h->shape.data[2] != batch ||
+      (lstm && calc_shape_size(f->inputs[2]->shape) != state_size) ||
+      calc_shape_size(f->inputs[weight_index - 1]->shape) !=
+          directions * gates * hidden * (input_size + hidden) ||
+      (num_layers > 1 &&
+       calc_shape_size(f->inputs[weight_index]->shape) !=
+           (num_layers - 1) * directions * gates * hidden * hidden_input) ||
+      (f->num_of_inputs > num_of_weights &&
+       calc_shape_size(f->inputs[num_of_weights]->shape) !=
+           num_layers * directions * bias_rows * hidden) ||
+      calc_shape_size(f->outputs[0]->shape) !=
+          seq_len * batch * directions * hidden ||
+      calc_shape_size(f->outputs[1]->shape) != state_size ||
+      (lstm && calc_shape_size(f->outputs[2]->shape) != state_size)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
+  recurrent_private_t *p = rt_malloc_func(sizeof(recurrent_private_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->cell = cell;
+  p->gates = gates;
+  p->num_layers = num_layers;
+  p->directions = directions;
+  p->seq_len = seq_len;
+  p->batch = batch;
+  p->input_size = input_size;
+  p->hidden = hidden;
+  p->x = x;
+  p->h = h;
+  p->c = lstm ? f->inputs[2] : 0;
+  p->weight_l0 = (const float *)(f->inputs[weight_index - 1]->data);
+  p->weight =
+      num_layers > 1 ? (const float *)(f->inputs[weight_index]->data) : 0;
+  p->bias = f->num_of_inputs > num_of_weights
+                ? (const float *)(f->inputs[num_of_weights]->data)
+                : 0;
+  p->y = f->outputs[0];
+  p->h_n = f->outputs[1];
+  p->c_n = lstm ? f->outputs[2] : 0;
+  p->sigmoid = is_fast_math() ? vector_sigmoid_fast : vector_sigmoid;
+  p->tanh = is_fast_math() ? vector_tanh_fast : vector_tanh;
+  p->state_size = state_size;
+  p->streaming = 0;
+  p->keep_state = 0;
+
+  p->projection =
+      rt_malloc_func(sizeof(float) * seq_len * batch * gates * hidden);
+  p->step = rt_malloc_func(sizeof(float) * batch * gates * hidden);
+  p->sequence =
+      num_layers > 1
+          ? rt_malloc_func(sizeof(float) * seq_len * batch * directions *
+                           hidden)
+          : 0;
+  p->state = rt_malloc_func(sizeof(float) * state_size * (lstm ? 2 : 1));
+  if (p->projection == 0 || p->step == 0 || p->state == 0 ||
+      (num_layers > 1 && p->sequence == 0)) {
+    free_recurrent(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  *private = p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static recurrent_private_t *recurrent_private(rt_function_t *f) {
+#ifdef CONFIG_RNN
+  if (f->exec_func == exec_rnn) {
+    return ((rnn_local_context_t *)(f->local_context))->data;
+  }
+#endif /* CONFIG_RNN */
+#ifdef CONFIG_LSTM
+  if (f->exec_func == exec_lstm) {
+    return ((lstm_local_context_t *)(f->local_context))->data;
+  }
+#endif /* CONFIG_LSTM */
+#ifdef CONFIG_GRU
+  if (f->exec_func == exec_gru) {
+    return ((gru_local_context_t *)(f->local_context))->data;
+  }
+#endif /* CONFIG_GRU */
+  return 0;
+}
+
+rt_function_error_t set_recurrent_streaming(rt_function_t *f, int enable) {
+  recurrent_private_t *p = recurrent_private(f);
+  if (p == 0 || (enable && p->directions > 1)) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  p->streaming = enable;
+  p->keep_state = 0;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t reset_recurrent_state(rt_function_t *f) {
+  recurrent_private_t *p = recurrent_private(f);
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+  p->keep_state = 0;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#endif
+
+// RNN
+#ifdef CONFIG_RNN
+rt_function_error_t allocate_rnn_local_context(rt_function_t *f) {
+  rnn_local_context_t *ctx = (rnn_local_context_t *)(f->local_context);
+  f->exec_func = exec_rnn;
+  return allocate_recurrent(f,
+                            ctx->nonlinearity == RNN_NONLINEARITY_RELU
+                                ? RECURRENT_RNN_RELU
+                                : RECURRENT_RNN_TANH,
+                            ctx->num_layers, ctx->bidirectional,
+                            (recurrent_private_t **)&ctx->data);
+}
+
+rt_function_error_t free_rnn_local_context(rt_function_t *f) {
+  free_recurrent(((rnn_local_context_t *)(f->local_context))->data);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t exec_rnn(rt_function_t *f) {
+  return exec_recurrent(((rnn_local_context_t *)(f->local_context))->data);
+}
+#endif /* CONFIG_RNN */
+
+// LSTM
+#ifdef CONFIG_LSTM
+rt_function_error_t allocate_lstm_local_context(rt_function_t *f) {
+  lstm_local_context_t *ctx = (lstm_local_context_t *)(f->local_context);
+  f->exec_func = exec_lstm;
+  return allocate_recurrent(f, RECURRENT_LSTM, ctx->num_layers,
+                            ctx->bidirectional,
+                            (recurrent_private_t **)&ctx->data);
+}
+
+rt_function_error_t free_lstm_local_context(rt_function_t *f) {
+  free_recurrent(((lstm_local_context_t *)(f->local_context))->data);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t exec_lstm(rt_function_t *f) {
+  return exec_recurrent(((lstm_local_context_t *)(f->local_context))->data);
+}
+#endif /* CONFIG_LSTM */
+
+// GRU
+#ifdef CONFIG_GRU
+rt_function_error_t allocate_gru_local_context(rt_function_t *f) {
+  gru_local_context_t *ctx = (gru_local_context_t *)(f->local_context);
+  f->exec_func = exec_gru;
+  return allocate_recurrent(f, RECURRENT_GRU, ctx->num_layers,
+                            ctx->bidirectional,
+                            (recurrent_private_t **)&ctx->data);
+}
+
+rt_function_error_t free_gru_local_context(rt_function_t *f) {
+  free_recurrent(((gru_local_context_t *)(f->local_context))->data);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t exec_gru(rt_function_t *f) {
+  return exec_recurrent(((gru_local_context_t *)(f->local_context))->data);
+}
+#endif /* CONFIG_GRU */
@@ -25,7 +25,7 @@ rt_function_error_t allocate_sum_pooling_local_context(rt_function_t *f) {
       (sum_pooling_local_context_t *)(f->local_context);
   pooling_private_t *p = rt_malloc_func(sizeof(pooling_private_t));
   rt_function_error_t ret =
-      allocate_pooling(f, (pooling_context_t *)context, p);
+      allocate_pooling(f, (pooling_context_t *)context, p, 0);
   ((sum_pooling_local_context_t *)(f->local_context))->data = (void *)p;
   f->exec_func = exec_sum_pooling;
   return ret;
@@ -52,7 +52,9 @@ rt_function_error_t exec_sum_pooling(rt_function_t *f) {
   } else {
 #ifdef CONFIG_SUMPOOLING_GENERIC
     return exec_pooling_generic(f, (pooling_context_t *)context, p,
-                                calc_sum_generic);
+                                is_fixed_point(p->calc_context.x)
+                                    ? calc_sum_fixed
+                                    : calc_sum_generic);
 #endif /* CONFIG_SUMPOOLING_GENERIC */
   }
   return RT_FUNCTION_ERROR_NOERROR;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "../../utilities/list.h"
+#include "../../utilities/neon.h"
 #include "../../utilities/shape.h"
 #include "pooling.h"
 
@@ -33,6 +34,11 @@ typedef struct {
   rt_variable_getter get_input;
   rt_variable_t *output;
   rt_variable_setter set_output;
+  int rows;     // Input rows of the last axis, when only the last two axes
+                // are unpooled. Otherwise 0.
+  int width;    // Size of the last axis of input.
+  int kernel_h; // Kernel of the axis before the last, or 1.
+  int kernel_w; // Kernel of the last axis.
 } unpooling_private_t;
 
 rt_function_error_t allocate_unpooling_local_context(rt_function_t *f) {
@@ -46,6 +52,10 @@ rt_function_error_t allocate_unpooling_local_context(rt_function_t *f) {
   p->output_shape = clone_list(f->outputs[0]->shape);
   p->input_strides = calc_contiguous_strides(f->inputs[0]->shape);
   p->output_strides = calc_contiguous_strides(f->outputs[0]->shape);
+  if (p->input_shape.data == 0 || p->output_shape.data == 0 ||
+      p->input_strides.data == 0 || p->output_strides.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->input = f->inputs[0];
   p->get_input = select_getter(p->input);
   p->output = f->outputs[0];
@@ -64,6 +74,9 @@ rt_function_error_t allocate_unpooling_local_context(rt_function_t *f) {
   rt_list_t shape = allocate_list(p->input_shape.size);
   int diff = p->input_shape.size - context->kernel.size;
   int i;
+  if (shape.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   for (i = 0; i < diff; i++) {
     shape.data[i] = 1;
   }
@@ -71,11 +84,34 @@ rt_function_error_t allocate_unpooling_local_context(rt_function_t *f) {
     shape.data[i] = context->kernel.data[i - diff];
   }
   p->kernel = clone_list(shape);
+  if (p->kernel.data == 0) {
+    free_list(shape);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   for (i = 0; i < p->input_shape.size; i++) {
     p->output_shape.data[i] = p->input_shape.data[i] * p->kernel.data[i];
   }
   free_list(shape);
 
+  p->rows = 0;
+  p->width = p->input_shape.size > 0
+                 ? p->input_shape.data[p->input_shape.size - 1]
+                 : 0;
+  p->kernel_h = p->input_shape.size > 1
+                    ? p->kernel.data[p->input_shape.size - 2]
+                    : 1;
+  p->kernel_w = p->input_shape.size > 0
+                    ? p->kernel.data[p->input_shape.size - 1]
+                    : 1;
+  if (p->width > 0) {
+    p->rows = calc_shape_size(p->input_shape) / p->width;
+    for (i = 0; i + 2 < p->input_shape.size; i++) {
+      if (p->kernel.data[i] != 1) {
+        p->rows = 0;
+      }
+    }
+  }
+
   ((unpooling_local_context_t *)(f->local_context))->data = (void *)p;
 
   f->exec_func = exec_unpooling;
@@ -186,6 +222,83 @@ static void unpooling_forward_recursive(unpooling_private_t *p, int x_offset,
 }
 #endif /* CONFIG_UNPOOLING_FLOAT32 */
 
+#ifdef CONFIG_UNPOOLING_FLOAT32
+#if defined(NNABLART_NEON)
+#define UNPOOLING_SIMD
+// Each of 4 values of x is repeated 2 or 4 times.
+static inline void unpooling_widen2(const float *x, float *y) {
+  const float32x4x2_t v = vzipq_f32(vld1q_f32(x), vld1q_f32(x));
+  vst1q_f32(y, v.val[0]);
+  vst1q_f32(y + 4, v.val[1]);
+}
+static inline void unpooling_widen4(const float *x, float *y) {
+  const float32x4_t v = vld1q_f32(x);
+  vst1q_f32(y, vdupq_lane_f32(vget_low_f32(v), 0));
+  vst1q_f32(y + 4, vdupq_lane_f32(vget_low_f32(v), 1));
+  vst1q_f32(y + 8, vdupq_lane_f32(vget_high_f32(v), 0));
+  vst1q_f32(y + 12, vdupq_lane_f32(vget_high_f32(v), 1));
+}
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UNPOOLING_SIMD
+#include <emmintrin.h>
+// Each of 4 values of x is repeated 2 or 4 times.
+static inline void unpooling_widen2(const float *x, float *y) {
+  const __m128 v = _mm_loadu_ps(x);
+  _mm_storeu_ps(y, _mm_unpacklo_ps(v, v));
+  _mm_storeu_ps(y + 4, _mm_unpackhi_ps(v, v));
+}
+static inline void unpooling_widen4(const float *x, float *y) {
+  const __m128 v = _mm_loadu_ps(x);
+  _mm_storeu_ps(y, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+  _mm_storeu_ps(y + 4, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+  _mm_storeu_ps(y + 8, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)));
+  _mm_storeu_ps(y + 12, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+#endif
+
+// y[i * kernel + k] = x[i] for each k < kernel.
+static void unpooling_widen_row(const float *x, float *y, int size,
+                                int kernel) {
+  int i = 0, k;
+#ifdef UNPOOLING_SIMD
+  if (kernel == 2) {
+    for (; i + 4 <= size; i += 4) {
+      unpooling_widen2(x + i, y + i * 2);
+    }
+  } else if (kernel == 4) {
+    for (; i + 4 <= size; i += 4) {
+      unpooling_widen4(x + i, y + i * 4);
+    }
+  }
+#endif /* UNPOOLING_SIMD */
+  for (; i < size; i++) {
+    for (k = 0; k < kernel; k++) {
+      y[i * kernel + k] = x[i];
+    }
+  }
+}
+
+// Input row r becomes output rows from r * kernel_h. The first one is widened
+// from input, and the others are copies of it.
+static void unpooling_rows(void *arg, int begin, int end) {
+  const unpooling_private_t *p = (const unpooling_private_t *)arg;
+  const int output_width = p->width * p->kernel_w;
+  const float *x = (const float *)(p->input->data);
+  float *y = (float *)(p->output->data);
+  int r, k; // Iterator
+
+  for (r = begin; r < end; r++) {
+    float *row = y + (nn_size_t)r * p->kernel_h * output_width;
+    unpooling_widen_row(x + (nn_size_t)r * p->width, row, p->width,
+                        p->kernel_w);
+    for (k = 1; k < p->kernel_h; k++) {
+      memcpy(row + k * output_width, row, sizeof(float) * output_width);
+    }
+  }
+}
+#endif /* CONFIG_UNPOOLING_FLOAT32 */
+
 rt_function_error_t exec_unpooling(rt_function_t *f) {
   unpooling_private_t *p =
       (unpooling_private_t *)(((unpooling_local_context_t *)(f->local_context))
@@ -193,7 +306,12 @@ rt_function_error_t exec_unpooling(rt_function_t *f) {
   if (p->input->type == NN_DATA_TYPE_FLOAT &&
       p->output->type == NN_DATA_TYPE_FLOAT) {
 #ifdef CONFIG_UNPOOLING_FLOAT32
-    unpooling_forward_recursive(p, 0, 0, 0);
+    if (p->rows > 0) {
+      rt_parallel_for(p->rows, p->width * p->kernel_w * p->kernel_h,
+                      unpooling_rows, p);
+    } else {
+      unpooling_forward_recursive(p, 0, 0, 0);
+    }
 #endif /* CONFIG_UNPOOLING_FLOAT32 */
   } else {
 #ifdef CONFIG_UNPOOLING_GENERIC
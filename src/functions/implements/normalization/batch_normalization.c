@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <math.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -28,9 +29,17 @@ typedef struct {
   int output_size;
   int multiplication_axis_output;
   int multiplication_batch_axis;
+  int fast; ///< Multiply by reciprocal of std instead of dividing by it.
+  float *scale; ///< gamma / std of running var, or NULL with batch stat.
+  float *shift; ///< beta - running mean * scale.
 } batch_normalization_private_t;
 
 rt_function_error_t exec_batch_normalization_generic(rt_function_t *f);
+#ifdef CONFIG_BATCHNORMALIZATION_FLOAT32
+static void precompute_scale_shift(rt_function_t *f,
+                                   batch_normalization_local_context_t *context,
+                                   batch_normalization_private_t *p);
+#endif /* CONFIG_BATCHNORMALIZATION_FLOAT32 */
 
 // BatchNormalization
 rt_function_error_t
@@ -49,6 +58,10 @@ allocate_batch_normalization_local_context(rt_function_t *f) {
   }
   // Check and parse shapes
   rt_list_t input_shape = clone_list(f->inputs[0]->shape);
+  if (input_shape.data == 0) {
+    rt_free_func(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   const int axis = context->axes.data[0];
   const int size = calc_shape_size(input_shape);
   const int size_axis =
@@ -66,11 +79,21 @@ allocate_batch_normalization_local_context(rt_function_t *f) {
 
   p->batch_mean.shape = clone_list(f->inputs[1]->shape);
   p->batch_var.shape = clone_list(f->inputs[2]->shape);
+  if (p->batch_mean.shape.data == 0 || p->batch_var.shape.data == 0) {
+    free_list(input_shape);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
   p->batch_mean.data =
       rt_malloc_func(sizeof(float) * calc_shape_size(p->batch_mean.shape));
   p->batch_var.data =
       rt_malloc_func(sizeof(float) * calc_shape_size(p->batch_var.shape));
   free_list(input_shape);
+  if (p->batch_mean.data == 0 || p->batch_var.data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->fast = is_fast_math();
+  p->scale = 0;
+  p->shift = 0;
   ((batch_normalization_local_context_t *)(f->local_context))->data = (void *)p;
 
 #ifdef CONFIG_BATCHNORMALIZATION_FLOAT32
@@ -87,6 +110,17 @@ allocate_batch_normalization_local_context(rt_function_t *f) {
     f->exec_func = exec_batch_normalization_generic;
   }
 #endif /* CONFIG_BATCHNORMALIZATION_GENERIC */
+#ifdef CONFIG_BATCHNORMALIZATION_FLOAT32
+  if (f->exec_func == exec_batch_normalization && !context->batch_stat) {
+    // Running mean and var are parameters, which are read once like weights.
+    p->scale = rt_malloc_func(sizeof(float) * 2 * p->specified_axis_size);
+    if (p->scale == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    p->shift = p->scale + p->specified_axis_size;
+    precompute_scale_shift(f, context, p);
+  }
+#endif /* CONFIG_BATCHNORMALIZATION_FLOAT32 */
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
@@ -99,23 +133,31 @@ rt_function_error_t free_batch_normalization_local_context(rt_function_t *f) {
   free_list(p->batch_var.shape);
   rt_free_func(p->batch_mean.data);
   rt_free_func(p->batch_var.data);
+  if (p->scale) {
+    rt_free_func(p->scale);
+  }
   rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
 #ifdef CONFIG_BATCHNORMALIZATION_FLOAT32
-static void forward_impl_batch(rt_function_t *f,
-                               batch_normalization_local_context_t *context,
-                               batch_normalization_private_t *p) {
+// Process channels in [begin, end).
+// Running mean and var are parameters stored in network which must stay
+// read only, and they are not used in forward with batch stat, so they are
+// not updated.
+static void forward_impl_batch(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  batch_normalization_local_context_t *context =
+      (batch_normalization_local_context_t *)(f->local_context);
+  batch_normalization_private_t *p =
+      (batch_normalization_private_t *)(context->data);
   const float *x = (float *)(f->inputs[0]->data);
   const float *beta = (float *)(f->inputs[1]->data);
   const float *gamma = (float *)(f->inputs[2]->data);
   float *y = (float *)(f->outputs[0]->data);
-  float *m = (float *)p->batch_mean.data;    // batch mean
-  float *v = (float *)p->batch_var.data;     // batch var
-  float *rm = (float *)(f->inputs[3]->data); // running mean
-  float *rv = (float *)(f->inputs[4]->data); // running var
-  const int specified_axis_size = p->specified_axis_size;
+  float *m = (float *)p->batch_mean.data; // batch mean
+  float *v = (float *)p->batch_var.data;  // batch var
+  const int batch_size = p->batch_size;
   const int output_size = p->output_size;
   const int multiplication_axis_output = p->multiplication_axis_output;
   const int multiplication_batch_axis = p->multiplication_batch_axis;
@@ -125,64 +167,105 @@ static void forward_impl_batch(rt_function_t *f,
     v = (float *)(f->outputs[2]->data);
   }
 
-  int i1;
-  for (i1 = 0; i1 < specified_axis_size; i1++) {
+  int i0, i1, i2;
+  for (i1 = begin; i1 < end; i1++) {
+    // Mean, then var from deviations from it, rows added pairwise by
+    // vector_sum() so that they do not depend on number of threads.
     m[i1] = 0;
     v[i1] = 0;
-    int i02;
-    for (i02 = 0; i02 < multiplication_batch_axis; i02++) {
-      const int i0 = i02 / output_size;
-      const int i2 = i02 % output_size;
-      const int i = i0 * multiplication_axis_output + i1 * output_size + i2;
-      const float value = x[i];
-      m[i1] += value;
-      v[i1] += value * value;
+    for (i0 = 0; i0 < batch_size; i0++) {
+      const float *xr = x + i0 * multiplication_axis_output + i1 * output_size;
+      m[i1] += vector_sum(xr, output_size);
     }
     m[i1] /= multiplication_batch_axis;
-    v[i1] = v[i1] / multiplication_batch_axis - m[i1] * m[i1];
-
-    // Moving mean and var
-    rm[i1] = context->decay_rate * rm[i1] + (1 - context->decay_rate) * m[i1];
-    rv[i1] = context->decay_rate * rv[i1] +
-             (1 - context->decay_rate) * v[i1] * multiplication_batch_axis /
-                 (multiplication_batch_axis - 1);
+    for (i0 = 0; i0 < batch_size; i0++) {
+      const float *xr = x + i0 * multiplication_axis_output + i1 * output_size;
+      v[i1] += vector_squared_deviation_sum(xr, output_size, m[i1]);
+    }
+    v[i1] /= multiplication_batch_axis;
 
     const float stdvar = sqrtf(v[i1] + context->eps);
     // Subtract mean and divide by std, and apply beta and gamma.
-    for (i02 = 0; i02 < multiplication_batch_axis; i02++) {
-      const int i0 = i02 / output_size;
-      const int i2 = i02 % output_size;
-      const int i = i0 * multiplication_axis_output + i1 * output_size + i2;
-      y[i] = (x[i] - m[i1]) * gamma[i1] / stdvar + beta[i1];
+    for (i0 = 0; i0 < batch_size; i0++) {
+      const int offset = i0 * multiplication_axis_output + i1 * output_size;
+      const float *xr = x + offset;
+      float *yr = y + offset;
+      if (p->fast) {
+        const float scale = gamma[i1] / stdvar;
+        for (i2 = 0; i2 < output_size; i2++) {
+          yr[i2] = (xr[i2] - m[i1]) * scale + beta[i1];
+        }
+      } else {
+        for (i2 = 0; i2 < output_size; i2++) {
+          yr[i2] = (xr[i2] - m[i1]) * gamma[i1] / stdvar + beta[i1];
+        }
+      }
     }
   }
 }
 
-static void forward_impl_global(rt_function_t *f,
-                                batch_normalization_local_context_t *context,
-                                batch_normalization_private_t *p) {
-  const float *x = (float *)(f->inputs[0]->data);
+// Fold running mean and var into y = x * scale + shift.
+static void precompute_scale_shift(rt_function_t *f,
+                                   batch_normalization_local_context_t *context,
+                                   batch_normalization_private_t *p) {
   const float *beta = (float *)(f->inputs[1]->data);
   const float *gamma = (float *)(f->inputs[2]->data);
   const float *rm = (float *)(f->inputs[3]->data); // running mean
   const float *rv = (float *)(f->inputs[4]->data); // running var
+  int i1;
+  for (i1 = 0; i1 < p->specified_axis_size; i1++) {
+    const float stdvar = sqrtf(rv[i1] + context->eps);
+    p->scale[i1] = gamma[i1] / stdvar;
+    p->shift[i1] = beta[i1] - rm[i1] * p->scale[i1];
+  }
+}
+
+// Process channels in [begin, end).
+static void forward_impl_global(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  batch_normalization_private_t *p =
+      (batch_normalization_private_t
+           *)(((batch_normalization_local_context_t *)(f->local_context))
+                  ->data);
+  const float *x = (float *)(f->inputs[0]->data);
   float *y = (float *)(f->outputs[0]->data);
-  const int specified_axis_size = p->specified_axis_size;
+  const int batch_size = p->batch_size;
   const int output_size = p->output_size;
   const int multiplication_axis_output = p->multiplication_axis_output;
-  const int multiplication_batch_axis = p->multiplication_batch_axis;
 
-  // Subtract mean and divide by std, and apply beta and gamma.
-  int i1;
-  for (i1 = 0; i1 < specified_axis_size; i1++) {
-    int i02;
-    const float stdvar = sqrtf(rv[i1] + context->eps);
-    for (i02 = 0; i02 < multiplication_batch_axis; i02++) {
-      const int i0 = i02 / output_size;
-      const int i2 = i02 % output_size;
-      const int i = i0 * multiplication_axis_output + i1 * output_size + i2;
-      const float mean = rm[i1];
-      y[i] = (x[i] - mean) * gamma[i1] / stdvar + beta[i1];
+  int i0, i1, i2;
+  for (i1 = begin; i1 < end; i1++) {
+    const float scale = p->scale[i1];
+    const float shift = p->shift[i1];
+    for (i0 = 0; i0 < batch_size; i0++) {
+      const int offset = i0 * multiplication_axis_output + i1 * output_size;
+      const float *xr = x + offset;
+      float *yr = y + offset;
+      for (i2 = 0; i2 < output_size; i2++) {
+        yr[i2] = xr[i2] * scale + shift;
+      }
+    }
+  }
+}
+
+// Process samples in [begin, end) when axis is innermost, so that channels of
+// a sample are one contiguous row.
+static void forward_impl_global_rows(void *arg, int begin, int end) {
+  rt_function_t *f = (rt_function_t *)arg;
+  batch_normalization_private_t *p =
+      (batch_normalization_private_t
+           *)(((batch_normalization_local_context_t *)(f->local_context))
+                  ->data);
+  const float *scale = p->scale;
+  const float *shift = p->shift;
+  const int specified_axis_size = p->specified_axis_size;
+
+  int i0, i1;
+  for (i0 = begin; i0 < end; i0++) {
+    const float *xr = (float *)(f->inputs[0]->data) + i0 * specified_axis_size;
+    float *yr = (float *)(f->outputs[0]->data) + i0 * specified_axis_size;
+    for (i1 = 0; i1 < specified_axis_size; i1++) {
+      yr[i1] = xr[i1] * scale[i1] + shift[i1];
     }
   }
 }
@@ -194,9 +277,14 @@ rt_function_error_t exec_batch_normalization(rt_function_t *f) {
       (batch_normalization_private_t *)(context->data);
 
   if (context->batch_stat) {
-    forward_impl_batch(f, context, p);
+    rt_parallel_for(p->specified_axis_size, p->multiplication_batch_axis * 2,
+                    forward_impl_batch, f);
+  } else if (p->output_size == 1) {
+    rt_parallel_for(p->batch_size, p->specified_axis_size,
+                    forward_impl_global_rows, f);
   } else {
-    forward_impl_global(f, context, p);
+    rt_parallel_for(p->specified_axis_size, p->multiplication_batch_axis,
+                    forward_impl_global, f);
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -213,12 +301,6 @@ forward_impl_batch_generic(rt_function_t *f,
   rt_variable_getter get_beta = select_getter(input_beta);
   rt_variable_t *input_gamma = f->inputs[2];
   rt_variable_getter get_gamma = select_getter(input_gamma);
-  rt_variable_t *input_rm = f->inputs[3]; // running mean
-  rt_variable_getter get_rm = select_getter(input_rm);
-  rt_variable_setter set_rm = select_setter(input_rm);
-  rt_variable_t *input_rv = f->inputs[4]; // running var
-  rt_variable_getter get_rv = select_getter(input_rv);
-  rt_variable_setter set_rv = select_setter(input_rv);
   rt_variable_t *output = f->outputs[0];
   rt_variable_setter set_output = select_setter(output);
   float *m = (float *)p->batch_mean.data; // batch mean
@@ -238,26 +320,22 @@ forward_impl_batch_generic(rt_function_t *f,
     m[i1] = 0;
     v[i1] = 0;
     int i02;
+    // Mean, then var from deviations from it, same as float function.
     for (i02 = 0; i02 < multiplication_batch_axis; i02++) {
       const int i0 = i02 / output_size;
       const int i2 = i02 % output_size;
       const int i = i0 * multiplication_axis_output + i1 * output_size + i2;
-      const float value = get_x(input_x, i);
-      m[i1] += value;
-      v[i1] += value * value;
+      m[i1] += get_x(input_x, i);
     }
     m[i1] /= multiplication_batch_axis;
-    v[i1] = v[i1] / multiplication_batch_axis - m[i1] * m[i1];
-
-    // Moving mean and var
-    float rm = get_rm(input_rm, i1);
-    float rv = get_rv(input_rv, i1);
-    rm = context->decay_rate * rm + (1 - context->decay_rate) * m[i1];
-    rv = context->decay_rate * rv +
-         (1 - context->decay_rate) * v[i1] * multiplication_batch_axis /
-             (multiplication_batch_axis - 1);
-    set_rm(input_rm, i1, rm);
-    set_rv(input_rv, i1, rv);
+    for (i02 = 0; i02 < multiplication_batch_axis; i02++) {
+      const int i0 = i02 / output_size;
+      const int i2 = i02 % output_size;
+      const int i = i0 * multiplication_axis_output + i1 * output_size + i2;
+      const float deviation = get_x(input_x, i) - m[i1];
+      v[i1] += deviation * deviation;
+    }
+    v[i1] /= multiplication_batch_axis;
 
     const float stdvar = sqrtf(v[i1] + context->eps);
     // Subtract mean and divide by std, and apply beta and gamma.
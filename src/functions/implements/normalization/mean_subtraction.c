@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
 #include <assert.h>
 #include <math.h>
 #include <nnablart/config.h>
@@ -21,6 +22,11 @@
 
 #ifdef CONFIG_MEANSUBTRACTION
 
+typedef struct {
+  int features; ///< Elements of running mean, from base_axis to the last.
+  int rows;     ///< Rows of features in input.
+} mean_subtraction_private_t;
+
 rt_function_error_t exec_mean_subtraction_generic(rt_function_t *f);
 
 // MeanSubtraction
@@ -35,6 +41,14 @@ rt_function_error_t allocate_mean_subtraction_local_context(rt_function_t *f) {
   if (calc_shape_size(f->inputs[1]->shape) != s0) {
     return RT_FUNCTION_ERROR_INVALID_SHAPE;
   }
+  mean_subtraction_private_t *p = (mean_subtraction_private_t *)rt_malloc_func(
+      sizeof(mean_subtraction_private_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->features = s0;
+  p->rows = s0 > 0 ? calc_shape_size(in_shape) / s0 : 0;
+  ctx->data = p;
   if (f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
       f->inputs[1]->type == NN_DATA_TYPE_FLOAT &&
       f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
@@ -50,32 +64,31 @@ rt_function_error_t allocate_mean_subtraction_local_context(rt_function_t *f) {
 }
 
 rt_function_error_t free_mean_subtraction_local_context(rt_function_t *f) {
+  mean_subtraction_local_context_t *ctx =
+      (mean_subtraction_local_context_t *)f->local_context;
+  rt_free_func(ctx->data);
+  ctx->data = 0;
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
 #ifdef CONFIG_MEANSUBTRACTION_FLOAT32
 /*
  * ctx->update_running_mean is omitted, since in inferring time,
- * we do not update running mean any more.
+ * we do not update running mean any more. Each row of features is
+ * contiguous, so running mean is subtracted from a row at once.
  */
 rt_function_error_t exec_mean_subtraction(rt_function_t *f) {
-  mean_subtraction_local_context_t *ctx =
-      (mean_subtraction_local_context_t *)f->local_context;
-  rt_list_t in_shape = f->inputs[0]->shape;
+  mean_subtraction_private_t *p =
+      (mean_subtraction_private_t *)((mean_subtraction_local_context_t *)
+                                         f->local_context)
+          ->data;
   float *y = (float *)(f->outputs[0]->data);
-  float *x = (float *)(f->inputs[0]->data);
-  float *rm = (float *)(f->inputs[1]->data);
-  int i, j, s0 = 1, s1;
+  const float *x = (const float *)(f->inputs[0]->data);
+  const float *rm = (const float *)(f->inputs[1]->data);
+  int j; // Iterator
 
-  for (i = ctx->base_axis; i < in_shape.size; ++i) {
-    s0 *= in_shape.data[i];
-  }
-  s1 = calc_shape_size(f->inputs[0]->shape) / s0;
-  for (i = 0; i < s0; ++i) {
-    for (j = 0; j < s1; ++j) {
-      int idx = j * s0 + i;
-      y[idx] = x[idx] - rm[i];
-    }
+  for (j = 0; j < p->rows; ++j) {
+    vector_sub(x + j * p->features, rm, y + j * p->features, p->features);
   }
 
   return RT_FUNCTION_ERROR_NOERROR;
@@ -84,24 +97,21 @@ rt_function_error_t exec_mean_subtraction(rt_function_t *f) {
 
 #ifdef CONFIG_MEANSUBTRACTION_GENERIC
 rt_function_error_t exec_mean_subtraction_generic(rt_function_t *f) {
-  mean_subtraction_local_context_t *ctx =
-      (mean_subtraction_local_context_t *)f->local_context;
-  rt_list_t in_shape = f->inputs[0]->shape;
+  mean_subtraction_private_t *p =
+      (mean_subtraction_private_t *)((mean_subtraction_local_context_t *)
+                                         f->local_context)
+          ->data;
   rt_variable_t *input_x = f->inputs[0];
   rt_variable_getter get_x = select_getter(input_x);
   rt_variable_t *input_rm = f->inputs[1];
   rt_variable_getter get_rm = select_getter(input_rm);
   rt_variable_t *output = f->outputs[0];
   rt_variable_setter set_output = select_setter(output);
-  int i, j, s0 = 1, s1;
+  int i, j; // Iterator
 
-  for (i = ctx->base_axis; i < in_shape.size; ++i) {
-    s0 *= in_shape.data[i];
-  }
-  s1 = calc_shape_size(f->inputs[0]->shape) / s0;
-  for (i = 0; i < s0; ++i) {
-    for (j = 0; j < s1; ++j) {
-      int idx = j * s0 + i;
+  for (j = 0; j < p->rows; ++j) {
+    for (i = 0; i < p->features; ++i) {
+      int idx = j * p->features + i;
       float x = get_x(input_x, idx);
       float rm = get_rm(input_rm, i);
       set_output(output, idx, x - rm);
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/sign.h"
 #include <math.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -30,6 +31,7 @@ typedef struct {
 } binary_sigmoid_private_context_t;
 
 rt_function_error_t exec_binary_sigmoid_generic(rt_function_t *f);
+rt_function_error_t exec_binary_sigmoid_sign(rt_function_t *f);
 
 // BinarySigmoid
 rt_function_error_t allocate_binary_sigmoid_local_context(rt_function_t *f) {
@@ -59,6 +61,10 @@ rt_function_error_t allocate_binary_sigmoid_local_context(rt_function_t *f) {
 #ifdef CONFIG_BINARYSIGMOID_FLOAT32
     f->exec_func = exec_binary_sigmoid;
 #endif /* CONFIG_BINARYSIGMOID_FLOAT32 */
+  } else if (p->output->type == NN_DATA_TYPE_SIGN) {
+#ifdef CONFIG_BINARYSIGMOID_GENERIC
+    f->exec_func = exec_binary_sigmoid_sign;
+#endif /* CONFIG_BINARYSIGMOID_GENERIC */
   } else {
 #ifdef CONFIG_BINARYSIGMOID_GENERIC
     f->exec_func = exec_binary_sigmoid_generic;
@@ -109,6 +115,15 @@ rt_function_error_t exec_binary_sigmoid_generic(rt_function_t *f) {
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
+
+// Output bits are written a word at a time. SIGN has no 0, so 0 is stored as
+// cleared bit which reads as -1, same as BinaryTanh.
+rt_function_error_t exec_binary_sigmoid_sign(rt_function_t *f) {
+  binary_sigmoid_private_context_t *p =
+      (binary_sigmoid_private_context_t *)(f->local_context);
+  pack_binary_sign(p->input, p->input_size, (uint32_t *)(p->output->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
 #endif /* CONFIG_BINARYSIGMOID_GENERIC */
 
 #endif /* CONFIG_BINARYSIGMOID */
@@ -14,6 +14,7 @@
 
 #include "../../utilities/accessor.h"
 #include "../../utilities/shape.h"
+#include "../../utilities/sign.h"
 #include <math.h>
 #include <nnablart/config.h>
 #include <nnablart/functions.h>
@@ -30,6 +31,7 @@ typedef struct {
 } binary_tanh_private_context_t;
 
 rt_function_error_t exec_binary_tanh_generic(rt_function_t *f);
+rt_function_error_t exec_binary_tanh_sign(rt_function_t *f);
 
 // BinaryTanh
 rt_function_error_t allocate_binary_tanh_local_context(rt_function_t *f) {
@@ -59,6 +61,10 @@ rt_function_error_t allocate_binary_tanh_local_context(rt_function_t *f) {
 #ifdef CONFIG_BINARYTANH_FLOAT32
     f->exec_func = exec_binary_tanh;
 #endif /* CONFIG_BINARYTANH_FLOAT32 */
+  } else if (p->output->type == NN_DATA_TYPE_SIGN) {
+#ifdef CONFIG_BINARYTANH_GENERIC
+    f->exec_func = exec_binary_tanh_sign;
+#endif /* CONFIG_BINARYTANH_GENERIC */
   } else {
 #ifdef CONFIG_BINARYTANH_GENERIC
     f->exec_func = exec_binary_tanh_generic;
@@ -109,6 +115,14 @@ rt_function_error_t exec_binary_tanh_generic(rt_function_t *f) {
   }
   return RT_FUNCTION_ERROR_NOERROR;
 }
+
+// Output bits are written a word at a time.
+rt_function_error_t exec_binary_tanh_sign(rt_function_t *f) {
+  binary_tanh_private_context_t *p =
+      (binary_tanh_private_context_t *)(f->local_context);
+  pack_binary_sign(p->input, p->input_size, (uint32_t *)(p->output->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
 #endif /* CONFIG_BINARYTANH_GENERIC */
 
 #endif /* CONFIG_BINARYTANH */
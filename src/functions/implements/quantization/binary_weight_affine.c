@@ -57,6 +57,13 @@ allocate_binary_weight_affine_local_context(rt_function_t *f) {
   }
 
   p->output_size = calc_shape_size(p->output->shape);
+  p->panel_weight = 0;
+  p->fixed_bias = 0;
+  p->sign_weight = 0;
+  p->sign_input = 0;
+  p->dense_weight.data = 0;
+  p->epilogue.type = RT_EPILOGUE_NONE;
+  p->epilogue.alpha = 0.0f;
 
   int base_axis = ((affine_local_context_t *)(f->local_context))->base_axis;
   int i; // Iterator
@@ -85,7 +92,12 @@ allocate_binary_weight_affine_local_context(rt_function_t *f) {
 #endif /* CONFIG_BINARYWEIGHTAFFINE_FLOAT32 */
   } else {
 #ifdef CONFIG_BINARYWEIGHTAFFINE_GENERIC
-    f->exec_func = exec_affine_generic;
+    if (is_sign_affine(p) &&
+        allocate_affine_sign(p) == RT_FUNCTION_ERROR_NOERROR) {
+      f->exec_func = exec_affine_sign;
+    } else {
+      f->exec_func = exec_affine_generic;
+    }
 #endif /* CONFIG_BINARYWEIGHTAFFINE_GENERIC */
   }
 
@@ -94,7 +106,11 @@ allocate_binary_weight_affine_local_context(rt_function_t *f) {
 }
 
 rt_function_error_t free_binary_weight_affine_local_context(rt_function_t *f) {
-  rt_free_func((((affine_local_context_t *)(f->local_context))->data));
+  affine_private_t *p =
+      (affine_private_t *)(((affine_local_context_t *)(f->local_context))
+                               ->data);
+  free_affine_sign(p);
+  rt_free_func(p);
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
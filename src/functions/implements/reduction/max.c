@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/reduction.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_MAX
+
+// Max over axes. Index is position of the first max in reduced axes.
+rt_function_error_t exec_max_generic(rt_function_t *f);
+
+// Max
+rt_function_error_t allocate_max_local_context(rt_function_t *f) {
+  max_local_context_t *context = (max_local_context_t *)(f->local_context);
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  // Outputs are index only, values and index, or values.
+  const int num_of_outputs =
+      context->only_index ? 1 : context->with_index ? 2 : 1;
+  if (f->num_of_outputs != num_of_outputs) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  const int with_index = context->only_index || context->with_index;
+  const int is_float =
+      f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+      f->outputs[0]->type == NN_DATA_TYPE_FLOAT &&
+      f->outputs[num_of_outputs - 1]->type == NN_DATA_TYPE_FLOAT;
+  reduction_param_t *p = rt_malloc_func(sizeof(reduction_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  rt_function_error_t ret = allocate_reduction_param(
+      f, REDUCTION_MAX, context->axes, with_index, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    rt_free_func(p);
+    return ret;
+  }
+  context->data = (void *)p;
+  if (is_float) {
+#ifdef CONFIG_MAX_FLOAT32
+    f->exec_func = exec_max;
+#endif /* CONFIG_MAX_FLOAT32 */
+  } else {
+#ifdef CONFIG_MAX_GENERIC
+    f->exec_func = exec_max_generic;
+#endif /* CONFIG_MAX_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_max_local_context(rt_function_t *f) {
+  max_local_context_t *context = (max_local_context_t *)(f->local_context);
+  reduction_param_t *p = (reduction_param_t *)(context->data);
+  if (p) {
+    free_reduction_param(p);
+    rt_free_func(p);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_MAX_FLOAT32
+rt_function_error_t exec_max(rt_function_t *f) {
+  max_local_context_t *context = (max_local_context_t *)(f->local_context);
+  reduction_param_t *p = (reduction_param_t *)(context->data);
+  const int only_index = context->only_index;
+  calc_reduction(p, (const float *)(f->inputs[0]->data),
+                 only_index ? 0 : (float *)(f->outputs[0]->data),
+                 only_index || context->with_index
+                     ? (float *)(f->outputs[f->num_of_outputs - 1]->data)
+                     : 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_MAX_FLOAT32 */
+
+#ifdef CONFIG_MAX_GENERIC
+rt_function_error_t exec_max_generic(rt_function_t *f) {
+  max_local_context_t *context = (max_local_context_t *)(f->local_context);
+  reduction_param_t *p = (reduction_param_t *)(context->data);
+  const int only_index = context->only_index;
+  calc_reduction_generic(p, f->inputs[0], only_index ? 0 : f->outputs[0],
+                         only_index || context->with_index
+                             ? f->outputs[f->num_of_outputs - 1]
+                             : 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_MAX_GENERIC */
+
+#endif /* CONFIG_MAX */
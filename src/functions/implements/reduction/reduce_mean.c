@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/reduction.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_REDUCEMEAN
+
+// Mean of all values.
+rt_function_error_t exec_reduce_mean_generic(rt_function_t *f);
+
+// ReduceMean
+rt_function_error_t allocate_reduce_mean_local_context(rt_function_t *f) {
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  const int is_float = f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+                       f->outputs[0]->type == NN_DATA_TYPE_FLOAT;
+  const rt_list_t all_axes = {0, 0};
+  reduction_param_t *p = rt_malloc_func(sizeof(reduction_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  // Runtime frees local context after this function frees work areas.
+  f->local_context = (void *)p;
+  rt_function_error_t ret =
+      allocate_reduction_param(f, REDUCTION_MEAN, all_axes, 0, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    return ret;
+  }
+  if (is_float) {
+#ifdef CONFIG_REDUCEMEAN_FLOAT32
+    f->exec_func = exec_reduce_mean;
+#endif /* CONFIG_REDUCEMEAN_FLOAT32 */
+  } else {
+#ifdef CONFIG_REDUCEMEAN_GENERIC
+    f->exec_func = exec_reduce_mean_generic;
+#endif /* CONFIG_REDUCEMEAN_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_reduce_mean_local_context(rt_function_t *f) {
+  if (f->local_context) {
+    free_reduction_param((reduction_param_t *)(f->local_context));
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_REDUCEMEAN_FLOAT32
+rt_function_error_t exec_reduce_mean(rt_function_t *f) {
+  calc_reduction((reduction_param_t *)(f->local_context),
+                 (const float *)(f->inputs[0]->data),
+                 (float *)(f->outputs[0]->data), 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_REDUCEMEAN_FLOAT32 */
+
+#ifdef CONFIG_REDUCEMEAN_GENERIC
+rt_function_error_t exec_reduce_mean_generic(rt_function_t *f) {
+  calc_reduction_generic((reduction_param_t *)(f->local_context),
+                         f->inputs[0], f->outputs[0], 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_REDUCEMEAN_GENERIC */
+
+#endif /* CONFIG_REDUCEMEAN */
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/reduction.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+
+#ifdef CONFIG_REDUCESUM
+
+// Sum of all values.
+rt_function_error_t exec_reduce_sum_generic(rt_function_t *f);
+
+// ReduceSum
+rt_function_error_t allocate_reduce_sum_local_context(rt_function_t *f) {
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  const int is_float = f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+                       f->outputs[0]->type == NN_DATA_TYPE_FLOAT;
+  const rt_list_t all_axes = {0, 0};
+  reduction_param_t *p = rt_malloc_func(sizeof(reduction_param_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  // Runtime frees local context after this function frees work areas.
+  f->local_context = (void *)p;
+  rt_function_error_t ret =
+      allocate_reduction_param(f, REDUCTION_SUM, all_axes, 0, is_float, p);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    return ret;
+  }
+  if (is_float) {
+#ifdef CONFIG_REDUCESUM_FLOAT32
+    f->exec_func = exec_reduce_sum;
+#endif /* CONFIG_REDUCESUM_FLOAT32 */
+  } else {
+#ifdef CONFIG_REDUCESUM_GENERIC
+    f->exec_func = exec_reduce_sum_generic;
+#endif /* CONFIG_REDUCESUM_GENERIC */
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_reduce_sum_local_context(rt_function_t *f) {
+  if (f->local_context) {
+    free_reduction_param((reduction_param_t *)(f->local_context));
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_REDUCESUM_FLOAT32
+rt_function_error_t exec_reduce_sum(rt_function_t *f) {
+  calc_reduction((reduction_param_t *)(f->local_context),
+                 (const float *)(f->inputs[0]->data),
+                 (float *)(f->outputs[0]->data), 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_REDUCESUM_FLOAT32 */
+
+#ifdef CONFIG_REDUCESUM_GENERIC
+rt_function_error_t exec_reduce_sum_generic(rt_function_t *f) {
+  calc_reduction_generic((reduction_param_t *)(f->local_context),
+                         f->inputs[0], f->outputs[0], 0);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_REDUCESUM_GENERIC */
+
+#endif /* CONFIG_REDUCESUM */
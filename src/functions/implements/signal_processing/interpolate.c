@@ -0,0 +1,294 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/accessor.h"
+#include "../../utilities/shape.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <string.h>
+
+#ifdef CONFIG_INTERPOLATE
+
+// Interpolation is separable, so each resized axis is one pass from the last
+// axis to the first. A pass reads rows of inner contiguous values at source
+// positions of the axis, which are computed when context is allocated, and
+// writes weighted sums of two rows. Axes after the resized one are already
+// resized, and inner is 1 only for the last axis.
+typedef struct {
+  int outer;      // Product of input axes before this axis.
+  int input_size; // Input size of this axis.
+  int size;       // Output size of this axis.
+  int inner;      // Product of output axes after this axis.
+  int *index0;    // First source position of each output position.
+  int *index1;    // Second source position, same as index0 for nearest.
+  float *weight0; // Weight of index0, 1 for nearest.
+  float *weight1; // Weight of index1, 0 for nearest.
+} interpolate_axis_t;
+
+typedef struct {
+  int linear;
+  int num_of_axes;          // Resized axes, whose input and output differ.
+  interpolate_axis_t *axes; // In order of passes, with their tables.
+  float *buffers[2];        // Outputs of passes before the last one.
+  float *input;             // Float copy of input by generic function.
+  float *output;            // Float output of generic function.
+  int input_size;
+  int output_size;
+} interpolate_private_t;
+
+rt_function_error_t exec_interpolate_generic(rt_function_t *f);
+
+static float calc_scale(int input_size, int output_size, int align_corners) {
+  if (output_size <= 1) {
+    return 0.0f;
+  }
+  return align_corners ? (float)(input_size - 1) / (output_size - 1)
+                       : (float)input_size / output_size;
+}
+
+static void set_source_positions(interpolate_axis_t *a, int linear,
+                                 int align_corners) {
+  const float scale = calc_scale(a->input_size, a->size, align_corners);
+  int i; // Iterator
+
+  for (i = 0; i < a->size; i++) {
+    float source = scale * i;
+    if (linear && !align_corners) {
+      source = scale * (i + 0.5f) - 0.5f;
+      source = source > 0.0f ? source : 0.0f;
+    }
+    a->index0[i] = (int)source;
+    if (a->index0[i] > a->input_size - 1) {
+      a->index0[i] = a->input_size - 1;
+    }
+    a->index1[i] = a->index0[i];
+    a->weight0[i] = 1.0f;
+    a->weight1[i] = 0.0f;
+    if (linear && a->index0[i] < a->input_size - 1) {
+      a->index1[i] = a->index0[i] + 1;
+      a->weight1[i] = source - a->index0[i];
+      a->weight0[i] = 1.0f - a->weight1[i];
+    }
+  }
+}
+
+static void free_interpolate_private(interpolate_private_t *p) {
+  rt_free_func(p->buffers[0]);
+  rt_free_func(p->buffers[1]);
+  rt_free_func(p->input);
+  rt_free_func(p->output);
+  rt_free_func(p->axes);
+  rt_free_func(p);
+}
+
+// Interpolate
+rt_function_error_t allocate_interpolate_local_context(rt_function_t *f) {
+  interpolate_local_context_t *context =
+      (interpolate_local_context_t *)(f->local_context);
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_list_t x = f->inputs[0]->shape;
+  rt_list_t y = f->outputs[0]->shape;
+  const int first = x.size - context->output_size.size;
+  int i, j; // Iterators
+
+  if (context->mode >= END_OF_INTERPOLATE_MODE ||
+      context->output_size.size < 1 || first < 0 || y.size != x.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < x.size; i++) {
+    int size = i < first ? x.data[i] : context->output_size.data[i - first];
+    if (y.data[i] != size || size < 1 || x.data[i] < 1) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+
+  interpolate_private_t *p = rt_malloc_func(sizeof(interpolate_private_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  memset(p, 0, sizeof(interpolate_private_t));
+  p->linear = context->mode == INTERPOLATE_MODE_LINEAR;
+  p->input_size = calc_shape_size(x);
+  p->output_size = calc_shape_size(y);
+
+  // Axes with tables in one area.
+  size_t bytes = 0;
+  for (i = first; i < x.size; i++) {
+    if (x.data[i] != y.data[i]) {
+      p->num_of_axes++;
+      bytes += (sizeof(int) * 2 + sizeof(float) * 2) * y.data[i];
+    }
+  }
+  p->axes =
+      rt_malloc_func(sizeof(interpolate_axis_t) * p->num_of_axes + bytes);
+  if (p->axes == 0) {
+    free_interpolate_private(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  uint8_t *tables = (uint8_t *)(p->axes + p->num_of_axes);
+  size_t largest = 0; // Elements of the largest output of passes.
+  size_t elements = p->input_size;
+  interpolate_axis_t *a = p->axes;
+  for (i = x.size - 1; i >= first; i--) {
+    if (x.data[i] == y.data[i]) {
+      continue;
+    }
+    a->outer = 1;
+    for (j = 0; j < i; j++) {
+      a->outer *= x.data[j];
+    }
+    a->input_size = x.data[i];
+    a->size = y.data[i];
+    a->inner = 1;
+    for (j = i + 1; j < y.size; j++) {
+      a->inner *= y.data[j];
+    }
+    a->index0 = (int *)tables;
+    a->index1 = a->index0 + a->size;
+    a->weight0 = (float *)(a->index1 + a->size);
+    a->weight1 = a->weight0 + a->size;
+    tables = (uint8_t *)(a->weight1 + a->size);
+    set_source_positions(a, p->linear, context->align_corners);
+
+    elements = elements / a->input_size * a->size;
+    if (a + 1 != p->axes + p->num_of_axes && elements > largest) {
+      largest = elements;
+    }
+    a++;
+  }
+
+  if (p->num_of_axes > 1) {
+    p->buffers[0] = rt_malloc_func(sizeof(float) * largest);
+  }
+  if (p->num_of_axes > 2) {
+    p->buffers[1] = rt_malloc_func(sizeof(float) * largest);
+  }
+  if ((p->num_of_axes > 1 && p->buffers[0] == 0) ||
+      (p->num_of_axes > 2 && p->buffers[1] == 0)) {
+    free_interpolate_private(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+
+  if (f->inputs[0]->type == NN_DATA_TYPE_FLOAT &&
+      f->outputs[0]->type == NN_DATA_TYPE_FLOAT) {
+#ifdef CONFIG_INTERPOLATE_FLOAT32
+    f->exec_func = exec_interpolate;
+#endif /* CONFIG_INTERPOLATE_FLOAT32 */
+  } else {
+#ifdef CONFIG_INTERPOLATE_GENERIC
+    p->input = rt_malloc_func(sizeof(float) * p->input_size);
+    p->output = rt_malloc_func(sizeof(float) * p->output_size);
+    if (p->input == 0 || p->output == 0) {
+      free_interpolate_private(p);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    f->exec_func = exec_interpolate_generic;
+#endif /* CONFIG_INTERPOLATE_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_interpolate_local_context(rt_function_t *f) {
+  interpolate_local_context_t *context =
+      (interpolate_local_context_t *)(f->local_context);
+  if (context->data) {
+    free_interpolate_private((interpolate_private_t *)(context->data));
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+// Loops over inner values are contiguous, and compilers vectorize them.
+static void interpolate_axis(const interpolate_axis_t *a, int linear,
+                             const float *x, float *y) {
+  const int input_stride = a->input_size * a->inner;
+  const int stride = a->size * a->inner;
+  int o, i, k; // Iterators
+
+  for (o = 0; o < a->outer; o++, x += input_stride, y += stride) {
+    if (a->inner == 1 && linear) {
+      for (i = 0; i < a->size; i++) {
+        y[i] =
+            a->weight0[i] * x[a->index0[i]] + a->weight1[i] * x[a->index1[i]];
+      }
+    } else if (a->inner == 1) {
+      for (i = 0; i < a->size; i++) {
+        y[i] = x[a->index0[i]];
+      }
+    } else {
+      for (i = 0; i < a->size; i++) {
+        const float *x0 = x + a->index0[i] * a->inner;
+        const float *x1 = x + a->index1[i] * a->inner;
+        const float w0 = a->weight0[i];
+        const float w1 = a->weight1[i];
+        float *yi = y + i * a->inner;
+        if (w1 == 0.0f) {
+          memcpy(yi, x0, sizeof(float) * a->inner);
+        } else {
+          for (k = 0; k < a->inner; k++) {
+            yi[k] = w0 * x0[k] + w1 * x1[k];
+          }
+        }
+      }
+    }
+  }
+}
+
+static void interpolate(const interpolate_private_t *p, const float *x,
+                        float *y) {
+  const float *source = x;
+  int i; // Iterator
+
+  if (p->num_of_axes == 0) {
+    memcpy(y, x, sizeof(float) * p->output_size);
+    return;
+  }
+  for (i = 0; i < p->num_of_axes; i++) {
+    float *destination = i == p->num_of_axes - 1 ? y : p->buffers[i % 2];
+    interpolate_axis(p->axes + i, p->linear, source, destination);
+    source = destination;
+  }
+}
+
+#ifdef CONFIG_INTERPOLATE_FLOAT32
+rt_function_error_t exec_interpolate(rt_function_t *f) {
+  interpolate_private_t *p =
+      (interpolate_private_t
+           *)(((interpolate_local_context_t *)(f->local_context))->data);
+  interpolate(p, (const float *)(f->inputs[0]->data),
+              (float *)(f->outputs[0]->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_INTERPOLATE_FLOAT32 */
+
+#ifdef CONFIG_INTERPOLATE_GENERIC
+rt_function_error_t exec_interpolate_generic(rt_function_t *f) {
+  interpolate_private_t *p =
+      (interpolate_private_t
+           *)(((interpolate_local_context_t *)(f->local_context))->data);
+  get_variable_block(f->inputs[0], 0, p->input_size, p->input);
+  interpolate(p, p->input, p->output);
+  set_variable_block(f->outputs[0], 0, p->output_size, p->output);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_INTERPOLATE_GENERIC */
+
+#endif /* CONFIG_INTERPOLATE */
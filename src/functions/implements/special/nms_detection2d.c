@@ -0,0 +1,277 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/accessor.h"
+#include "../../utilities/shape.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CONFIG_NMSDETECTION2D
+
+#define NMS_BLOCK (8) // Kept boxes compared before each early exit
+
+// Input is (B, N, 5 + C) of box x, y, w, h, objectness and probabilities of
+// C classes. Probabilities below thresh become 0. Boxes with nonzero score
+// are candidates, which are sorted by score and kept unless they overlap a
+// kept box by IoU over nms, in which case their probabilities become 0.
+// Score is probability of each class if nms_per_class, or objectness of boxes
+// with any nonzero probability otherwise.
+typedef struct {
+  float score;
+  int index;
+} nms_candidate_t;
+
+// Kept boxes of a sample, as arrays of each edge so that IoU against all of
+// them is vectorized.
+typedef struct {
+  float *left;
+  float *top;
+  float *right;
+  float *bottom;
+  float *area;
+} nms_kept_t;
+
+typedef struct {
+  int batch_size;
+  int num_of_boxes;
+  int channel;
+  float thresh;
+  float nms;
+  int per_class;
+  nms_candidate_t *candidates; // num_of_boxes for each sample.
+  float *kept;                 // 5 * num_of_boxes for each sample.
+  float *data;                 // Float copy of input by generic function.
+  float *boxes;                // Boxes suppressed by exec.
+} nms_detection2d_private_t;
+
+rt_function_error_t exec_nms_detection2d_generic(rt_function_t *f);
+
+static int compare_candidates(const void *a, const void *b) {
+  const nms_candidate_t *ca = (const nms_candidate_t *)a;
+  const nms_candidate_t *cb = (const nms_candidate_t *)b;
+  if (ca->score != cb->score) {
+    return ca->score < cb->score ? 1 : -1;
+  }
+  return ca->index - cb->index;
+}
+
+// Box overlaps any of num_of_kept boxes by IoU over nms.
+static int overlaps_kept(const nms_kept_t *k, int num_of_kept,
+                         const float *box, float nms) {
+  const float left = box[0] - box[2] / 2;
+  const float top = box[1] - box[3] / 2;
+  const float right = box[0] + box[2] / 2;
+  const float bottom = box[1] + box[3] / 2;
+  const float area = box[2] * box[3];
+  int i, j; // Iterators
+
+  for (j = 0; j < num_of_kept; j += NMS_BLOCK) {
+    const int end = j + NMS_BLOCK < num_of_kept ? j + NMS_BLOCK : num_of_kept;
+    int hit = 0;
+    for (i = j; i < end; i++) {
+      const float w = (right < k->right[i] ? right : k->right[i]) -
+                      (left > k->left[i] ? left : k->left[i]);
+      const float h = (bottom < k->bottom[i] ? bottom : k->bottom[i]) -
+                      (top > k->top[i] ? top : k->top[i]);
+      const float intersection = w < 0.0f || h < 0.0f ? 0.0f : w * h;
+      hit |= intersection / (area + k->area[i] - intersection) > nms;
+    }
+    if (hit) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void keep(nms_kept_t *k, int index, const float *box) {
+  k->left[index] = box[0] - box[2] / 2;
+  k->top[index] = box[1] - box[3] / 2;
+  k->right[index] = box[0] + box[2] / 2;
+  k->bottom[index] = box[1] + box[3] / 2;
+  k->area[index] = box[2] * box[3];
+}
+
+// Suppress probabilities of class c, or of all classes if c is negative.
+static void suppress(const nms_detection2d_private_t *p, float *boxes, int c,
+                     nms_candidate_t *candidates, nms_kept_t *k) {
+  const int num_of_classes = p->channel - 5;
+  int num_of_candidates = 0;
+  int num_of_kept = 0;
+  int i, j; // Iterators
+
+  for (i = 0; i < p->num_of_boxes; i++) {
+    const float *box = boxes + i * p->channel;
+    int nonzero = c >= 0 && box[5 + c] != 0.0f;
+    for (j = 0; c < 0 && j < num_of_classes && !nonzero; j++) {
+      nonzero = box[5 + j] != 0.0f;
+    }
+    if (nonzero) {
+      candidates[num_of_candidates].score = c >= 0 ? box[5 + c] : box[4];
+      candidates[num_of_candidates].index = i;
+      num_of_candidates++;
+    }
+  }
+  qsort(candidates, num_of_candidates, sizeof(nms_candidate_t),
+        compare_candidates);
+
+  for (i = 0; i < num_of_candidates; i++) {
+    float *box = boxes + candidates[i].index * p->channel;
+    if (!overlaps_kept(k, num_of_kept, box, p->nms)) {
+      keep(k, num_of_kept++, box);
+    } else if (c >= 0) {
+      box[5 + c] = 0.0f;
+    } else {
+      memset(box + 5, 0, sizeof(float) * num_of_classes);
+    }
+  }
+}
+
+// Process samples in [begin, end).
+static void nms_detection2d_range(void *arg, int begin, int end) {
+  nms_detection2d_private_t *p = (nms_detection2d_private_t *)arg;
+  const int num_of_classes = p->channel - 5;
+  int b, i, c; // Iterators
+
+  for (b = begin; b < end; b++) {
+    float *boxes = p->boxes + (size_t)b * p->num_of_boxes * p->channel;
+    float *kept = p->kept + (size_t)b * 5 * p->num_of_boxes;
+    nms_kept_t k = {kept, kept + p->num_of_boxes, kept + 2 * p->num_of_boxes,
+                    kept + 3 * p->num_of_boxes, kept + 4 * p->num_of_boxes};
+    nms_candidate_t *candidates =
+        p->candidates + (size_t)b * p->num_of_boxes;
+
+    for (i = 0; i < p->num_of_boxes; i++) {
+      float *prob = boxes + i * p->channel + 5;
+      for (c = 0; c < num_of_classes; c++) {
+        prob[c] = prob[c] < p->thresh ? 0.0f : prob[c];
+      }
+    }
+    if (p->per_class) {
+      for (c = 0; c < num_of_classes; c++) {
+        suppress(p, boxes, c, candidates, &k);
+      }
+    } else {
+      suppress(p, boxes, -1, candidates, &k);
+    }
+  }
+}
+
+static void free_nms_detection2d_private(nms_detection2d_private_t *p) {
+  rt_free_func(p->candidates);
+  rt_free_func(p->kept);
+  rt_free_func(p->data);
+  rt_free_func(p);
+}
+
+// NmsDetection2d
+rt_function_error_t allocate_nms_detection2d_local_context(rt_function_t *f) {
+  nms_detection2d_local_context_t *context =
+      (nms_detection2d_local_context_t *)(f->local_context);
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *y = f->outputs[0];
+  if (x->shape.size != 3 || x->shape.data[2] < 5 ||
+      calc_shape_size(y->shape) != calc_shape_size(x->shape)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
+  nms_detection2d_private_t *p =
+      rt_malloc_func(sizeof(nms_detection2d_private_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  memset(p, 0, sizeof(nms_detection2d_private_t));
+  p->batch_size = x->shape.data[0];
+  p->num_of_boxes = x->shape.data[1];
+  p->channel = x->shape.data[2];
+  p->thresh = context->thresh;
+  p->nms = context->nms;
+  p->per_class = context->nms_per_class;
+  p->candidates = rt_malloc_func(sizeof(nms_candidate_t) * p->batch_size *
+                                 p->num_of_boxes);
+  p->kept = rt_malloc_func(sizeof(float) * 5 * p->batch_size * p->num_of_boxes);
+  if (p->candidates == 0 || p->kept == 0) {
+    free_nms_detection2d_private(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+
+  if (x->type == NN_DATA_TYPE_FLOAT && y->type == NN_DATA_TYPE_FLOAT) {
+#ifdef CONFIG_NMSDETECTION2D_FLOAT32
+    f->exec_func = exec_nms_detection2d;
+#endif /* CONFIG_NMSDETECTION2D_FLOAT32 */
+  } else {
+#ifdef CONFIG_NMSDETECTION2D_GENERIC
+    p->data = rt_malloc_func(sizeof(float) * calc_shape_size(x->shape));
+    if (p->data == 0) {
+      free_nms_detection2d_private(p);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    f->exec_func = exec_nms_detection2d_generic;
+#endif /* CONFIG_NMSDETECTION2D_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_nms_detection2d_local_context(rt_function_t *f) {
+  nms_detection2d_local_context_t *context =
+      (nms_detection2d_local_context_t *)(f->local_context);
+  if (context->data) {
+    free_nms_detection2d_private((nms_detection2d_private_t *)(context->data));
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+#ifdef CONFIG_NMSDETECTION2D_FLOAT32
+rt_function_error_t exec_nms_detection2d(rt_function_t *f) {
+  nms_detection2d_private_t *p =
+      (nms_detection2d_private_t
+           *)(((nms_detection2d_local_context_t *)(f->local_context))->data);
+  const float *x = (const float *)(f->inputs[0]->data);
+  p->boxes = (float *)(f->outputs[0]->data);
+  if (p->boxes != x) {
+    memcpy(p->boxes, x,
+           sizeof(float) * p->batch_size * p->num_of_boxes * p->channel);
+  }
+  rt_parallel_for(p->batch_size, p->num_of_boxes * p->channel,
+                  nms_detection2d_range, p);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_NMSDETECTION2D_FLOAT32 */
+
+#ifdef CONFIG_NMSDETECTION2D_GENERIC
+rt_function_error_t exec_nms_detection2d_generic(rt_function_t *f) {
+  nms_detection2d_private_t *p =
+      (nms_detection2d_private_t
+           *)(((nms_detection2d_local_context_t *)(f->local_context))->data);
+  const int size = p->batch_size * p->num_of_boxes * p->channel;
+  get_variable_block(f->inputs[0], 0, size, p->data);
+  p->boxes = p->data;
+  rt_parallel_for(p->batch_size, p->num_of_boxes * p->channel,
+                  nms_detection2d_range, p);
+  set_variable_block(f->outputs[0], 0, size, p->data);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_NMSDETECTION2D_GENERIC */
+
+#endif /* CONFIG_NMSDETECTION2D */
@@ -0,0 +1,269 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../utilities/accessor.h"
+#include "../../utilities/shape.h"
+#include "../../utilities/vector_math.h"
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef CONFIG_TOPKDATA
+
+// Each sample of size values after base_axis keeps its k largest values, in
+// descending order when reduced, or at their positions among zeros
+// otherwise. They are found by a heap of k indices whose root is the smallest
+// kept value, so that a sample takes O(size log k). Of equal values the
+// first one is larger.
+typedef struct {
+  int num_of_samples;
+  int size;
+  int k;
+  int abs;
+  int reduce;
+  int softmax;   // Input is logits of merged Softmax over each sample.
+  int *heap;     // Indices of k largest values of a sample.
+  float *sample; // Float copy of a sample for generic function.
+  rt_variable_setter set_output;
+} top_k_data_private_t;
+
+rt_function_error_t exec_top_k_data_generic(rt_function_t *f);
+
+// Value at index a is smaller than that at index b.
+static inline int is_smaller(const float *x, int abs, int a, int b) {
+  const float va = abs ? fabsf(x[a]) : x[a];
+  const float vb = abs ? fabsf(x[b]) : x[b];
+  return va < vb || (va == vb && a > b);
+}
+
+static void sift_down(const float *x, int abs, int *heap, int size, int i) {
+  for (;;) {
+    int smallest = i;
+    int l = 2 * i + 1;
+    int r = l + 1;
+    if (l < size && is_smaller(x, abs, heap[l], heap[smallest])) {
+      smallest = l;
+    }
+    if (r < size && is_smaller(x, abs, heap[r], heap[smallest])) {
+      smallest = r;
+    }
+    if (smallest == i) {
+      return;
+    }
+    int t = heap[i];
+    heap[i] = heap[smallest];
+    heap[smallest] = t;
+    i = smallest;
+  }
+}
+
+// Indices of k largest of size values into heap, largest first.
+static void find_top_k(const float *x, int size, int k, int abs, int *heap) {
+  int i; // Iterator
+
+  for (i = 0; i < k; i++) {
+    heap[i] = i;
+  }
+  for (i = k / 2 - 1; i >= 0; i--) {
+    sift_down(x, abs, heap, k, i);
+  }
+  for (i = k; i < size; i++) {
+    if (is_smaller(x, abs, heap[0], i)) {
+      heap[0] = i;
+      sift_down(x, abs, heap, k, 0);
+    }
+  }
+  // Smallest is moved to the end one by one.
+  for (i = k - 1; i > 0; i--) {
+    int t = heap[0];
+    heap[0] = heap[i];
+    heap[i] = t;
+    sift_down(x, abs, heap, i, 0);
+  }
+}
+
+// Values[r] of index heap[r] of sample x, or probability of Softmax of x if
+// it is merged.
+static void top_k_values(const top_k_data_private_t *p, const float *x,
+                         float *values) {
+  int r; // Iterator
+
+  if (!p->softmax) {
+    for (r = 0; r < p->k; r++) {
+      values[r] = x[p->heap[r]];
+    }
+    return;
+  }
+  // Same exp and sum as Softmax without fast math, only k values are
+  // divided.
+  const float max_input = vector_max(x, p->size);
+  const float exp_sum = vector_exp_sum(x, 0, p->size, max_input);
+  for (r = 0; r < p->k; r++) {
+    values[r] = x[p->heap[r]] - max_input;
+  }
+  vector_exp(values, values, p->k);
+  for (r = 0; r < p->k; r++) {
+    values[r] /= exp_sum;
+  }
+}
+
+// TopKData
+rt_function_error_t allocate_top_k_data_local_context(rt_function_t *f) {
+  top_k_data_local_context_t *context =
+      (top_k_data_local_context_t *)(f->local_context);
+  context->data = 0;
+  if (f->num_of_inputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_INPUTS;
+  }
+  if (f->num_of_outputs != 1) {
+    return RT_FUNCTION_ERROR_INVALID_NUM_OF_OUTPUTS;
+  }
+  rt_variable_t *x = f->inputs[0];
+  rt_variable_t *y = f->outputs[0];
+  if (context->base_axis < 0 || context->base_axis >= x->shape.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  const int num_of_samples = shape_product_of(x, 0, context->base_axis);
+  const int size = shape_product_of(x, context->base_axis, x->shape.size);
+  if (context->k < 1 || context->k > size ||
+      calc_shape_size(y->shape) !=
+          (context->reduce ? num_of_samples * context->k
+                           : num_of_samples * size)) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+
+  top_k_data_private_t *p = rt_malloc_func(sizeof(top_k_data_private_t));
+  if (p == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  p->num_of_samples = num_of_samples;
+  p->size = size;
+  p->k = context->k;
+  p->abs = context->abs;
+  p->reduce = context->reduce;
+  p->softmax = 0;
+  p->set_output = select_setter(y);
+  // Heap is followed by values of k indices.
+  p->heap = rt_malloc_func((sizeof(int) + sizeof(float)) * p->k);
+  p->sample = 0;
+  if (p->heap == 0) {
+    rt_free_func(p);
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+
+  if (x->type == NN_DATA_TYPE_FLOAT && y->type == NN_DATA_TYPE_FLOAT) {
+#ifdef CONFIG_TOPKDATA_FLOAT32
+    f->exec_func = exec_top_k_data;
+#endif /* CONFIG_TOPKDATA_FLOAT32 */
+  } else {
+#ifdef CONFIG_TOPKDATA_GENERIC
+    p->sample = rt_malloc_func(sizeof(float) * p->size);
+    if (p->sample == 0) {
+      rt_free_func(p->heap);
+      rt_free_func(p);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    f->exec_func = exec_top_k_data_generic;
+#endif /* CONFIG_TOPKDATA_GENERIC */
+  }
+  context->data = (void *)p;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t free_top_k_data_local_context(rt_function_t *f) {
+  top_k_data_local_context_t *context =
+      (top_k_data_local_context_t *)(f->local_context);
+  top_k_data_private_t *p = (top_k_data_private_t *)(context->data);
+  if (p) {
+    rt_free_func(p->heap);
+    rt_free_func(p->sample);
+    rt_free_func(p);
+    context->data = 0;
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t set_top_k_data_softmax(rt_function_t *f) {
+#ifdef CONFIG_TOPKDATA_FLOAT32
+  if (f->exec_func == exec_top_k_data) {
+    top_k_data_private_t *p =
+        (top_k_data_private_t
+             *)(((top_k_data_local_context_t *)(f->local_context))->data);
+    p->softmax = 1;
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+#endif /* CONFIG_TOPKDATA_FLOAT32 */
+  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+}
+
+#ifdef CONFIG_TOPKDATA_FLOAT32
+rt_function_error_t exec_top_k_data(rt_function_t *f) {
+  top_k_data_private_t *p =
+      (top_k_data_private_t
+           *)(((top_k_data_local_context_t *)(f->local_context))->data);
+  const float *x = (const float *)(f->inputs[0]->data);
+  float *y = (float *)(f->outputs[0]->data);
+  float *values = (float *)(p->heap + p->k);
+  int s, r; // Iterators
+
+  for (s = 0; s < p->num_of_samples; s++, x += p->size) {
+    find_top_k(x, p->size, p->k, p->abs && !p->softmax, p->heap);
+    top_k_values(p, x, values);
+    if (p->reduce) {
+      memcpy(y, values, sizeof(float) * p->k);
+      y += p->k;
+    } else {
+      memset(y, 0, sizeof(float) * p->size);
+      for (r = 0; r < p->k; r++) {
+        y[p->heap[r]] = values[r];
+      }
+      y += p->size;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_TOPKDATA_FLOAT32 */
+
+#ifdef CONFIG_TOPKDATA_GENERIC
+rt_function_error_t exec_top_k_data_generic(rt_function_t *f) {
+  top_k_data_private_t *p =
+      (top_k_data_private_t
+           *)(((top_k_data_local_context_t *)(f->local_context))->data);
+  rt_variable_t *y = f->outputs[0];
+  float *values = (float *)(p->heap + p->k);
+  int s, r; // Iterators
+
+  for (s = 0; s < p->num_of_samples; s++) {
+    get_variable_block(f->inputs[0], (nn_size_t)s * p->size, p->size,
+                       p->sample);
+    find_top_k(p->sample, p->size, p->k, p->abs, p->heap);
+    top_k_values(p, p->sample, values);
+    if (p->reduce) {
+      set_variable_block(y, (nn_size_t)s * p->k, p->k, values);
+    } else {
+      nn_size_t pos = (nn_size_t)s * p->size;
+      for (r = 0; r < p->size; r++) {
+        p->set_output(y, pos + r, 0.0f);
+      }
+      for (r = 0; r < p->k; r++) {
+        p->set_output(y, pos + p->heap[r], values[r]);
+      }
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+#endif /* CONFIG_TOPKDATA_GENERIC */
+
+#endif /* CONFIG_TOPKDATA */
@@ -18,54 +18,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 // Neural Network Layer
 ////////////////////////////////////////////////////////////////////////////////
-// RNN
-#ifdef CONFIG_RNN
-rt_function_error_t allocate_rnn_local_context(rt_function_t *f) {
-  f->exec_func = exec_rnn;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_rnn_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_rnn(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_RNN */
-
-// LSTM
-#ifdef CONFIG_LSTM
-rt_function_error_t allocate_lstm_local_context(rt_function_t *f) {
-  f->exec_func = exec_lstm;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_lstm_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_lstm(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_LSTM */
-
-// GRU
-#ifdef CONFIG_GRU
-rt_function_error_t allocate_gru_local_context(rt_function_t *f) {
-  f->exec_func = exec_lstm;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_gru_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_gru(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_GRU */
-
 // DepthwiseDeconvolution
 #ifdef CONFIG_DEPTHWISEDECONVOLUTION
 rt_function_error_t
@@ -84,60 +36,10 @@ rt_function_error_t exec_depthwise_deconvolution(rt_function_t *f) {
 }
 #endif /* CONFIG_DEPTHWISEDECONVOLUTION */
 
-// GlobalAveragePooling
-#ifdef CONFIG_GLOBALAVERAGEPOOLING
-rt_function_error_t
-allocate_global_average_pooling_local_context(rt_function_t *f) {
-  f->exec_func = exec_global_average_pooling;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t
-free_global_average_pooling_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_global_average_pooling(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_GLOBALAVERAGEPOOLING */
-
-// Embed
-#ifdef CONFIG_EMBED
-rt_function_error_t allocate_embed_local_context(rt_function_t *f) {
-  f->exec_func = exec_embed;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_embed_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_embed(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_EMBED */
-
 ////////////////////////////////////////////////////////////////////////////////
 // Neural Network Activation Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-// LogSoftmax
-#ifdef CONFIG_LOGSOFTMAX
-rt_function_error_t allocate_log_softmax_local_context(rt_function_t *f) {
-  f->exec_func = exec_log_softmax;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_log_softmax_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_log_softmax(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_LOGSOFTMAX */
-
 // ReLU6
 #ifdef CONFIG_RELU6
 rt_function_error_t allocate_relu6_local_context(rt_function_t *f) {
@@ -356,102 +258,6 @@ rt_function_error_t exec_clip_grad_by_norm(rt_function_t *f) {
 // Reduction
 ////////////////////////////////////////////////////////////////////////////////
 
-// Mean
-#ifdef CONFIG_MEAN
-rt_function_error_t allocate_mean_local_context(rt_function_t *f) {
-  f->exec_func = exec_mean;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_mean_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_mean(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_MEAN */
-
-// Max
-#ifdef CONFIG_MAX
-rt_function_error_t allocate_max_local_context(rt_function_t *f) {
-  f->exec_func = exec_max;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_max_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_max(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_MAX */
-
-// Min
-#ifdef CONFIG_MIN
-rt_function_error_t allocate_min_local_context(rt_function_t *f) {
-  f->exec_func = exec_min;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_min_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_min(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_MIN */
-
-// Prod
-#ifdef CONFIG_PROD
-rt_function_error_t allocate_prod_local_context(rt_function_t *f) {
-  f->exec_func = exec_prod;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_prod_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_prod(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_PROD */
-
-// ReduceSum
-#ifdef CONFIG_REDUCESUM
-rt_function_error_t allocate_reduce_sum_local_context(rt_function_t *f) {
-  f->exec_func = exec_reduce_sum;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_reduce_sum_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_reduce_sum(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_REDUCESUM */
-
-// ReduceMean
-#ifdef CONFIG_REDUCEMEAN
-rt_function_error_t allocate_reduce_mean_local_context(rt_function_t *f) {
-  f->exec_func = exec_reduce_mean;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_reduce_mean_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_reduce_mean(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_REDUCEMEAN */
-
 ////////////////////////////////////////////////////////////////////////////////
 // Arithmetic
 ////////////////////////////////////////////////////////////////////////////////
@@ -1117,54 +923,6 @@ rt_function_error_t exec_atan2(rt_function_t *f) {
 // Array Manipulation
 ////////////////////////////////////////////////////////////////////////////////
 
-// Broadcast
-#ifdef CONFIG_BROADCAST
-rt_function_error_t allocate_broadcast_local_context(rt_function_t *f) {
-  f->exec_func = exec_broadcast;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_broadcast_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_broadcast(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_BROADCAST */
-
-// BroadcastTo
-#ifdef CONFIG_BROADCASTTO
-rt_function_error_t allocate_broadcast_to_local_context(rt_function_t *f) {
-  f->exec_func = exec_broadcast_to;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_broadcast_to_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_broadcast_to(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_BROADCASTTO */
-
-// Tile
-#ifdef CONFIG_TILE
-rt_function_error_t allocate_tile_local_context(rt_function_t *f) {
-  f->exec_func = exec_tile;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_tile_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_tile(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_TILE */
-
 // Assign
 #ifdef CONFIG_ASSIGN
 rt_function_error_t allocate_assign_local_context(rt_function_t *f) {
@@ -1281,20 +1039,6 @@ rt_function_error_t exec_batch_det(rt_function_t *f) {
 // Stochasticity
 ////////////////////////////////////////////////////////////////////////////////
 
-// TopKData
-#ifdef CONFIG_TOPKDATA
-rt_function_error_t allocate_top_k_data_local_context(rt_function_t *f) {
-  f->exec_func = exec_top_k_data;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-rt_function_error_t free_top_k_data_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-rt_function_error_t exec_top_k_data(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_TOPKDATA */
-
 // TopKGrad
 #ifdef CONFIG_TOPKGRAD
 rt_function_error_t allocate_top_k_grad_local_context(rt_function_t *f) {
@@ -1702,22 +1446,6 @@ rt_function_error_t exec_prune(rt_function_t *f) {
 // Spectral Operation
 ////////////////////////////////////////////////////////////////////////////////
 
-// Interpolate
-#ifdef CONFIG_INTERPOLATE
-rt_function_error_t allocate_interpolate_local_context(rt_function_t *f) {
-  f->exec_func = exec_interpolate;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_interpolate_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_interpolate(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_INTERPOLATE */
-
 // FFT
 #ifdef CONFIG_FFT
 rt_function_error_t allocate_fft_local_context(rt_function_t *f) {
@@ -1856,27 +1584,11 @@ rt_function_error_t exec_sink(rt_function_t *f) {
 }
 #endif /* CONFIG_SINK */
 
-// NmsDetection2d
-#ifdef CONFIG_NMSDETECTION2D
-rt_function_error_t allocate_nms_detection2d_local_context(rt_function_t *f) {
-  f->exec_func = exec_nms_detection2d;
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t free_nms_detection2d_local_context(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-
-rt_function_error_t exec_nms_detection2d(rt_function_t *f) {
-  return RT_FUNCTION_ERROR_UNIMPLEMENTED;
-}
-#endif /* CONFIG_NMSDETECTION2D */
-
 // MaxPoolingBackward
 #ifdef CONFIG_MAXPOOLINGBACKWARD
 rt_function_error_t
 allocate_max_pooling_backward_local_context(rt_function_t *f) {
-  f->exec_func = exec_nms_detection2d;
+  f->exec_func = exec_max_pooling_backward;
   return RT_FUNCTION_ERROR_UNIMPLEMENTED;
 }
 
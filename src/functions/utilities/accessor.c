@@ -12,9 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "accessor.h"
+#include "fixed.h"
+#include "half.h"
+#include "neon.h"
 #include "shape.h"
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACCESSOR_SSE2
+#include <emmintrin.h>
+#endif
+
 float get_float(rt_variable_t *variable, nn_size_t pos) {
   return GET_FLOAT(variable, pos);
 }
@@ -34,6 +43,35 @@ float get_sign(rt_variable_t *variable, nn_size_t pos) {
   return -1;
 }
 
+float get_float16(rt_variable_t *variable, nn_size_t pos) {
+  return float16_to_float(*((uint16_t *)(variable->data) + pos));
+}
+
+float get_bfloat16(rt_variable_t *variable, nn_size_t pos) {
+  return bfloat16_to_float(*((uint16_t *)(variable->data) + pos));
+}
+
+// Channel of element at pos of variable with per channel quantization.
+static inline int quantized_channel(const rt_quantization_t *q,
+                                    nn_size_t pos) {
+  return (int)((pos / q->inner) % q->channels);
+}
+
+static inline int32_t quantized_zero_point(const rt_quantization_t *q,
+                                           int channel) {
+  return q->zero_points ? q->zero_points[channel] : 0;
+}
+
+float get_quantized(rt_variable_t *variable, nn_size_t pos) {
+  const rt_quantization_t *q = variable->quantization;
+  int channel = quantized_channel(q, pos);
+  int32_t value = variable->type == NN_DATA_TYPE_INT8
+                      ? *((int8_t *)(variable->data) + pos)
+                      : *((int16_t *)(variable->data) + pos);
+  return q->scales[channel] *
+         (float)(value - quantized_zero_point(q, channel));
+}
+
 void set_float(rt_variable_t *variable, nn_size_t pos, float value) {
   *((float *)(variable->data) + pos) = value;
 }
@@ -68,20 +106,436 @@ void set_sign(rt_variable_t *variable, nn_size_t pos, float value) {
   }
 }
 
+void set_float16(rt_variable_t *variable, nn_size_t pos, float value) {
+  *((uint16_t *)(variable->data) + pos) = float_to_float16(value);
+}
+
+void set_bfloat16(rt_variable_t *variable, nn_size_t pos, float value) {
+  *((uint16_t *)(variable->data) + pos) = float_to_bfloat16(value);
+}
+
+// Same as set_int8() and set_int16(), value / scale is clamped and truncated
+// toward 0 after zero point is added.
+void set_quantized(rt_variable_t *variable, nn_size_t pos, float value) {
+  const rt_quantization_t *q = variable->quantization;
+  int channel = quantized_channel(q, pos);
+  float min = variable->type == NN_DATA_TYPE_INT8 ? INT8_MIN : INT16_MIN;
+  float max = variable->type == NN_DATA_TYPE_INT8 ? INT8_MAX : INT16_MAX;
+  value = value / q->scales[channel] + (float)quantized_zero_point(q, channel);
+  value = value >= max ? max : value <= min ? min : value;
+  if (variable->type == NN_DATA_TYPE_INT8) {
+    *((int8_t *)(variable->data) + pos) = (int8_t)value;
+  } else {
+    *((int16_t *)(variable->data) + pos) = (int16_t)value;
+  }
+}
+
+static int is_quantized(const rt_variable_t *variable) {
+  return variable->quantization != 0 &&
+         (variable->type == NN_DATA_TYPE_INT8 ||
+          variable->type == NN_DATA_TYPE_INT16);
+}
+
+int has_row_scales(const rt_variable_t *variable, int row_size) {
+  const rt_quantization_t *q = variable->quantization;
+  int i; // Iterator
+  if (!is_quantized(variable)) {
+    return 1;
+  }
+  if (row_size <= 0 || q->inner % row_size != 0) {
+    return 0;
+  }
+  for (i = 0; q->zero_points && i < q->channels; i++) {
+    if (q->zero_points[i] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+float get_row_scale(const rt_variable_t *variable, int row, int row_size) {
+  if (!is_quantized(variable)) {
+    return variable->coefficient;
+  }
+  return variable->quantization->scales[quantized_channel(
+      variable->quantization, (nn_size_t)row * row_size)];
+}
+
 static rt_variable_getter getter_list[END_OF_NN_DATA_TYPE] = {
-    get_float, get_int16, get_int8, get_sign};
+    get_float, get_int16, get_int8, get_sign, get_float16, get_bfloat16};
 
 rt_variable_getter select_getter(rt_variable_t *variable) {
+  if (is_quantized(variable)) {
+    return get_quantized;
+  }
   return getter_list[variable->type];
 }
 
 static rt_variable_setter setter_list[END_OF_NN_DATA_TYPE] = {
-    set_float, set_int16, set_int8, set_sign};
+    set_float, set_int16, set_int8, set_sign, set_float16, set_bfloat16};
 
 rt_variable_setter select_setter(rt_variable_t *variable) {
+  if (is_quantized(variable)) {
+    return set_quantized;
+  }
   return setter_list[variable->type];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Block conversion. Fixed point values are converted 8 at a time with SSE2 or
+// NEON, and SIGN values a word at a time. Results are same as getters and
+// setters.
+
+static void get_int8_block(const int8_t *src, float coefficient, int size,
+                           float *values) {
+  int i = 0;
+#if defined(ACCESSOR_SSE2)
+  const __m128 c = _mm_set1_ps(coefficient);
+  for (; i + 8 <= size; i += 8) {
+    __m128i v = _mm_loadl_epi64((const __m128i *)(src + i));
+    v = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+    _mm_storeu_ps(values + i,
+                  _mm_mul_ps(c, _mm_cvtepi32_ps(_mm_srai_epi32(
+                                    _mm_unpacklo_epi16(v, v), 16))));
+    _mm_storeu_ps(values + i + 4,
+                  _mm_mul_ps(c, _mm_cvtepi32_ps(_mm_srai_epi32(
+                                    _mm_unpackhi_epi16(v, v), 16))));
+  }
+#elif defined(NNABLART_NEON)
+  const float32x4_t c = vdupq_n_f32(coefficient);
+  for (; i + 8 <= size; i += 8) {
+    int16x8_t v = vmovl_s8(vld1_s8(src + i));
+    vst1q_f32(values + i,
+              vmulq_f32(c, vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)))));
+    vst1q_f32(values + i + 4,
+              vmulq_f32(c, vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)))));
+  }
+#endif
+  for (; i < size; i++) {
+    values[i] = coefficient * (float)src[i];
+  }
+}
+
+static void get_int16_block(const int16_t *src, float coefficient, int size,
+                            float *values) {
+  int i = 0;
+#if defined(ACCESSOR_SSE2)
+  const __m128 c = _mm_set1_ps(coefficient);
+  for (; i + 8 <= size; i += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+    _mm_storeu_ps(values + i,
+                  _mm_mul_ps(c, _mm_cvtepi32_ps(_mm_srai_epi32(
+                                    _mm_unpacklo_epi16(v, v), 16))));
+    _mm_storeu_ps(values + i + 4,
+                  _mm_mul_ps(c, _mm_cvtepi32_ps(_mm_srai_epi32(
+                                    _mm_unpackhi_epi16(v, v), 16))));
+  }
+#elif defined(NNABLART_NEON)
+  const float32x4_t c = vdupq_n_f32(coefficient);
+  for (; i + 8 <= size; i += 8) {
+    int16x8_t v = vld1q_s16(src + i);
+    vst1q_f32(values + i,
+              vmulq_f32(c, vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)))));
+    vst1q_f32(values + i + 4,
+              vmulq_f32(c, vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)))));
+  }
+#endif
+  for (; i < size; i++) {
+    values[i] = coefficient * (float)src[i];
+  }
+}
+
+static void get_sign_block(const uint32_t *words, nn_size_t pos, int size,
+                           float *values) {
+  int i = 0;
+  while (i < size) {
+    uint32_t word = words[(pos + i) / 32] >> ((pos + i) % 32);
+    int n = 32 - (int)((pos + i) % 32);
+    if (n > size - i) {
+      n = size - i;
+    }
+    for (; n > 0; n--, i++, word >>= 1) {
+      values[i] = (word & 1) ? 1.0f : -1.0f;
+    }
+  }
+}
+
+// Same as setters, value / coefficient is clamped and truncated toward 0.
+#define SET_FIXED_BLOCK(xType, xMin, xMax)                                     \
+  for (; i < size; i++) {                                                      \
+    float value = values[i] / coefficient;                                     \
+    if (value >= xMax) {                                                       \
+      dst[i] = xMax;                                                           \
+    } else if (value <= xMin) {                                                \
+      dst[i] = xMin;                                                           \
+    } else {                                                                   \
+      dst[i] = (xType)value;                                                   \
+    }                                                                          \
+  }
+
+// NEON division is only available on AArch64.
+#if defined(ACCESSOR_SSE2)
+static inline __m128i clamp_and_truncate_sse2(const float *values, __m128 c,
+                                              __m128 lower, __m128 upper) {
+  __m128 v = _mm_div_ps(_mm_loadu_ps(values), c);
+  return _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(v, upper), lower));
+}
+#elif defined(NNABLART_NEON) && defined(__aarch64__)
+static inline int32x4_t clamp_and_truncate_neon(const float *values,
+                                                float32x4_t c,
+                                                float32x4_t lower,
+                                                float32x4_t upper) {
+  float32x4_t v = vdivq_f32(vld1q_f32(values), c);
+  return vcvtq_s32_f32(vmaxq_f32(vminq_f32(v, upper), lower));
+}
+#endif
+
+static void set_int8_block(int8_t *dst, float coefficient, int size,
+                           const float *values) {
+  int i = 0;
+#if defined(ACCESSOR_SSE2)
+  const __m128 c = _mm_set1_ps(coefficient);
+  const __m128 lower = _mm_set1_ps(INT8_MIN);
+  const __m128 upper = _mm_set1_ps(INT8_MAX);
+  for (; i + 8 <= size; i += 8) {
+    __m128i w = _mm_packs_epi32(
+        clamp_and_truncate_sse2(values + i, c, lower, upper),
+        clamp_and_truncate_sse2(values + i + 4, c, lower, upper));
+    _mm_storel_epi64((__m128i *)(dst + i), _mm_packs_epi16(w, w));
+  }
+#elif defined(NNABLART_NEON) && defined(__aarch64__)
+  const float32x4_t c = vdupq_n_f32(coefficient);
+  const float32x4_t lower = vdupq_n_f32(INT8_MIN);
+  const float32x4_t upper = vdupq_n_f32(INT8_MAX);
+  for (; i + 8 <= size; i += 8) {
+    int16x8_t w = vcombine_s16(
+        vqmovn_s32(clamp_and_truncate_neon(values + i, c, lower, upper)),
+        vqmovn_s32(clamp_and_truncate_neon(values + i + 4, c, lower, upper)));
+    vst1_s8(dst + i, vqmovn_s16(w));
+  }
+#endif
+  SET_FIXED_BLOCK(int8_t, INT8_MIN, INT8_MAX);
+}
+
+static void set_int16_block(int16_t *dst, float coefficient, int size,
+                            const float *values) {
+  int i = 0;
+#if defined(ACCESSOR_SSE2)
+  const __m128 c = _mm_set1_ps(coefficient);
+  const __m128 lower = _mm_set1_ps(INT16_MIN);
+  const __m128 upper = _mm_set1_ps(INT16_MAX);
+  for (; i + 8 <= size; i += 8) {
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm_packs_epi32(
+                         clamp_and_truncate_sse2(values + i, c, lower, upper),
+                         clamp_and_truncate_sse2(values + i + 4, c, lower,
+                                                 upper)));
+  }
+#elif defined(NNABLART_NEON) && defined(__aarch64__)
+  const float32x4_t c = vdupq_n_f32(coefficient);
+  const float32x4_t lower = vdupq_n_f32(INT16_MIN);
+  const float32x4_t upper = vdupq_n_f32(INT16_MAX);
+  for (; i + 8 <= size; i += 8) {
+    vst1q_s16(dst + i,
+              vcombine_s16(vqmovn_s32(clamp_and_truncate_neon(values + i, c,
+                                                              lower, upper)),
+                           vqmovn_s32(clamp_and_truncate_neon(
+                               values + i + 4, c, lower, upper))));
+  }
+#endif
+  SET_FIXED_BLOCK(int16_t, INT16_MIN, INT16_MAX);
+}
+
+static void set_sign_block(uint32_t *words, nn_size_t pos, int size,
+                           const float *values) {
+  int i = 0;
+  while (i < size) {
+    uint32_t *word = words + (pos + i) / 32;
+    int shift = (int)((pos + i) % 32);
+    int n = 32 - shift;
+    uint32_t bits = 0;
+    uint32_t mask;
+    int k; // Iterator
+    if (n > size - i) {
+      n = size - i;
+    }
+    for (k = 0; k < n; k++) {
+      bits |= (uint32_t)(values[i + k] >= 0) << k;
+    }
+    mask = (n == 32) ? 0xffffffffu : ((1u << n) - 1);
+    *word = (*word & ~(mask << shift)) | (bits << shift);
+    i += n;
+  }
+}
+
+// Variables with per channel quantization are converted in runs of elements
+// of one channel. Runs without zero point use the same blocks as fp_pos.
+static void get_quantized_block(const rt_variable_t *variable, nn_size_t pos,
+                                int size, float *values) {
+  const rt_quantization_t *q = variable->quantization;
+  int i = 0;
+  while (i < size) {
+    int channel = quantized_channel(q, pos + i);
+    int32_t zero_point = quantized_zero_point(q, channel);
+    float scale = q->scales[channel];
+    int n = q->inner - (int)((pos + i) % q->inner);
+    int k; // Iterator
+    if (n > size - i) {
+      n = size - i;
+    }
+    if (variable->type == NN_DATA_TYPE_INT8) {
+      const int8_t *src = (const int8_t *)(variable->data) + pos + i;
+      if (zero_point == 0) {
+        get_int8_block(src, scale, n, values + i);
+      } else {
+        for (k = 0; k < n; k++) {
+          values[i + k] = scale * (float)(src[k] - zero_point);
+        }
+      }
+    } else {
+      const int16_t *src = (const int16_t *)(variable->data) + pos + i;
+      if (zero_point == 0) {
+        get_int16_block(src, scale, n, values + i);
+      } else {
+        for (k = 0; k < n; k++) {
+          values[i + k] = scale * (float)(src[k] - zero_point);
+        }
+      }
+    }
+    i += n;
+  }
+}
+
+static void set_quantized_block(rt_variable_t *variable, nn_size_t pos,
+                                int size, const float *values) {
+  const rt_quantization_t *q = variable->quantization;
+  int i = 0;
+  while (i < size) {
+    int channel = quantized_channel(q, pos + i);
+    int n = q->inner - (int)((pos + i) % q->inner);
+    int k; // Iterator
+    if (n > size - i) {
+      n = size - i;
+    }
+    if (quantized_zero_point(q, channel) != 0) {
+      for (k = 0; k < n; k++) {
+        set_quantized(variable, pos + i + k, values[i + k]);
+      }
+    } else if (variable->type == NN_DATA_TYPE_INT8) {
+      set_int8_block((int8_t *)(variable->data) + pos + i,
+                     q->scales[channel], n, values + i);
+    } else {
+      set_int16_block((int16_t *)(variable->data) + pos + i,
+                      q->scales[channel], n, values + i);
+    }
+    i += n;
+  }
+}
+
+void get_variable_block(const rt_variable_t *variable, nn_size_t pos,
+                        int size, float *values) {
+  const uint16_t *half = (const uint16_t *)(variable->data) + pos;
+  int i; // Iterator
+  if (is_quantized(variable)) {
+    get_quantized_block(variable, pos, size, values);
+    return;
+  }
+  switch (variable->type) {
+  case NN_DATA_TYPE_FLOAT:
+    memcpy(values, (const float *)(variable->data) + pos,
+           sizeof(float) * size);
+    break;
+  case NN_DATA_TYPE_INT16:
+    get_int16_block((const int16_t *)(variable->data) + pos,
+                    variable->coefficient, size, values);
+    break;
+  case NN_DATA_TYPE_INT8:
+    get_int8_block((const int8_t *)(variable->data) + pos,
+                   variable->coefficient, size, values);
+    break;
+  case NN_DATA_TYPE_SIGN:
+    get_sign_block((const uint32_t *)(variable->data), pos, size, values);
+    break;
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    for (i = 0; i < size; i++) {
+      values[i] = half_to_float(variable->type, half[i]);
+    }
+    break;
+  default:; // Do nothing
+  }
+}
+
+void set_variable_block(rt_variable_t *variable, nn_size_t pos, int size,
+                        const float *values) {
+  uint16_t *half = (uint16_t *)(variable->data) + pos;
+  int i; // Iterator
+  if (is_quantized(variable)) {
+    set_quantized_block(variable, pos, size, values);
+    return;
+  }
+  switch (variable->type) {
+  case NN_DATA_TYPE_FLOAT:
+    memmove((float *)(variable->data) + pos, values, sizeof(float) * size);
+    break;
+  case NN_DATA_TYPE_INT16:
+    set_int16_block((int16_t *)(variable->data) + pos, variable->coefficient,
+                    size, values);
+    break;
+  case NN_DATA_TYPE_INT8:
+    set_int8_block((int8_t *)(variable->data) + pos, variable->coefficient,
+                   size, values);
+    break;
+  case NN_DATA_TYPE_SIGN:
+    set_sign_block((uint32_t *)(variable->data), pos, size, values);
+    break;
+  case NN_DATA_TYPE_FLOAT16:
+    for (i = 0; i < size; i++) {
+      half[i] = float_to_float16(values[i]);
+    }
+    break;
+  case NN_DATA_TYPE_BFLOAT16:
+    for (i = 0; i < size; i++) {
+      half[i] = float_to_bfloat16(values[i]);
+    }
+    break;
+  default:; // Do nothing
+  }
+}
+
+void copy_variable_block(const rt_variable_t *src, nn_size_t src_pos,
+                         rt_variable_t *dst, nn_size_t dst_pos, int size) {
+  float block[ACCESSOR_BLOCK_SIZE];
+  int begin; // Iterator
+  if (is_fixed_point(src) && is_fixed_point(dst)) {
+    copy_fixed_block(src, src_pos, dst, dst_pos, size);
+    return;
+  }
+  for (begin = 0; begin < size; begin += ACCESSOR_BLOCK_SIZE) {
+    int n = size - begin;
+    if (n > ACCESSOR_BLOCK_SIZE) {
+      n = ACCESSOR_BLOCK_SIZE;
+    }
+    get_variable_block(src, src_pos + begin, n, block);
+    set_variable_block(dst, dst_pos + begin, n, block);
+  }
+}
+
+size_t get_element_size(nn_data_type_t type) {
+  switch (type) {
+  case NN_DATA_TYPE_FLOAT:
+    return sizeof(float);
+  case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return sizeof(int16_t);
+  case NN_DATA_TYPE_INT8:
+    return sizeof(int8_t);
+  default:
+    return 0;
+  }
+}
+
 void fill_variable_with(rt_variable_t *variable, int8_t value) {
   int size = calc_shape_size(variable->shape);
 
@@ -91,6 +545,8 @@ void fill_variable_with(rt_variable_t *variable, int8_t value) {
     break;
 
   case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
     size *= sizeof(uint16_t);
     break;
 
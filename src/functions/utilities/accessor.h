@@ -30,18 +30,76 @@ float get_float(rt_variable_t *variable, nn_size_t pos);
 float get_int16(rt_variable_t *variable, nn_size_t pos);
 float get_int8(rt_variable_t *variable, nn_size_t pos);
 float get_sign(rt_variable_t *variable, nn_size_t pos);
+float get_float16(rt_variable_t *variable, nn_size_t pos);
+float get_bfloat16(rt_variable_t *variable, nn_size_t pos);
+float get_quantized(rt_variable_t *variable, nn_size_t pos);
 
 void set_float(rt_variable_t *variable, nn_size_t pos, float value);
 void set_int16(rt_variable_t *variable, nn_size_t pos, float value);
 void set_int8(rt_variable_t *variable, nn_size_t pos, float value);
 void set_sign(rt_variable_t *variable, nn_size_t pos, float value);
+void set_float16(rt_variable_t *variable, nn_size_t pos, float value);
+void set_bfloat16(rt_variable_t *variable, nn_size_t pos, float value);
+void set_quantized(rt_variable_t *variable, nn_size_t pos, float value);
 
+/// Getters and setters of INT8 and INT16 variables with per channel
+/// quantization are get_quantized() and set_quantized(), GET_INT8() and
+/// GET_INT16() are only for variables without it.
 typedef float (*rt_variable_getter)(rt_variable_t *, nn_size_t);
 rt_variable_getter select_getter(rt_variable_t *variable);
 
 typedef void (*rt_variable_setter)(rt_variable_t *, nn_size_t, float);
 rt_variable_setter select_setter(rt_variable_t *variable);
 
+/// Each row of row_size elements of variable has one scale without zero
+/// point, i.e. variable has no per channel quantization or its channels are
+/// made of whole rows and have no zero point.
+int has_row_scales(const rt_variable_t *variable, int row_size);
+
+/// Scale of row of variable which has_row_scales().
+float get_row_scale(const rt_variable_t *variable, int row, int row_size);
+
+/// Number of elements which generic functions convert at a time.
+#define ACCESSOR_BLOCK_SIZE (256)
+
+/// Read size elements of variable from pos as float values, same as getter.
+void get_variable_block(const rt_variable_t *variable, nn_size_t pos,
+                        int size, float *values);
+
+/// Write size float values to variable from pos, same as setter.
+void set_variable_block(rt_variable_t *variable, nn_size_t pos, int size,
+                        const float *values);
+
+/// Copy size elements of src from src_pos into dst from dst_pos, converting
+/// ACCESSOR_BLOCK_SIZE elements at a time, or integers directly between fixed
+/// point variables. Areas must not overlap.
+void copy_variable_block(const rt_variable_t *src, nn_size_t src_pos,
+                         rt_variable_t *dst, nn_size_t dst_pos, int size);
+
+/// Bytes of an element of type, or 0 for SIGN whose elements are bits.
+size_t get_element_size(nn_data_type_t type);
+
+/// Calculate y = (xExpression) of x for each element of xInput into xOutput,
+/// converting ACCESSOR_BLOCK_SIZE elements at a time. xInput and xOutput may
+/// be same variable.
+#define FOR_EACH_BLOCK(xInput, xOutput, xSize, xExpression)                    \
+  do {                                                                         \
+    float block_[ACCESSOR_BLOCK_SIZE];                                         \
+    int begin_, k_;                                                            \
+    for (begin_ = 0; begin_ < (xSize); begin_ += ACCESSOR_BLOCK_SIZE) {        \
+      int n_ = (xSize)-begin_;                                                 \
+      if (n_ > ACCESSOR_BLOCK_SIZE) {                                          \
+        n_ = ACCESSOR_BLOCK_SIZE;                                              \
+      }                                                                        \
+      get_variable_block((xInput), begin_, n_, block_);                        \
+      for (k_ = 0; k_ < n_; k_++) {                                            \
+        const float x = block_[k_];                                            \
+        block_[k_] = (xExpression);                                            \
+      }                                                                        \
+      set_variable_block((xOutput), begin_, n_, block_);                       \
+    }                                                                          \
+  } while (0)
+
 void fill_variable_with(rt_variable_t *variable, int8_t value);
 
 #endif // H_ACCESSOR_H_171210064532_
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+
+#include "vector_math.h"
+
+#include <math.h>
+
+// Elements calculated by all operations before next elements. Values of one
+// block stay in L1 cache between operations.
+#define ELEMENTWISE_BLOCK_SIZE (1024)
+
+typedef struct {
+  const float *x;
+  float *y;
+  int size;
+  const rt_elementwise_op_t *ops;
+  int num_of_ops;
+} elementwise_chain_t;
+
+// Operation with a which is scalar or element of operand.
+#define ELEMENTWISE_LOOP(expression)                                          \
+  if (op->operand) {                                                          \
+    const float *a = (const float *)op->operand->data + offset;               \
+    for (i = 0; i < size; i++) {                                              \
+      const float v = x[i];                                                   \
+      const float w = a[i];                                                   \
+      y[i] = (expression);                                                    \
+    }                                                                         \
+  } else {                                                                    \
+    const float w = op->alpha;                                                \
+    for (i = 0; i < size; i++) {                                              \
+      const float v = x[i];                                                   \
+      y[i] = (expression);                                                    \
+    }                                                                         \
+  }
+
+// Unary operation.
+#define ELEMENTWISE_UNARY_LOOP(expression)                                    \
+  for (i = 0; i < size; i++) {                                                \
+    const float v = x[i];                                                     \
+    y[i] = (expression);                                                      \
+  }
+
+// Expressions are same as those of functions, so results do not change by
+// fusion.
+static void calc_op(const rt_elementwise_op_t *op, const float *x, float *y,
+                    int offset, int size) {
+  int i; // Iterator
+  switch (op->type) {
+  case RT_ELEMENTWISE_ADD:
+    ELEMENTWISE_LOOP(v + w);
+    break;
+  case RT_ELEMENTWISE_SUB:
+    ELEMENTWISE_LOOP(v - w);
+    break;
+  case RT_ELEMENTWISE_RSUB:
+    ELEMENTWISE_LOOP(w - v);
+    break;
+  case RT_ELEMENTWISE_MUL:
+    ELEMENTWISE_LOOP(v * w);
+    break;
+  case RT_ELEMENTWISE_DIV:
+    ELEMENTWISE_LOOP(v / w);
+    break;
+  case RT_ELEMENTWISE_RDIV:
+    ELEMENTWISE_LOOP(w / v);
+    break;
+  case RT_ELEMENTWISE_POW:
+    ELEMENTWISE_LOOP(powf(v, w));
+    break;
+  case RT_ELEMENTWISE_RPOW:
+    ELEMENTWISE_LOOP(powf(w, v));
+    break;
+  case RT_ELEMENTWISE_MAXIMUM:
+    ELEMENTWISE_LOOP(v > w ? v : w);
+    break;
+  case RT_ELEMENTWISE_MINIMUM:
+    ELEMENTWISE_LOOP(v < w ? v : w);
+    break;
+  case RT_ELEMENTWISE_IDENTITY:
+    ELEMENTWISE_UNARY_LOOP(v);
+    break;
+  case RT_ELEMENTWISE_ABS:
+    ELEMENTWISE_UNARY_LOOP(fabsf(v));
+    break;
+  case RT_ELEMENTWISE_EXP:
+    vector_exp(x, y, size);
+    break;
+  case RT_ELEMENTWISE_LOG:
+    vector_log(x, y, size);
+    break;
+  case RT_ELEMENTWISE_RELU:
+    ELEMENTWISE_UNARY_LOOP(v > 0.0f ? v : 0.0f);
+    break;
+  case RT_ELEMENTWISE_LEAKY_RELU:
+    ELEMENTWISE_UNARY_LOOP(v > 0.0f ? v : v * op->alpha);
+    break;
+  case RT_ELEMENTWISE_RELU6:
+    ELEMENTWISE_UNARY_LOOP(v > 0.0f ? (v < 6.0f ? v : 6.0f) : 0.0f);
+    break;
+  case RT_ELEMENTWISE_SIGMOID:
+    vector_sigmoid(x, y, size);
+    break;
+  case RT_ELEMENTWISE_TANH:
+    vector_tanh(x, y, size);
+    break;
+  case RT_ELEMENTWISE_SWISH:
+    vector_swish(x, y, size);
+    break;
+  case RT_ELEMENTWISE_ELU:
+    vector_elu(x, y, size, op->alpha, op->scale);
+    break;
+  default:
+    break;
+  }
+}
+
+static void calc_blocks(void *arg, int begin, int end) {
+  const elementwise_chain_t *chain = (const elementwise_chain_t *)arg;
+  int b, k; // Iterator
+  for (b = begin; b < end; b++) {
+    int offset = b * ELEMENTWISE_BLOCK_SIZE;
+    int size = chain->size - offset;
+    float *y = chain->y + offset;
+    if (size > ELEMENTWISE_BLOCK_SIZE) {
+      size = ELEMENTWISE_BLOCK_SIZE;
+    }
+    // First operation reads x, and others update y in place.
+    calc_op(chain->ops, chain->x + offset, y, offset, size);
+    for (k = 1; k < chain->num_of_ops; k++) {
+      calc_op(chain->ops + k, y, y, offset, size);
+    }
+  }
+}
+
+void calc_elementwise_chain(const float *x, float *y, int size,
+                            const rt_elementwise_op_t *ops, int num_of_ops) {
+  elementwise_chain_t chain;
+  chain.x = x;
+  chain.y = y;
+  chain.size = size;
+  chain.ops = ops;
+  chain.num_of_ops = num_of_ops;
+  rt_parallel_for((size + ELEMENTWISE_BLOCK_SIZE - 1) / ELEMENTWISE_BLOCK_SIZE,
+                  ELEMENTWISE_BLOCK_SIZE * num_of_ops, calc_blocks, &chain);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "epilogue.h"
+#include "vector_math.h"
+
+void apply_epilogue(const rt_epilogue_t *epilogue, float *data, int size) {
+  int i; // Iterator
+  switch (epilogue->type) {
+  case RT_EPILOGUE_RELU:
+    for (i = 0; i < size; i++) {
+      data[i] = data[i] > 0.0f ? data[i] : 0.0f;
+    }
+    break;
+  case RT_EPILOGUE_LEAKY_RELU:
+    for (i = 0; i < size; i++) {
+      data[i] = data[i] > 0.0f ? data[i] : data[i] * epilogue->alpha;
+    }
+    break;
+  case RT_EPILOGUE_RELU6:
+    for (i = 0; i < size; i++) {
+      data[i] = data[i] > 0.0f ? (data[i] < 6.0f ? data[i] : 6.0f) : 0.0f;
+    }
+    break;
+  case RT_EPILOGUE_SWISH:
+    vector_swish(data, data, size);
+    break;
+  case RT_EPILOGUE_SIGMOID:
+    vector_sigmoid(data, data, size);
+    break;
+  case RT_EPILOGUE_TANH:
+    vector_tanh(data, data, size);
+    break;
+  default:
+    break;
+  }
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_EPILOGUE_H_181015120000_
+#define H_EPILOGUE_H_181015120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup EpilogueFunction Epilogue Function
+/// @{
+
+/// Apply activation of epilogue to size values from data in place.
+void apply_epilogue(const rt_epilogue_t *epilogue, float *data, int size);
+
+/// @}
+
+#endif // H_EPILOGUE_H_181015120000_
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fixed.h"
+#include "accessor.h"
+
+#include <string.h>
+
+int is_fixed_point(const rt_variable_t *variable) {
+  return (variable->type == NN_DATA_TYPE_INT8 ||
+          variable->type == NN_DATA_TYPE_INT16) &&
+         variable->quantization == 0;
+}
+
+// Shift value from fixed point position by shift to the right, rounding
+// toward 0, or to the left. Results out of [min, max] are saturated.
+static inline int64_t shift_fixed(int64_t value, int shift, int64_t min,
+                                  int64_t max) {
+  if (shift > 0) {
+    value = (value + (value < 0 ? ((int64_t)1 << shift) - 1 : 0)) >> shift;
+  } else if (shift < 0) {
+    if (value > (max >> -shift)) {
+      return max;
+    }
+    if (value < (min >> -shift)) {
+      return min;
+    }
+    value *= (int64_t)1 << -shift;
+  }
+  return value > max ? max : value < min ? min : value;
+}
+
+void set_fixed(rt_variable_t *variable, nn_size_t pos, int64_t value,
+               int fp_pos) {
+  if (variable->type == NN_DATA_TYPE_INT8) {
+    *((int8_t *)(variable->data) + pos) = (int8_t)shift_fixed(
+        value, fp_pos - (int)variable->fp_pos, INT8_MIN, INT8_MAX);
+  } else {
+    *((int16_t *)(variable->data) + pos) = (int16_t)shift_fixed(
+        value, fp_pos - (int)variable->fp_pos, INT16_MIN, INT16_MAX);
+  }
+}
+
+void copy_fixed_block(const rt_variable_t *src, nn_size_t src_pos,
+                      rt_variable_t *dst, nn_size_t dst_pos, int size) {
+  int i; // Iterator
+  if (src->type == dst->type && src->fp_pos == dst->fp_pos) {
+    size_t element_size = get_element_size(src->type);
+    memcpy((uint8_t *)(dst->data) + dst_pos * element_size,
+           (const uint8_t *)(src->data) + src_pos * element_size,
+           element_size * size);
+    return;
+  }
+  for (i = 0; i < size; i++) {
+    set_fixed(dst, dst_pos + i, get_fixed(src, src_pos + i), src->fp_pos);
+  }
+}
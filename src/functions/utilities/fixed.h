@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_FIXED_H_181205120000_
+#define H_FIXED_H_181205120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup FixedPoint Fixed Point
+/// Integer kernels between INT8 and INT16 variables. Values keep their fixed
+/// point position while they are calculated, and are converted to position of
+/// output once when they are stored, with the same truncation toward 0 and
+/// saturation as setters.
+/// @{
+
+/// Variable is INT8 or INT16 whose values are scaled by fp_pos only.
+int is_fixed_point(const rt_variable_t *variable);
+
+/// Integer at pos of INT8 or INT16 variable.
+static inline int32_t get_fixed(const rt_variable_t *variable, nn_size_t pos) {
+  return variable->type == NN_DATA_TYPE_INT8
+             ? *((const int8_t *)(variable->data) + pos)
+             : *((const int16_t *)(variable->data) + pos);
+}
+
+/// Store value whose fixed point position is fp_pos at pos of INT8 or INT16
+/// variable, same as setter of value * 2^-fp_pos.
+void set_fixed(rt_variable_t *variable, nn_size_t pos, int64_t value,
+               int fp_pos);
+
+/// Copy size elements of fixed point src from src_pos into dst from dst_pos,
+/// same as copy_variable_block(). Areas must not overlap.
+void copy_fixed_block(const rt_variable_t *src, nn_size_t src_pos,
+                      rt_variable_t *dst, nn_size_t dst_pos, int size);
+
+/// @}
+
+#endif // H_FIXED_H_181205120000_
@@ -0,0 +1,36 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "half.h"
+#include "shape.h"
+
+rt_function_error_t expand_half_variable(const rt_variable_t *variable,
+                                         rt_variable_t *dense) {
+  const uint16_t *src = (const uint16_t *)(variable->data);
+  int size = calc_shape_size(variable->shape);
+  float *data;
+  int i; // Iterator
+
+  *dense = *variable;
+  dense->type = NN_DATA_TYPE_FLOAT;
+  dense->data = rt_malloc_func(sizeof(float) * size);
+  if (dense->data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  data = (float *)(dense->data);
+  for (i = 0; i < size; i++) {
+    data[i] = half_to_float(variable->type, src[i]);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
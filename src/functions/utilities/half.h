@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_HALF_H_181205120000_
+#define H_HALF_H_181205120000_
+
+#include <nnablart/functions.h>
+
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup HalfFunction Half Function
+/// Conversions of NN_DATA_TYPE_FLOAT16 and NN_DATA_TYPE_BFLOAT16 values.
+///
+/// Float values are rounded to nearest even, NaN stays NaN and values out of
+/// range of FLOAT16 become infinity. Native conversion instructions are used
+/// for FLOAT16 if compiler supports __fp16 (e.g. ARMv8.2 or ARMv7 with
+/// -mfp16-format=ieee).
+/// @{
+
+typedef union {
+  uint32_t u;
+  float f;
+} half_bits_t;
+
+/// Non zero if type is NN_DATA_TYPE_FLOAT16 or NN_DATA_TYPE_BFLOAT16.
+static inline int is_half_type(nn_data_type_t type) {
+  return type == NN_DATA_TYPE_FLOAT16 || type == NN_DATA_TYPE_BFLOAT16;
+}
+
+/// Float value of FLOAT16 bits.
+static inline float float16_to_float(uint16_t h) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+  __fp16 v;
+  memcpy(&v, &h, sizeof(v));
+  return (float)v;
+#else
+  const uint32_t exponent = 0x7c00 << 13; // Exponent bits after shift.
+  half_bits_t magic, o;
+
+  magic.u = 113 << 23;
+  o.u = (uint32_t)(h & 0x7fff) << 13;
+  if ((o.u & exponent) == exponent) {
+    o.u += (127 - 15 + 128 - 16) << 23; // Inf or NaN
+  } else if ((o.u & exponent) == 0) {
+    o.u += (127 - 15 + 1) << 23; // Zero or denormal, renormalized by FPU.
+    o.f -= magic.f;
+  } else {
+    o.u += (127 - 15) << 23;
+  }
+  o.u |= (uint32_t)(h & 0x8000) << 16;
+  return o.f;
+#endif
+}
+
+/// FLOAT16 bits of float value.
+static inline uint16_t float_to_float16(float value) {
+#if defined(__ARM_FP16_FORMAT_IEEE)
+  __fp16 v = (__fp16)value;
+  uint16_t h;
+  memcpy(&h, &v, sizeof(h));
+  return h;
+#else
+  half_bits_t f, denormal;
+  uint32_t sign;
+  uint16_t h;
+
+  f.f = value;
+  sign = f.u & 0x80000000u;
+  f.u ^= sign;
+  denormal.u = (127 - 15 + 23 - 10 + 1) << 23;
+  if (f.u >= (127 + 16) << 23) {
+    h = f.u > 0x7f800000u ? 0x7e00 : 0x7c00; // NaN or overflow to Inf
+  } else if (f.u < (127 - 14) << 23) {
+    // Rounded by FPU while mantissa is aligned to denormal.
+    f.f += denormal.f;
+    h = (uint16_t)(f.u - denormal.u);
+  } else {
+    uint32_t odd = (f.u >> 13) & 1;
+    f.u += ((uint32_t)(15 - 127) << 23) + 0xfff + odd;
+    h = (uint16_t)(f.u >> 13);
+  }
+  return (uint16_t)(h | (sign >> 16));
+#endif
+}
+
+/// Float value of BFLOAT16 bits.
+static inline float bfloat16_to_float(uint16_t b) {
+  half_bits_t o;
+  o.u = (uint32_t)b << 16;
+  return o.f;
+}
+
+/// BFLOAT16 bits of float value.
+static inline uint16_t float_to_bfloat16(float value) {
+  half_bits_t f;
+  f.f = value;
+  if ((f.u & 0x7fffffffu) > 0x7f800000u) {
+    return (uint16_t)((f.u >> 16) | 0x40); // Quiet NaN
+  }
+  f.u += 0x7fff + ((f.u >> 16) & 1);
+  return (uint16_t)(f.u >> 16);
+}
+
+/// Float value of 16bit float of type.
+static inline float half_to_float(nn_data_type_t type, uint16_t h) {
+  return type == NN_DATA_TYPE_BFLOAT16 ? bfloat16_to_float(h)
+                                       : float16_to_float(h);
+}
+
+/// Make float copy of FLOAT16 or BFLOAT16 variable, data of dense is
+/// allocated and freed with free_dense_variable().
+rt_function_error_t expand_half_variable(const rt_variable_t *variable,
+                                         rt_variable_t *dense);
+
+/// @}
+
+#endif // H_HALF_H_181205120000_
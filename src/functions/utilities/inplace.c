@@ -0,0 +1,104 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <limits.h>
+#include <nnablart/functions.h>
+
+// Kernels of these functions calculate each output element from the input
+// element at the same position, including their generic implementations.
+int is_inplace_function(const nn_function_t *func) {
+  switch (func->type) {
+  case NN_FUNCTION_RELU:
+  case NN_FUNCTION_LEAKY_RELU_0:
+  case NN_FUNCTION_LEAKY_RELU:
+  case NN_FUNCTION_PRELU:
+  case NN_FUNCTION_ELU:
+  case NN_FUNCTION_SELU:
+  case NN_FUNCTION_SIGMOID:
+  case NN_FUNCTION_TANH:
+  case NN_FUNCTION_SWISH:
+  case NN_FUNCTION_ADD_SCALAR:
+  case NN_FUNCTION_MUL_SCALAR:
+  case NN_FUNCTION_POW_SCALAR:
+  case NN_FUNCTION_R_SUB_SCALAR:
+  case NN_FUNCTION_R_DIV_SCALAR:
+  case NN_FUNCTION_R_POW_SCALAR:
+  case NN_FUNCTION_MAXIMUM_SCALAR:
+  case NN_FUNCTION_MINIMUM_SCALAR:
+  case NN_FUNCTION_SIGN:
+  case NN_FUNCTION_ABS:
+  case NN_FUNCTION_EXP:
+  case NN_FUNCTION_LOG:
+  case NN_FUNCTION_IDENTITY:
+  case NN_FUNCTION_ROUND:
+  case NN_FUNCTION_DROPOUT:
+  case NN_FUNCTION_RESHAPE:
+    return 1;
+  case NN_FUNCTION_BATCH_NORMALIZATION:
+    // Inference mode normalizes each element with running mean and variance.
+    return !((const nn_function_batch_normalization_t *)func)->batch_stat;
+  default:
+    return 0;
+  }
+}
+
+int is_alias_function(const nn_function_t *func) {
+  switch (func->type) {
+  case NN_FUNCTION_RESHAPE:
+  case NN_FUNCTION_IDENTITY:
+    return 1;
+  case NN_FUNCTION_DROPOUT:
+    // Inference mode scales input by 1 - p.
+    return ((const nn_function_dropout_t *)func)->p == 0.0f;
+  case NN_FUNCTION_MUL_SCALAR:
+    return ((const nn_function_mul_scalar_t *)func)->val == 1.0f;
+  case NN_FUNCTION_ADD_SCALAR:
+    return ((const nn_function_add_scalar_t *)func)->val == 0.0f;
+  default:
+    return 0;
+  }
+}
+
+int calc_slice_view_offset(rt_list_t input_shape, rt_list_t output_shape,
+                           rt_list_t start, rt_list_t step) {
+  const int first = input_shape.size - start.size;
+  int offset = 0;
+  int stride = 1;
+  int whole = 1; // Axes after current one are taken whole.
+  int d;         // Iterator
+
+  if (output_shape.size != input_shape.size || first < 0 ||
+      step.size != start.size) {
+    return -1;
+  }
+  for (d = input_shape.size - 1; d >= 0; d--) {
+    // Same as Slice, negative or unspecified start and step are ignored.
+    int s = 0;
+    int t = 1;
+    if (d >= first) {
+      const int start_d = start.data[d - first];
+      const int step_d = step.data[d - first];
+      s = (start_d < 0 || start_d == INT_MAX) ? 0 : start_d;
+      t = (step_d < 0 || step_d == INT_MAX) ? 1 : step_d;
+    }
+    if ((!whole && output_shape.data[d] != 1) ||
+        (output_shape.data[d] > 1 && t != 1)) {
+      return -1;
+    }
+    offset += s * stride;
+    stride *= input_shape.data[d];
+    whole = whole && output_shape.data[d] == input_shape.data[d];
+  }
+  return offset;
+}
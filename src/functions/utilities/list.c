@@ -20,7 +20,8 @@ rt_list_t allocate_list(int length) {
   rt_list_t ret;
   assert(length >= 0);
   ret.size = length;
-  ret.data = (int *)rt_malloc_func(sizeof(int) * length);
+  // Empty list has data too, so that NULL means allocation failed.
+  ret.data = (int *)rt_malloc_func(sizeof(int) * (length > 0 ? length : 1));
   return ret;
 }
 
@@ -34,7 +35,7 @@ void free_list(rt_list_t s) {
 rt_list_t clone_list(rt_list_t src) {
   int i;
   rt_list_t dst = allocate_list(src.size);
-  for (i = 0; i < src.size; i++) {
+  for (i = 0; dst.data && i < src.size; i++) {
     dst.data[i] = src.data[i];
   }
   return dst;
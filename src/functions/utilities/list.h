@@ -18,6 +18,8 @@
 #include <nnablart/functions.h>
 
 /// Allocate shape
+///
+/// data is NULL only if allocation failed, also for empty list.
 rt_list_t allocate_list(int length);
 
 /// Free allocated shape.
@@ -26,7 +28,7 @@ void free_list(rt_list_t s);
 /// Clone shape
 ///
 /// list.shape will be allocated inside this function.
-/// User must free cloned shape.
+/// User must free cloned shape, whose data is NULL if allocation failed.
 rt_list_t clone_list(rt_list_t src);
 
 #endif // H_LIST_H_171210064151_
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "neon.h"
+
+#ifdef NNABLART_NEON
+
+void neon_relu(const float *x, float *y, int size) {
+  float32x4_t zero = vdupq_n_f32(0.0f);
+  int i; // Iterator
+
+  for (i = 0; i + 4 <= size; i += 4) {
+    vst1q_f32(y + i, vmaxq_f32(vld1q_f32(x + i), zero));
+  }
+  for (; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : 0.0f;
+  }
+}
+
+void neon_add(const float *a, const float *b, float *y, int size) {
+  int i; // Iterator
+
+  for (i = 0; i + 4 <= size; i += 4) {
+    vst1q_f32(y + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = a[i] + b[i];
+  }
+}
+
+void neon_mul(const float *a, const float *b, float *y, int size) {
+  int i; // Iterator
+
+  for (i = 0; i + 4 <= size; i += 4) {
+    vst1q_f32(y + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = a[i] * b[i];
+  }
+}
+
+void neon_max(const float *a, const float *b, float *y, int size) {
+  int i; // Iterator
+
+  for (i = 0; i + 4 <= size; i += 4) {
+    vst1q_f32(y + i, vmaxq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = a[i] > b[i] ? a[i] : b[i];
+  }
+}
+
+#endif /* NNABLART_NEON */
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_NEON_H_181204120000_
+#define H_NEON_H_181204120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup NeonFunction Neon Function
+/// Element wise float kernels written with NEON intrinsics. Transcendental
+/// functions are in vector_math.h.
+///
+/// They are built when NNABLART_ENABLE_NEON is defined (CMake option of same
+/// name) and compiler targets NEON. NNABLART_NEON is defined then, and
+/// functions select NEON kernels at allocation. Only ARMv7 NEON instructions
+/// are used, so they run on both of AArch32 and AArch64.
+/// @{
+
+#if defined(NNABLART_ENABLE_NEON) &&                                           \
+    (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define NNABLART_NEON
+
+#include <arm_neon.h>
+
+/// y = max(x, 0)
+void neon_relu(const float *x, float *y, int size);
+
+/// y = a + b
+void neon_add(const float *a, const float *b, float *y, int size);
+
+/// y = a * b
+void neon_mul(const float *a, const float *b, float *y, int size);
+
+/// y = max(a, b)
+void neon_max(const float *a, const float *b, float *y, int size);
+
+#endif
+
+/// @}
+
+#endif // H_NEON_H_181204120000_
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+
+#include "thread_local.h"
+
+// Loops smaller than this amount of operations run serially.
+#define PARALLEL_MIN_COST (16384)
+
+// Loops check cancellation after about this amount of operations, and at
+// most this number of times in each range.
+#define CANCEL_CHECK_COST (1 << 22)
+#define CANCEL_CHECK_STEPS (8)
+
+static THREAD_LOCAL const rt_parallel_executor_t *current_executor = 0;
+static THREAD_LOCAL const rt_cancellation_t *current_cancellation = 0;
+
+typedef struct {
+  rt_parallel_body_t body;
+  void *arg;
+  const rt_cancellation_t *cancellation; ///< Threads of executor do not see
+                                         ///< one of caller.
+  int step;                              ///< Iterations between checks.
+} cancelable_loop_t;
+
+const rt_parallel_executor_t *
+rt_set_parallel_executor(const rt_parallel_executor_t *executor) {
+  const rt_parallel_executor_t *previous = current_executor;
+  current_executor = executor;
+  return previous;
+}
+
+const rt_cancellation_t *
+rt_set_cancellation(const rt_cancellation_t *cancellation) {
+  const rt_cancellation_t *previous = current_cancellation;
+  current_cancellation = cancellation;
+  return previous;
+}
+
+static void run_cancelable(void *arg, int begin, int end) {
+  const cancelable_loop_t *loop = arg;
+  int step = (end - begin + CANCEL_CHECK_STEPS - 1) / CANCEL_CHECK_STEPS;
+  int i; // Iterator
+
+  if (step < loop->step) {
+    step = loop->step;
+  }
+  for (i = begin; i < end; i += step) {
+    if (loop->cancellation->is_canceled(loop->cancellation->arg)) {
+      return;
+    }
+    loop->body(loop->arg, i, end - i < step ? end : i + step);
+  }
+}
+
+void rt_parallel_for(int size, int cost, rt_parallel_body_t body, void *arg) {
+  const rt_parallel_executor_t *e = current_executor;
+  cancelable_loop_t loop;
+  if (size <= 0) {
+    return;
+  }
+  if (current_cancellation) {
+    loop.body = body;
+    loop.arg = arg;
+    loop.cancellation = current_cancellation;
+    loop.step = cost > 0 && cost < CANCEL_CHECK_COST
+                    ? CANCEL_CHECK_COST / cost
+                    : 1;
+    body = run_cancelable;
+    arg = &loop;
+  }
+  if (e == 0 || e->num_of_threads <= 1 || size == 1 ||
+      (long long)size * cost < PARALLEL_MIN_COST) {
+    body(arg, 0, size);
+    return;
+  }
+  e->parallel_for(e->pool, size, body, arg);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "prepack.h"
+#include "sgemm.h"
+#include "thread_local.h"
+
+static THREAD_LOCAL size_t *current_budget = 0;
+static THREAD_LOCAL int kernel_candidates = 0;
+static THREAD_LOCAL const rt_weight_copies_t *current_copies = 0;
+
+size_t *rt_set_prepack_budget(size_t *budget) {
+  size_t *previous = current_budget;
+  current_budget = budget;
+  return previous;
+}
+
+int reserve_prepack_budget(size_t size) {
+  if (current_budget == 0) {
+    return 1;
+  }
+  if (*current_budget < size) {
+    return 0;
+  }
+  *current_budget -= size;
+  return 1;
+}
+
+int rt_set_kernel_candidates(int enable) {
+  int previous = kernel_candidates;
+  kernel_candidates = enable;
+  return previous;
+}
+
+int keep_kernel_candidates(void) { return kernel_candidates; }
+
+const rt_weight_copies_t *
+rt_set_weight_copies(const rt_weight_copies_t *copies) {
+  const rt_weight_copies_t *previous = current_copies;
+  current_copies = copies;
+  return previous;
+}
+
+void *find_weight_copy(const void *weight, int layout, size_t size) {
+  if (current_copies == 0) {
+    return 0;
+  }
+  return current_copies->find(current_copies->arg, weight, layout, size);
+}
+
+void add_weight_copy(const void *weight, int layout, size_t size, void *copy) {
+  if (current_copies != 0) {
+    current_copies->add(current_copies->arg, weight, layout, size, copy);
+  }
+}
+
+void free_weight_copy(void *copy) {
+  if (copy == 0) {
+    return;
+  }
+  if (current_copies == 0 ||
+      !current_copies->release(current_copies->arg, copy)) {
+    rt_free_func(copy);
+  }
+}
+
+float *pack_weight_panels(const float *matrix, int groups, int rows,
+                          int columns, int panel) {
+  int panels = (rows + panel - 1) / panel;
+  size_t size = sizeof(float) * groups * panels * columns * panel;
+  float *packed = find_weight_copy(matrix, WEIGHT_COPY_PANELS + panel, size);
+  int g; // Iterator
+
+  if (packed != 0) {
+    return packed;
+  }
+  if (!reserve_prepack_budget(size)) {
+    return 0;
+  }
+  packed = rt_malloc_func(size);
+  if (packed == 0) {
+    return 0;
+  }
+  for (g = 0; g < groups; g++) {
+    sgemm_pack_panels(matrix + g * rows * columns, rows, columns, panel,
+                      packed + g * panels * columns * panel);
+  }
+  add_weight_copy(matrix, WEIGHT_COPY_PANELS + panel, size, packed);
+  return packed;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_PREPACK_H_181022120000_
+#define H_PREPACK_H_181022120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup PrepackFunction Prepack Function
+/// @{
+
+/// Take size bytes from prepack budget of calling thread.
+/// @return 1 if packed copy of weight can be made, otherwise 0 and budget is
+/// not changed.
+int reserve_prepack_budget(size_t size);
+
+/// @return Non zero if functions keep areas of all kernels, set by
+/// rt_set_kernel_candidates() of calling thread.
+int keep_kernel_candidates(void);
+
+/// Layouts of weight copies, told apart in store of rt_set_weight_copies().
+typedef enum {
+  WEIGHT_COPY_WINOGRAD = 1,     ///< Transformed kernels of Winograd.
+  WEIGHT_COPY_CHANNEL_LAST = 2, ///< Transposed for channel last inputs.
+  WEIGHT_COPY_SIGN = 3,         ///< Sign bits with rows at word boundary.
+  WEIGHT_COPY_FIXED8_DOT = 4,   ///< Int8 rows padded to multiple of 4.
+  WEIGHT_COPY_PANELS = 16,      ///< Panels, plus number of rows of panel.
+} weight_copy_layout_t;
+
+/// @return Copy of weight in layout kept by another context, or NULL.
+void *find_weight_copy(const void *weight, int layout, size_t size);
+
+/// Let functions of other contexts use copy of weight made by calling one.
+void add_weight_copy(const void *weight, int layout, size_t size, void *copy);
+
+/// Free copy of weight unless it is owned by another context.
+void free_weight_copy(void *copy);
+
+/// Pack each of groups rows x columns matrices by sgemm_pack_panels() into
+/// panels of panel rows. Packed matrix of group g starts at
+/// g * panels * columns * panel, where panels is rows / panel rounded up.
+/// @return Packed matrices, kept by another context or allocated by
+/// rt_malloc_func and freed by free_weight_copy(), or NULL if they do not fit
+/// in budget or allocation failed.
+float *pack_weight_panels(const float *matrix, int groups, int rows,
+                          int columns, int panel);
+
+/// @}
+
+#endif // H_PREPACK_H_181022120000_
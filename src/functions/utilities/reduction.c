@@ -0,0 +1,347 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "reduction.h"
+#include "accessor.h"
+#include "shape.h"
+#include "vector_math.h"
+
+#include <string.h>
+
+#define REDUCTION_ROW_BLOCK (16) // Rows added in order before pairwise sum
+#define REDUCTION_COLUMNS (32)   // Columns summed pairwise at a time
+#define REDUCTION_LEVELS (32)    // Partial sums kept by pairwise sum
+
+typedef struct {
+  reduction_param_t *param;
+  const float *x;
+  float *y;
+  float *index;
+} reduction_job_t;
+
+rt_function_error_t allocate_reduction_param(rt_function_t *f,
+                                             reduction_op_t op,
+                                             rt_list_t axes, int with_index,
+                                             int is_float,
+                                             reduction_param_t *param) {
+  const rt_list_t shape = f->inputs[0]->shape;
+  uint32_t reduced = 0; // Bit of each reduced axis.
+  int last = -1;        // Reduced state of last group, -1 before first.
+  int num_of_reduced_groups = 0;
+  int i, g; // Iterators
+
+  memset(param, 0, sizeof(reduction_param_t));
+  param->op = op;
+  if (shape.size > 32) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < axes.size; i++) {
+    int axis = axes.data[i] < 0 ? axes.data[i] + shape.size : axes.data[i];
+    if (axis < 0 || axis >= shape.size) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+    reduced |= 1u << axis;
+  }
+  if (axes.size == 0) {
+    reduced = ~0u;
+  }
+
+  // Count groups of axes, skipping axes of size 1.
+  for (i = 0; i < shape.size; i++) {
+    const int r = (reduced >> i) & 1;
+    if (shape.data[i] == 1 || r == last) {
+      continue;
+    }
+    param->num_of_groups++;
+    num_of_reduced_groups += r;
+    last = r;
+  }
+  param->input_size = calc_shape_size(shape);
+  param->outer = 1;
+  param->size = 1;
+  param->inner = 1;
+  for (i = 0; i < shape.size; i++) {
+    if ((reduced >> i) & 1) {
+      param->size *= shape.data[i];
+    } else if (param->size == 1) {
+      param->outer *= shape.data[i];
+    } else {
+      param->inner *= shape.data[i];
+    }
+  }
+  param->output_size = param->outer * param->inner;
+  for (i = 0; i < f->num_of_outputs; i++) {
+    if (calc_shape_size(f->outputs[i]->shape) != param->output_size) {
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+  }
+
+  if (num_of_reduced_groups > 1) {
+    // Size, output stride and reduced stride of each group.
+    param->groups = rt_malloc_func(sizeof(int) * 3 * param->num_of_groups);
+    if (param->groups == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+    g = -1;
+    last = -1;
+    for (i = 0; i < shape.size; i++) {
+      const int r = (reduced >> i) & 1;
+      if (shape.data[i] == 1) {
+        continue;
+      }
+      if (r != last) {
+        g++;
+        param->groups[g * 3] = 1;
+        param->groups[g * 3 + 1] = !r;
+        param->groups[g * 3 + 2] = r;
+        last = r;
+      }
+      param->groups[g * 3] *= shape.data[i];
+    }
+    int output_stride = 1, reduced_stride = 1;
+    for (g = param->num_of_groups - 1; g >= 0; g--) {
+      int *group = param->groups + g * 3;
+      group[1] *= output_stride;
+      group[2] *= reduced_stride;
+      if (group[1]) {
+        output_stride *= group[0];
+      } else {
+        reduced_stride *= group[0];
+      }
+    }
+  } else {
+    param->num_of_groups = 0;
+  }
+
+  if (with_index) {
+    param->values = rt_malloc_func(sizeof(float) * param->output_size);
+    if (param->values == 0) {
+      free_reduction_param(param);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  if (!is_float) {
+    param->input = rt_malloc_func(sizeof(float) * param->input_size);
+    param->output = rt_malloc_func(sizeof(float) * param->output_size);
+    param->index = rt_malloc_func(sizeof(float) * param->output_size);
+    if (param->input == 0 || param->output == 0 || param->index == 0) {
+      free_reduction_param(param);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_reduction_param(reduction_param_t *param) {
+  rt_free_func(param->groups);
+  rt_free_func(param->values);
+  rt_free_func(param->input);
+  rt_free_func(param->output);
+  rt_free_func(param->index);
+  param->groups = 0;
+  param->values = 0;
+  param->input = 0;
+  param->output = 0;
+  param->index = 0;
+}
+
+// Reduce contiguous row of size values.
+static float reduce_row(reduction_op_t op, const float *x, int size) {
+  switch (op) {
+  case REDUCTION_SUM:
+    return vector_sum(x, size);
+  case REDUCTION_MEAN:
+    return vector_sum(x, size) / size;
+  case REDUCTION_PROD:
+    return vector_prod(x, size);
+  case REDUCTION_MAX:
+    return vector_max(x, size);
+  default:
+    return vector_min(x, size);
+  }
+}
+
+// Accumulate row of inner values into y, which has the first row, Prod,
+// Max and Min only.
+static void accumulate_row(reduction_op_t op, const float *x, float *y,
+                           int inner) {
+  switch (op) {
+  case REDUCTION_PROD:
+    vector_mul(x, y, inner);
+    break;
+  case REDUCTION_MAX:
+    vector_maximum(x, y, inner);
+    break;
+  default:
+    vector_minimum(x, y, inner);
+    break;
+  }
+}
+
+// Sum size rows of inner values into y. Blocks of REDUCTION_ROW_BLOCK rows
+// are added in order, and sums of blocks pairwise like a binary counter, same
+// as vector_sum() does for lanes.
+static void sum_rows_pairwise(const float *x, float *y, int size, int inner) {
+  float stack[REDUCTION_LEVELS][REDUCTION_COLUMNS];
+  int column, begin, b, m, r, depth; // Iterators
+
+  for (column = 0; column < inner; column += REDUCTION_COLUMNS) {
+    const int n = inner - column < REDUCTION_COLUMNS ? inner - column
+                                                     : REDUCTION_COLUMNS;
+    depth = 0;
+    for (begin = 0, b = 1; begin < size; begin += REDUCTION_ROW_BLOCK, b++) {
+      const int end = size - begin < REDUCTION_ROW_BLOCK
+                          ? size
+                          : begin + REDUCTION_ROW_BLOCK;
+      float *partial = stack[depth++];
+      memcpy(partial, x + (size_t)begin * inner + column, sizeof(float) * n);
+      for (r = begin + 1; r < end; r++) {
+        vector_add(x + (size_t)r * inner + column, partial, n);
+      }
+      for (m = b; (m & 1) == 0; m >>= 1, depth--) {
+        vector_add(stack[depth - 1], stack[depth - 2], n);
+      }
+    }
+    for (; depth > 1; depth--) {
+      vector_add(stack[depth - 1], stack[depth - 2], n);
+    }
+    memcpy(y + column, stack[0], sizeof(float) * n);
+  }
+}
+
+// Value v at reduced position r replaces y with index, Max and Min only.
+static inline int is_replaced(reduction_op_t op, float y, float v) {
+  return op == REDUCTION_MAX ? v > y : v < y;
+}
+
+// Process outer indices in [begin, end) of adjacent reduced axes.
+static void reduce_range(void *arg, int begin, int end) {
+  const reduction_job_t *job = (const reduction_job_t *)arg;
+  const reduction_param_t *p = job->param;
+  const int inner = p->inner;
+  int o, r, i; // Iterators
+
+  for (o = begin; o < end; o++) {
+    const float *x = job->x + (size_t)o * p->size * inner;
+    float *y = job->y + (size_t)o * inner;
+    if (job->index) {
+      float *index = job->index + (size_t)o * inner;
+      memcpy(y, x, sizeof(float) * inner);
+      memset(index, 0, sizeof(float) * inner);
+      for (r = 1; r < p->size; r++) {
+        const float *row = x + (size_t)r * inner;
+        for (i = 0; i < inner; i++) {
+          if (is_replaced(p->op, y[i], row[i])) {
+            y[i] = row[i];
+            index[i] = (float)r;
+          }
+        }
+      }
+    } else if (inner == 1) {
+      y[0] = reduce_row(p->op, x, p->size);
+    } else if (p->op == REDUCTION_SUM || p->op == REDUCTION_MEAN) {
+      sum_rows_pairwise(x, y, p->size, inner);
+      if (p->op == REDUCTION_MEAN) {
+        for (i = 0; i < inner; i++) {
+          y[i] /= p->size;
+        }
+      }
+    } else {
+      memcpy(y, x, sizeof(float) * inner);
+      for (r = 1; r < p->size; r++) {
+        accumulate_row(p->op, x + (size_t)r * inner, y, inner);
+      }
+    }
+  }
+}
+
+// Reduced axes are not adjacent, input is visited in order with positions
+// of groups.
+static void reduce_groups(const reduction_param_t *p, const float *x,
+                          float *y, float *index) {
+  int position[32] = {0};
+  int i, g; // Iterators
+
+  for (i = 0; i < p->input_size; i++) {
+    int o = 0, r = 0;
+    for (g = 0; g < p->num_of_groups; g++) {
+      o += position[g] * p->groups[g * 3 + 1];
+      r += position[g] * p->groups[g * 3 + 2];
+    }
+    if (r == 0) {
+      y[o] = x[i];
+      if (index) {
+        index[o] = 0.0f;
+      }
+    } else if (index) {
+      if (is_replaced(p->op, y[o], x[i])) {
+        y[o] = x[i];
+        index[o] = (float)r;
+      }
+    } else {
+      switch (p->op) {
+      case REDUCTION_SUM:
+      case REDUCTION_MEAN:
+        y[o] += x[i];
+        break;
+      case REDUCTION_PROD:
+        y[o] *= x[i];
+        break;
+      case REDUCTION_MAX:
+        y[o] = y[o] < x[i] ? x[i] : y[o];
+        break;
+      default:
+        y[o] = y[o] > x[i] ? x[i] : y[o];
+        break;
+      }
+    }
+    for (g = p->num_of_groups - 1;
+         g >= 0 && ++position[g] == p->groups[g * 3]; g--) {
+      position[g] = 0;
+    }
+  }
+  if (p->op == REDUCTION_MEAN) {
+    for (i = 0; i < p->output_size; i++) {
+      y[i] /= p->size;
+    }
+  }
+}
+
+void calc_reduction(reduction_param_t *param, const float *x, float *y,
+                    float *index) {
+  reduction_job_t job = {param, x, y, index};
+  if (index) {
+    // Values are needed to compare, and kept when they are also output.
+    job.y = y ? y : param->values;
+  }
+  if (param->num_of_groups > 0) {
+    reduce_groups(param, x, job.y, index);
+    return;
+  }
+  rt_parallel_for(param->outer, param->size * param->inner, reduce_range,
+                  &job);
+}
+
+void calc_reduction_generic(reduction_param_t *param, rt_variable_t *input,
+                            rt_variable_t *output, rt_variable_t *index) {
+  get_variable_block(input, 0, param->input_size, param->input);
+  calc_reduction(param, param->input, param->output,
+                 index ? param->index : 0);
+  if (output) {
+    set_variable_block(output, 0, param->output_size, param->output);
+  }
+  if (index) {
+    set_variable_block(index, 0, param->output_size, param->index);
+  }
+}
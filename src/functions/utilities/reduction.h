@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_REDUCTION_H_181225120000_
+#define H_REDUCTION_H_181225120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup ReductionFunction Reduction Function
+/// Sum, Mean, Prod, Max and Min of float values over axes.
+///
+/// Adjacent axes which are all reduced or all kept are collapsed when
+/// allocated, and axes of size 1 are ignored. If reduced axes are adjacent,
+/// input is (outer, size, inner). Rows of size values are reduced by lanes
+/// if inner is 1, otherwise rows of inner values are accumulated into
+/// output. Sum and Mean add blocks of values or rows pairwise, so that order
+/// of additions depends only on shape. Outer is split to threads by
+/// rt_parallel_for().
+/// @{
+
+/// Operation of reduction.
+typedef enum {
+  REDUCTION_SUM,
+  REDUCTION_MEAN,
+  REDUCTION_PROD,
+  REDUCTION_MAX,
+  REDUCTION_MIN
+} reduction_op_t;
+
+/// Collapsed shape and work area of reduction, built at allocation.
+typedef struct {
+  reduction_op_t op;
+  int outer;          ///< Elements of kept axes before reduced axes.
+  int size;           ///< Elements of reduced axes.
+  int inner;          ///< Elements of kept axes after reduced axes.
+  int num_of_groups;  ///< Collapsed axes if reduced axes are not adjacent.
+  int *groups;        ///< Size, output stride and reduced stride of groups.
+  int input_size;     ///< Elements of input.
+  int output_size;    ///< Elements of output, outer * inner.
+  float *values;      ///< Values when only index is calculated.
+  float *input;       ///< Float copy of input for generic functions.
+  float *output;      ///< Float output for generic functions.
+  float *index;       ///< Float index for generic functions.
+} reduction_param_t;
+
+/// Fill param for inputs[0] of f reduced over axes, all axes if axes is
+/// empty. Index of Max or Min is position in reduced axes of the first of
+/// equal values, calculated if with_index is non zero. Float copies are
+/// allocated if is_float is zero.
+rt_function_error_t allocate_reduction_param(rt_function_t *f,
+                                             reduction_op_t op,
+                                             rt_list_t axes, int with_index,
+                                             int is_float,
+                                             reduction_param_t *param);
+
+/// Free work areas of param.
+void free_reduction_param(reduction_param_t *param);
+
+/// Reduce float x into y and index, either of which may be NULL.
+void calc_reduction(reduction_param_t *param, const float *x, float *y,
+                    float *index);
+
+/// Reduce input of any type into output and index, either of which may be
+/// NULL.
+void calc_reduction_generic(reduction_param_t *param, rt_variable_t *input,
+                            rt_variable_t *output, rt_variable_t *index);
+
+/// @}
+
+#endif // H_REDUCTION_H_181225120000_
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "repeat.h"
+#include "accessor.h"
+#include "shape.h"
+
+#include <string.h>
+
+rt_function_error_t allocate_repeat_param(rt_list_t input, int offset,
+                                          rt_list_t output, int is_float,
+                                          repeat_param_t *param) {
+  int num_of_dims = 0;
+  int d; // Iterator
+
+  memset(param, 0, sizeof(repeat_param_t));
+  if (offset < 0 || offset + input.size > output.size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  param->shape = rt_malloc_func(sizeof(int) * 4 * (output.size + 1));
+  if (param->shape == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  param->in_shape = param->shape + output.size + 1;
+  param->stride_x = param->in_shape + output.size + 1;
+  param->stride_y = param->stride_x + output.size + 1;
+
+  // Axis which is not repeated continues the former axis, since position p
+  // of (r * a, b) reading (p / b % a, p % b) of (a, b) is p % (a * b).
+  for (d = 0; d < output.size; d++) {
+    const int in = d >= offset && d < offset + input.size
+                       ? input.data[d - offset]
+                       : 1;
+    const int out = output.data[d];
+    if (in <= 0 || out % in != 0) {
+      free_repeat_param(param);
+      return RT_FUNCTION_ERROR_INVALID_SHAPE;
+    }
+    if (out == 1) {
+      continue;
+    }
+    if (num_of_dims > 0 && in == out) {
+      param->shape[num_of_dims - 1] *= out;
+      param->in_shape[num_of_dims - 1] *= in;
+    } else {
+      param->shape[num_of_dims] = out;
+      param->in_shape[num_of_dims] = in;
+      num_of_dims++;
+    }
+  }
+  if (num_of_dims == 0) {
+    param->shape[0] = 1;
+    param->in_shape[0] = 1;
+    num_of_dims = 1;
+  }
+  param->num_of_dims = num_of_dims;
+
+  param->input_size = 1;
+  param->output_size = 1;
+  for (d = num_of_dims - 1; d >= 0; d--) {
+    param->stride_x[d] = param->input_size;
+    param->stride_y[d] = param->output_size;
+    param->input_size *= param->in_shape[d];
+    param->output_size *= param->shape[d];
+  }
+
+  if (!is_float) {
+    param->input = rt_malloc_func(sizeof(float) * param->input_size);
+    param->output = rt_malloc_func(sizeof(float) * param->output_size);
+    if (param->input == 0 || param->output == 0) {
+      free_repeat_param(param);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_repeat_param(repeat_param_t *param) {
+  rt_free_func(param->shape);
+  rt_free_func(param->input);
+  rt_free_func(param->output);
+  param->shape = 0;
+  param->input = 0;
+  param->output = 0;
+}
+
+static void repeat_dim(const repeat_param_t *p, int dim, const float *x,
+                       float *y) {
+  const int in = p->in_shape[dim];
+  const int size = p->shape[dim] * p->stride_y[dim];
+  int done = in * p->stride_y[dim];
+  int i; // Iterator
+
+  if (dim + 1 == p->num_of_dims) {
+    memcpy(y, x, sizeof(float) * in);
+  } else {
+    for (i = 0; i < in; i++) {
+      repeat_dim(p, dim + 1, x + i * p->stride_x[dim],
+                 y + i * p->stride_y[dim]);
+    }
+  }
+  // Written part is copied after itself, which doubles it.
+  while (done < size) {
+    const int n = size - done < done ? size - done : done;
+    memcpy(y + done, y, sizeof(float) * n);
+    done += n;
+  }
+}
+
+void calc_repeat(const repeat_param_t *param, const float *x, float *y) {
+  repeat_dim(param, 0, x, y);
+}
+
+void calc_repeat_generic(repeat_param_t *param, rt_variable_t *input,
+                         rt_variable_t *output) {
+  get_variable_block(input, 0, param->input_size, param->input);
+  calc_repeat(param, param->input, param->output);
+  set_variable_block(output, 0, param->output_size, param->output);
+}
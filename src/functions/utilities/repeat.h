@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_REPEAT_H_181226120000_
+#define H_REPEAT_H_181226120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup RepeatFunction Repeat Function
+/// Broadcast and tile of float values, used by Broadcast, BroadcastTo and
+/// Tile.
+///
+/// Each axis of output repeats the axis of input whose size divides it, so
+/// that position p of an axis reads position p % size of input. Input of
+/// size 1 is broadcast. Axes whose input is not repeated are collapsed into
+/// the former axis when allocated. Each axis is calculated once for the
+/// positions of input, and the block is copied in doubling size for the
+/// rest, so each value of output is written once.
+/// @{
+
+/// Collapsed shape and work area of repeat, built at allocation.
+typedef struct {
+  int num_of_dims; ///< Number of collapsed axes, at least 1.
+  int *shape;      ///< Collapsed shape of output.
+  int *in_shape;   ///< Collapsed shape of input, each divides shape.
+  int *stride_x;   ///< Distance between input elements in each axis.
+  int *stride_y;   ///< Distance between output elements in each axis.
+  int input_size;  ///< Elements of input.
+  int output_size; ///< Elements of output.
+  float *input;    ///< Float copy of input for generic functions.
+  float *output;   ///< Float output for generic functions.
+} repeat_param_t;
+
+/// Fill param to repeat input into output. Axes of input are axes of output
+/// from offset, and other axes of output repeat input of size 1. Float
+/// copies are allocated if is_float is zero.
+rt_function_error_t allocate_repeat_param(rt_list_t input, int offset,
+                                          rt_list_t output, int is_float,
+                                          repeat_param_t *param);
+
+/// Free work areas of param.
+void free_repeat_param(repeat_param_t *param);
+
+/// Repeat float x into y.
+void calc_repeat(const repeat_param_t *param, const float *x, float *y);
+
+/// Repeat input of any type into output.
+void calc_repeat_generic(repeat_param_t *param, rt_variable_t *input,
+                         rt_variable_t *output);
+
+/// @}
+
+#endif // H_REPEAT_H_181226120000_
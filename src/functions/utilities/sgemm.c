@@ -0,0 +1,556 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sgemm.h"
+#include "half.h"
+#include "x86.h"
+
+#include <string.h>
+
+#if defined(SGEMM_AVX2)
+#include <immintrin.h>
+#elif defined(SGEMM_SSE)
+#include <xmmintrin.h>
+#elif defined(SGEMM_NEON)
+#include <arm_neon.h>
+#endif
+
+// SSE build runs AVX2 kernels of same tiles if CPU has it.
+#if defined(NNABLART_X86_DISPATCH) && defined(SGEMM_SSE)
+#define SGEMM_X86_DISPATCH
+#endif
+
+/*
+ * C is calculated by blocks of SGEMM_BLOCK_N columns. For each depth block
+ * of SGEMM_BLOCK_K, the block of B is packed into panels of SGEMM_NR columns
+ * which stay in cache while all rows of A are multiplied with them, SGEMM_MR
+ * rows at a time. Operands already packed by sgemm_pack_panels() are read as
+ * they are, 16bit float B is converted to float while it is packed.
+ */
+
+#define SGEMM_BLOCK_K (128) // Depth of packed blocks of A and B
+#define SGEMM_BLOCK_N (64)  // Columns of packed block of B
+
+#define SGEMV_ROWS (8)      // Rows of A multiplied at once by sgemv()
+#define SGEMV_LANES (16)    // Partial sums of each row in sgemv()
+#define SGEMV_PREFETCH (64) // Distance of prefetched values of rows of A
+
+#if defined(__GNUC__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p)
+#endif
+
+typedef struct {
+  const float *data;
+  int row;    ///< Distance between rows.
+  int col;    ///< Distance between columns.
+  int packed; ///< Packed by sgemm_pack_panels(), strides are not used.
+
+  const uint16_t *half;     ///< 16bit float elements read instead of data.
+  nn_data_type_t half_type; ///< Type of half elements.
+} operand_t;
+
+typedef void (*kernel_func_t)(int kc, const float *a, const float *b,
+                              float *c, int ldc, int accumulate);
+
+////////////////////////////////////////////////////////////////////////////////
+// Micro-kernels. C[SGEMM_MR][SGEMM_NR] = (C +) A * B for kc columns of
+// packed A panel and kc rows of packed B panel.
+
+#if defined(SGEMM_AVX2)
+
+#ifdef __FMA__
+#define MADD256(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define MADD256(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+static void kernel(int kc, const float *a, const float *b, float *c, int ldc,
+                   int accumulate) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  int l; // Iterator
+
+  for (l = 0; l < kc; l++, a += SGEMM_MR, b += SGEMM_NR) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    __m256 x = _mm256_broadcast_ss(a);
+    c00 = MADD256(x, b0, c00);
+    c01 = MADD256(x, b1, c01);
+    x = _mm256_broadcast_ss(a + 1);
+    c10 = MADD256(x, b0, c10);
+    c11 = MADD256(x, b1, c11);
+    x = _mm256_broadcast_ss(a + 2);
+    c20 = MADD256(x, b0, c20);
+    c21 = MADD256(x, b1, c21);
+    x = _mm256_broadcast_ss(a + 3);
+    c30 = MADD256(x, b0, c30);
+    c31 = MADD256(x, b1, c31);
+  }
+  if (accumulate) {
+    c00 = _mm256_add_ps(c00, _mm256_loadu_ps(c));
+    c01 = _mm256_add_ps(c01, _mm256_loadu_ps(c + 8));
+    c10 = _mm256_add_ps(c10, _mm256_loadu_ps(c + ldc));
+    c11 = _mm256_add_ps(c11, _mm256_loadu_ps(c + ldc + 8));
+    c20 = _mm256_add_ps(c20, _mm256_loadu_ps(c + 2 * ldc));
+    c21 = _mm256_add_ps(c21, _mm256_loadu_ps(c + 2 * ldc + 8));
+    c30 = _mm256_add_ps(c30, _mm256_loadu_ps(c + 3 * ldc));
+    c31 = _mm256_add_ps(c31, _mm256_loadu_ps(c + 3 * ldc + 8));
+  }
+  _mm256_storeu_ps(c, c00);
+  _mm256_storeu_ps(c + 8, c01);
+  _mm256_storeu_ps(c + ldc, c10);
+  _mm256_storeu_ps(c + ldc + 8, c11);
+  _mm256_storeu_ps(c + 2 * ldc, c20);
+  _mm256_storeu_ps(c + 2 * ldc + 8, c21);
+  _mm256_storeu_ps(c + 3 * ldc, c30);
+  _mm256_storeu_ps(c + 3 * ldc + 8, c31);
+}
+
+#elif defined(SGEMM_SSE)
+
+static void kernel(int kc, const float *a, const float *b, float *c, int ldc,
+                   int accumulate) {
+  __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+  __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+  __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+  __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+  int l; // Iterator
+
+  for (l = 0; l < kc; l++, a += SGEMM_MR, b += SGEMM_NR) {
+    __m128 b0 = _mm_loadu_ps(b);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 x = _mm_set1_ps(a[0]);
+    c00 = _mm_add_ps(c00, _mm_mul_ps(x, b0));
+    c01 = _mm_add_ps(c01, _mm_mul_ps(x, b1));
+    x = _mm_set1_ps(a[1]);
+    c10 = _mm_add_ps(c10, _mm_mul_ps(x, b0));
+    c11 = _mm_add_ps(c11, _mm_mul_ps(x, b1));
+    x = _mm_set1_ps(a[2]);
+    c20 = _mm_add_ps(c20, _mm_mul_ps(x, b0));
+    c21 = _mm_add_ps(c21, _mm_mul_ps(x, b1));
+    x = _mm_set1_ps(a[3]);
+    c30 = _mm_add_ps(c30, _mm_mul_ps(x, b0));
+    c31 = _mm_add_ps(c31, _mm_mul_ps(x, b1));
+  }
+  if (accumulate) {
+    c00 = _mm_add_ps(c00, _mm_loadu_ps(c));
+    c01 = _mm_add_ps(c01, _mm_loadu_ps(c + 4));
+    c10 = _mm_add_ps(c10, _mm_loadu_ps(c + ldc));
+    c11 = _mm_add_ps(c11, _mm_loadu_ps(c + ldc + 4));
+    c20 = _mm_add_ps(c20, _mm_loadu_ps(c + 2 * ldc));
+    c21 = _mm_add_ps(c21, _mm_loadu_ps(c + 2 * ldc + 4));
+    c30 = _mm_add_ps(c30, _mm_loadu_ps(c + 3 * ldc));
+    c31 = _mm_add_ps(c31, _mm_loadu_ps(c + 3 * ldc + 4));
+  }
+  _mm_storeu_ps(c, c00);
+  _mm_storeu_ps(c + 4, c01);
+  _mm_storeu_ps(c + ldc, c10);
+  _mm_storeu_ps(c + ldc + 4, c11);
+  _mm_storeu_ps(c + 2 * ldc, c20);
+  _mm_storeu_ps(c + 2 * ldc + 4, c21);
+  _mm_storeu_ps(c + 3 * ldc, c30);
+  _mm_storeu_ps(c + 3 * ldc + 4, c31);
+}
+
+#elif defined(SGEMM_NEON)
+
+static void kernel(int kc, const float *a, const float *b, float *c, int ldc,
+                   int accumulate) {
+  float32x4_t c00 = vdupq_n_f32(0.0f), c01 = vdupq_n_f32(0.0f);
+  float32x4_t c10 = vdupq_n_f32(0.0f), c11 = vdupq_n_f32(0.0f);
+  float32x4_t c20 = vdupq_n_f32(0.0f), c21 = vdupq_n_f32(0.0f);
+  float32x4_t c30 = vdupq_n_f32(0.0f), c31 = vdupq_n_f32(0.0f);
+  int l; // Iterator
+
+  for (l = 0; l < kc; l++, a += SGEMM_MR, b += SGEMM_NR) {
+    float32x4_t b0 = vld1q_f32(b);
+    float32x4_t b1 = vld1q_f32(b + 4);
+    c00 = vmlaq_n_f32(c00, b0, a[0]);
+    c01 = vmlaq_n_f32(c01, b1, a[0]);
+    c10 = vmlaq_n_f32(c10, b0, a[1]);
+    c11 = vmlaq_n_f32(c11, b1, a[1]);
+    c20 = vmlaq_n_f32(c20, b0, a[2]);
+    c21 = vmlaq_n_f32(c21, b1, a[2]);
+    c30 = vmlaq_n_f32(c30, b0, a[3]);
+    c31 = vmlaq_n_f32(c31, b1, a[3]);
+  }
+  if (accumulate) {
+    c00 = vaddq_f32(c00, vld1q_f32(c));
+    c01 = vaddq_f32(c01, vld1q_f32(c + 4));
+    c10 = vaddq_f32(c10, vld1q_f32(c + ldc));
+    c11 = vaddq_f32(c11, vld1q_f32(c + ldc + 4));
+    c20 = vaddq_f32(c20, vld1q_f32(c + 2 * ldc));
+    c21 = vaddq_f32(c21, vld1q_f32(c + 2 * ldc + 4));
+    c30 = vaddq_f32(c30, vld1q_f32(c + 3 * ldc));
+    c31 = vaddq_f32(c31, vld1q_f32(c + 3 * ldc + 4));
+  }
+  vst1q_f32(c, c00);
+  vst1q_f32(c + 4, c01);
+  vst1q_f32(c + ldc, c10);
+  vst1q_f32(c + ldc + 4, c11);
+  vst1q_f32(c + 2 * ldc, c20);
+  vst1q_f32(c + 2 * ldc + 4, c21);
+  vst1q_f32(c + 3 * ldc, c30);
+  vst1q_f32(c + 3 * ldc + 4, c31);
+}
+
+#else
+
+static void kernel(int kc, const float *a, const float *b, float *c, int ldc,
+                   int accumulate) {
+  float acc[SGEMM_MR][SGEMM_NR];
+  int l, r, j; // Iterators
+
+  memset(acc, 0, sizeof(acc));
+  for (l = 0; l < kc; l++, a += SGEMM_MR, b += SGEMM_NR) {
+    for (r = 0; r < SGEMM_MR; r++) {
+      const float x = a[r];
+      for (j = 0; j < SGEMM_NR; j++) {
+        acc[r][j] += x * b[j];
+      }
+    }
+  }
+  for (r = 0; r < SGEMM_MR; r++, c += ldc) {
+    for (j = 0; j < SGEMM_NR; j++) {
+      c[j] = accumulate ? c[j] + acc[r][j] : acc[r][j];
+    }
+  }
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Packing
+
+void sgemm_pack_panels(const float *matrix, int rows, int columns, int panel,
+                       float *packed) {
+  int panels = (rows + panel - 1) / panel;
+  int r, l; // Iterators
+
+  for (r = 0; r < panels * panel; r++) {
+    float *p = packed + (r / panel) * columns * panel + r % panel;
+    for (l = 0; l < columns; l++) {
+      p[l * panel] = r < rows ? matrix[r * columns + l] : 0.0f;
+    }
+  }
+}
+
+// Pack rows [i0, i0 + rows) and columns [l0, l0 + kc) of A into one panel of
+// SGEMM_MR rows.
+static void pack_a(const operand_t *a, int i0, int rows, int l0, int kc,
+                   float *packed) {
+  int r, l; // Iterators
+
+  if (rows < SGEMM_MR) {
+    memset(packed, 0, sizeof(float) * SGEMM_MR * kc);
+  }
+  if (a->col == 1) {
+    for (r = 0; r < rows; r++) {
+      const float *src = a->data + (i0 + r) * a->row + l0;
+      for (l = 0; l < kc; l++) {
+        packed[l * SGEMM_MR + r] = src[l];
+      }
+    }
+  } else {
+    for (l = 0; l < kc; l++) {
+      const float *src = a->data + i0 * a->row + (l0 + l) * a->col;
+      for (r = 0; r < rows; r++) {
+        packed[l * SGEMM_MR + r] = src[r * a->row];
+      }
+    }
+  }
+}
+
+// Pack rows [l0, l0 + kc) and columns [j0, j0 + nc) of B into panels of
+// SGEMM_NR columns.
+static void pack_b(const operand_t *b, int l0, int kc, int j0, int nc,
+                   float *packed) {
+  int jr, l, j; // Iterators
+
+  for (jr = 0; jr < nc; jr += SGEMM_NR) {
+    int cols = nc - jr < SGEMM_NR ? nc - jr : SGEMM_NR;
+    float *panel = packed + (jr / SGEMM_NR) * kc * SGEMM_NR;
+    if (cols < SGEMM_NR) {
+      memset(panel, 0, sizeof(float) * SGEMM_NR * kc);
+    }
+    if (b->half) {
+      // Each element is converted once per block.
+      for (j = 0; j < cols; j++) {
+        const uint16_t *src = b->half + l0 * b->row + (j0 + jr + j) * b->col;
+        for (l = 0; l < kc; l++) {
+          panel[l * SGEMM_NR + j] =
+              half_to_float(b->half_type, src[l * b->row]);
+        }
+      }
+    } else if (b->col == 1) {
+      for (l = 0; l < kc; l++) {
+        memcpy(panel + l * SGEMM_NR, b->data + (l0 + l) * b->row + j0 + jr,
+               sizeof(float) * cols);
+      }
+    } else {
+      for (j = 0; j < cols; j++) {
+        const float *src = b->data + l0 * b->row + (j0 + jr + j) * b->col;
+        for (l = 0; l < kc; l++) {
+          panel[l * SGEMM_NR + j] = src[l * b->row];
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Drivers
+
+// Columns [j, j + cols) of rows of C are multiplied with alpha and added
+// bias of each column. alpha and bias point to column j, or NULL.
+static void scale_columns(float *c, int ldc, int rows, int cols,
+                          const float *alpha, const float *bias) {
+  int r, j; // Iterators
+
+  for (r = 0; r < rows; r++, c += ldc) {
+    if (alpha) {
+      for (j = 0; j < cols; j++) {
+        c[j] *= alpha[j];
+      }
+    }
+    if (bias) {
+      for (j = 0; j < cols; j++) {
+        c[j] += bias[j];
+      }
+    }
+  }
+}
+
+// C = a * B for one row a of A.
+static void row_product(int n, int k, const operand_t *a, const operand_t *b,
+                        float *c) {
+  int jr, l, j; // Iterators
+
+  if (b->packed) {
+    for (jr = 0; jr < n; jr += SGEMM_NR) {
+      const float *panel = b->data + (jr / SGEMM_NR) * k * SGEMM_NR;
+      int cols = n - jr < SGEMM_NR ? n - jr : SGEMM_NR;
+      float acc[SGEMM_NR];
+      memset(acc, 0, sizeof(acc));
+      for (l = 0; l < k; l++, panel += SGEMM_NR) {
+        const float x = a->data[l * a->col];
+        for (j = 0; j < SGEMM_NR; j++) {
+          acc[j] += x * panel[j];
+        }
+      }
+      memcpy(c + jr, acc, sizeof(float) * cols);
+    }
+  } else if (b->row == 1 && a->col == 1) {
+    // Columns of B are contiguous.
+    sgemv(n, k, b->data, b->col, a->data, c);
+  } else {
+    memset(c, 0, sizeof(float) * n);
+    for (l = 0; l < k; l++) {
+      const float x = a->data[l * a->col];
+      const float *src = b->data + l * b->row;
+      for (j = 0; j < n; j++) {
+        c[j] += x * src[j * b->col];
+      }
+    }
+  }
+}
+
+// C = A * B, then columns are scaled while each tile is stored.
+static void gemm(int m, int n, int k, const operand_t *a, const operand_t *b,
+                 const float *alpha, const float *bias, float *c, int ldc) {
+  float packed_b[SGEMM_BLOCK_K * SGEMM_BLOCK_N];
+  float packed_a[SGEMM_MR * SGEMM_BLOCK_K];
+  float tile[SGEMM_MR * SGEMM_NR];
+  kernel_func_t run = kernel;
+  int jc, pc, ir, jr, r, j; // Iterators
+
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  if (k <= 0) {
+    for (r = 0; r < m; r++) {
+      memset(c + r * ldc, 0, sizeof(float) * n);
+    }
+    scale_columns(c, ldc, m, n, alpha, bias);
+    return;
+  }
+  if (m == 1 && !b->half) {
+    // Single row of C is still in cache when it is scaled.
+    row_product(n, k, a, b, c);
+    scale_columns(c, ldc, 1, n, alpha, bias);
+    return;
+  }
+#ifdef SGEMM_X86_DISPATCH
+  if (x86_cpu_features() & X86_FEATURE_AVX2) {
+    run = avx2_sgemm_kernel;
+  }
+#endif
+
+  for (jc = 0; jc < n; jc += SGEMM_BLOCK_N) {
+    int nc = n - jc < SGEMM_BLOCK_N ? n - jc : SGEMM_BLOCK_N;
+    for (pc = 0; pc < k; pc += SGEMM_BLOCK_K) {
+      int kc = k - pc < SGEMM_BLOCK_K ? k - pc : SGEMM_BLOCK_K;
+      int last = pc + kc == k && (alpha || bias);
+      const float *b_block = packed_b;
+      int b_stride = kc * SGEMM_NR; // Distance between panels of B.
+      if (b->packed) {
+        b_block = b->data + (jc / SGEMM_NR) * k * SGEMM_NR + pc * SGEMM_NR;
+        b_stride = k * SGEMM_NR;
+      } else {
+        pack_b(b, pc, kc, jc, nc, packed_b);
+      }
+
+      for (ir = 0; ir < m; ir += SGEMM_MR) {
+        int rows = m - ir < SGEMM_MR ? m - ir : SGEMM_MR;
+        const float *a_panel = packed_a;
+        if (a->packed) {
+          a_panel = a->data + (ir / SGEMM_MR) * k * SGEMM_MR + pc * SGEMM_MR;
+        } else {
+          pack_a(a, ir, rows, pc, kc, packed_a);
+        }
+
+        for (jr = 0; jr < nc; jr += SGEMM_NR) {
+          int cols = nc - jr < SGEMM_NR ? nc - jr : SGEMM_NR;
+          const float *b_panel = b_block + (jr / SGEMM_NR) * b_stride;
+          float *y = c + ir * ldc + jc + jr;
+          if (rows == SGEMM_MR && cols == SGEMM_NR) {
+            run(kc, a_panel, b_panel, y, ldc, pc > 0);
+          } else {
+            // Edge tile is calculated in local buffer.
+            run(kc, a_panel, b_panel, tile, SGEMM_NR, 0);
+            for (r = 0; r < rows; r++) {
+              for (j = 0; j < cols; j++) {
+                y[r * ldc + j] = pc > 0
+                                     ? y[r * ldc + j] + tile[r * SGEMM_NR + j]
+                                     : tile[r * SGEMM_NR + j];
+              }
+            }
+          }
+          if (last) {
+            scale_columns(y, ldc, rows, cols, alpha ? alpha + jc + jr : 0,
+                          bias ? bias + jc + jr : 0);
+          }
+        }
+      }
+    }
+  }
+}
+
+void sgemm(int m, int n, int k, const float *a, int a_row, int a_col,
+           const float *b, int b_row, int b_col, float *c, int ldc) {
+  operand_t oa = {a, a_row, a_col, 0};
+  operand_t ob = {b, b_row, b_col, 0};
+  gemm(m, n, k, &oa, &ob, 0, 0, c, ldc);
+}
+
+void sgemm_scaled(int m, int n, int k, const float *a, int a_row, int a_col,
+                  const float *b, int b_row, int b_col, const float *alpha,
+                  const float *bias, float *c, int ldc) {
+  operand_t oa = {a, a_row, a_col, 0};
+  operand_t ob = {b, b_row, b_col, 0};
+  gemm(m, n, k, &oa, &ob, alpha, bias, c, ldc);
+}
+
+void sgemm_half_b_scaled(int m, int n, int k, const float *a, int a_row,
+                         int a_col, const uint16_t *b, nn_data_type_t b_type,
+                         int b_row, int b_col, const float *alpha,
+                         const float *bias, float *c, int ldc) {
+  operand_t oa = {a, a_row, a_col, 0};
+  operand_t ob = {0, b_row, b_col, 0, b, b_type};
+  gemm(m, n, k, &oa, &ob, alpha, bias, c, ldc);
+}
+
+void sgemm_packed_a(int m, int n, int k, const float *a, const float *b,
+                    int b_row, int b_col, float *c, int ldc) {
+  // Strides address rows of first panel, they are used for single row A.
+  operand_t oa = {a, 1, SGEMM_MR, 1};
+  operand_t ob = {b, b_row, b_col, 0};
+  gemm(m, n, k, &oa, &ob, 0, 0, c, ldc);
+}
+
+void sgemm_packed_b(int m, int n, int k, const float *a, int a_row, int a_col,
+                    const float *b, float *c, int ldc) {
+  operand_t oa = {a, a_row, a_col, 0};
+  operand_t ob = {b, SGEMM_NR, 1, 1};
+  gemm(m, n, k, &oa, &ob, 0, 0, c, ldc);
+}
+
+void sgemm_packed_b_scaled(int m, int n, int k, const float *a, int a_row,
+                           int a_col, const float *b, const float *alpha,
+                           const float *bias, float *c, int ldc) {
+  operand_t oa = {a, a_row, a_col, 0};
+  operand_t ob = {b, SGEMM_NR, 1, 1};
+  gemm(m, n, k, &oa, &ob, alpha, bias, c, ldc);
+}
+
+void sgemv(int m, int k, const float *a, int lda, const float *x, float *y) {
+  int i, r, l, j; // Iterators
+
+#ifdef SGEMM_X86_DISPATCH
+  if (x86_cpu_features() & X86_FEATURE_AVX2) {
+    avx2_sgemv(m, k, a, lda, x, y);
+    return;
+  }
+#endif
+
+  for (i = 0; i < m; i += SGEMV_ROWS) {
+    int rows = m - i < SGEMV_ROWS ? m - i : SGEMV_ROWS;
+    const float *row[SGEMV_ROWS];
+    float acc[SGEMV_ROWS][SGEMV_LANES];
+    float total[SGEMV_ROWS][SGEMV_LANES];
+    for (r = 0; r < SGEMV_ROWS; r++) {
+      // Missing rows repeat the first row, their sums are not stored.
+      row[r] = a + (i + (r < rows ? r : 0)) * lda;
+    }
+    memset(total, 0, sizeof(total));
+    // Lanes are summed for each depth block of sgemm(), then added to total,
+    // so that long rows do not add small products to one large sum.
+    for (l = 0; l + SGEMV_LANES <= k;) {
+      const int end = k - l < SGEMM_BLOCK_K ? k : l + SGEMM_BLOCK_K;
+      memset(acc, 0, sizeof(acc));
+      for (; l + SGEMV_LANES <= end; l += SGEMV_LANES) {
+        // Rows are separate streams, hardware prefetch may not follow all.
+        if (l + SGEMV_PREFETCH < k) {
+          for (r = 0; r < SGEMV_ROWS; r++) {
+            PREFETCH(row[r] + l + SGEMV_PREFETCH);
+          }
+        }
+        for (r = 0; r < SGEMV_ROWS; r++) {
+          for (j = 0; j < SGEMV_LANES; j++) {
+            acc[r][j] += row[r][l + j] * x[l + j];
+          }
+        }
+      }
+      for (r = 0; r < SGEMV_ROWS; r++) {
+        for (j = 0; j < SGEMV_LANES; j++) {
+          total[r][j] += acc[r][j];
+        }
+      }
+    }
+    for (r = 0; r < rows; r++) {
+      float sum = 0.0f;
+      for (j = 0; j < SGEMV_LANES; j++) {
+        sum += total[r][j];
+      }
+      for (j = l; j < k; j++) {
+        sum += row[r][j] * x[j];
+      }
+      y[i + r] = sum;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_SGEMM_H_181023120000_
+#define H_SGEMM_H_181023120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup SgemmFunction Sgemm Function
+/// Single precision matrix products shared by float kernels.
+///
+/// Products are calculated by MR x NR register tiles of micro-kernel for SSE,
+/// AVX2 or NEON selected by compiler flags, or portable C if none of them is
+/// available or NNABLART_SGEMM_PORTABLE is defined. SSE build with
+/// NNABLART_X86_DISPATCH runs AVX2 kernels of same tiles on CPUs which have
+/// it, see x86.h. Functions run in calling thread, caller splits rows or
+/// columns of C with rt_parallel_for().
+/// @{
+
+#if !defined(NNABLART_SGEMM_PORTABLE)
+#if defined(__AVX2__)
+#define SGEMM_AVX2
+#elif defined(__SSE__) || defined(_M_X64) ||                                   \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SGEMM_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SGEMM_NEON
+#endif
+#endif /* NNABLART_SGEMM_PORTABLE */
+
+/// Rows of A multiplied at once by micro-kernel.
+#define SGEMM_MR (4)
+
+/// Columns of B multiplied at once by micro-kernel.
+#ifdef SGEMM_AVX2
+#define SGEMM_NR (16)
+#else
+#define SGEMM_NR (8)
+#endif
+
+/// Pack rows x columns matrix into panels of panel rows. Element (r, l) is
+/// stored at ((r / panel) * columns + l) * panel + r % panel. Missing rows of
+/// last panel are zero.
+/// A packed with SGEMM_MR rows per panel, and transposed B packed with
+/// SGEMM_NR rows per panel are operands of sgemm_packed_a() and
+/// sgemm_packed_b().
+void sgemm_pack_panels(const float *matrix, int rows, int columns, int panel,
+                       float *packed);
+
+/// C = A * B, where A is m x k and B is k x n matrix.
+/// Element (i, l) of A is a[i * a_row + l * a_col], element (l, j) of B is
+/// b[l * b_row + j * b_col] and element (i, j) of C is c[i * ldc + j], so
+/// transposed operands are given by strides.
+void sgemm(int m, int n, int k, const float *a, int a_row, int a_col,
+           const float *b, int b_row, int b_col, float *c, int ldc);
+
+/// Same as sgemm(), then element (i, j) of C is multiplied with alpha[j] and
+/// added bias[j] while each tile of C is stored. alpha or bias may be NULL.
+void sgemm_scaled(int m, int n, int k, const float *a, int a_row, int a_col,
+                  const float *b, int b_row, int b_col, const float *alpha,
+                  const float *bias, float *c, int ldc);
+
+/// Same as sgemm_scaled() with B of NN_DATA_TYPE_FLOAT16 or
+/// NN_DATA_TYPE_BFLOAT16 given by b_type, elements of B are converted to
+/// float when blocks of B are packed.
+void sgemm_half_b_scaled(int m, int n, int k, const float *a, int a_row,
+                         int a_col, const uint16_t *b, nn_data_type_t b_type,
+                         int b_row, int b_col, const float *alpha,
+                         const float *bias, float *c, int ldc);
+
+/// Same as sgemm() with A packed by sgemm_pack_panels() into SGEMM_MR rows
+/// per panel. a points to the panel of row 0.
+void sgemm_packed_a(int m, int n, int k, const float *a, const float *b,
+                    int b_row, int b_col, float *c, int ldc);
+
+/// Same as sgemm() with transposed B packed by sgemm_pack_panels() into
+/// SGEMM_NR columns per panel. b points to the panel of column 0.
+void sgemm_packed_b(int m, int n, int k, const float *a, int a_row, int a_col,
+                    const float *b, float *c, int ldc);
+
+/// Same as sgemm_scaled() with B packed as sgemm_packed_b().
+void sgemm_packed_b_scaled(int m, int n, int k, const float *a, int a_row,
+                           int a_col, const float *b, const float *alpha,
+                           const float *bias, float *c, int ldc);
+
+/// y = A * x, where A is m x k matrix and element (i, l) of A is
+/// a[i * lda + l].
+void sgemv(int m, int k, const float *a, int lda, const float *x, float *y);
+
+/// @}
+
+#endif // H_SGEMM_H_181023120000_
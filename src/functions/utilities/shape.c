@@ -68,6 +68,9 @@ rt_list_t calc_contiguous_strides(rt_list_t shape) {
   }
   rt_list_t strides = allocate_list(shape.size);
   int i;
+  if (strides.data == 0) {
+    return strides;
+  }
   for (i = 0; i < shape.size; ++i) {
     strides.data[i] = 1;
   }
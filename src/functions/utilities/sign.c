@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sign.h"
+#include "accessor.h"
+
+#include <string.h>
+
+void pack_sign_rows(const uint32_t *data, int rows, int size,
+                    uint32_t *packed) {
+  int words = SIGN_WORDS(size);
+  int o, r; // Iterator
+
+  memset(packed, 0, sizeof(uint32_t) * rows * words);
+  for (o = 0; o < rows; o++) {
+    uint32_t *row = packed + o * words;
+    for (r = 0; r < size; r++) {
+      row[r / 32] |= (uint32_t)SIGN_BIT(data, o * size + r) << (r % 32);
+    }
+  }
+}
+
+void pack_binary_sign(const rt_variable_t *input, int size, uint32_t *words) {
+  float block[32];
+  int i, k; // Iterator
+
+  for (i = 0; i < size; i += 32) {
+    int n = size - i < 32 ? size - i : 32;
+    const float *x = block;
+    uint32_t bits = 0;
+    if (input->type == NN_DATA_TYPE_FLOAT) {
+      x = (const float *)(input->data) + i;
+    } else {
+      get_variable_block(input, i, n, block);
+    }
+    // Same as round((x + 1) / 2) of clamped value is 1.
+    for (k = 0; k < n; k++) {
+      bits |= (uint32_t)(x[k] + 1.0f >= 1.0f) << k;
+    }
+    words[i / 32] = bits;
+  }
+}
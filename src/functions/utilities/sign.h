@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_SIGN_H_181120120000_
+#define H_SIGN_H_181120120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup SignFunction Sign Function
+/// @{
+
+/// Number of set bits in 32 bit word.
+#if defined(__GNUC__) || defined(__clang__)
+#define POPCOUNT32(x) __builtin_popcount(x)
+#else
+static inline int POPCOUNT32(uint32_t x) {
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  x = (x + (x >> 4)) & 0x0f0f0f0f;
+  return (int)((x * 0x01010101) >> 24);
+}
+#endif
+
+/// Bit at pos of SIGN data, 1 means +1 and 0 means -1.
+#define SIGN_BIT(data, pos) (((data)[(pos) / 32] >> ((pos) % 32)) & 1)
+
+/// Number of words holding size bits.
+#define SIGN_WORDS(size) (((size) + 31) / 32)
+
+/// Copy rows of size bits from data into packed, each row starts at a word
+/// boundary and unused bits of its last word are cleared.
+void pack_sign_rows(const uint32_t *data, int rows, int size,
+                    uint32_t *packed);
+
+/// Binarize size values of input into SIGN words 32 values at a time. Bit is
+/// set where BinaryTanh gives +1 and BinarySigmoid gives 1, and unused bits
+/// of last word are cleared.
+void pack_binary_sign(const rt_variable_t *input, int size, uint32_t *words);
+
+/// @}
+
+#endif // H_SIGN_H_181120120000_
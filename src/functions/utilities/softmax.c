@@ -0,0 +1,255 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "softmax.h"
+#include "accessor.h"
+#include "shape.h"
+#include "vector_math.h"
+
+#include <math.h>
+
+// Values of LogSoftmax whose exp is calculated at a time when axis is not
+// innermost.
+#define SOFTMAX_BLOCK_SIZE (256)
+
+typedef struct {
+  softmax_param_t *param;
+  const float *x;
+  float *y;
+} softmax_job_t;
+
+rt_function_error_t allocate_softmax_param(rt_function_t *f, int axis, int log,
+                                           int is_float,
+                                           softmax_param_t *param) {
+  const int size = calc_shape_size(f->inputs[0]->shape);
+  int size_axis;
+
+  // axis must be less than ndim of inputs[0].
+  if (f->inputs[0]->shape.size <= axis) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  size_axis = axis <= 0 ? size : shape_product_of(f->inputs[0], axis,
+                                                  f->inputs[0]->shape.size);
+  param->batch_size = size / size_axis;
+  param->specified_axis_size = f->inputs[0]->shape.data[axis];
+  param->output_size =
+      size / param->batch_size / param->specified_axis_size;
+  if (param->batch_size * param->specified_axis_size * param->output_size !=
+      size) {
+    return RT_FUNCTION_ERROR_INVALID_SHAPE;
+  }
+  param->log = log;
+  param->fast = is_float && is_fast_math();
+  param->work = 0;
+  param->sample = 0;
+  if (param->output_size > 1) {
+    param->work = rt_malloc_func(sizeof(float) * 2 * param->output_size);
+    if (param->work == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  if (!is_float) {
+    param->sample = rt_malloc_func(sizeof(float) * size_axis);
+    if (param->sample == 0) {
+      free_softmax_param(param);
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_softmax_param(softmax_param_t *param) {
+  if (param->work) {
+    rt_free_func(param->work);
+    param->work = 0;
+  }
+  if (param->sample) {
+    rt_free_func(param->sample);
+    param->sample = 0;
+  }
+}
+
+// Axis is innermost, so each sample is one contiguous row.
+static void calc_rows(void *arg, int begin, int end) {
+  const softmax_job_t *job = (const softmax_job_t *)arg;
+  const softmax_param_t *p = job->param;
+  const int n = p->specified_axis_size;
+  int sample_index, i; // Iterator
+
+  for (sample_index = begin; sample_index < end; ++sample_index) {
+    const float *const x = job->x + sample_index * n;
+    float *const y = job->y + sample_index * n;
+    const float max_input = vector_max(x, n);
+    float exp_sum;
+    if (p->log) {
+      // exp is only summed, y keeps x until log of sum is known.
+      exp_sum = p->fast ? vector_exp_sum_fast(x, 0, n, max_input)
+                        : vector_exp_sum(x, 0, n, max_input);
+      const float log_sum = logf(exp_sum);
+      for (i = 0; i < n; i++) {
+        y[i] = (x[i] - max_input) - log_sum;
+      }
+    } else if (p->fast) {
+      const float scale = 1.0f / vector_exp_sum_fast(x, y, n, max_input);
+      for (i = 0; i < n; i++) {
+        y[i] *= scale;
+      }
+    } else {
+      exp_sum = vector_exp_sum(x, y, n, max_input);
+      for (i = 0; i < n; i++) {
+        y[i] /= exp_sum;
+      }
+    }
+  }
+}
+
+// Axis is not innermost. Each row of axis is contiguous over output index, and
+// max and sum are kept for each output index.
+static void calc_sample(softmax_param_t *p, const float *x, float *y) {
+  const int specified_axis_size = p->specified_axis_size;
+  const int output_size = p->output_size;
+  float *const max_input = p->work;
+  float *const exp_sum = p->work + output_size;
+  float block[SOFTMAX_BLOCK_SIZE];
+  int specified_index, output_index, begin; // Iterator
+
+  for (output_index = 0; output_index < output_size; ++output_index) {
+    max_input[output_index] = x[output_index];
+    exp_sum[output_index] = 0.0f;
+  }
+  for (specified_index = 1; specified_index < specified_axis_size;
+       ++specified_index) {
+    const float *const row = x + specified_index * output_size;
+    for (output_index = 0; output_index < output_size; ++output_index) {
+      const float v = row[output_index];
+      max_input[output_index] =
+          max_input[output_index] < v ? v : max_input[output_index];
+    }
+  }
+  if (p->log) {
+    // y keeps x until log of sum is known, so exp is summed through block.
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      const float *const row = x + specified_index * output_size;
+      for (begin = 0; begin < output_size; begin += SOFTMAX_BLOCK_SIZE) {
+        int n = output_size - begin;
+        if (n > SOFTMAX_BLOCK_SIZE) {
+          n = SOFTMAX_BLOCK_SIZE;
+        }
+        for (output_index = 0; output_index < n; ++output_index) {
+          block[output_index] =
+              row[begin + output_index] - max_input[begin + output_index];
+        }
+        if (p->fast) {
+          vector_exp_fast(block, block, n);
+        } else {
+          vector_exp(block, block, n);
+        }
+        for (output_index = 0; output_index < n; ++output_index) {
+          exp_sum[begin + output_index] += block[output_index];
+        }
+      }
+    }
+  } else {
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      const float *const row = x + specified_index * output_size;
+      float *const out = y + specified_index * output_size;
+      for (output_index = 0; output_index < output_size; ++output_index) {
+        out[output_index] = row[output_index] - max_input[output_index];
+      }
+    }
+    if (p->fast) {
+      vector_exp_fast(y, y, specified_axis_size * output_size);
+    } else {
+      vector_exp(y, y, specified_axis_size * output_size);
+    }
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      const float *const out = y + specified_index * output_size;
+      for (output_index = 0; output_index < output_size; ++output_index) {
+        exp_sum[output_index] += out[output_index];
+      }
+    }
+  }
+  if (p->log) {
+    for (output_index = 0; output_index < output_size; ++output_index) {
+      exp_sum[output_index] = logf(exp_sum[output_index]);
+    }
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      const float *const row = x + specified_index * output_size;
+      float *const out = y + specified_index * output_size;
+      for (output_index = 0; output_index < output_size; ++output_index) {
+        out[output_index] = (row[output_index] - max_input[output_index]) -
+                            exp_sum[output_index];
+      }
+    }
+  } else if (p->fast) {
+    for (output_index = 0; output_index < output_size; ++output_index) {
+      exp_sum[output_index] = 1.0f / exp_sum[output_index];
+    }
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      float *const out = y + specified_index * output_size;
+      for (output_index = 0; output_index < output_size; ++output_index) {
+        out[output_index] *= exp_sum[output_index];
+      }
+    }
+  } else {
+    for (specified_index = 0; specified_index < specified_axis_size;
+         ++specified_index) {
+      float *const out = y + specified_index * output_size;
+      for (output_index = 0; output_index < output_size; ++output_index) {
+        out[output_index] /= exp_sum[output_index];
+      }
+    }
+  }
+}
+
+void calc_softmax(softmax_param_t *param, const float *x, float *y) {
+  const int sample_size = param->specified_axis_size * param->output_size;
+  int sample_index; // Iterator
+
+  if (param->output_size == 1) {
+    softmax_job_t job;
+    job.param = param;
+    job.x = x;
+    job.y = y;
+    rt_parallel_for(param->batch_size, sample_size * 4, calc_rows, &job);
+    return;
+  }
+  for (sample_index = 0; sample_index < param->batch_size; ++sample_index) {
+    calc_sample(param, x + sample_index * sample_size,
+                y + sample_index * sample_size);
+  }
+}
+
+void calc_softmax_generic(softmax_param_t *param, rt_variable_t *input,
+                          rt_variable_t *output) {
+  const int sample_size = param->specified_axis_size * param->output_size;
+  const int batch_size = param->batch_size;
+  int sample_index; // Iterator
+
+  // Samples are converted and calculated one by one in float copy.
+  param->batch_size = 1;
+  for (sample_index = 0; sample_index < batch_size; ++sample_index) {
+    get_variable_block(input, sample_index * sample_size, sample_size,
+                       param->sample);
+    calc_softmax(param, param->sample, param->sample);
+    set_variable_block(output, sample_index * sample_size, sample_size,
+                       param->sample);
+  }
+  param->batch_size = batch_size;
+}
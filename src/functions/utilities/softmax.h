@@ -0,0 +1,58 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_SOFTMAX_H_181220120000_
+#define H_SOFTMAX_H_181220120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup SoftmaxFunction Softmax Function
+/// Softmax and LogSoftmax of float values along an axis.
+/// @{
+
+/// Shape and work area of Softmax or LogSoftmax, built at allocation.
+typedef struct {
+  int batch_size;          ///< Number of samples before axis.
+  int specified_axis_size; ///< Size of axis.
+  int output_size;         ///< Elements after axis, 1 if axis is innermost.
+  int log;                 ///< Calculate LogSoftmax.
+  int fast;                ///< Approximate exp and multiply by reciprocal.
+  float *work;   ///< Max and sum for each output index if output_size > 1.
+  float *sample; ///< Float copy of a sample for generic functions.
+} softmax_param_t;
+
+/// Fill param for inputs[0] of f along axis, allocating work areas. Fast
+/// approximations are selected if is_float is non zero and is_fast_math().
+/// Float copy of a sample is allocated if is_float is zero.
+rt_function_error_t allocate_softmax_param(rt_function_t *f, int axis, int log,
+                                           int is_float,
+                                           softmax_param_t *param);
+
+/// Free work areas of param.
+void free_softmax_param(softmax_param_t *param);
+
+/// Calculate Softmax or LogSoftmax of float x into y, which may be same.
+void calc_softmax(softmax_param_t *param, const float *x, float *y);
+
+/// Calculate Softmax or LogSoftmax of input of any type into output,
+/// converting a sample at a time.
+void calc_softmax_generic(softmax_param_t *param, rt_variable_t *input,
+                          rt_variable_t *output);
+
+/// @}
+
+#endif // H_SOFTMAX_H_181220120000_
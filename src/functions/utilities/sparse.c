@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparse.h"
+#include "shape.h"
+
+#include <string.h>
+
+void get_block_sparse(const rt_variable_t *variable, block_sparse_t *sparse) {
+  const nn_block_sparse_t *header = (const nn_block_sparse_t *)variable->data;
+  const int32_t *arrays = (const int32_t *)(header + 1);
+
+  sparse->rows = header->rows;
+  sparse->columns = header->columns;
+  sparse->block_size = header->block_size;
+  sparse->row_offsets = arrays;
+  sparse->block_columns = arrays + header->rows + 1;
+  sparse->values =
+      (const float *)(sparse->block_columns + header->num_of_blocks);
+}
+
+void rt_expand_block_sparse(const rt_variable_t *variable, float *dense) {
+  block_sparse_t s;
+  int r, b; // Iterator
+
+  get_block_sparse(variable, &s);
+  memset(dense, 0, sizeof(float) * s.rows * s.columns);
+  for (r = 0; r < s.rows; r++) {
+    for (b = s.row_offsets[r]; b < s.row_offsets[r + 1]; b++) {
+      memcpy(dense + r * s.columns + s.block_columns[b],
+             s.values + b * s.block_size, sizeof(float) * s.block_size);
+    }
+  }
+}
+
+rt_function_error_t expand_sparse_variable(const rt_variable_t *variable,
+                                           rt_variable_t *dense) {
+  *dense = *variable;
+  dense->layout = NN_DATA_LAYOUT_DENSE;
+  dense->data = rt_malloc_func(sizeof(float) * calc_shape_size(dense->shape));
+  if (dense->data == 0) {
+    return RT_FUNCTION_ERROR_MALLOC;
+  }
+  rt_expand_block_sparse(variable, (float *)(dense->data));
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_dense_variable(rt_variable_t *dense) {
+  if (dense->data != 0) {
+    rt_free_func(dense->data);
+    dense->data = 0;
+  }
+}
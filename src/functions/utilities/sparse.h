@@ -0,0 +1,49 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_SPARSE_H_181127120000_
+#define H_SPARSE_H_181127120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup SparseFunction Sparse Function
+/// @{
+
+/// Arrays of NN_DATA_LAYOUT_BLOCK_SPARSE data.
+typedef struct {
+  int rows;                     ///< Size of first axis.
+  int columns;                  ///< Size of other axes.
+  int block_size;               ///< Columns in one block.
+  const int32_t *row_offsets;   ///< First block of each row, and end.
+  const int32_t *block_columns; ///< First column of each block.
+  const float *values;          ///< block_size values of each block.
+} block_sparse_t;
+
+/// Read arrays following header of block sparse variable.
+void get_block_sparse(const rt_variable_t *variable, block_sparse_t *sparse);
+
+/// Make dense copy of block sparse variable, data of dense is allocated and
+/// freed with free_dense_variable().
+rt_function_error_t expand_sparse_variable(const rt_variable_t *variable,
+                                           rt_variable_t *dense);
+
+/// Free data of variable made by expand_sparse_variable().
+void free_dense_variable(rt_variable_t *dense);
+
+/// @}
+
+#endif // H_SPARSE_H_181127120000_
@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_SPECIALIZED_H_181105120000_
+#define H_SPECIALIZED_H_181105120000_
+
+#include <nnablart/config.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup SpecializedKernels Specialized Kernels
+/// @{
+///
+/// Shapes for which float kernels are compiled with constant kernel size and
+/// stride, as lists of X(kernel, stride) for square kernels with same stride
+/// for both axes. Each entry makes one copy of the kernel whose loops have
+/// constant trip counts, so that compiler unrolls and vectorizes them, and
+/// functions pick the copy for their shape when they are allocated. Other
+/// shapes run kernels which read sizes at run time.
+///
+/// config.h written by build-tools/code-generator/generate_config.py lists
+/// shapes of given networks, otherwise lists below are used. They can also
+/// be defined by compiler options.
+
+/// Direct 2D Convolution, X(kernel, stride, block) where block output maps
+/// of a group share each load of input. The first entry with block dividing
+/// output maps of group is used.
+#ifndef NNABLART_SPECIALIZED_CONVOLUTION
+#define NNABLART_SPECIALIZED_CONVOLUTION(X)                                    \
+  X(3, 1, 4) X(3, 1, 1) X(3, 2, 4) X(3, 2, 1)
+#endif
+
+/// Max block of NNABLART_SPECIALIZED_CONVOLUTION.
+#define SPECIALIZED_CONVOLUTION_MAX_BLOCK (8)
+
+/// 2D DepthwiseConvolution. Others are executed as Convolution.
+#ifndef NNABLART_SPECIALIZED_DEPTHWISE_CONVOLUTION
+#define NNABLART_SPECIALIZED_DEPTHWISE_CONVOLUTION(X)                          \
+  X(3, 1) X(3, 2) X(5, 1) X(5, 2)
+#endif
+
+/// Windows inside of input of 2D MaxPooling, AveragePooling and SumPooling.
+#ifndef NNABLART_SPECIALIZED_POOLING
+#define NNABLART_SPECIALIZED_POOLING(X) X(2, 1) X(2, 2) X(3, 1) X(3, 2)
+#endif
+
+/// @}
+
+#endif // H_SPECIALIZED_H_181105120000_
@@ -0,0 +1,945 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vector_math.h"
+#include "neon.h"
+#include "thread_local.h"
+
+#include <math.h>
+
+static THREAD_LOCAL rt_math_mode_t current_math_mode = RT_MATH_MODE_EXACT;
+
+rt_math_mode_t rt_set_math_mode(rt_math_mode_t mode) {
+  rt_math_mode_t previous = current_math_mode;
+  current_math_mode = mode;
+  return previous;
+}
+
+int is_fast_math(void) { return current_math_mode == RT_MATH_MODE_FAST; }
+
+#if defined(__AVX2__)
+#define VECTOR_MATH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(NNABLART_NEON)
+#define VECTOR_MATH_NEON
+#endif
+
+#define VECTOR_SUM_BLOCK (256) // Values added by lanes before pairwise sum
+#define VECTOR_SUM_LEVELS (32) // Partial sums kept by pairwise sum
+
+#if defined(VECTOR_MATH_AVX2) || defined(VECTOR_MATH_SSE2) ||                  \
+    defined(VECTOR_MATH_NEON)
+
+////////////////////////////////////////////////////////////////////////////////
+// Lane operations. Masks have all bits set in lanes where they are true.
+// Multiply and add are not fused, so that SSE2 and AVX2 give same results.
+
+#ifdef VECTOR_MATH_AVX2
+#define VECTOR_LANES (8)
+typedef __m256 vf_t;  // float
+typedef __m256i vi_t; // int32
+typedef __m256 vm_t;  // mask
+
+#define V_SHL(a, n) _mm256_slli_epi32(a, n)
+#define V_SAR(a, n) _mm256_srai_epi32(a, n)
+
+static inline vf_t v_set(float a) { return _mm256_set1_ps(a); }
+static inline vf_t v_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void v_store(float *p, vf_t a) { _mm256_storeu_ps(p, a); }
+static inline vf_t v_add(vf_t a, vf_t b) { return _mm256_add_ps(a, b); }
+static inline vf_t v_sub(vf_t a, vf_t b) { return _mm256_sub_ps(a, b); }
+static inline vf_t v_mul(vf_t a, vf_t b) { return _mm256_mul_ps(a, b); }
+static inline vf_t v_div(vf_t a, vf_t b) { return _mm256_div_ps(a, b); }
+static inline vf_t v_rcp(vf_t a) { return _mm256_rcp_ps(a); }
+static inline vf_t v_min(vf_t a, vf_t b) { return _mm256_min_ps(a, b); }
+static inline vf_t v_max(vf_t a, vf_t b) { return _mm256_max_ps(a, b); }
+static inline vf_t v_reverse(vf_t a) {
+  return _mm256_permutevar8x32_ps(a, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+static inline vm_t v_lt(vf_t a, vf_t b) {
+  return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+}
+static inline vm_t v_eq(vf_t a, vf_t b) {
+  return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+}
+static inline vm_t v_isnan(vf_t a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+static inline vf_t v_select(vm_t m, vf_t a, vf_t b) {
+  return _mm256_blendv_ps(b, a, m);
+}
+static inline vf_t v_abs(vf_t a) {
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+}
+static inline vf_t v_copysign(vf_t a, vf_t sign) {
+  vf_t s = _mm256_set1_ps(-0.0f);
+  return _mm256_or_ps(_mm256_andnot_ps(s, a), _mm256_and_ps(s, sign));
+}
+static inline vi_t v_iset(int a) { return _mm256_set1_epi32(a); }
+static inline vi_t v_iadd(vi_t a, vi_t b) { return _mm256_add_epi32(a, b); }
+static inline vi_t v_isub(vi_t a, vi_t b) { return _mm256_sub_epi32(a, b); }
+static inline vi_t v_iand(vi_t a, vi_t b) { return _mm256_and_si256(a, b); }
+static inline vi_t v_ior(vi_t a, vi_t b) { return _mm256_or_si256(a, b); }
+static inline vi_t v_iselect(vm_t m, vi_t a, vi_t b) {
+  return _mm256_blendv_epi8(b, a, _mm256_castps_si256(m));
+}
+static inline vf_t v_bits_to_float(vi_t a) { return _mm256_castsi256_ps(a); }
+static inline vi_t v_float_to_bits(vf_t a) { return _mm256_castps_si256(a); }
+static inline vf_t v_to_float(vi_t a) { return _mm256_cvtepi32_ps(a); }
+static inline vi_t v_truncate(vf_t a) { return _mm256_cvttps_epi32(a); }
+#endif /* VECTOR_MATH_AVX2 */
+
+#ifdef VECTOR_MATH_SSE2
+#define VECTOR_LANES (4)
+typedef __m128 vf_t;  // float
+typedef __m128i vi_t; // int32
+typedef __m128 vm_t;  // mask
+
+#define V_SHL(a, n) _mm_slli_epi32(a, n)
+#define V_SAR(a, n) _mm_srai_epi32(a, n)
+
+static inline vf_t v_set(float a) { return _mm_set1_ps(a); }
+static inline vf_t v_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void v_store(float *p, vf_t a) { _mm_storeu_ps(p, a); }
+static inline vf_t v_add(vf_t a, vf_t b) { return _mm_add_ps(a, b); }
+static inline vf_t v_sub(vf_t a, vf_t b) { return _mm_sub_ps(a, b); }
+static inline vf_t v_mul(vf_t a, vf_t b) { return _mm_mul_ps(a, b); }
+static inline vf_t v_div(vf_t a, vf_t b) { return _mm_div_ps(a, b); }
+static inline vf_t v_rcp(vf_t a) { return _mm_rcp_ps(a); }
+static inline vf_t v_min(vf_t a, vf_t b) { return _mm_min_ps(a, b); }
+static inline vf_t v_max(vf_t a, vf_t b) { return _mm_max_ps(a, b); }
+static inline vf_t v_reverse(vf_t a) {
+  return _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 1, 2, 3));
+}
+static inline vm_t v_lt(vf_t a, vf_t b) { return _mm_cmplt_ps(a, b); }
+static inline vm_t v_eq(vf_t a, vf_t b) { return _mm_cmpeq_ps(a, b); }
+static inline vm_t v_isnan(vf_t a) { return _mm_cmpunord_ps(a, a); }
+static inline vf_t v_select(vm_t m, vf_t a, vf_t b) {
+  return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+static inline vf_t v_abs(vf_t a) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+static inline vf_t v_copysign(vf_t a, vf_t sign) {
+  vf_t s = _mm_set1_ps(-0.0f);
+  return _mm_or_ps(_mm_andnot_ps(s, a), _mm_and_ps(s, sign));
+}
+static inline vi_t v_iset(int a) { return _mm_set1_epi32(a); }
+static inline vi_t v_iadd(vi_t a, vi_t b) { return _mm_add_epi32(a, b); }
+static inline vi_t v_isub(vi_t a, vi_t b) { return _mm_sub_epi32(a, b); }
+static inline vi_t v_iand(vi_t a, vi_t b) { return _mm_and_si128(a, b); }
+static inline vi_t v_ior(vi_t a, vi_t b) { return _mm_or_si128(a, b); }
+static inline vi_t v_iselect(vm_t m, vi_t a, vi_t b) {
+  vi_t mi = _mm_castps_si128(m);
+  return _mm_or_si128(_mm_and_si128(mi, a), _mm_andnot_si128(mi, b));
+}
+static inline vf_t v_bits_to_float(vi_t a) { return _mm_castsi128_ps(a); }
+static inline vi_t v_float_to_bits(vf_t a) { return _mm_castps_si128(a); }
+static inline vf_t v_to_float(vi_t a) { return _mm_cvtepi32_ps(a); }
+static inline vi_t v_truncate(vf_t a) { return _mm_cvttps_epi32(a); }
+#endif /* VECTOR_MATH_SSE2 */
+
+#ifdef VECTOR_MATH_NEON
+#define VECTOR_LANES (4)
+typedef float32x4_t vf_t; // float
+typedef int32x4_t vi_t;   // int32
+typedef uint32x4_t vm_t;  // mask
+
+#define V_SHL(a, n) vshlq_n_s32(a, n)
+#define V_SAR(a, n) vshrq_n_s32(a, n)
+
+static inline vf_t v_set(float a) { return vdupq_n_f32(a); }
+static inline vf_t v_load(const float *p) { return vld1q_f32(p); }
+static inline void v_store(float *p, vf_t a) { vst1q_f32(p, a); }
+static inline vf_t v_add(vf_t a, vf_t b) { return vaddq_f32(a, b); }
+static inline vf_t v_sub(vf_t a, vf_t b) { return vsubq_f32(a, b); }
+static inline vf_t v_mul(vf_t a, vf_t b) { return vmulq_f32(a, b); }
+static inline vf_t v_div(vf_t a, vf_t b) {
+#if defined(__aarch64__)
+  return vdivq_f32(a, b);
+#else
+  // Reciprocal estimate refined by two Newton-Raphson steps. Infinity is
+  // replaced by FLT_MAX, whose reciprocal estimate is 0, to avoid inf * 0.
+  vf_t r;
+  b = vbslq_f32(vceqq_f32(vabsq_f32(b), vdupq_n_f32(INFINITY)),
+                vbslq_f32(vdupq_n_u32(0x80000000u), b,
+                          vdupq_n_f32(3.40282347e+38f)),
+                b);
+  r = vrecpeq_f32(b);
+  r = vmulq_f32(r, vrecpsq_f32(b, r));
+  r = vmulq_f32(r, vrecpsq_f32(b, r));
+  return vmulq_f32(a, r);
+#endif
+}
+static inline vf_t v_rcp(vf_t a) {
+  // 8 bit estimate refined by one Newton-Raphson step.
+  vf_t r = vrecpeq_f32(a);
+  return vmulq_f32(r, vrecpsq_f32(a, r));
+}
+static inline vf_t v_min(vf_t a, vf_t b) { return vminq_f32(a, b); }
+static inline vf_t v_max(vf_t a, vf_t b) { return vmaxq_f32(a, b); }
+static inline vf_t v_reverse(vf_t a) {
+  const vf_t r = vrev64q_f32(a);
+  return vcombine_f32(vget_high_f32(r), vget_low_f32(r));
+}
+static inline vm_t v_lt(vf_t a, vf_t b) { return vcltq_f32(a, b); }
+static inline vm_t v_eq(vf_t a, vf_t b) { return vceqq_f32(a, b); }
+static inline vm_t v_isnan(vf_t a) { return vmvnq_u32(vceqq_f32(a, a)); }
+static inline vf_t v_select(vm_t m, vf_t a, vf_t b) {
+  return vbslq_f32(m, a, b);
+}
+static inline vf_t v_abs(vf_t a) { return vabsq_f32(a); }
+static inline vf_t v_copysign(vf_t a, vf_t sign) {
+  return vbslq_f32(vdupq_n_u32(0x80000000u), sign, a);
+}
+static inline vi_t v_iset(int a) { return vdupq_n_s32(a); }
+static inline vi_t v_iadd(vi_t a, vi_t b) { return vaddq_s32(a, b); }
+static inline vi_t v_isub(vi_t a, vi_t b) { return vsubq_s32(a, b); }
+static inline vi_t v_iand(vi_t a, vi_t b) { return vandq_s32(a, b); }
+static inline vi_t v_ior(vi_t a, vi_t b) { return vorrq_s32(a, b); }
+static inline vi_t v_iselect(vm_t m, vi_t a, vi_t b) {
+  return vbslq_s32(m, a, b);
+}
+static inline vf_t v_bits_to_float(vi_t a) { return vreinterpretq_f32_s32(a); }
+static inline vi_t v_float_to_bits(vf_t a) { return vreinterpretq_s32_f32(a); }
+static inline vf_t v_to_float(vi_t a) { return vcvtq_f32_s32(a); }
+static inline vi_t v_truncate(vf_t a) { return vcvtq_s32_f32(a); }
+#endif /* VECTOR_MATH_NEON */
+
+// a * b + c
+static inline vf_t v_madd(vf_t a, vf_t b, vf_t c) {
+  return v_add(v_mul(a, b), c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Kernels.
+
+/*
+ * exp(x) = 2^n * exp(r) where n = round(x / log(2)) and
+ * r = x - n * log(2) is in [-log(2)/2, log(2)/2]. exp(r) is approximated by
+ * polynomial of Cephes expf. 2^n is applied as 2^(n/2) * 2^(n - n/2) so that
+ * both factors are normal for all n from overflow down to underflow.
+ */
+
+#define EXP_HI (89.0f)   // exp() of larger value is infinity
+#define EXP_LO (-104.0f) // exp() of smaller value is 0
+
+static inline vf_t v_exp(vf_t x) {
+  vf_t c = v_max(v_min(x, v_set(EXP_HI)), v_set(EXP_LO));
+  vf_t fx = v_madd(c, v_set(1.44269504088896341f), v_set(0.5f));
+  vi_t n = v_truncate(fx);
+
+  // Truncation rounds negative values up, floor() is one less for them.
+  n = v_iselect(v_lt(fx, v_to_float(n)), v_isub(n, v_iset(1)), n);
+  fx = v_to_float(n);
+
+  // log(2) is split into two parts to keep precision of r.
+  vf_t r = v_sub(c, v_mul(fx, v_set(0.693359375f)));
+  r = v_sub(r, v_mul(fx, v_set(-2.12194440e-4f)));
+
+  vf_t y = v_set(1.9875691500e-4f);
+  y = v_madd(y, r, v_set(1.3981999507e-3f));
+  y = v_madd(y, r, v_set(8.3334519073e-3f));
+  y = v_madd(y, r, v_set(4.1665795894e-2f));
+  y = v_madd(y, r, v_set(1.6666665459e-1f));
+  y = v_madd(y, r, v_set(5.0000001201e-1f));
+  y = v_madd(y, v_mul(r, r), v_add(r, v_set(1.0f)));
+
+  vi_t n1 = V_SAR(n, 1);
+  vi_t n2 = v_isub(n, n1);
+  y = v_mul(y, v_bits_to_float(V_SHL(v_iadd(n1, v_iset(127)), 23)));
+  y = v_mul(y, v_bits_to_float(V_SHL(v_iadd(n2, v_iset(127)), 23)));
+  return v_select(v_isnan(x), x, y);
+}
+
+/*
+ * log(x) = e * log(2) + log(m) where x = m * 2^e and m is in
+ * [sqrt(0.5), sqrt(2)). log(m) is approximated by polynomial of Cephes logf.
+ */
+
+static inline vf_t v_log(vf_t x) {
+  // Denormals are scaled by 2^25 to be normal.
+  vm_t denormal = v_lt(x, v_set(1.17549435e-38f));
+  vf_t a = v_select(denormal, v_mul(x, v_set(33554432.0f)), x);
+  vi_t e = v_iselect(denormal, v_iset(-25), v_iset(0));
+
+  // Exponent is taken so that m is in [0.5, 1).
+  vi_t bits = v_float_to_bits(a);
+  e = v_iadd(e, v_isub(V_SAR(bits, 23), v_iset(126)));
+  vf_t m = v_bits_to_float(
+      v_ior(v_iand(bits, v_iset(0x007fffff)), v_iset(0x3f000000)));
+
+  vm_t small = v_lt(m, v_set(0.707106781186547524f));
+  e = v_iselect(small, v_isub(e, v_iset(1)), e);
+  m = v_sub(v_select(small, v_add(m, m), m), v_set(1.0f));
+  vf_t fe = v_to_float(e);
+
+  vf_t z = v_mul(m, m);
+  vf_t y = v_set(7.0376836292e-2f);
+  y = v_madd(y, m, v_set(-1.1514610310e-1f));
+  y = v_madd(y, m, v_set(1.1676998740e-1f));
+  y = v_madd(y, m, v_set(-1.2420140846e-1f));
+  y = v_madd(y, m, v_set(1.4249322787e-1f));
+  y = v_madd(y, m, v_set(-1.6668057665e-1f));
+  y = v_madd(y, m, v_set(2.0000714765e-1f));
+  y = v_madd(y, m, v_set(-2.4999993993e-1f));
+  y = v_madd(y, m, v_set(3.3333331174e-1f));
+  y = v_mul(v_mul(y, m), z);
+  y = v_madd(fe, v_set(-2.12194440e-4f), y);
+  y = v_madd(z, v_set(-0.5f), y);
+  y = v_add(m, y);
+  y = v_madd(fe, v_set(0.693359375f), y);
+
+  y = v_select(v_eq(x, v_set(INFINITY)), x, y);
+  y = v_select(v_eq(x, v_set(0.0f)), v_set(-INFINITY), y);
+  y = v_select(v_lt(x, v_set(0.0f)), v_set(NAN), y);
+  return v_select(v_isnan(x), x, y);
+}
+
+// sigmoid(x) is 1 / (1 + t) for x >= 0 and t / (1 + t) for x < 0 with
+// t = exp(-|x|), so that error of t is not amplified by 1 + t.
+static inline vf_t v_sigmoid(vf_t x) {
+  vf_t t = v_exp(v_sub(v_set(0.0f), v_abs(x)));
+  vf_t n = v_select(v_lt(x, v_set(0.0f)), t, v_set(1.0f));
+  return v_div(n, v_add(v_set(1.0f), t));
+}
+
+// tanh(x) is (1 - t) / (1 + t) with t = exp(-2|x|) and sign of x. Small |x|
+// loses precision in 1 - t, so polynomial of Cephes tanhf is used for them.
+static inline vf_t v_tanh(vf_t x) {
+  vf_t one = v_set(1.0f);
+  vf_t a = v_abs(x);
+  vf_t t = v_exp(v_mul(a, v_set(-2.0f)));
+  vf_t large = v_copysign(v_div(v_sub(one, t), v_add(one, t)), x);
+
+  vf_t z = v_mul(x, x);
+  vf_t small = v_set(-5.70498872745e-3f);
+  small = v_madd(small, z, v_set(2.06390887954e-2f));
+  small = v_madd(small, z, v_set(-5.37397155531e-2f));
+  small = v_madd(small, z, v_set(1.33314422036e-1f));
+  small = v_madd(small, z, v_set(-3.33332819422e-1f));
+  small = v_madd(v_mul(small, z), x, x);
+
+  return v_select(v_lt(a, v_set(0.625f)), small, large);
+}
+
+static inline vf_t v_swish(vf_t x) {
+  vf_t t = v_exp(v_sub(v_set(0.0f), v_abs(x)));
+  vf_t n = v_select(v_lt(x, v_set(0.0f)), v_mul(x, t), x);
+  return v_div(n, v_add(v_set(1.0f), t));
+}
+
+static inline vf_t v_elu(vf_t x, vf_t alpha, vf_t scale) {
+  vf_t negative = v_mul(alpha, v_sub(v_exp(x), v_set(1.0f)));
+  return v_mul(scale, v_select(v_lt(v_set(0.0f), x), x, negative));
+}
+
+/*
+ * Fast mode. exp(r) is approximated by Taylor series of degree 4, 2^n is
+ * applied as one factor, and divisions are replaced by reciprocal estimate
+ * refined by one Newton-Raphson step.
+ */
+
+#define EXP_FAST_HI (88.0f)  // Larger value gives exp(88)
+#define EXP_FAST_LO (-87.0f) // Smaller value gives exp(-87)
+
+static inline vf_t v_exp_fast(vf_t x) {
+  vf_t c = v_max(v_min(x, v_set(EXP_FAST_HI)), v_set(EXP_FAST_LO));
+  vf_t fx = v_madd(c, v_set(1.44269504088896341f), v_set(0.5f));
+  vi_t n = v_truncate(fx);
+  n = v_iselect(v_lt(fx, v_to_float(n)), v_isub(n, v_iset(1)), n);
+  vf_t r = v_sub(c, v_mul(v_to_float(n), v_set(0.693147180559945309f)));
+
+  vf_t y = v_set(1.0f / 24.0f);
+  y = v_madd(y, r, v_set(1.0f / 6.0f));
+  y = v_madd(y, r, v_set(0.5f));
+  y = v_madd(y, r, v_set(1.0f));
+  y = v_madd(y, r, v_set(1.0f));
+  y = v_mul(y, v_bits_to_float(V_SHL(v_iadd(n, v_iset(127)), 23)));
+  return v_select(v_isnan(x), x, y);
+}
+
+// 1 / a for a in [1, 2].
+static inline vf_t v_rcp_fast(vf_t a) {
+  vf_t r = v_rcp(a);
+  return v_mul(r, v_sub(v_set(2.0f), v_mul(a, r)));
+}
+
+static inline vf_t v_sigmoid_fast(vf_t x) {
+  vf_t t = v_exp_fast(v_sub(v_set(0.0f), v_abs(x)));
+  vf_t n = v_select(v_lt(x, v_set(0.0f)), t, v_set(1.0f));
+  return v_mul(n, v_rcp_fast(v_add(v_set(1.0f), t)));
+}
+
+static inline vf_t v_tanh_fast(vf_t x) {
+  vf_t one = v_set(1.0f);
+  vf_t a = v_abs(x);
+  vf_t t = v_exp_fast(v_mul(a, v_set(-2.0f)));
+  vf_t large =
+      v_copysign(v_mul(v_sub(one, t), v_rcp_fast(v_add(one, t))), x);
+
+  vf_t z = v_mul(x, x);
+  vf_t small = v_set(-5.70498872745e-3f);
+  small = v_madd(small, z, v_set(2.06390887954e-2f));
+  small = v_madd(small, z, v_set(-5.37397155531e-2f));
+  small = v_madd(small, z, v_set(1.33314422036e-1f));
+  small = v_madd(small, z, v_set(-3.33332819422e-1f));
+  small = v_madd(v_mul(small, z), x, x);
+
+  return v_select(v_lt(a, v_set(0.625f)), small, large);
+}
+
+// Calculate expression of v for each VECTOR_LANES values, and for remaining
+// values through zero padded copy, so that results do not depend on position.
+#define VECTOR_LOOP(expression)                                                \
+  do {                                                                         \
+    float tail[VECTOR_LANES] = {0.0f};                                         \
+    vf_t v;                                                                    \
+    int i, j;                                                                  \
+    for (i = 0; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                 \
+      v = v_load(x + i);                                                       \
+      v_store(y + i, expression);                                              \
+    }                                                                          \
+    if (i < size) {                                                            \
+      for (j = 0; i + j < size; j++) {                                         \
+        tail[j] = x[i + j];                                                    \
+      }                                                                        \
+      v = v_load(tail);                                                        \
+      v_store(tail, expression);                                               \
+      for (j = 0; i + j < size; j++) {                                         \
+        y[i + j] = tail[j];                                                    \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+void vector_exp(const float *x, float *y, int size) { VECTOR_LOOP(v_exp(v)); }
+
+void vector_log(const float *x, float *y, int size) { VECTOR_LOOP(v_log(v)); }
+
+void vector_sigmoid(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_sigmoid(v));
+}
+
+void vector_tanh(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_tanh(v));
+}
+
+void vector_swish(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_swish(v));
+}
+
+void vector_elu(const float *x, float *y, int size, float alpha, float scale) {
+  vf_t va = v_set(alpha);
+  vf_t vs = v_set(scale);
+  VECTOR_LOOP(v_elu(v, va, vs));
+}
+
+void vector_exp_fast(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_exp_fast(v));
+}
+
+void vector_sigmoid_fast(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_sigmoid_fast(v));
+}
+
+void vector_tanh_fast(const float *x, float *y, int size) {
+  VECTOR_LOOP(v_tanh_fast(v));
+}
+
+float vector_max(const float *x, int size) {
+  float lanes[VECTOR_LANES];
+  float max = x[0];
+  int i = 0, j;
+  if (size >= VECTOR_LANES) {
+    vf_t v = v_load(x);
+    for (i = VECTOR_LANES; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+      v = v_max(v, v_load(x + i));
+    }
+    v_store(lanes, v);
+    for (j = 0; j < VECTOR_LANES; j++) {
+      max = max < lanes[j] ? lanes[j] : max;
+    }
+  }
+  for (; i < size; i++) {
+    max = max < x[i] ? x[i] : max;
+  }
+  return max;
+}
+
+// Lanes of sum of term of block of values by 4 accumulators, remaining
+// values are padded with pad whose term is 0.
+#define VECTOR_SUM_BLOCK_FUNCTION(name, term)                                  \
+  static vf_t name(const float *x, int size, float pad) {                      \
+    const vf_t vp = v_set(pad);                                                \
+    vf_t s0 = v_set(0.0f), s1 = s0, s2 = s0, s3 = s0, v;                       \
+    float tail[VECTOR_LANES];                                                  \
+    int i = 0, j;                                                              \
+    for (; i + 4 * VECTOR_LANES <= size; i += 4 * VECTOR_LANES) {              \
+      v = v_load(x + i);                                                       \
+      s0 = v_add(s0, term);                                                    \
+      v = v_load(x + i + VECTOR_LANES);                                        \
+      s1 = v_add(s1, term);                                                    \
+      v = v_load(x + i + 2 * VECTOR_LANES);                                    \
+      s2 = v_add(s2, term);                                                    \
+      v = v_load(x + i + 3 * VECTOR_LANES);                                    \
+      s3 = v_add(s3, term);                                                    \
+    }                                                                          \
+    for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                      \
+      v = v_load(x + i);                                                       \
+      s0 = v_add(s0, term);                                                    \
+    }                                                                          \
+    if (i < size) {                                                            \
+      for (j = 0; j < VECTOR_LANES; j++) {                                     \
+        tail[j] = i + j < size ? x[i + j] : pad;                               \
+      }                                                                        \
+      v = v_load(tail);                                                        \
+      s1 = v_add(s1, term);                                                    \
+    }                                                                          \
+    (void)vp;                                                                  \
+    return v_add(v_add(s0, s1), v_add(s2, s3));                                \
+  }
+
+VECTOR_SUM_BLOCK_FUNCTION(sum_block, v)
+VECTOR_SUM_BLOCK_FUNCTION(squared_deviation_block,
+                          v_mul(v_sub(v, vp), v_sub(v, vp)))
+
+// Sum blocks of VECTOR_SUM_BLOCK values pairwise like a binary counter, and
+// lanes of the result in order.
+#define VECTOR_PAIRWISE_SUM(block_func, pad)                                   \
+  do {                                                                         \
+    vf_t stack[VECTOR_SUM_LEVELS];                                             \
+    float lanes[VECTOR_LANES];                                                 \
+    float result = 0.0f;                                                       \
+    int begin, b, m, j, depth = 0;                                             \
+    for (begin = 0, b = 1; begin < size; begin += VECTOR_SUM_BLOCK, b++) {     \
+      const int n = size - begin < VECTOR_SUM_BLOCK ? size - begin             \
+                                                    : VECTOR_SUM_BLOCK;        \
+      stack[depth++] = block_func(x + begin, n, pad);                          \
+      for (m = b; (m & 1) == 0; m >>= 1, depth--) {                            \
+        stack[depth - 2] = v_add(stack[depth - 2], stack[depth - 1]);          \
+      }                                                                        \
+    }                                                                          \
+    for (; depth > 1; depth--) {                                               \
+      stack[depth - 2] = v_add(stack[depth - 2], stack[depth - 1]);            \
+    }                                                                          \
+    if (depth > 0) {                                                           \
+      v_store(lanes, stack[0]);                                                \
+      for (j = 0; j < VECTOR_LANES; j++) {                                     \
+        result += lanes[j];                                                    \
+      }                                                                        \
+    }                                                                          \
+    return result;                                                             \
+  } while (0)
+
+float vector_sum(const float *x, int size) {
+  VECTOR_PAIRWISE_SUM(sum_block, 0.0f);
+}
+
+float vector_squared_deviation_sum(const float *x, int size, float mean) {
+  VECTOR_PAIRWISE_SUM(squared_deviation_block, mean);
+}
+
+float vector_min(const float *x, int size) {
+  float lanes[VECTOR_LANES];
+  float min = x[0];
+  int i = 0, j;
+  if (size >= VECTOR_LANES) {
+    vf_t v = v_load(x);
+    for (i = VECTOR_LANES; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+      v = v_min(v, v_load(x + i));
+    }
+    v_store(lanes, v);
+    for (j = 0; j < VECTOR_LANES; j++) {
+      min = min > lanes[j] ? lanes[j] : min;
+    }
+  }
+  for (; i < size; i++) {
+    min = min > x[i] ? x[i] : min;
+  }
+  return min;
+}
+
+float vector_prod(const float *x, int size) {
+  float lanes[VECTOR_LANES];
+  float prod = 1.0f;
+  int i = 0, j;
+  if (size >= VECTOR_LANES) {
+    vf_t v = v_load(x);
+    for (i = VECTOR_LANES; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+      v = v_mul(v, v_load(x + i));
+    }
+    v_store(lanes, v);
+    for (j = 0; j < VECTOR_LANES; j++) {
+      prod *= lanes[j];
+    }
+  }
+  for (; i < size; i++) {
+    prod *= x[i];
+  }
+  return prod;
+}
+
+// y = y op x for each VECTOR_LANES values, and remaining values one by one.
+#define VECTOR_ACCUMULATE(vector_op, scalar_op)                                \
+  do {                                                                         \
+    int i = 0;                                                                 \
+    for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                      \
+      v_store(y + i, vector_op(v_load(y + i), v_load(x + i)));                 \
+    }                                                                          \
+    for (; i < size; i++) {                                                    \
+      y[i] = scalar_op(y[i], x[i]);                                            \
+    }                                                                          \
+  } while (0)
+
+#define SCALAR_ADD(a, b) ((a) + (b))
+#define SCALAR_MUL(a, b) ((a) * (b))
+#define SCALAR_MAX(a, b) ((a) < (b) ? (b) : (a))
+#define SCALAR_MIN(a, b) ((a) > (b) ? (b) : (a))
+
+void vector_add(const float *x, float *y, int size) {
+  VECTOR_ACCUMULATE(v_add, SCALAR_ADD);
+}
+
+void vector_sub(const float *x, const float *m, float *y, int size) {
+  int i = 0;
+  for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+    v_store(y + i, v_sub(v_load(x + i), v_load(m + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = x[i] - m[i];
+  }
+}
+
+void vector_mul(const float *x, float *y, int size) {
+  VECTOR_ACCUMULATE(v_mul, SCALAR_MUL);
+}
+
+void vector_maximum(const float *x, float *y, int size) {
+  VECTOR_ACCUMULATE(v_max, SCALAR_MAX);
+}
+
+void vector_minimum(const float *x, float *y, int size) {
+  VECTOR_ACCUMULATE(v_min, SCALAR_MIN);
+}
+
+void vector_reverse(const float *x, float *y, int size) {
+  int i = 0;
+  for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+    v_store(y + i, v_reverse(v_load(x + size - i - VECTOR_LANES)));
+  }
+  for (; i < size; i++) {
+    y[i] = x[size - 1 - i];
+  }
+}
+
+// max(x, 0) + slope * min(x, 0) is x or x * slope exactly, since the other
+// term is zero. Zero is the first operand of max and min, so that NaN of x
+// is returned by SSE2 and AVX2.
+static inline vf_t v_leaky_relu(vf_t x, vf_t slope, vf_t zero) {
+  return v_madd(v_min(zero, x), slope, v_max(zero, x));
+}
+
+void vector_leaky_relu(const float *x, float *y, int size, float slope) {
+  const vf_t vs = v_set(slope);
+  const vf_t zero = v_set(0.0f);
+  int i = 0;
+  for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+    v_store(y + i, v_leaky_relu(v_load(x + i), vs, zero));
+  }
+  for (; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : x[i] * slope;
+  }
+}
+
+void vector_prelu(const float *x, const float *slope, float *y, int size) {
+  const vf_t zero = v_set(0.0f);
+  int i = 0;
+  for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+    v_store(y + i, v_leaky_relu(v_load(x + i), v_load(slope + i), zero));
+  }
+  for (; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : x[i] * slope[i];
+  }
+}
+
+void vector_crelu(const float *x, float *positive, float *negative,
+                  int size) {
+  const vf_t zero = v_set(0.0f);
+  int i = 0;
+  for (; i + VECTOR_LANES <= size; i += VECTOR_LANES) {
+    const vf_t v = v_load(x + i);
+    v_store(positive + i, v_max(v, zero));
+    v_store(negative + i, v_max(v_sub(zero, v), zero));
+  }
+  for (; i < size; i++) {
+    positive[i] = x[i] > 0.0f ? x[i] : 0.0f;
+    negative[i] = x[i] < 0.0f ? -x[i] : 0.0f;
+  }
+}
+
+// Sum exp(x - shift) by lanes, remaining values are padded with -inf whose
+// exp adds nothing.
+#define VECTOR_EXP_SUM(exp_func)                                               \
+  do {                                                                         \
+    const vf_t vs = v_set(shift);                                              \
+    vf_t e, sum = v_set(0.0f);                                                 \
+    float tail[VECTOR_LANES];                                                  \
+    float result = 0.0f;                                                       \
+    int i, j;                                                                  \
+    for (i = 0; i + VECTOR_LANES <= size; i += VECTOR_LANES) {                 \
+      e = exp_func(v_sub(v_load(x + i), vs));                                  \
+      if (y) {                                                                 \
+        v_store(y + i, e);                                                     \
+      }                                                                        \
+      sum = v_add(sum, e);                                                     \
+    }                                                                          \
+    if (i < size) {                                                            \
+      for (j = 0; j < VECTOR_LANES; j++) {                                     \
+        tail[j] = i + j < size ? x[i + j] : -INFINITY;                         \
+      }                                                                        \
+      e = exp_func(v_sub(v_load(tail), vs));                                   \
+      sum = v_add(sum, e);                                                     \
+      v_store(tail, e);                                                        \
+      for (j = 0; y && i + j < size; j++) {                                    \
+        y[i + j] = tail[j];                                                    \
+      }                                                                        \
+    }                                                                          \
+    v_store(tail, sum);                                                        \
+    for (j = 0; j < VECTOR_LANES; j++) {                                       \
+      result += tail[j];                                                       \
+    }                                                                          \
+    return result;                                                             \
+  } while (0)
+
+float vector_exp_sum(const float *x, float *y, int size, float shift) {
+  VECTOR_EXP_SUM(v_exp);
+}
+
+float vector_exp_sum_fast(const float *x, float *y, int size, float shift) {
+  VECTOR_EXP_SUM(v_exp_fast);
+}
+
+#else /* VECTOR_MATH_AVX2 || VECTOR_MATH_SSE2 || VECTOR_MATH_NEON */
+
+void vector_exp(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = expf(x[i]);
+  }
+}
+
+void vector_log(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = logf(x[i]);
+  }
+}
+
+void vector_sigmoid(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = 1.0f / (1.0f + expf(-x[i]));
+  }
+}
+
+void vector_tanh(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = tanhf(x[i]);
+  }
+}
+
+void vector_swish(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] / (1.0f + expf(-x[i]));
+  }
+}
+
+void vector_elu(const float *x, float *y, int size, float alpha, float scale) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = scale * (x[i] > 0.0f ? x[i] : alpha * (expf(x[i]) - 1.0f));
+  }
+}
+
+// Without vector instructions, libm is not slower than approximations.
+void vector_exp_fast(const float *x, float *y, int size) {
+  vector_exp(x, y, size);
+}
+
+void vector_sigmoid_fast(const float *x, float *y, int size) {
+  vector_sigmoid(x, y, size);
+}
+
+void vector_tanh_fast(const float *x, float *y, int size) {
+  vector_tanh(x, y, size);
+}
+
+float vector_max(const float *x, int size) {
+  float max = x[0];
+  int i; // Iterator
+  for (i = 1; i < size; i++) {
+    max = max < x[i] ? x[i] : max;
+  }
+  return max;
+}
+
+// Sum of term of block of values by 4 accumulators.
+#define SCALAR_SUM_BLOCK_FUNCTION(name, term)                                  \
+  static float name(const float *x, int size, float mean) {                    \
+    float s[4] = {0.0f, 0.0f, 0.0f, 0.0f};                                     \
+    float v;                                                                   \
+    int i; /* Iterator */                                                      \
+    for (i = 0; i < size; i++) {                                               \
+      v = x[i];                                                                \
+      s[i % 4] += term;                                                        \
+    }                                                                          \
+    (void)mean;                                                                \
+    return (s[0] + s[1]) + (s[2] + s[3]);                                      \
+  }
+
+SCALAR_SUM_BLOCK_FUNCTION(sum_block, v)
+SCALAR_SUM_BLOCK_FUNCTION(squared_deviation_block, (v - mean) * (v - mean))
+
+// Sum blocks of VECTOR_SUM_BLOCK values pairwise like a binary counter.
+#define SCALAR_PAIRWISE_SUM(block_func, mean)                                  \
+  do {                                                                         \
+    float stack[VECTOR_SUM_LEVELS];                                            \
+    int begin, b, m, depth = 0;                                                \
+    for (begin = 0, b = 1; begin < size; begin += VECTOR_SUM_BLOCK, b++) {     \
+      const int n = size - begin < VECTOR_SUM_BLOCK ? size - begin             \
+                                                    : VECTOR_SUM_BLOCK;        \
+      stack[depth++] = block_func(x + begin, n, mean);                         \
+      for (m = b; (m & 1) == 0; m >>= 1, depth--) {                            \
+        stack[depth - 2] += stack[depth - 1];                                  \
+      }                                                                        \
+    }                                                                          \
+    for (; depth > 1; depth--) {                                               \
+      stack[depth - 2] += stack[depth - 1];                                    \
+    }                                                                          \
+    return depth > 0 ? stack[0] : 0.0f;                                        \
+  } while (0)
+
+float vector_sum(const float *x, int size) {
+  SCALAR_PAIRWISE_SUM(sum_block, 0.0f);
+}
+
+float vector_squared_deviation_sum(const float *x, int size, float mean) {
+  SCALAR_PAIRWISE_SUM(squared_deviation_block, mean);
+}
+
+float vector_min(const float *x, int size) {
+  float min = x[0];
+  int i; // Iterator
+  for (i = 1; i < size; i++) {
+    min = min > x[i] ? x[i] : min;
+  }
+  return min;
+}
+
+float vector_prod(const float *x, int size) {
+  float prod = 1.0f;
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    prod *= x[i];
+  }
+  return prod;
+}
+
+void vector_add(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] += x[i];
+  }
+}
+
+void vector_sub(const float *x, const float *m, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] - m[i];
+  }
+}
+
+void vector_mul(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] *= x[i];
+  }
+}
+
+void vector_maximum(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = y[i] < x[i] ? x[i] : y[i];
+  }
+}
+
+void vector_minimum(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = y[i] > x[i] ? x[i] : y[i];
+  }
+}
+
+void vector_reverse(const float *x, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[size - 1 - i];
+  }
+}
+
+void vector_leaky_relu(const float *x, float *y, int size, float slope) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : x[i] * slope;
+  }
+}
+
+void vector_prelu(const float *x, const float *slope, float *y, int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : x[i] * slope[i];
+  }
+}
+
+void vector_crelu(const float *x, float *positive, float *negative,
+                  int size) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    positive[i] = x[i] > 0.0f ? x[i] : 0.0f;
+    negative[i] = x[i] < 0.0f ? -x[i] : 0.0f;
+  }
+}
+
+float vector_exp_sum(const float *x, float *y, int size, float shift) {
+  float sum = 0.0f;
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    const float e = expf(x[i] - shift);
+    if (y) {
+      y[i] = e;
+    }
+    sum += e;
+  }
+  return sum;
+}
+
+float vector_exp_sum_fast(const float *x, float *y, int size, float shift) {
+  return vector_exp_sum(x, y, size, shift);
+}
+
+#endif /* VECTOR_MATH_AVX2 || VECTOR_MATH_SSE2 || VECTOR_MATH_NEON */
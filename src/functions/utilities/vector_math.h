@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_VECTOR_MATH_H_181206120000_
+#define H_VECTOR_MATH_H_181206120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup VectorMathFunction Vector Math Function
+/// Element wise transcendental functions of float arrays.
+///
+/// Values are calculated 4 at a time by polynomial approximations with SSE2,
+/// or with NEON when NNABLART_NEON is defined (see neon.h). Otherwise libm is
+/// called for each value. Error bounds below are in ulp of exact results,
+/// measured with SSE2 over all float inputs whose results are normal.
+/// Infinity and NaN are handled like libm. x and y may be same array.
+/// @{
+
+/// y = exp(x), within 1.5 ulp (max 1.28).
+void vector_exp(const float *x, float *y, int size);
+
+/// y = log(x), within 1 ulp (max 0.83). -inf for 0, NaN for x < 0.
+void vector_log(const float *x, float *y, int size);
+
+/// y = 1 / (1 + exp(-x)), within 3 ulp (max 2.64).
+void vector_sigmoid(const float *x, float *y, int size);
+
+/// y = tanh(x), within 2 ulp (max 1.50).
+void vector_tanh(const float *x, float *y, int size);
+
+/// y = x / (1 + exp(-x)), within 3.5 ulp (max 3.21) for |x| < 87. Smaller x
+/// has only precision of denormal exp(x).
+void vector_swish(const float *x, float *y, int size);
+
+/// y = scale * x if x > 0, otherwise scale * alpha * (exp(x) - 1).
+/// exp(x) - 1 is within 1.5 ulp (max 1.12) of larger of exp(x) and result,
+/// same as expf(x) - 1.
+void vector_elu(const float *x, float *y, int size, float alpha, float scale);
+
+/// y = exp(x) with fast approximation, within 1e-4 relative error. x is
+/// clamped to [-87, 88].
+void vector_exp_fast(const float *x, float *y, int size);
+
+/// y = 1 / (1 + exp(-x)) with fast approximation, within 1e-4 relative
+/// error.
+void vector_sigmoid_fast(const float *x, float *y, int size);
+
+/// y = tanh(x) with fast approximation, within 1e-4 relative error.
+void vector_tanh_fast(const float *x, float *y, int size);
+
+/// Max of size values, size must be at least 1.
+float vector_max(const float *x, int size);
+
+/// Sum of size values. Blocks of 256 values are added by lanes, and sums of
+/// blocks are added pairwise, so that error grows with log of size and the
+/// order of additions depends only on size.
+float vector_sum(const float *x, int size);
+
+/// Sum of (x - mean)^2 of size values, added same as vector_sum().
+float vector_squared_deviation_sum(const float *x, int size, float mean);
+
+/// Min of size values, size must be at least 1.
+float vector_min(const float *x, int size);
+
+/// Product of size values, multiplied by lanes.
+float vector_prod(const float *x, int size);
+
+/// y[i] = y[i] + x[i].
+void vector_add(const float *x, float *y, int size);
+
+/// y[i] = x[i] - m[i]. y may be x.
+void vector_sub(const float *x, const float *m, float *y, int size);
+
+/// y[i] = y[i] * x[i].
+void vector_mul(const float *x, float *y, int size);
+
+/// y[i] = max(y[i], x[i]).
+void vector_maximum(const float *x, float *y, int size);
+
+/// y[i] = min(y[i], x[i]).
+void vector_minimum(const float *x, float *y, int size);
+
+/// y[i] = x[size - 1 - i]. x and y must not overlap.
+void vector_reverse(const float *x, float *y, int size);
+
+/// y = x if x > 0, otherwise x * slope, without branches.
+void vector_leaky_relu(const float *x, float *y, int size, float slope);
+
+/// y[i] = x[i] if x[i] > 0, otherwise x[i] * slope[i].
+void vector_prelu(const float *x, const float *slope, float *y, int size);
+
+/// positive = max(x, 0) and negative = max(-x, 0), reading x once.
+void vector_crelu(const float *x, float *positive, float *negative,
+                  int size);
+
+/// Sum of exp(x - shift), each exp is also stored to y unless y is NULL.
+/// Exp is same as vector_exp(), and sum is added in order of lanes.
+float vector_exp_sum(const float *x, float *y, int size, float shift);
+
+/// vector_exp_sum() with exp of vector_exp_fast().
+float vector_exp_sum_fast(const float *x, float *y, int size, float shift);
+
+/// Non zero if functions are allocated in RT_MATH_MODE_FAST by
+/// rt_set_math_mode() of calling thread.
+int is_fast_math(void);
+
+/// @}
+
+#endif // H_VECTOR_MATH_H_181206120000_
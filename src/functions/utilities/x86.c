@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "x86.h"
+
+#ifdef NNABLART_X86_DISPATCH
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#define CPUID_1_ECX_FMA (1u << 12)
+#define CPUID_1_ECX_OSXSAVE (1u << 27)
+#define CPUID_1_ECX_AVX (1u << 28)
+#define CPUID_7_EBX_AVX2 (1u << 5)
+#define CPUID_7_EBX_AVX512F (1u << 16)
+#define CPUID_7_EBX_AVX512VL (1u << 31)
+#define CPUID_7_ECX_AVX512VNNI (1u << 11)
+#define XCR0_SSE_AVX (0x6u)     // XMM and YMM states
+#define XCR0_AVX512 (0xe6u)     // And opmask, ZMM_Hi256 and Hi16_ZMM states
+
+static void cpuid(unsigned int leaf, unsigned int *regs) {
+#if defined(_MSC_VER)
+  int r[4];
+  int i; // Iterator
+  __cpuidex(r, (int)leaf, 0);
+  for (i = 0; i < 4; i++) {
+    regs[i] = (unsigned int)r[i];
+  }
+#else
+  if (__get_cpuid_max(0, 0) < leaf) {
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    return;
+  }
+  __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned int xcr0(void) {
+#if defined(_MSC_VER)
+  return (unsigned int)_xgetbv(0);
+#else
+  unsigned int lo, hi;
+  __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return lo;
+#endif
+}
+
+static int detect(void) {
+  unsigned int regs[4]; // eax, ebx, ecx, edx
+  int features = 0;
+
+  cpuid(0, regs);
+  if (regs[0] < 7) {
+    return 0;
+  }
+  cpuid(1, regs);
+  if ((regs[2] & CPUID_1_ECX_OSXSAVE) == 0 ||
+      (regs[2] & CPUID_1_ECX_AVX) == 0 ||
+      (xcr0() & XCR0_SSE_AVX) != XCR0_SSE_AVX) {
+    return 0;
+  }
+  int fma = (regs[2] & CPUID_1_ECX_FMA) != 0;
+  int avx512 = (xcr0() & XCR0_AVX512) == XCR0_AVX512;
+  cpuid(7, regs);
+  if (fma && (regs[1] & CPUID_7_EBX_AVX2)) {
+    features |= X86_FEATURE_AVX2;
+  }
+  if (avx512 && (regs[1] & CPUID_7_EBX_AVX512F) &&
+      (regs[1] & CPUID_7_EBX_AVX512VL) && (regs[2] & CPUID_7_ECX_AVX512VNNI)) {
+    features |= X86_FEATURE_VNNI;
+  }
+  return features;
+}
+
+int x86_cpu_features(void) {
+  // Threads which race at first call store same value.
+  static volatile int features = -1;
+  if (features < 0) {
+    features = detect();
+  }
+  return features;
+}
+
+#endif /* NNABLART_X86_DISPATCH */
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_X86_H_181210120000_
+#define H_X86_H_181210120000_
+
+#include <nnablart/functions.h>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @ingroup Utilities
+
+/// @defgroup X86Function X86 Function
+/// Float and int8 kernels for instruction sets newer than the one compiler
+/// targets, selected by features of CPU at run time.
+///
+/// They are built when NNABLART_ENABLE_X86_DISPATCH is defined (CMake option
+/// of same name) on x86. NNABLART_X86_DISPATCH is defined then. Kernels of
+/// each instruction set are in their own file compiled with flags of it, and
+/// they must be called only if x86_cpu_features() has its bit. Functions
+/// check it at allocation and set exec_func to those kernels.
+/// @{
+
+#if defined(NNABLART_ENABLE_X86_DISPATCH) &&                                   \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+     defined(_M_IX86))
+#define NNABLART_X86_DISPATCH
+
+/// AVX2 and FMA, and OS saves YMM registers.
+#define X86_FEATURE_AVX2 (1 << 0)
+
+/// AVX-512 VNNI with 256bit vectors (AVX512VL), and OS saves AVX-512 states.
+#define X86_FEATURE_VNNI (1 << 1)
+
+/// Features of running CPU, detected at first call.
+int x86_cpu_features(void);
+
+/// y = max(x, 0)
+void avx2_relu(const float *x, float *y, int size);
+
+/// y = a + b
+void avx2_add(const float *a, const float *b, float *y, int size);
+
+/// y = a * b
+void avx2_mul(const float *a, const float *b, float *y, int size);
+
+/// Micro-kernel of sgemm() for SGEMM_MR 4 and SGEMM_NR 8, i.e. tiles of
+/// SSE build, so that panels packed by either kernel are same.
+void avx2_sgemm_kernel(int kc, const float *a, const float *b, float *c,
+                       int ldc, int accumulate);
+
+/// Same as sgemv().
+void avx2_sgemv(int m, int k, const float *a, int lda, const float *x,
+                float *y);
+
+/// c[r * ldc + j] += sum of a[r * lda + l] * b(l, j) for rows x n block,
+/// where b(l, j) is b[(l / 4) * ldb * 4 + j * 4 + l % 4], i.e. each 4 rows of
+/// b are interleaved. a is signed, b is unsigned, k4 is a multiple of 4 and
+/// n a multiple of 16. Products wrap around like int32 of vpdpbusd.
+void vnni_gemm_u8s8(int rows, int n, int k4, const int8_t *a, int lda,
+                    const uint8_t *b, int ldb, int32_t *c, int ldc);
+
+#endif
+
+/// @}
+
+#endif // H_X86_H_181210120000_
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This file is compiled with AVX2 and FMA enabled, nothing here may run
+// before x86_cpu_features() is checked.
+
+#include "x86.h"
+
+#ifdef NNABLART_X86_DISPATCH
+
+#include <immintrin.h>
+
+#define SGEMV_ROWS (8)      // Rows of A multiplied at once by avx2_sgemv()
+#define SGEMV_PREFETCH (64) // Distance of prefetched values of rows of A
+#define SGEMV_BLOCK (128)   // Depth of partial sums, SGEMM_BLOCK_K of sgemm.c
+
+#if defined(__GNUC__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p)
+#endif
+
+static float sum_lanes(__m256 v) {
+  __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+  return _mm_cvtss_f32(s);
+}
+
+void avx2_relu(const float *x, float *y, int size) {
+  __m256 zero = _mm256_setzero_ps();
+  int i; // Iterator
+
+  for (i = 0; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(y + i, _mm256_max_ps(_mm256_loadu_ps(x + i), zero));
+  }
+  for (; i < size; i++) {
+    y[i] = x[i] > 0.0f ? x[i] : 0.0f;
+  }
+}
+
+void avx2_add(const float *a, const float *b, float *y, int size) {
+  int i; // Iterator
+
+  for (i = 0; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(
+        y + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = a[i] + b[i];
+  }
+}
+
+void avx2_mul(const float *a, const float *b, float *y, int size) {
+  int i; // Iterator
+
+  for (i = 0; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(
+        y + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  for (; i < size; i++) {
+    y[i] = a[i] * b[i];
+  }
+}
+
+// One YMM register holds a row of the 4 x 8 tile. Even and odd steps of
+// depth are summed separately, so that 8 chains of FMA hide its latency.
+void avx2_sgemm_kernel(int kc, const float *a, const float *b, float *c,
+                       int ldc, int accumulate) {
+  __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+  __m256 c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+  __m256 d0 = _mm256_setzero_ps(), d1 = _mm256_setzero_ps();
+  __m256 d2 = _mm256_setzero_ps(), d3 = _mm256_setzero_ps();
+  int l; // Iterator
+
+  for (l = 0; l + 2 <= kc; l += 2, a += 8, b += 16) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    c0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a), b0, c0);
+    c1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 1), b0, c1);
+    c2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 2), b0, c2);
+    c3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 3), b0, c3);
+    d0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 4), b1, d0);
+    d1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 5), b1, d1);
+    d2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 6), b1, d2);
+    d3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 7), b1, d3);
+  }
+  if (l < kc) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    c0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a), b0, c0);
+    c1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 1), b0, c1);
+    c2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 2), b0, c2);
+    c3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 3), b0, c3);
+  }
+  c0 = _mm256_add_ps(c0, d0);
+  c1 = _mm256_add_ps(c1, d1);
+  c2 = _mm256_add_ps(c2, d2);
+  c3 = _mm256_add_ps(c3, d3);
+  if (accumulate) {
+    c0 = _mm256_add_ps(c0, _mm256_loadu_ps(c));
+    c1 = _mm256_add_ps(c1, _mm256_loadu_ps(c + ldc));
+    c2 = _mm256_add_ps(c2, _mm256_loadu_ps(c + 2 * ldc));
+    c3 = _mm256_add_ps(c3, _mm256_loadu_ps(c + 3 * ldc));
+  }
+  _mm256_storeu_ps(c, c0);
+  _mm256_storeu_ps(c + ldc, c1);
+  _mm256_storeu_ps(c + 2 * ldc, c2);
+  _mm256_storeu_ps(c + 3 * ldc, c3);
+}
+
+void avx2_sgemv(int m, int k, const float *a, int lda, const float *x,
+                float *y) {
+  int i, r, l, j; // Iterators
+
+  for (i = 0; i < m; i += SGEMV_ROWS) {
+    int rows = m - i < SGEMV_ROWS ? m - i : SGEMV_ROWS;
+    const float *row[SGEMV_ROWS];
+    __m256 acc[SGEMV_ROWS];
+    __m256 total[SGEMV_ROWS];
+    for (r = 0; r < SGEMV_ROWS; r++) {
+      // Missing rows repeat the first row, their sums are not stored.
+      row[r] = a + (i + (r < rows ? r : 0)) * lda;
+      total[r] = _mm256_setzero_ps();
+    }
+    // Same depth blocks as sgemv().
+    for (l = 0; l + 8 <= k;) {
+      const int end = k - l < SGEMV_BLOCK ? k : l + SGEMV_BLOCK;
+      for (r = 0; r < SGEMV_ROWS; r++) {
+        acc[r] = _mm256_setzero_ps();
+      }
+      for (; l + 8 <= end; l += 8) {
+        __m256 xv = _mm256_loadu_ps(x + l);
+        if (l + SGEMV_PREFETCH < k && l % 16 == 0) {
+          for (r = 0; r < SGEMV_ROWS; r++) {
+            PREFETCH(row[r] + l + SGEMV_PREFETCH);
+          }
+        }
+        for (r = 0; r < SGEMV_ROWS; r++) {
+          acc[r] = _mm256_fmadd_ps(_mm256_loadu_ps(row[r] + l), xv, acc[r]);
+        }
+      }
+      for (r = 0; r < SGEMV_ROWS; r++) {
+        total[r] = _mm256_add_ps(total[r], acc[r]);
+      }
+    }
+    for (r = 0; r < rows; r++) {
+      float sum = sum_lanes(total[r]);
+      for (j = l; j < k; j++) {
+        sum += row[r][j] * x[j];
+      }
+      y[i + r] = sum;
+    }
+  }
+}
+
+#endif /* NNABLART_X86_DISPATCH */
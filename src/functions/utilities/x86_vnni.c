@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file is compiled with AVX-512 VNNI enabled, nothing here may run
+// before x86_cpu_features() is checked.
+
+#include "x86.h"
+
+#ifdef NNABLART_X86_DISPATCH
+
+#include <immintrin.h>
+#include <string.h>
+
+static __m256i broadcast4(const int8_t *a) {
+  int32_t v;
+  memcpy(&v, a, sizeof(v));
+  return _mm256_set1_epi32(v);
+}
+
+static void add_row(int32_t *c, __m256i lo, __m256i hi) {
+  __m256i *p = (__m256i *)c;
+  _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), lo));
+  _mm256_storeu_si256(p + 1, _mm256_add_epi32(_mm256_loadu_si256(p + 1), hi));
+}
+
+// 4 rows x 16 columns in 8 accumulators, b of 16 columns is loaded once for
+// 4 rows.
+static void kernel_4x16(int k4, const int8_t *a, int lda, const uint8_t *b,
+                        int ldb, int32_t *c, int ldc) {
+  __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+  __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+  __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+  __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+  int l; // Iterator
+
+  for (l = 0; l < k4; l += 4) {
+    const __m256i *p = (const __m256i *)(b + l * ldb);
+    __m256i b0 = _mm256_loadu_si256(p);
+    __m256i b1 = _mm256_loadu_si256(p + 1);
+    __m256i a0 = broadcast4(a + l);
+    __m256i a1 = broadcast4(a + lda + l);
+    __m256i a2 = broadcast4(a + 2 * lda + l);
+    __m256i a3 = broadcast4(a + 3 * lda + l);
+    c00 = _mm256_dpbusd_epi32(c00, b0, a0);
+    c01 = _mm256_dpbusd_epi32(c01, b1, a0);
+    c10 = _mm256_dpbusd_epi32(c10, b0, a1);
+    c11 = _mm256_dpbusd_epi32(c11, b1, a1);
+    c20 = _mm256_dpbusd_epi32(c20, b0, a2);
+    c21 = _mm256_dpbusd_epi32(c21, b1, a2);
+    c30 = _mm256_dpbusd_epi32(c30, b0, a3);
+    c31 = _mm256_dpbusd_epi32(c31, b1, a3);
+  }
+  add_row(c, c00, c01);
+  add_row(c + ldc, c10, c11);
+  add_row(c + 2 * ldc, c20, c21);
+  add_row(c + 3 * ldc, c30, c31);
+}
+
+static void kernel_1x16(int k4, const int8_t *a, const uint8_t *b, int ldb,
+                        int32_t *c) {
+  __m256i c0 = _mm256_setzero_si256(), c1 = _mm256_setzero_si256();
+  int l; // Iterator
+
+  for (l = 0; l < k4; l += 4) {
+    const __m256i *p = (const __m256i *)(b + l * ldb);
+    __m256i a0 = broadcast4(a + l);
+    c0 = _mm256_dpbusd_epi32(c0, _mm256_loadu_si256(p), a0);
+    c1 = _mm256_dpbusd_epi32(c1, _mm256_loadu_si256(p + 1), a0);
+  }
+  add_row(c, c0, c1);
+}
+
+void vnni_gemm_u8s8(int rows, int n, int k4, const int8_t *a, int lda,
+                    const uint8_t *b, int ldb, int32_t *c, int ldc) {
+  int r, j;
+  for (j = 0; j < n; j += 16) {
+    for (r = 0; r + 4 <= rows; r += 4) {
+      kernel_4x16(k4, a + r * lda, lda, b + j * 4, ldb, c + r * ldc + j, ldc);
+    }
+    for (; r < rows; r++) {
+      kernel_1x16(k4, a + r * lda, b + j * 4, ldb, c + r * ldc + j);
+    }
+  }
+}
+
+#endif /* NNABLART_X86_DISPATCH */
@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../runtime/runtime_internal.h"
+#include "batch.h"
+#include "load.h"
+
+/*
+ * Runs many samples with one initialization. A sample is raw data of all
+ * inputs in order, and samples are concatenated in one file which is mapped,
+ * or in a stream read from stdin. Contexts cloned from the first one make a
+ * ring, and sample i runs on context i % CONTEXTS by rt_forward_async():
+ * while it runs, inputs of next sample are read into the next context, and
+ * outputs of the context are written once it is reused. Outputs of all
+ * samples are raw data of all outputs in order of samples, in one file.
+ */
+
+static void usage(void) {
+  printf("Usage: nnablart batch NNB [-c CONTEXTS] [-t THREADS] INPUT "
+         "OUTPUT\n");
+  printf("  -c CONTEXTS  Samples run at the same time, each with own context "
+         "(default 2).\n");
+  printf("  -t THREADS   Threads of rt_set_num_threads() of each context "
+         "(default 1).\n");
+  printf("  INPUT        Concatenated samples, or - to read them from "
+         "stdin.\n");
+  printf("  OUTPUT       Concatenated outputs of samples.\n");
+}
+
+// Bytes of raw data of size values of variable.
+static size_t data_size(const nn_variable_t *variable, int size) {
+  switch (variable->type) {
+  case NN_DATA_TYPE_FLOAT:
+    return size * sizeof(float);
+  case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return size * sizeof(uint16_t);
+  case NN_DATA_TYPE_SIGN:
+    return (size + 7) >> 3;
+  default:
+    return size;
+  }
+}
+
+static size_t input_data_size(rt_context_pointer context, int index) {
+  return data_size(rt_input_variable(context, index),
+                   rt_input_size(context, index));
+}
+
+static size_t output_data_size(rt_context_pointer context, int index) {
+  return data_size(rt_output_variable(context, index),
+                   rt_output_size(context, index));
+}
+
+// Copy next sample to inputs of context. Returns 1 if a sample is read, 0 at
+// the end of samples, or -1 if the last sample is incomplete.
+static int read_sample(rt_context_pointer context, FILE *stream,
+                       const nnb_file_t *file, size_t *offset) {
+  int i; // Iterator
+  for (i = 0; i < rt_num_of_input(context); i++) {
+    size_t size = input_data_size(context, i);
+    if (stream) {
+      size_t read_size = fread(rt_input_buffer(context, i), 1, size, stream);
+      if (read_size != size) {
+        return i == 0 && read_size == 0 ? 0 : -1;
+      }
+    } else {
+      if (*offset + size > file->size) {
+        return i == 0 && *offset == file->size ? 0 : -1;
+      }
+      memcpy(rt_input_buffer(context, i), (uint8_t *)file->data + *offset,
+             size);
+      *offset += size;
+    }
+  }
+  return 1;
+}
+
+static int write_outputs(rt_context_pointer context, FILE *output) {
+  int i; // Iterator
+  for (i = 0; i < rt_num_of_output(context); i++) {
+    size_t size = output_data_size(context, i);
+    if (fwrite(rt_output_buffer(context, i), 1, size, output) != size) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Wait for sample run on context, and write its outputs.
+static int finish_sample(rt_context_pointer context, long long sample,
+                         FILE *output) {
+  rt_return_value_t ret = rt_wait_forward(context);
+  if (ret != RT_RET_NOERROR) {
+    printf("Sample %lld failed with %d.\n", sample, ret);
+    return -1;
+  }
+  if (write_outputs(context, output) != 0) {
+    printf("Failed to write outputs of sample %lld.\n", sample);
+    return -1;
+  }
+  return 0;
+}
+
+int batch(nn_network_t *net, int argc, char *argv[]) {
+  int num_of_contexts = 2;
+  int num_of_threads = 1;
+  rt_context_pointer *contexts = 0;
+  nnb_file_t file = {0};
+  FILE *stream = 0;
+  FILE *output = 0;
+  size_t offset = 0;
+  long long samples = 0, finished = 0;
+  uint64_t start, total;
+  int ret = -1;
+  int i, k; // Iterator
+
+  for (; argc > 0 && argv[0][0] == '-' && argv[0][1] != '\0'; argc--, argv++) {
+    if (strcmp(argv[0], "-c") == 0 && argc > 1) {
+      num_of_contexts = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-t") == 0 && argc > 1) {
+      num_of_threads = atoi(*++argv);
+      argc--;
+    } else {
+      break;
+    }
+  }
+  if (argc != 2 || num_of_contexts < 1 || num_of_threads < 1) {
+    usage();
+    return -1;
+  }
+
+  contexts = calloc(num_of_contexts, sizeof(rt_context_pointer));
+  if (contexts == 0 || rt_allocate_context(&contexts[0]) != RT_RET_NOERROR) {
+    free(contexts);
+    return -1;
+  }
+  rt_set_num_threads(contexts[0], num_of_threads);
+  if (rt_initialize_context(contexts[0], net) != RT_RET_NOERROR) {
+    printf("rt_initialize_context() failed.\n");
+    goto end;
+  }
+  for (k = 1; k < num_of_contexts; k++) {
+    if (rt_clone_context(contexts[0], &contexts[k]) != RT_RET_NOERROR) {
+      printf("rt_clone_context() failed.\n");
+      goto end;
+    }
+  }
+
+  if (strcmp(argv[0], "-") == 0) {
+    stream = stdin;
+  } else if (load_nnb(argv[0], &file) != 0) {
+    printf("Cannot open input file: %s.\n", argv[0]);
+    goto end;
+  }
+#ifdef _MSC_VER
+  fopen_s(&output, argv[1], "wb");
+#else
+  output = fopen(argv[1], "wb");
+#endif
+  if (output == NULL) {
+    printf("Cannot open output file: %s.\n", argv[1]);
+    goto end;
+  }
+
+  start = profile_now();
+  for (;;) {
+    rt_context_pointer context = contexts[samples % num_of_contexts];
+    if (samples >= num_of_contexts) {
+      if (finish_sample(context, finished, output) != 0) {
+        goto end;
+      }
+      finished++;
+    }
+    i = read_sample(context, stream, &file, &offset);
+    if (i < 0) {
+      printf("Sample %lld is incomplete.\n", samples);
+      goto end;
+    }
+    if (i == 0) {
+      break;
+    }
+    if (rt_forward_async(context, 0, 0) != RT_RET_NOERROR) {
+      printf("rt_forward_async() failed.\n");
+      goto end;
+    }
+    samples++;
+  }
+  // Context of the end has no sample, the rest are in order after it.
+  for (; finished < samples; finished++) {
+    if (finish_sample(contexts[finished % num_of_contexts], finished,
+                      output) != 0) {
+      goto end;
+    }
+  }
+  total = profile_now() - start;
+
+  printf("Samples:    %lld, contexts %d, threads %d\n", samples,
+         num_of_contexts, num_of_threads);
+  printf("Throughput: %.1f inferences/s\n",
+         total > 0 ? samples * 1e9 / total : 0.0);
+  ret = 0;
+
+end:
+  // Samples still running are waited before their contexts are freed.
+  for (k = 0; k < num_of_contexts; k++) {
+    if (contexts[k]) {
+      rt_wait_forward(contexts[k]);
+      rt_free_context(&contexts[k]);
+    }
+  }
+  free(contexts);
+  if (output && fclose(output) != 0 && ret == 0) {
+    printf("Failed to write output file: %s.\n", argv[1]);
+    ret = -1;
+  }
+  if (file.data) {
+    unload_nnb(&file);
+  }
+  return ret;
+}
@@ -0,0 +1,526 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For sched_setaffinity()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../functions/utilities/half.h"
+#include "../runtime/runtime_internal.h"
+#include "bench.h"
+#include "cost.h"
+#include "dump_function.h"
+#include "trace.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+/*
+ * Runs network repeatedly and reports latency of rt_forward() measured by
+ * the clock used for profiling. Inputs are read from files like `infer`, or
+ * filled with fixed pseudo random values so that runs are comparable.
+ */
+
+static void usage(void) {
+  printf("Usage: nnablart bench NNB [-w WARMUP] [-n ITERATIONS] "
+         "[-t THREADS] [-p CPUS] [-T TRACE] [-c] [-k] [-K KERNELS] "
+         "[INPUT...]\n");
+  printf("  -w WARMUP      Iterations before measurement (default 10).\n");
+  printf("  -n ITERATIONS  Measured iterations (default 100).\n");
+  printf("  -t THREADS     Threads of rt_set_num_threads() (default 1).\n");
+  printf("  -p CPUS        Pin threads to CPUs, e.g. 0-3,6.\n");
+  printf("  -T TRACE       Write measured iterations as Chrome trace JSON.\n");
+  printf("  -c             Profile functions with hardware counters.\n");
+  printf("  -k             Choose kernels by timing them in initialization.\n");
+  printf("  -K KERNELS     Use kernels chosen in file, or choose by timing and "
+         "save them.\n");
+  printf("  INPUT          Raw data of each input, random if omitted.\n");
+}
+
+static size_t input_data_size(rt_context_pointer context, int index) {
+  size_t size = rt_input_size(context, index);
+  switch (rt_input_variable(context, index)->type) {
+  case NN_DATA_TYPE_FLOAT:
+    return size * sizeof(float);
+  case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return size * sizeof(uint16_t);
+  case NN_DATA_TYPE_SIGN:
+    return (size + 7) >> 3;
+  default:
+    return size;
+  }
+}
+
+static uint32_t next_random(uint32_t *state) {
+  // xorshift32
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+}
+
+// Uniform in [-1, 1) for float types, whole range for integers.
+static void fill_random(rt_context_pointer context, int index,
+                        uint32_t *state) {
+  nn_data_type_t type = rt_input_variable(context, index)->type;
+  void *buffer = rt_input_buffer(context, index);
+  int size = rt_input_size(context, index);
+  int i; // Iterator
+
+  for (i = 0; i < size; i++) {
+    uint32_t r = next_random(state);
+    float value = (float)(r >> 8) / (1 << 23) - 1.0f;
+    switch (type) {
+    case NN_DATA_TYPE_FLOAT:
+      ((float *)buffer)[i] = value;
+      break;
+    case NN_DATA_TYPE_INT16:
+      ((int16_t *)buffer)[i] = (int16_t)r;
+      break;
+    case NN_DATA_TYPE_FLOAT16:
+      ((uint16_t *)buffer)[i] = float_to_float16(value);
+      break;
+    case NN_DATA_TYPE_BFLOAT16:
+      ((uint16_t *)buffer)[i] = float_to_bfloat16(value);
+      break;
+    case NN_DATA_TYPE_SIGN:
+      if (i % 8 == 0) {
+        ((uint8_t *)buffer)[i / 8] = (uint8_t)r;
+      }
+      break;
+    default:
+      ((int8_t *)buffer)[i] = (int8_t)r;
+      break;
+    }
+  }
+}
+
+static int read_input(rt_context_pointer context, int index,
+                      const char *filename) {
+  size_t size = input_data_size(context, index);
+  size_t read_size;
+  long file_size;
+  FILE *input = 0;
+#ifdef _MSC_VER
+  fopen_s(&input, filename, "rb");
+#else
+  input = fopen(filename, "rb");
+#endif
+  if (input == NULL) {
+    printf("Cannot open input file: %s.\n", filename);
+    return -1;
+  }
+  fseek(input, 0L, SEEK_END);
+  file_size = ftell(input);
+  fseek(input, 0L, SEEK_SET);
+  if (file_size != (long)size) {
+    printf("Input[%d] size of %s is %ld bytes, expected %d bytes.\n", index,
+           filename, file_size, (int)size);
+    fclose(input);
+    return -1;
+  }
+  read_size = fread(rt_input_buffer(context, index), 1, size, input);
+  fclose(input);
+  if (read_size != size) {
+    printf("Failed to read input file: %s.\n", filename);
+    return -1;
+  }
+  return 0;
+}
+
+// Restrict this process, and so threads created later, to CPUs in list.
+static int pin_threads(const char *list) {
+#if defined(__linux__)
+  cpu_set_t set;
+  const char *p = list;
+  CPU_ZERO(&set);
+  while (*p) {
+    char *end;
+    long first = strtol(p, &end, 10);
+    long last = first;
+    if (end == p || first < 0) {
+      return -1;
+    }
+    p = end;
+    if (*p == '-') {
+      last = strtol(p + 1, &end, 10);
+      if (end == p + 1 || last < first) {
+        return -1;
+      }
+      p = end;
+    }
+    for (; first <= last && first < CPU_SETSIZE; first++) {
+      CPU_SET((int)first, &set);
+    }
+    if (*p == ',') {
+      p++;
+    } else if (*p) {
+      return -1;
+    }
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#else
+  (void)list;
+  printf("Pinning threads is not supported on this platform.\n");
+  return -1;
+#endif
+}
+
+static void print_init_profile(rt_context_pointer context) {
+  static const char *names[RT_INIT_PHASE_END] = {
+      "version check",   "arena measurement", "variables",
+      "function fusion", "buffer planning",   "buffer allocation",
+      "parameters",      "function io",       "local contexts",
+      "kernel tuning",   "finalization"};
+  rt_init_profile_t profile;
+  int i; // Iterator
+
+  if (rt_get_init_profile(context, &profile) != RT_RET_NOERROR) {
+    return;
+  }
+  for (i = 0; i < RT_INIT_PHASE_END; i++) {
+    if (i != RT_INIT_PHASE_ARENA_MEASUREMENT) {
+      printf("  %-18s %10.1f us\n", names[i], profile.phase_nsec[i] / 1e3);
+    }
+  }
+}
+
+// Work is cost of all calls, and per nano second is per giga per second.
+static void print_profile_line(const char *name, int index,
+                               const rt_function_profile_t *p,
+                               const function_cost_t *work,
+                               uint64_t init_nsec) {
+  const uint64_t *k = p->counters;
+  double nsec = p->total_nsec > 0 ? (double)p->total_nsec : 1.0;
+  printf("%-24s %5d %8u %10.1f %12.1f %9.2f %9.2f %14llu %14llu %6.2f "
+         "%12llu %12llu\n",
+         name, index, p->call_count, init_nsec / 1e3, p->total_nsec / 1e3,
+         work->flops / nsec,
+         (work->read_bytes + work->written_bytes) / nsec,
+         (unsigned long long)k[RT_PROFILE_COUNTER_CYCLES],
+         (unsigned long long)k[RT_PROFILE_COUNTER_INSTRUCTIONS],
+         k[RT_PROFILE_COUNTER_CYCLES]
+             ? (double)k[RT_PROFILE_COUNTER_INSTRUCTIONS] /
+                   k[RT_PROFILE_COUNTER_CYCLES]
+             : 0.0,
+         (unsigned long long)k[RT_PROFILE_COUNTER_L1D_MISSES],
+         (unsigned long long)k[RT_PROFILE_COUNTER_LLC_MISSES]);
+}
+
+// Each function, and sum of functions of each type. Types are in order of
+// their first function. GFLOP/s and GB/s are achieved rates of costs which
+// `nnablart dump --cost` estimates.
+static int print_profile(nn_network_t *net, rt_context_pointer context) {
+  int *list = (int *)NN_GET(net, net->functions.list);
+  int num_of_functions = 0;
+  const rt_function_profile_t *profile =
+      rt_get_profile(context, &num_of_functions);
+  rt_function_profile_t *types;
+  function_cost_t *works;
+  uint64_t *inits;
+  int *counts;
+  int num_of_types = 0;
+  int i, j, k; // Iterator
+
+  types = malloc(sizeof(rt_function_profile_t) * (num_of_functions + 1));
+  works = malloc(sizeof(function_cost_t) * (num_of_functions + 1));
+  inits = malloc(sizeof(uint64_t) * (num_of_functions + 1));
+  counts = malloc(sizeof(int) * (num_of_functions + 1));
+  if (types == 0 || works == 0 || inits == 0 || counts == 0) {
+    free(types);
+    free(works);
+    free(inits);
+    free(counts);
+    return -1;
+  }
+  printf("%-24s %5s %8s %10s %12s %9s %9s %14s %14s %6s %12s %12s\n",
+         "Function", "Index", "Calls", "Init(us)", "Total(us)", "GFLOP/s",
+         "GB/s", "Cycles", "Instructions", "IPC", "L1DMisses", "LLCMisses");
+  for (i = 0; i < num_of_functions; i++) {
+    const rt_function_profile_t *p = profile + i;
+    function_cost_t work;
+    if (p->call_count == 0) {
+      continue; // Merged into other function.
+    }
+    function_cost(net, (nn_function_t *)(NN_GET(net, list[i])), &work);
+    work.flops *= p->call_count;
+    work.read_bytes *= p->call_count;
+    work.written_bytes *= p->call_count;
+    print_profile_line(function_type_name(p->type), i, p, &work,
+                       rt_function_init_nsec(context, i));
+    for (j = 0; j < num_of_types && types[j].type != p->type; j++) {
+    }
+    if (j == num_of_types) {
+      memset(types + j, 0, sizeof(rt_function_profile_t));
+      memset(works + j, 0, sizeof(function_cost_t));
+      inits[j] = 0;
+      types[j].type = p->type;
+      counts[j] = 0;
+      num_of_types++;
+    }
+    types[j].call_count += p->call_count;
+    types[j].total_nsec += p->total_nsec;
+    for (k = 0; k < RT_PROFILE_COUNTER_END; k++) {
+      types[j].counters[k] += p->counters[k];
+    }
+    works[j].flops += work.flops;
+    works[j].read_bytes += work.read_bytes;
+    works[j].written_bytes += work.written_bytes;
+    inits[j] += rt_function_init_nsec(context, i);
+    counts[j]++;
+  }
+  printf("%-24s %5s %8s %10s %12s %9s %9s %14s %14s %6s %12s %12s\n",
+         "Type", "Count", "Calls", "Init(us)", "Total(us)", "GFLOP/s", "GB/s",
+         "Cycles", "Instructions", "IPC", "L1DMisses", "LLCMisses");
+  for (j = 0; j < num_of_types; j++) {
+    print_profile_line(function_type_name(types[j].type), counts[j], types + j,
+                       works + j, inits[j]);
+  }
+  free(types);
+  free(works);
+  free(inits);
+  free(counts);
+  return 0;
+}
+
+// Kernels saved by former run, or NULL if there is no file.
+static uint8_t *read_kernel_choices(const char *filename, int *size) {
+  uint8_t *choices;
+  long file_size;
+  FILE *input = 0;
+#ifdef _MSC_VER
+  fopen_s(&input, filename, "rb");
+#else
+  input = fopen(filename, "rb");
+#endif
+  if (input == NULL) {
+    return 0;
+  }
+  fseek(input, 0L, SEEK_END);
+  file_size = ftell(input);
+  fseek(input, 0L, SEEK_SET);
+  choices = malloc(file_size > 0 ? file_size : 1);
+  if (choices && fread(choices, 1, file_size, input) != (size_t)file_size) {
+    free(choices);
+    choices = 0;
+  }
+  fclose(input);
+  *size = (int)file_size;
+  return choices;
+}
+
+static int write_kernel_choices(rt_context_pointer context,
+                                const char *filename) {
+  const uint8_t *choices;
+  int size;
+  FILE *output = 0;
+  if (rt_get_kernel_choices(context, &choices, &size) != RT_RET_NOERROR) {
+    return -1;
+  }
+#ifdef _MSC_VER
+  fopen_s(&output, filename, "wb");
+#else
+  output = fopen(filename, "wb");
+#endif
+  if (output == NULL) {
+    printf("Cannot open kernel file: %s.\n", filename);
+    return -1;
+  }
+  fwrite(choices, 1, size, output);
+  fclose(output);
+  return 0;
+}
+
+static int compare_times(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// Nearest rank percentile of sorted times in microsecond.
+static double percentile(const uint64_t *times, int count, int p) {
+  int rank = (count * p + 99) / 100;
+  return times[rank > 0 ? rank - 1 : 0] / 1e3;
+}
+
+int bench(nn_network_t *net, int argc, char *argv[]) {
+  int warmup = 10;
+  int iterations = 100;
+  int num_of_threads = 1;
+  const char *cpus = 0;
+  const char *trace = 0;
+  int counters = 0;
+  int tuning = 0;
+  const char *kernels = 0;
+  uint8_t *choices = 0;
+  int num_of_choices = 0;
+  rt_trace_event_t *events = 0;
+  rt_context_pointer context = 0;
+  uint64_t *times = 0;
+  uint64_t start, init_time, total = 0;
+  uint32_t state = 2463534242u;
+  int ret = -1;
+  int i; // Iterator
+
+  for (; argc > 0 && argv[0][0] == '-'; argc--, argv++) {
+    if (strcmp(argv[0], "-w") == 0 && argc > 1) {
+      warmup = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-n") == 0 && argc > 1) {
+      iterations = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-t") == 0 && argc > 1) {
+      num_of_threads = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-p") == 0 && argc > 1) {
+      cpus = *++argv;
+      argc--;
+    } else if (strcmp(argv[0], "-c") == 0) {
+      counters = 1;
+    } else if (strcmp(argv[0], "-T") == 0 && argc > 1) {
+      trace = *++argv;
+      argc--;
+    } else if (strcmp(argv[0], "-k") == 0) {
+      tuning = 1;
+    } else if (strcmp(argv[0], "-K") == 0 && argc > 1) {
+      kernels = *++argv;
+      argc--;
+    } else {
+      break;
+    }
+  }
+  if (warmup < 0 || iterations < 1 || num_of_threads < 1) {
+    usage();
+    return -1;
+  }
+  if (cpus && pin_threads(cpus) != 0) {
+    printf("Cannot pin threads to CPUs: %s.\n", cpus);
+    return -1;
+  }
+
+  if (rt_allocate_context(&context) != RT_RET_NOERROR) {
+    return -1;
+  }
+  // Kernels are timed with threads used to run them.
+  if (rt_set_num_threads(context, num_of_threads) != RT_RET_NOERROR) {
+    printf("Cannot use %d threads.\n", num_of_threads);
+    goto end;
+  }
+  if (kernels) {
+    choices = read_kernel_choices(kernels, &num_of_choices);
+    if (choices) {
+      rt_set_kernel_choices(context, choices, num_of_choices);
+    } else {
+      tuning = 1;
+    }
+  }
+  rt_set_kernel_tuning(context, tuning);
+  start = profile_now();
+  if (rt_initialize_context(context, net) != RT_RET_NOERROR) {
+    printf("rt_initialize_context() failed.\n");
+    goto end;
+  }
+  init_time = profile_now() - start;
+  if (kernels && choices == 0 && write_kernel_choices(context, kernels) == 0) {
+    printf("Kernels:    saved to %s\n", kernels);
+  }
+
+  if (counters) {
+    rt_set_profiling(context, 1);
+    if (rt_set_profile_counters(context, 1) != RT_RET_NOERROR) {
+      printf("Hardware counters are not available, only time is profiled.\n");
+    }
+  }
+
+  if (argc != 0 && argc != rt_num_of_input(context)) {
+    printf("Network has %d inputs, but %d files are given.\n",
+           rt_num_of_input(context), argc);
+    usage();
+    goto end;
+  }
+  for (i = 0; i < rt_num_of_input(context); i++) {
+    if (argc == 0) {
+      fill_random(context, i, &state);
+    } else if (read_input(context, i, argv[i]) != 0) {
+      goto end;
+    }
+  }
+
+  times = malloc(sizeof(uint64_t) * iterations);
+  if (times == 0) {
+    goto end;
+  }
+  if (trace) {
+    int capacity = iterations * rt_num_of_functions(context);
+    events = malloc(sizeof(rt_trace_event_t) * (capacity + 1));
+    if (events == 0) {
+      goto end;
+    }
+  }
+  for (i = 0; i < warmup + iterations; i++) {
+    if (trace && i == warmup) {
+      rt_set_trace(context, events, iterations * rt_num_of_functions(context));
+    }
+    if (counters && i == warmup) {
+      rt_reset_profile(context);
+    }
+    start = profile_now();
+    if (rt_forward(context) != RT_RET_NOERROR) {
+      printf("rt_forward() failed.\n");
+      goto end;
+    }
+    if (i >= warmup) {
+      times[i - warmup] = profile_now() - start;
+      total += times[i - warmup];
+    }
+  }
+  qsort(times, iterations, sizeof(uint64_t), compare_times);
+
+  printf("Init:       %.1f us\n", init_time / 1e3);
+  print_init_profile(context);
+  printf("Iterations: %d (warmup %d), threads %d\n", iterations, warmup,
+         num_of_threads);
+  printf("Latency:    min %.1f mean %.1f p50 %.1f p90 %.1f p99 %.1f max %.1f "
+         "us\n",
+         times[0] / 1e3, total / 1e3 / iterations,
+         percentile(times, iterations, 50), percentile(times, iterations, 90),
+         percentile(times, iterations, 99), times[iterations - 1] / 1e3);
+  printf("Throughput: %.1f inferences/s\n",
+         total > 0 ? iterations * 1e9 / total : 0.0);
+  ret = 0;
+  if (counters) {
+    ret = print_profile(net, context);
+  }
+  if (ret == 0 && trace) {
+    ret = write_trace(trace, net, context, events,
+                      rt_num_of_trace_events(context));
+  }
+
+end:
+  free(choices);
+  free(events);
+  free(times);
+  rt_free_context(&context);
+  return ret;
+}
@@ -0,0 +1,459 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(_MSC_VER) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For opendir() with -std=c99
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../runtime/runtime_internal.h"
+#include "calibrate.h"
+
+#if defined(_MSC_VER)
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+/*
+ * Runs float network over sample inputs and records range of every float
+ * variable from a hook after each function. Recommended fp_pos is the
+ * largest one which keeps the absolute maximum inside the integer range.
+ *
+ * NNB has no variable names, so names are taken in order from `variables:`
+ * section of settings written by `nnabla_cli convert` for the same network.
+ * Without it variables are named by their index.
+ */
+
+void free_names(name_list_t *list) {
+  int i; // Iterator
+  for (i = 0; i < list->num_of_names; i++) {
+    free(list->names[i]);
+  }
+  free(list->names);
+  list->names = 0;
+  list->num_of_names = 0;
+}
+
+static int add_name(name_list_t *list, const char *name, size_t length) {
+  char **names =
+      realloc(list->names, sizeof(char *) * (list->num_of_names + 1));
+  if (names == 0) {
+    return -1;
+  }
+  list->names = names;
+  names[list->num_of_names] = malloc(length + 1);
+  if (names[list->num_of_names] == 0) {
+    return -1;
+  }
+  memcpy(names[list->num_of_names], name, length);
+  names[list->num_of_names++][length] = '\0';
+  return 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+  return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+int list_files(const char *dir, name_list_t *list) {
+  size_t dir_length = strlen(dir);
+  char path[1024];
+#if defined(_MSC_VER)
+  struct _finddata_t entry;
+  intptr_t handle;
+  snprintf(path, sizeof(path), "%s\\*", dir);
+  handle = _findfirst(path, &entry);
+  if (handle == -1) {
+    return -1;
+  }
+  do {
+    const char *name = entry.name;
+    if (entry.attrib & _A_SUBDIR) {
+      continue;
+    }
+#else
+  struct dirent *entry;
+  DIR *d = opendir(dir);
+  if (d == 0) {
+    return -1;
+  }
+  while ((entry = readdir(d)) != 0) {
+    const char *name = entry->d_name;
+    if (name[0] == '.') {
+      continue;
+    }
+#endif
+    if (dir_length + strlen(name) + 2 > sizeof(path)) {
+      continue;
+    }
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    if (add_name(list, path, strlen(path)) != 0) {
+      break;
+    }
+#if defined(_MSC_VER)
+  } while (_findnext(handle, &entry) == 0);
+  _findclose(handle);
+#else
+  }
+  closedir(d);
+#endif
+  qsort(list->names, list->num_of_names, sizeof(char *), compare_names);
+  return 0;
+}
+
+int read_variable_names(const char *filename, name_list_t *list) {
+  char line[1024];
+  int in_variables = 0;
+  FILE *fp = fopen(filename, "r");
+  if (fp == 0) {
+    return -1;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    char *name = line;
+    char *colon;
+    if (line[0] != ' ' && line[0] != '\n' && line[0] != '#') {
+      in_variables = strncmp(line, "variables:", 10) == 0;
+      continue;
+    }
+    while (*name == ' ') {
+      name++;
+    }
+    colon = strchr(name, ':');
+    if (!in_variables || *name == '#' || colon == 0) {
+      continue;
+    }
+    if (add_name(list, name, colon - name) != 0) {
+      fclose(fp);
+      return -1;
+    }
+  }
+  fclose(fp);
+  return 0;
+}
+
+nn_variable_t *get_variable(nn_network_t *net, int index) {
+  int *list = (int *)NN_GET(net, net->variables.list);
+  return (nn_variable_t *)NN_GET(net, list[index]);
+}
+
+int variable_size(nn_network_t *net, nn_variable_t *v) {
+  int *shape = (int *)NN_GET(net, v->shape.list);
+  int size = 1;
+  int i; // Iterator
+  for (i = 0; i < v->shape.size; i++) {
+    size *= shape[i];
+  }
+  return size;
+}
+
+static void observe(calibration_t *cal, int index, const float *data) {
+  nn_variable_t *v = get_variable(cal->net, index);
+  int size = variable_size(cal->net, v);
+  int i; // Iterator
+  if (v->type != NN_DATA_TYPE_FLOAT || data == 0) {
+    return;
+  }
+  for (i = 0; i < size; i++) {
+    if (data[i] < cal->min[index]) {
+      cal->min[index] = data[i];
+    }
+    if (data[i] > cal->max[index]) {
+      cal->max[index] = data[i];
+    }
+  }
+  cal->observed[index] = 1;
+}
+
+static void observe_outputs(void *user_data, int index,
+                            nn_function_t *function) {
+  calibration_t *cal = user_data;
+  int *outputs = (int *)NN_GET(cal->net, function->outputs.list);
+  int i; // Iterator
+  (void)index;
+  for (i = 0; i < function->outputs.size; i++) {
+    observe(cal, outputs[i], rt_variable_buffer(cal->context, outputs[i]));
+  }
+}
+
+int recommend_fp_pos(float min, float max, int bits) {
+  float range = fabsf(min) > fabsf(max) ? fabsf(min) : fabsf(max);
+  int fp_pos;
+  if (!(range > 0.0f)) {
+    return bits - 1;
+  }
+  fp_pos = (int)floor(log2((double)((1 << (bits - 1)) - 1) / range));
+  return fp_pos < 0 ? 0 : fp_pos > 15 ? 15 : fp_pos;
+}
+
+void write_variable_name(FILE *fp, const name_list_t *names, int index) {
+  if (index < names->num_of_names) {
+    fprintf(fp, "  %s: ", names->names[index]);
+  } else {
+    fprintf(fp, "  variable_%d: ", index);
+  }
+}
+
+static void write_variable_setting(FILE *fp, calibration_t *cal,
+                                   const name_list_t *names, int index,
+                                   int bits) {
+  nn_variable_t *v = get_variable(cal->net, index);
+  write_variable_name(fp, names, index);
+  switch (v->type) {
+  case NN_DATA_TYPE_FLOAT:
+    if (cal->observed[index]) {
+      fprintf(fp, "FIXED%d_%d # min %g max %g\n", bits,
+              recommend_fp_pos(cal->min[index], cal->max[index], bits),
+              cal->min[index], cal->max[index]);
+    } else {
+      fprintf(fp, "FLOAT32 # not calculated\n");
+    }
+    break;
+  case NN_DATA_TYPE_INT16:
+    fprintf(fp, "FIXED16_%d\n", v->fp_pos);
+    break;
+  case NN_DATA_TYPE_INT8:
+    fprintf(fp, "FIXED8_%d\n", v->fp_pos);
+    break;
+  default:
+    fprintf(fp, "# type %d is kept\n", v->type);
+    break;
+  }
+}
+
+/// Scales along axis 0 of float parameters with 2 or more dimensions.
+static void write_channel_scales(FILE *fp, calibration_t *cal,
+                                 const name_list_t *names, int bits) {
+  int i, j, k; // Iterator
+  fprintf(fp, "quantization:\n");
+  for (i = 0; i < cal->net->variables.size; i++) {
+    nn_variable_t *v = get_variable(cal->net, i);
+    const int *shape = (const int *)NN_GET(cal->net, v->shape.list);
+    const float *data;
+    int inner;
+    if (v->type != NN_DATA_TYPE_FLOAT || v->data_index < 0 ||
+        v->shape.size < 2) {
+      continue;
+    }
+    data = (const float *)NN_GET(cal->net, v->data_index);
+    inner = variable_size(cal->net, v) / shape[0];
+    if (i < names->num_of_names) {
+      fprintf(fp, "  %s:\n", names->names[i]);
+    } else {
+      fprintf(fp, "  variable_%d:\n", i);
+    }
+    fprintf(fp, "    axis: 0\n    scales: [");
+    for (j = 0; j < shape[0]; j++) {
+      float range = 0.0f;
+      for (k = 0; k < inner; k++) {
+        float value = fabsf(data[j * inner + k]);
+        range = value > range ? value : range;
+      }
+      fprintf(fp, "%s%g", j ? ", " : "",
+              range > 0.0f ? range / ((1 << (bits - 1)) - 1) : 1.0f);
+    }
+    fprintf(fp, "]\n");
+  }
+}
+
+int read_sample(const char *filename, void *buffer, size_t size) {
+  size_t read_size;
+  FILE *fp = fopen(filename, "rb");
+  if (fp == 0) {
+    printf("Cannot open input file: %s.\n", filename);
+    return -1;
+  }
+  read_size = fread(buffer, 1, size, fp);
+  fclose(fp);
+  if (read_size != size) {
+    printf("Input data size of %s is invalid. Expected %d bytes.\n", filename,
+           (int)size);
+    return -1;
+  }
+  return 0;
+}
+
+int observe_samples(calibration_t *cal, const name_list_t *samples,
+                    int num_of_samples) {
+  nn_network_t *net = cal->net;
+  int *inputs = (int *)NN_GET(net, net->inputs.list);
+  int ret = 0;
+  int i, j; // Iterator
+
+  for (i = 0; i < net->variables.size; i++) {
+    cal->min[i] = FLT_MAX;
+    cal->max[i] = -FLT_MAX;
+    cal->observed[i] = 0;
+  }
+  // Parameters are observed once from network.
+  for (i = 0; i < net->variables.size; i++) {
+    nn_variable_t *v = get_variable(net, i);
+    if (v->data_index >= 0) {
+      observe(cal, i, (const float *)NN_GET(net, v->data_index));
+    }
+  }
+
+  rt_set_function_hook(cal->context, 0, observe_outputs, cal);
+  for (j = 0; j < num_of_samples && ret == 0; j++) {
+    for (i = 0; i < rt_num_of_input(cal->context); i++) {
+      if (read_sample(samples[i].names[j], rt_input_buffer(cal->context, i),
+                      rt_input_size(cal->context, i) * sizeof(float)) != 0) {
+        ret = -1;
+        break;
+      }
+      observe(cal, inputs[i], rt_input_buffer(cal->context, i));
+    }
+    if (ret == 0 && rt_forward(cal->context) != RT_RET_NOERROR) {
+      printf("Error occurs in forward of %s.\n", samples[0].names[j]);
+      ret = -1;
+    }
+  }
+  rt_set_function_hook(cal->context, 0, 0, 0);
+  return ret;
+}
+
+static void usage(void) {
+  printf("Usage: nnablart calibrate NNB [-b BITS] [-c] [-t SETTINGS] "
+         "OUTPUT INPUT_DIR...\n");
+  printf("  -b BITS      8 or 16, width of recommended type (default 8).\n");
+  printf("  -c           Also write per channel scales of parameters.\n");
+  printf("  -t SETTINGS  Settings written by nnabla_cli convert to take "
+         "variable names from.\n");
+  printf("  INPUT_DIR    Directory of raw float samples per network input.\n");
+}
+
+int calibrate(nn_network_t *net, int argc, char *argv[]) {
+  int bits = 8;
+  int channel_scales = 0;
+  const char *template_name = 0;
+  const char *output_name;
+  name_list_t names = {0, 0};
+  name_list_t *samples = 0;
+  calibration_t cal;
+  int num_of_samples = -1;
+  int ret = -1;
+  int i; // Iterator
+  FILE *fp;
+
+  for (; argc > 0 && argv[0][0] == '-'; argc--, argv++) {
+    if (strcmp(argv[0], "-b") == 0 && argc > 1) {
+      bits = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-t") == 0 && argc > 1) {
+      template_name = *++argv;
+      argc--;
+    } else if (strcmp(argv[0], "-c") == 0) {
+      channel_scales = 1;
+    } else {
+      break;
+    }
+  }
+  if ((bits != 8 && bits != 16) || argc < 2) {
+    usage();
+    return -1;
+  }
+  output_name = argv[0];
+  argv++;
+  argc--;
+
+  memset(&cal, 0, sizeof(cal));
+  cal.net = net;
+  if (rt_allocate_context(&cal.context) != RT_RET_NOERROR) {
+    return -1;
+  }
+  if (rt_initialize_context(cal.context, net) != RT_RET_NOERROR) {
+    printf("rt_initialize_context() failed.\n");
+    goto end;
+  }
+  if (argc != rt_num_of_input(cal.context)) {
+    printf("Required input directories: %d, actual: %d\n",
+           rt_num_of_input(cal.context), argc);
+    goto end;
+  }
+  if (template_name && read_variable_names(template_name, &names) != 0) {
+    printf("Cannot read settings file: %s.\n", template_name);
+    goto end;
+  }
+  if (names.num_of_names && names.num_of_names != net->variables.size) {
+    printf("Settings have %d variables, but network has %d.\n",
+           names.num_of_names, net->variables.size);
+    goto end;
+  }
+
+  samples = calloc(argc, sizeof(name_list_t));
+  cal.min = malloc(sizeof(float) * net->variables.size);
+  cal.max = malloc(sizeof(float) * net->variables.size);
+  cal.observed = calloc(net->variables.size, sizeof(int));
+  if (samples == 0 || cal.min == 0 || cal.max == 0 || cal.observed == 0) {
+    goto end;
+  }
+  for (i = 0; i < argc; i++) {
+    if (rt_input_variable(cal.context, i)->type != NN_DATA_TYPE_FLOAT) {
+      printf("Input[%d] is not float.\n", i);
+      goto end;
+    }
+    if (list_files(argv[i], samples + i) != 0) {
+      printf("Cannot open input directory: %s.\n", argv[i]);
+      goto end;
+    }
+    if (num_of_samples < 0 || samples[i].num_of_names < num_of_samples) {
+      num_of_samples = samples[i].num_of_names;
+    }
+  }
+  if (num_of_samples <= 0) {
+    printf("No samples.\n");
+    goto end;
+  }
+
+  if (observe_samples(&cal, samples, num_of_samples) != 0) {
+    goto end;
+  }
+
+  fp = fopen(output_name, "w");
+  if (fp == 0) {
+    printf("Cannot open output file: %s.\n", output_name);
+    goto end;
+  }
+  fprintf(fp, "# Calibrated with %d samples.\n", num_of_samples);
+  fprintf(fp, "variables:\n");
+  for (i = 0; i < net->variables.size; i++) {
+    write_variable_setting(fp, &cal, &names, i, bits);
+  }
+  if (channel_scales) {
+    write_channel_scales(fp, &cal, &names, bits);
+  }
+  fclose(fp);
+  printf("Calibrated %d variables with %d samples into %s.\n",
+         net->variables.size, num_of_samples, output_name);
+  ret = 0;
+
+end:
+  for (i = 0; samples && i < argc; i++) {
+    free_names(samples + i);
+  }
+  free(samples);
+  free_names(&names);
+  free(cal.min);
+  free(cal.max);
+  free(cal.observed);
+  rt_free_context(&cal.context);
+  return ret;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_CALIBRATE_H_181210120000_
+#define H_CALIBRATE_H_181210120000_
+
+#include <stdio.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+typedef struct {
+  char **names;
+  int num_of_names;
+} name_list_t;
+
+typedef struct {
+  nn_network_t *net;
+  rt_context_pointer context;
+  float *min;
+  float *max;
+  int *observed;
+} calibration_t;
+
+int calibrate(nn_network_t *net, int argc, char *argv[]);
+
+void free_names(name_list_t *list);
+
+/// Regular files in directory as paths sorted by name.
+int list_files(const char *dir, name_list_t *list);
+
+/// Names in `variables:` section of settings YAML.
+int read_variable_names(const char *filename, name_list_t *list);
+
+/// Write `  name: ` of variable at index, by its index without names.
+void write_variable_name(FILE *fp, const name_list_t *names, int index);
+
+nn_variable_t *get_variable(nn_network_t *net, int index);
+int variable_size(nn_network_t *net, nn_variable_t *v);
+
+/// Largest fp_pos which keeps range in signed integer of bits.
+int recommend_fp_pos(float min, float max, int bits);
+
+/// Read size bytes of raw sample.
+int read_sample(const char *filename, void *buffer, size_t size);
+
+/// Range of float variables in cal->min and cal->max, running cal->context
+/// over num_of_samples samples. samples has files of each input.
+int observe_samples(calibration_t *cal, const name_list_t *samples,
+                    int num_of_samples);
+
+#endif // H_CALIBRATE_H_181210120000_
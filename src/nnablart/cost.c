@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../runtime/runtime_internal.h"
+#include "cost.h"
+
+/*
+ * Costs are what functions compute, not what kernels do. Functions with
+ * weights count multiply accumulates of dense weights, pooling counts each
+ * element of window, and others count one operation for each element of
+ * larger one of first input and first output. Bytes are whole inputs and
+ * outputs read or written once, so cache reuse and packed or compressed
+ * parameters are not reflected.
+ */
+
+static nn_variable_t *variable(nn_network_t *net, nn_list_t vars, int index) {
+  int *list = (int *)NN_GET(net, vars.list);
+  int *variables = (int *)NN_GET(net, net->variables.list);
+  if (index >= vars.size) {
+    return 0;
+  }
+  return (nn_variable_t *)(NN_GET(net, variables[list[index]]));
+}
+
+static uint64_t num_of_elements(nn_network_t *net, nn_variable_t *var) {
+  int *shape;
+  uint64_t size = 1;
+  int i; // Iterator
+  if (var == 0) {
+    return 0;
+  }
+  shape = (int *)NN_GET(net, var->shape.list);
+  for (i = 0; i < var->shape.size; i++) {
+    size *= shape[i];
+  }
+  return size;
+}
+
+static int dimension(nn_network_t *net, nn_variable_t *var, int axis) {
+  if (var == 0 || axis < 0 || axis >= var->shape.size) {
+    return 1;
+  }
+  return ((int *)NN_GET(net, var->shape.list))[axis];
+}
+
+static uint64_t variables_bytes(nn_network_t *net, nn_list_t vars) {
+  uint64_t bits = 0;
+  int i; // Iterator
+  for (i = 0; i < vars.size; i++) {
+    nn_variable_t *var = variable(net, vars, i);
+    uint64_t size = num_of_elements(net, var);
+    switch (var->type) {
+    case NN_DATA_TYPE_FLOAT:
+      bits += size * 32;
+      break;
+    case NN_DATA_TYPE_INT16:
+    case NN_DATA_TYPE_FLOAT16:
+    case NN_DATA_TYPE_BFLOAT16:
+      bits += size * 16;
+      break;
+    case NN_DATA_TYPE_SIGN:
+      bits += size;
+      break;
+    default:
+      bits += size * 8;
+      break;
+    }
+  }
+  return (bits + 7) / 8;
+}
+
+// Elements of weight used for one element of output or input.
+static uint64_t weight_per_channel(nn_network_t *net, nn_function_t *func) {
+  nn_variable_t *weight = variable(net, func->inputs, 1);
+  int channels = dimension(net, weight, 0);
+  return channels > 0 ? num_of_elements(net, weight) / channels : 0;
+}
+
+// Recurrent functions apply w_init, and w to following layers, to each
+// element of sequence and batch.
+static uint64_t recurrent_macs(nn_network_t *net, nn_function_t *func,
+                               int w_init, int num_of_layers) {
+  nn_variable_t *x = variable(net, func->inputs, 0);
+  uint64_t weights = num_of_elements(net, variable(net, func->inputs, w_init));
+  if (num_of_layers > 1) {
+    weights += num_of_elements(net, variable(net, func->inputs, w_init + 1));
+  }
+  return (uint64_t)dimension(net, x, 0) * dimension(net, x, 1) * weights;
+}
+
+static uint64_t window_size(nn_network_t *net, nn_list_t kernel) {
+  int *list = (int *)NN_GET(net, kernel.list);
+  uint64_t size = 1;
+  int i; // Iterator
+  for (i = 0; i < kernel.size; i++) {
+    size *= list[i];
+  }
+  return size;
+}
+
+void function_cost(nn_network_t *net, nn_function_t *func,
+                   function_cost_t *cost) {
+  nn_variable_t *x = variable(net, func->inputs, 0);
+  nn_variable_t *y = variable(net, func->outputs, 0);
+  uint64_t inputs = num_of_elements(net, x);
+  uint64_t outputs = num_of_elements(net, y);
+
+  memset(cost, 0, sizeof(function_cost_t));
+  cost->read_bytes = variables_bytes(net, func->inputs);
+  cost->written_bytes = variables_bytes(net, func->outputs);
+
+  switch (func->type) {
+  case NN_FUNCTION_AFFINE:
+  case NN_FUNCTION_BINARY_CONNECT_AFFINE_0:
+  case NN_FUNCTION_BINARY_CONNECT_AFFINE:
+  case NN_FUNCTION_BINARY_WEIGHT_AFFINE_0:
+  case NN_FUNCTION_BINARY_WEIGHT_AFFINE:
+  case NN_FUNCTION_INQ_AFFINE:
+    // Weight is (inputs, outputs...).
+    cost->macs =
+        outputs * dimension(net, variable(net, func->inputs, 1), 0);
+    break;
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION:
+  case NN_FUNCTION_DEPTHWISE_CONVOLUTION:
+  case NN_FUNCTION_BINARY_CONNECT_CONVOLUTION_0:
+  case NN_FUNCTION_BINARY_CONNECT_CONVOLUTION:
+  case NN_FUNCTION_BINARY_WEIGHT_CONVOLUTION_0:
+  case NN_FUNCTION_BINARY_WEIGHT_CONVOLUTION:
+  case NN_FUNCTION_INQ_CONVOLUTION:
+    // Weight is (output channels, ...).
+    cost->macs = outputs * weight_per_channel(net, func);
+    break;
+  case NN_FUNCTION_DECONVOLUTION:
+  case NN_FUNCTION_DEPTHWISE_DECONVOLUTION:
+    // Weight is (input channels, ...).
+    cost->macs = inputs * weight_per_channel(net, func);
+    break;
+  case NN_FUNCTION_BATCH_MATMUL: {
+    nn_function_batch_matmul_t *f = (nn_function_batch_matmul_t *)func;
+    int axis = x ? x->shape.size - (f->transpose_a ? 2 : 1) : 0;
+    cost->macs = outputs * dimension(net, x, axis);
+  } break;
+  case NN_FUNCTION_RNN:
+    cost->macs = recurrent_macs(net, func, 2,
+                                ((nn_function_rnn_t *)func)->num_layers);
+    break;
+  case NN_FUNCTION_LSTM:
+    cost->macs = recurrent_macs(net, func, 3,
+                                ((nn_function_lstm_t *)func)->num_layers);
+    break;
+  case NN_FUNCTION_GRU:
+    cost->macs = recurrent_macs(net, func, 2,
+                                ((nn_function_gru_t *)func)->num_layers);
+    break;
+  case NN_FUNCTION_MAX_POOLING_0:
+  case NN_FUNCTION_MAX_POOLING:
+  case NN_FUNCTION_AVERAGE_POOLING_0:
+  case NN_FUNCTION_AVERAGE_POOLING:
+  case NN_FUNCTION_SUM_POOLING_0:
+  case NN_FUNCTION_SUM_POOLING:
+    // Kernel is first argument of all pooling functions.
+    cost->flops =
+        outputs * window_size(net, ((nn_function_max_pooling_t *)func)->kernel);
+    return;
+  default:
+    cost->flops = inputs > outputs ? inputs : outputs;
+    return;
+  }
+  cost->flops = cost->macs * 2;
+}
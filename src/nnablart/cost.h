@@ -0,0 +1,31 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_COST_H_181220120000_
+#define H_COST_H_181220120000_
+
+#include <stdint.h>
+
+/// Work of one execution of a function estimated from shapes and types.
+typedef struct {
+  uint64_t macs;          ///< Multiply accumulates.
+  uint64_t flops;         ///< Operations, 2 for each multiply accumulate.
+  uint64_t read_bytes;    ///< Bytes of inputs including parameters.
+  uint64_t written_bytes; ///< Bytes of outputs.
+} function_cost_t;
+
+void function_cost(nn_network_t *net, nn_function_t *func,
+                   function_cost_t *cost);
+
+#endif // H_COST_H_181220120000_
@@ -14,17 +14,168 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nnablart/network.h>
 #include <nnablart/runtime.h>
 
 #include "../runtime/runtime_internal.h"
+#include "cost.h"
 #include "dump_function.h"
 
+static void usage(void) {
+  printf("Usage: nnablart dump NNB [--memory [-p] [-f] | --cost]\n");
+  printf("  --memory  Print memory which runtime allocates for network.\n");
+  printf("  --cost    Print operations and bytes of each function.\n");
+  printf("  -p        With rt_set_buffer_planning().\n");
+  printf("  -f        With rt_set_function_fusion().\n");
+}
+
+static void print_memory(const char *name, size_t bytes) {
+  printf("NNB: Memory %-26s %lu\n", name, (unsigned long)bytes);
+}
+
+static int dump_memory(nn_network_t *net, int planning, int fusion) {
+  rt_context_pointer context = 0;
+  rt_memory_stats_t stats;
+  int ret = -1;
+  int i; // Iterator
+
+  if (rt_allocate_context(&context) != RT_RET_NOERROR) {
+    return -1;
+  }
+  rt_set_buffer_planning(context, planning);
+  rt_set_function_fusion(context, fusion);
+  if (rt_initialize_context(context, net) != RT_RET_NOERROR) {
+    printf("rt_initialize_context() failed.\n");
+    goto end;
+  }
+  if (rt_get_memory_stats(context, &stats) != RT_RET_NOERROR) {
+    printf("rt_get_memory_stats() failed.\n");
+    goto end;
+  }
+
+  int *list = (int *)NN_GET(net, net->functions.list);
+  for (i = 0; i < rt_num_of_functions(context); i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(net, *(list + i)));
+    printf("NNB: Function[%d] type:%d private:%lu\n", i, func->type,
+           (unsigned long)rt_function_private_size(context, i));
+  }
+  print_memory("parameters (in network)", stats.parameter_bytes);
+  print_memory("activations", stats.activation_bytes);
+  print_memory("activations alive at once", stats.peak_activation_bytes);
+  print_memory("function private", stats.private_bytes);
+  print_memory("scratch", stats.scratch_bytes);
+  print_memory("context", stats.context_bytes);
+  print_memory("peak", stats.peak_bytes);
+  ret = 0;
+
+end:
+  rt_free_context(&context);
+  return ret;
+}
+
+static void print_cost_line(const char *name, int index,
+                            const function_cost_t *cost) {
+  uint64_t bytes = cost->read_bytes + cost->written_bytes;
+  printf("%-24s %5d %14llu %14llu %12llu %12llu %8.2f\n", name, index,
+         (unsigned long long)cost->macs, (unsigned long long)cost->flops,
+         (unsigned long long)cost->read_bytes,
+         (unsigned long long)cost->written_bytes,
+         bytes > 0 ? (double)cost->flops / bytes : 0.0);
+}
+
+static void add_cost(function_cost_t *total, const function_cost_t *cost) {
+  total->macs += cost->macs;
+  total->flops += cost->flops;
+  total->read_bytes += cost->read_bytes;
+  total->written_bytes += cost->written_bytes;
+}
+
+// Each function, sum of functions of each type in order of their first
+// function, and sum of network.
+static int dump_cost(nn_network_t *net) {
+  int *list = (int *)NN_GET(net, net->functions.list);
+  function_cost_t *types;
+  function_cost_t total;
+  nn_function_type_t *type_ids;
+  int *counts;
+  int num_of_types = 0;
+  int i, j; // Iterator
+
+  types = malloc(sizeof(function_cost_t) * (net->functions.size + 1));
+  type_ids = malloc(sizeof(nn_function_type_t) * (net->functions.size + 1));
+  counts = malloc(sizeof(int) * (net->functions.size + 1));
+  if (types == 0 || type_ids == 0 || counts == 0) {
+    free(types);
+    free(type_ids);
+    free(counts);
+    return -1;
+  }
+  memset(&total, 0, sizeof(total));
+  printf("%-24s %5s %14s %14s %12s %12s %8s\n", "Function", "Index", "MACs",
+         "FLOPs", "Read(B)", "Written(B)", "FLOP/B");
+  for (i = 0; i < net->functions.size; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(net, list[i]));
+    function_cost_t cost;
+    function_cost(net, func, &cost);
+    print_cost_line(function_type_name(func->type), i, &cost);
+    for (j = 0; j < num_of_types && type_ids[j] != func->type; j++) {
+    }
+    if (j == num_of_types) {
+      memset(types + j, 0, sizeof(function_cost_t));
+      type_ids[j] = func->type;
+      counts[j] = 0;
+      num_of_types++;
+    }
+    add_cost(types + j, &cost);
+    add_cost(&total, &cost);
+    counts[j]++;
+  }
+  printf("%-24s %5s %14s %14s %12s %12s %8s\n", "Type", "Count", "MACs",
+         "FLOPs", "Read(B)", "Written(B)", "FLOP/B");
+  for (j = 0; j < num_of_types; j++) {
+    print_cost_line(function_type_name(type_ids[j]), counts[j], types + j);
+  }
+  print_cost_line("Total", net->functions.size, &total);
+  free(types);
+  free(type_ids);
+  free(counts);
+  return 0;
+}
+
 int dump(nn_network_t *net, int argc, char *argv[]) {
   unsigned int i, j;
 
+  if (argc > 0) {
+    int memory = 0;
+    int cost = 0;
+    int planning = 0;
+    int fusion = 0;
+    for (; argc > 0 && argv[0][0] == '-'; argc--, argv++) {
+      if (strcmp(argv[0], "--memory") == 0) {
+        memory = 1;
+      } else if (strcmp(argv[0], "--cost") == 0) {
+        cost = 1;
+      } else if (strcmp(argv[0], "-p") == 0) {
+        planning = 1;
+      } else if (strcmp(argv[0], "-f") == 0) {
+        fusion = 1;
+      } else {
+        break;
+      }
+    }
+    if (memory == cost || argc > 0 || (cost && (planning || fusion))) {
+      usage();
+      return -1;
+    }
+    if (cost) {
+      return dump_cost(net);
+    }
+    return dump_memory(net, planning, fusion);
+  }
+
   printf("NNB: Version: [%d]\n", net->version);
   printf("NNB: Has %d buffers.\n", net->buffers.size);
   int *list = (int *)NN_GET(net, net->buffers.list);
@@ -50,6 +201,31 @@ int dump(nn_network_t *net, int argc, char *argv[]) {
              (-1 * var->data_index) - 1);
     } else {
       printf("NNB: Variable data_index: %d\n", var->data_index);
+      if (var->layout == NN_DATA_LAYOUT_COMPRESSED) {
+        nn_compressed_t *z = (nn_compressed_t *)(NN_GET(net, var->data_index));
+        printf("NNB: Variable compression: method:%d size:%d\n", z->method,
+               z->size);
+      }
+    }
+    if (net->version >= 4 && var->quantization >= 0) {
+      nn_quantization_t *q =
+          (nn_quantization_t *)(NN_GET(net, var->quantization));
+      float *scale = (float *)(q + 1);
+      printf("NNB: Variable quantization: axis:%d channels:%d scale:(",
+             q->axis, q->channels);
+      for (j = 0; j < q->channels; j++) {
+        printf(" %g", scale[j]);
+      }
+      printf(" )");
+      if (q->has_zero_point) {
+        int32_t *zero_point = (int32_t *)(scale + q->channels);
+        printf(" zero_point:(");
+        for (j = 0; j < q->channels; j++) {
+          printf(" %d", zero_point[j]);
+        }
+        printf(" )");
+      }
+      printf("\n");
     }
   }
 
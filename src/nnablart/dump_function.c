@@ -1671,3 +1671,362 @@ void dump_function(nn_network_t *net, nn_function_t *func) {
   default:;
   }
 }
+
+const char *function_type_name(nn_function_type_t type) {
+  switch (type) {
+  case NN_FUNCTION_AFFINE:
+    return "Affine";
+  case NN_FUNCTION_RNN:
+    return "RNN";
+  case NN_FUNCTION_LSTM:
+    return "LSTM";
+  case NN_FUNCTION_GRU:
+    return "GRU";
+  case NN_FUNCTION_CONVOLUTION:
+    return "Convolution";
+  case NN_FUNCTION_DEPTHWISE_CONVOLUTION:
+    return "DepthwiseConvolution";
+  case NN_FUNCTION_DECONVOLUTION:
+    return "Deconvolution";
+  case NN_FUNCTION_DEPTHWISE_DECONVOLUTION:
+    return "DepthwiseDeconvolution";
+  case NN_FUNCTION_MAX_POOLING:
+    return "MaxPooling";
+  case NN_FUNCTION_AVERAGE_POOLING:
+    return "AveragePooling";
+  case NN_FUNCTION_GLOBAL_AVERAGE_POOLING:
+    return "GlobalAveragePooling";
+  case NN_FUNCTION_SUM_POOLING:
+    return "SumPooling";
+  case NN_FUNCTION_UNPOOLING:
+    return "Unpooling";
+  case NN_FUNCTION_EMBED:
+    return "Embed";
+  case NN_FUNCTION_SIGMOID:
+    return "Sigmoid";
+  case NN_FUNCTION_SWISH:
+    return "Swish";
+  case NN_FUNCTION_TANH:
+    return "Tanh";
+  case NN_FUNCTION_RELU:
+    return "ReLU";
+  case NN_FUNCTION_LEAKY_RELU:
+    return "LeakyReLU";
+  case NN_FUNCTION_SOFTMAX:
+    return "Softmax";
+  case NN_FUNCTION_LOG_SOFTMAX:
+    return "LogSoftmax";
+  case NN_FUNCTION_ELU:
+    return "ELU";
+  case NN_FUNCTION_SELU:
+    return "SELU";
+  case NN_FUNCTION_CRELU:
+    return "CReLU";
+  case NN_FUNCTION_CELU:
+    return "CELU";
+  case NN_FUNCTION_PRELU:
+    return "PReLU";
+  case NN_FUNCTION_GELU:
+    return "GELU";
+  case NN_FUNCTION_RELU6:
+    return "ReLU6";
+  case NN_FUNCTION_HARD_SIGMOID:
+    return "HardSigmoid";
+  case NN_FUNCTION_HARD_TANH:
+    return "HardTanh";
+  case NN_FUNCTION_LOG_SIGMOID:
+    return "LogSigmoid";
+  case NN_FUNCTION_SOFTPLUS:
+    return "SoftPlus";
+  case NN_FUNCTION_SOFTSIGN:
+    return "SoftSign";
+  case NN_FUNCTION_TANH_SHRINK:
+    return "TanhShrink";
+  case NN_FUNCTION_SINC:
+    return "Sinc";
+  case NN_FUNCTION_FUSED_BATCH_NORMALIZATION:
+    return "FusedBatchNormalization";
+  case NN_FUNCTION_BATCH_NORMALIZATION:
+    return "BatchNormalization";
+  case NN_FUNCTION_SYNC_BATCH_NORMALIZATION:
+    return "SyncBatchNormalization";
+  case NN_FUNCTION_MEAN_SUBTRACTION:
+    return "MeanSubtraction";
+  case NN_FUNCTION_CLIP_GRAD_BY_VALUE:
+    return "ClipGradByValue";
+  case NN_FUNCTION_CLIP_GRAD_BY_NORM:
+    return "ClipGradByNorm";
+  case NN_FUNCTION_SUM:
+    return "Sum";
+  case NN_FUNCTION_MEAN:
+    return "Mean";
+  case NN_FUNCTION_MAX:
+    return "Max";
+  case NN_FUNCTION_MIN:
+    return "Min";
+  case NN_FUNCTION_PROD:
+    return "Prod";
+  case NN_FUNCTION_REDUCE_SUM:
+    return "ReduceSum";
+  case NN_FUNCTION_REDUCE_MEAN:
+    return "ReduceMean";
+  case NN_FUNCTION_ADD2:
+    return "Add2";
+  case NN_FUNCTION_BC_ADD2:
+    return "BcAdd2";
+  case NN_FUNCTION_SUB2:
+    return "Sub2";
+  case NN_FUNCTION_MUL2:
+    return "Mul2";
+  case NN_FUNCTION_DIV2:
+    return "Div2";
+  case NN_FUNCTION_POW2:
+    return "Pow2";
+  case NN_FUNCTION_ADD_SCALAR:
+    return "AddScalar";
+  case NN_FUNCTION_MUL_SCALAR:
+    return "MulScalar";
+  case NN_FUNCTION_POW_SCALAR:
+    return "PowScalar";
+  case NN_FUNCTION_R_SUB_SCALAR:
+    return "RSubScalar";
+  case NN_FUNCTION_R_DIV_SCALAR:
+    return "RDivScalar";
+  case NN_FUNCTION_R_POW_SCALAR:
+    return "RPowScalar";
+  case NN_FUNCTION_SIGN:
+    return "Sign";
+  case NN_FUNCTION_MINIMUM2:
+    return "Minimum2";
+  case NN_FUNCTION_MAXIMUM2:
+    return "Maximum2";
+  case NN_FUNCTION_MINIMUM_SCALAR:
+    return "MinimumScalar";
+  case NN_FUNCTION_MAXIMUM_SCALAR:
+    return "MaximumScalar";
+  case NN_FUNCTION_LOGICAL_AND:
+    return "LogicalAnd";
+  case NN_FUNCTION_LOGICAL_OR:
+    return "LogicalOr";
+  case NN_FUNCTION_LOGICAL_XOR:
+    return "LogicalXor";
+  case NN_FUNCTION_EQUAL:
+    return "Equal";
+  case NN_FUNCTION_NOT_EQUAL:
+    return "NotEqual";
+  case NN_FUNCTION_GREATER_EQUAL:
+    return "GreaterEqual";
+  case NN_FUNCTION_GREATER:
+    return "Greater";
+  case NN_FUNCTION_LESS_EQUAL:
+    return "LessEqual";
+  case NN_FUNCTION_LESS:
+    return "Less";
+  case NN_FUNCTION_LOGICAL_AND_SCALAR:
+    return "LogicalAndScalar";
+  case NN_FUNCTION_LOGICAL_OR_SCALAR:
+    return "LogicalOrScalar";
+  case NN_FUNCTION_LOGICAL_XOR_SCALAR:
+    return "LogicalXorScalar";
+  case NN_FUNCTION_EQUAL_SCALAR:
+    return "EqualScalar";
+  case NN_FUNCTION_NOT_EQUAL_SCALAR:
+    return "NotEqualScalar";
+  case NN_FUNCTION_GREATER_EQUAL_SCALAR:
+    return "GreaterEqualScalar";
+  case NN_FUNCTION_GREATER_SCALAR:
+    return "GreaterScalar";
+  case NN_FUNCTION_LESS_EQUAL_SCALAR:
+    return "LessEqualScalar";
+  case NN_FUNCTION_LESS_SCALAR:
+    return "LessScalar";
+  case NN_FUNCTION_LOGICAL_NOT:
+    return "LogicalNot";
+  case NN_FUNCTION_ISNAN:
+    return "IsNaN";
+  case NN_FUNCTION_ISINF:
+    return "IsInf";
+  case NN_FUNCTION_RESET_NAN:
+    return "ResetNaN";
+  case NN_FUNCTION_RESET_INF:
+    return "ResetInf";
+  case NN_FUNCTION_WHERE:
+    return "Where";
+  case NN_FUNCTION_CONSTANT:
+    return "Constant";
+  case NN_FUNCTION_ARANGE:
+    return "Arange";
+  case NN_FUNCTION_ABS:
+    return "Abs";
+  case NN_FUNCTION_EXP:
+    return "Exp";
+  case NN_FUNCTION_LOG:
+    return "Log";
+  case NN_FUNCTION_IDENTITY:
+    return "Identity";
+  case NN_FUNCTION_BATCH_MATMUL:
+    return "BatchMatmul";
+  case NN_FUNCTION_ROUND:
+    return "Round";
+  case NN_FUNCTION_CEIL:
+    return "Ceil";
+  case NN_FUNCTION_FLOOR:
+    return "Floor";
+  case NN_FUNCTION_SIN:
+    return "Sin";
+  case NN_FUNCTION_COS:
+    return "Cos";
+  case NN_FUNCTION_TAN:
+    return "Tan";
+  case NN_FUNCTION_SINH:
+    return "Sinh";
+  case NN_FUNCTION_COSH:
+    return "Cosh";
+  case NN_FUNCTION_ASIN:
+    return "ASin";
+  case NN_FUNCTION_ACOS:
+    return "ACos";
+  case NN_FUNCTION_ATAN:
+    return "ATan";
+  case NN_FUNCTION_ATAN2:
+    return "ATan2";
+  case NN_FUNCTION_ASINH:
+    return "ASinh";
+  case NN_FUNCTION_ACOSH:
+    return "ACosh";
+  case NN_FUNCTION_ATANH:
+    return "ATanh";
+  case NN_FUNCTION_CONCATENATE:
+    return "Concatenate";
+  case NN_FUNCTION_SPLIT:
+    return "Split";
+  case NN_FUNCTION_STACK:
+    return "Stack";
+  case NN_FUNCTION_SLICE:
+    return "Slice";
+  case NN_FUNCTION_PAD:
+    return "Pad";
+  case NN_FUNCTION_TRANSPOSE:
+    return "Transpose";
+  case NN_FUNCTION_BROADCAST:
+    return "Broadcast";
+  case NN_FUNCTION_BROADCAST_TO:
+    return "BroadcastTo";
+  case NN_FUNCTION_TILE:
+    return "Tile";
+  case NN_FUNCTION_ONE_HOT:
+    return "OneHot";
+  case NN_FUNCTION_FLIP:
+    return "Flip";
+  case NN_FUNCTION_SHIFT:
+    return "Shift";
+  case NN_FUNCTION_SORT:
+    return "Sort";
+  case NN_FUNCTION_RESHAPE:
+    return "Reshape";
+  case NN_FUNCTION_MATRIX_DIAG:
+    return "MatrixDiag";
+  case NN_FUNCTION_MATRIX_DIAG_PART:
+    return "MatrixDiagPart";
+  case NN_FUNCTION_BATCH_INV:
+    return "BatchInv";
+  case NN_FUNCTION_BATCH_DET:
+    return "BatchDet";
+  case NN_FUNCTION_ASSIGN:
+    return "Assign";
+  case NN_FUNCTION_GATHER_ND:
+    return "GatherNd";
+  case NN_FUNCTION_SCATTER_ND:
+    return "ScatterNd";
+  case NN_FUNCTION_INTERPOLATE:
+    return "Interpolate";
+  case NN_FUNCTION_FFT:
+    return "FFT";
+  case NN_FUNCTION_IFFT:
+    return "IFFT";
+  case NN_FUNCTION_DROPOUT:
+    return "Dropout";
+  case NN_FUNCTION_TOP_K_DATA:
+    return "TopKData";
+  case NN_FUNCTION_TOP_K_GRAD:
+    return "TopKGrad";
+  case NN_FUNCTION_RAND:
+    return "Rand";
+  case NN_FUNCTION_RANDINT:
+    return "Randint";
+  case NN_FUNCTION_RANDN:
+    return "Randn";
+  case NN_FUNCTION_RANDOM_CHOICE:
+    return "RandomChoice";
+  case NN_FUNCTION_RANDOM_CROP:
+    return "RandomCrop";
+  case NN_FUNCTION_RANDOM_FLIP:
+    return "RandomFlip";
+  case NN_FUNCTION_RANDOM_SHIFT:
+    return "RandomShift";
+  case NN_FUNCTION_IMAGE_AUGMENTATION:
+    return "ImageAugmentation";
+  case NN_FUNCTION_SIGMOID_CROSS_ENTROPY:
+    return "SigmoidCrossEntropy";
+  case NN_FUNCTION_BINARY_CROSS_ENTROPY:
+    return "BinaryCrossEntropy";
+  case NN_FUNCTION_SOFTMAX_CROSS_ENTROPY:
+    return "SoftmaxCrossEntropy";
+  case NN_FUNCTION_CATEGORICAL_CROSS_ENTROPY:
+    return "CategoricalCrossEntropy";
+  case NN_FUNCTION_SQUARED_ERROR:
+    return "SquaredError";
+  case NN_FUNCTION_ABSOLUTE_ERROR:
+    return "AbsoluteError";
+  case NN_FUNCTION_HUBER_LOSS:
+    return "HuberLoss";
+  case NN_FUNCTION_EPSILON_INSENSITIVE_LOSS:
+    return "EpsilonInsensitiveLoss";
+  case NN_FUNCTION_KL_MULTINOMIAL:
+    return "KLMultinomial";
+  case NN_FUNCTION_BINARY_SIGMOID:
+    return "BinarySigmoid";
+  case NN_FUNCTION_BINARY_TANH:
+    return "BinaryTanh";
+  case NN_FUNCTION_BINARY_CONNECT_AFFINE:
+    return "BinaryConnectAffine";
+  case NN_FUNCTION_BINARY_CONNECT_CONVOLUTION:
+    return "BinaryConnectConvolution";
+  case NN_FUNCTION_BINARY_WEIGHT_AFFINE:
+    return "BinaryWeightAffine";
+  case NN_FUNCTION_BINARY_WEIGHT_CONVOLUTION:
+    return "BinaryWeightConvolution";
+  case NN_FUNCTION_INQ_AFFINE:
+    return "INQAffine";
+  case NN_FUNCTION_INQ_CONVOLUTION:
+    return "INQConvolution";
+  case NN_FUNCTION_FIXED_POINT_QUANTIZE:
+    return "FixedPointQuantize";
+  case NN_FUNCTION_MIN_MAX_QUANTIZE:
+    return "MinMaxQuantize";
+  case NN_FUNCTION_POW2_QUANTIZE:
+    return "Pow2Quantize";
+  case NN_FUNCTION_PRUNE:
+    return "Prune";
+  case NN_FUNCTION_TOP_N_ERROR:
+    return "TopNError";
+  case NN_FUNCTION_BINARY_ERROR:
+    return "BinaryError";
+  case NN_FUNCTION_CONFUSION_MATRIX:
+    return "ConfusionMatrix";
+  case NN_FUNCTION_VAT_NOISE:
+    return "VATNoise";
+  case NN_FUNCTION_UNLINK:
+    return "Unlink";
+  case NN_FUNCTION_SINK:
+    return "Sink";
+  case NN_FUNCTION_NMS_DETECTION2D:
+    return "NmsDetection2d";
+  case NN_FUNCTION_MAX_POOLING_BACKWARD:
+    return "MaxPoolingBackward";
+  case NN_FUNCTION_WARP_BY_FLOW:
+    return "WarpByFlow";
+  default:
+    return "Unknown";
+  }
+}
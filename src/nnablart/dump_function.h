@@ -18,5 +18,6 @@
 #define H_TEMPLATE_SRC_NNABLART_DUMP_FUNCTION_H_171220144441_
 
 void dump_function(nn_network_t *net, nn_function_t *func);
+const char *function_type_name(nn_function_type_t type);
 
 #endif // H_TEMPLATE_SRC_NNABLART_DUMP_FUNCTION_H_171220144441_
@@ -35,6 +35,7 @@ int infer(nn_network_t *net, int argc, char *argv[]) {
   rt_return_value_t ret;
   const char *data_type[] = {"NN_DATA_TYPE_FLOAT", "NN_DATA_TYPE_INT16",
                              "NN_DATA_TYPE_INT8", "NN_DATA_TYPE_SIGN",
+                             "NN_DATA_TYPE_FLOAT16", "NN_DATA_TYPE_BFLOAT16",
                              "END_OF_NN_DATA_TYPE"};
 
   for (i = 0; i < argc; i++) {
@@ -107,6 +108,8 @@ int infer(nn_network_t *net, int argc, char *argv[]) {
                              input_data_size, input);
       break;
     case NN_DATA_TYPE_INT16:
+    case NN_DATA_TYPE_FLOAT16:
+    case NN_DATA_TYPE_BFLOAT16:
       if (check_data_size(input_data_size,
                           rt_input_size(context, i) * sizeof(uint16_t)) < 0)
         return -1;
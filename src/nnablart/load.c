@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(_MSC_VER) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // For mmap() with -std=c99
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "load.h"
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NNABLART_USE_MMAP
+#endif
+
+static int map_nnb(const char *filename, nnb_file_t *file) {
+#if defined(_MSC_VER)
+  HANDLE handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+    CloseHandle(handle);
+    return -1;
+  }
+  HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(handle);
+  if (mapping == NULL) {
+    return -1;
+  }
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL) {
+    CloseHandle(mapping);
+    return -1;
+  }
+  file->data = data;
+  file->size = (size_t)size.QuadPart;
+  file->mapping = mapping;
+  file->mapped = 1;
+  return 0;
+#elif defined(NNABLART_USE_MMAP)
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return -1;
+  }
+  void *data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return -1;
+  }
+  file->data = data;
+  file->size = st.st_size;
+  file->mapped = 1;
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+static int read_nnb(const char *filename, nnb_file_t *file) {
+  FILE *nnb = 0;
+#ifdef _MSC_VER
+  fopen_s(&nnb, filename, "rb");
+#else
+  nnb = fopen(filename, "rb");
+#endif
+  if (nnb == 0) {
+    return -1;
+  }
+  fseek(nnb, 0L, SEEK_END);
+  size_t nnb_data_size = ftell(nnb);
+  fseek(nnb, 0L, SEEK_SET);
+  uint8_t *nnb_data = malloc(nnb_data_size);
+  if (nnb_data == 0) {
+    fclose(nnb);
+    return -1;
+  }
+  size_t read_size = fread(nnb_data, sizeof(uint8_t), nnb_data_size, nnb);
+  fclose(nnb);
+  if (read_size != nnb_data_size) {
+    free(nnb_data);
+    return -1;
+  }
+  file->data = nnb_data;
+  file->size = nnb_data_size;
+  file->mapped = 0;
+  return 0;
+}
+
+int load_nnb(const char *filename, nnb_file_t *file) {
+  if (map_nnb(filename, file) == 0) {
+    return 0;
+  }
+  return read_nnb(filename, file);
+}
+
+void unload_nnb(nnb_file_t *file) {
+  if (!file->mapped) {
+    free(file->data);
+  } else {
+#if defined(_MSC_VER)
+    UnmapViewOfFile(file->data);
+    CloseHandle(file->mapping);
+#elif defined(NNABLART_USE_MMAP)
+    munmap(file->data, file->size);
+#endif
+  }
+  file->data = 0;
+  file->size = 0;
+}
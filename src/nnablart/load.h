@@ -0,0 +1,34 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_LOAD_H_171220180159_
+#define H_LOAD_H_171220180159_
+
+#include <stddef.h>
+
+typedef struct {
+  void *data;
+  size_t size;
+  int mapped; ///< Data is read only mapping of the file.
+#ifdef _MSC_VER
+  void *mapping;
+#endif
+} nnb_file_t;
+
+/// Map NNB file read only, or read it to memory if mapping is not available.
+int load_nnb(const char *filename, nnb_file_t *file);
+
+void unload_nnb(nnb_file_t *file);
+
+#endif // H_LOAD_H_171220180159_
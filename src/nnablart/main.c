@@ -19,8 +19,13 @@
 #include <nnablart/network.h>
 #include <nnablart/runtime.h>
 
+#include "batch.h"
+#include "bench.h"
+#include "calibrate.h"
 #include "dump.h"
 #include "infer.h"
+#include "load.h"
+#include "precision.h"
 
 int main(int argc, char *argv[]) {
   int ret = -1;
@@ -38,40 +43,39 @@ int main(int argc, char *argv[]) {
       argv += 3;
       argc -= 3;
 
-      FILE *nnb = 0;
-#ifdef _MSC_VER
-      fopen_s(&nnb, nnb_filename, "rb");
-#else
-      nnb = fopen(nnb_filename, "rb");
-#endif
-      assert(nnb);
-      fseek(nnb, 0L, SEEK_END);
-      size_t nnb_data_size = ftell(nnb);
-      fseek(nnb, 0L, SEEK_SET);
-      uint8_t *nnb_data = malloc(nnb_data_size);
-      assert(nnb_data);
-      int read_size = (int)fread(nnb_data, sizeof(uint8_t), nnb_data_size, nnb);
-      assert(read_size == nnb_data_size);
-      fclose(nnb);
+      nnb_file_t nnb;
+      if (load_nnb(nnb_filename, &nnb) != 0) {
+        printf("Cannot open NNB file: %s.\n", nnb_filename);
+        return -1;
+      }
 
-      nn_network_t *net = (nn_network_t *)nnb_data;
+      nn_network_t *net = (nn_network_t *)nnb.data;
 
       if (strncmp("dump", subcmd, 4) == 0) {
         ret = dump(net, argc, argv);
       } else if (strncmp("infer", subcmd, 5) == 0) {
         ret = infer(net, argc, argv);
+      } else if (strncmp("calibrate", subcmd, 9) == 0) {
+        ret = calibrate(net, argc, argv);
+      } else if (strncmp("bench", subcmd, 5) == 0) {
+        ret = bench(net, argc, argv);
+      } else if (strncmp("batch", subcmd, 5) == 0) {
+        ret = batch(net, argc, argv);
+      } else if (strncmp("precision", subcmd, 9) == 0) {
+        ret = precision(net, argc, argv);
       } else {
         printf("Unknown subcommand [%s]\n", subcmd);
       }
 
-      free(nnb_data);
+      unload_nnb(&nnb);
     } else {
       printf("Unknown subcommand [%s]\n", subcmd);
     }
 
   } else {
     printf("No subcommand.\n");
-    printf("Please specify sub command `dump`, `infer` or `version`.\n");
+    printf("Please specify sub command `dump`, `infer`, `calibrate`, `bench`, "
+           "`batch`, `precision` or `version`.\n");
   }
   return ret;
 }
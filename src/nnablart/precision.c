@@ -0,0 +1,484 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../runtime/runtime_internal.h"
+#include "calibrate.h"
+#include "dump_function.h"
+#include "precision.h"
+
+/*
+ * Chooses FIXED8 or FLOAT32 for each function of a float network. Ranges of
+ * variables are calibrated over samples like `calibrate`, and outputs of
+ * float network are kept as reference. Then each function is measured with
+ * its outputs and float parameters converted to INT8 in a copy of network,
+ * alone: error is RMS of difference of network outputs from reference,
+ * relative to RMS of reference, and gain is time of forward saved against
+ * float network, which includes conversion by functions around it.
+ * Functions which gain are tried in order of gain per error, and each is
+ * kept if error of network with all kept functions in INT8 is within
+ * budget, so errors need not add up. Network inputs and outputs stay float.
+ */
+
+typedef struct {
+  nn_network_t *net;
+  nn_network_t *copy; ///< Network with chosen variables in INT8.
+  calibration_t cal;
+  int num_of_inputs;
+  int num_of_samples;
+  int iterations;
+  uint8_t *inputs;     ///< Raw inputs of all samples.
+  size_t input_bytes;  ///< Bytes of inputs of a sample.
+  float *reference;    ///< Float outputs of all samples.
+  int output_size;     ///< Values of outputs of a sample.
+  int *is_io;          ///< Variable is network input or output.
+  int *int8_variables; ///< Variable is INT8 in copy.
+} planner_t;
+
+typedef struct {
+  double error; ///< RMS of output error relative to RMS of reference.
+  double nsec;  ///< Time of forward of a sample.
+} measure_t;
+
+// Float buffer of function, which is not network input or output.
+static int is_convertible_output(planner_t *p, int index) {
+  nn_variable_t *v = get_variable(p->net, index);
+  return v->type == NN_DATA_TYPE_FLOAT && v->data_index < 0 &&
+         !p->is_io[index] && p->cal.observed[index];
+}
+
+// Dense float parameter, which can be written as INT8 in place.
+static int is_convertible_parameter(planner_t *p, int index) {
+  nn_variable_t *v = get_variable(p->net, index);
+  return v->type == NN_DATA_TYPE_FLOAT && v->data_index >= 0 &&
+         v->layout == NN_DATA_LAYOUT_DENSE && v->quantization < 0;
+}
+
+static void convert_variable(planner_t *p, int index) {
+  nn_variable_t *src = get_variable(p->net, index);
+  nn_variable_t *v = get_variable(p->copy, index);
+  int fp_pos = recommend_fp_pos(p->cal.min[index], p->cal.max[index], 8);
+  int i; // Iterator
+
+  if (p->int8_variables[index]) {
+    return;
+  }
+  p->int8_variables[index] = 1;
+  v->type = NN_DATA_TYPE_INT8;
+  v->fp_pos = fp_pos;
+  if (v->data_index >= 0) {
+    const float *x = (const float *)NN_GET(p->net, src->data_index);
+    int8_t *y = (int8_t *)NN_GET(p->copy, v->data_index);
+    const float scale = (float)(1 << fp_pos);
+    for (i = 0; i < variable_size(p->net, src); i++) {
+      float q = roundf(x[i] * scale);
+      y[i] = (int8_t)(q > 127.0f ? 127.0f : q < -128.0f ? -128.0f : q);
+    }
+  }
+}
+
+// Copy network, with variables of functions marked in int8 set to INT8.
+static void convert_network(planner_t *p, const int *int8) {
+  int *list = (int *)NN_GET(p->net, p->net->functions.list);
+  int i, j; // Iterator
+
+  memcpy(p->copy, p->net, NN_NETWORK_SIZE(p->net));
+  memset(p->int8_variables, 0, sizeof(int) * p->net->variables.size);
+  for (i = 0; i < p->net->functions.size; i++) {
+    nn_function_t *f = (nn_function_t *)NN_GET(p->net, list[i]);
+    const int *inputs = (const int *)NN_GET(p->net, f->inputs.list);
+    const int *outputs = (const int *)NN_GET(p->net, f->outputs.list);
+    if (!int8[i]) {
+      continue;
+    }
+    for (j = 0; j < f->outputs.size; j++) {
+      if (is_convertible_output(p, outputs[j])) {
+        convert_variable(p, outputs[j]);
+      }
+    }
+    for (j = 0; j < f->inputs.size; j++) {
+      if (is_convertible_parameter(p, inputs[j])) {
+        convert_variable(p, inputs[j]);
+      }
+    }
+  }
+}
+
+static int has_convertible_output(planner_t *p, int function) {
+  int *list = (int *)NN_GET(p->net, p->net->functions.list);
+  nn_function_t *f = (nn_function_t *)NN_GET(p->net, list[function]);
+  const int *outputs = (const int *)NN_GET(p->net, f->outputs.list);
+  int j; // Iterator
+  for (j = 0; j < f->outputs.size; j++) {
+    if (is_convertible_output(p, outputs[j])) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Copy inputs of sample into context.
+static void set_inputs(planner_t *p, rt_context_pointer context,
+                       int sample) {
+  const uint8_t *data = p->inputs + p->input_bytes * sample;
+  int i; // Iterator
+  for (i = 0; i < p->num_of_inputs; i++) {
+    size_t size = rt_input_size(context, i) * sizeof(float);
+    memcpy(rt_input_buffer(context, i), data, size);
+    data += size;
+  }
+}
+
+// Run network over samples. Outputs are compared with reference, or stored
+// as reference if compare is zero. Time is the shortest of iterations.
+static int measure(planner_t *p, nn_network_t *net, int compare,
+                   measure_t *result) {
+  rt_context_pointer context = 0;
+  double error = 0.0, norm = 0.0;
+  uint64_t best = 0;
+  int ret = -1;
+  int i, j, k, l; // Iterator
+
+  if (rt_allocate_context(&context) != RT_RET_NOERROR) {
+    return -1;
+  }
+  if (rt_initialize_context(context, net) != RT_RET_NOERROR) {
+    goto end;
+  }
+  for (i = 0; i < p->iterations; i++) {
+    uint64_t total = 0;
+    for (j = 0; j < p->num_of_samples; j++) {
+      float *reference = p->reference + (size_t)p->output_size * j;
+      uint64_t start;
+      set_inputs(p, context, j);
+      start = profile_now();
+      if (rt_forward(context) != RT_RET_NOERROR) {
+        goto end;
+      }
+      total += profile_now() - start;
+      if (i > 0) {
+        continue;
+      }
+      for (k = 0; k < rt_num_of_output(context); k++) {
+        const float *y = (const float *)rt_output_buffer(context, k);
+        for (l = 0; l < rt_output_size(context, k); l++, reference++) {
+          if (compare) {
+            error += (y[l] - *reference) * (y[l] - *reference);
+            norm += *reference * *reference;
+          } else {
+            *reference = y[l];
+          }
+        }
+      }
+    }
+    best = i == 0 || total < best ? total : best;
+  }
+  result->error = norm > 0.0 ? sqrt(error / norm) : sqrt(error);
+  result->nsec = (double)best / p->num_of_samples;
+  ret = 0;
+
+end:
+  rt_free_context(&context);
+  return ret;
+}
+
+static int load_samples(planner_t *p, char *dirs[]) {
+  rt_context_pointer context = p->cal.context;
+  name_list_t *samples = calloc(p->num_of_inputs, sizeof(name_list_t));
+  int ret = -1;
+  int i, j; // Iterator
+
+  if (samples == 0) {
+    return -1;
+  }
+  p->num_of_samples = -1;
+  p->input_bytes = 0;
+  for (i = 0; i < p->num_of_inputs; i++) {
+    if (rt_input_variable(context, i)->type != NN_DATA_TYPE_FLOAT) {
+      printf("Input[%d] is not float.\n", i);
+      goto end;
+    }
+    if (list_files(dirs[i], samples + i) != 0) {
+      printf("Cannot open input directory: %s.\n", dirs[i]);
+      goto end;
+    }
+    if (p->num_of_samples < 0 ||
+        samples[i].num_of_names < p->num_of_samples) {
+      p->num_of_samples = samples[i].num_of_names;
+    }
+    p->input_bytes += rt_input_size(context, i) * sizeof(float);
+  }
+  if (p->num_of_samples <= 0) {
+    printf("No samples.\n");
+    goto end;
+  }
+  p->inputs = malloc(p->input_bytes * p->num_of_samples);
+  if (p->inputs == 0) {
+    goto end;
+  }
+  for (j = 0; j < p->num_of_samples; j++) {
+    uint8_t *data = p->inputs + p->input_bytes * j;
+    for (i = 0; i < p->num_of_inputs; i++) {
+      size_t size = rt_input_size(context, i) * sizeof(float);
+      if (read_sample(samples[i].names[j], data, size) != 0) {
+        goto end;
+      }
+      data += size;
+    }
+  }
+  ret = observe_samples(&p->cal, samples, p->num_of_samples);
+
+end:
+  for (i = 0; i < p->num_of_inputs; i++) {
+    free_names(samples + i);
+  }
+  free(samples);
+  return ret;
+}
+
+static void write_settings(FILE *fp, planner_t *p, const name_list_t *names) {
+  int i; // Iterator
+  fprintf(fp, "variables:\n");
+  for (i = 0; i < p->net->variables.size; i++) {
+    nn_variable_t *v = get_variable(p->copy, i);
+    write_variable_name(fp, names, i);
+    switch (v->type) {
+    case NN_DATA_TYPE_FLOAT:
+      fprintf(fp, "FLOAT32\n");
+      break;
+    case NN_DATA_TYPE_INT16:
+      fprintf(fp, "FIXED16_%d\n", v->fp_pos);
+      break;
+    case NN_DATA_TYPE_INT8:
+      fprintf(fp, "FIXED8_%d\n", v->fp_pos);
+      break;
+    default:
+      fprintf(fp, "# type %d is kept\n", v->type);
+      break;
+    }
+  }
+}
+
+static void usage(void) {
+  printf("Usage: nnablart precision NNB [-e ERROR] [-n ITERATIONS] "
+         "[-t SETTINGS] OUTPUT INPUT_DIR...\n");
+  printf("  -e ERROR       Budget of RMS error of outputs relative to float "
+         "(default 0.01).\n");
+  printf("  -n ITERATIONS  Runs over samples to time, shortest is taken "
+         "(default 3).\n");
+  printf("  -t SETTINGS    Settings written by nnabla_cli convert to take "
+         "variable names from.\n");
+  printf("  INPUT_DIR      Directory of raw float samples per network "
+         "input.\n");
+}
+
+int precision(nn_network_t *net, int argc, char *argv[]) {
+  double budget = 0.01;
+  const char *template_name = 0;
+  const char *output_name;
+  name_list_t names = {0, 0};
+  planner_t p;
+  measure_t base, kept, trial;
+  measure_t *layers = 0;
+  int *order = 0;
+  int *int8 = 0;
+  int num_of_functions = net->functions.size;
+  int num_of_candidates = 0;
+  int ret = -1;
+  int i, j; // Iterator
+  FILE *fp;
+
+  memset(&p, 0, sizeof(p));
+  p.iterations = 3;
+  for (; argc > 0 && argv[0][0] == '-'; argc--, argv++) {
+    if (strcmp(argv[0], "-e") == 0 && argc > 1) {
+      budget = atof(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-n") == 0 && argc > 1) {
+      p.iterations = atoi(*++argv);
+      argc--;
+    } else if (strcmp(argv[0], "-t") == 0 && argc > 1) {
+      template_name = *++argv;
+      argc--;
+    } else {
+      break;
+    }
+  }
+  if (budget < 0.0 || p.iterations < 1 || argc < 2) {
+    usage();
+    return -1;
+  }
+  output_name = argv[0];
+  argv++;
+  argc--;
+
+  p.net = net;
+  p.cal.net = net;
+  if (rt_allocate_context(&p.cal.context) != RT_RET_NOERROR) {
+    return -1;
+  }
+  if (rt_initialize_context(p.cal.context, net) != RT_RET_NOERROR) {
+    printf("rt_initialize_context() failed.\n");
+    goto end;
+  }
+  p.num_of_inputs = rt_num_of_input(p.cal.context);
+  if (argc != p.num_of_inputs) {
+    printf("Required input directories: %d, actual: %d\n", p.num_of_inputs,
+           argc);
+    goto end;
+  }
+  if (template_name && read_variable_names(template_name, &names) != 0) {
+    printf("Cannot read settings file: %s.\n", template_name);
+    goto end;
+  }
+  if (names.num_of_names && names.num_of_names != net->variables.size) {
+    printf("Settings have %d variables, but network has %d.\n",
+           names.num_of_names, net->variables.size);
+    goto end;
+  }
+  for (i = 0; i < rt_num_of_output(p.cal.context); i++) {
+    if (rt_output_variable(p.cal.context, i)->type != NN_DATA_TYPE_FLOAT) {
+      printf("Output[%d] is not float.\n", i);
+      goto end;
+    }
+    p.output_size += rt_output_size(p.cal.context, i);
+  }
+
+  p.cal.min = malloc(sizeof(float) * net->variables.size);
+  p.cal.max = malloc(sizeof(float) * net->variables.size);
+  p.cal.observed = calloc(net->variables.size, sizeof(int));
+  p.is_io = calloc(net->variables.size, sizeof(int));
+  p.int8_variables = calloc(net->variables.size, sizeof(int));
+  p.copy = malloc(NN_NETWORK_SIZE(net));
+  layers = calloc(num_of_functions, sizeof(measure_t));
+  order = malloc(sizeof(int) * (num_of_functions + 1));
+  int8 = calloc(num_of_functions + 1, sizeof(int));
+  if (p.cal.min == 0 || p.cal.max == 0 || p.cal.observed == 0 ||
+      p.is_io == 0 || p.int8_variables == 0 || p.copy == 0 || layers == 0 ||
+      order == 0 || int8 == 0) {
+    goto end;
+  }
+  for (i = 0; i < (int)net->inputs.size; i++) {
+    p.is_io[((int *)NN_GET(net, net->inputs.list))[i]] = 1;
+  }
+  for (i = 0; i < (int)net->outputs.size; i++) {
+    p.is_io[((int *)NN_GET(net, net->outputs.list))[i]] = 1;
+  }
+  if (load_samples(&p, argv) != 0) {
+    goto end;
+  }
+  p.reference = malloc(sizeof(float) * p.output_size * p.num_of_samples);
+  if (p.reference == 0 || measure(&p, net, 0, &base) != 0) {
+    goto end;
+  }
+
+  // Each function alone in INT8.
+  printf("%-24s %5s %10s %10s %10s\n", "Function", "Index", "Gain(us)",
+         "Error", "Chosen");
+  for (i = 0; i < num_of_functions; i++) {
+    if (!has_convertible_output(&p, i)) {
+      continue;
+    }
+    int8[i] = 1;
+    convert_network(&p, int8);
+    int8[i] = 0;
+    if (measure(&p, p.copy, 1, layers + i) != 0) {
+      continue; // No kernel of function takes INT8.
+    }
+    if (layers[i].nsec < base.nsec) {
+      order[num_of_candidates++] = i;
+    }
+  }
+
+  // Most gain per error first, sorted by insertion.
+  for (i = 1; i < num_of_candidates; i++) {
+    int f = order[i];
+    double score = (base.nsec - layers[f].nsec) / (layers[f].error + 1e-9);
+    for (j = i; j > 0; j--) {
+      int g = order[j - 1];
+      if ((base.nsec - layers[g].nsec) / (layers[g].error + 1e-9) >= score) {
+        break;
+      }
+      order[j] = g;
+    }
+    order[j] = f;
+  }
+
+  kept = base;
+  kept.error = 0.0;
+  for (i = 0; i < num_of_candidates; i++) {
+    int f = order[i];
+    if (layers[f].error > budget) {
+      continue;
+    }
+    int8[f] = 1;
+    convert_network(&p, int8);
+    if (measure(&p, p.copy, 1, &trial) == 0 && trial.error <= budget) {
+      kept = trial;
+    } else {
+      int8[f] = 0;
+    }
+  }
+
+  for (i = 0; i < num_of_functions; i++) {
+    int *list = (int *)NN_GET(net, net->functions.list);
+    nn_function_t *f = (nn_function_t *)NN_GET(net, list[i]);
+    if (layers[i].nsec <= 0.0) {
+      continue;
+    }
+    printf("%-24s %5d %10.1f %10.2e %10s\n", function_type_name(f->type), i,
+           (base.nsec - layers[i].nsec) / 1e3, layers[i].error,
+           int8[i] ? "FIXED8" : "FLOAT32");
+  }
+
+  convert_network(&p, int8);
+  fp = fopen(output_name, "w");
+  if (fp == 0) {
+    printf("Cannot open output file: %s.\n", output_name);
+    goto end;
+  }
+  fprintf(fp, "# Planned with %d samples, error %g within %g.\n",
+          p.num_of_samples, kept.error, budget);
+  fprintf(fp, "# Forward %.1f us, %.1f us in FLOAT32.\n", kept.nsec / 1e3,
+          base.nsec / 1e3);
+  write_settings(fp, &p, &names);
+  fclose(fp);
+  printf("Forward %.1f us of %.1f us in FLOAT32, error %g within %g, "
+         "written into %s.\n",
+         kept.nsec / 1e3, base.nsec / 1e3, kept.error, budget, output_name);
+  ret = 0;
+
+end:
+  free_names(&names);
+  free(p.cal.min);
+  free(p.cal.max);
+  free(p.cal.observed);
+  free(p.is_io);
+  free(p.int8_variables);
+  free(p.copy);
+  free(p.inputs);
+  free(p.reference);
+  free(layers);
+  free(order);
+  free(int8);
+  rt_free_context(&p.cal.context);
+  return ret;
+}
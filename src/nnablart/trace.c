@@ -0,0 +1,134 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "../runtime/runtime_internal.h"
+#include "dump_function.h"
+#include "trace.h"
+
+/*
+ * Events are written in Chrome trace event format, which is read by Perfetto
+ * and chrome://tracing. Each function is a complete event on its thread, and
+ * each call of rt_forward() is an event on the caller thread around them.
+ * Times are in microsecond from the first event.
+ */
+
+static void write_shapes(FILE *output, nn_network_t *net, nn_list_t inputs) {
+  int *list = (int *)NN_GET(net, inputs.list);
+  int *variables = (int *)NN_GET(net, net->variables.list);
+  int i, j; // Iterator
+
+  fprintf(output, "[");
+  for (i = 0; i < inputs.size; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(net, variables[list[i]]));
+    int *shape = (int *)NN_GET(net, var->shape.list);
+    fprintf(output, "%s[", i > 0 ? "," : "");
+    for (j = 0; j < var->shape.size; j++) {
+      fprintf(output, "%s%d", j > 0 ? "," : "", shape[j]);
+    }
+    fprintf(output, "]");
+  }
+  fprintf(output, "]");
+}
+
+int write_trace(const char *filename, nn_network_t *net,
+                rt_context_pointer context, const rt_trace_event_t *events,
+                int num_of_events) {
+  int num_of_functions = rt_num_of_functions(context);
+  int *functions = (int *)NN_GET(net, net->functions.list);
+  uint64_t origin = 0;
+  int num_of_threads = 1;
+  int first = 1;
+  int i, k; // Iterator
+  FILE *output = 0;
+
+#ifdef _MSC_VER
+  fopen_s(&output, filename, "w");
+#else
+  output = fopen(filename, "w");
+#endif
+  if (output == NULL) {
+    printf("Cannot open trace file: %s.\n", filename);
+    return -1;
+  }
+
+  for (i = 0; i < num_of_events; i++) {
+    if (events[i].function < 0) {
+      continue;
+    }
+    if (first || events[i].start_nsec < origin) {
+      origin = events[i].start_nsec;
+      first = 0;
+    }
+    if (events[i].thread >= num_of_threads) {
+      num_of_threads = events[i].thread + 1;
+    }
+  }
+
+  fprintf(output, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  for (i = 0; i < num_of_threads; i++) {
+    fprintf(output,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s %d\"}},\n",
+            i, i == 0 ? "Caller" : "Worker", i);
+  }
+
+  for (k = 0; num_of_functions > 0 && k + num_of_functions <= num_of_events;
+       k += num_of_functions) {
+    const rt_trace_event_t *call = events + k;
+    uint64_t start = 0, end = 0;
+    first = 1;
+    for (i = 0; i < num_of_functions; i++) {
+      nn_function_t *func;
+      if (call[i].function < 0) {
+        continue;
+      }
+      func = (nn_function_t *)(NN_GET(net, functions[call[i].function]));
+      if (first || call[i].start_nsec < start) {
+        start = call[i].start_nsec;
+      }
+      if (first || call[i].end_nsec > end) {
+        end = call[i].end_nsec;
+      }
+      first = 0;
+      fprintf(output,
+              "{\"name\":\"%s\",\"cat\":\"function\",\"ph\":\"X\","
+              "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+              "\"args\":{\"index\":%d,\"type\":%d,\"impl\":%d,\"inputs\":",
+              function_type_name(func->type),
+              (call[i].start_nsec - origin) / 1e3,
+              (call[i].end_nsec - call[i].start_nsec) / 1e3, call[i].thread,
+              call[i].function, func->type, func->impl);
+      write_shapes(output, net, func->inputs);
+      fprintf(output, "}},\n");
+    }
+    if (!first) {
+      fprintf(output,
+              "{\"name\":\"rt_forward\",\"cat\":\"forward\",\"ph\":\"X\","
+              "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":0,"
+              "\"args\":{\"call\":%d}},\n",
+              (start - origin) / 1e3, (end - start) / 1e3,
+              k / num_of_functions);
+    }
+  }
+  // Trailing comma is not allowed by JSON.
+  fprintf(output, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                  "\"args\":{\"name\":\"nnablart\"}}\n]}\n");
+  fclose(output);
+  return 0;
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef H_TRACE_H_181213120000_
+#define H_TRACE_H_181213120000_
+
+/// Write events recorded by rt_set_trace() as Chrome trace event JSON.
+int write_trace(const char *filename, nn_network_t *net,
+                rt_context_pointer context, const rt_trace_event_t *events,
+                int num_of_events);
+
+#endif // H_TRACE_H_181213120000_
@@ -0,0 +1,287 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+static void *(*backend_malloc)(size_t size) = malloc;
+static void (*backend_free)(void *ptr) = free;
+
+// Context which is now initialized or freed by this thread.
+static RT_THREAD_LOCAL rt_context_t *active_context = 0;
+
+void set_backend_malloc(void *(*user_malloc)(size_t size)) {
+  backend_malloc = user_malloc;
+}
+
+void set_backend_free(void (*user_free)(void *ptr)) {
+  backend_free = user_free;
+}
+
+// Allocator of context c, or global one if it has none.
+static void *allocate_by(rt_context_t *c, size_t size) {
+  if (c != 0 && c->allocator.malloc_func) {
+    return c->allocator.malloc_func(c->allocator.user_data, size);
+  }
+  return backend_malloc(size);
+}
+
+static void free_by(rt_context_t *c, void *ptr) {
+  if (c != 0 && c->allocator.free_func) {
+    c->allocator.free_func(c->allocator.user_data, ptr);
+  } else {
+    backend_free(ptr);
+  }
+}
+
+// Size of chunk header, after which data is aligned.
+#define ARENA_CHUNK_HEADER                                                     \
+  RT_ALIGN_SIZE(sizeof(rt_arena_chunk_t), RT_ARENA_ALIGNMENT)
+
+// Size of the first chunk allocated by runtime. Next ones are doubled, so
+// that a context takes a few of them.
+#define ARENA_MIN_CHUNK (16 * 1024)
+
+static uint8_t *chunk_data(rt_arena_chunk_t *chunk) {
+  return (uint8_t *)chunk + ARENA_CHUNK_HEADER;
+}
+
+static int is_in_area(const uint8_t *base, size_t size, void *ptr) {
+  return base != 0 && (uint8_t *)ptr >= base && (uint8_t *)ptr < base + size;
+}
+
+static int is_in_arena(rt_context_arena_t *arena, void *ptr) {
+  rt_arena_chunk_t *chunk;
+  if (is_in_area(arena->block, arena->block_size, ptr)) {
+    return 1;
+  }
+  for (chunk = arena->chunks; chunk; chunk = chunk->next) {
+    if (is_in_area(chunk_data(chunk), chunk->size, ptr)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void take_chunk(rt_context_arena_t *arena, rt_arena_chunk_t *chunk) {
+  arena->chunk = chunk;
+  arena->base = chunk_data(chunk);
+  arena->size = chunk->size;
+  arena->used = 0;
+}
+
+static rt_arena_chunk_t *add_chunk(rt_context_t *c, size_t size) {
+  rt_context_arena_t *arena = &c->arena;
+  rt_arena_chunk_t *chunk = allocate_by(c, ARENA_CHUNK_HEADER + size);
+  rt_arena_chunk_t **last = &arena->chunks;
+  if (chunk == 0) {
+    return 0;
+  }
+  chunk->next = 0;
+  chunk->size = size;
+  while (*last) {
+    last = &(*last)->next;
+  }
+  *last = chunk;
+  return chunk;
+}
+
+// Move to the next chunk which has aligned_size, allocating one if there is
+// none. Tail of current area is left unused.
+static int next_chunk(rt_context_t *c, size_t aligned_size) {
+  rt_context_arena_t *arena = &c->arena;
+  rt_arena_chunk_t *chunk = arena->chunk ? arena->chunk->next : arena->chunks;
+  size_t size = ARENA_MIN_CHUNK;
+
+  for (; chunk; chunk = chunk->next) {
+    if (chunk->size >= aligned_size) {
+      take_chunk(arena, chunk);
+      return 1;
+    }
+    size = chunk->size * 2;
+  }
+  if (size < aligned_size) {
+    size = aligned_size;
+  }
+  chunk = add_chunk(c, size);
+  if (chunk == 0) {
+    return 0;
+  }
+  take_chunk(arena, chunk);
+  return 1;
+}
+
+void count_context_allocation(size_t size) {
+  if (active_context != 0) {
+    active_context->allocated += size;
+  }
+}
+
+void *context_malloc(size_t size) {
+  rt_context_t *c = active_context;
+  count_context_allocation(size);
+  if (c == 0 || !c->arena.enabled) {
+    return allocate_by(c, size);
+  }
+
+  size_t aligned_size = RT_ALIGN_SIZE(size, RT_ARENA_ALIGNMENT);
+  rt_context_arena_t *arena = &c->arena;
+  if ((arena->base == 0 || arena->used + aligned_size > arena->size) &&
+      !next_chunk(c, aligned_size)) {
+    return 0;
+  }
+  void *ptr = arena->base + arena->used;
+  arena->used += aligned_size;
+  arena->total += aligned_size;
+  return ptr;
+}
+
+void context_free(void *ptr) {
+  rt_context_t *c = active_context;
+  if (c != 0 && is_in_arena(&c->arena, ptr)) {
+    // Whole arena is released at once in rt_free_context().
+    return;
+  }
+  free_by(c, ptr);
+}
+
+void *variable_backend_malloc(size_t size) {
+  rt_context_t *c = active_context;
+  if (c != 0 && c->variable_allocator.malloc_func) {
+    return c->variable_allocator.malloc_func(c->variable_allocator.user_data,
+                                             size);
+  }
+  return rt_variable_malloc_func(size);
+}
+
+void variable_backend_free(void *ptr) {
+  rt_context_t *c = active_context;
+  if (c != 0 && c->variable_allocator.free_func) {
+    c->variable_allocator.free_func(c->variable_allocator.user_data, ptr);
+  } else {
+    rt_variable_free_func(ptr);
+  }
+}
+
+void *begin_context_allocation(rt_context_t *c) {
+  rt_context_t *previous = active_context;
+  active_context = c;
+  rt_set_weight_copies(c ? get_weight_copies(c) : 0);
+  return previous;
+}
+
+void end_context_allocation(void *previous) {
+  active_context = (rt_context_t *)previous;
+  rt_set_weight_copies(active_context ? get_weight_copies(active_context) : 0);
+}
+
+void rewind_context_arena(rt_context_t *c) {
+  rt_context_arena_t *arena = &c->arena;
+  if (arena->block) {
+    arena->chunk = 0;
+    arena->base = arena->block;
+    arena->size = arena->block_size;
+    arena->used = 0;
+  } else if (arena->chunks) {
+    take_chunk(arena, arena->chunks);
+  } else {
+    arena->base = 0;
+    arena->size = 0;
+    arena->used = 0;
+  }
+  arena->total = 0;
+}
+
+rt_return_value_t reserve_context_arena(rt_context_t *c, size_t size) {
+  if (add_chunk(c, size) == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  rewind_context_arena(c);
+  return RT_RET_NOERROR;
+}
+
+void free_context_arena(rt_context_t *c) {
+  rt_context_arena_t *arena = &c->arena;
+  while (arena->chunks) {
+    rt_arena_chunk_t *next = arena->chunks->next;
+    free_by(c, arena->chunks);
+    arena->chunks = next;
+  }
+  arena->chunk = 0;
+  arena->base = 0;
+  arena->size = 0;
+  arena->used = 0;
+}
+
+// Static block never falls back to heap, so allocation fails when it is
+// exhausted. Without base, memory is taken from heap and only counted.
+static void *static_block_malloc(void *user_data, size_t size) {
+  rt_static_block_t *b = user_data;
+  size_t aligned_size = RT_ALIGN_SIZE(size, RT_ARENA_ALIGNMENT);
+  void *ptr;
+
+  if (b->base == 0) {
+    ptr = backend_malloc(size);
+  } else if (aligned_size <= b->size - b->used) {
+    ptr = b->base + b->used;
+  } else {
+    return 0;
+  }
+  if (ptr != 0) {
+    b->used += aligned_size;
+    if (b->used > b->peak) {
+      b->peak = b->used;
+    }
+  }
+  return ptr;
+}
+
+static void static_block_free(void *user_data, void *ptr) {
+  rt_static_block_t *b = user_data;
+  if (b->base == 0) {
+    backend_free(ptr);
+  }
+  // Memory in block is given back by rewind_static_block().
+}
+
+void init_static_block(rt_context_t *c, uint8_t *base, size_t size) {
+  rt_allocator_t allocator = {static_block_malloc, static_block_free,
+                              &c->block};
+  c->block.enabled = 1;
+  c->block.base = base;
+  c->block.size = size;
+  c->block.used = RT_ALIGN_SIZE(sizeof(rt_context_t), RT_ARENA_ALIGNMENT);
+  c->block.mark = c->block.used;
+  c->block.peak = c->block.used;
+  c->allocator = allocator;
+  c->variable_allocator = allocator;
+}
+
+void mark_static_block(rt_context_t *c) { c->block.mark = c->block.used; }
+
+void rewind_static_block(rt_context_t *c) { c->block.used = c->block.mark; }
+
+void *context_owned_malloc(rt_context_t *c, size_t size) {
+  return c->block.enabled ? allocate_by(c, size) : rt_malloc_func(size);
+}
+
+void context_owned_free(rt_context_t *c, void *ptr) {
+  if (c->block.enabled) {
+    free_by(c, ptr);
+  } else {
+    rt_free_func(ptr);
+  }
+}
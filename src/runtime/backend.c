@@ -0,0 +1,138 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Backends are kept sorted by priority, higher first, so that a function is
+ * given to the first kernel of its type which accepts it. Whether a backend
+ * takes a function is known only when its variables are allocated, so
+ * functions of any type a backend has are kept as they are in network.
+ */
+
+static rt_function_error_t free_nothing(rt_function_t *f) {
+  (void)f;
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_return_value_t rt_add_backend(rt_context_pointer context,
+                                 const rt_backend_t *backend) {
+  rt_context_t *c = context;
+  rt_backend_t *backends;
+  int i; // Iterator
+
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  backends = context_owned_malloc(c, (c->num_of_backends + 1) *
+                                         sizeof(rt_backend_t));
+  if (backends == 0) {
+    return RT_RET_ERROR_ALLOCATE_CALLBACK_BUFFER;
+  }
+
+  // After backends of same or higher priority.
+  for (i = 0; i < c->num_of_backends &&
+              c->backends[i].priority >= backend->priority;
+       i++) {
+  }
+  if (c->backends) {
+    memcpy(backends, c->backends, i * sizeof(rt_backend_t));
+    memcpy(backends + i + 1, c->backends + i,
+           (c->num_of_backends - i) * sizeof(rt_backend_t));
+    context_owned_free(c, c->backends);
+  }
+  backends[i] = *backend;
+  c->backends = backends;
+  c->num_of_backends += 1;
+  return RT_RET_NOERROR;
+}
+
+void free_backends(rt_context_t *c) {
+  if (c->backends) {
+    context_owned_free(c, c->backends);
+    c->backends = 0;
+  }
+  c->num_of_backends = 0;
+}
+
+const int *rt_network_list(nn_network_t *net, nn_list_t list) {
+  return (const int *)NN_GET(net, list.list);
+}
+
+int has_user_function(rt_context_t *c, nn_function_t *func) {
+  int i, k; // Iterator
+  if (func->impl <= NN_END_OF_USER_DEFINED_FUNCTION_IMPLEMENT) {
+    for (i = 0; i < c->num_of_callbacks; i++) {
+      if (c->callbacks[i].type == func->type) {
+        return 1;
+      }
+    }
+  }
+  for (i = 0; i < c->num_of_backends; i++) {
+    for (k = 0; k < c->backends[i].num_of_kernels; k++) {
+      if (c->backends[i].kernels[k].type == func->type) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int allocate_backend_function(nn_network_t *n, rt_context_t *c, int i) {
+  rt_function_context_t *function_context = c->functions + i;
+  rt_function_t *f = &function_context->func;
+  nn_function_t *info = function_context->info;
+  int j, k; // Iterator
+
+  for (j = 0; j < c->num_of_backends; j++) {
+    const rt_backend_t *backend = c->backends + j;
+    for (k = 0; k < backend->num_of_kernels; k++) {
+      const rt_backend_kernel_t *kernel = backend->kernels + k;
+      if (kernel->type != info->type || kernel->exec_func == 0 ||
+          (kernel->accept &&
+           !kernel->accept(n, info, f, backend->user_data))) {
+        continue;
+      }
+      f->local_context = 0;
+      if (kernel->allocate_local_context &&
+          kernel->allocate_local_context(n, info, f, backend->user_data) !=
+              RT_FUNCTION_ERROR_NOERROR) {
+        // Kernel leaves nothing to free when it fails.
+        f->local_context = 0;
+        continue;
+      }
+      f->exec_func = kernel->exec_func;
+      f->free_local_context_func = kernel->free_local_context_func
+                                       ? kernel->free_local_context_func
+                                       : free_nothing;
+      function_context->backend = j;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+const char *rt_function_backend(rt_context_pointer context, int index) {
+  rt_context_t *c = context;
+  if (index < 0 || index >= c->num_of_functions ||
+      c->functions[index].backend < 0) {
+    return 0;
+  }
+  return c->backends[c->functions[index].backend].name;
+}
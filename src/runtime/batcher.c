@@ -0,0 +1,440 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(_MSC_VER) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L // For clock_gettime() with -std=c99
+#endif
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Each context of a batcher has one thread, which takes up to max_batch_size
+ * oldest pending requests when there are so many or when the oldest one
+ * reaches its deadline. Contexts always run at max_batch_size, since
+ * reshaping to the number of requests initializes context again.
+ */
+
+typedef struct {
+  rt_context_pointer context;
+  rt_batch_request_t *requests; ///< Requests of running batch.
+} batch_worker_t;
+
+typedef struct {
+  int max_batch_size;
+  uint32_t max_delay_usec;
+  int num_of_inputs;
+  size_t *input_bytes; ///< Bytes of one sample of each input.
+  int num_of_outputs;
+  size_t *output_bytes; ///< Bytes of one sample of each output.
+  int num_of_contexts;
+  batch_worker_t *workers;
+  void *queue; ///< Pending requests and threads.
+} batcher_t;
+
+// Bytes of one row of batched variable, or 0 if it is not batched.
+static size_t sample_bytes(const rt_variable_t *v, int batch_size) {
+  size_t size = 1;
+  int i; // Iterator
+  if (v->shape.size < 1 || v->shape.data[0] != batch_size) {
+    return 0;
+  }
+  for (i = 1; i < v->shape.size; i++) {
+    size *= v->shape.data[i];
+  }
+  if (v->type == NN_DATA_TYPE_SIGN) {
+    // Rows must start at byte boundary.
+    return size % 8 == 0 ? size / 8 : 0;
+  }
+  return size * calc_element_size(v->type);
+}
+
+static rt_return_value_t measure_samples(batcher_t *b, rt_context_t *c) {
+  int i; // Iterator
+  b->num_of_inputs = c->num_of_inputs;
+  b->num_of_outputs = c->num_of_outputs;
+  b->input_bytes = rt_malloc_func(sizeof(size_t) * (c->num_of_inputs + 1));
+  b->output_bytes = rt_malloc_func(sizeof(size_t) * (c->num_of_outputs + 1));
+  if (b->input_bytes == 0 || b->output_bytes == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < c->num_of_inputs; i++) {
+    b->input_bytes[i] = sample_bytes(c->variables + c->input_variable_ids[i],
+                                     b->max_batch_size);
+    if (b->input_bytes[i] == 0) {
+      return RT_RET_ERROR_INVALID_SHAPE;
+    }
+  }
+  for (i = 0; i < c->num_of_outputs; i++) {
+    b->output_bytes[i] = sample_bytes(
+        c->variables + c->output_variable_ids[i], b->max_batch_size);
+    if (b->output_bytes[i] == 0) {
+      return RT_RET_ERROR_INVALID_SHAPE;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+// Clone of source reshaped to max_batch_size.
+static rt_return_value_t create_worker(batcher_t *b, rt_context_t *source,
+                                       batch_worker_t *w) {
+  rt_return_value_t ret;
+  int *shape;
+  int i; // Iterator
+
+  w->requests = rt_malloc_func(sizeof(rt_batch_request_t) * b->max_batch_size);
+  if (w->requests == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  ret = rt_clone_context(source, &w->context);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  if (source->num_of_inputs > 0) {
+    rt_variable_t *input = source->variables + source->input_variable_ids[0];
+    shape = rt_malloc_func(sizeof(int) * input->shape.size);
+    if (shape == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    for (i = 0; i < input->shape.size; i++) {
+      shape[i] = input->shape.data[i];
+    }
+    shape[0] = b->max_batch_size;
+    ret = rt_reshape_input(w->context, 0, shape);
+    rt_free_func(shape);
+  }
+  return ret;
+}
+
+static void free_batcher(batcher_t *b) {
+  int i; // Iterator
+  if (b->workers) {
+    for (i = 0; i < b->num_of_contexts; i++) {
+      if (b->workers[i].context) {
+        rt_free_context(&b->workers[i].context);
+      }
+      if (b->workers[i].requests) {
+        rt_free_func(b->workers[i].requests);
+      }
+    }
+    rt_free_func(b->workers);
+  }
+  if (b->input_bytes) {
+    rt_free_func(b->input_bytes);
+  }
+  if (b->output_bytes) {
+    rt_free_func(b->output_bytes);
+  }
+  rt_free_func(b);
+}
+
+static rt_return_value_t allocate_batcher(batcher_t **batcher,
+                                          rt_context_t *source,
+                                          const rt_batcher_config_t *config,
+                                          int num_of_contexts) {
+  rt_return_value_t ret;
+  batcher_t *b;
+  int i; // Iterator
+
+  *batcher = 0;
+  if (source->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (num_of_contexts < 1 || config->max_batch_size < 1 ||
+      config->capacity < 1) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  b = rt_malloc_func(sizeof(batcher_t));
+  if (b == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(b, 0, sizeof(batcher_t));
+  b->max_batch_size = config->max_batch_size;
+  b->max_delay_usec = config->max_delay_usec;
+  b->num_of_contexts = num_of_contexts;
+  b->workers = rt_malloc_func(sizeof(batch_worker_t) * num_of_contexts);
+  if (b->workers == 0) {
+    free_batcher(b);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(b->workers, 0, sizeof(batch_worker_t) * num_of_contexts);
+  for (i = 0; i < num_of_contexts; i++) {
+    ret = create_worker(b, source, b->workers + i);
+    if (ret != RT_RET_NOERROR) {
+      free_batcher(b);
+      return ret;
+    }
+  }
+  ret = measure_samples(b, b->workers[0].context);
+  if (ret != RT_RET_NOERROR) {
+    free_batcher(b);
+    return ret;
+  }
+  *batcher = b;
+  return RT_RET_NOERROR;
+}
+
+static void run_batch(batcher_t *b, batch_worker_t *w, int num_of_requests) {
+  rt_context_t *c = w->context;
+  rt_return_value_t ret;
+  int i, k; // Iterator
+
+  for (i = 0; i < b->num_of_inputs; i++) {
+    uint8_t *data = c->variables[c->input_variable_ids[i]].data;
+    for (k = 0; k < num_of_requests; k++) {
+      memcpy(data + b->input_bytes[i] * k, w->requests[k].inputs[i],
+             b->input_bytes[i]);
+    }
+  }
+  ret = rt_forward(c);
+  for (i = 0; ret == RT_RET_NOERROR && i < b->num_of_outputs; i++) {
+    const uint8_t *data = c->variables[c->output_variable_ids[i]].data;
+    for (k = 0; k < num_of_requests; k++) {
+      memcpy(w->requests[k].outputs[i], data + b->output_bytes[i] * k,
+             b->output_bytes[i]);
+    }
+  }
+  for (k = 0; k < num_of_requests; k++) {
+    if (w->requests[k].done) {
+      w->requests[k].done(w->requests[k].user_data, ret);
+    }
+  }
+}
+
+#ifdef NNABLART_USE_PTHREAD
+
+#include <pthread.h>
+#include <time.h>
+
+typedef struct {
+  rt_batch_request_t request;
+  struct timespec deadline; ///< Time to run without waiting for others.
+} pending_request_t;
+
+typedef struct {
+  pthread_t *threads;
+  int num_of_started; ///< Number of threads which took their context.
+
+  pthread_mutex_t mutex;
+  pthread_cond_t submitted;
+  int shutdown;
+
+  int capacity;
+  pending_request_t *pending; ///< Ring of pending requests.
+  int head;                   ///< Oldest pending request.
+  int num_of_pending;
+  int num_of_running;
+} batch_queue_t;
+
+// Deadline is in clock of pthread_cond_timedwait().
+static struct timespec deadline_after(uint32_t usec) {
+  struct timespec t;
+  clock_gettime(CLOCK_REALTIME, &t);
+  t.tv_sec += usec / 1000000;
+  t.tv_nsec += (long)(usec % 1000000) * 1000;
+  if (t.tv_nsec >= 1000000000L) {
+    t.tv_sec += 1;
+    t.tv_nsec -= 1000000000L;
+  }
+  return t;
+}
+
+static int is_past(const struct timespec *deadline) {
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return now.tv_sec > deadline->tv_sec ||
+         (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+static void *worker(void *arg) {
+  batcher_t *b = arg;
+  batch_queue_t *q = b->queue;
+  batch_worker_t *w;
+  int num_of_requests;
+  int k; // Iterator
+
+  pthread_mutex_lock(&q->mutex);
+  w = b->workers + q->num_of_started++;
+  for (;;) {
+    while (q->num_of_pending == 0 && !q->shutdown) {
+      pthread_cond_wait(&q->submitted, &q->mutex);
+    }
+    if (q->num_of_pending == 0) {
+      break; // Shut down after pending requests are finished.
+    }
+    // Pending requests run at once when batcher is shut down.
+    while (q->num_of_pending > 0 && q->num_of_pending < b->max_batch_size &&
+           !q->shutdown && !is_past(&q->pending[q->head].deadline)) {
+      pthread_cond_timedwait(&q->submitted, &q->mutex,
+                             &q->pending[q->head].deadline);
+    }
+    num_of_requests = q->num_of_pending < b->max_batch_size
+                          ? q->num_of_pending
+                          : b->max_batch_size;
+    if (num_of_requests == 0) {
+      continue; // Taken by another thread.
+    }
+    for (k = 0; k < num_of_requests; k++) {
+      w->requests[k] = q->pending[q->head].request;
+      q->head = (q->head + 1) % q->capacity;
+    }
+    q->num_of_pending -= num_of_requests;
+    q->num_of_running += num_of_requests;
+    if (q->num_of_pending > 0) {
+      // Rest are for another thread.
+      pthread_cond_signal(&q->submitted);
+    }
+    pthread_mutex_unlock(&q->mutex);
+
+    run_batch(b, w, num_of_requests);
+
+    pthread_mutex_lock(&q->mutex);
+    q->num_of_running -= num_of_requests;
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return 0;
+}
+
+static void free_queue(batch_queue_t *q) {
+  if (q->threads) {
+    rt_free_func(q->threads);
+  }
+  if (q->pending) {
+    rt_free_func(q->pending);
+  }
+  rt_free_func(q);
+}
+
+// Stop threads after pending requests.
+static void stop_queue(batch_queue_t *q, int num_of_threads) {
+  int i; // Iterator
+  pthread_mutex_lock(&q->mutex);
+  q->shutdown = 1;
+  pthread_cond_broadcast(&q->submitted);
+  pthread_mutex_unlock(&q->mutex);
+  for (i = 0; i < num_of_threads; i++) {
+    pthread_join(q->threads[i], 0);
+  }
+  pthread_cond_destroy(&q->submitted);
+  pthread_mutex_destroy(&q->mutex);
+}
+
+rt_return_value_t rt_create_batcher(rt_batcher_pointer *batcher,
+                                    rt_context_pointer context,
+                                    const rt_batcher_config_t *config) {
+  batch_queue_t *q;
+  batcher_t *b;
+  rt_return_value_t ret;
+  int i; // Iterator
+
+  *batcher = 0;
+  ret = allocate_batcher(&b, context, config, config->num_of_contexts);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  q = rt_malloc_func(sizeof(batch_queue_t));
+  if (q == 0) {
+    free_batcher(b);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(q, 0, sizeof(batch_queue_t));
+  q->capacity = config->capacity;
+  q->threads = rt_malloc_func(sizeof(pthread_t) * b->num_of_contexts);
+  q->pending = rt_malloc_func(sizeof(pending_request_t) * q->capacity);
+  if (q->threads == 0 || q->pending == 0) {
+    free_queue(q);
+    free_batcher(b);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  pthread_mutex_init(&q->mutex, 0);
+  pthread_cond_init(&q->submitted, 0);
+  b->queue = q;
+
+  for (i = 0; i < b->num_of_contexts; i++) {
+    if (pthread_create(q->threads + i, 0, worker, b) != 0) {
+      stop_queue(q, i);
+      free_queue(q);
+      free_batcher(b);
+      return RT_RET_ERROR_CREATE_THREAD_POOL;
+    }
+  }
+  *batcher = b;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_submit_batch_request(rt_batcher_pointer batcher,
+                                          const rt_batch_request_t *request) {
+  batcher_t *b = batcher;
+  batch_queue_t *q = b->queue;
+  pending_request_t *p;
+
+  pthread_mutex_lock(&q->mutex);
+  if (q->num_of_pending + q->num_of_running >= q->capacity) {
+    pthread_mutex_unlock(&q->mutex);
+    return RT_RET_ERROR_QUEUE_FULL;
+  }
+  p = q->pending + (q->head + q->num_of_pending) % q->capacity;
+  p->request = *request;
+  p->deadline = deadline_after(b->max_delay_usec);
+  q->num_of_pending++;
+  // Thread waiting for first request, or for a full batch.
+  if (q->num_of_pending == 1 || q->num_of_pending >= b->max_batch_size) {
+    pthread_cond_signal(&q->submitted);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_destroy_batcher(rt_batcher_pointer *batcher) {
+  batcher_t *b = *batcher;
+  if (b == 0) {
+    return RT_RET_NOERROR;
+  }
+  stop_queue(b->queue, b->num_of_contexts);
+  free_queue(b->queue);
+  free_batcher(b);
+  *batcher = 0;
+  return RT_RET_NOERROR;
+}
+
+#else /* NNABLART_USE_PTHREAD */
+
+rt_return_value_t rt_create_batcher(rt_batcher_pointer *batcher,
+                                    rt_context_pointer context,
+                                    const rt_batcher_config_t *config) {
+  // Requests run one by one, so one context is enough.
+  return allocate_batcher((batcher_t **)batcher, context, config, 1);
+}
+
+rt_return_value_t rt_submit_batch_request(rt_batcher_pointer batcher,
+                                          const rt_batch_request_t *request) {
+  batcher_t *b = batcher;
+  b->workers[0].requests[0] = *request;
+  run_batch(b, b->workers, 1);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_destroy_batcher(rt_batcher_pointer *batcher) {
+  if (*batcher) {
+    free_batcher(*batcher);
+    *batcher = 0;
+  }
+  return RT_RET_NOERROR;
+}
+
+#endif /* NNABLART_USE_PTHREAD */
@@ -0,0 +1,566 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+typedef struct {
+  int first;     ///< Index of first function which uses the variable.
+  int last;      ///< Index of last function which uses the variable.
+  int fused;     ///< Only used by functions merged into others.
+  size_t size;   ///< Aligned size in byte (0 means not buffer backed).
+  size_t offset; ///< Offset in the arena.
+  int alias;     ///< Variable whose area is shared in place, or -1.
+  size_t alias_offset; ///< Offset in area of alias.
+  int inside;          ///< Placed inside area of alias at alias_offset.
+  int pinned;          ///< Area of network input or output, placed first.
+} buffer_plan_entry_t;
+
+// Pinned variables first, then larger ones, then earlier ones.
+static int is_placed_before(const buffer_plan_entry_t *a,
+                            const buffer_plan_entry_t *b) {
+  if (a->pinned != b->pinned) {
+    return a->pinned;
+  }
+  if (a->size != b->size) {
+    return a->size > b->size;
+  }
+  return a->first < b->first;
+}
+
+static void update_lifetime(buffer_plan_entry_t *entry, int index) {
+  if (entry->first < 0 || index < entry->first) {
+    entry->first = index;
+  }
+  if (index > entry->last) {
+    entry->last = index;
+  }
+}
+
+static void update_lifetime_from_list(buffer_plan_entry_t *entries,
+                                      int num_of_entries, rt_list_t list,
+                                      int index) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] >= 0 && list.data[i] < num_of_entries) {
+      update_lifetime(entries + list.data[i], index);
+    }
+  }
+}
+
+static void mark_fused_from_list(buffer_plan_entry_t *entries,
+                                 int num_of_entries, rt_list_t list) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] >= 0 && list.data[i] < num_of_entries) {
+      entries[list.data[i]].fused = 1;
+    }
+  }
+}
+
+// Variables whose data is not in arena.
+static void remove_areas(buffer_plan_entry_t *entries, int num_of_entries,
+                         rt_list_t list) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] >= 0 && list.data[i] < num_of_entries) {
+      entries[list.data[i]].size = 0;
+    }
+  }
+}
+
+static void pin_areas(buffer_plan_entry_t *entries, int num_of_entries,
+                      rt_list_t list, int num_of_functions) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    int root = list.data[i];
+    if (root < 0 || root >= num_of_entries) {
+      continue;
+    }
+    while (entries[root].alias >= 0) {
+      root = entries[root].alias;
+    }
+    entries[root].pinned = 1;
+    entries[root].first = 0;
+    entries[root].last = num_of_functions;
+  }
+}
+
+static int is_overlapped(const buffer_plan_entry_t *a,
+                         const buffer_plan_entry_t *b) {
+  return a->first <= b->last && b->first <= a->last;
+}
+
+// Function i writes output over its input 0. Input must not be read by the
+// function again as another input, or as operand of merged chain. copy is set
+// if output is same data as input.
+static int get_inplace_variables(nn_network_t *n,
+                                 const function_fusion_t *fusions,
+                                 const rt_variable_t *variables, int i,
+                                 int *input, int *output, int *copy) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int j; // Iterator
+
+  *copy = 0;
+  if (inputs.size < 1 || outputs.size != 1) {
+    return 0;
+  }
+  if (fusions && (fusions[i].skip || fusions[i].tile >= 0)) {
+    // Tiled group reads its input while the last function writes output.
+    return 0;
+  }
+  if (fusions && fusions[i].chain >= 0) {
+    // Chain calculates each block from the same block of input 0.
+    for (j = i + 1; j <= fusions[i].chain; j++) {
+      if (fusions[j].operand == inputs.data[0]) {
+        return 0;
+      }
+    }
+  } else if ((fusions && fusions[i].output >= 0) ||
+             !is_inplace_function(func)) {
+    return 0;
+  } else {
+    *copy = is_alias_function(func);
+  }
+  for (j = 1; j < inputs.size; j++) {
+    if (inputs.data[j] == inputs.data[0]) {
+      return 0;
+    }
+  }
+  *input = inputs.data[0];
+  *output = fusions && fusions[i].output >= 0 ? fusions[i].output
+                                               : outputs.data[0];
+  list = (int *)NN_GET(n, n->variables.list);
+  // Copy into other fixed point position is not the same data.
+  *copy = *copy && is_same_fixed_point(variables + *input, variables + *output);
+  return ((nn_variable_t *)(NN_GET(n, *(list + *input))))->type ==
+         ((nn_variable_t *)(NN_GET(n, *(list + *output))))->type;
+}
+
+// Inputs of Concatenate whose output is one contiguous run of each input
+// are placed at their position inside output, so that Concatenate finds them
+// already there. Output lives while any of them is alive.
+static void place_concatenated_inputs(nn_network_t *n,
+                                      const function_fusion_t *fusions,
+                                      const rt_variable_t *variables,
+                                      buffer_plan_entry_t *entries,
+                                      int num_of_entries, int i) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int j, k; // Iterator
+
+  if (func->type != NN_FUNCTION_CONCATENATE || outputs.size != 1 ||
+      (fusions && fusions[i].skip)) {
+    return;
+  }
+  const int output = outputs.data[0];
+  if (output < 0 || output >= num_of_entries || entries[output].size == 0 ||
+      entries[output].alias >= 0 ||
+      variables[output].type == NN_DATA_TYPE_SIGN) {
+    return;
+  }
+  const int axis = ((nn_function_concatenate_t *)func)->axis;
+  for (j = 0; j < axis && j < variables[output].shape.size; j++) {
+    if (variables[output].shape.data[j] != 1) {
+      return;
+    }
+  }
+
+  size_t offset = 0;
+  for (j = 0; j < inputs.size; j++) {
+    const int input = inputs.data[j];
+    if (input < 0 || input >= num_of_entries) {
+      return;
+    }
+    int unique = input != output;
+    for (k = 0; k < j; k++) {
+      unique = unique && inputs.data[k] != input;
+    }
+    buffer_plan_entry_t *e = entries + input;
+    if (unique && e->size > 0 && e->alias < 0 &&
+        is_same_fixed_point(variables + input, variables + output) &&
+        offset % RT_VARIABLE_ALIGNMENT == 0) {
+      e->alias = output;
+      e->alias_offset = offset;
+      e->inside = 1;
+      if (e->first < entries[output].first) {
+        entries[output].first = e->first;
+      }
+      if (e->last > entries[output].last) {
+        entries[output].last = e->last;
+      }
+    }
+    offset += calc_variable_data_size(variables + input);
+  }
+}
+
+// Output of Slice or Split which is one contiguous run of input is placed at
+// its position inside input, so that the function finds it already there.
+// Input lives while any of such outputs is alive.
+static void place_input_views(nn_network_t *n, const function_fusion_t *fusions,
+                              const rt_variable_t *variables,
+                              buffer_plan_entry_t *entries, int num_of_entries,
+                              int i) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int j; // Iterator
+
+  if ((func->type != NN_FUNCTION_SLICE && func->type != NN_FUNCTION_SPLIT) ||
+      inputs.size != 1 || (fusions && fusions[i].skip)) {
+    return;
+  }
+  const int input = inputs.data[0];
+  if (input < 0 || input >= num_of_entries || entries[input].size == 0) {
+    return;
+  }
+  const rt_variable_t *x = variables + input;
+  const size_t element_size = calc_element_size(x->type);
+  if (element_size == 0) {
+    return;
+  }
+  int root = input;
+  while (entries[root].alias >= 0) {
+    root = entries[root].alias;
+  }
+
+  for (j = 0; j < outputs.size; j++) {
+    const int output = outputs.data[j];
+    int offset = -1;
+    if (output < 0 || output >= num_of_entries || output == input) {
+      continue;
+    }
+    if (func->type == NN_FUNCTION_SLICE) {
+      nn_function_slice_t *slice = (nn_function_slice_t *)func;
+      offset = calc_slice_view_offset(
+          x->shape, variables[output].shape,
+          create_rt_list_from_nn_list(n, slice->start),
+          create_rt_list_from_nn_list(n, slice->step));
+    } else {
+      // Output j of Split is j-th run of axes after axis.
+      const int axis = ((nn_function_split_t *)func)->axis;
+      int k, size = 1;
+      offset = 0;
+      for (k = 0; k < x->shape.size; k++) {
+        if (k < axis && x->shape.data[k] != 1) {
+          offset = -1;
+          break;
+        }
+        size *= k > axis ? x->shape.data[k] : 1;
+      }
+      offset = offset < 0 ? -1 : j * size;
+    }
+    buffer_plan_entry_t *e = entries + output;
+    if (offset < 0 || e->size == 0 || e->alias >= 0 ||
+        !is_same_fixed_point(variables + output, x) ||
+        (offset * element_size) % RT_VARIABLE_ALIGNMENT != 0) {
+      continue;
+    }
+    e->alias = input;
+    e->alias_offset = offset * element_size;
+    e->inside = 1;
+    if (e->first < entries[root].first) {
+      entries[root].first = e->first;
+    }
+    if (e->last > entries[root].last) {
+      entries[root].last = e->last;
+    }
+  }
+}
+
+rt_return_value_t plan_variable_buffers(nn_network_t *n,
+                                        const function_fusion_t *fusions,
+                                        const uint8_t *removed,
+                                        const rt_variable_t *variables,
+                                        const size_t *buffer_sizes,
+                                        int pin_io, int keep_all,
+                                        size_t *offsets, size_t *arena_size,
+                                        size_t *pinned_size) {
+  int i, j; // Iterator
+  int num_of_variables = n->variables.size;
+  int num_of_functions = n->functions.size;
+  int num_of_planned = 0;
+
+  buffer_plan_entry_t *entries =
+      rt_malloc_func(sizeof(buffer_plan_entry_t) * num_of_variables);
+  int *order = rt_malloc_func(sizeof(int) * num_of_variables);
+  int *placed = rt_malloc_func(sizeof(int) * num_of_variables);
+  if (entries == 0 || order == 0 || placed == 0) {
+    rt_free_func(entries);
+    rt_free_func(order);
+    rt_free_func(placed);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Size of each buffer backed variable.
+  int *list = (int *)NN_GET(n, n->variables.list);
+  for (i = 0; i < num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    entries[i].first = -1;
+    entries[i].last = -1;
+    entries[i].fused = 0;
+    entries[i].size = 0;
+    entries[i].offset = 0;
+    entries[i].alias = -1;
+    entries[i].alias_offset = 0;
+    entries[i].inside = 0;
+    entries[i].pinned = 0;
+    offsets[i] = 0;
+    if (var->data_index < 0) {
+      int index = (-1 * var->data_index) - 1;
+      if (index >= (int)n->buffers.size) {
+        rt_free_func(entries);
+        rt_free_func(order);
+        rt_free_func(placed);
+        return RT_RET_ERROR_INVALID_BUFFER_INDEX;
+      }
+      entries[i].size =
+          RT_ALIGN_SIZE(buffer_sizes[index], RT_BUFFER_ALIGNMENT);
+      order[num_of_planned++] = i;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Lifetime of each variable. Network inputs and outputs must stay valid
+  // across whole rt_forward(), so they are live from the beginning to the end.
+  // Fused function writes output of the last merged function, and variables
+  // between them are not used. Head with merged pooling writes its output
+  // too, so the feature map lives only while the head runs. BatchMatmul reads
+  // input of merged Transpose instead of its output, TopKData reads input of
+  // merged Softmax, and function with merged Pad reads input of the Pad.
+  // Arithmetic function reads input of Broadcast, BroadcastTo or Tile as a
+  // view. Last function of tiled group reads input of the group.
+  // Head of element wise chain reads operands of merged functions. Dead
+  // functions read and write nothing, so their outputs get no area. Outputs
+  // of folded functions are kept by context instead.
+  list = (int *)NN_GET(n, n->functions.list);
+  for (i = 0; i < num_of_functions; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+    if ((fusions && fusions[i].skip) || (removed && removed[i])) {
+      mark_fused_from_list(entries, num_of_variables, inputs);
+      mark_fused_from_list(entries, num_of_variables, outputs);
+      if (removed && removed[i] == RT_FUNCTION_FOLDED) {
+        remove_areas(entries, num_of_variables, outputs);
+      }
+      continue;
+    }
+    for (j = 0; j < inputs.size; j++) {
+      int index = inputs.data[j];
+      if (fusions && j < 2 && fusions[i].transpose[j] >= 0) {
+        nn_function_t *transpose =
+            (nn_function_t *)(NN_GET(n, *(list + fusions[i].transpose[j])));
+        index = create_rt_list_from_nn_list(n, transpose->inputs).data[0];
+      }
+      if (fusions && j < 2 && fusions[i].view[j] >= 0) {
+        nn_function_t *repeat =
+            (nn_function_t *)(NN_GET(n, *(list + fusions[i].view[j])));
+        index = create_rt_list_from_nn_list(n, repeat->inputs)
+                    .data[repeat->type == NN_FUNCTION_BROADCAST_TO ? 1 : 0];
+      }
+      if (fusions && j == 0 && fusions[i].softmax >= 0) {
+        nn_function_t *softmax =
+            (nn_function_t *)(NN_GET(n, *(list + fusions[i].softmax)));
+        index = create_rt_list_from_nn_list(n, softmax->inputs).data[0];
+      }
+      if (fusions && j == 0 && fusions[i].pad >= 0) {
+        nn_function_t *pad =
+            (nn_function_t *)(NN_GET(n, *(list + fusions[i].pad)));
+        index = create_rt_list_from_nn_list(n, pad->inputs).data[0];
+      }
+      if (fusions && j == 0 && fusions[i].mean_subtraction >= 0) {
+        nn_function_t *ms = (nn_function_t *)(NN_GET(
+            n, *(list + fusions[i].mean_subtraction)));
+        index = create_rt_list_from_nn_list(n, ms->inputs).data[0];
+      }
+      if (fusions && j == 0 && fusions[i].tile >= 0) {
+        nn_function_t *first =
+            (nn_function_t *)(NN_GET(n, *(list + fusions[i].tile)));
+        index = create_rt_list_from_nn_list(n, first->inputs).data[0];
+      }
+      if (index >= 0 && index < num_of_variables) {
+        update_lifetime(entries + index, i);
+      }
+    }
+    if (fusions) {
+      for (j = i + 1; j <= fusions[i].chain; j++) {
+        if (fusions[j].operand >= 0 && fusions[j].operand < num_of_variables) {
+          update_lifetime(entries + fusions[j].operand, i);
+        }
+      }
+    }
+    if (fusions && fusions[i].output >= 0) {
+      mark_fused_from_list(entries, num_of_variables, outputs);
+      update_lifetime(entries + fusions[i].output, i);
+      if (fusions[i].pooled >= 0) {
+        update_lifetime(entries + fusions[i].pooled, i);
+      }
+    } else {
+      update_lifetime_from_list(entries, num_of_variables, outputs, i);
+    }
+  }
+  rt_list_t inputs = create_rt_list_from_nn_list(n, n->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, n->outputs);
+  update_lifetime_from_list(entries, num_of_variables, inputs, 0);
+  update_lifetime_from_list(entries, num_of_variables, inputs,
+                            num_of_functions);
+  update_lifetime_from_list(entries, num_of_variables, outputs, 0);
+  update_lifetime_from_list(entries, num_of_variables, outputs,
+                            num_of_functions);
+  for (i = 0; i < num_of_variables; i++) {
+    if (entries[i].first < 0 && entries[i].fused) {
+      entries[i].first = 0;
+      entries[i].last = 0;
+      entries[i].size = 0;
+    } else if (entries[i].first < 0 || keep_all) {
+      // Not used by any function, or kept for next rt_forward(), keep it for
+      // whole lifetime.
+      entries[i].first = 0;
+      entries[i].last = num_of_functions;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Concatenated inputs and views of Slice and Split, before in place
+  // functions take their areas.
+  for (i = 0; i < num_of_functions; i++) {
+    place_concatenated_inputs(n, fusions, variables, entries, num_of_variables,
+                              i);
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    place_input_views(n, fusions, variables, entries, num_of_variables, i);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // In place functions. Output takes area of input 0 if nothing reads the
+  // area after the function, and the area lives until output is dead. Output
+  // which is a copy of input shares the area even if input is read later,
+  // since nothing writes the area while either of them is alive.
+  for (i = 0; i < num_of_functions; i++) {
+    int input, output, copy;
+    if (!get_inplace_variables(n, fusions, variables, i, &input, &output,
+                               &copy) ||
+        input < 0 || input >= num_of_variables || output < 0 ||
+        output >= num_of_variables || input == output ||
+        entries[input].inside) {
+      continue;
+    }
+    int root = input;
+    while (entries[root].alias >= 0) {
+      root = entries[root].alias;
+    }
+    buffer_plan_entry_t *e = entries + output;
+    if (entries[root].size == 0 || e->size == 0 || e->alias >= 0 ||
+        (entries[root].last != i && !copy) || e->first != i) {
+      continue;
+    }
+    e->alias = root;
+    if (e->last > entries[root].last) {
+      entries[root].last = e->last;
+    }
+    if (e->size > entries[root].size) {
+      entries[root].size = e->size;
+    }
+  }
+  for (i = 0, j = 0; i < num_of_planned; i++) {
+    if (entries[order[i]].alias < 0) {
+      order[j++] = order[i];
+    }
+  }
+  num_of_planned = j;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Areas of network inputs and outputs live during whole rt_forward(), and
+  // they are placed first. So they are below every other area, and
+  // [0, pinned_size) is kept by context while the rest can be shared.
+  *pinned_size = 0;
+  if (pin_io) {
+    pin_areas(entries, num_of_variables, inputs, num_of_functions);
+    pin_areas(entries, num_of_variables, outputs, num_of_functions);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Greedy placement by size. Each variable is placed at the lowest offset
+  // which does not overlap with already placed variables living at the same
+  // time. `placed` is kept sorted by offset.
+  for (i = 1; i < num_of_planned; i++) {
+    int v = order[i];
+    for (j = i; j > 0 && is_placed_before(entries + v, entries + order[j - 1]);
+         j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = v;
+  }
+
+  int num_of_placed = 0;
+  size_t total = 0;
+  for (i = 0; i < num_of_planned; i++) {
+    buffer_plan_entry_t *e = entries + order[i];
+    size_t offset = 0;
+    for (j = 0; j < num_of_placed; j++) {
+      buffer_plan_entry_t *p = entries + placed[j];
+      if (!is_overlapped(e, p)) {
+        continue;
+      }
+      if (p->offset >= offset + e->size) {
+        break;
+      }
+      if (p->offset + p->size > offset) {
+        offset = p->offset + p->size;
+      }
+    }
+    e->offset = offset;
+    if (offset + e->size > total) {
+      total = offset + e->size;
+    }
+    if (e->pinned) {
+      *pinned_size = total;
+    }
+
+    for (j = num_of_placed; j > 0; j--) {
+      if (entries[placed[j - 1]].offset <= offset) {
+        break;
+      }
+      placed[j] = placed[j - 1];
+    }
+    placed[j] = order[i];
+    num_of_placed++;
+  }
+
+  for (i = 0; i < num_of_variables; i++) {
+    int root = i;
+    offsets[i] = 0;
+    while (entries[root].alias >= 0) {
+      offsets[i] += entries[root].alias_offset;
+      root = entries[root].alias;
+    }
+    offsets[i] += entries[root].offset;
+  }
+  *arena_size = total;
+
+  rt_free_func(entries);
+  rt_free_func(order);
+  rt_free_func(placed);
+  return RT_RET_NOERROR;
+}
@@ -0,0 +1,201 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Compressed parameters are decompressed from network straight into one area
+ * owned by context, so nothing but their final dense values is allocated.
+ * Each of them starts at an aligned offset of the area, and they are seen as
+ * NN_DATA_LAYOUT_DENSE by everything after initialization.
+ */
+
+static size_t aligned_size(const rt_variable_t *v) {
+  return (calc_variable_data_size(v) + RT_VARIABLE_ALIGNMENT - 1) &
+         ~(size_t)(RT_VARIABLE_ALIGNMENT - 1);
+}
+
+// Decode LZ4 block into exactly dst_size bytes. Returns 0 if the block is
+// broken or its size differs.
+static int decompress_lz4(const uint8_t *src, size_t src_size, uint8_t *dst,
+                          size_t dst_size) {
+  const uint8_t *src_end = src + src_size;
+  uint8_t *out = dst;
+  uint8_t *out_end = dst + dst_size;
+
+  while (src < src_end) {
+    unsigned token = *src++;
+    size_t length = token >> 4;
+    size_t offset;
+
+    // Literals
+    if (length == 15) {
+      unsigned byte;
+      do {
+        if (src >= src_end) {
+          return 0;
+        }
+        byte = *src++;
+        length += byte;
+      } while (byte == 255);
+    }
+    if (length > (size_t)(src_end - src) || length > (size_t)(out_end - out)) {
+      return 0;
+    }
+    memcpy(out, src, length);
+    src += length;
+    out += length;
+    if (src == src_end) {
+      break; // Last sequence has literals only.
+    }
+
+    // Match
+    if (src_end - src < 2) {
+      return 0;
+    }
+    offset = src[0] | ((size_t)src[1] << 8);
+    src += 2;
+    if (offset == 0 || offset > (size_t)(out - dst)) {
+      return 0;
+    }
+    length = (token & 15) + 4;
+    if ((token & 15) == 15) {
+      unsigned byte;
+      do {
+        if (src >= src_end) {
+          return 0;
+        }
+        byte = *src++;
+        length += byte;
+      } while (byte == 255);
+    }
+    if (length > (size_t)(out_end - out)) {
+      return 0;
+    }
+    // Match may overlap its own output.
+    for (; length > 0; length--, out++) {
+      *out = *(out - offset);
+    }
+  }
+  return out == out_end;
+}
+
+static int decompress_palette(const nn_compressed_t *header,
+                              const rt_variable_t *v, uint8_t *dst) {
+  size_t element_size = calc_element_size(v->type);
+  size_t count = calc_variable_data_size(v) / (element_size ? element_size : 1);
+  const uint8_t *palette = (const uint8_t *)(header + 1);
+  const uint8_t *indices = palette + element_size * header->palette_size;
+  int bits = header->index_bits;
+  unsigned mask = (1u << bits) - 1;
+  size_t i; // Iterator
+
+  if (element_size == 0 ||
+      (bits != 1 && bits != 2 && bits != 4 && bits != 8) ||
+      header->palette_size < 1 || header->palette_size > (1 << bits) ||
+      (size_t)header->size <
+          element_size * header->palette_size + (count * bits + 7) / 8) {
+    return 0;
+  }
+  for (i = 0; i < count; i++) {
+    size_t bit = i * bits;
+    unsigned index = (indices[bit / 8] >> (bit % 8)) & mask;
+    if (index >= (unsigned)header->palette_size) {
+      return 0;
+    }
+    memcpy(dst + i * element_size, palette + index * element_size,
+           element_size);
+  }
+  return 1;
+}
+
+rt_return_value_t prepare_compressed_variables(nn_network_t *n,
+                                               rt_context_t *c) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  int shared = c->source != 0 && c->source->decompressed != 0;
+  size_t size = 0;
+  uint8_t *area;
+  int i; // Iterator
+
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    if (var->layout != NN_DATA_LAYOUT_COMPRESSED) {
+      continue;
+    }
+    if (var->data_index < 0) {
+      return RT_RET_ERROR_INIT_VARIABLE;
+    }
+    size += aligned_size(c->variables + i);
+  }
+  if (size == 0) {
+    return RT_RET_NOERROR;
+  }
+
+  if (shared) {
+    // Values decompressed by source are placed in the same order.
+    c->decompressed = c->source->decompressed;
+  } else {
+    c->decompressed = variable_malloc(size);
+  }
+  if (c->decompressed == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  area = c->decompressed;
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    rt_variable_t *v = c->variables + i;
+    const nn_compressed_t *header;
+    int ok = 0;
+    if (var->layout != NN_DATA_LAYOUT_COMPRESSED) {
+      continue;
+    }
+    header = (const nn_compressed_t *)NN_GET(n, var->data_index);
+    if (shared) {
+      ok = 1;
+    } else if (header->size >= 0) {
+      switch (header->method) {
+      case NN_COMPRESSION_LZ4:
+        ok = decompress_lz4((const uint8_t *)(header + 1), header->size, area,
+                            calc_variable_data_size(v));
+        break;
+      case NN_COMPRESSION_PALETTE:
+        ok = decompress_palette(header, v, area);
+        break;
+      default:
+        break;
+      }
+    }
+    if (!ok) {
+      return RT_RET_ERROR_INIT_VARIABLE;
+    }
+    v->data = area;
+    v->layout = NN_DATA_LAYOUT_DENSE;
+    area += aligned_size(v);
+  }
+  return RT_RET_NOERROR;
+}
+
+void free_compressed_variables(rt_context_t *c) {
+  // Those of clone are owned by source.
+  if (c->decompressed &&
+      (c->source == 0 || c->source->decompressed != c->decompressed)) {
+    variable_free(c->decompressed);
+  }
+  c->decompressed = 0;
+}
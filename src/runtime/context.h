@@ -17,6 +17,7 @@
 
 #include <nnablart/functions.h>
 #include <nnablart/network.h>
+#include <nnablart/runtime.h>
 
 typedef struct {
   rt_buffer_allocate_type_t allocate_type;
@@ -26,6 +27,10 @@ typedef struct {
 typedef struct {
   nn_function_t *info;
   rt_function_t func;
+  int alias; ///< Output is copy of input 0, skipped while they share data.
+  size_t private_size; ///< Bytes allocated for local context of function.
+  int backend;         ///< Index of backend executing function, or -1.
+  uint64_t init_nsec;  ///< Time to allocate local context and choose kernel.
 } rt_function_context_t;
 
 typedef struct {
@@ -33,7 +38,226 @@ typedef struct {
   rt_return_value_t (*allocate_local_context)(nn_network_t *net, void *f);
 } rt_function_callback_t;
 
+/// Block allocated by runtime when given block of arena is exhausted.
+typedef struct st_rt_arena_chunk_t {
+  struct st_rt_arena_chunk_t *next;
+  size_t size; ///< Bytes after header.
+} rt_arena_chunk_t;
+
+typedef struct {
+  int enabled;              ///< Allocate context data from arena.
+  uint8_t *block;           ///< Block given by user, or NULL.
+  size_t block_size;
+  rt_arena_chunk_t *chunks; ///< Chunks in order of allocation.
+  rt_arena_chunk_t *chunk;  ///< Chunk taken from now, or NULL for block.
+  uint8_t *base;            ///< Area taken from now.
+  size_t size;
+  size_t used;
+  size_t total; ///< Bytes taken by initialization, which fit one block.
+} rt_context_arena_t;
+
+/// Block given to rt_allocate_static_context(), which holds context itself
+/// and all memory allocated for it.
+typedef struct {
+  int enabled;
+  uint8_t *base; ///< Aligned start of block, or NULL to only measure size.
+  size_t size;   ///< Size of block after base.
+  size_t used;   ///< Bytes taken from base, including context.
+  size_t mark;   ///< Used before memory allocated by initialization.
+  size_t peak;   ///< Max of used.
+} rt_static_block_t;
+
+/// Planned variables after network inputs and outputs, which are placed in
+/// memory shared with other contexts by rt_set_activation_arena().
+typedef struct {
+  int enabled;
+  uint8_t *base;       ///< Given memory, or NULL.
+  size_t size;         ///< Size of given memory.
+  size_t pinned_size;  ///< Size of plan kept in variable_arena.
+  size_t shared_size;  ///< Size of plan after pinned part.
+  uint8_t *shared;     ///< Memory of shared part.
+  void *owned;         ///< Shared part allocated by runtime, or NULL.
+  size_t owned_mapped; ///< Size of mapping of owned, see planned_malloc().
+} rt_activation_arena_t;
+
+/// Weight in layout of a kernel made by a function of context.
+typedef struct {
+  const void *weight; ///< Data of weight variable.
+  int layout;
+  size_t size;
+  void *copy;
+} weight_copy_t;
+
+/// Copies made by functions of context, which its clones use.
+typedef struct {
+  rt_weight_copies_t store; ///< Given to functions of context.
+  weight_copy_t *list;
+  int size;
+  int capacity;
+} weight_copies_t;
+
+/// Dependency between functions, built by rt_set_graph_execution().
+typedef struct {
+  int num_of_nodes;
+  int *num_of_dependencies; ///< Number of functions each function waits for.
+  int *successor_offsets;   ///< num_of_nodes + 1 offsets into successors.
+  int *successors;          ///< Functions which wait for each function.
+  int *remaining;           ///< Work area: dependencies not finished yet.
+  int *ready;               ///< Work area: queue of runnable functions.
+} function_graph_t;
+
+/// Functions merged into former ones, built by rt_set_function_fusion().
+typedef struct {
+  int skip;                ///< Function is executed by a former function.
+  int output;              ///< Variable written instead of output, or -1.
+  int batch_normalization; ///< BatchNormalization folded into weight, or -1.
+  int activation;          ///< Activation applied as epilogue, or -1.
+  int pooling; ///< GlobalAveragePooling applied to output, or -1.
+  int pooled;  ///< Output of merged GlobalAveragePooling, or -1.
+  float *weight;           ///< Folded weight owned by context.
+  float *bias;             ///< Folded bias owned by context.
+  int transpose[2];        ///< Transpose merged into BatchMatmul input, or -1.
+  nn_function_batch_matmul_t batch_matmul; ///< BatchMatmul with flipped flags.
+  int softmax; ///< Softmax merged into TopKData, or -1.
+  int view[2]; ///< Broadcast, BroadcastTo or Tile read by input, or -1.
+  int pad;   ///< Pad merged into pad of Convolution or pooling, or -1.
+  int *pads; ///< Pad of function with merged Pad owned by context.
+  int mean_subtraction; ///< MeanSubtraction folded into bias, or -1.
+  int tile; ///< First function of tiled group ending with function, or -1.
+  int chain;   ///< Last element wise function merged into chain, or -1.
+  int operand; ///< Variable read by merged function with chained value, or -1.
+  int num_of_ops;           ///< Number of operations of chain.
+  rt_elementwise_op_t *ops; ///< Operations of chain owned by context.
+} function_fusion_t;
+
+/// Copy of a function which calculates a range of output columns of a
+/// streaming window from input columns gathered into its own input.
+typedef struct {
+  rt_function_t func;
+  rt_variable_t input;
+  rt_variable_t output;
+  int first;   ///< First output column.
+  int columns; ///< Output columns, 0 if part is not used.
+  int start;   ///< First input column, negative in left padding.
+} window_part_t;
+
+/// Function which calculates only changed columns of its output.
+typedef struct {
+  int function;
+  int in_columns;     ///< Last axis of input.
+  int out_columns;    ///< Last axis of output.
+  int hop;            ///< Output columns moved in each run.
+  float *state;       ///< Output of former run.
+  int primed;         ///< state holds output of former run.
+  window_part_t head; ///< Columns reading left padding.
+  window_part_t tail; ///< Columns reading new input columns.
+} window_function_t;
+
+/// Functions of streaming window, built by rt_set_streaming_window().
+typedef struct {
+  int num_of_functions;
+  window_function_t *functions;
+  int *index; ///< Index into functions of each function, or -1.
+} streaming_window_t;
+
+/// Copy of a function of tiled group which calculates a band of rows of its
+/// output from a band of rows of its input.
+typedef struct {
+  int function;
+  rt_function_t func;
+  rt_variable_t input;  ///< Gathered input rows, if gather is set.
+  rt_variable_t output; ///< Band of output rows.
+  int gather;   ///< Input rows are gathered, otherwise former band is read.
+  int *pads;    ///< Pad of copy owned by group, or NULL.
+  int kernel;   ///< Kernel along rows.
+  int stride;   ///< Stride along rows.
+  int dilation; ///< Dilation along rows.
+  int pad;      ///< Pad along rows of function.
+  int in_rows;  ///< Rows of whole input.
+  int out_rows; ///< Rows of whole output.
+  int rows;     ///< Rows of band of output.
+  int first;    ///< First output row of current band.
+} tile_layer_t;
+
+/// Functions from first to last calculated band by band of output rows of
+/// last, so that bands of intermediate maps stay in cache.
+typedef struct {
+  int first;
+  int last;
+  int num_of_layers;
+  tile_layer_t *layers;
+} tiled_group_t;
+
+/// Tiled groups, built by rt_set_tiled_execution().
 typedef struct {
+  int num_of_groups;
+  tiled_group_t *groups;
+  int *index; ///< Index into groups of last function of each, or -1.
+} tiled_execution_t;
+
+/// Functions run again by rt_set_result_caching(), and what they depend on.
+typedef struct {
+  function_graph_t *graph; ///< Dependency graph, or NULL if functions are
+                           ///< a chain.
+  int own_graph;           ///< graph is not that of graph execution.
+  int *reader_offsets;     ///< num_of_inputs + 1 offsets into readers.
+  int *readers;            ///< Functions which read each network input.
+  uint8_t *marked;         ///< Input marked by rt_mark_input_changed().
+  uint64_t *hashes;        ///< Hash of each input in former run.
+  void **data;             ///< Data of inputs, then outputs, in former run.
+  uint8_t *dirty;          ///< Function runs in this run.
+  int valid;               ///< Former rt_forward() calculated all outputs.
+} result_cache_t;
+
+/// Parameters loaded before each function, set by rt_set_parameter_loader().
+typedef struct {
+  int *offsets;        ///< num_of_functions + 1 offsets into variables.
+  int *variables;      ///< Parameters read by each function.
+  size_t *positions;   ///< Position of each of them in staging buffer.
+  size_t *sources;     ///< Offset of each of them in network.
+  int *buffers;        ///< Staging buffer of each function, or -1.
+  int *next;           ///< Next function which has parameters.
+  uint8_t *staging[2]; ///< Staging buffers owned by context.
+  int resident[2];     ///< Function whose parameters are in each buffer.
+  int pending;         ///< Function whose parameters are being loaded.
+} parameter_staging_t;
+
+/// Plan given to and recorded by rt_set_plan_cache().
+typedef struct {
+  int enabled;           ///< Plan is recorded in initialization.
+  const uint32_t *given; ///< Plan to reuse, or NULL if it does not match.
+  size_t given_size;     ///< Size of given plan in byte.
+  uint32_t *recorded;    ///< Plan of this context owned by context.
+  size_t recorded_size;  ///< Size of recorded plan in byte.
+  int reused;            ///< Given plan was used by initialization.
+  uint64_t network_hash; ///< Hash of network and callbacks.
+} plan_cache_t;
+
+/// Kernels chosen by rt_set_kernel_tuning() or given by
+/// rt_set_kernel_choices().
+typedef struct {
+  int tuning;           ///< Time kernels in initialization.
+  const uint8_t *given; ///< Choices to use, or NULL.
+  int given_size;       ///< Number of functions in given.
+  uint8_t *chosen;      ///< Choices of this context owned by context.
+} kernel_choices_t;
+
+/// Events given to rt_set_trace().
+typedef struct {
+  rt_trace_event_t *events;
+  int capacity;
+  int num_of_events;         ///< Events taken by calls of rt_forward().
+  rt_trace_event_t *current; ///< Events of running call, or NULL.
+} function_trace_t;
+
+/// Hardware counters of each thread, set by rt_set_profile_counters().
+typedef struct {
+  int num_of_threads;
+  int *fds;     ///< RT_PROFILE_COUNTER_END descriptors of each thread, or -1.
+  long *owners; ///< Thread which opened descriptors of each thread, or 0.
+} profile_counters_t;
+
+typedef struct st_rt_context_t {
   int num_of_buffers;
   rt_variable_buffer_context_t *buffers;
 
@@ -49,10 +273,93 @@ typedef struct {
   int num_of_outputs;
   int *output_variable_ids;
 
+  rt_variable_buffer_context_t *input_bindings;
+  rt_variable_buffer_context_t *output_bindings;
+
   int num_of_callbacks;
   rt_function_callback_t *callbacks;
 
+  int num_of_backends;
+  rt_backend_t *backends; ///< Sorted by priority, higher first.
+
   nn_network_t *network;
+  size_t parameter_alignment; ///< Alignment of parameters in network.
+
+  int buffer_planning;
+  rt_huge_pages_t huge_pages;
+  void *variable_arena;
+  size_t variable_arena_size;
+  size_t variable_arena_mapped; ///< Size of mapping, see planned_malloc().
+
+  rt_context_arena_t arena;
+  rt_activation_arena_t activations;
+  rt_allocator_t allocator;          ///< Context data, or global if NULL.
+  rt_allocator_t variable_allocator; ///< Variable data, or global if NULL.
+  rt_static_block_t block;           ///< Memory of static context.
+  int *cpus; ///< CPUs of initialization and threads, or NULL.
+  int num_of_cpus;
+  int replicate_network;
+  nn_network_t *replica;       ///< Copy of network owned by context, or NULL.
+  nn_network_t *given_network; ///< Network which replica is copied from.
+  size_t allocated;         ///< Bytes allocated since initialization.
+  rt_memory_stats_t memory; ///< Sizes measured in initialization.
+  rt_init_profile_t init_profile; ///< Times measured in initialization.
+
+  int num_of_threads;
+  void *thread_pool;
+  rt_parallel_executor_t executor;
+  rt_request_queue_pointer async; ///< Thread of rt_forward_async().
+  uint64_t deadline;              ///< Time of profile clock to abort forward,
+                                  ///< or 0.
+  volatile int canceled;          ///< Running or next forward is aborted.
+  rt_cancellation_t cancellation; ///< Checks canceled and deadline.
+
+  int graph_execution;
+  function_graph_t *graph;
+
+  int graph_simplification;
+  uint8_t *removed_functions; ///< RT_FUNCTION_DEAD or FOLDED each, or NULL.
+  void **constants; ///< Outputs of folded functions owned by context, or NULL.
+
+  int function_fusion;
+  function_fusion_t *fusions;
+
+  size_t prepack_limit;    ///< Max bytes of weights packed by functions.
+  int fast_math;           ///< Functions are allocated in RT_MATH_MODE_FAST.
+  int recurrent_streaming; ///< RNN, LSTM and GRU keep state between runs.
+  int window_hop;          ///< Columns moved in streaming window, or 0.
+  streaming_window_t *window;
+  size_t tile_cache_size; ///< Bytes of bands of tiled group, or 0.
+  tiled_execution_t *tiles;
+  rt_result_caching_t result_caching;
+  result_cache_t *cache;
+
+  rt_parameter_loader_t loader;
+  parameter_staging_t *staging;
+
+  plan_cache_t plan_cache;
+  kernel_choices_t kernels;
+
+  struct st_rt_context_t *source; ///< Context whose parameters and weight
+                                  ///< copies are shared by clone, or NULL.
+  int num_of_clones;              ///< Clones sharing them, alive.
+  int freed;                      ///< Freed while clones are alive.
+  weight_copies_t weight_copies;
+
+  int batch_size;         ///< Batch size set by rt_reshape_input().
+  int network_batch_size; ///< Batch size in network.
+  int *reshaped_dims;     ///< Own shapes of variables with batch_size.
+  void *dense_variables;  ///< Expanded block sparse variables.
+  void *decompressed;     ///< Decompressed parameters.
+  void *quantizations;    ///< Per channel quantization of variables.
+
+  int profiling;
+  rt_function_profile_t *profile;
+  profile_counters_t *counters;
+  function_trace_t trace;
+  rt_function_hook_t pre_hook;
+  rt_function_hook_t post_hook;
+  void *hook_user_data;
 
 } rt_context_t;
 
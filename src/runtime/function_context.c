@@ -25,8 +25,9 @@
 
 #include "runtime_internal.h"
 
-void allocate_function_context(nn_network_t *n, nn_function_t *function,
-                               rt_function_context_t *function_context) {
+rt_function_error_t allocate_function_context(
+    nn_network_t *n, nn_function_t *function,
+    rt_function_context_t *function_context) {
   switch (function_context->info->type) {
 #ifdef CONFIG_AFFINE
   case NN_FUNCTION_AFFINE: { // Affine
@@ -34,10 +35,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_affine_t *f = (nn_function_affine_t *)function;
     affine_local_context_t *ctx =
         rt_malloc_func(sizeof(affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     function_context->func.local_context = ctx;
-    allocate_affine_local_context(&function_context->func);
-  } break;
+    return allocate_affine_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RNN
@@ -45,14 +49,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_rnn_local_context;
     nn_function_rnn_t *f = (nn_function_rnn_t *)function;
     rnn_local_context_t *ctx = rt_malloc_func(sizeof(rnn_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->num_layers = f->num_layers;
     ctx->nonlinearity = f->nonlinearity;
     ctx->dropout = f->dropout;
     ctx->bidirectional = f->bidirectional;
     ctx->training = f->training;
     function_context->func.local_context = ctx;
-    allocate_rnn_local_context(&function_context->func);
-  } break;
+    return allocate_rnn_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LSTM
@@ -60,13 +67,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_lstm_local_context;
     nn_function_lstm_t *f = (nn_function_lstm_t *)function;
     lstm_local_context_t *ctx = rt_malloc_func(sizeof(lstm_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->num_layers = f->num_layers;
     ctx->dropout = f->dropout;
     ctx->bidirectional = f->bidirectional;
     ctx->training = f->training;
     function_context->func.local_context = ctx;
-    allocate_lstm_local_context(&function_context->func);
-  } break;
+    return allocate_lstm_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GRU
@@ -74,13 +84,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_gru_local_context;
     nn_function_gru_t *f = (nn_function_gru_t *)function;
     gru_local_context_t *ctx = rt_malloc_func(sizeof(gru_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->num_layers = f->num_layers;
     ctx->dropout = f->dropout;
     ctx->bidirectional = f->bidirectional;
     ctx->training = f->training;
     function_context->func.local_context = ctx;
-    allocate_gru_local_context(&function_context->func);
-  } break;
+    return allocate_gru_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CONVOLUTION
@@ -90,6 +103,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_convolution_t *f = (nn_function_convolution_t *)function;
     convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -97,14 +113,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->channel_last = 0;
     function_context->func.local_context = ctx;
-    allocate_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_convolution_local_context(&function_context->func);
+  }
   case NN_FUNCTION_CONVOLUTION: { // Convolution
     function_context->func.free_local_context_func =
         free_convolution_local_context;
     nn_function_convolution_t *f = (nn_function_convolution_t *)function;
     convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -112,8 +131,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->channel_last = f->channel_last;
     function_context->func.local_context = ctx;
-    allocate_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_convolution_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_DEPTHWISECONVOLUTION
@@ -124,14 +143,18 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_depthwise_convolution_t *)function;
     depthwise_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(depthwise_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->dilation = create_rt_list_from_nn_list(n, f->dilation);
     ctx->multiplier = f->multiplier;
     function_context->func.local_context = ctx;
-    allocate_depthwise_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_depthwise_convolution_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_DECONVOLUTION
@@ -141,14 +164,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_deconvolution_t *f = (nn_function_deconvolution_t *)function;
     deconvolution_local_context_t *ctx =
         rt_malloc_func(sizeof(deconvolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->dilation = create_rt_list_from_nn_list(n, f->dilation);
     ctx->group = f->group;
     function_context->func.local_context = ctx;
-    allocate_deconvolution_local_context(&function_context->func);
-  } break;
+    return allocate_deconvolution_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_DEPTHWISEDECONVOLUTION
@@ -159,14 +185,18 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_depthwise_deconvolution_t *)function;
     depthwise_deconvolution_local_context_t *ctx =
         rt_malloc_func(sizeof(depthwise_deconvolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->dilation = create_rt_list_from_nn_list(n, f->dilation);
     ctx->divisor = f->divisor;
     function_context->func.local_context = ctx;
-    allocate_depthwise_deconvolution_local_context(&function_context->func);
-  } break;
+    return allocate_depthwise_deconvolution_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MAXPOOLING
@@ -176,28 +206,34 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_max_pooling_t *f = (nn_function_max_pooling_t *)function;
     max_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(max_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->channel_last = 0;
     function_context->func.local_context = ctx;
-    allocate_max_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_max_pooling_local_context(&function_context->func);
+  }
   case NN_FUNCTION_MAX_POOLING: { // MaxPooling
     function_context->func.free_local_context_func =
         free_max_pooling_local_context;
     nn_function_max_pooling_t *f = (nn_function_max_pooling_t *)function;
     max_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(max_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->channel_last = f->channel_last;
     function_context->func.local_context = ctx;
-    allocate_max_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_max_pooling_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_AVERAGEPOOLING
@@ -208,6 +244,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_average_pooling_t *)function;
     average_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(average_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
@@ -215,8 +254,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->channel_last = f->channel_last;
     ctx->including_pad = 1;
     function_context->func.local_context = ctx;
-    allocate_average_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_average_pooling_local_context(&function_context->func);
+  }
   case NN_FUNCTION_AVERAGE_POOLING: { // AveragePooling
     function_context->func.free_local_context_func =
         free_average_pooling_local_context;
@@ -224,6 +263,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_average_pooling_t *)function;
     average_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(average_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
@@ -231,8 +273,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->channel_last = f->channel_last;
     ctx->including_pad = f->including_pad;
     function_context->func.local_context = ctx;
-    allocate_average_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_average_pooling_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GLOBALAVERAGEPOOLING
@@ -240,8 +282,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_global_average_pooling_local_context;
     function_context->func.local_context = 0;
-    allocate_global_average_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_global_average_pooling_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SUMPOOLING
@@ -251,28 +294,34 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_sum_pooling_t *f = (nn_function_sum_pooling_t *)function;
     sum_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(sum_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->channel_last = 0;
     function_context->func.local_context = ctx;
-    allocate_sum_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_sum_pooling_local_context(&function_context->func);
+  }
   case NN_FUNCTION_SUM_POOLING: { // SumPooling
     function_context->func.free_local_context_func =
         free_sum_pooling_local_context;
     nn_function_sum_pooling_t *f = (nn_function_sum_pooling_t *)function;
     sum_pooling_local_context_t *ctx =
         rt_malloc_func(sizeof(sum_pooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->channel_last = f->channel_last;
     function_context->func.local_context = ctx;
-    allocate_sum_pooling_local_context(&function_context->func);
-  } break;
+    return allocate_sum_pooling_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_UNPOOLING
@@ -282,42 +331,45 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_unpooling_t *f = (nn_function_unpooling_t *)function;
     unpooling_local_context_t *ctx =
         rt_malloc_func(sizeof(unpooling_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     function_context->func.local_context = ctx;
-    allocate_unpooling_local_context(&function_context->func);
-  } break;
+    return allocate_unpooling_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_EMBED
   case NN_FUNCTION_EMBED: { // Embed
     function_context->func.free_local_context_func = free_embed_local_context;
     function_context->func.local_context = 0;
-    allocate_embed_local_context(&function_context->func);
-  } break;
+    return allocate_embed_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SIGMOID
   case NN_FUNCTION_SIGMOID: { // Sigmoid
     function_context->func.free_local_context_func = free_sigmoid_local_context;
     function_context->func.local_context = 0;
-    allocate_sigmoid_local_context(&function_context->func);
-  } break;
+    return allocate_sigmoid_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SWISH
   case NN_FUNCTION_SWISH: { // Swish
     function_context->func.free_local_context_func = free_swish_local_context;
     function_context->func.local_context = 0;
-    allocate_swish_local_context(&function_context->func);
-  } break;
+    return allocate_swish_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TANH
   case NN_FUNCTION_TANH: { // Tanh
     function_context->func.free_local_context_func = free_tanh_local_context;
     function_context->func.local_context = 0;
-    allocate_tanh_local_context(&function_context->func);
-  } break;
+    return allocate_tanh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RELU
@@ -325,10 +377,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_relu_local_context;
     nn_function_relu_t *f = (nn_function_relu_t *)function;
     relu_local_context_t *ctx = rt_malloc_func(sizeof(relu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->inplace = f->inplace;
     function_context->func.local_context = ctx;
-    allocate_relu_local_context(&function_context->func);
-  } break;
+    return allocate_relu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LEAKYRELU
@@ -338,22 +393,28 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_leaky_relu_t *f = (nn_function_leaky_relu_t *)function;
     leaky_relu_local_context_t *ctx =
         rt_malloc_func(sizeof(leaky_relu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->alpha = f->alpha;
     ctx->inplace = 0;
     function_context->func.local_context = ctx;
-    allocate_leaky_relu_local_context(&function_context->func);
-  } break;
+    return allocate_leaky_relu_local_context(&function_context->func);
+  }
   case NN_FUNCTION_LEAKY_RELU: { // LeakyReLU
     function_context->func.free_local_context_func =
         free_leaky_relu_local_context;
     nn_function_leaky_relu_t *f = (nn_function_leaky_relu_t *)function;
     leaky_relu_local_context_t *ctx =
         rt_malloc_func(sizeof(leaky_relu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->alpha = f->alpha;
     ctx->inplace = f->inplace;
     function_context->func.local_context = ctx;
-    allocate_leaky_relu_local_context(&function_context->func);
-  } break;
+    return allocate_leaky_relu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SOFTMAX
@@ -362,10 +423,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_softmax_t *f = (nn_function_softmax_t *)function;
     softmax_local_context_t *ctx =
         rt_malloc_func(sizeof(softmax_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_softmax_local_context(&function_context->func);
-  } break;
+    return allocate_softmax_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGSOFTMAX
@@ -375,10 +439,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_log_softmax_t *f = (nn_function_log_softmax_t *)function;
     log_softmax_local_context_t *ctx =
         rt_malloc_func(sizeof(log_softmax_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_log_softmax_local_context(&function_context->func);
-  } break;
+    return allocate_log_softmax_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ELU
@@ -386,10 +453,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_elu_local_context;
     nn_function_elu_t *f = (nn_function_elu_t *)function;
     elu_local_context_t *ctx = rt_malloc_func(sizeof(elu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->alpha = f->alpha;
     function_context->func.local_context = ctx;
-    allocate_elu_local_context(&function_context->func);
-  } break;
+    return allocate_elu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SELU
@@ -397,11 +467,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_selu_local_context;
     nn_function_selu_t *f = (nn_function_selu_t *)function;
     selu_local_context_t *ctx = rt_malloc_func(sizeof(selu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->scale = f->scale;
     ctx->alpha = f->alpha;
     function_context->func.local_context = ctx;
-    allocate_selu_local_context(&function_context->func);
-  } break;
+    return allocate_selu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CRELU
@@ -409,10 +482,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_crelu_local_context;
     nn_function_crelu_t *f = (nn_function_crelu_t *)function;
     crelu_local_context_t *ctx = rt_malloc_func(sizeof(crelu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_crelu_local_context(&function_context->func);
-  } break;
+    return allocate_crelu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CELU
@@ -420,11 +496,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_celu_local_context;
     nn_function_celu_t *f = (nn_function_celu_t *)function;
     celu_local_context_t *ctx = rt_malloc_func(sizeof(celu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->alpha = f->alpha;
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_celu_local_context(&function_context->func);
-  } break;
+    return allocate_celu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_PRELU
@@ -432,26 +511,29 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_prelu_local_context;
     nn_function_prelu_t *f = (nn_function_prelu_t *)function;
     prelu_local_context_t *ctx = rt_malloc_func(sizeof(prelu_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     function_context->func.local_context = ctx;
-    allocate_prelu_local_context(&function_context->func);
-  } break;
+    return allocate_prelu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GELU
   case NN_FUNCTION_GELU: { // GELU
     function_context->func.free_local_context_func = free_gelu_local_context;
     function_context->func.local_context = 0;
-    allocate_gelu_local_context(&function_context->func);
-  } break;
+    return allocate_gelu_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RELU6
   case NN_FUNCTION_RELU6: { // ReLU6
     function_context->func.free_local_context_func = free_relu6_local_context;
     function_context->func.local_context = 0;
-    allocate_relu6_local_context(&function_context->func);
-  } break;
+    return allocate_relu6_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_HARDSIGMOID
@@ -459,14 +541,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_hard_sigmoid_local_context;
     function_context->func.local_context = 0;
-    allocate_hard_sigmoid_local_context(&function_context->func);
-  } break;
+    return allocate_hard_sigmoid_local_context(&function_context->func);
+  }
   case NN_FUNCTION_HARD_SIGMOID: { // HardSigmoid
     function_context->func.free_local_context_func =
         free_hard_sigmoid_local_context;
     function_context->func.local_context = 0;
-    allocate_hard_sigmoid_local_context(&function_context->func);
-  } break;
+    return allocate_hard_sigmoid_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_HARDTANH
@@ -474,8 +556,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_hard_tanh_local_context;
     function_context->func.local_context = 0;
-    allocate_hard_tanh_local_context(&function_context->func);
-  } break;
+    return allocate_hard_tanh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGSIGMOID
@@ -483,8 +565,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_log_sigmoid_local_context;
     function_context->func.local_context = 0;
-    allocate_log_sigmoid_local_context(&function_context->func);
-  } break;
+    return allocate_log_sigmoid_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SOFTPLUS
@@ -492,8 +574,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_softplus_local_context;
     function_context->func.local_context = 0;
-    allocate_softplus_local_context(&function_context->func);
-  } break;
+    return allocate_softplus_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SOFTSIGN
@@ -501,8 +583,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_softsign_local_context;
     function_context->func.local_context = 0;
-    allocate_softsign_local_context(&function_context->func);
-  } break;
+    return allocate_softsign_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TANHSHRINK
@@ -510,16 +592,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_tanh_shrink_local_context;
     function_context->func.local_context = 0;
-    allocate_tanh_shrink_local_context(&function_context->func);
-  } break;
+    return allocate_tanh_shrink_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SINC
   case NN_FUNCTION_SINC: { // Sinc
     function_context->func.free_local_context_func = free_sinc_local_context;
     function_context->func.local_context = 0;
-    allocate_sinc_local_context(&function_context->func);
-  } break;
+    return allocate_sinc_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_FUSEDBATCHNORMALIZATION
@@ -530,14 +612,18 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_fused_batch_normalization_t *)function;
     fused_batch_normalization_local_context_t *ctx =
         rt_malloc_func(sizeof(fused_batch_normalization_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->decay_rate = f->decay_rate;
     ctx->eps = f->eps;
     ctx->batch_stat = f->batch_stat;
     ctx->nonlinearity = f->nonlinearity;
     function_context->func.local_context = ctx;
-    allocate_fused_batch_normalization_local_context(&function_context->func);
-  } break;
+    return allocate_fused_batch_normalization_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BATCHNORMALIZATION
@@ -548,13 +634,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_batch_normalization_t *)function;
     batch_normalization_local_context_t *ctx =
         rt_malloc_func(sizeof(batch_normalization_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->decay_rate = f->decay_rate;
     ctx->eps = f->eps;
     ctx->batch_stat = f->batch_stat;
     function_context->func.local_context = ctx;
-    allocate_batch_normalization_local_context(&function_context->func);
-  } break;
+    return allocate_batch_normalization_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SYNCBATCHNORMALIZATION
@@ -565,14 +654,18 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_sync_batch_normalization_t *)function;
     sync_batch_normalization_local_context_t *ctx =
         rt_malloc_func(sizeof(sync_batch_normalization_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->group = f->group;
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->decay_rate = f->decay_rate;
     ctx->eps = f->eps;
     ctx->batch_stat = f->batch_stat;
     function_context->func.local_context = ctx;
-    allocate_sync_batch_normalization_local_context(&function_context->func);
-  } break;
+    return allocate_sync_batch_normalization_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MEANSUBTRACTION
@@ -583,11 +676,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_mean_subtraction_t *)function;
     mean_subtraction_local_context_t *ctx =
         rt_malloc_func(sizeof(mean_subtraction_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->update_running_mean = f->update_running_mean;
     function_context->func.local_context = ctx;
-    allocate_mean_subtraction_local_context(&function_context->func);
-  } break;
+    return allocate_mean_subtraction_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CLIPGRADBYVALUE
@@ -595,8 +691,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_clip_grad_by_value_local_context;
     function_context->func.local_context = 0;
-    allocate_clip_grad_by_value_local_context(&function_context->func);
-  } break;
+    return allocate_clip_grad_by_value_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CLIPGRADBYNORM
@@ -607,11 +703,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_clip_grad_by_norm_t *)function;
     clip_grad_by_norm_local_context_t *ctx =
         rt_malloc_func(sizeof(clip_grad_by_norm_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->clip_norm = f->clip_norm;
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     function_context->func.local_context = ctx;
-    allocate_clip_grad_by_norm_local_context(&function_context->func);
-  } break;
+    return allocate_clip_grad_by_norm_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SUM
@@ -619,11 +718,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_sum_local_context;
     nn_function_sum_t *f = (nn_function_sum_t *)function;
     sum_local_context_t *ctx = rt_malloc_func(sizeof(sum_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     function_context->func.local_context = ctx;
-    allocate_sum_local_context(&function_context->func);
-  } break;
+    return allocate_sum_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MEAN
@@ -631,11 +733,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_mean_local_context;
     nn_function_mean_t *f = (nn_function_mean_t *)function;
     mean_local_context_t *ctx = rt_malloc_func(sizeof(mean_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     function_context->func.local_context = ctx;
-    allocate_mean_local_context(&function_context->func);
-  } break;
+    return allocate_mean_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MAX
@@ -643,24 +748,30 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_max_local_context;
     nn_function_max_t *f = (nn_function_max_t *)function;
     max_local_context_t *ctx = rt_malloc_func(sizeof(max_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     ctx->with_index = 0;
     ctx->only_index = 0;
     function_context->func.local_context = ctx;
-    allocate_max_local_context(&function_context->func);
-  } break;
+    return allocate_max_local_context(&function_context->func);
+  }
   case NN_FUNCTION_MAX: { // Max
     function_context->func.free_local_context_func = free_max_local_context;
     nn_function_max_t *f = (nn_function_max_t *)function;
     max_local_context_t *ctx = rt_malloc_func(sizeof(max_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     ctx->with_index = f->with_index;
     ctx->only_index = f->only_index;
     function_context->func.local_context = ctx;
-    allocate_max_local_context(&function_context->func);
-  } break;
+    return allocate_max_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MIN
@@ -668,24 +779,30 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_min_local_context;
     nn_function_min_t *f = (nn_function_min_t *)function;
     min_local_context_t *ctx = rt_malloc_func(sizeof(min_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     ctx->with_index = 0;
     ctx->only_index = 0;
     function_context->func.local_context = ctx;
-    allocate_min_local_context(&function_context->func);
-  } break;
+    return allocate_min_local_context(&function_context->func);
+  }
   case NN_FUNCTION_MIN: { // Min
     function_context->func.free_local_context_func = free_min_local_context;
     nn_function_min_t *f = (nn_function_min_t *)function;
     min_local_context_t *ctx = rt_malloc_func(sizeof(min_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     ctx->with_index = f->with_index;
     ctx->only_index = f->only_index;
     function_context->func.local_context = ctx;
-    allocate_min_local_context(&function_context->func);
-  } break;
+    return allocate_min_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_PROD
@@ -693,11 +810,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_prod_local_context;
     nn_function_prod_t *f = (nn_function_prod_t *)function;
     prod_local_context_t *ctx = rt_malloc_func(sizeof(prod_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->keep_dims = f->keep_dims;
     function_context->func.local_context = ctx;
-    allocate_prod_local_context(&function_context->func);
-  } break;
+    return allocate_prod_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_REDUCESUM
@@ -705,8 +825,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_reduce_sum_local_context;
     function_context->func.local_context = 0;
-    allocate_reduce_sum_local_context(&function_context->func);
-  } break;
+    return allocate_reduce_sum_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_REDUCEMEAN
@@ -714,8 +834,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_reduce_mean_local_context;
     function_context->func.local_context = 0;
-    allocate_reduce_mean_local_context(&function_context->func);
-  } break;
+    return allocate_reduce_mean_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ADD2
@@ -723,50 +843,53 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_add2_local_context;
     nn_function_add2_t *f = (nn_function_add2_t *)function;
     add2_local_context_t *ctx = rt_malloc_func(sizeof(add2_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->inplace = f->inplace;
     function_context->func.local_context = ctx;
-    allocate_add2_local_context(&function_context->func);
-  } break;
+    return allocate_add2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BCADD2
   case NN_FUNCTION_BC_ADD2: { // BcAdd2
     function_context->func.free_local_context_func = free_bc_add2_local_context;
     function_context->func.local_context = 0;
-    allocate_bc_add2_local_context(&function_context->func);
-  } break;
+    return allocate_bc_add2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SUB2
   case NN_FUNCTION_SUB2: { // Sub2
     function_context->func.free_local_context_func = free_sub2_local_context;
     function_context->func.local_context = 0;
-    allocate_sub2_local_context(&function_context->func);
-  } break;
+    return allocate_sub2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MUL2
   case NN_FUNCTION_MUL2: { // Mul2
     function_context->func.free_local_context_func = free_mul2_local_context;
     function_context->func.local_context = 0;
-    allocate_mul2_local_context(&function_context->func);
-  } break;
+    return allocate_mul2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_DIV2
   case NN_FUNCTION_DIV2: { // Div2
     function_context->func.free_local_context_func = free_div2_local_context;
     function_context->func.local_context = 0;
-    allocate_div2_local_context(&function_context->func);
-  } break;
+    return allocate_div2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_POW2
   case NN_FUNCTION_POW2: { // Pow2
     function_context->func.free_local_context_func = free_pow2_local_context;
     function_context->func.local_context = 0;
-    allocate_pow2_local_context(&function_context->func);
-  } break;
+    return allocate_pow2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ADDSCALAR
@@ -776,10 +899,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_add_scalar_t *f = (nn_function_add_scalar_t *)function;
     add_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(add_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_add_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_add_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MULSCALAR
@@ -789,10 +915,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_mul_scalar_t *f = (nn_function_mul_scalar_t *)function;
     mul_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(mul_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_mul_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_mul_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_POWSCALAR
@@ -802,10 +931,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_pow_scalar_t *f = (nn_function_pow_scalar_t *)function;
     pow_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(pow_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_pow_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_pow_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RSUBSCALAR
@@ -815,10 +947,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_r_sub_scalar_t *f = (nn_function_r_sub_scalar_t *)function;
     r_sub_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(r_sub_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_r_sub_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_r_sub_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RDIVSCALAR
@@ -828,10 +963,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_r_div_scalar_t *f = (nn_function_r_div_scalar_t *)function;
     r_div_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(r_div_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_r_div_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_r_div_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RPOWSCALAR
@@ -841,10 +979,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_r_pow_scalar_t *f = (nn_function_r_pow_scalar_t *)function;
     r_pow_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(r_pow_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_r_pow_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_r_pow_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SIGN
@@ -852,10 +993,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_sign_local_context;
     nn_function_sign_t *f = (nn_function_sign_t *)function;
     sign_local_context_t *ctx = rt_malloc_func(sizeof(sign_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->alpha = f->alpha;
     function_context->func.local_context = ctx;
-    allocate_sign_local_context(&function_context->func);
-  } break;
+    return allocate_sign_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MINIMUM2
@@ -863,8 +1007,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_minimum2_local_context;
     function_context->func.local_context = 0;
-    allocate_minimum2_local_context(&function_context->func);
-  } break;
+    return allocate_minimum2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MAXIMUM2
@@ -872,8 +1016,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_maximum2_local_context;
     function_context->func.local_context = 0;
-    allocate_maximum2_local_context(&function_context->func);
-  } break;
+    return allocate_maximum2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MINIMUMSCALAR
@@ -883,10 +1027,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_minimum_scalar_t *f = (nn_function_minimum_scalar_t *)function;
     minimum_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(minimum_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_minimum_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_minimum_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MAXIMUMSCALAR
@@ -896,10 +1043,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_maximum_scalar_t *f = (nn_function_maximum_scalar_t *)function;
     maximum_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(maximum_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_maximum_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_maximum_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALAND
@@ -907,8 +1057,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_logical_and_local_context;
     function_context->func.local_context = 0;
-    allocate_logical_and_local_context(&function_context->func);
-  } break;
+    return allocate_logical_and_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALOR
@@ -916,8 +1066,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_logical_or_local_context;
     function_context->func.local_context = 0;
-    allocate_logical_or_local_context(&function_context->func);
-  } break;
+    return allocate_logical_or_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALXOR
@@ -925,16 +1075,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_logical_xor_local_context;
     function_context->func.local_context = 0;
-    allocate_logical_xor_local_context(&function_context->func);
-  } break;
+    return allocate_logical_xor_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_EQUAL
   case NN_FUNCTION_EQUAL: { // Equal
     function_context->func.free_local_context_func = free_equal_local_context;
     function_context->func.local_context = 0;
-    allocate_equal_local_context(&function_context->func);
-  } break;
+    return allocate_equal_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_NOTEQUAL
@@ -942,8 +1092,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_not_equal_local_context;
     function_context->func.local_context = 0;
-    allocate_not_equal_local_context(&function_context->func);
-  } break;
+    return allocate_not_equal_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GREATEREQUAL
@@ -951,16 +1101,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_greater_equal_local_context;
     function_context->func.local_context = 0;
-    allocate_greater_equal_local_context(&function_context->func);
-  } break;
+    return allocate_greater_equal_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GREATER
   case NN_FUNCTION_GREATER: { // Greater
     function_context->func.free_local_context_func = free_greater_local_context;
     function_context->func.local_context = 0;
-    allocate_greater_local_context(&function_context->func);
-  } break;
+    return allocate_greater_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LESSEQUAL
@@ -968,16 +1118,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_less_equal_local_context;
     function_context->func.local_context = 0;
-    allocate_less_equal_local_context(&function_context->func);
-  } break;
+    return allocate_less_equal_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LESS
   case NN_FUNCTION_LESS: { // Less
     function_context->func.free_local_context_func = free_less_local_context;
     function_context->func.local_context = 0;
-    allocate_less_local_context(&function_context->func);
-  } break;
+    return allocate_less_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALANDSCALAR
@@ -988,10 +1138,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_logical_and_scalar_t *)function;
     logical_and_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(logical_and_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_logical_and_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_logical_and_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALORSCALAR
@@ -1002,10 +1155,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_logical_or_scalar_t *)function;
     logical_or_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(logical_or_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_logical_or_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_logical_or_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALXORSCALAR
@@ -1016,10 +1172,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_logical_xor_scalar_t *)function;
     logical_xor_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(logical_xor_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_logical_xor_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_logical_xor_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_EQUALSCALAR
@@ -1029,10 +1188,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_equal_scalar_t *f = (nn_function_equal_scalar_t *)function;
     equal_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(equal_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_equal_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_equal_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_NOTEQUALSCALAR
@@ -1043,10 +1205,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_not_equal_scalar_t *)function;
     not_equal_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(not_equal_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_not_equal_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_not_equal_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GREATEREQUALSCALAR
@@ -1057,10 +1222,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_greater_equal_scalar_t *)function;
     greater_equal_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(greater_equal_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_greater_equal_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_greater_equal_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GREATERSCALAR
@@ -1070,10 +1238,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_greater_scalar_t *f = (nn_function_greater_scalar_t *)function;
     greater_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(greater_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_greater_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_greater_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LESSEQUALSCALAR
@@ -1084,10 +1255,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_less_equal_scalar_t *)function;
     less_equal_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(less_equal_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_less_equal_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_less_equal_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LESSSCALAR
@@ -1097,10 +1271,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_less_scalar_t *f = (nn_function_less_scalar_t *)function;
     less_scalar_local_context_t *ctx =
         rt_malloc_func(sizeof(less_scalar_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_less_scalar_local_context(&function_context->func);
-  } break;
+    return allocate_less_scalar_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOGICALNOT
@@ -1108,24 +1285,24 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_logical_not_local_context;
     function_context->func.local_context = 0;
-    allocate_logical_not_local_context(&function_context->func);
-  } break;
+    return allocate_logical_not_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ISNAN
   case NN_FUNCTION_ISNAN: { // IsNaN
     function_context->func.free_local_context_func = free_isnan_local_context;
     function_context->func.local_context = 0;
-    allocate_isnan_local_context(&function_context->func);
-  } break;
+    return allocate_isnan_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ISINF
   case NN_FUNCTION_ISINF: { // IsInf
     function_context->func.free_local_context_func = free_isinf_local_context;
     function_context->func.local_context = 0;
-    allocate_isinf_local_context(&function_context->func);
-  } break;
+    return allocate_isinf_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RESETNAN
@@ -1135,10 +1312,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_reset_nan_t *f = (nn_function_reset_nan_t *)function;
     reset_nan_local_context_t *ctx =
         rt_malloc_func(sizeof(reset_nan_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_reset_nan_local_context(&function_context->func);
-  } break;
+    return allocate_reset_nan_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RESETINF
@@ -1148,18 +1328,21 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_reset_inf_t *f = (nn_function_reset_inf_t *)function;
     reset_inf_local_context_t *ctx =
         rt_malloc_func(sizeof(reset_inf_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     function_context->func.local_context = ctx;
-    allocate_reset_inf_local_context(&function_context->func);
-  } break;
+    return allocate_reset_inf_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_WHERE
   case NN_FUNCTION_WHERE: { // Where
     function_context->func.free_local_context_func = free_where_local_context;
     function_context->func.local_context = 0;
-    allocate_where_local_context(&function_context->func);
-  } break;
+    return allocate_where_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CONSTANT
@@ -1169,11 +1352,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_constant_t *f = (nn_function_constant_t *)function;
     constant_local_context_t *ctx =
         rt_malloc_func(sizeof(constant_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->val = f->val;
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     function_context->func.local_context = ctx;
-    allocate_constant_local_context(&function_context->func);
-  } break;
+    return allocate_constant_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ARANGE
@@ -1182,36 +1368,39 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_arange_t *f = (nn_function_arange_t *)function;
     arange_local_context_t *ctx =
         rt_malloc_func(sizeof(arange_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->start = f->start;
     ctx->stop = f->stop;
     ctx->step = f->step;
     function_context->func.local_context = ctx;
-    allocate_arange_local_context(&function_context->func);
-  } break;
+    return allocate_arange_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ABS
   case NN_FUNCTION_ABS: { // Abs
     function_context->func.free_local_context_func = free_abs_local_context;
     function_context->func.local_context = 0;
-    allocate_abs_local_context(&function_context->func);
-  } break;
+    return allocate_abs_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_EXP
   case NN_FUNCTION_EXP: { // Exp
     function_context->func.free_local_context_func = free_exp_local_context;
     function_context->func.local_context = 0;
-    allocate_exp_local_context(&function_context->func);
-  } break;
+    return allocate_exp_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_LOG
   case NN_FUNCTION_LOG: { // Log
     function_context->func.free_local_context_func = free_log_local_context;
     function_context->func.local_context = 0;
-    allocate_log_local_context(&function_context->func);
-  } break;
+    return allocate_log_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_IDENTITY
@@ -1219,8 +1408,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_identity_local_context;
     function_context->func.local_context = 0;
-    allocate_identity_local_context(&function_context->func);
-  } break;
+    return allocate_identity_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BATCHMATMUL
@@ -1230,131 +1419,134 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_batch_matmul_t *f = (nn_function_batch_matmul_t *)function;
     batch_matmul_local_context_t *ctx =
         rt_malloc_func(sizeof(batch_matmul_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->transpose_a = f->transpose_a;
     ctx->transpose_b = f->transpose_b;
     function_context->func.local_context = ctx;
-    allocate_batch_matmul_local_context(&function_context->func);
-  } break;
+    return allocate_batch_matmul_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ROUND
   case NN_FUNCTION_ROUND: { // Round
     function_context->func.free_local_context_func = free_round_local_context;
     function_context->func.local_context = 0;
-    allocate_round_local_context(&function_context->func);
-  } break;
+    return allocate_round_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CEIL
   case NN_FUNCTION_CEIL: { // Ceil
     function_context->func.free_local_context_func = free_ceil_local_context;
     function_context->func.local_context = 0;
-    allocate_ceil_local_context(&function_context->func);
-  } break;
+    return allocate_ceil_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_FLOOR
   case NN_FUNCTION_FLOOR: { // Floor
     function_context->func.free_local_context_func = free_floor_local_context;
     function_context->func.local_context = 0;
-    allocate_floor_local_context(&function_context->func);
-  } break;
+    return allocate_floor_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SIN
   case NN_FUNCTION_SIN: { // Sin
     function_context->func.free_local_context_func = free_sin_local_context;
     function_context->func.local_context = 0;
-    allocate_sin_local_context(&function_context->func);
-  } break;
+    return allocate_sin_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_COS
   case NN_FUNCTION_COS: { // Cos
     function_context->func.free_local_context_func = free_cos_local_context;
     function_context->func.local_context = 0;
-    allocate_cos_local_context(&function_context->func);
-  } break;
+    return allocate_cos_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TAN
   case NN_FUNCTION_TAN: { // Tan
     function_context->func.free_local_context_func = free_tan_local_context;
     function_context->func.local_context = 0;
-    allocate_tan_local_context(&function_context->func);
-  } break;
+    return allocate_tan_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SINH
   case NN_FUNCTION_SINH: { // Sinh
     function_context->func.free_local_context_func = free_sinh_local_context;
     function_context->func.local_context = 0;
-    allocate_sinh_local_context(&function_context->func);
-  } break;
+    return allocate_sinh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_COSH
   case NN_FUNCTION_COSH: { // Cosh
     function_context->func.free_local_context_func = free_cosh_local_context;
     function_context->func.local_context = 0;
-    allocate_cosh_local_context(&function_context->func);
-  } break;
+    return allocate_cosh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ASIN
   case NN_FUNCTION_ASIN: { // ASin
     function_context->func.free_local_context_func = free_asin_local_context;
     function_context->func.local_context = 0;
-    allocate_asin_local_context(&function_context->func);
-  } break;
+    return allocate_asin_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ACOS
   case NN_FUNCTION_ACOS: { // ACos
     function_context->func.free_local_context_func = free_acos_local_context;
     function_context->func.local_context = 0;
-    allocate_acos_local_context(&function_context->func);
-  } break;
+    return allocate_acos_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ATAN
   case NN_FUNCTION_ATAN: { // ATan
     function_context->func.free_local_context_func = free_atan_local_context;
     function_context->func.local_context = 0;
-    allocate_atan_local_context(&function_context->func);
-  } break;
+    return allocate_atan_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ATAN2
   case NN_FUNCTION_ATAN2: { // ATan2
     function_context->func.free_local_context_func = free_atan2_local_context;
     function_context->func.local_context = 0;
-    allocate_atan2_local_context(&function_context->func);
-  } break;
+    return allocate_atan2_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ASINH
   case NN_FUNCTION_ASINH: { // ASinh
     function_context->func.free_local_context_func = free_asinh_local_context;
     function_context->func.local_context = 0;
-    allocate_asinh_local_context(&function_context->func);
-  } break;
+    return allocate_asinh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ACOSH
   case NN_FUNCTION_ACOSH: { // ACosh
     function_context->func.free_local_context_func = free_acosh_local_context;
     function_context->func.local_context = 0;
-    allocate_acosh_local_context(&function_context->func);
-  } break;
+    return allocate_acosh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ATANH
   case NN_FUNCTION_ATANH: { // ATanh
     function_context->func.free_local_context_func = free_atanh_local_context;
     function_context->func.local_context = 0;
-    allocate_atanh_local_context(&function_context->func);
-  } break;
+    return allocate_atanh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CONCATENATE
@@ -1364,10 +1556,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_concatenate_t *f = (nn_function_concatenate_t *)function;
     concatenate_local_context_t *ctx =
         rt_malloc_func(sizeof(concatenate_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_concatenate_local_context(&function_context->func);
-  } break;
+    return allocate_concatenate_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SPLIT
@@ -1375,10 +1570,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_split_local_context;
     nn_function_split_t *f = (nn_function_split_t *)function;
     split_local_context_t *ctx = rt_malloc_func(sizeof(split_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_split_local_context(&function_context->func);
-  } break;
+    return allocate_split_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_STACK
@@ -1386,10 +1584,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_stack_local_context;
     nn_function_stack_t *f = (nn_function_stack_t *)function;
     stack_local_context_t *ctx = rt_malloc_func(sizeof(stack_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_stack_local_context(&function_context->func);
-  } break;
+    return allocate_stack_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SLICE
@@ -1397,12 +1598,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_slice_local_context;
     nn_function_slice_t *f = (nn_function_slice_t *)function;
     slice_local_context_t *ctx = rt_malloc_func(sizeof(slice_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->start = create_rt_list_from_nn_list(n, f->start);
     ctx->stop = create_rt_list_from_nn_list(n, f->stop);
     ctx->step = create_rt_list_from_nn_list(n, f->step);
     function_context->func.local_context = ctx;
-    allocate_slice_local_context(&function_context->func);
-  } break;
+    return allocate_slice_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_PAD
@@ -1410,12 +1614,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_pad_local_context;
     nn_function_pad_t *f = (nn_function_pad_t *)function;
     pad_local_context_t *ctx = rt_malloc_func(sizeof(pad_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->pad_width = create_rt_list_from_nn_list(n, f->pad_width);
     ctx->mode = f->mode;
     ctx->constant_value = f->constant_value;
     function_context->func.local_context = ctx;
-    allocate_pad_local_context(&function_context->func);
-  } break;
+    return allocate_pad_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TRANSPOSE
@@ -1425,10 +1632,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_transpose_t *f = (nn_function_transpose_t *)function;
     transpose_local_context_t *ctx =
         rt_malloc_func(sizeof(transpose_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     function_context->func.local_context = ctx;
-    allocate_transpose_local_context(&function_context->func);
-  } break;
+    return allocate_transpose_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BROADCAST
@@ -1438,10 +1648,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_broadcast_t *f = (nn_function_broadcast_t *)function;
     broadcast_local_context_t *ctx =
         rt_malloc_func(sizeof(broadcast_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     function_context->func.local_context = ctx;
-    allocate_broadcast_local_context(&function_context->func);
-  } break;
+    return allocate_broadcast_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BROADCASTTO
@@ -1451,10 +1664,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_broadcast_to_t *f = (nn_function_broadcast_to_t *)function;
     broadcast_to_local_context_t *ctx =
         rt_malloc_func(sizeof(broadcast_to_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_broadcast_to_local_context(&function_context->func);
-  } break;
+    return allocate_broadcast_to_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TILE
@@ -1462,10 +1678,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_tile_local_context;
     nn_function_tile_t *f = (nn_function_tile_t *)function;
     tile_local_context_t *ctx = rt_malloc_func(sizeof(tile_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->reps = create_rt_list_from_nn_list(n, f->reps);
     function_context->func.local_context = ctx;
-    allocate_tile_local_context(&function_context->func);
-  } break;
+    return allocate_tile_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ONEHOT
@@ -1474,10 +1693,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_one_hot_t *f = (nn_function_one_hot_t *)function;
     one_hot_local_context_t *ctx =
         rt_malloc_func(sizeof(one_hot_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     function_context->func.local_context = ctx;
-    allocate_one_hot_local_context(&function_context->func);
-  } break;
+    return allocate_one_hot_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_FLIP
@@ -1485,10 +1707,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_flip_local_context;
     nn_function_flip_t *f = (nn_function_flip_t *)function;
     flip_local_context_t *ctx = rt_malloc_func(sizeof(flip_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     function_context->func.local_context = ctx;
-    allocate_flip_local_context(&function_context->func);
-  } break;
+    return allocate_flip_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SHIFT
@@ -1496,11 +1721,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_shift_local_context;
     nn_function_shift_t *f = (nn_function_shift_t *)function;
     shift_local_context_t *ctx = rt_malloc_func(sizeof(shift_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shifts = create_rt_list_from_nn_list(n, f->shifts);
     ctx->border_mode = f->border_mode;
     function_context->func.local_context = ctx;
-    allocate_shift_local_context(&function_context->func);
-  } break;
+    return allocate_shift_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SORT
@@ -1508,13 +1736,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_sort_local_context;
     nn_function_sort_t *f = (nn_function_sort_t *)function;
     sort_local_context_t *ctx = rt_malloc_func(sizeof(sort_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     ctx->reverse = f->reverse;
     ctx->with_index = f->with_index;
     ctx->only_index = f->only_index;
     function_context->func.local_context = ctx;
-    allocate_sort_local_context(&function_context->func);
-  } break;
+    return allocate_sort_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RESHAPE
@@ -1523,21 +1754,27 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_reshape_t *f = (nn_function_reshape_t *)function;
     reshape_local_context_t *ctx =
         rt_malloc_func(sizeof(reshape_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->inplace = 1;
     function_context->func.local_context = ctx;
-    allocate_reshape_local_context(&function_context->func);
-  } break;
+    return allocate_reshape_local_context(&function_context->func);
+  }
   case NN_FUNCTION_RESHAPE: { // Reshape
     function_context->func.free_local_context_func = free_reshape_local_context;
     nn_function_reshape_t *f = (nn_function_reshape_t *)function;
     reshape_local_context_t *ctx =
         rt_malloc_func(sizeof(reshape_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->inplace = f->inplace;
     function_context->func.local_context = ctx;
-    allocate_reshape_local_context(&function_context->func);
-  } break;
+    return allocate_reshape_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MATRIXDIAG
@@ -1545,8 +1782,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_matrix_diag_local_context;
     function_context->func.local_context = 0;
-    allocate_matrix_diag_local_context(&function_context->func);
-  } break;
+    return allocate_matrix_diag_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MATRIXDIAGPART
@@ -1554,8 +1791,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_matrix_diag_part_local_context;
     function_context->func.local_context = 0;
-    allocate_matrix_diag_part_local_context(&function_context->func);
-  } break;
+    return allocate_matrix_diag_part_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BATCHINV
@@ -1563,8 +1800,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_batch_inv_local_context;
     function_context->func.local_context = 0;
-    allocate_batch_inv_local_context(&function_context->func);
-  } break;
+    return allocate_batch_inv_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BATCHDET
@@ -1572,16 +1809,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_batch_det_local_context;
     function_context->func.local_context = 0;
-    allocate_batch_det_local_context(&function_context->func);
-  } break;
+    return allocate_batch_det_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ASSIGN
   case NN_FUNCTION_ASSIGN: { // Assign
     function_context->func.free_local_context_func = free_assign_local_context;
     function_context->func.local_context = 0;
-    allocate_assign_local_context(&function_context->func);
-  } break;
+    return allocate_assign_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_GATHERND
@@ -1589,8 +1826,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_gather_nd_local_context;
     function_context->func.local_context = 0;
-    allocate_gather_nd_local_context(&function_context->func);
-  } break;
+    return allocate_gather_nd_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SCATTERND
@@ -1600,10 +1837,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_scatter_nd_t *f = (nn_function_scatter_nd_t *)function;
     scatter_nd_local_context_t *ctx =
         rt_malloc_func(sizeof(scatter_nd_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     function_context->func.local_context = ctx;
-    allocate_scatter_nd_local_context(&function_context->func);
-  } break;
+    return allocate_scatter_nd_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_INTERPOLATE
@@ -1613,12 +1853,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_interpolate_t *f = (nn_function_interpolate_t *)function;
     interpolate_local_context_t *ctx =
         rt_malloc_func(sizeof(interpolate_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->output_size = create_rt_list_from_nn_list(n, f->output_size);
     ctx->mode = f->mode;
     ctx->align_corners = f->align_corners;
     function_context->func.local_context = ctx;
-    allocate_interpolate_local_context(&function_context->func);
-  } break;
+    return allocate_interpolate_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_FFT
@@ -1626,11 +1869,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_fft_local_context;
     nn_function_fft_t *f = (nn_function_fft_t *)function;
     fft_local_context_t *ctx = rt_malloc_func(sizeof(fft_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->signal_ndim = f->signal_ndim;
     ctx->normalized = f->normalized;
     function_context->func.local_context = ctx;
-    allocate_fft_local_context(&function_context->func);
-  } break;
+    return allocate_fft_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_IFFT
@@ -1638,11 +1884,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_ifft_local_context;
     nn_function_ifft_t *f = (nn_function_ifft_t *)function;
     ifft_local_context_t *ctx = rt_malloc_func(sizeof(ifft_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->signal_ndim = f->signal_ndim;
     ctx->normalized = f->normalized;
     function_context->func.local_context = ctx;
-    allocate_ifft_local_context(&function_context->func);
-  } break;
+    return allocate_ifft_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_DROPOUT
@@ -1651,11 +1900,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_dropout_t *f = (nn_function_dropout_t *)function;
     dropout_local_context_t *ctx =
         rt_malloc_func(sizeof(dropout_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->p = f->p;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_dropout_local_context(&function_context->func);
-  } break;
+    return allocate_dropout_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TOPKDATA
@@ -1665,13 +1917,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_top_k_data_t *f = (nn_function_top_k_data_t *)function;
     top_k_data_local_context_t *ctx =
         rt_malloc_func(sizeof(top_k_data_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->k = f->k;
     ctx->abs = f->abs;
     ctx->reduce = f->reduce;
     ctx->base_axis = f->base_axis;
     function_context->func.local_context = ctx;
-    allocate_top_k_data_local_context(&function_context->func);
-  } break;
+    return allocate_top_k_data_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TOPKGRAD
@@ -1681,12 +1936,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_top_k_grad_t *f = (nn_function_top_k_grad_t *)function;
     top_k_grad_local_context_t *ctx =
         rt_malloc_func(sizeof(top_k_grad_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->k = f->k;
     ctx->abs = f->abs;
     ctx->base_axis = f->base_axis;
     function_context->func.local_context = ctx;
-    allocate_top_k_grad_local_context(&function_context->func);
-  } break;
+    return allocate_top_k_grad_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RAND
@@ -1694,13 +1952,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_rand_local_context;
     nn_function_rand_t *f = (nn_function_rand_t *)function;
     rand_local_context_t *ctx = rt_malloc_func(sizeof(rand_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->low = f->low;
     ctx->high = f->high;
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_rand_local_context(&function_context->func);
-  } break;
+    return allocate_rand_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDINT
@@ -1709,13 +1970,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_randint_t *f = (nn_function_randint_t *)function;
     randint_local_context_t *ctx =
         rt_malloc_func(sizeof(randint_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->low = f->low;
     ctx->high = f->high;
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_randint_local_context(&function_context->func);
-  } break;
+    return allocate_randint_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDN
@@ -1723,13 +1987,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_randn_local_context;
     nn_function_randn_t *f = (nn_function_randn_t *)function;
     randn_local_context_t *ctx = rt_malloc_func(sizeof(randn_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->mu = f->mu;
     ctx->sigma = f->sigma;
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_randn_local_context(&function_context->func);
-  } break;
+    return allocate_randn_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDOMCHOICE
@@ -1739,12 +2006,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_random_choice_t *f = (nn_function_random_choice_t *)function;
     random_choice_local_context_t *ctx =
         rt_malloc_func(sizeof(random_choice_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->replace = f->replace;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_random_choice_local_context(&function_context->func);
-  } break;
+    return allocate_random_choice_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDOMCROP
@@ -1754,12 +2024,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_random_crop_t *f = (nn_function_random_crop_t *)function;
     random_crop_local_context_t *ctx =
         rt_malloc_func(sizeof(random_crop_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->base_axis = f->base_axis;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_random_crop_local_context(&function_context->func);
-  } break;
+    return allocate_random_crop_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDOMFLIP
@@ -1769,12 +2042,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_random_flip_t *f = (nn_function_random_flip_t *)function;
     random_flip_local_context_t *ctx =
         rt_malloc_func(sizeof(random_flip_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axes = create_rt_list_from_nn_list(n, f->axes);
     ctx->base_axis = f->base_axis;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_random_flip_local_context(&function_context->func);
-  } break;
+    return allocate_random_flip_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_RANDOMSHIFT
@@ -1784,13 +2060,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_random_shift_t *f = (nn_function_random_shift_t *)function;
     random_shift_local_context_t *ctx =
         rt_malloc_func(sizeof(random_shift_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shifts = create_rt_list_from_nn_list(n, f->shifts);
     ctx->border_mode = f->border_mode;
     ctx->base_axis = f->base_axis;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_random_shift_local_context(&function_context->func);
-  } break;
+    return allocate_random_shift_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_IMAGEAUGMENTATION
@@ -1801,6 +2080,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_image_augmentation_t *)function;
     image_augmentation_local_context_t *ctx =
         rt_malloc_func(sizeof(image_augmentation_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->shape = create_rt_list_from_nn_list(n, f->shape);
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->min_scale = f->min_scale;
@@ -1818,8 +2100,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->noise = f->noise;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_image_augmentation_local_context(&function_context->func);
-  } break;
+    return allocate_image_augmentation_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SIGMOIDCROSSENTROPY
@@ -1827,8 +2109,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_sigmoid_cross_entropy_local_context;
     function_context->func.local_context = 0;
-    allocate_sigmoid_cross_entropy_local_context(&function_context->func);
-  } break;
+    return allocate_sigmoid_cross_entropy_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYCROSSENTROPY
@@ -1836,8 +2119,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_binary_cross_entropy_local_context;
     function_context->func.local_context = 0;
-    allocate_binary_cross_entropy_local_context(&function_context->func);
-  } break;
+    return allocate_binary_cross_entropy_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SOFTMAXCROSSENTROPY
@@ -1848,10 +2131,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_softmax_cross_entropy_t *)function;
     softmax_cross_entropy_local_context_t *ctx =
         rt_malloc_func(sizeof(softmax_cross_entropy_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_softmax_cross_entropy_local_context(&function_context->func);
-  } break;
+    return allocate_softmax_cross_entropy_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CATEGORICALCROSSENTROPY
@@ -1862,10 +2149,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_categorical_cross_entropy_t *)function;
     categorical_cross_entropy_local_context_t *ctx =
         rt_malloc_func(sizeof(categorical_cross_entropy_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_categorical_cross_entropy_local_context(&function_context->func);
-  } break;
+    return allocate_categorical_cross_entropy_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SQUAREDERROR
@@ -1873,8 +2164,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_squared_error_local_context;
     function_context->func.local_context = 0;
-    allocate_squared_error_local_context(&function_context->func);
-  } break;
+    return allocate_squared_error_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_ABSOLUTEERROR
@@ -1882,8 +2173,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_absolute_error_local_context;
     function_context->func.local_context = 0;
-    allocate_absolute_error_local_context(&function_context->func);
-  } break;
+    return allocate_absolute_error_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_HUBERLOSS
@@ -1893,10 +2184,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_huber_loss_t *f = (nn_function_huber_loss_t *)function;
     huber_loss_local_context_t *ctx =
         rt_malloc_func(sizeof(huber_loss_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->delta = f->delta;
     function_context->func.local_context = ctx;
-    allocate_huber_loss_local_context(&function_context->func);
-  } break;
+    return allocate_huber_loss_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_EPSILONINSENSITIVELOSS
@@ -1907,10 +2201,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_epsilon_insensitive_loss_t *)function;
     epsilon_insensitive_loss_local_context_t *ctx =
         rt_malloc_func(sizeof(epsilon_insensitive_loss_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->epsilon = f->epsilon;
     function_context->func.local_context = ctx;
-    allocate_epsilon_insensitive_loss_local_context(&function_context->func);
-  } break;
+    return allocate_epsilon_insensitive_loss_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_KLMULTINOMIAL
@@ -1920,10 +2218,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_kl_multinomial_t *f = (nn_function_kl_multinomial_t *)function;
     kl_multinomial_local_context_t *ctx =
         rt_malloc_func(sizeof(kl_multinomial_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     function_context->func.local_context = ctx;
-    allocate_kl_multinomial_local_context(&function_context->func);
-  } break;
+    return allocate_kl_multinomial_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYSIGMOID
@@ -1931,8 +2232,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_binary_sigmoid_local_context;
     function_context->func.local_context = 0;
-    allocate_binary_sigmoid_local_context(&function_context->func);
-  } break;
+    return allocate_binary_sigmoid_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYTANH
@@ -1940,8 +2241,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_binary_tanh_local_context;
     function_context->func.local_context = 0;
-    allocate_binary_tanh_local_context(&function_context->func);
-  } break;
+    return allocate_binary_tanh_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYCONNECTAFFINE
@@ -1952,11 +2253,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_connect_affine_t *)function;
     binary_connect_affine_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_connect_affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->quantize_zero_to = 1.0;
     function_context->func.local_context = ctx;
-    allocate_binary_connect_affine_local_context(&function_context->func);
-  } break;
+    return allocate_binary_connect_affine_local_context(
+        &function_context->func);
+  }
   case NN_FUNCTION_BINARY_CONNECT_AFFINE: { // BinaryConnectAffine
     function_context->func.free_local_context_func =
         free_binary_connect_affine_local_context;
@@ -1964,11 +2269,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_connect_affine_t *)function;
     binary_connect_affine_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_connect_affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->quantize_zero_to = f->quantize_zero_to;
     function_context->func.local_context = ctx;
-    allocate_binary_connect_affine_local_context(&function_context->func);
-  } break;
+    return allocate_binary_connect_affine_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYCONNECTCONVOLUTION
@@ -1979,6 +2288,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_connect_convolution_t *)function;
     binary_connect_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_connect_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -1986,8 +2298,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->quantize_zero_to = 1.0;
     function_context->func.local_context = ctx;
-    allocate_binary_connect_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_binary_connect_convolution_local_context(
+        &function_context->func);
+  }
   case NN_FUNCTION_BINARY_CONNECT_CONVOLUTION: { // BinaryConnectConvolution
     function_context->func.free_local_context_func =
         free_binary_connect_convolution_local_context;
@@ -1995,6 +2308,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_connect_convolution_t *)function;
     binary_connect_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_connect_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -2002,8 +2318,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->quantize_zero_to = f->quantize_zero_to;
     function_context->func.local_context = ctx;
-    allocate_binary_connect_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_binary_connect_convolution_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYWEIGHTAFFINE
@@ -2014,11 +2331,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_weight_affine_t *)function;
     binary_weight_affine_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_weight_affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->quantize_zero_to = 1.0;
     function_context->func.local_context = ctx;
-    allocate_binary_weight_affine_local_context(&function_context->func);
-  } break;
+    return allocate_binary_weight_affine_local_context(&function_context->func);
+  }
   case NN_FUNCTION_BINARY_WEIGHT_AFFINE: { // BinaryWeightAffine
     function_context->func.free_local_context_func =
         free_binary_weight_affine_local_context;
@@ -2026,11 +2346,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_weight_affine_t *)function;
     binary_weight_affine_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_weight_affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->quantize_zero_to = f->quantize_zero_to;
     function_context->func.local_context = ctx;
-    allocate_binary_weight_affine_local_context(&function_context->func);
-  } break;
+    return allocate_binary_weight_affine_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYWEIGHTCONVOLUTION
@@ -2041,6 +2364,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_weight_convolution_t *)function;
     binary_weight_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_weight_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -2048,8 +2374,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->quantize_zero_to = 1.0;
     function_context->func.local_context = ctx;
-    allocate_binary_weight_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_binary_weight_convolution_local_context(
+        &function_context->func);
+  }
   case NN_FUNCTION_BINARY_WEIGHT_CONVOLUTION: { // BinaryWeightConvolution
     function_context->func.free_local_context_func =
         free_binary_weight_convolution_local_context;
@@ -2057,6 +2384,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_binary_weight_convolution_t *)function;
     binary_weight_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(binary_weight_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -2064,8 +2394,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->group = f->group;
     ctx->quantize_zero_to = f->quantize_zero_to;
     function_context->func.local_context = ctx;
-    allocate_binary_weight_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_binary_weight_convolution_local_context(
+        &function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_INQAFFINE
@@ -2075,14 +2406,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_inq_affine_t *f = (nn_function_inq_affine_t *)function;
     inq_affine_local_context_t *ctx =
         rt_malloc_func(sizeof(inq_affine_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->num_bits = f->num_bits;
     ctx->inq_iterations = create_rt_list_from_nn_list(n, f->inq_iterations);
     ctx->selection_algorithm = f->selection_algorithm;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_inq_affine_local_context(&function_context->func);
-  } break;
+    return allocate_inq_affine_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_INQCONVOLUTION
@@ -2093,6 +2427,9 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_inq_convolution_t *)function;
     inq_convolution_local_context_t *ctx =
         rt_malloc_func(sizeof(inq_convolution_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
@@ -2103,8 +2440,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     ctx->selection_algorithm = f->selection_algorithm;
     ctx->seed = f->seed;
     function_context->func.local_context = ctx;
-    allocate_inq_convolution_local_context(&function_context->func);
-  } break;
+    return allocate_inq_convolution_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_FIXEDPOINTQUANTIZE
@@ -2115,13 +2452,16 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_fixed_point_quantize_t *)function;
     fixed_point_quantize_local_context_t *ctx =
         rt_malloc_func(sizeof(fixed_point_quantize_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->sign = f->sign;
     ctx->n = f->n;
     ctx->delta = f->delta;
     ctx->ste_fine_grained = f->ste_fine_grained;
     function_context->func.local_context = ctx;
-    allocate_fixed_point_quantize_local_context(&function_context->func);
-  } break;
+    return allocate_fixed_point_quantize_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MINMAXQUANTIZE
@@ -2132,14 +2472,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_min_max_quantize_t *)function;
     min_max_quantize_local_context_t *ctx =
         rt_malloc_func(sizeof(min_max_quantize_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->decay = f->decay;
     ctx->x_min_max = f->x_min_max;
     ctx->ema = f->ema;
     ctx->ste_fine_grained = f->ste_fine_grained;
     ctx->eps = 0.01;
     function_context->func.local_context = ctx;
-    allocate_min_max_quantize_local_context(&function_context->func);
-  } break;
+    return allocate_min_max_quantize_local_context(&function_context->func);
+  }
   case NN_FUNCTION_MIN_MAX_QUANTIZE: { // MinMaxQuantize
     function_context->func.free_local_context_func =
         free_min_max_quantize_local_context;
@@ -2147,14 +2490,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_min_max_quantize_t *)function;
     min_max_quantize_local_context_t *ctx =
         rt_malloc_func(sizeof(min_max_quantize_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->decay = f->decay;
     ctx->x_min_max = f->x_min_max;
     ctx->ema = f->ema;
     ctx->ste_fine_grained = f->ste_fine_grained;
     ctx->eps = f->eps;
     function_context->func.local_context = ctx;
-    allocate_min_max_quantize_local_context(&function_context->func);
-  } break;
+    return allocate_min_max_quantize_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_POW2QUANTIZE
@@ -2164,14 +2510,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_pow2_quantize_t *f = (nn_function_pow2_quantize_t *)function;
     pow2_quantize_local_context_t *ctx =
         rt_malloc_func(sizeof(pow2_quantize_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->sign = f->sign;
     ctx->with_zero = f->with_zero;
     ctx->n = f->n;
     ctx->m = f->m;
     ctx->ste_fine_grained = f->ste_fine_grained;
     function_context->func.local_context = ctx;
-    allocate_pow2_quantize_local_context(&function_context->func);
-  } break;
+    return allocate_pow2_quantize_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_PRUNE
@@ -2179,10 +2528,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_prune_local_context;
     nn_function_prune_t *f = (nn_function_prune_t *)function;
     prune_local_context_t *ctx = rt_malloc_func(sizeof(prune_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->rate = f->rate;
     function_context->func.local_context = ctx;
-    allocate_prune_local_context(&function_context->func);
-  } break;
+    return allocate_prune_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_TOPNERROR
@@ -2192,11 +2544,14 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_top_n_error_t *f = (nn_function_top_n_error_t *)function;
     top_n_error_local_context_t *ctx =
         rt_malloc_func(sizeof(top_n_error_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     ctx->n = f->n;
     function_context->func.local_context = ctx;
-    allocate_top_n_error_local_context(&function_context->func);
-  } break;
+    return allocate_top_n_error_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_BINARYERROR
@@ -2204,8 +2559,8 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_binary_error_local_context;
     function_context->func.local_context = 0;
-    allocate_binary_error_local_context(&function_context->func);
-  } break;
+    return allocate_binary_error_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_CONFUSIONMATRIX
@@ -2216,10 +2571,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_confusion_matrix_t *)function;
     confusion_matrix_local_context_t *ctx =
         rt_malloc_func(sizeof(confusion_matrix_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->axis = f->axis;
     function_context->func.local_context = ctx;
-    allocate_confusion_matrix_local_context(&function_context->func);
-  } break;
+    return allocate_confusion_matrix_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_VATNOISE
@@ -2229,19 +2587,22 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     nn_function_vat_noise_t *f = (nn_function_vat_noise_t *)function;
     vat_noise_local_context_t *ctx =
         rt_malloc_func(sizeof(vat_noise_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->base_axis = f->base_axis;
     ctx->eps = f->eps;
     function_context->func.local_context = ctx;
-    allocate_vat_noise_local_context(&function_context->func);
-  } break;
+    return allocate_vat_noise_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_UNLINK
   case NN_FUNCTION_UNLINK: { // Unlink
     function_context->func.free_local_context_func = free_unlink_local_context;
     function_context->func.local_context = 0;
-    allocate_unlink_local_context(&function_context->func);
-  } break;
+    return allocate_unlink_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_SINK
@@ -2249,10 +2610,13 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func = free_sink_local_context;
     nn_function_sink_t *f = (nn_function_sink_t *)function;
     sink_local_context_t *ctx = rt_malloc_func(sizeof(sink_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->one_input_grad = f->one_input_grad;
     function_context->func.local_context = ctx;
-    allocate_sink_local_context(&function_context->func);
-  } break;
+    return allocate_sink_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_NMSDETECTION2D
@@ -2263,12 +2627,15 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_nms_detection2d_t *)function;
     nms_detection2d_local_context_t *ctx =
         rt_malloc_func(sizeof(nms_detection2d_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->thresh = f->thresh;
     ctx->nms = f->nms;
     ctx->nms_per_class = f->nms_per_class;
     function_context->func.local_context = ctx;
-    allocate_nms_detection2d_local_context(&function_context->func);
-  } break;
+    return allocate_nms_detection2d_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_MAXPOOLINGBACKWARD
@@ -2279,14 +2646,17 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
         (nn_function_max_pooling_backward_t *)function;
     max_pooling_backward_local_context_t *ctx =
         rt_malloc_func(sizeof(max_pooling_backward_local_context_t));
+    if (ctx == 0) {
+      return RT_FUNCTION_ERROR_MALLOC;
+    }
     ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
     ctx->stride = create_rt_list_from_nn_list(n, f->stride);
     ctx->ignore_border = f->ignore_border;
     ctx->pad = create_rt_list_from_nn_list(n, f->pad);
     ctx->channel_last = f->channel_last;
     function_context->func.local_context = ctx;
-    allocate_max_pooling_backward_local_context(&function_context->func);
-  } break;
+    return allocate_max_pooling_backward_local_context(&function_context->func);
+  }
 #endif
 
 #ifdef CONFIG_WARPBYFLOW
@@ -2294,11 +2664,12 @@ void allocate_function_context(nn_network_t *n, nn_function_t *function,
     function_context->func.free_local_context_func =
         free_warp_by_flow_local_context;
     function_context->func.local_context = 0;
-    allocate_warp_by_flow_local_context(&function_context->func);
-  } break;
+    return allocate_warp_by_flow_local_context(&function_context->func);
+  }
 #endif
 
   default:
     function_context->func.local_context = 0;
   }
+  return RT_FUNCTION_ERROR_NOERROR;
 }
@@ -0,0 +1,2006 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/config.h>
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#include <math.h>
+
+/*
+ * Patterns merged into one function:
+ *   Convolution/Affine -> BatchNormalization -> Activation
+ *   Convolution/Affine -> BatchNormalization
+ *   Convolution/Affine -> Activation
+ * BatchNormalization with constant mean and variance is folded into copies
+ * of weight and bias, and ReLU, LeakyReLU, ReLU6, Swish, Sigmoid or Tanh is
+ * applied by the kernel as epilogue. Convolution/Affine writes output of the
+ * last merged function directly, and merged functions are skipped in
+ * forward. GlobalAveragePooling after any of these Convolution patterns is
+ * calculated by the head right after its kernel, so the feature map lives
+ * only while the head runs.
+ *
+ * Pad with constant zero, the same width before and after each spatial axis
+ * and no width on other axes, is merged into pad of following Convolution,
+ * DepthwiseConvolution, AveragePooling including pad or SumPooling, and the
+ * function reads input of the Pad.
+ *
+ * MeanSubtraction whose output is read only by Affine or Convolution with
+ * bias is folded into a copy of the bias, b' = b - W * mean, and the function
+ * reads input of the MeanSubtraction. Convolution must have no pad, and its
+ * mean must be the same over each map of channel, which is checked when the
+ * bias is folded.
+ *
+ * Transpose which swaps the last two axes of a BatchMatmul input is merged
+ * into transpose_a or transpose_b, and BatchMatmul reads input of the
+ * Transpose with the other layout.
+ *
+ * Softmax over each sample of following TopKData is merged into it. TopKData
+ * reads logits and finds the largest ones, and only their probabilities are
+ * calculated from the sum of exp over the sample.
+ *
+ * Broadcast, BroadcastTo or Tile whose output is read only by a two input
+ * arithmetic function, such as Add2 or Mul2, is not calculated. The function
+ * reads input of it as a view, whose axes of size 1 are broadcast and other
+ * axes are tiled by its broadcast engine with stride 0, so the repeated
+ * values are never written to memory.
+ *
+ * Chain of element wise functions, such as MulScalar -> AddScalar -> ReLU or
+ * Sub2 -> Abs -> Pow2, is calculated by the first function in one pass with
+ * calc_elementwise_chain(). Each following function reads output of former
+ * one, and may read one more variable with same number of elements.
+ *
+ * Groups of rt_set_tiled_execution() are found after these, also without
+ * function fusion, and their functions before the last one are skipped.
+ */
+
+static nn_function_t *get_function(nn_network_t *n, int index) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  return (nn_function_t *)(NN_GET(n, list[index]));
+}
+
+static nn_variable_t *get_variable(nn_network_t *n, int index) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  return (nn_variable_t *)(NN_GET(n, list[index]));
+}
+
+static int is_in_list(rt_list_t list, int value) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] == value) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int is_float_variable(rt_context_t *c, int index) {
+  return index >= 0 && index < c->num_of_variables &&
+         c->variables[index].type == NN_DATA_TYPE_FLOAT;
+}
+
+static int is_constant_variable(nn_network_t *n, rt_context_t *c,
+                                const int *uses, int index) {
+  return is_float_variable(c, index) && uses[index] == 1 &&
+         get_variable(n, index)->data_index >= 0 &&
+         get_variable(n, index)->layout == NN_DATA_LAYOUT_DENSE;
+}
+
+static int num_of_elements(rt_context_t *c, int index) {
+  return (int)(calc_variable_data_size(c->variables + index) / sizeof(float));
+}
+
+// Variable is written by a function and read only by next function.
+static int is_intermediate(nn_network_t *n, rt_context_t *c, const int *uses,
+                           int index, nn_function_t *next) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, next->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, next->outputs);
+  return is_float_variable(c, index) && uses[index] == 1 &&
+         inputs.size > 0 && inputs.data[0] == index && outputs.size == 1 &&
+         is_float_variable(c, outputs.data[0]) &&
+         !is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) &&
+         !is_in_list(create_rt_list_from_nn_list(n, n->outputs), index) &&
+         !has_user_function(c, next);
+}
+
+// Convolution or Affine calculated in float. channel_axis is axis of output
+// which BatchNormalization must normalize to be folded.
+static int is_fusion_head(nn_network_t *n, rt_context_t *c,
+                          nn_function_t *func, int *channel_axis) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int i; // Iterator
+
+  if ((inputs.size != 2 && inputs.size != 3) || outputs.size != 1 ||
+      has_user_function(c, func)) {
+    return 0;
+  }
+  for (i = 0; i < inputs.size; i++) {
+    if (!is_float_variable(c, inputs.data[i])) {
+      return 0;
+    }
+  }
+  if (!is_float_variable(c, outputs.data[0])) {
+    return 0;
+  }
+
+  switch (func->type) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  case NN_FUNCTION_CONVOLUTION_0:
+    *channel_axis = ((nn_function_convolution_t *)func)->base_axis;
+    return 1;
+  case NN_FUNCTION_CONVOLUTION:
+    *channel_axis =
+        ((nn_function_convolution_t *)func)->channel_last
+            ? c->variables[outputs.data[0]].shape.size - 1
+            : ((nn_function_convolution_t *)func)->base_axis;
+    return 1;
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+#ifdef CONFIG_AFFINE
+  case NN_FUNCTION_AFFINE:
+    *channel_axis = ((nn_function_affine_t *)func)->base_axis;
+    return c->variables[outputs.data[0]].shape.size == *channel_axis + 1;
+#endif /* CONFIG_AFFINE */
+  default:
+    return 0;
+  }
+}
+
+static int is_foldable_batch_normalization(nn_network_t *n, rt_context_t *c,
+                                           const int *uses,
+                                           nn_function_t *head,
+                                           int channel_axis,
+                                           nn_function_t *func) {
+  nn_function_batch_normalization_t *bn =
+      (nn_function_batch_normalization_t *)func;
+  int i; // Iterator
+
+  if (func->type != NN_FUNCTION_BATCH_NORMALIZATION) {
+    return 0;
+  }
+  rt_list_t head_inputs = create_rt_list_from_nn_list(n, head->inputs);
+  rt_list_t head_outputs = create_rt_list_from_nn_list(n, head->outputs);
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t axes = create_rt_list_from_nn_list(n, bn->axes);
+  rt_variable_t *y = c->variables + head_outputs.data[0];
+  if (bn->batch_stat || inputs.size != 5 || axes.size != 1 ||
+      axes.data[0] != channel_axis || channel_axis < 0 ||
+      channel_axis >= y->shape.size) {
+    return 0;
+  }
+  int channels = y->shape.data[channel_axis];
+  for (i = 1; i < inputs.size; i++) {
+    if (!is_constant_variable(n, c, uses, inputs.data[i]) ||
+        num_of_elements(c, inputs.data[i]) != channels) {
+      return 0;
+    }
+  }
+
+  // Weight is calculated as [output channel][others].
+  int weight = head_inputs.data[1];
+  if (!is_constant_variable(n, c, uses, weight) ||
+      num_of_elements(c, weight) % channels != 0) {
+    return 0;
+  }
+  if (head_inputs.size > 2 &&
+      (!is_constant_variable(n, c, uses, head_inputs.data[2]) ||
+       num_of_elements(c, head_inputs.data[2]) != channels)) {
+    return 0;
+  }
+  return 1;
+}
+
+static int get_epilogue(nn_function_t *func, rt_epilogue_t *epilogue) {
+  if (func->inputs.size != 1) {
+    return 0;
+  }
+  epilogue->alpha = 0.0f;
+  switch (func->type) {
+  case NN_FUNCTION_RELU:
+    epilogue->type = RT_EPILOGUE_RELU;
+    return 1;
+  case NN_FUNCTION_LEAKY_RELU_0:
+  case NN_FUNCTION_LEAKY_RELU:
+    epilogue->type = RT_EPILOGUE_LEAKY_RELU;
+    epilogue->alpha = ((nn_function_leaky_relu_t *)func)->alpha;
+    return 1;
+  case NN_FUNCTION_RELU6:
+    epilogue->type = RT_EPILOGUE_RELU6;
+    return 1;
+  case NN_FUNCTION_SWISH:
+    epilogue->type = RT_EPILOGUE_SWISH;
+    return 1;
+  case NN_FUNCTION_SIGMOID:
+    epilogue->type = RT_EPILOGUE_SIGMOID;
+    return 1;
+  case NN_FUNCTION_TANH:
+    epilogue->type = RT_EPILOGUE_TANH;
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_FLOAT32
+// GlobalAveragePooling which averages each map of channel of input.
+static int is_global_average_pooling(nn_network_t *n, rt_context_t *c,
+                                     int input, nn_function_t *func) {
+  rt_variable_t *x = c->variables + input;
+  int maps;
+
+  if (func->type != NN_FUNCTION_GLOBAL_AVERAGE_POOLING ||
+      x->shape.size < 2) {
+    return 0;
+  }
+  maps = num_of_elements(
+      c, create_rt_list_from_nn_list(n, func->outputs).data[0]);
+  return maps > 0 && maps == x->shape.data[0] * x->shape.data[1] &&
+         num_of_elements(c, input) % maps == 0;
+}
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_FLOAT32 */
+
+#ifdef CONFIG_BATCHMATMUL
+// Transpose of one variable which swaps the last two axes.
+static int is_last_axes_transpose(nn_network_t *n, rt_context_t *c,
+                                  nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  rt_list_t axes;
+  int i; // Iterator
+
+  if (func->type != NN_FUNCTION_TRANSPOSE || inputs.size != 1 ||
+      outputs.size != 1 || !is_float_variable(c, inputs.data[0]) ||
+      has_user_function(c, func)) {
+    return 0;
+  }
+  axes = create_rt_list_from_nn_list(
+      n, ((nn_function_transpose_t *)func)->axes);
+  if (axes.size < 2 || axes.size != c->variables[inputs.data[0]].shape.size) {
+    return 0;
+  }
+  for (i = 0; i < axes.size - 2; i++) {
+    if (axes.data[i] != i) {
+      return 0;
+    }
+  }
+  return axes.data[axes.size - 2] == axes.size - 1 &&
+         axes.data[axes.size - 1] == axes.size - 2;
+}
+
+// Index of Transpose before function i whose output is read only by input k
+// of BatchMatmul i, or -1.
+static int find_merged_transpose(nn_network_t *n, rt_context_t *c,
+                                 const int *uses, int i, int k) {
+  nn_function_t *func = get_function(n, i);
+  int index = create_rt_list_from_nn_list(n, func->inputs).data[k];
+  int j; // Iterator
+
+  if (!is_float_variable(c, index) || uses[index] != 1 ||
+      is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) ||
+      is_in_list(create_rt_list_from_nn_list(n, n->outputs), index)) {
+    return -1;
+  }
+  for (j = i - 1; j >= 0; j--) {
+    nn_function_t *transpose = get_function(n, j);
+    if (is_in_list(create_rt_list_from_nn_list(n, transpose->outputs),
+                   index)) {
+      return is_last_axes_transpose(n, c, transpose) &&
+                     !is_removed_function(c, j)
+                 ? j
+                 : -1;
+    }
+  }
+  return -1;
+}
+#endif /* CONFIG_BATCHMATMUL */
+
+#if defined(CONFIG_SOFTMAX) && defined(CONFIG_TOPKDATA_FLOAT32)
+// Softmax whose groups of normalized values are samples of TopKData.
+static int is_softmax_of_samples(nn_network_t *n, rt_context_t *c,
+                                 nn_function_t *top_k, nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int base_axis = ((nn_function_top_k_data_t *)top_k)->base_axis;
+  int axis, samples, groups, i; // Iterator
+
+  if (func->type != NN_FUNCTION_SOFTMAX || inputs.size != 1 ||
+      outputs.size != 1 || !is_float_variable(c, inputs.data[0]) ||
+      has_user_function(c, func)) {
+    return 0;
+  }
+  rt_list_t shape = c->variables[inputs.data[0]].shape;
+  axis = ((nn_function_softmax_t *)func)->axis;
+  axis = axis < 0 ? axis + shape.size : axis;
+  if (axis < 0 || axis >= shape.size || base_axis < 0 || base_axis > axis) {
+    return 0;
+  }
+  // Softmax groups are contiguous only if axes after axis are 1.
+  for (i = axis + 1; i < shape.size; i++) {
+    if (shape.data[i] != 1) {
+      return 0;
+    }
+  }
+  samples = 1;
+  groups = 1;
+  for (i = 0; i < axis; i++) {
+    samples *= i < base_axis ? shape.data[i] : 1;
+    groups *= shape.data[i];
+  }
+  return samples == groups;
+}
+
+// Index of Softmax before TopKData i whose output is read only by it, or -1.
+static int find_merged_softmax(nn_network_t *n, rt_context_t *c,
+                               const int *uses, int i) {
+  nn_function_t *func = get_function(n, i);
+  int index = create_rt_list_from_nn_list(n, func->inputs).data[0];
+  int j; // Iterator
+
+  if (!is_float_variable(c, index) || uses[index] != 1 ||
+      is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) ||
+      is_in_list(create_rt_list_from_nn_list(n, n->outputs), index)) {
+    return -1;
+  }
+  for (j = i - 1; j >= 0; j--) {
+    nn_function_t *softmax = get_function(n, j);
+    if (is_in_list(create_rt_list_from_nn_list(n, softmax->outputs),
+                   index)) {
+      return is_softmax_of_samples(n, c, func, softmax) &&
+                     !is_removed_function(c, j)
+                 ? j
+                 : -1;
+    }
+  }
+  return -1;
+}
+#endif /* CONFIG_SOFTMAX && CONFIG_TOPKDATA_FLOAT32 */
+
+// Two input arithmetic function which reads inputs by broadcast engine.
+static int is_broadcast_arithmetic(nn_network_t *n, rt_context_t *c,
+                                   nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+
+  switch (func->type) {
+  case NN_FUNCTION_ADD2:
+  case NN_FUNCTION_SUB2:
+  case NN_FUNCTION_MUL2:
+  case NN_FUNCTION_DIV2:
+  case NN_FUNCTION_POW2:
+  case NN_FUNCTION_MAXIMUM2:
+  case NN_FUNCTION_MINIMUM2:
+    return inputs.size == 2 && outputs.size == 1 &&
+           is_float_variable(c, inputs.data[0]) &&
+           is_float_variable(c, inputs.data[1]) &&
+           is_float_variable(c, outputs.data[0]) &&
+           !has_user_function(c, func);
+  default:
+    return 0;
+  }
+}
+
+// Variable repeated by Broadcast, BroadcastTo or Tile, which is y of
+// BroadcastTo and x of others.
+static int get_repeated_variable(nn_network_t *n, nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  return inputs.data[func->type == NN_FUNCTION_BROADCAST_TO ? 1 : 0];
+}
+
+// Broadcast, BroadcastTo or Tile whose input has the same axes as output,
+// each of which divides the axis of output. Repeated input read by the
+// broadcast engine is the same as the output then.
+static int is_repeat_view(nn_network_t *n, rt_context_t *c,
+                          nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int d; // Iterator
+
+  if ((func->type != NN_FUNCTION_BROADCAST &&
+       func->type != NN_FUNCTION_BROADCAST_TO &&
+       func->type != NN_FUNCTION_TILE) ||
+      inputs.size != (func->type == NN_FUNCTION_BROADCAST_TO ? 2 : 1) ||
+      outputs.size != 1 || has_user_function(c, func)) {
+    return 0;
+  }
+  int input = get_repeated_variable(n, func);
+  if (!is_float_variable(c, input) || !is_float_variable(c, outputs.data[0])) {
+    return 0;
+  }
+  rt_list_t x = c->variables[input].shape;
+  rt_list_t y = c->variables[outputs.data[0]].shape;
+  if (x.size != y.size || (func->type == NN_FUNCTION_BROADCAST_TO &&
+                           ((nn_function_broadcast_to_t *)func)->axis > 0)) {
+    return 0;
+  }
+  for (d = 0; d < y.size; d++) {
+    if (x.data[d] <= 0 || y.data[d] % x.data[d] != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Index of Broadcast, BroadcastTo or Tile before function i whose output is
+// read only by input k of function i, or -1.
+static int find_repeat_view(nn_network_t *n, rt_context_t *c, const int *uses,
+                            int i, int k) {
+  nn_function_t *func = get_function(n, i);
+  int index = create_rt_list_from_nn_list(n, func->inputs).data[k];
+  int j; // Iterator
+
+  if (!is_float_variable(c, index) || uses[index] != 1 ||
+      is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) ||
+      is_in_list(create_rt_list_from_nn_list(n, n->outputs), index)) {
+    return -1;
+  }
+  for (j = i - 1; j >= 0; j--) {
+    nn_function_t *repeat = get_function(n, j);
+    if (is_in_list(create_rt_list_from_nn_list(n, repeat->outputs), index)) {
+      return is_repeat_view(n, c, repeat) && !is_removed_function(c, j) ? j
+                                                                        : -1;
+    }
+  }
+  return -1;
+}
+
+// Input of Broadcast, BroadcastTo or Tile read by input k of function i.
+static int get_viewed_input(nn_network_t *n, rt_context_t *c, int i, int k) {
+  return get_repeated_variable(n, get_function(n, c->fusions[i].view[k]));
+}
+
+// Input of Softmax merged into TopKData i.
+static int get_softmax_input(nn_network_t *n, rt_context_t *c, int i) {
+  nn_function_t *softmax = get_function(n, c->fusions[i].softmax);
+  return create_rt_list_from_nn_list(n, softmax->inputs).data[0];
+}
+
+// Input of Transpose merged into input k of function i.
+static int get_transposed_input(nn_network_t *n, rt_context_t *c, int i,
+                                int k) {
+  nn_function_t *transpose = get_function(n, c->fusions[i].transpose[k]);
+  return create_rt_list_from_nn_list(n, transpose->inputs).data[0];
+}
+
+// First axis of input padded by pad of Convolution or pooling function, or -1
+// if Pad cannot be merged into the function. pad is set to its pad.
+static int get_first_padded_axis(nn_network_t *n, rt_context_t *c,
+                                 nn_function_t *func, int input,
+                                 rt_list_t *pad) {
+  int ndim = c->variables[input].shape.size;
+  int channel_last = 0;
+  int kernel_size = -1;
+
+  pad->size = 0;
+  pad->data = 0;
+  switch (func->type) {
+#ifdef CONFIG_CONVOLUTION
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION: {
+    nn_function_convolution_t *conv = (nn_function_convolution_t *)func;
+    *pad = create_rt_list_from_nn_list(n, conv->pad);
+    channel_last = func->type == NN_FUNCTION_CONVOLUTION && conv->channel_last;
+  } break;
+#endif /* CONFIG_CONVOLUTION */
+#ifdef CONFIG_DEPTHWISECONVOLUTION
+  case NN_FUNCTION_DEPTHWISE_CONVOLUTION:
+    *pad = create_rt_list_from_nn_list(
+        n, ((nn_function_depthwise_convolution_t *)func)->pad);
+    break;
+#endif /* CONFIG_DEPTHWISECONVOLUTION */
+#ifdef CONFIG_AVERAGEPOOLING
+  case NN_FUNCTION_AVERAGE_POOLING_0:
+  case NN_FUNCTION_AVERAGE_POOLING: {
+    // Zeros of Pad are counted by average only when pad is included.
+    nn_function_average_pooling_t *pooling =
+        (nn_function_average_pooling_t *)func;
+    if (!pooling->ignore_border || (func->type == NN_FUNCTION_AVERAGE_POOLING &&
+                                    !pooling->including_pad)) {
+      return -1;
+    }
+    *pad = create_rt_list_from_nn_list(n, pooling->pad);
+    kernel_size = pooling->kernel.size;
+    channel_last =
+        func->type == NN_FUNCTION_AVERAGE_POOLING && pooling->channel_last;
+  } break;
+#endif /* CONFIG_AVERAGEPOOLING */
+#ifdef CONFIG_SUMPOOLING
+  case NN_FUNCTION_SUM_POOLING_0:
+  case NN_FUNCTION_SUM_POOLING: {
+    nn_function_sum_pooling_t *pooling = (nn_function_sum_pooling_t *)func;
+    if (!pooling->ignore_border) {
+      return -1;
+    }
+    *pad = create_rt_list_from_nn_list(n, pooling->pad);
+    kernel_size = pooling->kernel.size;
+    channel_last =
+        func->type == NN_FUNCTION_SUM_POOLING && pooling->channel_last;
+  } break;
+#endif /* CONFIG_SUMPOOLING */
+  default:
+    return -1;
+  }
+  if (pad->size < 1 || pad->size + channel_last >= ndim ||
+      (kernel_size >= 0 && kernel_size != pad->size)) {
+    return -1;
+  }
+  return ndim - pad->size - channel_last;
+}
+
+// Width of Pad before or after axis. pad_width has pairs of the last axes.
+static int get_pad_width(rt_list_t pad_width, int ndim, int axis, int after) {
+  int first = ndim - pad_width.size / 2;
+  return axis < first ? 0 : pad_width.data[(axis - first) * 2 + after];
+}
+
+static int is_mergeable_pad(nn_network_t *n, rt_context_t *c,
+                            nn_function_t *func, int first, int size) {
+  nn_function_pad_t *pad = (nn_function_pad_t *)func;
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  rt_list_t pad_width;
+  rt_variable_t *x;
+  rt_variable_t *y;
+  int axis; // Iterator
+
+  if (func->type != NN_FUNCTION_PAD || inputs.size != 1 ||
+      outputs.size != 1 || has_user_function(c, func) ||
+      pad->mode != PAD_MODE_CONSTANT || pad->constant_value != 0.0f) {
+    return 0;
+  }
+  x = c->variables + inputs.data[0];
+  y = c->variables + outputs.data[0];
+  pad_width = create_rt_list_from_nn_list(n, pad->pad_width);
+  if (!is_same_fixed_point(x, y) || x->shape.size != y->shape.size ||
+      pad_width.size % 2 != 0 || pad_width.size / 2 > x->shape.size) {
+    return 0;
+  }
+  for (axis = 0; axis < x->shape.size; axis++) {
+    int before = get_pad_width(pad_width, x->shape.size, axis, 0);
+    int after = get_pad_width(pad_width, x->shape.size, axis, 1);
+    if (before < 0 || before != after ||
+        ((axis < first || axis >= first + size) && before != 0)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Index of Pad before function i whose output is read only by input 0 of
+// function i, or -1.
+static int find_merged_pad(nn_network_t *n, rt_context_t *c, const int *uses,
+                           int i) {
+  nn_function_t *func = get_function(n, i);
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t pad;
+  int first;
+  int j; // Iterator
+
+  if (inputs.size < 1 || has_user_function(c, func) ||
+      is_removed_function(c, i)) {
+    return -1;
+  }
+  int index = inputs.data[0];
+  if (index < 0 || index >= c->num_of_variables || uses[index] != 1 ||
+      is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) ||
+      is_in_list(create_rt_list_from_nn_list(n, n->outputs), index)) {
+    return -1;
+  }
+  first = get_first_padded_axis(n, c, func, index, &pad);
+  if (first < 0) {
+    return -1;
+  }
+  for (j = i - 1; j >= 0; j--) {
+    nn_function_t *producer = get_function(n, j);
+    if (is_in_list(create_rt_list_from_nn_list(n, producer->outputs),
+                   index)) {
+      return is_mergeable_pad(n, c, producer, first, pad.size) &&
+                     !is_removed_function(c, j)
+                 ? j
+                 : -1;
+    }
+  }
+  return -1;
+}
+
+// Input of Pad merged into function i.
+static int get_padded_input(nn_network_t *n, rt_context_t *c, int i) {
+  nn_function_t *pad = get_function(n, c->fusions[i].pad);
+  return create_rt_list_from_nn_list(n, pad->inputs).data[0];
+}
+
+// Axis of input from which Affine or Convolution reads features, if it has
+// constant weight and bias which can absorb a subtracted mean, or -1.
+static int get_mean_subtraction_axis(nn_network_t *n, rt_context_t *c,
+                                     const int *uses, nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int k; // Iterator
+
+  if (inputs.size != 3 || outputs.size != 1 || has_user_function(c, func) ||
+      !is_float_variable(c, inputs.data[0]) ||
+      !is_float_variable(c, outputs.data[0]) ||
+      !is_constant_variable(n, c, uses, inputs.data[1]) ||
+      !is_constant_variable(n, c, uses, inputs.data[2])) {
+    return -1;
+  }
+  switch (func->type) {
+#ifdef CONFIG_AFFINE
+  case NN_FUNCTION_AFFINE:
+    return ((nn_function_affine_t *)func)->base_axis;
+#endif /* CONFIG_AFFINE */
+#ifdef CONFIG_CONVOLUTION
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION: {
+    nn_function_convolution_t *conv = (nn_function_convolution_t *)func;
+    rt_list_t pad = create_rt_list_from_nn_list(n, conv->pad);
+    if (func->type == NN_FUNCTION_CONVOLUTION && conv->channel_last) {
+      return -1;
+    }
+    // Padded zeros would not be subtracted.
+    for (k = 0; k < pad.size; k++) {
+      if (pad.data[k] != 0) {
+        return -1;
+      }
+    }
+    return conv->base_axis;
+  }
+#endif /* CONFIG_CONVOLUTION */
+  default:
+    return -1;
+  }
+}
+
+// Mean can be folded into bias of func reading x. Checked before buffers are
+// planned, which give no area to output of merged MeanSubtraction. Mean of
+// each channel of Convolution must be constant over its map.
+static int is_foldable_mean(nn_network_t *n, rt_context_t *c,
+                            nn_function_t *func, rt_variable_t *x,
+                            int mean_index) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  const float *mean =
+      (const float *)NN_GET(n, get_variable(n, mean_index)->data_index);
+  int features = num_of_elements(c, mean_index);
+  int outputs = num_of_elements(c, inputs.data[2]);
+  int size = num_of_elements(c, inputs.data[1]) / outputs;
+  int k; // Iterator
+
+  if (outputs == 0 || size * outputs != num_of_elements(c, inputs.data[1])) {
+    return 0;
+  }
+  if (func->type == NN_FUNCTION_AFFINE) {
+    return size == features;
+  }
+  nn_function_convolution_t *conv = (nn_function_convolution_t *)func;
+  int channels = x->shape.data[conv->base_axis];
+  int groups = conv->group > 0 ? conv->group : 1;
+  int map = channels > 0 ? features / channels : 0;
+  if (map == 0 || channels % groups != 0 || outputs % groups != 0 ||
+      size % (channels / groups) != 0) {
+    return 0;
+  }
+  for (k = 0; k < features; k++) {
+    if (mean[k] != mean[k - k % map]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Index of MeanSubtraction before function i whose output is read only by
+// input 0 of function i, or -1.
+static int find_merged_mean_subtraction(nn_network_t *n, rt_context_t *c,
+                                        const int *uses, int i) {
+  nn_function_t *func = get_function(n, i);
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  int axis = get_mean_subtraction_axis(n, c, uses, func);
+  int features = 1;
+  int j, k; // Iterator
+
+  if (axis < 0 || is_removed_function(c, i)) {
+    return -1;
+  }
+  int index = inputs.data[0];
+  rt_variable_t *x = c->variables + index;
+  if (uses[index] != 1 || axis >= x->shape.size ||
+      is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) ||
+      is_in_list(create_rt_list_from_nn_list(n, n->outputs), index)) {
+    return -1;
+  }
+  for (k = axis; k < x->shape.size; k++) {
+    features *= x->shape.data[k];
+  }
+  for (j = i - 1; j >= 0; j--) {
+    nn_function_t *producer = get_function(n, j);
+    rt_list_t producer_inputs =
+        create_rt_list_from_nn_list(n, producer->inputs);
+    if (!is_in_list(create_rt_list_from_nn_list(n, producer->outputs),
+                    index)) {
+      continue;
+    }
+    // Mean of each feature read by the function, repeated over batch. Third
+    // input, number of updates, is used only in training.
+    return producer->type == NN_FUNCTION_MEAN_SUBTRACTION &&
+                   producer_inputs.size >= 2 &&
+                   producer->outputs.size == 1 &&
+                   is_float_variable(c, producer_inputs.data[0]) &&
+                   is_constant_variable(n, c, uses,
+                                        producer_inputs.data[1]) &&
+                   num_of_elements(c, producer_inputs.data[1]) == features &&
+                   !has_user_function(c, producer) &&
+                   !is_removed_function(c, j) &&
+                   is_foldable_mean(n, c, func, x, producer_inputs.data[1])
+               ? j
+               : -1;
+  }
+  return -1;
+}
+
+// Input of MeanSubtraction merged into function i.
+static int get_subtracted_input(nn_network_t *n, rt_context_t *c, int i) {
+  nn_function_t *func = get_function(n, c->fusions[i].mean_subtraction);
+  return create_rt_list_from_nn_list(n, func->inputs).data[0];
+}
+
+// Input of tiled group whose last function is i.
+static int get_tiled_input(nn_network_t *n, rt_context_t *c, int i) {
+  nn_function_t *func = get_function(n, c->fusions[i].tile);
+  return create_rt_list_from_nn_list(n, func->inputs).data[0];
+}
+
+// Operation of float element wise function whose inputs and output have same
+// number of elements. chained is input which has value of former function in
+// chain, or -1 for the first function which reads input 0. operand is set to
+// the other input of two input function, or -1.
+static int get_elementwise_op(nn_network_t *n, rt_context_t *c,
+                              nn_function_t *func, int chained,
+                              rt_elementwise_op_t *op, int *operand) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int is_binary = 0;
+  int k = 0;
+  int i; // Iterator
+
+  if (outputs.size != 1 || !is_float_variable(c, outputs.data[0]) ||
+      has_user_function(c, func)) {
+    return 0;
+  }
+  for (i = 0; i < inputs.size; i++) {
+    if (!is_float_variable(c, inputs.data[i]) ||
+        num_of_elements(c, inputs.data[i]) !=
+            num_of_elements(c, outputs.data[0])) {
+      return 0;
+    }
+  }
+  if (chained >= 0) {
+    for (k = 0; k < inputs.size && inputs.data[k] != chained; k++) {
+    }
+    if (k == inputs.size) {
+      return 0;
+    }
+  }
+
+  op->alpha = 0.0f;
+  op->scale = 1.0f;
+  op->operand = 0;
+  switch (func->type) {
+  case NN_FUNCTION_ADD_SCALAR:
+    op->type = RT_ELEMENTWISE_ADD;
+    op->alpha = ((nn_function_add_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_MUL_SCALAR:
+    op->type = RT_ELEMENTWISE_MUL;
+    op->alpha = ((nn_function_mul_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_POW_SCALAR:
+    op->type = RT_ELEMENTWISE_POW;
+    op->alpha = ((nn_function_pow_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_R_SUB_SCALAR:
+    op->type = RT_ELEMENTWISE_RSUB;
+    op->alpha = ((nn_function_r_sub_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_R_DIV_SCALAR:
+    op->type = RT_ELEMENTWISE_RDIV;
+    op->alpha = ((nn_function_r_div_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_R_POW_SCALAR:
+    op->type = RT_ELEMENTWISE_RPOW;
+    op->alpha = ((nn_function_r_pow_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_MAXIMUM_SCALAR:
+    op->type = RT_ELEMENTWISE_MAXIMUM;
+    op->alpha = ((nn_function_maximum_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_MINIMUM_SCALAR:
+    op->type = RT_ELEMENTWISE_MINIMUM;
+    op->alpha = ((nn_function_minimum_scalar_t *)func)->val;
+    break;
+  case NN_FUNCTION_ADD2:
+    op->type = RT_ELEMENTWISE_ADD;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_SUB2:
+    op->type = k == 0 ? RT_ELEMENTWISE_SUB : RT_ELEMENTWISE_RSUB;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_MUL2:
+    op->type = RT_ELEMENTWISE_MUL;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_DIV2:
+    op->type = k == 0 ? RT_ELEMENTWISE_DIV : RT_ELEMENTWISE_RDIV;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_POW2:
+    op->type = k == 0 ? RT_ELEMENTWISE_POW : RT_ELEMENTWISE_RPOW;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_MAXIMUM2:
+    op->type = RT_ELEMENTWISE_MAXIMUM;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_MINIMUM2:
+    op->type = RT_ELEMENTWISE_MINIMUM;
+    is_binary = 1;
+    break;
+  case NN_FUNCTION_IDENTITY:
+    op->type = RT_ELEMENTWISE_IDENTITY;
+    break;
+  case NN_FUNCTION_ABS:
+    op->type = RT_ELEMENTWISE_ABS;
+    break;
+  case NN_FUNCTION_EXP:
+    op->type = RT_ELEMENTWISE_EXP;
+    break;
+  case NN_FUNCTION_LOG:
+    op->type = RT_ELEMENTWISE_LOG;
+    break;
+  case NN_FUNCTION_RELU:
+    op->type = RT_ELEMENTWISE_RELU;
+    break;
+  case NN_FUNCTION_LEAKY_RELU_0:
+  case NN_FUNCTION_LEAKY_RELU:
+    op->type = RT_ELEMENTWISE_LEAKY_RELU;
+    op->alpha = ((nn_function_leaky_relu_t *)func)->alpha;
+    break;
+  case NN_FUNCTION_RELU6:
+    op->type = RT_ELEMENTWISE_RELU6;
+    break;
+  case NN_FUNCTION_SIGMOID:
+    op->type = RT_ELEMENTWISE_SIGMOID;
+    break;
+  case NN_FUNCTION_TANH:
+    op->type = RT_ELEMENTWISE_TANH;
+    break;
+  case NN_FUNCTION_SWISH:
+    op->type = RT_ELEMENTWISE_SWISH;
+    break;
+  case NN_FUNCTION_ELU:
+    op->type = RT_ELEMENTWISE_ELU;
+    op->alpha = ((nn_function_elu_t *)func)->alpha;
+    break;
+  case NN_FUNCTION_SELU:
+    op->type = RT_ELEMENTWISE_ELU;
+    op->alpha = ((nn_function_selu_t *)func)->alpha;
+    op->scale = ((nn_function_selu_t *)func)->scale;
+    break;
+  default:
+    return 0;
+  }
+  if (inputs.size != (is_binary ? 2 : 1)) {
+    return 0;
+  }
+  *operand = is_binary ? inputs.data[1 - k] : -1;
+  if (*operand >= 0) {
+    op->operand = c->variables + *operand;
+  }
+  return 1;
+}
+
+// Next function after i which is not removed by graph simplification, or
+// num_of_functions. Functions merged into head may be apart by dead ones.
+static int next_live_function(rt_context_t *c, int i, int num_of_functions) {
+  for (i++; i < num_of_functions && is_removed_function(c, i); i++) {
+  }
+  return i;
+}
+
+// Output of function is read only by next function in chain.
+static int is_chained(nn_network_t *n, rt_context_t *c, const int *uses,
+                      int index, nn_function_t *next) {
+  rt_elementwise_op_t op;
+  int operand;
+  return uses[index] == 1 &&
+         !is_in_list(create_rt_list_from_nn_list(n, n->inputs), index) &&
+         !is_in_list(create_rt_list_from_nn_list(n, n->outputs), index) &&
+         get_elementwise_op(n, c, next, index, &op, &operand);
+}
+
+// Operations of functions from i to fusions[i].chain.
+static rt_return_value_t build_function_chain(nn_network_t *n,
+                                              rt_context_t *c,
+                                              function_fusion_t *fusions,
+                                              int i) {
+  function_fusion_t *fusion = fusions + i;
+  int chained = -1;
+  int k; // Iterator
+
+  fusion->num_of_ops = fusion->chain - i + 1;
+  fusion->ops =
+      rt_malloc_func(sizeof(rt_elementwise_op_t) * fusion->num_of_ops);
+  if (fusion->ops == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (k = i; k <= fusion->chain; k++) {
+    nn_function_t *func = get_function(n, k);
+    get_elementwise_op(n, c, func, chained, fusion->ops + (k - i),
+                       &fusions[k].operand);
+    chained = create_rt_list_from_nn_list(n, func->outputs).data[0];
+    if (k > i) {
+      fusions[k].skip = 1;
+    }
+  }
+  // Input 1 of two input head is already one of its inputs.
+  fusion->operand = -1;
+  return RT_RET_NOERROR;
+}
+
+static void reset_fusion(function_fusion_t *fusion) {
+  fusion->skip = 0;
+  fusion->output = -1;
+  fusion->batch_normalization = -1;
+  fusion->activation = -1;
+  fusion->pooling = -1;
+  fusion->pooled = -1;
+  fusion->weight = 0;
+  fusion->bias = 0;
+  fusion->transpose[0] = -1;
+  fusion->transpose[1] = -1;
+  fusion->softmax = -1;
+  fusion->view[0] = -1;
+  fusion->view[1] = -1;
+  fusion->pad = -1;
+  fusion->pads = 0;
+  fusion->mean_subtraction = -1;
+  fusion->tile = -1;
+  fusion->chain = -1;
+  fusion->operand = -1;
+  fusion->num_of_ops = 0;
+  fusion->ops = 0;
+}
+
+static void cancel_fusion(rt_context_t *c, int i) {
+  function_fusion_t *fusion = c->fusions + i;
+  int k; // Iterator
+  for (k = i + 1; k <= fusion->chain; k++) {
+    c->fusions[k].skip = 0;
+    c->fusions[k].operand = -1;
+  }
+  if (fusion->ops) {
+    rt_free_func(fusion->ops);
+  }
+  fusion->chain = -1;
+  fusion->num_of_ops = 0;
+  fusion->ops = 0;
+  if (fusion->batch_normalization >= 0) {
+    c->fusions[fusion->batch_normalization].skip = 0;
+  }
+  if (fusion->activation >= 0) {
+    c->fusions[fusion->activation].skip = 0;
+  }
+  if (fusion->pooling >= 0) {
+    c->fusions[fusion->pooling].skip = 0;
+  }
+  fusion->output = -1;
+  fusion->batch_normalization = -1;
+  fusion->activation = -1;
+  fusion->pooling = -1;
+  fusion->pooled = -1;
+}
+
+static void cancel_transpose(rt_context_t *c, int i, int k) {
+  c->fusions[c->fusions[i].transpose[k]].skip = 0;
+  c->fusions[i].transpose[k] = -1;
+}
+
+static void cancel_softmax(rt_context_t *c, int i) {
+  c->fusions[c->fusions[i].softmax].skip = 0;
+  c->fusions[i].softmax = -1;
+}
+
+static void cancel_view(rt_context_t *c, int i, int k) {
+  c->fusions[c->fusions[i].view[k]].skip = 0;
+  c->fusions[i].view[k] = -1;
+}
+
+static void cancel_pad(rt_context_t *c, int i) {
+  c->fusions[c->fusions[i].pad].skip = 0;
+  c->fusions[i].pad = -1;
+}
+
+static void cancel_mean_subtraction(rt_context_t *c, int i) {
+  c->fusions[c->fusions[i].mean_subtraction].skip = 0;
+  c->fusions[i].mean_subtraction = -1;
+}
+
+// Functions merged into others by rt_set_function_fusion(). Returns number
+// of functions which merge others, or -1 if chain cannot be allocated.
+static int merge_functions(nn_network_t *n, rt_context_t *c, const int *uses,
+                           function_fusion_t *fusions) {
+  int num_of_functions = n->functions.size;
+  int num_of_fused = 0;
+  int i, j; // Iterator
+
+#ifdef CONFIG_BATCHMATMUL
+  for (i = 1; i < num_of_functions; i++) {
+    nn_function_t *func = get_function(n, i);
+    if (func->type != NN_FUNCTION_BATCH_MATMUL || func->inputs.size != 2 ||
+        has_user_function(c, func) || is_removed_function(c, i)) {
+      continue;
+    }
+    for (j = 0; j < 2; j++) {
+      int transpose = find_merged_transpose(n, c, uses, i, j);
+      if (transpose >= 0) {
+        fusions[i].transpose[j] = transpose;
+        fusions[transpose].skip = 1;
+        num_of_fused++;
+      }
+    }
+  }
+#endif /* CONFIG_BATCHMATMUL */
+
+#if defined(CONFIG_SOFTMAX) && defined(CONFIG_TOPKDATA_FLOAT32)
+  for (i = 1; i < num_of_functions; i++) {
+    nn_function_t *func = get_function(n, i);
+    if (func->type != NN_FUNCTION_TOP_K_DATA || func->inputs.size != 1 ||
+        func->outputs.size != 1 ||
+        !is_float_variable(
+            c, create_rt_list_from_nn_list(n, func->outputs).data[0]) ||
+        has_user_function(c, func) || is_removed_function(c, i)) {
+      continue;
+    }
+    int softmax = find_merged_softmax(n, c, uses, i);
+    if (softmax >= 0) {
+      fusions[i].softmax = softmax;
+      fusions[softmax].skip = 1;
+      num_of_fused++;
+    }
+  }
+#endif /* CONFIG_SOFTMAX && CONFIG_TOPKDATA_FLOAT32 */
+
+  for (i = 1; i < num_of_functions; i++) {
+    if (is_removed_function(c, i) ||
+        !is_broadcast_arithmetic(n, c, get_function(n, i))) {
+      continue;
+    }
+    for (j = 0; j < 2; j++) {
+      int view = find_repeat_view(n, c, uses, i, j);
+      if (view >= 0) {
+        fusions[i].view[j] = view;
+        fusions[view].skip = 1;
+        num_of_fused++;
+      }
+    }
+  }
+
+  for (i = 1; i < num_of_functions; i++) {
+    int pad = find_merged_pad(n, c, uses, i);
+    if (pad >= 0) {
+      fusions[i].pad = pad;
+      fusions[pad].skip = 1;
+      num_of_fused++;
+    }
+  }
+
+  for (i = 1; i < num_of_functions; i++) {
+    int mean_subtraction = find_merged_mean_subtraction(n, c, uses, i);
+    if (mean_subtraction >= 0) {
+      fusions[i].mean_subtraction = mean_subtraction;
+      fusions[mean_subtraction].skip = 1;
+      num_of_fused++;
+    }
+  }
+
+  for (i = 0; i + 1 < num_of_functions; i++) {
+    nn_function_t *head = get_function(n, i);
+    int channel_axis;
+    if (is_removed_function(c, i) ||
+        !is_fusion_head(n, c, head, &channel_axis)) {
+      continue;
+    }
+    int output = create_rt_list_from_nn_list(n, head->outputs).data[0];
+    int next = next_live_function(c, i, num_of_functions);
+    nn_function_t *func;
+    rt_epilogue_t epilogue;
+
+    if (next < num_of_functions) {
+      func = get_function(n, next);
+      if (is_intermediate(n, c, uses, output, func) &&
+          is_foldable_batch_normalization(n, c, uses, head, channel_axis,
+                                          func)) {
+        fusions[i].batch_normalization = next;
+        fusions[next].skip = 1;
+        output = create_rt_list_from_nn_list(n, func->outputs).data[0];
+        next = next_live_function(c, next, num_of_functions);
+      }
+    }
+    if (next < num_of_functions) {
+      func = get_function(n, next);
+      if (is_intermediate(n, c, uses, output, func) &&
+          get_epilogue(func, &epilogue)) {
+        fusions[i].activation = next;
+        fusions[next].skip = 1;
+        output = create_rt_list_from_nn_list(n, func->outputs).data[0];
+        next = next_live_function(c, next, num_of_functions);
+      }
+    }
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_FLOAT32
+    if (next < num_of_functions && head->type != NN_FUNCTION_AFFINE) {
+      func = get_function(n, next);
+      if (is_intermediate(n, c, uses, output, func) &&
+          is_global_average_pooling(n, c, output, func)) {
+        fusions[i].pooling = next;
+        fusions[i].pooled =
+            create_rt_list_from_nn_list(n, func->outputs).data[0];
+        fusions[next].skip = 1;
+        next = next_live_function(c, next, num_of_functions);
+      }
+    }
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_FLOAT32 */
+    if (fusions[i].batch_normalization >= 0 || fusions[i].activation >= 0 ||
+        fusions[i].pooling >= 0) {
+      fusions[i].output = output;
+      num_of_fused++;
+      i = next - 1;
+    }
+  }
+
+  for (i = 0; i + 1 < num_of_functions; i++) {
+    nn_function_t *head = get_function(n, i);
+    rt_elementwise_op_t op;
+    int operand;
+    if (fusions[i].skip || fusions[i].output >= 0 ||
+        fusions[i].view[0] >= 0 || fusions[i].view[1] >= 0 ||
+        is_removed_function(c, i) ||
+        !get_elementwise_op(n, c, head, -1, &op, &operand)) {
+      continue;
+    }
+    int output = create_rt_list_from_nn_list(n, head->outputs).data[0];
+    int next = i + 1;
+    while (next < num_of_functions && !fusions[next].skip &&
+           fusions[next].view[0] < 0 && fusions[next].view[1] < 0 &&
+           !is_removed_function(c, next) &&
+           is_chained(n, c, uses, output, get_function(n, next))) {
+      output =
+          create_rt_list_from_nn_list(n, get_function(n, next)->outputs)
+              .data[0];
+      next++;
+    }
+    if (next > i + 1) {
+      fusions[i].chain = next - 1;
+      fusions[i].output = output;
+      if (build_function_chain(n, c, fusions, i) != RT_RET_NOERROR) {
+        for (j = 0; j < i; j++) {
+          if (fusions[j].ops) {
+            rt_free_func(fusions[j].ops);
+          }
+        }
+        return -1;
+      }
+      num_of_fused++;
+      i = next - 1;
+    }
+  }
+  return num_of_fused;
+}
+
+rt_return_value_t build_function_fusion(nn_network_t *n, rt_context_t *c) {
+  int num_of_functions = n->functions.size;
+  int num_of_fused = 0;
+  int i, j; // Iterator
+
+  c->fusions = 0;
+  // Streaming window and result caching run functions one by one.
+  if ((!c->function_fusion && !c->tile_cache_size) || c->loader.load ||
+      c->window_hop || c->result_caching != RT_RESULT_CACHING_NONE ||
+      num_of_functions < 2) {
+    return RT_RET_NOERROR;
+  }
+
+  int *uses = rt_malloc_func(sizeof(int) * c->num_of_variables);
+  function_fusion_t *fusions =
+      rt_malloc_func(sizeof(function_fusion_t) * num_of_functions);
+  if (uses == 0 || fusions == 0) {
+    rt_free_func(uses);
+    rt_free_func(fusions);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    reset_fusion(fusions + i);
+  }
+
+  // Number of functions which read each variable. Dead functions never read,
+  // and they are neither merged nor merge others.
+  for (i = 0; i < c->num_of_variables; i++) {
+    uses[i] = 0;
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    nn_function_t *func = get_function(n, i);
+    if (is_removed_function(c, i)) {
+      continue;
+    }
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    for (j = 0; j < inputs.size; j++) {
+      if (inputs.data[j] >= 0 && inputs.data[j] < c->num_of_variables) {
+        uses[inputs.data[j]]++;
+      }
+    }
+  }
+
+  if (c->function_fusion) {
+    num_of_fused = merge_functions(n, c, uses, fusions);
+  }
+  if (num_of_fused >= 0) {
+    num_of_fused += find_tiled_groups(n, c, uses, fusions);
+  }
+  rt_free_func(uses);
+
+  if (num_of_fused < 0) {
+    rt_free_func(fusions);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  if (num_of_fused == 0) {
+    rt_free_func(fusions);
+    return RT_RET_NOERROR;
+  }
+  c->fusions = fusions;
+  return RT_RET_NOERROR;
+}
+
+void record_function_fusion(nn_network_t *n, rt_context_t *c,
+                            int32_t *record) {
+  int i; // Iterator
+  for (i = 0; i < n->functions.size; i++, record += RT_FUSION_RECORD_SIZE) {
+    const function_fusion_t *fusion = c->fusions + i;
+    record[0] = fusion->skip;
+    record[1] = fusion->output;
+    record[2] = fusion->batch_normalization;
+    record[3] = fusion->activation;
+    record[4] = fusion->pooling;
+    record[5] = fusion->pooled;
+    record[6] = fusion->transpose[0];
+    record[7] = fusion->transpose[1];
+    record[8] = fusion->pad;
+    record[9] = fusion->chain;
+    record[10] = fusion->softmax;
+    record[11] = fusion->view[0];
+    record[12] = fusion->view[1];
+    record[13] = fusion->mean_subtraction;
+    record[14] = fusion->tile;
+  }
+}
+
+rt_return_value_t restore_function_fusion(nn_network_t *n, rt_context_t *c,
+                                          const int32_t *record) {
+  int num_of_functions = n->functions.size;
+  function_fusion_t *fusions;
+  int i, j; // Iterator
+
+  c->fusions = 0;
+  if (record == 0) {
+    return RT_RET_NOERROR;
+  }
+  fusions = rt_malloc_func(sizeof(function_fusion_t) * num_of_functions);
+  if (fusions == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < num_of_functions; i++, record += RT_FUSION_RECORD_SIZE) {
+    function_fusion_t *fusion = fusions + i;
+    reset_fusion(fusion);
+    fusion->skip = record[0];
+    fusion->output = record[1];
+    fusion->batch_normalization = record[2];
+    fusion->activation = record[3];
+    fusion->pooling = record[4];
+    fusion->pooled = record[5];
+    fusion->transpose[0] = record[6];
+    fusion->transpose[1] = record[7];
+    fusion->pad = record[8];
+    fusion->chain = record[9];
+    fusion->softmax = record[10];
+    fusion->view[0] = record[11];
+    fusion->view[1] = record[12];
+    fusion->mean_subtraction = record[13];
+    fusion->tile = record[14];
+  }
+  // Operations of chains are not recorded, they are found again.
+  for (i = 0; i < num_of_functions; i++) {
+    if (fusions[i].chain >= 0 &&
+        build_function_chain(n, c, fusions, i) != RT_RET_NOERROR) {
+      for (j = 0; j < i; j++) {
+        if (fusions[j].ops) {
+          rt_free_func(fusions[j].ops);
+        }
+      }
+      rt_free_func(fusions);
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  }
+  c->fusions = fusions;
+  return RT_RET_NOERROR;
+}
+
+// Fusion of function i in source of clone c, whose folded weight and bias are
+// used by clone too, or NULL.
+static const function_fusion_t *get_source_fusion(const rt_context_t *c,
+                                                  int i) {
+  return c->source && c->source->fusions ? c->source->fusions + i : 0;
+}
+
+// b' = b - W * mean for each output. Weight of Convolution is calculated as
+// [output][input channel of group][kernel], and mean of each input channel
+// is the first one of its map.
+static rt_return_value_t fold_mean_subtraction(nn_network_t *n,
+                                               rt_context_t *c, int i) {
+  function_fusion_t *fusion = c->fusions + i;
+  const function_fusion_t *shared = get_source_fusion(c, i);
+  nn_function_t *head = get_function(n, i);
+  nn_function_t *ms = get_function(n, fusion->mean_subtraction);
+  rt_list_t inputs = create_rt_list_from_nn_list(n, head->inputs);
+  int mean_index = create_rt_list_from_nn_list(n, ms->inputs).data[1];
+  const float *mean = (const float *)c->variables[mean_index].data;
+  const float *weight = (const float *)c->variables[inputs.data[1]].data;
+  rt_variable_t *bias = c->variables + inputs.data[2];
+  int features = num_of_elements(c, mean_index);
+  int outputs = num_of_elements(c, inputs.data[2]);
+  int size = num_of_elements(c, inputs.data[1]) / outputs;
+  int channels = features, groups = 1, map = 1, kernel = 1;
+  int o, k, l; // Iterator
+
+  if (head->type != NN_FUNCTION_AFFINE) {
+    nn_function_convolution_t *conv = (nn_function_convolution_t *)head;
+    rt_variable_t *x = c->variables + get_subtracted_input(n, c, i);
+    channels = x->shape.data[conv->base_axis];
+    groups = conv->group > 0 ? conv->group : 1;
+    map = features / channels;
+    kernel = size / (channels / groups);
+  }
+
+  if (shared && shared->bias) {
+    // Bias of source is final one, also when BatchNormalization is folded.
+    fusion->bias = shared->bias;
+    bias->data = fusion->bias;
+    return RT_RET_NOERROR;
+  }
+  fusion->bias = rt_malloc_func(sizeof(float) * outputs);
+  if (fusion->bias == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (o = 0; o < outputs; o++) {
+    const float *w = weight + o * size;
+    int first = o / (outputs / groups) * (channels / groups);
+    double sum = 0.0;
+    for (k = 0; k < channels / groups; k++) {
+      float m = mean[(first + k) * map];
+      for (l = 0; l < kernel; l++) {
+        sum += (double)w[k * kernel + l] * m;
+      }
+    }
+    fusion->bias[o] = ((const float *)bias->data)[o] - (float)sum;
+  }
+  bias->data = fusion->bias;
+  return RT_RET_NOERROR;
+}
+
+// W' = W * gamma / sqrt(var + eps), b' = (b - mean) * gamma / sqrt(var + eps)
+// + beta for each output channel.
+static rt_return_value_t fold_batch_normalization(nn_network_t *n,
+                                                  rt_context_t *c, int i) {
+  function_fusion_t *fusion = c->fusions + i;
+  const function_fusion_t *shared = get_source_fusion(c, i);
+  nn_function_t *head = get_function(n, i);
+  nn_function_batch_normalization_t *bn =
+      (nn_function_batch_normalization_t *)get_function(
+          n, fusion->batch_normalization);
+  rt_list_t inputs = create_rt_list_from_nn_list(n, head->inputs);
+  rt_list_t bn_inputs = create_rt_list_from_nn_list(n, bn->inputs);
+  rt_list_t axes = create_rt_list_from_nn_list(n, bn->axes);
+  rt_variable_t *y =
+      c->variables + create_rt_list_from_nn_list(n, head->outputs).data[0];
+  rt_variable_t *weight = c->variables + inputs.data[1];
+  rt_variable_t *bias = inputs.size > 2 ? c->variables + inputs.data[2] : 0;
+  rt_variable_t *beta_variable = c->variables + bn_inputs.data[1];
+  const float *beta = (const float *)beta_variable->data;
+  const float *gamma = (const float *)c->variables[bn_inputs.data[2]].data;
+  const float *mean = (const float *)c->variables[bn_inputs.data[3]].data;
+  const float *var = (const float *)c->variables[bn_inputs.data[4]].data;
+  int channels = y->shape.data[axes.data[0]];
+  int size = num_of_elements(c, inputs.data[1]) / channels;
+  int o, k; // Iterator
+
+  if (shared && shared->weight) {
+    // Source folded the same weight and bias.
+    fusion->weight = shared->weight;
+    fusion->bias = shared->bias;
+  } else {
+    // Bias may be folded from MeanSubtraction already, and is updated then.
+    fusion->weight = rt_malloc_func(sizeof(float) * channels * size);
+    if (fusion->bias == 0) {
+      fusion->bias = rt_malloc_func(sizeof(float) * channels);
+    }
+    if (fusion->weight == 0 || fusion->bias == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    for (o = 0; o < channels; o++) {
+      const float *w = (const float *)weight->data + o * size;
+      float scale = gamma[o] / sqrtf(var[o] + bn->eps);
+      for (k = 0; k < size; k++) {
+        fusion->weight[o * size + k] = w[k] * scale;
+      }
+      fusion->bias[o] =
+          ((bias ? ((const float *)bias->data)[o] : 0.0f) - mean[o]) * scale +
+          beta[o];
+    }
+  }
+
+  weight->data = fusion->weight;
+  if (bias) {
+    bias->data = fusion->bias;
+  } else {
+    // Beta is used only by skipped BatchNormalization, so it becomes bias
+    // of the function. Bias has one axis of output channels.
+    beta_variable->data = fusion->bias;
+    beta_variable->shape.size = 1;
+    beta_variable->shape.data = y->shape.data + axes.data[0];
+  }
+  return RT_RET_NOERROR;
+}
+
+// Function j writes memory in [begin, end) in forward.
+static int writes_memory(nn_network_t *n, rt_context_t *c, int j,
+                         uint8_t *begin, uint8_t *end) {
+  rt_list_t outputs =
+      create_rt_list_from_nn_list(n, get_function(n, j)->outputs);
+  int l; // Iterator
+
+  if (c->fusions[j].skip || is_removed_function(c, j)) {
+    return 0;
+  }
+  for (l = 0; l < outputs.size; l++) {
+    rt_variable_t *output =
+        c->variables +
+        (c->fusions[j].output >= 0 ? c->fusions[j].output : outputs.data[l]);
+    uint8_t *output_begin = output->data;
+    uint8_t *output_end = output_begin + calc_variable_data_size(output);
+    if (begin < output_end && output_begin < end) {
+      return 1;
+    }
+  }
+  if (c->fusions[j].pooled >= 0) {
+    rt_variable_t *pooled = c->variables + c->fusions[j].pooled;
+    uint8_t *pooled_begin = pooled->data;
+    uint8_t *pooled_end = pooled_begin + calc_variable_data_size(pooled);
+    return begin < pooled_end && pooled_begin < end;
+  }
+  return 0;
+}
+
+static int is_variable_overlapped(rt_context_t *c, rt_variable_t *output,
+                                  int index) {
+  rt_variable_t *input = c->variables + index;
+  uint8_t *begin = output->data;
+  uint8_t *end = begin + calc_variable_data_size(output);
+  uint8_t *input_begin = input->data;
+  uint8_t *input_end = input_begin + calc_variable_data_size(input);
+  return begin < input_end && input_begin < end;
+}
+
+rt_return_value_t prepare_function_fusion(nn_network_t *n, rt_context_t *c) {
+  int num_of_functions = n->functions.size;
+  int i, j, k; // Iterator
+
+  if (c->fusions == 0) {
+    return RT_RET_NOERROR;
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    for (k = 0; k < 2; k++) {
+      if (c->fusions[i].transpose[k] < 0) {
+        continue;
+      }
+      // Input of Transpose is read by BatchMatmul later, so functions
+      // between them must not write its buffer when it is shared.
+      rt_variable_t *input = c->variables + get_transposed_input(n, c, i, k);
+      uint8_t *begin = input->data;
+      uint8_t *end = begin + calc_variable_data_size(input);
+      for (j = c->fusions[i].transpose[k] + 1; j <= i; j++) {
+        if (writes_memory(n, c, j, begin, end)) {
+          cancel_transpose(c, i, k);
+          break;
+        }
+      }
+    }
+    if (c->fusions[i].softmax >= 0) {
+      // TopKData reads input of Softmax while it writes its output.
+      rt_variable_t *input = c->variables + get_softmax_input(n, c, i);
+      uint8_t *begin = input->data;
+      uint8_t *end = begin + calc_variable_data_size(input);
+      for (j = c->fusions[i].softmax + 1; j <= i; j++) {
+        if (writes_memory(n, c, j, begin, end)) {
+          cancel_softmax(c, i);
+          break;
+        }
+      }
+    }
+    for (k = 0; k < 2; k++) {
+      if (c->fusions[i].view[k] < 0) {
+        continue;
+      }
+      // Input of Broadcast, BroadcastTo or Tile is read by the function.
+      rt_variable_t *input = c->variables + get_viewed_input(n, c, i, k);
+      uint8_t *begin = input->data;
+      uint8_t *end = begin + calc_variable_data_size(input);
+      for (j = c->fusions[i].view[k] + 1; j <= i; j++) {
+        if (writes_memory(n, c, j, begin, end)) {
+          cancel_view(c, i, k);
+          break;
+        }
+      }
+    }
+    if (c->fusions[i].pad >= 0) {
+      // Input of Pad is read by the function instead of output of Pad.
+      rt_variable_t *input = c->variables + get_padded_input(n, c, i);
+      uint8_t *begin = input->data;
+      uint8_t *end = begin + calc_variable_data_size(input);
+      for (j = c->fusions[i].pad + 1; j <= i; j++) {
+        if (writes_memory(n, c, j, begin, end)) {
+          cancel_pad(c, i);
+          break;
+        }
+      }
+    }
+    if (c->fusions[i].mean_subtraction >= 0) {
+      // Input of MeanSubtraction is read by the function instead.
+      rt_variable_t *input = c->variables + get_subtracted_input(n, c, i);
+      uint8_t *begin = input->data;
+      uint8_t *end = begin + calc_variable_data_size(input);
+      for (j = c->fusions[i].mean_subtraction + 1; j <= i; j++) {
+        if (writes_memory(n, c, j, begin, end)) {
+          cancel_mean_subtraction(c, i);
+          break;
+        }
+      }
+      if (c->fusions[i].mean_subtraction >= 0) {
+        rt_return_value_t ret = fold_mean_subtraction(n, c, i);
+        if (ret != RT_RET_NOERROR) {
+          return ret;
+        }
+      }
+    }
+    if (c->fusions[i].output < 0) {
+      continue;
+    }
+    // Buffers without planning may share output of merged function with
+    // inputs of head, since they were not used at the same time.
+    // Operands of chain are read while output is written, too. Chain may
+    // write output over input 0 in place.
+    nn_function_t *head = get_function(n, i);
+    rt_list_t inputs = create_rt_list_from_nn_list(n, head->inputs);
+    rt_variable_t *output = c->variables + c->fusions[i].output;
+    int overlapped = 0;
+    for (j = 0; j < inputs.size; j++) {
+      if (j == 0 && c->fusions[i].chain >= 0 &&
+          c->variables[inputs.data[0]].data == output->data) {
+        continue;
+      }
+      if (j == 0 &&
+          (c->fusions[i].pad >= 0 || c->fusions[i].mean_subtraction >= 0)) {
+        // Output of merged Pad or MeanSubtraction is not written, and their
+        // inputs are checked below.
+        continue;
+      }
+      if (j == 0 && c->fusions[i].tile >= 0) {
+        // Last function of tiled group reads input of the group instead.
+        overlapped |=
+            is_variable_overlapped(c, output, get_tiled_input(n, c, i));
+        continue;
+      }
+      overlapped |= is_variable_overlapped(c, output, inputs.data[j]);
+    }
+    if (c->fusions[i].pad >= 0) {
+      overlapped |=
+          is_variable_overlapped(c, output, get_padded_input(n, c, i));
+    }
+    if (c->fusions[i].mean_subtraction >= 0) {
+      overlapped |=
+          is_variable_overlapped(c, output, get_subtracted_input(n, c, i));
+    }
+    for (j = i + 1; j <= c->fusions[i].chain; j++) {
+      if (c->fusions[j].operand >= 0) {
+        overlapped |= is_variable_overlapped(c, output, c->fusions[j].operand);
+      }
+    }
+    // Pooling reads feature map while it writes pooled output.
+    if (c->fusions[i].pooled >= 0) {
+      overlapped |= is_variable_overlapped(c, output, c->fusions[i].pooled);
+    }
+    // Function of tiled group before the last one writes bands of its own,
+    // and its output has no memory.
+    if (overlapped && !c->fusions[i].skip) {
+      cancel_fusion(c, i);
+    }
+    if (c->fusions[i].batch_normalization >= 0) {
+      rt_return_value_t ret = fold_batch_normalization(n, c, i);
+      if (ret != RT_RET_NOERROR) {
+        return ret;
+      }
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+// Function i reads input of merged Pad, and its pad is widened by the Pad.
+static rt_return_value_t connect_padded_input(nn_network_t *n, rt_context_t *c,
+                                              int i) {
+  function_fusion_t *fusion = c->fusions + i;
+  nn_function_t *func = get_function(n, i);
+  int input = create_rt_list_from_nn_list(n, func->inputs).data[0];
+  int ndim = c->variables[input].shape.size;
+  rt_list_t pad_width = create_rt_list_from_nn_list(
+      n, ((nn_function_pad_t *)get_function(n, fusion->pad))->pad_width);
+  rt_list_t pad;
+  int first = get_first_padded_axis(n, c, func, input, &pad);
+  int k; // Iterator
+
+  fusion->pads = rt_malloc_func(sizeof(int) * pad.size);
+  if (fusion->pads == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (k = 0; k < pad.size; k++) {
+    fusion->pads[k] =
+        pad.data[k] + get_pad_width(pad_width, ndim, first + k, 0);
+  }
+  c->functions[i].func.inputs[0] = c->variables + get_padded_input(n, c, i);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t connect_fused_function(nn_network_t *n, rt_context_t *c,
+                                         int i) {
+  rt_function_t *f = &c->functions[i].func;
+  function_fusion_t *fusion;
+  int k; // Iterator
+
+  if (c->fusions == 0) {
+    return RT_RET_NOERROR;
+  }
+  fusion = c->fusions + i;
+  if (fusion->transpose[0] >= 0 || fusion->transpose[1] >= 0) {
+    // Local context is allocated from this copy of BatchMatmul.
+    fusion->batch_matmul = *(nn_function_batch_matmul_t *)c->functions[i].info;
+    for (k = 0; k < 2; k++) {
+      if (fusion->transpose[k] < 0) {
+        continue;
+      }
+      f->inputs[k] = c->variables + get_transposed_input(n, c, i, k);
+      if (k == 0) {
+        fusion->batch_matmul.transpose_a = !fusion->batch_matmul.transpose_a;
+      } else {
+        fusion->batch_matmul.transpose_b = !fusion->batch_matmul.transpose_b;
+      }
+    }
+    c->functions[i].info = (nn_function_t *)&fusion->batch_matmul;
+  }
+  if (fusion->softmax >= 0) {
+    f->inputs[0] = c->variables + get_softmax_input(n, c, i);
+  }
+  for (k = 0; k < 2; k++) {
+    if (fusion->view[k] >= 0) {
+      f->inputs[k] = c->variables + get_viewed_input(n, c, i, k);
+    }
+  }
+  if (fusion->pad >= 0) {
+    rt_return_value_t ret = connect_padded_input(n, c, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  if (fusion->mean_subtraction >= 0) {
+    f->inputs[0] = c->variables + get_subtracted_input(n, c, i);
+  }
+  if (fusion->output < 0) {
+    return RT_RET_NOERROR;
+  }
+  f->outputs[0] = c->variables + fusion->output;
+  if (fusion->batch_normalization >= 0 && f->num_of_inputs == 2) {
+    nn_function_t *bn = get_function(n, fusion->batch_normalization);
+    rt_variable_t **inputs = rt_malloc_func(sizeof(rt_variable_t *) * 3);
+    if (inputs == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    inputs[0] = f->inputs[0];
+    inputs[1] = f->inputs[1];
+    inputs[2] = c->variables + ((int *)NN_GET(n, bn->inputs.list))[1];
+    rt_free_func(f->inputs);
+    f->inputs = inputs;
+    f->num_of_inputs = 3;
+  }
+  return RT_RET_NOERROR;
+}
+
+// Operands are appended to inputs of head, so that dependency graph waits for
+// functions writing them. Allocated local context does not read them.
+static rt_return_value_t connect_chain_operands(rt_context_t *c, int i) {
+  rt_function_t *f = &c->functions[i].func;
+  int num_of_inputs = f->num_of_inputs;
+  int k; // Iterator
+
+  for (k = i + 1; k <= c->fusions[i].chain; k++) {
+    num_of_inputs += c->fusions[k].operand >= 0;
+  }
+  if (num_of_inputs == f->num_of_inputs) {
+    return RT_RET_NOERROR;
+  }
+  rt_variable_t **inputs =
+      rt_malloc_func(sizeof(rt_variable_t *) * num_of_inputs);
+  if (inputs == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  num_of_inputs = 0;
+  for (k = 0; k < f->num_of_inputs; k++) {
+    inputs[num_of_inputs++] = f->inputs[k];
+  }
+  for (k = i + 1; k <= c->fusions[i].chain; k++) {
+    if (c->fusions[k].operand >= 0) {
+      inputs[num_of_inputs++] = c->variables + c->fusions[k].operand;
+    }
+  }
+  rt_free_func(f->inputs);
+  f->inputs = inputs;
+  f->num_of_inputs = num_of_inputs;
+  return RT_RET_NOERROR;
+}
+
+// Output of merged pooling is appended to outputs of head, so that
+// dependency graph sees that head writes it.
+static rt_return_value_t connect_pooled_output(rt_context_t *c, int i) {
+  rt_function_t *f = &c->functions[i].func;
+  int k; // Iterator
+
+  rt_variable_t **outputs =
+      rt_malloc_func(sizeof(rt_variable_t *) * (f->num_of_outputs + 1));
+  if (outputs == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (k = 0; k < f->num_of_outputs; k++) {
+    outputs[k] = f->outputs[k];
+  }
+  outputs[k] = c->variables + c->fusions[i].pooled;
+  rt_free_func(f->outputs);
+  f->outputs = outputs;
+  f->num_of_outputs++;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t set_fused_function_epilogue(nn_network_t *n,
+                                              rt_context_t *c, int i) {
+  if (c->fusions && c->fusions[i].ops) {
+    return connect_chain_operands(c, i);
+  }
+#ifdef CONFIG_TOPKDATA_FLOAT32
+  if (c->fusions && c->fusions[i].softmax >= 0) {
+    return set_top_k_data_softmax(&c->functions[i].func) ==
+                   RT_FUNCTION_ERROR_NOERROR
+               ? RT_RET_NOERROR
+               : RT_RET_ERROR_NO_MATCHING_FUNCTION;
+  }
+#endif /* CONFIG_TOPKDATA_FLOAT32 */
+  if (c->fusions && c->fusions[i].pooled >= 0) {
+    rt_return_value_t pooled_ret = connect_pooled_output(c, i);
+    if (pooled_ret != RT_RET_NOERROR) {
+      return pooled_ret;
+    }
+  }
+  return set_merged_activation(n, c, i, &c->functions[i].func);
+}
+
+rt_return_value_t set_merged_activation(nn_network_t *n, rt_context_t *c,
+                                        int i, rt_function_t *f) {
+  rt_function_error_t ret = RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  rt_epilogue_t epilogue;
+
+  if (c->fusions == 0 || c->fusions[i].activation < 0) {
+    return RT_RET_NOERROR;
+  }
+  get_epilogue(get_function(n, c->fusions[i].activation), &epilogue);
+  switch (c->functions[i].info->type) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION:
+    ret = set_convolution_epilogue(f, &epilogue);
+    break;
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+#ifdef CONFIG_AFFINE
+  case NN_FUNCTION_AFFINE:
+    ret = set_affine_epilogue(f, &epilogue);
+    break;
+#endif /* CONFIG_AFFINE */
+  default:
+    break;
+  }
+  return ret == RT_FUNCTION_ERROR_NOERROR ? RT_RET_NOERROR
+                                          : RT_RET_ERROR_NO_MATCHING_FUNCTION;
+}
+
+int allocate_padded_function_context(nn_network_t *n, rt_context_t *c, int i,
+                                     rt_function_error_t *error) {
+  rt_function_context_t *function_context = c->functions + i;
+  nn_function_t *function = function_context->info;
+  rt_list_t pad;
+
+  if (c->fusions == 0 || c->fusions[i].pad < 0) {
+    return 0;
+  }
+  pad.data = c->fusions[i].pads;
+  (void)pad; // Not read when no function with pad is built.
+
+  // Same as allocate_function_context() except pad.
+  switch (function->type) {
+#ifdef CONFIG_CONVOLUTION
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION: {
+    function_context->func.free_local_context_func =
+        free_convolution_local_context;
+    nn_function_convolution_t *f = (nn_function_convolution_t *)function;
+    convolution_local_context_t *ctx =
+        rt_malloc_func(sizeof(convolution_local_context_t));
+    if (ctx == 0) {
+      *error = RT_FUNCTION_ERROR_MALLOC;
+      return 1;
+    }
+    pad.size = f->pad.size;
+    ctx->base_axis = f->base_axis;
+    ctx->pad = pad;
+    ctx->stride = create_rt_list_from_nn_list(n, f->stride);
+    ctx->dilation = create_rt_list_from_nn_list(n, f->dilation);
+    ctx->group = f->group;
+    ctx->channel_last =
+        function->type == NN_FUNCTION_CONVOLUTION && f->channel_last;
+    function_context->func.local_context = ctx;
+    *error = allocate_convolution_local_context(&function_context->func);
+  } break;
+#endif /* CONFIG_CONVOLUTION */
+#ifdef CONFIG_DEPTHWISECONVOLUTION
+  case NN_FUNCTION_DEPTHWISE_CONVOLUTION: {
+    function_context->func.free_local_context_func =
+        free_depthwise_convolution_local_context;
+    nn_function_depthwise_convolution_t *f =
+        (nn_function_depthwise_convolution_t *)function;
+    depthwise_convolution_local_context_t *ctx =
+        rt_malloc_func(sizeof(depthwise_convolution_local_context_t));
+    if (ctx == 0) {
+      *error = RT_FUNCTION_ERROR_MALLOC;
+      return 1;
+    }
+    pad.size = f->pad.size;
+    ctx->base_axis = f->base_axis;
+    ctx->pad = pad;
+    ctx->stride = create_rt_list_from_nn_list(n, f->stride);
+    ctx->dilation = create_rt_list_from_nn_list(n, f->dilation);
+    ctx->multiplier = f->multiplier;
+    function_context->func.local_context = ctx;
+    *error = allocate_depthwise_convolution_local_context(
+        &function_context->func);
+  } break;
+#endif /* CONFIG_DEPTHWISECONVOLUTION */
+#ifdef CONFIG_AVERAGEPOOLING
+  case NN_FUNCTION_AVERAGE_POOLING_0:
+  case NN_FUNCTION_AVERAGE_POOLING: {
+    function_context->func.free_local_context_func =
+        free_average_pooling_local_context;
+    nn_function_average_pooling_t *f =
+        (nn_function_average_pooling_t *)function;
+    average_pooling_local_context_t *ctx =
+        rt_malloc_func(sizeof(average_pooling_local_context_t));
+    if (ctx == 0) {
+      *error = RT_FUNCTION_ERROR_MALLOC;
+      return 1;
+    }
+    pad.size = f->pad.size;
+    ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
+    ctx->stride = create_rt_list_from_nn_list(n, f->stride);
+    ctx->ignore_border = f->ignore_border;
+    ctx->pad = pad;
+    ctx->channel_last =
+        function->type == NN_FUNCTION_AVERAGE_POOLING && f->channel_last;
+    ctx->including_pad = 1;
+    function_context->func.local_context = ctx;
+    *error = allocate_average_pooling_local_context(&function_context->func);
+  } break;
+#endif /* CONFIG_AVERAGEPOOLING */
+#ifdef CONFIG_SUMPOOLING
+  case NN_FUNCTION_SUM_POOLING_0:
+  case NN_FUNCTION_SUM_POOLING: {
+    function_context->func.free_local_context_func =
+        free_sum_pooling_local_context;
+    nn_function_sum_pooling_t *f = (nn_function_sum_pooling_t *)function;
+    sum_pooling_local_context_t *ctx =
+        rt_malloc_func(sizeof(sum_pooling_local_context_t));
+    if (ctx == 0) {
+      *error = RT_FUNCTION_ERROR_MALLOC;
+      return 1;
+    }
+    pad.size = f->pad.size;
+    ctx->kernel = create_rt_list_from_nn_list(n, f->kernel);
+    ctx->stride = create_rt_list_from_nn_list(n, f->stride);
+    ctx->ignore_border = f->ignore_border;
+    ctx->pad = pad;
+    ctx->channel_last =
+        function->type == NN_FUNCTION_SUM_POOLING && f->channel_last;
+    function_context->func.local_context = ctx;
+    *error = allocate_sum_pooling_local_context(&function_context->func);
+  } break;
+#endif /* CONFIG_SUMPOOLING */
+  default:
+    return 0;
+  }
+  return 1;
+}
+
+rt_function_error_t exec_function_chain(rt_context_t *c, int i) {
+  rt_function_t *f = &c->functions[i].func;
+  calc_elementwise_chain(
+      (const float *)f->inputs[0]->data, (float *)f->outputs[0]->data,
+      (int)(calc_variable_data_size(f->outputs[0]) / sizeof(float)),
+      c->fusions[i].ops, c->fusions[i].num_of_ops);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void exec_function_pooling(rt_context_t *c, int i) {
+#ifdef CONFIG_GLOBALAVERAGEPOOLING_FLOAT32
+  rt_variable_t *x = c->functions[i].func.outputs[0];
+  rt_variable_t *y = c->variables + c->fusions[i].pooled;
+  const int maps = (int)(calc_variable_data_size(y) / sizeof(float));
+  calc_global_average_pooling(
+      (const float *)x->data, (float *)y->data, maps,
+      (int)(calc_variable_data_size(x) / sizeof(float)) / maps);
+#endif /* CONFIG_GLOBALAVERAGEPOOLING_FLOAT32 */
+}
+
+void free_function_fusion(rt_context_t *c) {
+  int i; // Iterator
+  if (c->fusions == 0) {
+    return;
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    // Folded weight and bias of clone are owned by source.
+    const function_fusion_t *shared = get_source_fusion(c, i);
+    if (c->fusions[i].weight &&
+        (shared == 0 || shared->weight != c->fusions[i].weight)) {
+      rt_free_func(c->fusions[i].weight);
+    }
+    if (c->fusions[i].bias &&
+        (shared == 0 || shared->bias != c->fusions[i].bias)) {
+      rt_free_func(c->fusions[i].bias);
+    }
+    if (c->fusions[i].ops) {
+      rt_free_func(c->fusions[i].ops);
+    }
+    if (c->fusions[i].pads) {
+      rt_free_func(c->fusions[i].pads);
+    }
+  }
+  rt_free_func(c->fusions);
+  c->fusions = 0;
+}
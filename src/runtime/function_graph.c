@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+typedef struct {
+  uint8_t *begin;
+  uint8_t *end;
+} memory_range_t;
+
+static int is_overlapped(const memory_range_t *a, const memory_range_t *b) {
+  return a->begin < b->end && b->begin < a->end;
+}
+
+static int is_list_overlapped(rt_context_t *c, const memory_range_t *ranges,
+                              rt_variable_t **a, int num_of_a,
+                              rt_variable_t **b, int num_of_b) {
+  int i, j; // Iterator
+  for (i = 0; i < num_of_a; i++) {
+    if (a[i] == 0) {
+      continue;
+    }
+    for (j = 0; j < num_of_b; j++) {
+      if (b[j] != 0 && is_overlapped(ranges + (a[i] - c->variables),
+                                     ranges + (b[j] - c->variables))) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Function `later` must wait for function `earlier` if one of them writes
+// memory which the other reads or writes. Memory is compared instead of
+// variable ids because variables may share buffers.
+static int is_dependent(rt_context_t *c, const memory_range_t *ranges,
+                        rt_function_t *earlier, rt_function_t *later) {
+  return is_list_overlapped(c, ranges, earlier->outputs,
+                            earlier->num_of_outputs, later->inputs,
+                            later->num_of_inputs) ||
+         is_list_overlapped(c, ranges, earlier->outputs,
+                            earlier->num_of_outputs, later->outputs,
+                            later->num_of_outputs) ||
+         is_list_overlapped(c, ranges, earlier->inputs, earlier->num_of_inputs,
+                            later->outputs, later->num_of_outputs);
+}
+
+rt_return_value_t build_function_graph(rt_context_t *c,
+                                       function_graph_t **graph) {
+  int i, j; // Iterator
+  int n = c->num_of_functions;
+  int num_of_edges = 0;
+  int is_chain = 1;
+  function_graph_t *g;
+
+  *graph = 0;
+  if (n < 2) {
+    return RT_RET_NOERROR;
+  }
+
+  memory_range_t *ranges =
+      rt_malloc_func(sizeof(memory_range_t) * c->num_of_variables);
+  if (ranges == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < c->num_of_variables; i++) {
+    ranges[i].begin = c->variables[i].data;
+    ranges[i].end =
+        ranges[i].begin + calc_variable_data_size(c->variables + i);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Count edges. A network whose functions all depend on the previous one has
+  // only one order to run, graph is not built for it.
+  for (j = 1; j < n; j++) {
+    for (i = 0; i < j; i++) {
+      if (is_dependent(c, ranges, &c->functions[i].func,
+                       &c->functions[j].func)) {
+        num_of_edges++;
+      } else if (i == j - 1) {
+        is_chain = 0;
+      }
+    }
+  }
+  if (is_chain) {
+    rt_free_func(ranges);
+    return RT_RET_NOERROR;
+  }
+
+  g = rt_malloc_func(sizeof(function_graph_t));
+  if (g == 0) {
+    rt_free_func(ranges);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  g->num_of_nodes = n;
+  g->num_of_dependencies = rt_malloc_func(sizeof(int) * n);
+  g->successor_offsets = rt_malloc_func(sizeof(int) * (n + 1));
+  g->successors = rt_malloc_func(sizeof(int) * (num_of_edges + 1));
+  g->remaining = rt_malloc_func(sizeof(int) * n);
+  g->ready = rt_malloc_func(sizeof(int) * n);
+  if (g->num_of_dependencies == 0 || g->successor_offsets == 0 ||
+      g->successors == 0 || g->remaining == 0 || g->ready == 0) {
+    free_function_graph(g);
+    rt_free_func(ranges);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Fill edges. Successors of function i are stored in
+  // successors[successor_offsets[i]] ... successors[successor_offsets[i+1]-1].
+  for (i = 0; i <= n; i++) {
+    g->successor_offsets[i] = 0;
+  }
+  for (i = 0; i < n; i++) {
+    g->num_of_dependencies[i] = 0;
+  }
+  for (j = 1; j < n; j++) {
+    for (i = 0; i < j; i++) {
+      if (is_dependent(c, ranges, &c->functions[i].func,
+                       &c->functions[j].func)) {
+        g->successor_offsets[i + 1]++;
+        g->num_of_dependencies[j]++;
+      }
+    }
+  }
+  for (i = 0; i < n; i++) {
+    g->successor_offsets[i + 1] += g->successor_offsets[i];
+    g->remaining[i] = g->successor_offsets[i];
+  }
+  for (j = 1; j < n; j++) {
+    for (i = 0; i < j; i++) {
+      if (is_dependent(c, ranges, &c->functions[i].func,
+                       &c->functions[j].func)) {
+        g->successors[g->remaining[i]++] = j;
+      }
+    }
+  }
+
+  rt_free_func(ranges);
+  *graph = g;
+  return RT_RET_NOERROR;
+}
+
+void free_function_graph(function_graph_t *graph) {
+  rt_free_func(graph->num_of_dependencies);
+  rt_free_func(graph->successor_offsets);
+  rt_free_func(graph->successors);
+  rt_free_func(graph->remaining);
+  rt_free_func(graph->ready);
+  rt_free_func(graph);
+}
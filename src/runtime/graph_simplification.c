@@ -0,0 +1,382 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/functions.h>
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#include <string.h>
+
+/*
+ * Functions whose outputs reach no network output, such as branches left
+ * from training or auxiliary heads, are dead. Functions are stored in order
+ * of execution, so one pass from the last function finds them: a function is
+ * live if network or a live function reads any of its outputs. Functions
+ * without outputs and those run by callbacks may have effects out of network,
+ * and they are kept.
+ *
+ * Live functions whose inputs are all parameters, or outputs of other such
+ * functions, are folded: e.g. Reshape or Transpose of a weight, or MulScalar
+ * on a bias. They are calculated once when context is initialized, into
+ * memory owned by context, and their outputs are parameters afterwards.
+ * Copy of a parameter by Reshape or Identity is the parameter itself.
+ * Broadcast, BroadcastTo and Tile are not folded when function fusion is
+ * enabled, so that arithmetic functions read the parameter as a view.
+ * Folded outputs read only by other folded functions are freed after
+ * folding.
+ *
+ * Dead and folded functions get no local context and do nothing in forward.
+ * Buffer planning gives their outputs no area, and function fusion does not
+ * count them as readers. No-ops found by is_alias_function(), such as
+ * Identity or MulScalar by 1, are removed by buffer planning which places
+ * their output over input.
+ */
+
+// Random functions give new values in each run, and recurrent functions
+// may keep state between runs. Repeated parameter is read as a view by
+// function fusion instead of folded copy.
+static int is_foldable_function(rt_context_t *c, nn_function_t *func) {
+  switch (func->type) {
+  case NN_FUNCTION_BROADCAST:
+  case NN_FUNCTION_BROADCAST_TO:
+  case NN_FUNCTION_TILE:
+    return !c->function_fusion && func->inputs.size > 0 &&
+           func->outputs.size > 0 && !has_user_function(c, func);
+  case NN_FUNCTION_RAND:
+  case NN_FUNCTION_RANDINT:
+  case NN_FUNCTION_RANDN:
+  case NN_FUNCTION_RANDOM_CHOICE:
+  case NN_FUNCTION_RANDOM_CROP:
+  case NN_FUNCTION_RANDOM_FLIP:
+  case NN_FUNCTION_RANDOM_SHIFT:
+  case NN_FUNCTION_IMAGE_AUGMENTATION:
+  case NN_FUNCTION_RNN:
+  case NN_FUNCTION_LSTM:
+  case NN_FUNCTION_GRU:
+    return 0;
+  default:
+    return func->inputs.size > 0 && func->outputs.size > 0 &&
+           !has_user_function(c, func);
+  }
+}
+
+static int is_in_list(rt_list_t list, int value) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] == value) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Outputs of function i are calculated from parameters only, and they are
+// intermediate variables.
+static int is_constant_function(nn_network_t *n, rt_context_t *c,
+                                const uint8_t *constant, int i) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  rt_list_t network_inputs = create_rt_list_from_nn_list(n, n->inputs);
+  rt_list_t network_outputs = create_rt_list_from_nn_list(n, n->outputs);
+  int j; // Iterator
+
+  if (!is_foldable_function(c, func)) {
+    return 0;
+  }
+  for (j = 0; j < inputs.size; j++) {
+    if (inputs.data[j] < 0 || inputs.data[j] >= c->num_of_variables ||
+        !constant[inputs.data[j]]) {
+      return 0;
+    }
+  }
+  list = (int *)NN_GET(n, n->variables.list);
+  for (j = 0; j < outputs.size; j++) {
+    int index = outputs.data[j];
+    if (index < 0 || index >= c->num_of_variables ||
+        ((nn_variable_t *)(NN_GET(n, *(list + index))))->data_index >= 0 ||
+        is_in_list(network_inputs, index) ||
+        is_in_list(network_outputs, index)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+rt_return_value_t build_graph_simplification(nn_network_t *n,
+                                             rt_context_t *c) {
+  int num_of_functions = n->functions.size;
+  int num_of_removed = 0;
+  int i, j; // Iterator
+
+  c->removed_functions = 0;
+  c->constants = 0;
+  // Streaming window and result caching run functions one by one, and
+  // parameter loader stages parameters of every function.
+  if (!c->graph_simplification || c->loader.load || c->window_hop ||
+      c->result_caching != RT_RESULT_CACHING_NONE || num_of_functions < 1) {
+    return RT_RET_NOERROR;
+  }
+
+  uint8_t *read = rt_malloc_func(c->num_of_variables + 1);
+  uint8_t *removed = rt_malloc_func(num_of_functions);
+  if (read == 0 || removed == 0) {
+    rt_free_func(read);
+    rt_free_func(removed);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  // Variables read by network or by live functions.
+  memset(read, 0, c->num_of_variables + 1);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, n->outputs);
+  for (j = 0; j < outputs.size; j++) {
+    if (outputs.data[j] >= 0 && outputs.data[j] < c->num_of_variables) {
+      read[outputs.data[j]] = 1;
+    }
+  }
+  int *list = (int *)NN_GET(n, n->functions.list);
+  for (i = num_of_functions - 1; i >= 0; i--) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    outputs = create_rt_list_from_nn_list(n, func->outputs);
+    int live = outputs.size == 0 || has_user_function(c, func);
+    for (j = 0; j < outputs.size && !live; j++) {
+      live = outputs.data[j] >= 0 && outputs.data[j] < c->num_of_variables &&
+             read[outputs.data[j]];
+    }
+    removed[i] = live ? 0 : RT_FUNCTION_DEAD;
+    if (!live) {
+      num_of_removed++;
+      continue;
+    }
+    for (j = 0; j < inputs.size; j++) {
+      if (inputs.data[j] >= 0 && inputs.data[j] < c->num_of_variables) {
+        read[inputs.data[j]] = 1;
+      }
+    }
+  }
+
+  // Same area now tells variables which are parameters or outputs of folded
+  // functions.
+  uint8_t *constant = read;
+  list = (int *)NN_GET(n, n->variables.list);
+  for (j = 0; j < c->num_of_variables; j++) {
+    constant[j] = ((nn_variable_t *)(NN_GET(n, *(list + j))))->data_index >= 0;
+  }
+  list = (int *)NN_GET(n, n->functions.list);
+  for (i = 0; i < num_of_functions; i++) {
+    if (removed[i] || !is_constant_function(n, c, constant, i)) {
+      continue;
+    }
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+    outputs = create_rt_list_from_nn_list(n, func->outputs);
+    for (j = 0; j < outputs.size; j++) {
+      constant[outputs.data[j]] = 1;
+    }
+    removed[i] = RT_FUNCTION_FOLDED;
+    num_of_removed++;
+  }
+  rt_free_func(read);
+
+  if (num_of_removed == 0) {
+    rt_free_func(removed);
+    return RT_RET_NOERROR;
+  }
+  c->removed_functions = removed;
+  return RT_RET_NOERROR;
+}
+
+// All outputs of function f are kept by source of clone c.
+static int is_folded_by_source(const rt_context_t *c, const rt_function_t *f) {
+  int j; // Iterator
+  if (c->source == 0 || c->source->constants == 0) {
+    return 0;
+  }
+  for (j = 0; j < f->num_of_outputs; j++) {
+    if (c->source->constants[f->outputs[j] - c->variables] == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Free output j unless it is owned by source of clone.
+static void free_constant(rt_context_t *c, int j) {
+  if (c->constants[j] && (c->source == 0 || c->source->constants == 0 ||
+                          c->source->constants[j] != c->constants[j])) {
+    variable_free(c->constants[j]);
+  }
+  c->constants[j] = 0;
+}
+
+// Calculate outputs of function i into memory owned by context.
+static rt_return_value_t fold_function(nn_network_t *n, rt_context_t *c,
+                                       int i) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+  rt_function_context_t context = allocate_function_io(n, c, func);
+  rt_function_t *f = &context.func;
+  rt_return_value_t ret = RT_RET_NOERROR;
+  int aliased = 0, shared = 0;
+  int j; // Iterator
+
+  if ((func->inputs.size > 0 && f->inputs == 0) ||
+      (func->outputs.size > 0 && f->outputs == 0)) {
+    rt_free_func(f->inputs);
+    rt_free_func(f->outputs);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (j = 0; j < f->num_of_inputs; j++) {
+    if (f->inputs[j] == 0) {
+      ret = RT_RET_ERROR_INIT_VARIABLE;
+    }
+  }
+  for (j = 0; j < f->num_of_outputs && ret == RT_RET_NOERROR; j++) {
+    if (f->outputs[j] == 0) {
+      ret = RT_RET_ERROR_INIT_VARIABLE;
+    }
+  }
+
+  if (ret == RT_RET_NOERROR && is_alias_function(func) &&
+      f->num_of_outputs == 1 &&
+      is_same_fixed_point(f->inputs[0], f->outputs[0]) &&
+      c->constants[f->inputs[0] - c->variables] == 0) {
+    f->outputs[0]->data = f->inputs[0]->data;
+    aliased = 1;
+  } else if (ret == RT_RET_NOERROR && is_folded_by_source(c, f)) {
+    for (j = 0; j < f->num_of_outputs; j++) {
+      int index = f->outputs[j] - c->variables;
+      c->constants[index] = c->source->constants[index];
+      f->outputs[j]->data = c->constants[index];
+    }
+    shared = 1;
+  } else if (ret == RT_RET_NOERROR) {
+    for (j = 0; j < f->num_of_outputs && ret == RT_RET_NOERROR; j++) {
+      int index = f->outputs[j] - c->variables;
+      c->constants[index] =
+          variable_malloc(calc_variable_data_size(f->outputs[j]));
+      if (c->constants[index] == 0) {
+        ret = RT_RET_ERROR_ALLOCATE_CONTEXT;
+      }
+      f->outputs[j]->data = c->constants[index];
+    }
+  }
+  if (ret == RT_RET_NOERROR && !aliased && !shared) {
+    // Weights are not packed for only one run.
+    size_t budget = 0;
+    size_t *previous = rt_set_prepack_budget(&budget);
+    rt_math_mode_t previous_mode = rt_set_math_mode(
+        c->fast_math ? RT_MATH_MODE_FAST : RT_MATH_MODE_EXACT);
+    f->exec_func = 0;
+    rt_function_error_t error = allocate_function_context(n, func, &context);
+    if (error == RT_FUNCTION_ERROR_NOERROR) {
+      error = f->exec_func ? f->exec_func(f) : RT_FUNCTION_ERROR_UNIMPLEMENTED;
+    }
+    rt_set_math_mode(previous_mode);
+    rt_set_prepack_budget(previous);
+    if (error == RT_FUNCTION_ERROR_MALLOC) {
+      // Free function does not know how far private data is allocated.
+      f->free_local_context_func = 0;
+      ret = RT_RET_ERROR_ALLOCATE_CONTEXT;
+    } else if (error == RT_FUNCTION_ERROR_UNIMPLEMENTED) {
+      ret = RT_RET_ERROR_UNKNOWN_FUNCTION;
+    } else if (error != RT_FUNCTION_ERROR_NOERROR) {
+      ret = RT_RET_ERROR_INIT_VARIABLE;
+    }
+    if (f->free_local_context_func) {
+      f->free_local_context_func(f);
+    }
+    if (f->local_context) {
+      rt_free_func(f->local_context);
+    }
+  }
+  rt_free_func(f->inputs);
+  rt_free_func(f->outputs);
+  return ret;
+}
+
+rt_return_value_t fold_constant_functions(nn_network_t *n, rt_context_t *c) {
+  int num_of_functions = n->functions.size;
+  int i, j; // Iterator
+
+  if (c->removed_functions == 0) {
+    return RT_RET_NOERROR;
+  }
+  c->constants = rt_malloc_func(sizeof(void *) * (c->num_of_variables + 1));
+  uint8_t *read = rt_malloc_func(c->num_of_variables + 1);
+  if (c->constants == 0 || read == 0) {
+    rt_free_func(read);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (j = 0; j < c->num_of_variables; j++) {
+    c->constants[j] = 0;
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    if (c->removed_functions[i] != RT_FUNCTION_FOLDED) {
+      continue;
+    }
+    rt_return_value_t ret = fold_function(n, c, i);
+    if (ret != RT_RET_NOERROR) {
+      rt_free_func(read);
+      return ret;
+    }
+  }
+
+  // Keep only outputs read in forward.
+  memset(read, 0, c->num_of_variables + 1);
+  int *list = (int *)NN_GET(n, n->functions.list);
+  for (i = 0; i < num_of_functions; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    if (c->removed_functions[i]) {
+      continue;
+    }
+    for (j = 0; j < inputs.size; j++) {
+      if (inputs.data[j] >= 0 && inputs.data[j] < c->num_of_variables) {
+        read[inputs.data[j]] = 1;
+      }
+    }
+  }
+  for (j = 0; j < c->num_of_variables; j++) {
+    if (c->constants[j] && !read[j]) {
+      free_constant(c, j);
+      c->variables[j].data = 0;
+    }
+  }
+  rt_free_func(read);
+  return RT_RET_NOERROR;
+}
+
+int is_removed_function(const rt_context_t *c, int i) {
+  return c->removed_functions != 0 && c->removed_functions[i];
+}
+
+void free_graph_simplification(rt_context_t *c) {
+  int i; // Iterator
+
+  if (c->constants) {
+    for (i = 0; i < c->num_of_variables; i++) {
+      free_constant(c, i);
+    }
+    rt_free_func(c->constants);
+    c->constants = 0;
+  }
+  if (c->removed_functions) {
+    rt_free_func(c->removed_functions);
+    c->removed_functions = 0;
+  }
+}
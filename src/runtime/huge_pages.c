@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For MAP_ANONYMOUS, MAP_HUGETLB and MADV_HUGEPAGE
+#endif
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/*
+ * Transparent huge pages are used only for memory mapped at a 2 MB boundary,
+ * so mapping is made one page larger and trimmed to it. Explicit pages are
+ * always at the boundary. Memory is taken by mmap() rather than by variable
+ * allocator, which cannot give such alignment.
+ */
+
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+#ifdef __linux__
+static void *map_huge_pages(rt_huge_pages_t pages, size_t size,
+                            size_t *mapped) {
+  const size_t length = RT_ALIGN_SIZE(size, HUGE_PAGE_SIZE);
+  uint8_t *p;
+  size_t head;
+
+#ifdef MAP_HUGETLB
+  if (pages == RT_HUGE_PAGES_EXPLICIT) {
+    p = mmap(0, length, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      *mapped = length;
+      return p;
+    }
+  }
+#else
+  (void)pages;
+#endif
+  p = mmap(0, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return 0;
+  }
+  head = RT_ALIGN_SIZE((uintptr_t)p, HUGE_PAGE_SIZE) - (uintptr_t)p;
+  if (head > 0) {
+    munmap(p, head);
+  }
+  if (head < HUGE_PAGE_SIZE) {
+    munmap(p + head + length, HUGE_PAGE_SIZE - head);
+  }
+  p += head;
+#ifdef MADV_HUGEPAGE
+  madvise(p, length, MADV_HUGEPAGE);
+#endif
+  *mapped = length;
+  return p;
+}
+#endif
+
+void *planned_malloc(rt_huge_pages_t pages, size_t size, size_t *mapped) {
+  *mapped = 0;
+#ifdef __linux__
+  if (pages != RT_HUGE_PAGES_NONE && size >= HUGE_PAGE_SIZE) {
+    void *p = map_huge_pages(pages, size, mapped);
+    if (p) {
+      count_context_allocation(*mapped);
+      return p;
+    }
+  }
+#else
+  (void)pages;
+#endif
+  return variable_malloc_aligned(size, RT_BUFFER_ALIGNMENT);
+}
+
+void planned_free(void *buffer, size_t mapped) {
+#ifdef __linux__
+  if (mapped > 0) {
+    munmap(buffer, mapped);
+    return;
+  }
+#else
+  (void)mapped;
+#endif
+  variable_free(buffer);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * 8 bit images have only 256 values per channel, so each value is normalized
+ * once into a table of the input type, and every pixel is one table lookup
+ * while it is moved from the image layout to planes of input. Tables of up to
+ * IMAGE_STACK_CHANNELS channels are on stack.
+ */
+
+#define IMAGE_STACK_CHANNELS (4)
+#define IMAGE_VALUES (256)
+
+// Normalized value of each 8 bit value of each channel, in input type.
+typedef union {
+  float f[IMAGE_VALUES];
+  int16_t i16[IMAGE_VALUES];
+  int8_t i8[IMAGE_VALUES];
+} image_table_t;
+
+// Same clamp and truncation as setters of fixed point functions.
+static float to_fixed(float value, float coefficient, float min, float max) {
+  value /= coefficient;
+  return value >= max ? max : value <= min ? min : value;
+}
+
+static void fill_tables(const rt_variable_t *v, const rt_image_format_t *format,
+                        int channels, image_table_t *tables) {
+  int c, k; // Iterators
+
+  for (c = 0; c < channels; c++) {
+    const float mean = format->mean ? format->mean[c] : 0.0f;
+    const float std = format->std ? format->std[c] : 1.0f;
+    for (k = 0; k < IMAGE_VALUES; k++) {
+      // Byte k is value k of uint8, or k - 256 above 127 of int8.
+      const int value =
+          format->type == RT_IMAGE_TYPE_INT8 && k > INT8_MAX ? k - 256 : k;
+      const float y = (value - mean) / std;
+      if (v->type == NN_DATA_TYPE_INT16) {
+        tables[c].i16[k] =
+            (int16_t)to_fixed(y, v->coefficient, INT16_MIN, INT16_MAX);
+      } else if (v->type == NN_DATA_TYPE_INT8) {
+        tables[c].i8[k] =
+            (int8_t)to_fixed(y, v->coefficient, INT8_MIN, INT8_MAX);
+      } else {
+        tables[c].f[k] = y;
+      }
+    }
+  }
+}
+
+// Convert images of element type T through member M of tables.
+#define CONVERT_IMAGES(T, M)                                                   \
+  do {                                                                         \
+    T *y = (T *)(v->data);                                                     \
+    for (n = 0; n < num_of_images; n++, x += image_size, y += image_size) {    \
+      if (format->layout == RT_IMAGE_LAYOUT_CHW) {                             \
+        for (ch = 0; ch < channels; ch++) {                                    \
+          const T *table = tables[ch].M;                                       \
+          for (p = 0; p < plane; p++) {                                        \
+            y[ch * plane + p] = table[x[ch * plane + p]];                      \
+          }                                                                    \
+        }                                                                      \
+      } else if (channels == 3) {                                              \
+        for (p = 0; p < plane; p++) {                                          \
+          y[p] = tables[0].M[x[p * 3]];                                        \
+          y[plane + p] = tables[1].M[x[p * 3 + 1]];                            \
+          y[2 * plane + p] = tables[2].M[x[p * 3 + 2]];                        \
+        }                                                                      \
+      } else {                                                                 \
+        for (p = 0; p < plane; p++) {                                          \
+          for (ch = 0; ch < channels; ch++) {                                  \
+            y[ch * plane + p] = tables[ch].M[x[p * channels + ch]];            \
+          }                                                                    \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+rt_return_value_t rt_write_input_image(rt_context_pointer context,
+                                       size_t index,
+                                       const rt_image_format_t *format,
+                                       const void *image) {
+  rt_context_t *c = context;
+  image_table_t stack_tables[IMAGE_STACK_CHANNELS];
+  image_table_t *tables = stack_tables;
+  const uint8_t *x = (const uint8_t *)image;
+  int num_of_images = 1;
+  int n, ch, p, i; // Iterators
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (index >= (size_t)c->num_of_inputs ||
+      format->type < RT_IMAGE_TYPE_UINT8 || format->type > RT_IMAGE_TYPE_INT8 ||
+      format->layout < RT_IMAGE_LAYOUT_HWC ||
+      format->layout > RT_IMAGE_LAYOUT_CHW) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  rt_variable_t *v = &c->variables[c->input_variable_ids[index]];
+  if (v->shape.size < 3 || v->quantization ||
+      (v->type != NN_DATA_TYPE_FLOAT && v->type != NN_DATA_TYPE_INT16 &&
+       v->type != NN_DATA_TYPE_INT8)) {
+    return RT_RET_ERROR_INVALID_SHAPE;
+  }
+  for (i = 0; i < v->shape.size - 3; i++) {
+    num_of_images *= v->shape.data[i];
+  }
+  const int channels = v->shape.data[v->shape.size - 3];
+  const int plane =
+      v->shape.data[v->shape.size - 2] * v->shape.data[v->shape.size - 1];
+  const int image_size = channels * plane;
+
+  if (channels > IMAGE_STACK_CHANNELS) {
+    tables = rt_malloc_func(sizeof(image_table_t) * channels);
+    if (tables == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  }
+  fill_tables(v, format, channels, tables);
+  if (v->type == NN_DATA_TYPE_INT16) {
+    CONVERT_IMAGES(int16_t, i16);
+  } else if (v->type == NN_DATA_TYPE_INT8) {
+    CONVERT_IMAGES(int8_t, i8);
+  } else {
+    CONVERT_IMAGES(float, f);
+  }
+  if (tables != stack_tables) {
+    rt_free_func(tables);
+  }
+  return rt_mark_input_changed(context, index);
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/config.h>
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * A function is timed right after it is allocated, while its parameters are
+ * staged and its inputs hold whatever they have at initialization. Each
+ * kernel runs once to warm caches, then the best of TUNING_ITERATIONS runs is
+ * compared. Kernels which fail are not chosen.
+ */
+
+#define TUNING_ITERATIONS (3)
+
+static int function_kernels(rt_context_t *c, int i, rt_kernel_t *kernels) {
+  switch (c->functions[i].info->type) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION:
+    return convolution_kernels(&c->functions[i].func, kernels);
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+  default:
+    return 0;
+  }
+}
+
+static rt_function_error_t select_kernel(rt_context_t *c, int i,
+                                         rt_kernel_t kernel, int keep) {
+  switch (c->functions[i].info->type) {
+#ifdef CONFIG_CONVOLUTION_FLOAT32
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION:
+    return select_convolution_kernel(&c->functions[i].func, kernel, keep);
+#endif /* CONFIG_CONVOLUTION_FLOAT32 */
+  default:
+    return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+  }
+}
+
+// Best time of kernel in nano seconds, or 0 if it failed.
+static uint64_t time_kernel(rt_context_t *c, int i, rt_kernel_t kernel) {
+  rt_function_t *f = &c->functions[i].func;
+  uint64_t best = 0;
+  int k; // Iterator
+
+  if (select_kernel(c, i, kernel, 1) != RT_FUNCTION_ERROR_NOERROR ||
+      f->exec_func(f) != RT_FUNCTION_ERROR_NOERROR) {
+    return 0;
+  }
+  for (k = 0; k < TUNING_ITERATIONS; k++) {
+    uint64_t start = profile_now();
+    if (f->exec_func(f) != RT_FUNCTION_ERROR_NOERROR) {
+      return 0;
+    }
+    uint64_t elapsed = profile_now() - start;
+    if (best == 0 || elapsed < best) {
+      // 0 is failure, so even too fast kernel takes 1.
+      best = elapsed > 0 ? elapsed : 1;
+    }
+  }
+  return best;
+}
+
+static rt_kernel_t tune_kernel(rt_context_t *c, int i,
+                               const rt_kernel_t *kernels,
+                               int num_of_kernels) {
+  const rt_parallel_executor_t *previous =
+      rt_set_parallel_executor(c->thread_pool ? &c->executor : 0);
+  rt_kernel_t fastest = kernels[0];
+  uint64_t fastest_time = 0;
+  int k; // Iterator
+
+  for (k = 0; k < num_of_kernels; k++) {
+    uint64_t elapsed = time_kernel(c, i, kernels[k]);
+    if (elapsed > 0 && (fastest_time == 0 || elapsed < fastest_time)) {
+      fastest = kernels[k];
+      fastest_time = elapsed;
+    }
+  }
+  rt_set_parallel_executor(previous);
+  return fastest;
+}
+
+rt_return_value_t prepare_kernel_choices(rt_context_t *c) {
+  kernel_choices_t *k = &c->kernels;
+  if (!k->tuning && k->given == 0) {
+    return RT_RET_NOERROR;
+  }
+  k->chosen = rt_malloc_func(c->num_of_functions + 1);
+  if (k->chosen == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(k->chosen, RT_KERNEL_DEFAULT, c->num_of_functions + 1);
+  return RT_RET_NOERROR;
+}
+
+void free_kernel_choices(rt_context_t *c) {
+  if (c->kernels.chosen) {
+    rt_free_func(c->kernels.chosen);
+    c->kernels.chosen = 0;
+  }
+}
+
+int has_kernel_choices(rt_context_t *c) { return c->kernels.chosen != 0; }
+
+void choose_function_kernel(rt_context_t *c, int i) {
+  kernel_choices_t *k = &c->kernels;
+  rt_kernel_t kernels[RT_KERNEL_END];
+  rt_kernel_t kernel;
+  int num_of_kernels;
+  int j; // Iterator
+
+  if (k->chosen == 0 || (c->fusions && c->fusions[i].skip)) {
+    return;
+  }
+  num_of_kernels = function_kernels(c, i, kernels);
+  if (num_of_kernels <= 1) {
+    return;
+  }
+
+  // Kernel chosen by rule unless another one is given or faster.
+  kernel = kernels[0];
+  if (k->given && k->given_size == c->num_of_functions &&
+      k->given[i] != RT_KERNEL_DEFAULT) {
+    for (j = 0; j < num_of_kernels; j++) {
+      if (kernels[j] == (rt_kernel_t)k->given[i]) {
+        break;
+      }
+    }
+    if (j < num_of_kernels) {
+      kernel = kernels[j];
+    } else if (k->tuning) {
+      kernel = tune_kernel(c, i, kernels, num_of_kernels);
+    }
+  } else if (k->tuning) {
+    kernel = tune_kernel(c, i, kernels, num_of_kernels);
+  }
+  if (select_kernel(c, i, kernel, 0) == RT_FUNCTION_ERROR_NOERROR) {
+    k->chosen[i] = (uint8_t)kernel;
+  }
+}
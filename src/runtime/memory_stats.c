@@ -0,0 +1,177 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+typedef struct {
+  uint8_t *begin;
+  uint8_t *end;
+} memory_range_t;
+
+static int compare_offsets(const void *a, const void *b) {
+  pointer_index_t x = *(const pointer_index_t *)a;
+  pointer_index_t y = *(const pointer_index_t *)b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static int compare_ranges(const void *a, const void *b) {
+  const uint8_t *x = ((const memory_range_t *)a)->begin;
+  const uint8_t *y = ((const memory_range_t *)b)->begin;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// Data of a parameter lasts until the next data in network.
+size_t measure_parameter_bytes(nn_network_t *n) {
+  int num_of_data = n->memory.num_of_data;
+  const pointer_index_t *index = NN_NETWORK_INDEX_POINTER(n);
+  int *list = (int *)NN_GET(n, n->variables.list);
+  pointer_index_t *offsets;
+  uint8_t *counted;
+  size_t bytes = 0;
+  int i; // Iterator
+
+  offsets = rt_malloc_func(sizeof(pointer_index_t) * (num_of_data + 1));
+  counted = rt_malloc_func(num_of_data + 1);
+  if (offsets == 0 || counted == 0) {
+    rt_free_func(offsets);
+    rt_free_func(counted);
+    return 0;
+  }
+  memcpy(offsets, index, sizeof(pointer_index_t) * num_of_data);
+  qsort(offsets, num_of_data, sizeof(pointer_index_t), compare_offsets);
+  offsets[num_of_data] = NN_NETWORK_DATA_SIZE(n);
+  memset(counted, 0, num_of_data + 1);
+
+  for (i = 0; i < n->variables.size; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[i]));
+    int first = 0;
+    int last = num_of_data;
+    if (var->data_index < 0 || var->data_index >= num_of_data ||
+        counted[var->data_index]) {
+      continue;
+    }
+    counted[var->data_index] = 1;
+    // First offset after this data.
+    while (first < last) {
+      int middle = (first + last) / 2;
+      if (offsets[middle] <= index[var->data_index]) {
+        first = middle + 1;
+      } else {
+        last = middle;
+      }
+    }
+    bytes += offsets[first] - index[var->data_index];
+  }
+  rt_free_func(offsets);
+  rt_free_func(counted);
+  return bytes;
+}
+
+static void update_lifetime(int *first, int *last, rt_variable_t **list,
+                            int size, rt_variable_t *variables, int index) {
+  int i; // Iterator
+  for (i = 0; i < size; i++) {
+    if (list[i] != 0) {
+      int v = (int)(list[i] - variables);
+      if (first[v] < 0) {
+        first[v] = index;
+      }
+      last[v] = index;
+    }
+  }
+}
+
+rt_return_value_t measure_peak_activation(nn_network_t *n, rt_context_t *c,
+                                          size_t *peak) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  int num_of_variables = c->num_of_variables;
+  int num_of_functions = c->num_of_functions;
+  int *first = rt_malloc_func(sizeof(int) * (num_of_variables + 1));
+  int *last = rt_malloc_func(sizeof(int) * (num_of_variables + 1));
+  memory_range_t *ranges =
+      rt_malloc_func(sizeof(memory_range_t) * (num_of_variables + 1));
+  int i, j; // Iterator
+
+  *peak = 0;
+  if (first == 0 || last == 0 || ranges == 0) {
+    rt_free_func(first);
+    rt_free_func(last);
+    rt_free_func(ranges);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Functions which read or write each variable, in order of execution.
+  for (i = 0; i < num_of_variables; i++) {
+    first[i] = last[i] = -1;
+  }
+  for (i = 0; i < num_of_functions; i++) {
+    rt_function_t *f = &c->functions[i].func;
+    if ((c->fusions && c->fusions[i].skip) || is_removed_function(c, i)) {
+      continue;
+    }
+    update_lifetime(first, last, f->inputs, f->num_of_inputs, c->variables,
+                    i);
+    update_lifetime(first, last, f->outputs, f->num_of_outputs, c->variables,
+                    i);
+  }
+  for (i = 0; i < c->num_of_inputs; i++) {
+    first[c->input_variable_ids[i]] = 0;
+    last[c->input_variable_ids[i]] = num_of_functions;
+  }
+  for (i = 0; i < c->num_of_outputs; i++) {
+    first[c->output_variable_ids[i]] = 0;
+    last[c->output_variable_ids[i]] = num_of_functions;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Union of memory of variables alive while each function runs.
+  for (i = 0; i < num_of_functions || i == 0; i++) {
+    int num_of_ranges = 0;
+    size_t bytes = 0;
+    uint8_t *end = 0;
+    for (j = 0; j < num_of_variables; j++) {
+      nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[j]));
+      if (var->data_index >= 0 || first[j] < 0 || first[j] > i ||
+          last[j] < i || c->variables[j].data == 0) {
+        continue;
+      }
+      ranges[num_of_ranges].begin = c->variables[j].data;
+      ranges[num_of_ranges].end = ranges[num_of_ranges].begin +
+                                  calc_variable_data_size(c->variables + j);
+      num_of_ranges++;
+    }
+    qsort(ranges, num_of_ranges, sizeof(memory_range_t), compare_ranges);
+    for (j = 0; j < num_of_ranges; j++) {
+      uint8_t *begin = ranges[j].begin > end ? ranges[j].begin : end;
+      if (ranges[j].end > begin) {
+        bytes += ranges[j].end - begin;
+        end = ranges[j].end;
+      }
+    }
+    if (bytes > *peak) {
+      *peak = bytes;
+    }
+  }
+  rt_free_func(first);
+  rt_free_func(last);
+  rt_free_func(ranges);
+  return RT_RET_NOERROR;
+}
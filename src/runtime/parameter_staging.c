@@ -0,0 +1,243 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Functions which read dense parameters use the two staging buffers in turn,
+ * in order of functions. Parameters of a function are always placed at the
+ * same positions of the same buffer, so pointers kept by its local context
+ * stay valid, and the other buffer is free to receive parameters of next
+ * function while it runs. Parameters are read only, so those still in their
+ * buffer are not loaded again.
+ */
+
+static int is_staged_parameter(nn_network_t *n, int index) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[index]));
+  return var->data_index >= 0 && var->layout == NN_DATA_LAYOUT_DENSE;
+}
+
+// Index of input k of function which is not same as its former inputs.
+static int first_use(rt_list_t inputs, int k) {
+  int j; // Iterator
+  for (j = 0; j < k; j++) {
+    if (inputs.data[j] == inputs.data[k]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+rt_return_value_t prepare_parameter_staging(nn_network_t *n, rt_context_t *c) {
+  int *functions = (int *)NN_GET(n, n->functions.list);
+  int *variables = (int *)NN_GET(n, n->variables.list);
+  parameter_staging_t *s;
+  size_t staging_size = 0;
+  int count = 0;
+  int ordinal = 0;
+  int i, k; // Iterator
+
+  c->staging = 0;
+  if (c->loader.load == 0) {
+    return RT_RET_NOERROR;
+  }
+  s = rt_malloc_func(sizeof(parameter_staging_t));
+  if (s == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(s, 0, sizeof(parameter_staging_t));
+  s->resident[0] = s->resident[1] = -1;
+  s->pending = -1;
+  c->staging = s;
+
+  for (i = 0; i < n->functions.size; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, functions[i]));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    for (k = 0; k < inputs.size; k++) {
+      if (is_staged_parameter(n, inputs.data[k]) && first_use(inputs, k)) {
+        count++;
+      }
+    }
+  }
+  s->offsets = rt_malloc_func(sizeof(int) * (n->functions.size + 1));
+  s->buffers = rt_malloc_func(sizeof(int) * n->functions.size);
+  s->next = rt_malloc_func(sizeof(int) * n->functions.size);
+  s->variables = rt_malloc_func(sizeof(int) * (count + 1));
+  s->positions = rt_malloc_func(sizeof(size_t) * (count + 1));
+  s->sources = rt_malloc_func(sizeof(size_t) * (count + 1));
+  if (s->offsets == 0 || s->buffers == 0 || s->next == 0 ||
+      s->variables == 0 || s->positions == 0 || s->sources == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Place parameters of each function from beginning of its buffer.
+  count = 0;
+  for (i = 0; i < n->functions.size; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, functions[i]));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    size_t position = 0;
+    s->offsets[i] = count;
+    for (k = 0; k < inputs.size; k++) {
+      int index = inputs.data[k];
+      nn_variable_t *var;
+      if (!is_staged_parameter(n, index) || !first_use(inputs, k)) {
+        continue;
+      }
+      var = (nn_variable_t *)(NN_GET(n, variables[index]));
+      s->variables[count] = index;
+      s->positions[count] = position;
+      s->sources[count] =
+          (size_t)(NN_GET(n, var->data_index) - (uint8_t *)n);
+      position += (calc_variable_data_size(c->variables + index) +
+                   RT_VARIABLE_ALIGNMENT - 1) &
+                  ~(size_t)(RT_VARIABLE_ALIGNMENT - 1);
+      c->variables[index].data = 0;
+      count++;
+    }
+    s->buffers[i] = count > s->offsets[i] ? ordinal++ % 2 : -1;
+    if (position > staging_size) {
+      staging_size = position;
+    }
+  }
+  s->offsets[n->functions.size] = count;
+
+  // Next function with parameters, the first one follows the last one.
+  for (i = n->functions.size - 1, k = -1; i >= 0; i--) {
+    s->next[i] = k;
+    k = s->buffers[i] >= 0 ? i : k;
+  }
+  for (i = n->functions.size - 1; i >= 0 && s->next[i] < 0; i--) {
+    s->next[i] = k;
+  }
+
+  for (i = 0; i < 2 && i < ordinal; i++) {
+    s->staging[i] = variable_malloc(staging_size);
+    if (s->staging[i] == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+void free_parameter_staging(rt_context_t *c) {
+  parameter_staging_t *s = c->staging;
+  int i; // Iterator
+  if (s == 0) {
+    return;
+  }
+  if (s->pending >= 0 && c->loader.wait) {
+    // Transfer must not write into freed buffer.
+    c->loader.wait(c->loader.user_data);
+  }
+  for (i = 0; i < 2; i++) {
+    if (s->staging[i]) {
+      variable_free(s->staging[i]);
+    }
+  }
+  if (s->offsets) {
+    rt_free_func(s->offsets);
+  }
+  if (s->buffers) {
+    rt_free_func(s->buffers);
+  }
+  if (s->next) {
+    rt_free_func(s->next);
+  }
+  if (s->variables) {
+    rt_free_func(s->variables);
+  }
+  if (s->positions) {
+    rt_free_func(s->positions);
+  }
+  if (s->sources) {
+    rt_free_func(s->sources);
+  }
+  rt_free_func(s);
+  c->staging = 0;
+}
+
+static rt_return_value_t wait_loading(rt_context_t *c) {
+  parameter_staging_t *s = c->staging;
+  s->pending = -1;
+  if (c->loader.wait && c->loader.wait(c->loader.user_data) != 0) {
+    s->resident[0] = s->resident[1] = -1;
+    return RT_RET_ERROR_LOAD_PARAMETER;
+  }
+  return RT_RET_NOERROR;
+}
+
+static rt_return_value_t start_loading(rt_context_t *c, int i) {
+  parameter_staging_t *s = c->staging;
+  uint8_t *buffer = s->staging[s->buffers[i]];
+  int j; // Iterator
+
+  s->pending = i;
+  s->resident[s->buffers[i]] = i;
+  for (j = s->offsets[i]; j < s->offsets[i + 1]; j++) {
+    if (c->loader.load(c->loader.user_data, s->sources[j],
+                       buffer + s->positions[j],
+                       calc_variable_data_size(c->variables +
+                                               s->variables[j])) != 0) {
+      wait_loading(c);
+      s->resident[0] = s->resident[1] = -1;
+      return RT_RET_ERROR_LOAD_PARAMETER;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t stage_parameters(rt_context_t *c, int i, int prefetch) {
+  parameter_staging_t *s = c->staging;
+  rt_return_value_t ret = RT_RET_NOERROR;
+  int b, next;
+  int j; // Iterator
+
+  if (s == 0 || s->buffers[i] < 0) {
+    return RT_RET_NOERROR;
+  }
+  b = s->buffers[i];
+  if (s->pending == i) {
+    ret = wait_loading(c);
+  } else if (s->resident[b] != i) {
+    if (s->pending >= 0) {
+      ret = wait_loading(c);
+    }
+    if (ret == RT_RET_NOERROR) {
+      ret = start_loading(c, i);
+    }
+    if (ret == RT_RET_NOERROR) {
+      ret = wait_loading(c);
+    }
+  }
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  for (j = s->offsets[i]; j < s->offsets[i + 1]; j++) {
+    c->variables[s->variables[j]].data = s->staging[b] + s->positions[j];
+  }
+
+  next = s->next[i];
+  if (prefetch && s->pending < 0 && next != i && s->buffers[next] != b &&
+      s->resident[s->buffers[next]] != next) {
+    ret = start_loading(c, next);
+  }
+  return ret;
+}
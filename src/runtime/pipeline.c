@@ -0,0 +1,616 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For pthread_setaffinity_np()
+#endif
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Stage s runs functions [first, last) of its own clone of context. Before
+ * that, variables which are network inputs or outputs of earlier stages, and
+ * are read by this or later stages or are network outputs, are copied from
+ * the previous stage. They are alive at the first function of stage, so
+ * buffer planning never places two of them at the same memory.
+ */
+
+typedef struct {
+  void *pipeline; ///< Owner, given to thread of stage.
+  rt_context_pointer context;
+  int first;
+  int last;
+  int num_of_carried;
+  int *carried; ///< Variables copied from previous stage.
+  size_t bytes; ///< Total size of carried variables.
+} stage_t;
+
+typedef struct {
+  int num_of_stages;
+  stage_t *stages;
+  void *queue; ///< Threads and buffers between stages.
+} pipeline_t;
+
+static void free_pipeline(pipeline_t *p) {
+  int i; // Iterator
+  if (p->stages) {
+    for (i = 0; i < p->num_of_stages; i++) {
+      if (p->stages[i].context) {
+        rt_free_context(&p->stages[i].context);
+      }
+      if (p->stages[i].carried) {
+        rt_free_func(p->stages[i].carried);
+      }
+    }
+    rt_free_func(p->stages);
+  }
+  rt_free_func(p);
+}
+
+// Split functions into contiguous stages minimizing time of slowest stage.
+static rt_return_value_t balance_stages(pipeline_t *p) {
+  rt_context_t *c = p->stages[0].context;
+  const int n = c->num_of_functions;
+  const int k_max = p->num_of_stages;
+  const rt_function_profile_t *profile;
+  uint64_t *sum, *best;
+  int *cut;
+  int previous = c->profiling;
+  int num, i, j, k; // Iterator
+  rt_return_value_t ret;
+
+  sum = rt_malloc_func(sizeof(uint64_t) * (n + 1));
+  best = rt_malloc_func(sizeof(uint64_t) * (n + 1) * (k_max + 1));
+  cut = rt_malloc_func(sizeof(int) * (n + 1) * (k_max + 1));
+  if (sum == 0 || best == 0 || cut == 0) {
+    ret = RT_RET_ERROR_ALLOCATE_CONTEXT;
+    goto end;
+  }
+  ret = rt_set_profiling(c, 1);
+  if (ret == RT_RET_NOERROR) {
+    ret = rt_forward(c);
+  }
+  if (ret != RT_RET_NOERROR) {
+    goto end;
+  }
+  profile = rt_get_profile(c, &num);
+  sum[0] = 0;
+  for (i = 0; i < n; i++) {
+    // Functions taking no measurable time still add to stage.
+    sum[i + 1] = sum[i] + (i < num ? profile[i].total_nsec : 0) + 1;
+  }
+  ret = rt_set_profiling(c, previous);
+
+  // best[k * (n + 1) + i] is time of slowest stage when first i functions
+  // are split into k stages, and cut is first function of the last of them.
+  for (i = 1; i <= n; i++) {
+    best[n + 1 + i] = sum[i];
+    cut[n + 1 + i] = 0;
+  }
+  for (k = 2; k <= k_max; k++) {
+    for (i = k; i <= n; i++) {
+      uint64_t *b = best + k * (n + 1) + i;
+      *b = UINT64_MAX;
+      for (j = k - 1; j < i; j++) {
+        uint64_t t = best[(k - 1) * (n + 1) + j];
+        if (sum[i] - sum[j] > t) {
+          t = sum[i] - sum[j];
+        }
+        if (t < *b) {
+          *b = t;
+          cut[k * (n + 1) + i] = j;
+        }
+      }
+    }
+  }
+  i = n;
+  for (k = k_max; k >= 1; k--) {
+    p->stages[k - 1].last = i;
+    i = cut[k * (n + 1) + i];
+    p->stages[k - 1].first = i;
+  }
+
+end:
+  if (sum) {
+    rt_free_func(sum);
+  }
+  if (best) {
+    rt_free_func(best);
+  }
+  if (cut) {
+    rt_free_func(cut);
+  }
+  return ret;
+}
+
+// Find variables each stage takes from previous one.
+static rt_return_value_t find_carried(pipeline_t *p) {
+  rt_context_t *c = p->stages[0].context;
+  int *written, *read;
+  rt_return_value_t ret = RT_RET_NOERROR;
+  int s, i, j; // Iterator
+
+  written = rt_malloc_func(sizeof(int) * c->num_of_variables);
+  read = rt_malloc_func(sizeof(int) * c->num_of_variables);
+  if (written == 0 || read == 0) {
+    ret = RT_RET_ERROR_ALLOCATE_CONTEXT;
+    goto end;
+  }
+  // written is first function writing variable, -1 for network inputs and
+  // num_of_functions for others. read is last function reading variable,
+  // num_of_functions for network outputs.
+  for (i = 0; i < c->num_of_variables; i++) {
+    written[i] = c->num_of_functions;
+    read[i] = -1;
+  }
+  for (i = c->num_of_functions - 1; i >= 0; i--) {
+    rt_function_t *f = &c->functions[i].func;
+    for (j = 0; j < f->num_of_outputs; j++) {
+      written[f->outputs[j] - c->variables] = i;
+    }
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    rt_function_t *f = &c->functions[i].func;
+    for (j = 0; j < f->num_of_inputs; j++) {
+      read[f->inputs[j] - c->variables] = i;
+    }
+  }
+  for (i = 0; i < c->num_of_inputs; i++) {
+    written[c->input_variable_ids[i]] = -1;
+  }
+  for (i = 0; i < c->num_of_outputs; i++) {
+    read[c->output_variable_ids[i]] = c->num_of_functions;
+  }
+
+  for (s = 1; s < p->num_of_stages; s++) {
+    stage_t *stage = p->stages + s;
+    stage->carried = rt_malloc_func(sizeof(int) * (c->num_of_variables + 1));
+    if (stage->carried == 0) {
+      ret = RT_RET_ERROR_ALLOCATE_CONTEXT;
+      goto end;
+    }
+    for (i = 0; i < c->num_of_variables; i++) {
+      if (written[i] < stage->first && read[i] >= stage->first &&
+          c->variables[i].data != 0) {
+        stage->carried[stage->num_of_carried++] = i;
+        stage->bytes += calc_variable_data_size(c->variables + i);
+      }
+    }
+  }
+
+end:
+  if (written) {
+    rt_free_func(written);
+  }
+  if (read) {
+    rt_free_func(read);
+  }
+  return ret;
+}
+
+static rt_return_value_t allocate_pipeline(pipeline_t **pipeline,
+                                           rt_context_t *source,
+                                           int num_of_stages) {
+  rt_return_value_t ret;
+  pipeline_t *p;
+  int i; // Iterator
+
+  *pipeline = 0;
+  if (source->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (num_of_stages < 1 || num_of_stages > source->num_of_functions) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  p = rt_malloc_func(sizeof(pipeline_t));
+  if (p == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(p, 0, sizeof(pipeline_t));
+  p->num_of_stages = num_of_stages;
+  p->stages = rt_malloc_func(sizeof(stage_t) * num_of_stages);
+  if (p->stages == 0) {
+    free_pipeline(p);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(p->stages, 0, sizeof(stage_t) * num_of_stages);
+  for (i = 0; i < num_of_stages; i++) {
+    p->stages[i].pipeline = p;
+    ret = rt_clone_context(source, &p->stages[i].context);
+    if (ret != RT_RET_NOERROR) {
+      free_pipeline(p);
+      return ret;
+    }
+  }
+  p->stages[0].last = source->num_of_functions;
+  if (num_of_stages > 1) {
+    ret = balance_stages(p);
+    if (ret == RT_RET_NOERROR) {
+      ret = find_carried(p);
+    }
+    if (ret != RT_RET_NOERROR) {
+      free_pipeline(p);
+      return ret;
+    }
+  }
+  *pipeline = p;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_pipeline_stage(rt_pipeline_pointer pipeline, int stage,
+                                    int *first, int *last) {
+  pipeline_t *p = pipeline;
+  if (stage < 0 || stage >= p->num_of_stages) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  *first = p->stages[stage].first;
+  *last = p->stages[stage].last;
+  return RT_RET_NOERROR;
+}
+
+#ifdef NNABLART_USE_PTHREAD
+
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// Frame passed from a stage to the next one.
+typedef struct {
+  int full;
+  rt_request_t request;
+  rt_return_value_t result;
+  uint8_t *data; ///< Carried variables of next stage.
+} handoff_t;
+
+typedef struct {
+  pthread_t *threads;
+  int *stopped;        ///< Stage will take no more frames.
+  handoff_t *handoffs; ///< handoffs[s] is given to stage s + 1.
+
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  int shutdown;
+
+  int capacity;
+  rt_request_t *requests; ///< Ring of frames not taken by first stage.
+  int head;               ///< Oldest pending frame.
+  int num_of_pending;
+  int num_of_frames; ///< Submitted and not finished.
+  rt_return_value_t result; ///< Result of last finished frame.
+} pipeline_queue_t;
+
+// Copy variables carried into stage between buffer and context.
+static void copy_carried(const stage_t *stage, rt_context_t *c,
+                         uint8_t *buffer, int save) {
+  int i; // Iterator
+  for (i = 0; i < stage->num_of_carried; i++) {
+    rt_variable_t *v = c->variables + stage->carried[i];
+    size_t size = calc_variable_data_size(v);
+    if (save) {
+      memcpy(buffer, v->data, size);
+    } else {
+      memcpy(v->data, buffer, size);
+    }
+    buffer += size;
+  }
+}
+
+static void *worker(void *arg) {
+  const stage_t *stage = arg;
+  pipeline_t *p = stage->pipeline;
+  pipeline_queue_t *q = p->queue;
+  const int s = stage - p->stages;
+  handoff_t *in = s > 0 ? q->handoffs + s - 1 : 0;
+  handoff_t *out = s < p->num_of_stages - 1 ? q->handoffs + s : 0;
+  rt_request_t request;
+  rt_return_value_t result;
+
+  pthread_mutex_lock(&q->mutex);
+  for (;;) {
+    if (in) {
+      while (!in->full && !q->stopped[s - 1]) {
+        pthread_cond_wait(&q->changed, &q->mutex);
+      }
+      if (!in->full) {
+        break; // Previous stage has stopped.
+      }
+      request = in->request;
+      result = in->result;
+      pthread_mutex_unlock(&q->mutex);
+      copy_carried(stage, stage->context, in->data, 0);
+      pthread_mutex_lock(&q->mutex);
+      in->full = 0;
+      pthread_cond_broadcast(&q->changed);
+      pthread_mutex_unlock(&q->mutex);
+    } else {
+      while (q->num_of_pending == 0 && !q->shutdown) {
+        pthread_cond_wait(&q->changed, &q->mutex);
+      }
+      if (q->num_of_pending == 0) {
+        break; // Shut down after pending frames are finished.
+      }
+      request = q->requests[q->head];
+      q->head = (q->head + 1) % q->capacity;
+      q->num_of_pending--;
+      pthread_mutex_unlock(&q->mutex);
+      if (request.prepare) {
+        request.prepare(request.user_data, stage->context);
+      }
+      result = RT_RET_NOERROR;
+    }
+
+    // Frame failed in earlier stage is passed through to done.
+    if (result == RT_RET_NOERROR) {
+      result = rt_forward_range(stage->context, stage->first, stage->last);
+    }
+
+    if (out) {
+      pthread_mutex_lock(&q->mutex);
+      while (out->full) {
+        pthread_cond_wait(&q->changed, &q->mutex);
+      }
+      pthread_mutex_unlock(&q->mutex);
+      copy_carried(stage + 1, stage->context, out->data, 1);
+      pthread_mutex_lock(&q->mutex);
+      out->request = request;
+      out->result = result;
+      out->full = 1;
+    } else {
+      if (request.done) {
+        request.done(request.user_data, stage->context, result);
+      }
+      pthread_mutex_lock(&q->mutex);
+      q->num_of_frames--;
+      q->result = result;
+    }
+    pthread_cond_broadcast(&q->changed);
+  }
+  q->stopped[s] = 1;
+  pthread_cond_broadcast(&q->changed);
+  pthread_mutex_unlock(&q->mutex);
+  return 0;
+}
+
+static void free_queue(pipeline_queue_t *q, int num_of_stages) {
+  int i; // Iterator
+  if (q->handoffs) {
+    for (i = 0; i < num_of_stages - 1; i++) {
+      if (q->handoffs[i].data) {
+        rt_free_func(q->handoffs[i].data);
+      }
+    }
+    rt_free_func(q->handoffs);
+  }
+  if (q->stopped) {
+    rt_free_func(q->stopped);
+  }
+  if (q->threads) {
+    rt_free_func(q->threads);
+  }
+  if (q->requests) {
+    rt_free_func(q->requests);
+  }
+  rt_free_func(q);
+}
+
+// Stop threads after pending frames.
+static void stop_queue(pipeline_queue_t *q, int num_of_threads) {
+  int i; // Iterator
+  pthread_mutex_lock(&q->mutex);
+  q->shutdown = 1;
+  pthread_cond_broadcast(&q->changed);
+  pthread_mutex_unlock(&q->mutex);
+  for (i = 0; i < num_of_threads; i++) {
+    pthread_join(q->threads[i], 0);
+  }
+  pthread_cond_destroy(&q->changed);
+  pthread_mutex_destroy(&q->mutex);
+}
+
+static int pin_thread(pthread_t thread, int core) {
+#ifdef __linux__
+  cpu_set_t set;
+  if (core < 0 || core >= CPU_SETSIZE) {
+    return 0;
+  }
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+  (void)thread;
+  (void)core;
+  return 1;
+#endif
+}
+
+static rt_return_value_t allocate_queue(pipeline_t *p, int capacity) {
+  pipeline_queue_t *q;
+  int i; // Iterator
+
+  q = rt_malloc_func(sizeof(pipeline_queue_t));
+  if (q == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(q, 0, sizeof(pipeline_queue_t));
+  q->capacity = capacity;
+  q->result = RT_RET_NOERROR;
+  q->threads = rt_malloc_func(sizeof(pthread_t) * p->num_of_stages);
+  q->stopped = rt_malloc_func(sizeof(int) * p->num_of_stages);
+  q->handoffs = rt_malloc_func(sizeof(handoff_t) * p->num_of_stages);
+  q->requests = rt_malloc_func(sizeof(rt_request_t) * capacity);
+  if (q->threads == 0 || q->stopped == 0 || q->handoffs == 0 ||
+      q->requests == 0) {
+    free_queue(q, 0);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(q->stopped, 0, sizeof(int) * p->num_of_stages);
+  memset(q->handoffs, 0, sizeof(handoff_t) * p->num_of_stages);
+  for (i = 0; i < p->num_of_stages - 1; i++) {
+    q->handoffs[i].data = rt_malloc_func(p->stages[i + 1].bytes + 1);
+    if (q->handoffs[i].data == 0) {
+      free_queue(q, p->num_of_stages);
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  }
+  pthread_mutex_init(&q->mutex, 0);
+  pthread_cond_init(&q->changed, 0);
+  p->queue = q;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_create_pipeline(rt_pipeline_pointer *pipeline,
+                                     rt_context_pointer context,
+                                     const rt_pipeline_config_t *config) {
+  pipeline_queue_t *q;
+  pipeline_t *p;
+  rt_return_value_t ret;
+  int i; // Iterator
+
+  *pipeline = 0;
+  if (config->capacity < 1) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  ret = allocate_pipeline(&p, context, config->num_of_stages);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  ret = allocate_queue(p, config->capacity);
+  if (ret != RT_RET_NOERROR) {
+    free_pipeline(p);
+    return ret;
+  }
+  q = p->queue;
+
+  for (i = 0; i < p->num_of_stages; i++) {
+    if (pthread_create(q->threads + i, 0, worker, p->stages + i) != 0) {
+      ret = RT_RET_ERROR_CREATE_THREAD_POOL;
+    } else if (config->cores && !pin_thread(q->threads[i], config->cores[i])) {
+      ret = RT_RET_ERROR_CREATE_THREAD_POOL;
+      i++;
+    }
+    if (ret != RT_RET_NOERROR) {
+      stop_queue(q, i);
+      free_queue(q, p->num_of_stages);
+      free_pipeline(p);
+      return ret;
+    }
+  }
+  *pipeline = p;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_submit_frame(rt_pipeline_pointer pipeline,
+                                  const rt_request_t *request) {
+  pipeline_queue_t *q = ((pipeline_t *)pipeline)->queue;
+  pthread_mutex_lock(&q->mutex);
+  if (q->num_of_frames >= q->capacity) {
+    pthread_mutex_unlock(&q->mutex);
+    return RT_RET_ERROR_QUEUE_FULL;
+  }
+  q->requests[(q->head + q->num_of_pending) % q->capacity] = *request;
+  q->num_of_pending++;
+  q->num_of_frames++;
+  pthread_cond_broadcast(&q->changed);
+  pthread_mutex_unlock(&q->mutex);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_wait_pipeline(rt_pipeline_pointer pipeline) {
+  pipeline_queue_t *q = ((pipeline_t *)pipeline)->queue;
+  rt_return_value_t result;
+  pthread_mutex_lock(&q->mutex);
+  while (q->num_of_frames > 0) {
+    pthread_cond_wait(&q->changed, &q->mutex);
+  }
+  result = q->result;
+  pthread_mutex_unlock(&q->mutex);
+  return result;
+}
+
+rt_return_value_t rt_destroy_pipeline(rt_pipeline_pointer *pipeline) {
+  pipeline_t *p = *pipeline;
+  if (p == 0) {
+    return RT_RET_NOERROR;
+  }
+  stop_queue(p->queue, p->num_of_stages);
+  free_queue(p->queue, p->num_of_stages);
+  free_pipeline(p);
+  *pipeline = 0;
+  return RT_RET_NOERROR;
+}
+
+#else /* NNABLART_USE_PTHREAD */
+
+rt_return_value_t rt_create_pipeline(rt_pipeline_pointer *pipeline,
+                                     rt_context_pointer context,
+                                     const rt_pipeline_config_t *config) {
+  rt_return_value_t ret;
+  pipeline_t *p;
+  rt_return_value_t *result;
+
+  *pipeline = 0;
+  if (config->num_of_stages < 1 || config->capacity < 1) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  // Frames run one by one, so whole network is one stage.
+  ret = allocate_pipeline(&p, context, 1);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  result = rt_malloc_func(sizeof(rt_return_value_t));
+  if (result == 0) {
+    free_pipeline(p);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  *result = RT_RET_NOERROR;
+  p->queue = result;
+  *pipeline = p;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_submit_frame(rt_pipeline_pointer pipeline,
+                                  const rt_request_t *request) {
+  pipeline_t *p = pipeline;
+  rt_return_value_t *result = p->queue;
+  if (request->prepare) {
+    request->prepare(request->user_data, p->stages[0].context);
+  }
+  *result = rt_forward(p->stages[0].context);
+  if (request->done) {
+    request->done(request->user_data, p->stages[0].context, *result);
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_wait_pipeline(rt_pipeline_pointer pipeline) {
+  return *(rt_return_value_t *)((pipeline_t *)pipeline)->queue;
+}
+
+rt_return_value_t rt_destroy_pipeline(rt_pipeline_pointer *pipeline) {
+  pipeline_t *p = *pipeline;
+  if (p) {
+    rt_free_func(p->queue);
+    free_pipeline(p);
+    *pipeline = 0;
+  }
+  return RT_RET_NOERROR;
+}
+
+#endif /* NNABLART_USE_PTHREAD */
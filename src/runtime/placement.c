@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For sched_setaffinity()
+#endif
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/*
+ * Memory is not bound to a node explicitly. Linux places a page on the node
+ * of the CPU which touches it first, so initializing on CPUs of context is
+ * enough without libnuma.
+ */
+
+rt_return_value_t rt_set_placement(rt_context_pointer context,
+                                   const rt_placement_t *placement) {
+  rt_context_t *c = context;
+#ifdef __linux__
+  int i; // Iterator
+#endif
+
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  free_placement(c);
+  c->replicate_network = placement ? placement->replicate_network : 0;
+  if (placement && placement->num_of_cpus > 0) {
+#ifdef __linux__
+    for (i = 0; i < placement->num_of_cpus; i++) {
+      if (placement->cpus[i] < 0 || placement->cpus[i] >= CPU_SETSIZE) {
+        return RT_RET_ERROR_INVALID_INDEX;
+      }
+    }
+#endif
+    c->cpus = rt_malloc_func(sizeof(int) * placement->num_of_cpus);
+    if (c->cpus == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    memcpy(c->cpus, placement->cpus, sizeof(int) * placement->num_of_cpus);
+    c->num_of_cpus = placement->num_of_cpus;
+  }
+  if (c->thread_pool) {
+    // Threads are bound when they start.
+    return rt_set_num_threads(c, c->num_of_threads);
+  }
+  return RT_RET_NOERROR;
+}
+
+int bind_current_thread(const int *cpus, int num_of_cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  int i; // Iterator
+  CPU_ZERO(&set);
+  for (i = 0; i < num_of_cpus; i++) {
+    CPU_SET(cpus[i], &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  (void)num_of_cpus;
+  return 1;
+#endif
+}
+
+void *begin_placement(rt_context_t *c) {
+#ifdef __linux__
+  cpu_set_t *previous;
+  if (c->num_of_cpus == 0) {
+    return 0;
+  }
+  previous = rt_malloc_func(sizeof(cpu_set_t));
+  if (previous == 0) {
+    return 0;
+  }
+  if (sched_getaffinity(0, sizeof(cpu_set_t), previous) != 0 ||
+      !bind_current_thread(c->cpus, c->num_of_cpus)) {
+    // Initialized where caller runs.
+    rt_free_func(previous);
+    return 0;
+  }
+  return previous;
+#else
+  (void)c;
+  return 0;
+#endif
+}
+
+void end_placement(void *previous) {
+#ifdef __linux__
+  if (previous) {
+    sched_setaffinity(0, sizeof(cpu_set_t), previous);
+    rt_free_func(previous);
+  }
+#else
+  (void)previous;
+#endif
+}
+
+rt_return_value_t replicate_network(rt_context_t *c, nn_network_t **n) {
+  free_network_replica(c);
+  if (!c->replicate_network || c->loader.load) {
+    return RT_RET_NOERROR;
+  }
+  c->replica = variable_malloc(NN_NETWORK_SIZE(*n));
+  if (c->replica == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  // Data is addressed relatively to network, so copy works as it is.
+  memcpy(c->replica, *n, NN_NETWORK_SIZE(*n));
+  c->given_network = *n;
+  *n = c->replica;
+  return RT_RET_NOERROR;
+}
+
+void free_network_replica(rt_context_t *c) {
+  if (c->replica) {
+    variable_free(c->replica);
+    c->replica = 0;
+    c->given_network = 0;
+  }
+}
+
+void free_placement(rt_context_t *c) {
+  if (c->cpus) {
+    rt_free_func(c->cpus);
+    c->cpus = 0;
+  }
+  c->num_of_cpus = 0;
+}
@@ -0,0 +1,370 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Plan is an array of uint32_t in native byte order.
+ *
+ * | Word         | Content                                              |
+ * |--------------|------------------------------------------------------|
+ * | 0 - 10       | Key, see make_key()                                  |
+ * | 11           | Number of fusion records, 0 or number of functions   |
+ * | 12           | Number of offsets, 0 or number of variables          |
+ * | 13, 14       | Lower and upper 32 bits of arena size                |
+ * | 15, 16       | Lower and upper 32 bits of size of pinned variables  |
+ * | 17           | Number of kernel choices, 0 or number of functions   |
+ * | 18 -         | RT_FUSION_RECORD_SIZE words for each function        |
+ * |              | Lower and upper 32 bits of offset of each variable   |
+ * |              | Kernel choice of each function in a byte, padded     |
+ *
+ * Parameter values are not in key, since nothing in plan depends on them.
+ * Values folded from them are calculated again. Kernel choices are recorded
+ * when kernels are tuned or given, and used as choices given by
+ * rt_set_kernel_choices() unless others are given.
+ */
+
+#define PLAN_MAGIC (0x50524e4e) // "NNRP"
+#define PLAN_VERSION (8)
+#define PLAN_KEY_SIZE (11)
+#define PLAN_HEADER_SIZE (18)
+
+#define FNV_OFFSET_BASIS (14695981039346656037ULL)
+#define FNV_PRIME (1099511628211ULL)
+
+typedef struct {
+  pointer_index_t offset;
+  int parameter;
+} data_chunk_t;
+
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t size) {
+  const uint8_t *p = data;
+  size_t i; // Iterator
+  for (i = 0; i < size; i++) {
+    hash = (hash ^ p[i]) * FNV_PRIME;
+  }
+  return hash;
+}
+
+static int compare_chunks(const void *a, const void *b) {
+  pointer_index_t x = ((const data_chunk_t *)a)->offset;
+  pointer_index_t y = ((const data_chunk_t *)b)->offset;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// Hash of network except data of parameters, which is not read when
+// parameters are loaded on demand.
+static rt_return_value_t hash_network(nn_network_t *n, rt_context_t *c,
+                                      uint64_t *hash) {
+  int num_of_data = n->memory.num_of_data;
+  const pointer_index_t *index = NN_NETWORK_INDEX_POINTER(n);
+  const uint8_t *data = NN_NETWORK_DATA_POINTER(n);
+  int *list = (int *)NN_GET(n, n->variables.list);
+  data_chunk_t *chunks;
+  uint64_t h = FNV_OFFSET_BASIS;
+  int i; // Iterator
+
+  chunks = rt_malloc_func(sizeof(data_chunk_t) * (num_of_data + 1));
+  if (chunks == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < num_of_data; i++) {
+    chunks[i].offset = index[i];
+    chunks[i].parameter = 0;
+  }
+  for (i = 0; i < n->variables.size; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[i]));
+    if (var->data_index >= 0 && var->data_index < num_of_data) {
+      chunks[var->data_index].parameter = 1;
+    }
+  }
+  qsort(chunks, num_of_data, sizeof(data_chunk_t), compare_chunks);
+  chunks[num_of_data].offset = NN_NETWORK_DATA_SIZE(n);
+
+  h = hash_bytes(h, n, sizeof(nn_network_t) + NN_NETWORK_INDEX_SIZE(n));
+  for (i = 0; i < num_of_data; i++) {
+    if (!chunks[i].parameter && chunks[i + 1].offset > chunks[i].offset) {
+      h = hash_bytes(h, data + chunks[i].offset,
+                     chunks[i + 1].offset - chunks[i].offset);
+    }
+  }
+  rt_free_func(chunks);
+
+  // Functions replaced by callbacks or backends are not merged.
+  for (i = 0; i < c->num_of_callbacks; i++) {
+    h = hash_bytes(h, &c->callbacks[i].type, sizeof(nn_function_type_t));
+  }
+  for (i = 0; i < c->num_of_backends; i++) {
+    int k; // Iterator
+    for (k = 0; k < c->backends[i].num_of_kernels; k++) {
+      h = hash_bytes(h, &c->backends[i].kernels[k].type,
+                     sizeof(nn_function_type_t));
+    }
+  }
+  *hash = h;
+  return RT_RET_NOERROR;
+}
+
+// Kernels are selected when runtime is built, so plan is bound to
+// instruction sets enabled in the build.
+static uint32_t build_features(void) {
+  uint32_t features = 0;
+#ifdef __SSE2__
+  features |= 1 << 0;
+#endif
+#ifdef __AVX__
+  features |= 1 << 1;
+#endif
+#ifdef __AVX2__
+  features |= 1 << 2;
+#endif
+#ifdef __FMA__
+  features |= 1 << 3;
+#endif
+#ifdef __AVX512F__
+  features |= 1 << 4;
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  features |= 1 << 5;
+#endif
+#ifdef __ARM_FEATURE_FMA
+  features |= 1 << 6;
+#endif
+  return features;
+}
+
+static void make_key(nn_network_t *n, rt_context_t *c, uint32_t *key) {
+  uint64_t hash = c->plan_cache.network_hash;
+  key[0] = PLAN_MAGIC;
+  key[1] = PLAN_VERSION;
+  key[2] = (uint32_t)hash;
+  key[3] = (uint32_t)(hash >> 32);
+  key[4] = build_features();
+  key[5] = sizeof(void *);
+  key[6] = RT_VARIABLE_ALIGNMENT;
+  key[7] = (c->buffer_planning != 0) | (c->function_fusion != 0) << 1 |
+           (c->fast_math != 0) << 2 | (c->loader.load != 0) << 3 |
+           (c->activations.enabled != 0) << 4 | (c->window_hop != 0) << 5 |
+           (c->result_caching != RT_RESULT_CACHING_NONE) << 6 |
+           (c->graph_simplification != 0) << 7 |
+           (c->tile_cache_size != 0) << 8;
+  key[8] = c->batch_size;
+  key[9] = n->functions.size;
+  key[10] = n->variables.size;
+}
+
+// Words of plan before kernel choices.
+static size_t plan_words(uint32_t num_of_records, uint32_t num_of_offsets) {
+  return PLAN_HEADER_SIZE + (size_t)num_of_records * RT_FUSION_RECORD_SIZE +
+         (size_t)num_of_offsets * 2;
+}
+
+static size_t kernel_words(uint32_t num_of_kernels) {
+  return ((size_t)num_of_kernels + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+}
+
+static int is_valid_index(int32_t index, int size) {
+  return index >= -1 && index < size;
+}
+
+// Indices in recorded fusions must be in network, even if plan is broken.
+static int is_valid_fusion_record(nn_network_t *n, const uint32_t *words) {
+  const int32_t *record = (const int32_t *)words;
+  int num_of_functions = n->functions.size;
+  int num_of_variables = n->variables.size;
+  int i, k; // Iterator
+  for (i = 0; i < num_of_functions; i++, record += RT_FUSION_RECORD_SIZE) {
+    if ((record[0] != 0 && record[0] != 1) ||
+        !is_valid_index(record[1], num_of_variables) ||
+        !is_valid_index(record[5], num_of_variables) ||
+        (record[9] >= 0 && record[9] <= i) || record[14] >= i) {
+      return 0;
+    }
+    for (k = 2; k < RT_FUSION_RECORD_SIZE; k++) {
+      if (k != 5 && !is_valid_index(record[k], num_of_functions)) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+rt_return_value_t prepare_plan_cache(nn_network_t *n, rt_context_t *c) {
+  plan_cache_t *p = &c->plan_cache;
+  const uint32_t *given = p->given;
+  uint32_t key[PLAN_KEY_SIZE];
+  size_t size;
+
+  p->given = 0;
+  p->reused = 0;
+  if (!p->enabled) {
+    return RT_RET_NOERROR;
+  }
+  rt_return_value_t ret = hash_network(n, c, &p->network_hash);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  make_key(n, c, key);
+  if (given == 0 || ((uintptr_t)given & (sizeof(uint32_t) - 1)) != 0 ||
+      p->given_size < sizeof(uint32_t) * PLAN_HEADER_SIZE ||
+      memcmp(given, key, sizeof(key)) != 0) {
+    return RT_RET_NOERROR;
+  }
+  if ((given[11] != 0 && given[11] != (uint32_t)n->functions.size) ||
+      (given[12] != 0 && given[12] != (uint32_t)n->variables.size) ||
+      (given[17] != 0 && given[17] != (uint32_t)n->functions.size)) {
+    return RT_RET_NOERROR;
+  }
+  size = sizeof(uint32_t) *
+         (plan_words(given[11], given[12]) + kernel_words(given[17]));
+  if (p->given_size != size ||
+      (given[11] && !is_valid_fusion_record(n, given + PLAN_HEADER_SIZE))) {
+    return RT_RET_NOERROR;
+  }
+  p->given = given;
+  p->reused = 1;
+  if (given[17] && c->kernels.given == 0) {
+    // Kernels are not timed again.
+    c->kernels.given =
+        (const uint8_t *)(given + plan_words(given[11], given[12]));
+    c->kernels.given_size = (int)given[17];
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t restore_cached_fusion(nn_network_t *n, rt_context_t *c) {
+  const uint32_t *given = c->plan_cache.given;
+  return restore_function_fusion(
+      n, c, given[11] ? (const int32_t *)(given + PLAN_HEADER_SIZE) : 0);
+}
+
+int restore_cached_offsets(nn_network_t *n, rt_context_t *c, size_t *offsets,
+                           size_t *arena_size, size_t *pinned_size) {
+  plan_cache_t *p = &c->plan_cache;
+  int *list = (int *)NN_GET(n, n->variables.list);
+  const uint32_t *words;
+  int i; // Iterator
+
+  if (p->given == 0 || p->given[12] == 0) {
+    return 0;
+  }
+  words = p->given + PLAN_HEADER_SIZE +
+          (size_t)p->given[11] * RT_FUSION_RECORD_SIZE;
+  *arena_size = p->given[13] | (size_t)((uint64_t)p->given[14] << 32);
+  *pinned_size = p->given[15] | (size_t)((uint64_t)p->given[16] << 32);
+  if (*pinned_size > *arena_size) {
+    p->given = 0;
+    p->reused = 0;
+    return 0;
+  }
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[i]));
+    offsets[i] = words[2 * i] | (size_t)((uint64_t)words[2 * i + 1] << 32);
+    if (var->data_index < 0 &&
+        (offsets[i] > *arena_size ||
+         calc_variable_data_size(c->variables + i) >
+             *arena_size - offsets[i])) {
+      // Broken plan, variables are planned again and recorded.
+      p->given = 0;
+      p->reused = 0;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+rt_return_value_t record_plan(nn_network_t *n, rt_context_t *c,
+                              const size_t *offsets, size_t arena_size,
+                              size_t pinned_size) {
+  plan_cache_t *p = &c->plan_cache;
+  uint32_t num_of_records = c->fusions ? n->functions.size : 0;
+  uint32_t num_of_offsets = offsets ? n->variables.size : 0;
+  uint32_t num_of_kernels =
+      c->kernels.tuning || c->kernels.given ? n->functions.size : 0;
+  size_t size = plan_words(num_of_records, num_of_offsets);
+  uint32_t *words;
+  int i; // Iterator
+
+  if (!p->enabled) {
+    return RT_RET_NOERROR;
+  }
+  p->recorded_size =
+      sizeof(uint32_t) * (size + kernel_words(num_of_kernels));
+  p->recorded = rt_malloc_func(p->recorded_size);
+  if (p->recorded == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  // Choices are written by record_kernel_choices() after functions are
+  // allocated.
+  memset(p->recorded + size, 0, p->recorded_size - sizeof(uint32_t) * size);
+  if (p->given) {
+    // Same plan is made again.
+    if (p->given[17] == num_of_kernels) {
+      memcpy(p->recorded, p->given, p->recorded_size);
+    } else {
+      memcpy(p->recorded, p->given, sizeof(uint32_t) * size);
+      p->recorded[17] = num_of_kernels;
+      p->reused = 0;
+    }
+    p->given = 0;
+    return RT_RET_NOERROR;
+  }
+  make_key(n, c, p->recorded);
+  words = p->recorded + PLAN_KEY_SIZE;
+  *words++ = num_of_records;
+  *words++ = num_of_offsets;
+  *words++ = (uint32_t)arena_size;
+  *words++ = (uint32_t)((uint64_t)arena_size >> 32);
+  *words++ = (uint32_t)pinned_size;
+  *words++ = (uint32_t)((uint64_t)pinned_size >> 32);
+  *words++ = num_of_kernels;
+  if (num_of_records) {
+    record_function_fusion(n, c, (int32_t *)words);
+    words += num_of_records * RT_FUSION_RECORD_SIZE;
+  }
+  for (i = 0; i < (int)num_of_offsets; i++) {
+    *words++ = (uint32_t)offsets[i];
+    *words++ = (uint32_t)((uint64_t)offsets[i] >> 32);
+  }
+  return RT_RET_NOERROR;
+}
+
+void record_kernel_choices(rt_context_t *c) {
+  plan_cache_t *p = &c->plan_cache;
+  uint32_t *recorded = p->recorded;
+  uint8_t *choices;
+
+  if (recorded == 0 || recorded[17] == 0 || c->kernels.chosen == 0) {
+    return;
+  }
+  choices = (uint8_t *)(recorded + plan_words(recorded[11], recorded[12]));
+  if (memcmp(choices, c->kernels.chosen, c->num_of_functions) != 0) {
+    memcpy(choices, c->kernels.chosen, c->num_of_functions);
+    p->reused = 0;
+  }
+}
+
+void free_plan_cache(rt_context_t *c) {
+  if (c->plan_cache.recorded) {
+    rt_free_func(c->plan_cache.recorded);
+    c->plan_cache.recorded = 0;
+  }
+  c->plan_cache.recorded_size = 0;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(_MSC_VER) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L // For clock_gettime() with -std=c99
+#endif
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#endif
+
+static uint64_t (*profile_clock)(void) = 0;
+
+void rt_set_profile_clock(uint64_t (*clock_nsec)(void)) {
+  profile_clock = clock_nsec;
+}
+
+uint64_t profile_now(void) {
+  if (profile_clock) {
+    return profile_clock();
+  }
+#if defined(_MSC_VER)
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ULL +
+         (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ULL /
+             frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+  return (uint64_t)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+rt_return_value_t allocate_profile(rt_context_t *c) {
+  int i; // Iterator
+  if (c->profile == 0) {
+    c->profile =
+        rt_malloc_func(sizeof(rt_function_profile_t) * c->num_of_functions);
+    if (c->profile == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+  }
+  memset(c->profile, 0, sizeof(rt_function_profile_t) * c->num_of_functions);
+  for (i = 0; i < c->num_of_functions; i++) {
+    c->profile[i].type = c->functions[i].info->type;
+    c->profile[i].impl = c->functions[i].info->impl;
+  }
+  return RT_RET_NOERROR;
+}
+
+void record_profile(rt_function_profile_t *profile, uint64_t elapsed) {
+  profile->call_count++;
+  profile->total_nsec += elapsed;
+  if (elapsed > profile->max_nsec) {
+    profile->max_nsec = elapsed;
+  }
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(NNABLART_USE_PERF_EVENT) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For syscall()
+#endif
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+#ifdef NNABLART_USE_PERF_EVENT
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+ * Counters of a thread are one perf event group, so that one read() gives
+ * all of them. Events count only the thread which opened them, so each
+ * thread index of thread pool has its own group, opened by the thread which
+ * reads it first, and opened again if another thread has that index later.
+ */
+
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} events[RT_PROFILE_COUNTER_END] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+};
+
+static void close_counters(int *fds) {
+  int k; // Iterator
+  for (k = RT_PROFILE_COUNTER_END - 1; k >= 0; k--) {
+    if (fds[k] >= 0) {
+      close(fds[k]);
+      fds[k] = -1;
+    }
+  }
+}
+
+// Returns number of counters opened for calling thread.
+static int open_counters(int *fds) {
+  struct perf_event_attr attr;
+  int leader = -1;
+  int count = 0;
+  int k; // Iterator
+
+  for (k = 0; k < RT_PROFILE_COUNTER_END; k++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[k].type;
+    attr.config = events[k].config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fds[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+    if (fds[k] < 0) {
+      fds[k] = -1;
+      continue;
+    }
+    if (leader < 0) {
+      leader = fds[k];
+    }
+    count++;
+  }
+  return count;
+}
+
+rt_return_value_t prepare_profile_counters(rt_context_t *c) {
+  profile_counters_t *p;
+  int num_of_threads = c->thread_pool ? c->num_of_threads : 1;
+  int i; // Iterator
+
+  free_profile_counters(c);
+  p = rt_malloc_func(sizeof(profile_counters_t));
+  if (p == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  p->num_of_threads = num_of_threads;
+  p->fds =
+      rt_malloc_func(sizeof(int) * RT_PROFILE_COUNTER_END * num_of_threads);
+  p->owners = rt_malloc_func(sizeof(long) * num_of_threads);
+  c->counters = p;
+  if (p->fds == 0 || p->owners == 0) {
+    free_profile_counters(c);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < RT_PROFILE_COUNTER_END * num_of_threads; i++) {
+    p->fds[i] = -1;
+  }
+  for (i = 0; i < num_of_threads; i++) {
+    p->owners[i] = 0;
+  }
+
+  // Calling thread is usually the one which calls rt_forward().
+  if (open_counters(p->fds) == 0) {
+    free_profile_counters(c);
+    return RT_RET_ERROR_NO_PROFILE_COUNTER;
+  }
+  p->owners[0] = (long)syscall(SYS_gettid);
+  return RT_RET_NOERROR;
+}
+
+void free_profile_counters(rt_context_t *c) {
+  profile_counters_t *p = c->counters;
+  int i; // Iterator
+  if (p == 0) {
+    return;
+  }
+  if (p->fds) {
+    for (i = 0; i < p->num_of_threads; i++) {
+      close_counters(p->fds + i * RT_PROFILE_COUNTER_END);
+    }
+    rt_free_func(p->fds);
+  }
+  if (p->owners) {
+    rt_free_func(p->owners);
+  }
+  rt_free_func(p);
+  c->counters = 0;
+}
+
+void read_profile_counters(profile_counters_t *p, uint64_t *values) {
+  uint64_t buffer[1 + RT_PROFILE_COUNTER_END];
+  int t = current_thread_index();
+  int *fds;
+  long tid;
+  int j, k; // Iterator
+
+  memset(values, 0, sizeof(uint64_t) * RT_PROFILE_COUNTER_END);
+  if (t >= p->num_of_threads) {
+    return;
+  }
+  fds = p->fds + t * RT_PROFILE_COUNTER_END;
+  tid = (long)syscall(SYS_gettid);
+  if (p->owners[t] != tid) {
+    close_counters(fds);
+    open_counters(fds);
+    p->owners[t] = tid;
+  }
+  k = 0;
+  while (k < RT_PROFILE_COUNTER_END && fds[k] < 0) {
+    k++;
+  }
+  if (k == RT_PROFILE_COUNTER_END ||
+      read(fds[k], buffer, sizeof(buffer)) < (ssize_t)sizeof(uint64_t)) {
+    return;
+  }
+  // Values are in order of events added to group.
+  for (j = 1; k < RT_PROFILE_COUNTER_END && j <= (int)buffer[0]; k++) {
+    if (fds[k] >= 0) {
+      values[k] = buffer[j++];
+    }
+  }
+}
+
+#else /* NNABLART_USE_PERF_EVENT */
+
+rt_return_value_t prepare_profile_counters(rt_context_t *c) {
+  (void)c;
+  return RT_RET_ERROR_NO_PROFILE_COUNTER;
+}
+
+void free_profile_counters(rt_context_t *c) { c->counters = 0; }
+
+void read_profile_counters(profile_counters_t *p, uint64_t *values) {
+  (void)p;
+  memset(values, 0, sizeof(uint64_t) * RT_PROFILE_COUNTER_END);
+}
+
+#endif /* NNABLART_USE_PERF_EVENT */
+
+void record_profile_counters(rt_function_profile_t *profile,
+                             const uint64_t *start, const uint64_t *end) {
+  int k; // Iterator
+  for (k = 0; k < RT_PROFILE_COUNTER_END; k++) {
+    profile->counters[k] += end[k] - start[k];
+  }
+}
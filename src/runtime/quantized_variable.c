@@ -0,0 +1,108 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Scales and zero points of per channel quantization are read from network
+ * as they are. Context owns only rt_quantization_t which points to them.
+ */
+
+static int is_valid_quantization(const nn_quantization_t *header,
+                                 const rt_variable_t *v) {
+  const float *scales = (const float *)(header + 1);
+  int i; // Iterator
+
+  if ((v->type != NN_DATA_TYPE_INT8 && v->type != NN_DATA_TYPE_INT16) ||
+      v->layout != NN_DATA_LAYOUT_DENSE || header->axis < 0 ||
+      header->axis >= v->shape.size ||
+      header->channels != v->shape.data[header->axis]) {
+    return 0;
+  }
+  for (i = 0; i < header->channels; i++) {
+    if (!(scales[i] > 0.0f)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+rt_return_value_t prepare_quantized_variables(nn_network_t *n,
+                                              rt_context_t *c) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  rt_quantization_t *q;
+  int count = 0;
+  int i, j; // Iterator
+
+  for (i = 0; i < c->num_of_variables; i++) {
+    c->variables[i].quantization = 0;
+  }
+  if (n->version < 4) {
+    return RT_RET_NOERROR;
+  }
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    if (var->quantization >= 0) {
+      count++;
+    }
+  }
+  if (count == 0) {
+    return RT_RET_NOERROR;
+  }
+
+  c->quantizations = rt_malloc_func(sizeof(rt_quantization_t) * count);
+  if (c->quantizations == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  q = c->quantizations;
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    rt_variable_t *v = c->variables + i;
+    const nn_quantization_t *header;
+    if (var->quantization < 0) {
+      continue;
+    }
+    header = (const nn_quantization_t *)NN_GET(n, var->quantization);
+    if (!is_valid_quantization(header, v)) {
+      return RT_RET_ERROR_INIT_VARIABLE;
+    }
+    q->axis = header->axis;
+    q->channels = header->channels;
+    q->inner = 1;
+    for (j = header->axis + 1; j < v->shape.size; j++) {
+      q->inner *= v->shape.data[j];
+    }
+    q->scales = (const float *)(header + 1);
+    q->zero_points = header->has_zero_point
+                         ? (const int32_t *)(q->scales + header->channels)
+                         : 0;
+    v->quantization = q++;
+  }
+  return RT_RET_NOERROR;
+}
+
+void free_quantized_variables(rt_context_t *c) {
+  if (c->quantizations) {
+    rt_free_func(c->quantizations);
+    c->quantizations = 0;
+  }
+}
+
+int is_same_fixed_point(const rt_variable_t *x, const rt_variable_t *y) {
+  return x->type == y->type && x->fp_pos == y->fp_pos && !x->quantization &&
+         !y->quantization;
+}
@@ -0,0 +1,279 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Each context of a queue has one thread, which takes the oldest pending
+ * request and runs it with that context. rt_forward_async() uses a queue of
+ * its context alone whose capacity is one request, so that inputs are not
+ * changed while forward runs.
+ */
+
+static void run_request(rt_context_pointer context,
+                        const rt_request_t *request,
+                        rt_return_value_t *result) {
+  rt_return_value_t ret;
+  if (request->prepare) {
+    request->prepare(request->user_data, context);
+  }
+  ret = rt_forward(context);
+  *result = ret;
+  if (request->done) {
+    request->done(request->user_data, context, ret);
+  }
+}
+
+#ifdef NNABLART_USE_PTHREAD
+
+#include <pthread.h>
+
+typedef struct {
+  int num_of_contexts;
+  rt_context_pointer *contexts;
+  pthread_t *threads;
+  int num_of_started; ///< Number of threads which took their context.
+
+  pthread_mutex_t mutex;
+  pthread_cond_t submitted;
+  pthread_cond_t finished;
+  int shutdown;
+
+  int capacity;
+  rt_request_t *requests; ///< Ring of pending requests.
+  int head;               ///< Oldest pending request.
+  int num_of_pending;
+  int num_of_running;
+  rt_return_value_t result; ///< Result of last finished request.
+} request_queue_t;
+
+static void *worker(void *arg) {
+  request_queue_t *q = arg;
+  rt_context_pointer context;
+  rt_request_t request;
+  rt_return_value_t result;
+
+  pthread_mutex_lock(&q->mutex);
+  context = q->contexts[q->num_of_started++];
+  for (;;) {
+    while (q->num_of_pending == 0 && !q->shutdown) {
+      pthread_cond_wait(&q->submitted, &q->mutex);
+    }
+    if (q->num_of_pending == 0) {
+      break; // Shut down after pending requests are finished.
+    }
+    request = q->requests[q->head];
+    q->head = (q->head + 1) % q->capacity;
+    q->num_of_pending--;
+    q->num_of_running++;
+    pthread_mutex_unlock(&q->mutex);
+
+    run_request(context, &request, &result);
+
+    pthread_mutex_lock(&q->mutex);
+    q->num_of_running--;
+    q->result = result;
+    pthread_cond_broadcast(&q->finished);
+  }
+  pthread_mutex_unlock(&q->mutex);
+  return 0;
+}
+
+static void free_queue(request_queue_t *q) {
+  if (q->threads) {
+    rt_free_func(q->threads);
+  }
+  if (q->contexts) {
+    rt_free_func(q->contexts);
+  }
+  if (q->requests) {
+    rt_free_func(q->requests);
+  }
+  rt_free_func(q);
+}
+
+// Stop threads after pending requests.
+static void stop_queue(request_queue_t *q, int num_of_threads) {
+  int i; // Iterator
+  pthread_mutex_lock(&q->mutex);
+  q->shutdown = 1;
+  pthread_cond_broadcast(&q->submitted);
+  pthread_mutex_unlock(&q->mutex);
+  for (i = 0; i < num_of_threads; i++) {
+    pthread_join(q->threads[i], 0);
+  }
+  pthread_cond_destroy(&q->finished);
+  pthread_cond_destroy(&q->submitted);
+  pthread_mutex_destroy(&q->mutex);
+}
+
+rt_return_value_t rt_create_request_queue(rt_request_queue_pointer *queue,
+                                          rt_context_pointer *contexts,
+                                          int num_of_contexts, int capacity) {
+  request_queue_t *q;
+  int i; // Iterator
+
+  *queue = 0;
+  if (num_of_contexts < 1 || capacity < 1) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  q = rt_malloc_func(sizeof(request_queue_t));
+  if (q == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(q, 0, sizeof(request_queue_t));
+  q->num_of_contexts = num_of_contexts;
+  q->capacity = capacity;
+  q->result = RT_RET_NOERROR;
+  q->contexts = rt_malloc_func(sizeof(rt_context_pointer) * num_of_contexts);
+  q->threads = rt_malloc_func(sizeof(pthread_t) * num_of_contexts);
+  q->requests = rt_malloc_func(sizeof(rt_request_t) * capacity);
+  if (q->contexts == 0 || q->threads == 0 || q->requests == 0) {
+    free_queue(q);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memcpy(q->contexts, contexts, sizeof(rt_context_pointer) * num_of_contexts);
+  pthread_mutex_init(&q->mutex, 0);
+  pthread_cond_init(&q->submitted, 0);
+  pthread_cond_init(&q->finished, 0);
+
+  for (i = 0; i < num_of_contexts; i++) {
+    if (pthread_create(q->threads + i, 0, worker, q) != 0) {
+      stop_queue(q, i);
+      free_queue(q);
+      return RT_RET_ERROR_CREATE_THREAD_POOL;
+    }
+  }
+  *queue = q;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_submit_request(rt_request_queue_pointer queue,
+                                    const rt_request_t *request) {
+  request_queue_t *q = queue;
+  pthread_mutex_lock(&q->mutex);
+  if (q->num_of_pending + q->num_of_running >= q->capacity) {
+    pthread_mutex_unlock(&q->mutex);
+    return RT_RET_ERROR_QUEUE_FULL;
+  }
+  q->requests[(q->head + q->num_of_pending) % q->capacity] = *request;
+  q->num_of_pending++;
+  pthread_cond_signal(&q->submitted);
+  pthread_mutex_unlock(&q->mutex);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_wait_requests(rt_request_queue_pointer queue) {
+  request_queue_t *q = queue;
+  rt_return_value_t result;
+  pthread_mutex_lock(&q->mutex);
+  while (q->num_of_pending + q->num_of_running > 0) {
+    pthread_cond_wait(&q->finished, &q->mutex);
+  }
+  result = q->result;
+  pthread_mutex_unlock(&q->mutex);
+  return result;
+}
+
+rt_return_value_t rt_destroy_request_queue(rt_request_queue_pointer *queue) {
+  request_queue_t *q = *queue;
+  if (q == 0) {
+    return RT_RET_NOERROR;
+  }
+  stop_queue(q, q->num_of_contexts);
+  free_queue(q);
+  *queue = 0;
+  return RT_RET_NOERROR;
+}
+
+#else /* NNABLART_USE_PTHREAD */
+
+typedef struct {
+  rt_context_pointer context;
+  rt_return_value_t result;
+} request_queue_t;
+
+rt_return_value_t rt_create_request_queue(rt_request_queue_pointer *queue,
+                                          rt_context_pointer *contexts,
+                                          int num_of_contexts, int capacity) {
+  request_queue_t *q;
+  *queue = 0;
+  if (num_of_contexts < 1 || capacity < 1) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  q = rt_malloc_func(sizeof(request_queue_t));
+  if (q == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  // Requests run one by one, so one context is enough.
+  q->context = contexts[0];
+  q->result = RT_RET_NOERROR;
+  *queue = q;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_submit_request(rt_request_queue_pointer queue,
+                                    const rt_request_t *request) {
+  request_queue_t *q = queue;
+  run_request(q->context, request, &q->result);
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_wait_requests(rt_request_queue_pointer queue) {
+  return ((request_queue_t *)queue)->result;
+}
+
+rt_return_value_t rt_destroy_request_queue(rt_request_queue_pointer *queue) {
+  if (*queue) {
+    rt_free_func(*queue);
+    *queue = 0;
+  }
+  return RT_RET_NOERROR;
+}
+
+#endif /* NNABLART_USE_PTHREAD */
+
+rt_return_value_t rt_forward_async(rt_context_pointer context,
+                                   rt_forward_callback_t done,
+                                   void *user_data) {
+  rt_context_t *c = context;
+  rt_request_t request;
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (c->async == 0) {
+    rt_return_value_t ret = rt_create_request_queue(&c->async, &context, 1, 1);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  request.prepare = 0;
+  request.done = done;
+  request.user_data = user_data;
+  return rt_submit_request(c->async, &request);
+}
+
+rt_return_value_t rt_wait_forward(rt_context_pointer context) {
+  rt_context_t *c = context;
+  if (c->async == 0) {
+    return RT_RET_NOERROR;
+  }
+  return rt_wait_requests(c->async);
+}
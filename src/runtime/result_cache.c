@@ -0,0 +1,250 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Every variable has its own area planned with keep_all, so output of a
+ * function stays in its area until the function runs again. A function runs
+ * if it reads a changed input, or if one it depends on in the dependency
+ * graph runs. Without graph, functions are a chain and each depends on the
+ * former one.
+ */
+
+#define HASH_PRIME 0x100000001b3ULL
+
+rt_return_value_t rt_set_result_caching(rt_context_pointer context,
+                                        rt_result_caching_t mode) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  if (mode < RT_RESULT_CACHING_NONE || mode > RT_RESULT_CACHING_HASHED) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  c->result_caching = mode;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_mark_input_changed(rt_context_pointer context,
+                                        size_t index) {
+  rt_context_t *c = context;
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (index >= (size_t)c->num_of_inputs) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  if (c->cache) {
+    c->cache->marked[index] = 1;
+  }
+  return RT_RET_NOERROR;
+}
+
+// Words are mixed at once, since inputs are hashed in every rt_forward().
+static uint64_t hash_data(const void *data, size_t size) {
+  const uint8_t *p = data;
+  uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+  uint64_t word;
+  size_t i; // Iterator
+
+  for (i = 0; i + sizeof(word) <= size; i += sizeof(word)) {
+    memcpy(&word, p + i, sizeof(word));
+    hash = (hash ^ word) * HASH_PRIME;
+    hash ^= hash >> 29;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ p[i]) * HASH_PRIME;
+  }
+  return hash;
+}
+
+static int is_reading(const rt_function_t *f, const uint8_t *begin,
+                      const uint8_t *end) {
+  int i; // Iterator
+  for (i = 0; i < f->num_of_inputs; i++) {
+    const rt_variable_t *v = f->inputs[i];
+    if (v != 0) {
+      const uint8_t *data = v->data;
+      if (data < end && begin < data + calc_variable_data_size(v)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+static int is_stateful(rt_context_t *c, int i) {
+  nn_function_type_t type = c->functions[i].info->type;
+  return c->recurrent_streaming &&
+         (type == NN_FUNCTION_RNN || type == NN_FUNCTION_LSTM ||
+          type == NN_FUNCTION_GRU);
+}
+
+rt_return_value_t build_result_cache(rt_context_t *c) {
+  int num_of_data = c->num_of_inputs + c->num_of_outputs;
+  int num_of_readers = 0;
+  int i, k; // Iterator
+
+  c->cache = 0;
+  if (c->result_caching == RT_RESULT_CACHING_NONE || c->loader.load ||
+      c->window_hop) {
+    return RT_RET_NOERROR;
+  }
+  result_cache_t *cache = rt_malloc_func(sizeof(result_cache_t));
+  if (cache == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(cache, 0, sizeof(result_cache_t));
+  c->cache = cache;
+  if (c->graph) {
+    cache->graph = c->graph;
+  } else {
+    rt_return_value_t ret = build_function_graph(c, &cache->graph);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+    cache->own_graph = 1;
+  }
+
+  for (k = 0; k < c->num_of_inputs; k++) {
+    const rt_variable_t *v = c->variables + c->input_variable_ids[k];
+    const uint8_t *begin = v->data;
+    for (i = 0; i < c->num_of_functions; i++) {
+      num_of_readers +=
+          is_reading(&c->functions[i].func, begin,
+                     begin + calc_variable_data_size(v));
+    }
+  }
+  cache->reader_offsets = rt_malloc_func(sizeof(int) * (c->num_of_inputs + 1));
+  cache->readers = rt_malloc_func(sizeof(int) * (num_of_readers + 1));
+  cache->marked = rt_malloc_func(c->num_of_inputs + 1);
+  cache->hashes = rt_malloc_func(sizeof(uint64_t) * (c->num_of_inputs + 1));
+  cache->data = rt_malloc_func(sizeof(void *) * (num_of_data + 1));
+  cache->dirty = rt_malloc_func(c->num_of_functions + 1);
+  if (cache->reader_offsets == 0 || cache->readers == 0 ||
+      cache->marked == 0 || cache->hashes == 0 || cache->data == 0 ||
+      cache->dirty == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+
+  num_of_readers = 0;
+  for (k = 0; k < c->num_of_inputs; k++) {
+    const rt_variable_t *v = c->variables + c->input_variable_ids[k];
+    const uint8_t *begin = v->data;
+    cache->reader_offsets[k] = num_of_readers;
+    for (i = 0; i < c->num_of_functions; i++) {
+      if (is_reading(&c->functions[i].func, begin,
+                     begin + calc_variable_data_size(v))) {
+        cache->readers[num_of_readers++] = i;
+      }
+    }
+    cache->marked[k] = 0;
+  }
+  cache->reader_offsets[c->num_of_inputs] = num_of_readers;
+  memset(cache->data, 0, sizeof(void *) * (num_of_data + 1));
+  memset(cache->dirty, 1, c->num_of_functions + 1);
+  cache->valid = 0;
+  return RT_RET_NOERROR;
+}
+
+// Mark readers of input k, and keep its data and hash for next run.
+static void check_input(rt_context_t *c, int k) {
+  result_cache_t *cache = c->cache;
+  const rt_variable_t *v = c->variables + c->input_variable_ids[k];
+  int changed = cache->data[k] != v->data || cache->marked[k];
+  int i; // Iterator
+
+  cache->data[k] = v->data;
+  if (c->result_caching == RT_RESULT_CACHING_HASHED) {
+    uint64_t hash = hash_data(v->data, calc_variable_data_size(v));
+    changed |= hash != cache->hashes[k];
+    cache->hashes[k] = hash;
+  }
+  if (changed) {
+    for (i = cache->reader_offsets[k]; i < cache->reader_offsets[k + 1];
+         i++) {
+      cache->dirty[cache->readers[i]] = 1;
+    }
+  }
+}
+
+void begin_result_cache(rt_context_t *c) {
+  result_cache_t *cache = c->cache;
+  function_graph_t *g = cache->graph;
+  int i, j, k; // Iterator
+
+  for (k = 0; k < c->num_of_outputs; k++) {
+    void *data = c->variables[c->output_variable_ids[k]].data;
+    if (cache->data[c->num_of_inputs + k] != data) {
+      // Functions which are not run do not write bound buffer.
+      cache->data[c->num_of_inputs + k] = data;
+      cache->valid = 0;
+    }
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    cache->dirty[i] = !cache->valid || is_stateful(c, i);
+  }
+  for (k = 0; k < c->num_of_inputs; k++) {
+    check_input(c, k);
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    if (!cache->dirty[i]) {
+      continue;
+    }
+    if (g == 0) {
+      cache->dirty[i + 1] = 1;
+      continue;
+    }
+    for (j = g->successor_offsets[i]; j < g->successor_offsets[i + 1]; j++) {
+      cache->dirty[g->successors[j]] = 1;
+    }
+  }
+}
+
+void end_result_cache(rt_context_t *c, int succeeded) {
+  result_cache_t *cache = c->cache;
+  cache->valid = succeeded;
+  if (succeeded) {
+    memset(cache->marked, 0, c->num_of_inputs);
+  }
+}
+
+void invalidate_result_cache(rt_context_t *c) {
+  c->cache->valid = 0;
+  memset(c->cache->dirty, 1, c->num_of_functions);
+}
+
+void free_result_cache(rt_context_t *c) {
+  result_cache_t *cache = c->cache;
+  if (cache == 0) {
+    return;
+  }
+  if (cache->own_graph && cache->graph) {
+    free_function_graph(cache->graph);
+  }
+  rt_free_func(cache->reader_offsets);
+  rt_free_func(cache->readers);
+  rt_free_func(cache->marked);
+  rt_free_func(cache->hashes);
+  rt_free_func(cache->data);
+  rt_free_func(cache->dirty);
+  rt_free_func(cache);
+  c->cache = 0;
+}
@@ -15,6 +15,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include <nnablart/config.h>
 #include <nnablart/network.h>
 #include <nnablart/runtime.h>
 
@@ -23,8 +24,8 @@
 void *(*rt_variable_malloc_func)(size_t size) = malloc;
 void (*rt_variable_free_func)(void *ptr) = free;
 
-void *(*rt_malloc_func)(size_t size) = malloc;
-void (*rt_free_func)(void *ptr) = free;
+void *(*rt_malloc_func)(size_t size) = context_malloc;
+void (*rt_free_func)(void *ptr) = context_free;
 
 rt_return_value_t rt_allocate_context(rt_context_pointer *context) {
   rt_context_t *c = rt_malloc_func(sizeof(rt_context_t));
@@ -34,10 +35,60 @@ rt_return_value_t rt_allocate_context(rt_context_pointer *context) {
   }
   c->callbacks = 0;
   c->num_of_callbacks = 0;
+  c->prepack_limit = (size_t)-1;
   *context = c;
   return RT_RET_NOERROR;
 }
 
+rt_return_value_t rt_allocate_static_context(rt_context_pointer *context,
+                                             void *block, size_t size) {
+  uint8_t *base =
+      (uint8_t *)RT_ALIGN_SIZE((uintptr_t)block, RT_ARENA_ALIGNMENT);
+  size_t margin = (size_t)(base - (uint8_t *)block);
+  rt_context_t *c;
+
+  if (block == 0) {
+    // Context on heap measures size of block.
+    rt_return_value_t ret = rt_allocate_context(context);
+    if (ret == RT_RET_NOERROR) {
+      init_static_block(*context, 0, 0);
+    }
+    return ret;
+  }
+  if (margin > size ||
+      size - margin < RT_ALIGN_SIZE(sizeof(rt_context_t), RT_ARENA_ALIGNMENT)) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  c = (rt_context_t *)base;
+  memset(c, 0, sizeof(rt_context_t));
+  c->prepack_limit = (size_t)-1;
+  init_static_block(c, base, size - margin);
+  *context = c;
+  return RT_RET_NOERROR;
+}
+
+size_t rt_static_context_size(rt_context_pointer context) {
+  rt_context_t *c = context;
+  if (!c->block.enabled) {
+    return 0;
+  }
+  // Given block may be aligned by runtime.
+  return c->block.peak + RT_ARENA_ALIGNMENT - 1;
+}
+
+size_t rt_context_required_size(nn_network_t *net) {
+  rt_context_pointer context;
+  size_t size = 0;
+  if (rt_allocate_static_context(&context, 0, 0) != RT_RET_NOERROR) {
+    return 0;
+  }
+  if (rt_initialize_context(context, net) == RT_RET_NOERROR) {
+    size = rt_static_context_size(context);
+  }
+  rt_free_context(&context);
+  return size;
+}
+
 void rt_set_variable_malloc(void *(*user_malloc)(size_t size)) {
   if (user_malloc == 0) {
     rt_variable_malloc_func = malloc;
@@ -56,17 +107,17 @@ void rt_set_variable_free(void (*user_free)(void *ptr)) {
 
 void rt_set_malloc(void *(*user_malloc)(size_t size)) {
   if (user_malloc == 0) {
-    rt_malloc_func = malloc;
+    set_backend_malloc(malloc);
   } else {
-    rt_malloc_func = user_malloc;
+    set_backend_malloc(user_malloc);
   }
 }
 
 void rt_set_free(void (*user_free)(void *ptr)) {
   if (user_free == 0) {
-    rt_free_func = free;
+    set_backend_free(free);
   } else {
-    rt_free_func = user_free;
+    set_backend_free(user_free);
   }
 }
 
@@ -77,8 +128,8 @@ rt_return_value_t rt_add_callback(
   rt_context_t *c = context;
 
   rt_function_callback_t *callbacks;
-  callbacks = rt_malloc_func((c->num_of_callbacks + 1) *
-                             sizeof(rt_function_callback_t));
+  callbacks = context_owned_malloc(c, (c->num_of_callbacks + 1) *
+                                          sizeof(rt_function_callback_t));
   if (callbacks == 0) {
     return RT_RET_ERROR_ALLOCATE_CALLBACK_BUFFER;
   }
@@ -88,7 +139,7 @@ rt_return_value_t rt_add_callback(
   } else {
     memcpy(callbacks, c->callbacks,
            c->num_of_callbacks * sizeof(rt_function_callback_t));
-    rt_free_func(c->callbacks);
+    context_owned_free(c, c->callbacks);
     c->callbacks = callbacks;
   }
 
@@ -100,30 +151,428 @@ rt_return_value_t rt_add_callback(
   return RT_RET_NOERROR;
 }
 
-rt_return_value_t rt_initialize_context(rt_context_pointer context,
-                                        nn_network_t *n) {
+rt_return_value_t rt_set_buffer_planning(rt_context_pointer context,
+                                         int enable) {
   rt_context_t *c = context;
-  int i, j; // Iterator
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->buffer_planning = enable;
+  return RT_RET_NOERROR;
+}
 
-  //////////////////////////////////////////////////////////////////////////////
-  // Binary format version check
-  if (n->version < NN_BINARY_FORMAT_MINIMUM_VERSION ||
-      n->version > NN_BINARY_FORMAT_VERSION) {
-    return RT_RET_ERROR_VERSION_UNMATCH;
+rt_return_value_t rt_set_graph_execution(rt_context_pointer context,
+                                         int enable) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
   }
+  c->graph_execution = enable;
+  return RT_RET_NOERROR;
+}
 
-  //////////////////////////////////////////////////////////////////////////////
-  // API level check
-  if (n->api_level > NN_API_LEVEL_MAX) {
-    n->api_level = 1;
-    printf("WARNING:\n"
-           "The NNabla version is too low to find a suitable api level. \n"
-           "Unexpected errors might occur.\n"
-           "Please upgrade NNabla to latest version.\n");
+rt_return_value_t rt_set_function_fusion(rt_context_pointer context,
+                                         int enable) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
   }
+  c->function_fusion = enable;
+  return RT_RET_NOERROR;
+}
 
-  if (n->api_level > NN_API_LEVEL) {
-    return RT_RET_ERROR_VERSION_UNMATCH;
+rt_return_value_t rt_set_graph_simplification(rt_context_pointer context,
+                                              int enable) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->graph_simplification = enable;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_parameter_loader(rt_context_pointer context,
+                                          const rt_parameter_loader_t *loader) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  if (loader && loader->load) {
+    c->loader = *loader;
+  } else {
+    memset(&c->loader, 0, sizeof(rt_parameter_loader_t));
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_plan_cache(rt_context_pointer context,
+                                    const void *plan, size_t size) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->plan_cache.enabled = 1;
+  c->plan_cache.given = plan;
+  c->plan_cache.given_size = plan ? size : 0;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_kernel_tuning(rt_context_pointer context, int enable) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->kernels.tuning = enable;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_kernel_choices(rt_context_pointer context,
+                                        const uint8_t *choices,
+                                        int num_of_functions) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->kernels.given = choices;
+  c->kernels.given_size = choices ? num_of_functions : 0;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_get_kernel_choices(rt_context_pointer context,
+                                        const uint8_t **choices,
+                                        int *num_of_functions) {
+  rt_context_t *c = context;
+  if (c->kernels.chosen == 0) {
+    return RT_RET_ERROR_NO_KERNEL_CHOICES;
+  }
+  *choices = c->kernels.chosen;
+  *num_of_functions = c->num_of_functions;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_get_plan_cache(rt_context_pointer context,
+                                    const void **plan, size_t *size,
+                                    int *reused) {
+  rt_context_t *c = context;
+  if (c->plan_cache.recorded == 0) {
+    return RT_RET_ERROR_NO_PLAN_CACHE;
+  }
+  *plan = c->plan_cache.recorded;
+  *size = c->plan_cache.recorded_size;
+  if (reused) {
+    *reused = c->plan_cache.reused;
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_weight_prepack_limit(rt_context_pointer context,
+                                              size_t limit) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->prepack_limit = limit;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_fast_math(rt_context_pointer context, int enable) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->fast_math = enable;
+  return RT_RET_NOERROR;
+}
+
+// Recurrent functions are not built without their configs.
+#if defined(CONFIG_RNN) || defined(CONFIG_LSTM) || defined(CONFIG_GRU)
+static int is_recurrent_function(const nn_function_t *info) {
+  return info->type == NN_FUNCTION_RNN || info->type == NN_FUNCTION_LSTM ||
+         info->type == NN_FUNCTION_GRU;
+}
+#endif
+
+static rt_return_value_t set_function_streaming(rt_context_t *c, int i) {
+#if defined(CONFIG_RNN) || defined(CONFIG_LSTM) || defined(CONFIG_GRU)
+  if (is_recurrent_function(c->functions[i].info) &&
+      !is_removed_function(c, i) &&
+      set_recurrent_streaming(&c->functions[i].func, c->recurrent_streaming) !=
+          RT_FUNCTION_ERROR_NOERROR &&
+      c->recurrent_streaming) {
+    return RT_RET_ERROR_NO_MATCHING_FUNCTION;
+  }
+#endif
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_recurrent_streaming(rt_context_pointer context,
+                                             int enable) {
+  rt_context_t *c = context;
+  int i; // Iterator
+
+  c->recurrent_streaming = enable;
+  if (c->network == 0) {
+    return RT_RET_NOERROR;
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    rt_return_value_t ret = set_function_streaming(c, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_reset_recurrent_state(rt_context_pointer context) {
+  rt_context_t *c = context;
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+#if defined(CONFIG_RNN) || defined(CONFIG_LSTM) || defined(CONFIG_GRU)
+  int i; // Iterator
+  for (i = 0; i < c->num_of_functions; i++) {
+    if (is_recurrent_function(c->functions[i].info) &&
+        !is_removed_function(c, i)) {
+      reset_recurrent_state(&c->functions[i].func);
+    }
+  }
+#endif
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_context_arena(rt_context_pointer context,
+                                       void *arena, size_t size) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->arena.enabled = 1;
+  c->arena.block = arena;
+  c->arena.block_size = arena ? size : 0;
+  rewind_context_arena(c);
+  return RT_RET_NOERROR;
+}
+
+static rt_return_value_t set_allocator(rt_context_t *c, rt_allocator_t *to,
+                                       const rt_allocator_t *allocator) {
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  if (c->block.enabled) {
+    // Memory of static context is in its block.
+    return RT_RET_ERROR_INVALID_ARGUMENT;
+  }
+  if (allocator == 0) {
+    memset(to, 0, sizeof(rt_allocator_t));
+  } else if (allocator->malloc_func == 0 || allocator->free_func == 0) {
+    return RT_RET_ERROR_INVALID_ARGUMENT;
+  } else {
+    *to = *allocator;
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_set_context_allocator(rt_context_pointer context,
+                                           const rt_allocator_t *allocator) {
+  rt_context_t *c = context;
+  return set_allocator(c, &c->allocator, allocator);
+}
+
+rt_return_value_t rt_set_variable_allocator(rt_context_pointer context,
+                                            const rt_allocator_t *allocator) {
+  rt_context_t *c = context;
+  return set_allocator(c, &c->variable_allocator, allocator);
+}
+
+rt_return_value_t rt_set_activation_arena(rt_context_pointer context,
+                                          void *arena, size_t size) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->buffer_planning = 1;
+  c->activations.enabled = 1;
+  c->activations.base = arena;
+  c->activations.size = arena ? size : 0;
+  return RT_RET_NOERROR;
+}
+
+size_t rt_activation_arena_size(rt_context_pointer context) {
+  rt_context_t *c = context;
+  if (c->activations.shared_size == 0) {
+    return 0;
+  }
+  // Given arena may be aligned by runtime.
+  return c->activations.shared_size + RT_BUFFER_ALIGNMENT - 1;
+}
+
+rt_return_value_t rt_set_huge_pages(rt_context_pointer context,
+                                    rt_huge_pages_t pages) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  if (pages < RT_HUGE_PAGES_NONE || pages >= END_OF_RT_HUGE_PAGES) {
+    return RT_RET_ERROR_INVALID_ARGUMENT;
+  }
+  c->huge_pages = pages;
+  return RT_RET_NOERROR;
+}
+
+size_t rt_context_arena_size(rt_context_pointer context) {
+  return ((rt_context_t *)context)->arena.total;
+}
+
+// Variables whose first dimension is batch size follow rt_reshape_input().
+static int is_batched_variable(nn_network_t *n, rt_context_t *c,
+                               nn_variable_t *var) {
+  return var->data_index < 0 && var->shape.size > 0 &&
+         ((int *)NN_GET(n, var->shape.list))[0] == c->network_batch_size;
+}
+
+// Runtime does not infer shapes, so a function reading batched variables
+// must write batched outputs and keep batch as their first axis.
+static int keeps_batch_axis(nn_network_t *n, rt_context_t *c,
+                            nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int *list = (int *)NN_GET(n, n->variables.list);
+  int batched = 0;
+  int j; // Iterator
+
+  for (j = 0; j < inputs.size; j++) {
+    if (inputs.data[j] >= 0 && inputs.data[j] < (int)n->variables.size &&
+        is_batched_variable(
+            n, c, (nn_variable_t *)NN_GET(n, list[inputs.data[j]]))) {
+      batched = 1;
+    }
+  }
+  if (!batched) {
+    return 1;
+  }
+  for (j = 0; j < outputs.size; j++) {
+    if (!is_batched_variable(
+            n, c, (nn_variable_t *)NN_GET(n, list[outputs.data[j]]))) {
+      return 0;
+    }
+  }
+  if (func->type == NN_FUNCTION_TRANSPOSE) {
+    rt_list_t axes = create_rt_list_from_nn_list(
+        n, ((nn_function_transpose_t *)func)->axes);
+    return axes.size > 0 && axes.data[0] == 0;
+  }
+  return 1;
+}
+
+// Buffer variable is written in forward, as network input or as output of a
+// function which is not removed.
+static int is_written_variable(nn_network_t *n, rt_context_t *c, int index) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  int i, j; // Iterators
+
+  for (i = 0; i < c->num_of_inputs; i++) {
+    if (c->input_variable_ids[i] == index) {
+      return 1;
+    }
+  }
+  for (i = 0; i < (int)n->functions.size; i++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
+    rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+    for (j = 0; j < outputs.size; j++) {
+      if (outputs.data[j] == index && !is_removed_function(c, i)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Weights of function, its inputs after the first, are written in forward,
+// e.g. by Transpose of a parameter, so that copies of them packed while
+// initialization would be stale.
+static int reads_written_weight(nn_network_t *n, rt_context_t *c,
+                                nn_function_t *func) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  int *list = (int *)NN_GET(n, n->variables.list);
+  int j; // Iterator
+
+  for (j = 1; j < inputs.size; j++) {
+    int index = inputs.data[j];
+    if (index >= 0 && index < c->num_of_variables &&
+        ((nn_variable_t *)NN_GET(n, list[index]))->data_index < 0 &&
+        is_written_variable(n, c, index)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Add time since start to phase of initialization, and start next phase.
+static void end_init_phase(rt_context_t *c, rt_init_phase_t phase,
+                           uint64_t *start) {
+  uint64_t now = profile_now();
+  c->init_profile.phase_nsec[phase] += now - *start;
+  *start = now;
+}
+
+// Planned area above pinned_size is taken from activation arena if context
+// has one, otherwise whole plan is in variable_arena.
+static rt_return_value_t allocate_planned_buffers(rt_context_t *c,
+                                                  size_t pinned_size) {
+  rt_activation_arena_t *a = &c->activations;
+  a->pinned_size = a->enabled ? pinned_size : c->variable_arena_size;
+  a->shared_size = c->variable_arena_size - a->pinned_size;
+  if (a->pinned_size > 0) {
+    c->variable_arena = planned_malloc(c->huge_pages, a->pinned_size,
+                                       &c->variable_arena_mapped);
+    if (c->variable_arena == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    memset(c->variable_arena, 0, a->pinned_size);
+  }
+  if (a->shared_size > 0) {
+    if (a->base) {
+      uint8_t *base = (uint8_t *)RT_ALIGN_SIZE((uintptr_t)a->base,
+                                               RT_BUFFER_ALIGNMENT);
+      if ((size_t)(base - a->base) + a->shared_size > a->size) {
+        return RT_RET_ERROR_ALLOCATE_CONTEXT;
+      }
+      a->shared = base;
+    } else {
+      a->owned =
+          planned_malloc(c->huge_pages, a->shared_size, &a->owned_mapped);
+      if (a->owned == 0) {
+        return RT_RET_ERROR_ALLOCATE_CONTEXT;
+      }
+      a->shared = a->owned;
+    }
+    memset(a->shared, 0, a->shared_size);
+  }
+  c->memory.activation_bytes =
+      a->pinned_size + (a->owned ? a->shared_size : 0);
+  return RT_RET_NOERROR;
+}
+
+static void *planned_data(rt_context_t *c, size_t offset) {
+  if (offset < c->activations.pinned_size || c->activations.shared == 0) {
+    return (uint8_t *)c->variable_arena + offset;
+  }
+  return c->activations.shared + (offset - c->activations.pinned_size);
+}
+
+static rt_return_value_t initialize_context(rt_context_t *c,
+                                            nn_network_t *n) {
+  uint64_t phase_start = profile_now();
+  int i, j; // Iterator
+  size_t allocated;
+
+  c->allocated = 0;
+  memset(&c->memory, 0, sizeof(rt_memory_stats_t));
+  // Phases before are measured by caller, and ones of measuring run are
+  // replaced.
+  for (i = RT_INIT_PHASE_VARIABLES; i < RT_INIT_PHASE_END; i++) {
+    c->init_profile.phase_nsec[i] = 0;
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -144,6 +593,9 @@ rt_return_value_t rt_initialize_context(rt_context_pointer context,
   rt_list_t inputs = create_rt_list_from_nn_list(n, n->inputs);
   c->num_of_inputs = inputs.size;
   c->input_variable_ids = rt_malloc_func(sizeof(int *) * c->num_of_inputs);
+  if (c->input_variable_ids == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
   for (i = 0; i < c->num_of_inputs; i++) {
     c->input_variable_ids[i] = inputs.data[i];
   }
@@ -153,30 +605,13 @@ rt_return_value_t rt_initialize_context(rt_context_pointer context,
   rt_list_t outputs = create_rt_list_from_nn_list(n, n->outputs);
   c->num_of_outputs = outputs.size;
   c->output_variable_ids = rt_malloc_func(sizeof(int *) * c->num_of_outputs);
+  if (c->output_variable_ids == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
   for (i = 0; i < c->num_of_outputs; i++) {
     c->output_variable_ids[i] = outputs.data[i];
   }
 
-  //////////////////////////////////////////////////////////////////////////////
-  // Allocate buffers
-  int *list = (int *)NN_GET(n, n->buffers.list);
-  for (i = 0; i < c->num_of_buffers; i++) {
-    if (c->buffers[i].allocate_type == RT_BUFFER_ALLOCATE_TYPE_INITIAL) {
-      c->buffers[i].allocate_type = RT_BUFFER_ALLOCATE_TYPE_MALLOC;
-      if (n->version == 2) {
-        c->buffers[i].buffer =
-            rt_variable_malloc_func(*(list + i) * sizeof(float));
-        memset(c->buffers[i].buffer, 0, *(list + i) * sizeof(float));
-      } else {
-        c->buffers[i].buffer = rt_variable_malloc_func(*(list + i));
-        memset(c->buffers[i].buffer, 0, *(list + i));
-      }
-      if (c->buffers[i].buffer == 0) {
-        return RT_RET_ERROR_ALLOCATE_CONTEXT;
-      }
-    }
-  }
-
   //////////////////////////////////////////////////////////////////////////////
   // Variables
   c->num_of_variables = n->variables.size;
@@ -185,12 +620,30 @@ rt_return_value_t rt_initialize_context(rt_context_pointer context,
     return RT_RET_ERROR_ALLOCATE_CONTEXT;
   }
 
-  list = (int *)NN_GET(n, n->variables.list);
+  int reshaped = c->batch_size > 0 && c->batch_size != c->network_batch_size;
+  int num_of_reshaped_dims = 0;
+  int *list = (int *)NN_GET(n, n->variables.list);
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+    if (reshaped && is_batched_variable(n, c, var)) {
+      num_of_reshaped_dims += var->shape.size;
+    }
+  }
+  int *reshaped_dims = 0;
+  if (num_of_reshaped_dims > 0) {
+    c->reshaped_dims = rt_malloc_func(sizeof(int) * num_of_reshaped_dims);
+    if (c->reshaped_dims == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    reshaped_dims = c->reshaped_dims;
+  }
+
   for (i = 0; i < c->num_of_variables; i++) {
     nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
     c->variables[i].shape = create_rt_list_from_nn_list(n, var->shape);
     c->variables[i].type = var->type;
     c->variables[i].fp_pos = var->fp_pos;
+    c->variables[i].layout = var->layout;
 
     if (var->type == NN_DATA_TYPE_INT8 || var->type == NN_DATA_TYPE_INT16) {
       c->variables[i].coefficient = (1.0f / (1 << var->fp_pos));
@@ -198,27 +651,265 @@ rt_return_value_t rt_initialize_context(rt_context_pointer context,
       c->variables[i].coefficient = 0;
     }
 
+    if (var->data_index < 0 && -1 * var->data_index > c->num_of_buffers) {
+      return RT_RET_ERROR_INVALID_BUFFER_INDEX;
+    }
+
+    if (reshaped && is_batched_variable(n, c, var)) {
+      // Shape in network is read only, use own copy.
+      for (j = 0; j < var->shape.size; j++) {
+        reshaped_dims[j] = c->variables[i].shape.data[j];
+      }
+      reshaped_dims[0] = c->batch_size;
+      c->variables[i].shape.data = reshaped_dims;
+      reshaped_dims += var->shape.size;
+    }
+  }
+  allocated = c->allocated;
+  rt_return_value_t compression_ret = prepare_compressed_variables(n, c);
+  if (compression_ret != RT_RET_NOERROR) {
+    return compression_ret;
+  }
+  c->memory.scratch_bytes += c->allocated - allocated;
+  rt_return_value_t quantization_ret = prepare_quantized_variables(n, c);
+  if (quantization_ret != RT_RET_NOERROR) {
+    return quantization_ret;
+  }
+
+  rt_return_value_t plan_ret = prepare_plan_cache(n, c);
+  if (plan_ret != RT_RET_NOERROR) {
+    return plan_ret;
+  }
+  end_init_phase(c, RT_INIT_PHASE_VARIABLES, &phase_start);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Graph simplification and function fusion
+  rt_return_value_t simplification_ret = build_graph_simplification(n, c);
+  if (simplification_ret != RT_RET_NOERROR) {
+    return simplification_ret;
+  }
+  rt_return_value_t fusion_ret = c->plan_cache.given
+                                     ? restore_cached_fusion(n, c)
+                                     : build_function_fusion(n, c);
+  if (fusion_ret != RT_RET_NOERROR) {
+    return fusion_ret;
+  }
+  end_init_phase(c, RT_INIT_PHASE_FUNCTION_FUSION, &phase_start);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Buffer sizes
+  size_t *buffer_sizes =
+      rt_malloc_func(sizeof(size_t) * (c->num_of_buffers + 1));
+  if (buffer_sizes == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  list = (int *)NN_GET(n, n->buffers.list);
+  for (i = 0; i < c->num_of_buffers; i++) {
+    buffer_sizes[i] = *(list + i);
+    if (n->version == 2) {
+      buffer_sizes[i] *= sizeof(float);
+    }
+  }
+  if (reshaped) {
+    // Buffers are as large as the largest variable with new batch size.
+    for (i = 0; i < c->num_of_buffers; i++) {
+      buffer_sizes[i] = 0;
+    }
+    list = (int *)NN_GET(n, n->variables.list);
+    for (i = 0; i < c->num_of_variables; i++) {
+      nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
+      if (var->data_index < 0) {
+        int index = (-1 * var->data_index) - 1;
+        size_t size = calc_variable_data_size(c->variables + i);
+        if (size > buffer_sizes[index]) {
+          buffer_sizes[index] = size;
+        }
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Plan buffers
+  size_t *variable_offsets = 0;
+  int keep_all = c->result_caching != RT_RESULT_CACHING_NONE &&
+                 !c->loader.load && !c->window_hop;
+  // Outputs of removed functions and no-ops get no area by planning.
+  if (c->buffer_planning || c->graph_simplification || keep_all) {
+    variable_offsets = rt_malloc_func(sizeof(size_t) * n->variables.size);
+    if (variable_offsets == 0) {
+      rt_free_func(buffer_sizes);
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    rt_return_value_t ret = RT_RET_NOERROR;
+    size_t pinned_size = 0;
+    if (!restore_cached_offsets(n, c, variable_offsets,
+                                &c->variable_arena_size, &pinned_size)) {
+      ret = plan_variable_buffers(n, c->fusions, c->removed_functions,
+                                  c->variables, buffer_sizes,
+                                  c->activations.enabled, keep_all,
+                                  variable_offsets, &c->variable_arena_size,
+                                  &pinned_size);
+    }
+    if (keep_all) {
+      // Kept variables must not be shared with other contexts.
+      pinned_size = c->variable_arena_size;
+    }
+    if (ret != RT_RET_NOERROR) {
+      rt_free_func(buffer_sizes);
+      rt_free_func(variable_offsets);
+      return ret;
+    }
+    end_init_phase(c, RT_INIT_PHASE_BUFFER_PLANNING, &phase_start);
+    ret = allocate_planned_buffers(c, pinned_size);
+    if (ret != RT_RET_NOERROR) {
+      rt_free_func(buffer_sizes);
+      rt_free_func(variable_offsets);
+      return ret;
+    }
+    for (i = 0; i < c->num_of_buffers; i++) {
+      c->buffers[i].allocate_type = RT_BUFFER_ALLOCATE_TYPE_PLANNED;
+      c->buffers[i].buffer = 0;
+    }
+    end_init_phase(c, RT_INIT_PHASE_BUFFER_ALLOCATION, &phase_start);
+  }
+
+  rt_return_value_t record_ret = record_plan(
+      n, c, variable_offsets, c->variable_arena_size,
+      c->activations.enabled ? c->activations.pinned_size : 0);
+  if (record_ret != RT_RET_NOERROR) {
+    rt_free_func(buffer_sizes);
+    if (variable_offsets) {
+      rt_free_func(variable_offsets);
+    }
+    return record_ret;
+  }
+  end_init_phase(c, RT_INIT_PHASE_BUFFER_PLANNING, &phase_start);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Allocate buffers
+  for (i = 0; i < c->num_of_buffers; i++) {
+    if (c->buffers[i].allocate_type == RT_BUFFER_ALLOCATE_TYPE_INITIAL) {
+      c->buffers[i].allocate_type = RT_BUFFER_ALLOCATE_TYPE_MALLOC;
+      c->buffers[i].buffer = variable_malloc(buffer_sizes[i]);
+      if (c->buffers[i].buffer == 0) {
+        rt_free_func(buffer_sizes);
+        if (variable_offsets) {
+          rt_free_func(variable_offsets);
+        }
+        return RT_RET_ERROR_ALLOCATE_CONTEXT;
+      }
+      memset(c->buffers[i].buffer, 0, buffer_sizes[i]);
+      c->memory.activation_bytes += buffer_sizes[i];
+    }
+  }
+  rt_free_func(buffer_sizes);
+  end_init_phase(c, RT_INIT_PHASE_BUFFER_ALLOCATION, &phase_start);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Variable data
+  list = (int *)NN_GET(n, n->variables.list);
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, *(list + i)));
     if (var->data_index < 0) {
       int index = (-1 * var->data_index) - 1;
-      if (index >= c->num_of_buffers) {
-        return RT_RET_ERROR_INVALID_BUFFER_INDEX;
+      if (c->buffers[index].allocate_type == RT_BUFFER_ALLOCATE_TYPE_PLANNED) {
+        c->variables[i].data = planned_data(c, variable_offsets[i]);
+      } else {
+        c->variables[i].data = c->buffers[index].buffer;
       }
-      c->variables[i].data = c->buffers[index].buffer;
-    } else {
+    } else if (var->layout != NN_DATA_LAYOUT_COMPRESSED) {
       c->variables[i].data = NN_GET(n, var->data_index);
     }
   }
+  if (variable_offsets) {
+    rt_free_func(variable_offsets);
+  }
+  allocated = c->allocated;
+  rt_return_value_t staging_ret = prepare_parameter_staging(n, c);
+  if (staging_ret != RT_RET_NOERROR) {
+    return staging_ret;
+  }
+  rt_return_value_t sparse_ret = prepare_sparse_variables(n, c);
+  if (sparse_ret != RT_RET_NOERROR) {
+    return sparse_ret;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Functions of parameters only, before weights are read by fusion
+  rt_return_value_t folding_ret = fold_constant_functions(n, c);
+  if (folding_ret != RT_RET_NOERROR) {
+    return folding_ret;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Fold parameters of fused functions
+  fusion_ret = prepare_function_fusion(n, c);
+  if (fusion_ret != RT_RET_NOERROR) {
+    return fusion_ret;
+  }
+  c->memory.scratch_bytes += c->allocated - allocated;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Bindings of inputs and outputs
+  c->input_bindings = rt_malloc_func(sizeof(rt_variable_buffer_context_t) *
+                                     c->num_of_inputs);
+  c->output_bindings = rt_malloc_func(sizeof(rt_variable_buffer_context_t) *
+                                      c->num_of_outputs);
+  if ((c->num_of_inputs > 0 && c->input_bindings == 0) ||
+      (c->num_of_outputs > 0 && c->output_bindings == 0)) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < c->num_of_inputs; i++) {
+    c->input_bindings[i].allocate_type = RT_BUFFER_ALLOCATE_TYPE_MALLOC;
+    c->input_bindings[i].buffer = c->variables[c->input_variable_ids[i]].data;
+  }
+  for (i = 0; i < c->num_of_outputs; i++) {
+    c->output_bindings[i].allocate_type = RT_BUFFER_ALLOCATE_TYPE_MALLOC;
+    c->output_bindings[i].buffer =
+        c->variables[c->output_variable_ids[i]].data;
+  }
+  end_init_phase(c, RT_INIT_PHASE_PARAMETERS, &phase_start);
 
   //////////////////////////////////////////////////////////////////////////////
   // Functions
   c->num_of_functions = n->functions.size;
   c->functions =
       rt_malloc_func(sizeof(rt_function_context_t) * c->num_of_functions);
+  if (c->functions == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  // Functions after one which failed are released as empty.
+  memset(c->functions, 0, sizeof(rt_function_context_t) * c->num_of_functions);
   list = (int *)NN_GET(n, n->functions.list);
+  rt_return_value_t kernel_ret = prepare_kernel_choices(c);
+  if (kernel_ret != RT_RET_NOERROR) {
+    return kernel_ret;
+  }
+  // Shared by all functions, each takes size of its packed weights.
+  size_t prepack_budget = c->prepack_limit;
   for (i = 0; i < c->num_of_functions; i++) {
     nn_function_t *func = (nn_function_t *)(NN_GET(n, *(list + i)));
     c->functions[i] = allocate_function_io(n, c, func);
+    if ((func->inputs.size > 0 && c->functions[i].func.inputs == 0) ||
+        (func->outputs.size > 0 && c->functions[i].func.outputs == 0)) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    if (is_removed_function(c, i)) {
+      // Nothing reads its outputs, or they are calculated already.
+      continue;
+    }
+    rt_return_value_t ret = connect_fused_function(n, c, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+    ret = stage_parameters(c, i, 0);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+    end_init_phase(c, RT_INIT_PHASE_FUNCTION_IO, &phase_start);
+    uint64_t function_start = phase_start;
 
+    allocated = c->allocated;
     int callback_registered_flag = 0;
     if (func->impl <= NN_END_OF_USER_DEFINED_FUNCTION_IMPLEMENT) {
       for (j = 0; j < c->num_of_callbacks; j++) {
@@ -234,53 +925,438 @@ rt_return_value_t rt_initialize_context(rt_context_pointer context,
       }
     }
     if (!callback_registered_flag) {
-      allocate_function_context(n, func, c->functions + i);
+      callback_registered_flag = allocate_backend_function(n, c, i);
+    }
+    if (!callback_registered_flag) {
+      size_t no_budget = 0;
+      size_t *previous = rt_set_prepack_budget(
+          reads_written_weight(n, c, func) ? &no_budget : &prepack_budget);
+      rt_math_mode_t previous_mode = rt_set_math_mode(
+          c->fast_math ? RT_MATH_MODE_FAST : RT_MATH_MODE_EXACT);
+      int previous_candidates = rt_set_kernel_candidates(has_kernel_choices(c));
+      rt_function_error_t error = RT_FUNCTION_ERROR_NOERROR;
+      if (!allocate_padded_function_context(n, c, i, &error)) {
+        error = allocate_function_context(n, c->functions[i].info,
+                                          c->functions + i);
+      }
+      rt_set_kernel_candidates(previous_candidates);
+      rt_set_math_mode(previous_mode);
+      rt_set_prepack_budget(previous);
+      if (error == RT_FUNCTION_ERROR_MALLOC) {
+        // Free function does not know how far private data is allocated.
+        c->functions[i].func.free_local_context_func = 0;
+        return RT_RET_ERROR_ALLOCATE_CONTEXT;
+      }
+    }
+    ret = set_fused_function_epilogue(n, c, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
     }
+    if (c->recurrent_streaming) {
+      ret = set_function_streaming(c, i);
+      if (ret != RT_RET_NOERROR) {
+        return ret;
+      }
+    }
+    end_init_phase(c, RT_INIT_PHASE_LOCAL_CONTEXT, &phase_start);
+    if (!callback_registered_flag) {
+      choose_function_kernel(c, i);
+    }
+    end_init_phase(c, RT_INIT_PHASE_KERNEL_TUNING, &phase_start);
+    c->functions[i].init_nsec = phase_start - function_start;
+    c->functions[i].private_size = c->allocated - allocated;
+    c->memory.private_bytes += c->functions[i].private_size;
+    rt_function_t *f = &c->functions[i].func;
+    if (is_alias_function(func) && f->num_of_inputs >= 1 &&
+        f->num_of_outputs == 1 && f->inputs[0] && f->outputs[0] &&
+        is_same_fixed_point(f->inputs[0], f->outputs[0]) &&
+        !(c->fusions && (c->fusions[i].ops || c->fusions[i].output >= 0))) {
+      c->functions[i].alias = 1;
+    }
+  }
+
+  record_kernel_choices(c);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Streaming window
+  rt_return_value_t window_ret = build_streaming_window(n, c);
+  if (window_ret != RT_RET_NOERROR) {
+    return window_ret;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Tiled execution
+  allocated = c->allocated;
+  rt_return_value_t tile_ret = build_tiled_execution(n, c);
+  if (tile_ret != RT_RET_NOERROR) {
+    return tile_ret;
+  }
+  // Copies of functions and their bands.
+  c->memory.private_bytes += c->allocated - allocated;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Profile
+  if (c->profiling) {
+    rt_return_value_t ret = allocate_profile(c);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Dependency graph
+  if (c->graph_execution && !c->staging) {
+    rt_return_value_t ret = build_function_graph(c, &c->graph);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Result caching
+  rt_return_value_t cache_ret = build_result_cache(c);
+  if (cache_ret != RT_RET_NOERROR) {
+    return cache_ret;
   }
 
+  c->parameter_alignment = measure_parameter_alignment(n, c);
   c->network = n;
+  end_init_phase(c, RT_INIT_PHASE_FINALIZATION, &phase_start);
 
   return RT_RET_NOERROR;
 }
 
-rt_return_value_t rt_free_context(rt_context_pointer *context) {
-  rt_context_t *c = *context;
-
+static void release_context(rt_context_t *c) {
   int i; // Iterator
 
+  // Narrow copies of functions refer variables.
+  free_streaming_window(c);
+  free_tiled_execution(c);
+
   // Buffers
-  for (i = 0; i < c->num_of_buffers; i++) {
+  for (i = 0; c->buffers && i < c->num_of_buffers; i++) {
     if (c->buffers[i].allocate_type == RT_BUFFER_ALLOCATE_TYPE_MALLOC) {
-      rt_variable_free_func(c->buffers[i].buffer);
+      variable_free(c->buffers[i].buffer);
     }
   }
   rt_free_func(c->buffers);
+  if (c->activations.owned) {
+    planned_free(c->activations.owned, c->activations.owned_mapped);
+    c->activations.owned = 0;
+  }
+  c->activations.shared = 0;
+  if (c->variable_arena) {
+    planned_free(c->variable_arena, c->variable_arena_mapped);
+    c->variable_arena = 0;
+  }
 
   // Variables
   rt_free_func(c->variables);
+  free_sparse_variables(c);
+  free_compressed_variables(c);
+  free_parameter_staging(c);
+  free_quantized_variables(c);
+  free_plan_cache(c);
+  free_kernel_choices(c);
+  if (c->reshaped_dims) {
+    rt_free_func(c->reshaped_dims);
+    c->reshaped_dims = 0;
+  }
 
   // Functions
-  for (i = 0; i < c->num_of_functions; i++) {
+  for (i = 0; c->functions && i < c->num_of_functions; i++) {
     rt_free_func(c->functions[i].func.inputs);
     rt_free_func(c->functions[i].func.outputs);
 
-    c->functions[i].func.free_local_context_func(&(c->functions[i].func));
+    if (c->functions[i].func.free_local_context_func) {
+      c->functions[i].func.free_local_context_func(&(c->functions[i].func));
+    }
     if (c->functions[i].func.local_context != 0) {
       rt_free_func(c->functions[i].func.local_context);
       c->functions[i].func.local_context = NULL;
     }
   }
+  free_weight_copies(c);
+  free_function_fusion(c);
+  free_graph_simplification(c);
   rt_free_func(c->functions);
+  free_result_cache(c);
+  if (c->graph) {
+    free_function_graph(c->graph);
+    c->graph = 0;
+  }
+  if (c->profile) {
+    rt_free_func(c->profile);
+    c->profile = 0;
+  }
 
   rt_free_func(c->input_variable_ids);
   rt_free_func(c->output_variable_ids);
+  rt_free_func(c->input_bindings);
+  rt_free_func(c->output_bindings);
+
+  // Context which failed to initialize may be released again.
+  c->buffers = 0;
+  c->variables = 0;
+  c->functions = 0;
+  c->input_variable_ids = 0;
+  c->output_variable_ids = 0;
+  c->input_bindings = 0;
+  c->output_bindings = 0;
+  c->network = 0;
+}
+
+rt_return_value_t rt_set_num_threads(rt_context_pointer context,
+                                     int num_of_threads) {
+  rt_context_t *c = context;
+  if (c->thread_pool) {
+    destroy_thread_pool(c->thread_pool);
+    c->thread_pool = 0;
+  }
+  c->num_of_threads = 1;
+  if (num_of_threads > 1) {
+    c->thread_pool =
+        create_thread_pool(num_of_threads, c->cpus, c->num_of_cpus);
+    if (c->thread_pool == 0) {
+      return RT_RET_ERROR_CREATE_THREAD_POOL;
+    }
+    c->num_of_threads = num_of_threads;
+    c->executor.parallel_for = thread_pool_parallel_for;
+    c->executor.pool = c->thread_pool;
+    c->executor.num_of_threads = num_of_threads;
+  }
+  if (c->counters) {
+    // Counters of each thread of new pool.
+    return rt_set_profile_counters(c, 1);
+  }
+  return RT_RET_NOERROR;
+}
+
+int rt_num_of_threads(rt_context_pointer context) {
+  rt_context_t *c = context;
+  return c->thread_pool ? c->num_of_threads : 1;
+}
+
+static rt_return_value_t initialize_network(rt_context_t *c,
+                                           nn_network_t *n) {
+  uint64_t start = profile_now();
+  uint64_t phase_start = start;
+  rt_return_value_t ret;
+  void *previous;
+
+  memset(&c->init_profile, 0, sizeof(rt_init_profile_t));
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Binary format version check
+  if (n->version < NN_BINARY_FORMAT_MINIMUM_VERSION ||
+      n->version > NN_BINARY_FORMAT_VERSION) {
+    return RT_RET_ERROR_VERSION_UNMATCH;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // API level check
+  int api_level = n->api_level;
+  if (api_level > NN_API_LEVEL_MAX) {
+    api_level = 1;
+    printf("WARNING:\n"
+           "The NNabla version is too low to find a suitable api level. \n"
+           "Unexpected errors might occur.\n"
+           "Please upgrade NNabla to latest version.\n");
+  }
+
+  if (api_level > NN_API_LEVEL) {
+    return RT_RET_ERROR_VERSION_UNMATCH;
+  }
+  end_init_phase(c, RT_INIT_PHASE_VERSION_CHECK, &phase_start);
+
+  // Copy is made before arena, by variable allocator.
+  previous = begin_context_allocation(c);
+  ret = replicate_network(c, &n);
+  end_context_allocation(previous);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+
+  // Arena grows by chunks while context is initialized once.
+  rewind_context_arena(c);
+  mark_static_block(c);
+  previous = begin_context_allocation(c);
+  ret = initialize_context(c, n);
+  end_context_allocation(previous);
+  // Given choices are not kept alive after initialization.
+  c->kernels.given = 0;
+  c->kernels.given_size = 0;
+  c->init_profile.total_nsec = profile_now() - start;
+  return ret;
+}
+
+rt_return_value_t rt_initialize_context(rt_context_pointer context,
+                                        nn_network_t *n) {
+  rt_context_t *c = context;
+  // Memory first touched on CPUs of context is placed on their node.
+  void *placement = begin_placement(c);
+  rt_return_value_t ret = initialize_network(c, n);
+  end_placement(placement);
+  return ret;
+}
+
+static void discard_context(rt_context_pointer *context) {
+  rt_context_t *c = *context;
+  if (c->callbacks) {
+    context_owned_free(c, c->callbacks);
+  }
+  free_placement(c);
+  free_backends(c);
+  if (c->source) {
+    c->source->num_of_clones--;
+  }
+  rt_free_func(c);
+  *context = 0;
+}
+
+rt_return_value_t rt_clone_context(rt_context_pointer source,
+                                   rt_context_pointer *context) {
+  rt_context_t *src = source;
+  rt_context_t *c;
+  rt_return_value_t ret;
+  int i; // Iterator
+
+  if (src->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+
+  ret = rt_allocate_context(context);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  c = *context;
+  // Parameters folded or reordered by source are shared by all its clones, so
+  // it is freed after them.
+  c->source = src->source ? src->source : src;
+  c->source->num_of_clones++;
+
+  for (i = 0; i < src->num_of_callbacks; i++) {
+    ret = rt_add_callback(c, src->callbacks[i].type,
+                          src->callbacks[i].allocate_local_context);
+    if (ret != RT_RET_NOERROR) {
+      discard_context(context);
+      return ret;
+    }
+  }
+  for (i = 0; i < src->num_of_backends; i++) {
+    ret = rt_add_backend(c, src->backends + i);
+    if (ret != RT_RET_NOERROR) {
+      discard_context(context);
+      return ret;
+    }
+  }
+
+  c->buffer_planning = src->buffer_planning;
+  c->huge_pages = src->huge_pages;
+  // Clone may run at the same time as source, so its arena is its own.
+  c->activations.enabled = src->activations.enabled;
+  c->graph_execution = src->graph_execution;
+  c->graph_simplification = src->graph_simplification;
+  c->function_fusion = src->function_fusion;
+  c->prepack_limit = src->prepack_limit;
+  c->fast_math = src->fast_math;
+  c->recurrent_streaming = src->recurrent_streaming;
+  c->window_hop = src->window_hop;
+  c->tile_cache_size = src->tile_cache_size;
+  c->result_caching = src->result_caching;
+  c->kernels.tuning = src->kernels.tuning;
+  if (src->kernels.chosen) {
+    // Same kernels are used without timing again.
+    c->kernels.given = src->kernels.chosen;
+    c->kernels.given_size = src->num_of_functions;
+  }
+  if (!src->block.enabled) {
+    // Clone of static context is allocated in normal way.
+    c->allocator = src->allocator;
+    c->variable_allocator = src->variable_allocator;
+  }
+  if (src->cpus || src->replicate_network) {
+    rt_placement_t placement = {src->cpus, src->num_of_cpus,
+                                src->replicate_network};
+    ret = rt_set_placement(c, &placement);
+    if (ret != RT_RET_NOERROR) {
+      discard_context(context);
+      return ret;
+    }
+  }
+  c->loader = src->loader;
+  c->batch_size = src->batch_size;
+  c->network_batch_size = src->network_batch_size;
+  c->profiling = src->profiling;
+  c->pre_hook = src->pre_hook;
+  c->post_hook = src->post_hook;
+  c->hook_user_data = src->hook_user_data;
+  if (src->thread_pool) {
+    ret = rt_set_num_threads(c, src->num_of_threads);
+    if (ret != RT_RET_NOERROR) {
+      discard_context(context);
+      return ret;
+    }
+  }
+  if (src->counters) {
+    ret = rt_set_profile_counters(c, 1);
+    if (ret != RT_RET_NOERROR) {
+      discard_context(context);
+      return ret;
+    }
+  }
+  if (src->arena.enabled) {
+    c->arena.enabled = 1;
+    if (src->arena.total > 0) {
+      // Clone takes as much as source, in one chunk.
+      ret = reserve_context_arena(c, src->arena.total);
+      if (ret != RT_RET_NOERROR) {
+        discard_context(context);
+        return ret;
+      }
+    }
+  }
+
+  return rt_initialize_context(c, src->given_network ? src->given_network
+                                                    : src->network);
+}
+
+rt_return_value_t rt_free_context(rt_context_pointer *context) {
+  rt_context_t *c = *context;
+  rt_context_t *source = c->source;
+
+  // Running forward is finished first.
+  rt_destroy_request_queue(&c->async);
+  if (c->num_of_clones > 0) {
+    // Freed with its last clone.
+    c->freed = 1;
+    return RT_RET_NOERROR;
+  }
+
+  void *previous = begin_context_allocation(c);
+  release_context(c);
+  free_network_replica(c);
+  end_context_allocation(previous);
+  free_context_arena(c);
+  free_placement(c);
+
+  if (c->thread_pool) {
+    destroy_thread_pool(c->thread_pool);
+  }
+  rt_set_profile_counters(c, 0);
 
   // Callback
   if (c->callbacks) {
-    rt_free_func(c->callbacks);
+    context_owned_free(c, c->callbacks);
   }
+  free_backends(c);
 
-  rt_free_func(*context);
+  if (!c->block.enabled || c->block.base == 0) {
+    rt_free_func(*context);
+  }
+  if (source && --source->num_of_clones == 0 && source->freed) {
+    return rt_free_context((rt_context_pointer *)&source);
+  }
   return RT_RET_NOERROR;
 }
 
@@ -313,11 +1389,95 @@ int rt_input_shape(rt_context_pointer context, size_t index,
   return c->variables[c->input_variable_ids[index]].shape.data[shape_index];
 }
 
+static rt_return_value_t reinitialize_context(rt_context_t *c) {
+  nn_network_t *n = c->network;
+  void *previous = begin_context_allocation(c);
+  release_context(c);
+  rewind_static_block(c);
+  rewind_context_arena(c);
+  rt_return_value_t ret = initialize_context(c, n);
+  end_context_allocation(previous);
+  return ret;
+}
+
+rt_return_value_t rt_reshape_input(rt_context_pointer context, size_t index,
+                                   const int *shape) {
+  rt_context_t *c = context;
+  int i; // Iterator
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (index >= (size_t)c->num_of_inputs) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+
+  // Runtime does not infer shapes, so variables are resized by batch size.
+  nn_network_t *n = c->network;
+  int *list = (int *)NN_GET(n, n->variables.list);
+  nn_variable_t *var =
+      (nn_variable_t *)(NN_GET(n, list[c->input_variable_ids[index]]));
+  int *dims = (int *)NN_GET(n, var->shape.list);
+  if (var->shape.size < 1 || shape[0] < 1) {
+    return RT_RET_ERROR_INVALID_SHAPE;
+  }
+  for (i = 1; i < var->shape.size; i++) {
+    if (shape[i] != dims[i]) {
+      return RT_RET_ERROR_INVALID_SHAPE;
+    }
+  }
+  if (shape[0] == c->variables[c->input_variable_ids[index]].shape.data[0]) {
+    return RT_RET_NOERROR;
+  }
+  if (c->num_of_clones > 0) {
+    // Clones use parameters folded and reordered by it.
+    return RT_RET_ERROR_CONTEXT_HAS_CLONES;
+  }
+
+  c->network_batch_size = dims[0];
+  list = (int *)NN_GET(n, n->functions.list);
+  for (i = 0; i < (int)n->functions.size; i++) {
+    if (!keeps_batch_axis(n, c, (nn_function_t *)NN_GET(n, list[i]))) {
+      return RT_RET_ERROR_INVALID_SHAPE;
+    }
+  }
+  c->batch_size = shape[0];
+  // Whole context is initialized again for the new sizes.
+  return reinitialize_context(c);
+}
+
 void *rt_input_buffer(rt_context_pointer context, size_t index) {
   rt_context_t *c = context;
   return c->variables[c->input_variable_ids[index]].data;
 }
 
+// Binding keeps data allocated by runtime to restore it by unbinding.
+static rt_return_value_t bind_buffer(rt_context_t *c,
+                                     rt_variable_buffer_context_t *binding,
+                                     int id, void *buffer) {
+  if (buffer) {
+    binding->allocate_type = RT_BUFFER_ALLOCATE_TYPE_ALLOCATED;
+    c->variables[id].data = buffer;
+  } else if (binding->allocate_type == RT_BUFFER_ALLOCATE_TYPE_ALLOCATED) {
+    c->variables[id].data = binding->buffer;
+    binding->allocate_type = RT_BUFFER_ALLOCATE_TYPE_MALLOC;
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_bind_input_buffer(rt_context_pointer context,
+                                       size_t index, void *buffer) {
+  rt_context_t *c = context;
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (index >= (size_t)c->num_of_inputs) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  return bind_buffer(c, c->input_bindings + index,
+                     c->input_variable_ids[index], buffer);
+}
+
 int rt_num_of_output(rt_context_pointer context) {
   return ((rt_context_t *)context)->num_of_outputs;
 }
@@ -352,6 +1512,19 @@ void *rt_output_buffer(rt_context_pointer context, size_t index) {
   return c->variables[c->output_variable_ids[index]].data;
 }
 
+rt_return_value_t rt_bind_output_buffer(rt_context_pointer context,
+                                        size_t index, void *buffer) {
+  rt_context_t *c = context;
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (index >= (size_t)c->num_of_outputs) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  return bind_buffer(c, c->output_bindings + index,
+                     c->output_variable_ids[index], buffer);
+}
+
 nn_variable_t *rt_input_variable(rt_context_pointer context, size_t index) {
   rt_context_t *c = context;
   const nn_network_t *n = c->network;
@@ -368,30 +1541,383 @@ nn_variable_t *rt_output_variable(rt_context_pointer context, size_t index) {
   return (nn_variable_t *)(NN_GET(n, *(list + i)));
 }
 
-rt_return_value_t rt_forward(rt_context_pointer context) {
-  int i; // Iterator
+void *rt_variable_buffer(rt_context_pointer context, int index) {
+  rt_context_t *c = context;
+  if (index < 0 || index >= c->num_of_variables) {
+    return 0;
+  }
+  return c->variables[index].data;
+}
+
+size_t rt_parameter_alignment(rt_context_pointer context) {
+  rt_context_t *c = context;
+  return c->parameter_alignment;
+}
+
+rt_return_value_t rt_get_memory_stats(rt_context_pointer context,
+                                      rt_memory_stats_t *stats) {
+  rt_context_t *c = context;
+  rt_memory_stats_t *m = &c->memory;
+  rt_return_value_t ret;
+  size_t peak_activation;
+  void *previous;
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  previous = begin_context_allocation(0);
+  ret = measure_peak_activation(c->network, c, &peak_activation);
+  end_context_allocation(previous);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  *stats = *m;
+  stats->parameter_bytes = measure_parameter_bytes(c->network);
+  stats->peak_activation_bytes = peak_activation;
+  stats->context_bytes = sizeof(rt_context_t) + c->allocated -
+                         m->activation_bytes - m->private_bytes -
+                         m->scratch_bytes;
+  stats->peak_bytes = m->activation_bytes + m->private_bytes +
+                      m->scratch_bytes + stats->context_bytes;
+  return RT_RET_NOERROR;
+}
+
+size_t rt_function_private_size(rt_context_pointer context, int index) {
+  rt_context_t *c = context;
+  if (index < 0 || index >= c->num_of_functions) {
+    return 0;
+  }
+  return c->functions[index].private_size;
+}
+
+rt_return_value_t rt_get_init_profile(rt_context_pointer context,
+                                      rt_init_profile_t *profile) {
+  rt_context_t *c = context;
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  *profile = c->init_profile;
+  return RT_RET_NOERROR;
+}
+
+uint64_t rt_function_init_nsec(rt_context_pointer context, int index) {
+  rt_context_t *c = context;
+  if (index < 0 || index >= c->num_of_functions) {
+    return 0;
+  }
+  return c->functions[index].init_nsec;
+}
+
+// Deadline is latched, so later checks do not read clock.
+static int is_forward_canceled(void *context) {
+  rt_context_t *c = context;
+  if (!c->canceled && c->deadline && profile_now() >= c->deadline) {
+    c->canceled = 1;
+  }
+  return c->canceled;
+}
+
+static rt_return_value_t forward_function(rt_context_t *c, int i) {
   rt_function_error_t ret;
+  uint64_t start = 0;
+  uint64_t counters[RT_PROFILE_COUNTER_END];
+
+  if (is_forward_canceled(c)) {
+    return RT_RET_ERROR_FORWARD_ABORTED;
+  }
+  if (c->fusions && c->fusions[i].skip) {
+    // Already calculated by former function.
+    return RT_RET_NOERROR;
+  }
+  if (is_removed_function(c, i)) {
+    // Nothing reads its outputs, or they are parameters now.
+    return RT_RET_NOERROR;
+  }
+  if (c->cache && !c->cache->dirty[i]) {
+    // Output of former run is kept.
+    return RT_RET_NOERROR;
+  }
+  if (c->functions[i].alias &&
+      c->functions[i].func.inputs[0]->data ==
+          c->functions[i].func.outputs[0]->data) {
+    // Output shares data with input by buffer planning. Bound buffers of
+    // inputs or outputs of network make them differ, and then it is copied.
+    return RT_RET_NOERROR;
+  }
+  if (c->staging) {
+    rt_return_value_t staged = stage_parameters(c, i, 1);
+    if (staged != RT_RET_NOERROR) {
+      return staged;
+    }
+  }
+  if (c->pre_hook) {
+    c->pre_hook(c->hook_user_data, i, c->functions[i].info);
+  }
+  if (c->profile && c->counters) {
+    read_profile_counters(c->counters, counters);
+  }
+  if (c->profile || c->trace.current) {
+    start = profile_now();
+  }
+  // Set for each function, since threads of graph execution run them too.
+  const rt_cancellation_t *previous_cancellation =
+      rt_set_cancellation(&c->cancellation);
+  if (c->fusions && c->fusions[i].ops) {
+    ret = exec_function_chain(c, i);
+  } else if (c->window && c->window->index[i] >= 0) {
+    ret = exec_window_function(c, i);
+  } else if (c->tiles && c->tiles->index[i] >= 0) {
+    ret = exec_tiled_group(c, i);
+  } else {
+    ret = c->functions[i].func.exec_func(&(c->functions[i].func));
+    if (ret == RT_FUNCTION_ERROR_NOERROR && c->fusions &&
+        c->fusions[i].pooled >= 0) {
+      exec_function_pooling(c, i);
+    }
+  }
+  rt_set_cancellation(previous_cancellation);
+  if (c->profile || c->trace.current) {
+    uint64_t end = profile_now();
+    if (c->profile) {
+      record_profile(c->profile + i, end - start);
+    }
+    if (c->profile && c->counters) {
+      uint64_t now[RT_PROFILE_COUNTER_END];
+      read_profile_counters(c->counters, now);
+      record_profile_counters(c->profile + i, counters, now);
+    }
+    if (c->trace.current) {
+      rt_trace_event_t *event = c->trace.current + i;
+      event->function = i;
+      event->thread = current_thread_index();
+      event->start_nsec = start;
+      event->end_nsec = end;
+    }
+  }
+  if (c->post_hook) {
+    c->post_hook(c->hook_user_data, i, c->functions[i].info);
+  }
+  if (c->canceled) {
+    // Loops of function may be skipped.
+    return RT_RET_ERROR_FORWARD_ABORTED;
+  }
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    switch (ret) {
+    case RT_FUNCTION_ERROR_UNIMPLEMENTED:
+      printf("Error: %d, Function (ID: %d) is not implemented in "
+             "nnabla-c-runtime!\n",
+             ret, c->functions[i].info->type);
+      return -1;
+    default:
+      printf("Failed to run exec_func, Error: %d.\n", ret);
+      return -1;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+static rt_return_value_t forward_node(void *context, int node) {
+  return forward_function((rt_context_t *)context, node);
+}
+
+// Take events of this call from trace, if they are left.
+static void begin_trace(rt_context_t *c) {
+  function_trace_t *t = &c->trace;
+  int i; // Iterator
+
+  t->current = 0;
+  if (t->events == 0 || t->capacity - t->num_of_events < c->num_of_functions) {
+    return;
+  }
+  t->current = t->events + t->num_of_events;
+  t->num_of_events += c->num_of_functions;
+  for (i = 0; i < c->num_of_functions; i++) {
+    t->current[i].function = -1;
+  }
+}
+
+// Cancel called before forward is kept, so that it aborts this one.
+static void begin_cancellation(rt_context_t *c) {
+  c->cancellation.is_canceled = is_forward_canceled;
+  c->cancellation.arg = c;
+}
+
+// Cancel called after last check of forward is dropped with it.
+static void end_cancellation(rt_context_t *c) { c->canceled = 0; }
+
+static rt_return_value_t forward_functions(rt_context_t *c, int first,
+                                           int last) {
+  int i; // Iterator
+  rt_return_value_t ret;
+
+  for (i = first; i < last; i++) {
+    ret = forward_function(c, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_forward(rt_context_pointer context) {
+  rt_context_t *c = context;
+  const rt_parallel_executor_t *previous;
+  rt_return_value_t ret;
+
+  begin_trace(c);
+  begin_cancellation(c);
+  if (c->cache) {
+    begin_result_cache(c);
+  }
+  if (c->graph && c->thread_pool) {
+    // Threads of the pool run functions, so each function runs serially.
+    previous = rt_set_parallel_executor(0);
+    ret = thread_pool_run_graph(c->thread_pool, c->graph, forward_node, c);
+  } else {
+    previous = rt_set_parallel_executor(c->thread_pool ? &c->executor : 0);
+    ret = forward_functions(c, 0, c->num_of_functions);
+  }
+  rt_set_parallel_executor(previous);
+  end_cancellation(c);
+  if (c->cache) {
+    end_result_cache(c, ret == RT_RET_NOERROR);
+  }
+  return ret;
+}
+
+rt_return_value_t rt_set_forward_deadline(rt_context_pointer context,
+                                          uint64_t deadline_nsec) {
+  ((rt_context_t *)context)->deadline = deadline_nsec;
+  return RT_RET_NOERROR;
+}
+
+void rt_cancel_forward(rt_context_pointer context) {
+  ((rt_context_t *)context)->canceled = 1;
+}
+
+int rt_num_of_functions(rt_context_pointer context) {
+  return ((rt_context_t *)context)->num_of_functions;
+}
+
+rt_return_value_t rt_forward_range(rt_context_pointer context, int first,
+                                   int last) {
+  rt_context_t *c = context;
+  const rt_parallel_executor_t *previous;
+  rt_return_value_t ret;
+
+  if (first < 0 || first > last || last > c->num_of_functions) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
+  begin_trace(c);
+  begin_cancellation(c);
+  if (c->cache) {
+    invalidate_result_cache(c);
+  }
+  previous = rt_set_parallel_executor(c->thread_pool ? &c->executor : 0);
+  ret = forward_functions(c, first, last);
+  rt_set_parallel_executor(previous);
+  end_cancellation(c);
+  return ret;
+}
+
+rt_return_value_t rt_forward_until(rt_context_pointer context, int variable) {
   rt_context_t *c = context;
+  int i, j; // Iterator
+  int last = 0;
 
+  if (variable < 0 || variable >= c->num_of_variables) {
+    return RT_RET_ERROR_INVALID_INDEX;
+  }
   for (i = 0; i < c->num_of_functions; i++) {
-    ret = c->functions[i].func.exec_func(&(c->functions[i].func));
-    if (ret != RT_FUNCTION_ERROR_NOERROR) {
-      switch (ret) {
-      case RT_FUNCTION_ERROR_UNIMPLEMENTED:
-        printf("Error: %d, Function (ID: %d) is not implemented in "
-               "nnabla-c-runtime!\n",
-               ret, c->functions[i].info->type);
-        return -1;
-      default:
-        printf("Failed to run exec_func, Error: %d.\n", ret);
-        return -1;
+    rt_function_t *f = &c->functions[i].func;
+    for (j = 0; j < f->num_of_outputs; j++) {
+      if (f->outputs[j] == c->variables + variable) {
+        last = i + 1;
       }
     }
   }
+  return rt_forward_range(c, 0, last);
+}
+
+rt_return_value_t rt_set_profiling(rt_context_pointer context, int enable) {
+  rt_context_t *c = context;
+  rt_return_value_t ret = RT_RET_NOERROR;
+  void *previous;
+
+  c->profiling = enable;
+  if (c->network == 0) {
+    return RT_RET_NOERROR;
+  }
+  previous = begin_context_allocation(c);
+  if (enable) {
+    ret = allocate_profile(c);
+  } else if (c->profile) {
+    rt_free_func(c->profile);
+    c->profile = 0;
+  }
+  end_context_allocation(previous);
+  return ret;
+}
+
+const rt_function_profile_t *rt_get_profile(rt_context_pointer context,
+                                            int *num_of_functions) {
+  rt_context_t *c = context;
+  if (c->profile == 0) {
+    *num_of_functions = 0;
+    return 0;
+  }
+  *num_of_functions = c->num_of_functions;
+  return c->profile;
+}
+
+void rt_reset_profile(rt_context_pointer context) {
+  rt_context_t *c = context;
+  if (c->profile) {
+    allocate_profile(c);
+  }
+}
+
+rt_return_value_t rt_set_profile_counters(rt_context_pointer context,
+                                          int enable) {
+  rt_context_t *c = context;
+  rt_return_value_t ret = RT_RET_NOERROR;
+  // Counters are not taken from context arena, they follow thread pool.
+  void *previous = begin_context_allocation(0);
+  if (enable) {
+    ret = prepare_profile_counters(c);
+  } else {
+    free_profile_counters(c);
+  }
+  end_context_allocation(previous);
+  return ret;
+}
 
+rt_return_value_t rt_set_trace(rt_context_pointer context,
+                               rt_trace_event_t *events, int capacity) {
+  rt_context_t *c = context;
+  if (capacity < 0 || (events == 0 && capacity > 0)) {
+    return RT_RET_ERROR_INVALID_ARGUMENT;
+  }
+  c->trace.events = events;
+  c->trace.capacity = events ? capacity : 0;
+  c->trace.num_of_events = 0;
+  c->trace.current = 0;
   return RT_RET_NOERROR;
 }
 
+int rt_num_of_trace_events(rt_context_pointer context) {
+  return ((rt_context_t *)context)->trace.num_of_events;
+}
+
+void rt_set_function_hook(rt_context_pointer context, rt_function_hook_t pre,
+                          rt_function_hook_t post, void *user_data) {
+  rt_context_t *c = context;
+  c->pre_hook = pre;
+  c->post_hook = post;
+  c->hook_user_data = user_data;
+}
+
 const char *const rt_c_runtime_version(void) { return NN_C_RUNTIME_VERSION; }
 
 const int rt_nnb_version(void) { return NN_BINARY_FORMAT_VERSION; }
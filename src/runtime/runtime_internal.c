@@ -24,12 +24,87 @@ rt_list_t create_rt_list_from_nn_list(nn_network_t *n, nn_list_t list) {
   return l;
 }
 
+size_t calc_variable_data_size(const rt_variable_t *v) {
+  size_t size = 1;
+  int i; // Iterator
+  for (i = 0; i < v->shape.size; i++) {
+    size *= v->shape.data[i];
+  }
+  if (v->type == NN_DATA_TYPE_SIGN) {
+    return (size + 7) >> 3;
+  }
+  return size * calc_element_size(v->type);
+}
+
+size_t calc_element_size(nn_data_type_t type) {
+  switch (type) {
+  case NN_DATA_TYPE_FLOAT:
+    return sizeof(float);
+  case NN_DATA_TYPE_INT16:
+  case NN_DATA_TYPE_FLOAT16:
+  case NN_DATA_TYPE_BFLOAT16:
+    return sizeof(int16_t);
+  case NN_DATA_TYPE_SIGN:
+    return 0;
+  default:
+    return 1;
+  }
+}
+
+void *variable_malloc(size_t size) {
+  return variable_malloc_aligned(size, RT_VARIABLE_ALIGNMENT);
+}
+
+void *variable_malloc_aligned(size_t size, size_t alignment) {
+  count_context_allocation(size);
+  // Pointer given by allocator is kept just before aligned buffer.
+  uint8_t *raw =
+      variable_backend_malloc(size + sizeof(void *) + alignment - 1);
+  uintptr_t buffer;
+  if (raw == 0) {
+    return 0;
+  }
+  buffer = ((uintptr_t)raw + sizeof(void *) + alignment - 1) &
+           ~(uintptr_t)(alignment - 1);
+  ((void **)buffer)[-1] = raw;
+  return (void *)buffer;
+}
+
+void variable_free(void *buffer) {
+  if (buffer) {
+    variable_backend_free(((void **)buffer)[-1]);
+  }
+}
+
+size_t measure_parameter_alignment(nn_network_t *n, rt_context_t *c) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  uintptr_t alignment = RT_MAX_PARAMETER_ALIGNMENT;
+  int i; // Iterator
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, list[i]));
+    uintptr_t address = (uintptr_t)c->variables[i].data;
+    if (var->data_index < 0) {
+      continue;
+    }
+    while (address & (alignment - 1)) {
+      alignment >>= 1;
+    }
+  }
+  return (size_t)alignment;
+}
+
 rt_function_context_t allocate_function_io(nn_network_t *n, rt_context_t *c,
                                            nn_function_t *function) {
   int i; // Iterator
 
   rt_function_context_t func;
   func.info = function;
+  func.alias = 0;
+  func.private_size = 0;
+  func.backend = -1;
+  func.init_nsec = 0;
+  func.func.local_context = 0;
+  func.func.free_local_context_func = 0;
 
   rt_list_t inputs = create_rt_list_from_nn_list(n, function->inputs);
   func.func.num_of_inputs = inputs.size;
@@ -51,12 +51,407 @@
   (NN_NETWORK_DATA_POINTER(xNetwork) +                                         \
    NN_NETWORK_INDEX_POINTER(xNetwork)[xIndex])
 
+/// @brief Thread local storage specifier.
+#if defined(_MSC_VER)
+#define RT_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define RT_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define RT_THREAD_LOCAL _Thread_local
+#else
+// Allocations of contexts initialized on different threads would be mixed.
+#error "Thread local storage is not supported by this compiler."
+#endif
+
+/// @brief Alignment in byte of allocations from context arena.
+#define RT_ARENA_ALIGNMENT (16)
+
+/// @brief Size in byte of cache line which variables in planned arena start
+/// at, so that no load of their first vectors is split between lines.
+#define RT_CACHE_LINE_SIZE (64)
+
+/// @brief Alignment in byte of variables placed in planned arena. Variables
+/// placed inside others, e.g. inputs of Concatenate, need only
+/// RT_VARIABLE_ALIGNMENT.
+#define RT_BUFFER_ALIGNMENT                                                    \
+  (RT_VARIABLE_ALIGNMENT > RT_CACHE_LINE_SIZE ? RT_VARIABLE_ALIGNMENT          \
+                                              : RT_CACHE_LINE_SIZE)
+
+/// @brief Largest alignment in byte reported for parameters in network.
+#define RT_MAX_PARAMETER_ALIGNMENT (64)
+
+/// @brief Round up xSize to multiple of xAlign.
+#define RT_ALIGN_SIZE(xSize, xAlign)                                           \
+  ((((xSize) + (xAlign)-1) / (xAlign)) * (xAlign))
+
 rt_list_t create_rt_list_from_nn_list(nn_network_t *n, nn_list_t list);
 
+/// @brief Size of variable data in byte.
+size_t calc_variable_data_size(const rt_variable_t *v);
+
+/// @brief Size of an element in byte, 0 for SIGN whose elements are bits.
+size_t calc_element_size(nn_data_type_t type);
+
+/// @brief Allocate variable data from @ref variable_backend_malloc(),
+/// aligned to RT_VARIABLE_ALIGNMENT whatever alignment the allocator gives.
+/// It must be freed by @ref variable_free() routed to same context.
+void *variable_malloc(size_t size);
+void variable_free(void *buffer);
+
+/// @brief @ref variable_malloc() aligned to alignment, a power of two which
+/// is at least RT_VARIABLE_ALIGNMENT.
+void *variable_malloc_aligned(size_t size, size_t alignment);
+
+/// @brief Allocate planned memory of size bytes aligned to
+/// RT_BUFFER_ALIGNMENT, with pages of rt_set_huge_pages(). mapped is size of
+/// mapping, or 0 if memory is from @ref variable_malloc_aligned().
+void *planned_malloc(rt_huge_pages_t pages, size_t size, size_t *mapped);
+void planned_free(void *buffer, size_t mapped);
+
+/// @brief Largest power of two up to RT_MAX_PARAMETER_ALIGNMENT which divides
+/// addresses of all parameters read by functions, in network or in memory of
+/// context. Parameters which are not staged yet are aligned by staging.
+size_t measure_parameter_alignment(nn_network_t *n, rt_context_t *c);
+
+/// @brief Bytes of network data read by parameters.
+size_t measure_parameter_bytes(nn_network_t *n);
+
+/// @brief Largest memory of buffer backed variables read or written while a
+/// function runs, with inputs and outputs of network alive throughout.
+/// Variables sharing memory are counted once.
+rt_return_value_t measure_peak_activation(nn_network_t *n, rt_context_t *c,
+                                          size_t *peak);
+
 rt_function_context_t allocate_function_io(nn_network_t *n, rt_context_t *c,
                                            nn_function_t *function);
 
-void allocate_function_context(nn_network_t *n, nn_function_t *function,
-                               rt_function_context_t *function_context);
+/// @brief Allocate local context of function by its type.
+/// @return Error of allocate function, RT_FUNCTION_ERROR_MALLOC if local
+/// context cannot be allocated.
+rt_function_error_t allocate_function_context(
+    nn_network_t *n, nn_function_t *function,
+    rt_function_context_t *function_context);
+
+/// @brief Plan placement of buffer backed variables into one arena.
+/// Variables whose lifetime do not overlap share same area.
+/// @param[in] n Network
+/// @param[in] fusions Fusion of each function, or NULL.
+/// @param[in] removed RT_FUNCTION_DEAD or RT_FUNCTION_FOLDED for each
+/// function removed by graph simplification, or NULL.
+/// @param[in] variables Variables with their shape and type.
+/// @param[in] buffer_sizes Size of each buffer in byte.
+/// @param[in] pin_io Place network inputs and outputs below others.
+/// @param[in] keep_all Give every variable its own area, which keeps data
+/// from former rt_forward().
+/// @param[out] offsets Offset in arena for each variable.
+/// @param[out] arena_size Total size of arena in byte.
+/// @param[out] pinned_size Size of arena below which network inputs and
+/// outputs are placed, 0 unless pin_io.
+/// @return @ref rt_return_value_t
+rt_return_value_t plan_variable_buffers(nn_network_t *n,
+                                        const function_fusion_t *fusions,
+                                        const uint8_t *removed,
+                                        const rt_variable_t *variables,
+                                        const size_t *buffer_sizes,
+                                        int pin_io, int keep_all,
+                                        size_t *offsets, size_t *arena_size,
+                                        size_t *pinned_size);
+
+/// @brief Check block sparse variables, and expand those which are read by
+/// functions other than Affine and Convolution.
+rt_return_value_t prepare_sparse_variables(nn_network_t *n, rt_context_t *c);
+void free_sparse_variables(rt_context_t *c);
+
+/// @brief Decompress NN_DATA_LAYOUT_COMPRESSED parameters into dense values
+/// owned by context.
+rt_return_value_t prepare_compressed_variables(nn_network_t *n,
+                                               rt_context_t *c);
+void free_compressed_variables(rt_context_t *c);
+
+/// @brief Plan staging buffers of parameters when loader is set.
+rt_return_value_t prepare_parameter_staging(nn_network_t *n, rt_context_t *c);
+void free_parameter_staging(rt_context_t *c);
+
+/// @brief Make parameters of function i available before it runs. Those of
+/// next function are started to load if prefetch is not 0.
+rt_return_value_t stage_parameters(rt_context_t *c, int i, int prefetch);
+
+/// @brief Hash network and use plan given by rt_set_plan_cache() only if it
+/// was made for same network and settings.
+rt_return_value_t prepare_plan_cache(nn_network_t *n, rt_context_t *c);
+
+/// @brief Restore fusions from given plan, instead of build_function_fusion().
+rt_return_value_t restore_cached_fusion(nn_network_t *n, rt_context_t *c);
+
+/// @brief Restore offsets of planned variables from given plan.
+/// @return 1 if restored, otherwise 0 and variables must be planned.
+int restore_cached_offsets(nn_network_t *n, rt_context_t *c, size_t *offsets,
+                           size_t *arena_size, size_t *pinned_size);
+
+/// @brief Record plan of context after its fusions and buffers are planned.
+/// offsets is NULL without buffer planning.
+rt_return_value_t record_plan(nn_network_t *n, rt_context_t *c,
+                              const size_t *offsets, size_t arena_size,
+                              size_t pinned_size);
+
+/// @brief Record kernels chosen by functions in plan, after they are
+/// allocated.
+void record_kernel_choices(rt_context_t *c);
+void free_plan_cache(rt_context_t *c);
+
+/// @brief Allocate choices of kernels for functions of context, if they are
+/// tuned or given.
+rt_return_value_t prepare_kernel_choices(rt_context_t *c);
+void free_kernel_choices(rt_context_t *c);
+
+/// @brief Functions are allocated with areas of all kernels to choose one.
+int has_kernel_choices(rt_context_t *c);
+
+/// @brief Select kernel of function i after its local context is allocated,
+/// from given choice or by timing kernels, and free areas of others.
+void choose_function_kernel(rt_context_t *c, int i);
+
+/// @brief Functions of type which callbacks or backends may replace.
+int has_user_function(rt_context_t *c, nn_function_t *func);
+
+/// @brief Give function i to first backend which accepts it.
+/// @return 1 if a backend executes function.
+int allocate_backend_function(nn_network_t *n, rt_context_t *c, int i);
+void free_backends(rt_context_t *c);
+
+/// @brief Set per channel quantization of variables which have it in network.
+rt_return_value_t prepare_quantized_variables(nn_network_t *n,
+                                              rt_context_t *c);
+void free_quantized_variables(rt_context_t *c);
+
+/// @brief Same integers of x and y mean same values, i.e. they have same type
+/// and fp_pos without per channel quantization.
+int is_same_fixed_point(const rt_variable_t *x, const rt_variable_t *y);
+
+/// @brief Allocators which rt_malloc_func and rt_free_func point to.
+/// While a context is marked by @ref begin_context_allocation(), memory is
+/// taken from its arena if the context has one, otherwise they forward to its
+/// allocator or to the functions set by rt_set_malloc() and rt_set_free().
+void *context_malloc(size_t size);
+void context_free(void *ptr);
+
+/// @brief Variable allocator of routed context, or rt_variable_malloc_func
+/// and rt_variable_free_func.
+void *variable_backend_malloc(size_t size);
+void variable_backend_free(void *ptr);
+void set_backend_malloc(void *(*user_malloc)(size_t size));
+void set_backend_free(void (*user_free)(void *ptr));
+
+/// @brief Route allocation in this thread to context c.
+/// @return Previously routed context, pass it to @ref end_context_allocation.
+void *begin_context_allocation(rt_context_t *c);
+void end_context_allocation(void *previous);
+
+/// @brief Store of weight copies given to functions while context c is
+/// routed. Functions of clone use copies made by its source.
+const rt_weight_copies_t *get_weight_copies(rt_context_t *c);
+/// @brief Forget copies of context c. It must be after function contexts.
+void free_weight_copies(rt_context_t *c);
+
+/// @brief Add size to bytes allocated by routed context, if there is one.
+/// Allocations from context_malloc() and variable_malloc() are counted.
+void count_context_allocation(size_t size);
+
+/// @brief Bind calling thread to CPUs, on Linux.
+/// @return Non zero if succeeded.
+int bind_current_thread(const int *cpus, int num_of_cpus);
+
+/// @brief Run calling thread on CPUs of context while it is initialized.
+/// @return Previous binding, pass it to @ref end_placement.
+void *begin_placement(rt_context_t *c);
+void end_placement(void *previous);
+
+/// @brief Replace network with its copy by variable_malloc() if context
+/// replicates network, and keep given one in given_network.
+rt_return_value_t replicate_network(rt_context_t *c, nn_network_t **n);
+/// @brief Free copy of network. Allocation must be routed to context.
+void free_network_replica(rt_context_t *c);
+/// @brief Free CPUs set by rt_set_placement().
+void free_placement(rt_context_t *c);
+
+/// @brief Find functions which calculate only new columns of window moved
+/// by window_hop. Function contexts must be allocated.
+rt_return_value_t build_streaming_window(nn_network_t *n, rt_context_t *c);
+/// @brief Run function i of streaming window.
+rt_function_error_t exec_window_function(rt_context_t *c, int i);
+/// @brief Free streaming window. It must be before variables and function
+/// contexts.
+void free_streaming_window(rt_context_t *c);
+
+/// @brief Mark groups of rt_set_tiled_execution() in fusions, after other
+/// fusions are found. uses is number of functions reading each variable.
+/// @return Number of groups.
+int find_tiled_groups(nn_network_t *n, rt_context_t *c, const int *uses,
+                      function_fusion_t *fusions);
+/// @brief Make copies of functions of tiled groups calculating bands of
+/// rows. Function contexts must be allocated.
+rt_return_value_t build_tiled_execution(nn_network_t *n, rt_context_t *c);
+/// @brief Run tiled group whose last function is i.
+rt_function_error_t exec_tiled_group(rt_context_t *c, int i);
+/// @brief Free tiled groups. It must be before variables and function
+/// contexts.
+void free_tiled_execution(rt_context_t *c);
+
+/// @brief Find readers of network inputs for rt_set_result_caching().
+/// Variables must be allocated, and graph built if graph execution is used.
+rt_return_value_t build_result_cache(rt_context_t *c);
+/// @brief Mark functions which run in rt_forward(), all if cache is not valid.
+void begin_result_cache(rt_context_t *c);
+/// @brief Keep inputs and outputs of run, which is valid if it succeeded.
+void end_result_cache(rt_context_t *c, int succeeded);
+/// @brief Run all functions, and next rt_forward() too.
+void invalidate_result_cache(rt_context_t *c);
+void free_result_cache(rt_context_t *c);
+
+/// @brief Thread pool for @ref rt_parallel_executor_t.
+/// Threads are bound to cpus unless num_of_cpus is 0. With OpenMP, pool
+/// takes threads of OpenMP runtime for each loop.
+/// Returns NULL if threads are not supported.
+void *create_thread_pool(int num_of_threads, const int *cpus,
+                         int num_of_cpus);
+void destroy_thread_pool(void *pool);
+void thread_pool_parallel_for(void *pool, int size, rt_parallel_body_t body,
+                              void *arg);
+
+/// @brief 1 or more for threads of a pool in order of their start, or their
+/// number in OpenMP team, 0 for other threads.
+int current_thread_index(void);
+
+/// @brief Run every node of graph by run() on the pool.
+/// Nodes start when all of their dependencies are finished. After a failure
+/// no more nodes are started, and the first error is returned.
+rt_return_value_t thread_pool_run_graph(void *pool, function_graph_t *graph,
+                                        rt_return_value_t (*run)(void *arg,
+                                                                 int node),
+                                        void *arg);
+
+/// @brief Build dependency graph between functions of initialized context.
+/// graph is set to NULL when functions can run only in their order.
+rt_return_value_t build_function_graph(rt_context_t *c,
+                                       function_graph_t **graph);
+void free_function_graph(function_graph_t *graph);
+
+/// @brief Values of c->removed_functions.
+#define RT_FUNCTION_DEAD (1)   ///< No network output reads the function.
+#define RT_FUNCTION_FOLDED (2) ///< Calculated from parameters only.
+
+/// @brief Find functions whose outputs reach no network output, and those
+/// which read parameters only, before function fusion.
+/// c->removed_functions is set to NULL when none is found.
+rt_return_value_t build_graph_simplification(nn_network_t *n,
+                                             rt_context_t *c);
+
+/// @brief Calculate outputs of folded functions into c->constants. Variable
+/// data must be set.
+rt_return_value_t fold_constant_functions(nn_network_t *n, rt_context_t *c);
+
+/// @brief Function i is removed by graph simplification, and it does nothing
+/// in forward.
+int is_removed_function(const rt_context_t *c, int i);
+
+void free_graph_simplification(rt_context_t *c);
+
+/// @brief Find functions which can be merged into former Convolution or
+/// Affine, Pad, MeanSubtraction and Softmax merged into following function,
+/// chains of element wise functions, and tiled groups. Variables must be
+/// created, c->fusions is set to NULL when nothing is fused.
+rt_return_value_t build_function_fusion(nn_network_t *n, rt_context_t *c);
+
+/// @brief Number of int32_t recorded for fusion of each function.
+#define RT_FUSION_RECORD_SIZE (15)
+
+/// @brief Record fusions found by build_function_fusion() before they are
+/// dropped by prepare_function_fusion(), RT_FUSION_RECORD_SIZE for each
+/// function.
+void record_function_fusion(nn_network_t *n, rt_context_t *c,
+                            int32_t *record);
+
+/// @brief Set c->fusions from record instead of build_function_fusion(), or
+/// to NULL if record is NULL.
+rt_return_value_t restore_function_fusion(nn_network_t *n, rt_context_t *c,
+                                          const int32_t *record);
+
+/// @brief Drop fusions whose output overlaps with inputs in memory, and fold
+/// BatchNormalization into weight and bias. Variable data must be set.
+rt_return_value_t prepare_function_fusion(nn_network_t *n, rt_context_t *c);
+
+/// @brief Connect inputs and outputs of function i for fusion, before its
+/// local context is allocated.
+rt_return_value_t connect_fused_function(nn_network_t *n, rt_context_t *c,
+                                         int i);
+
+/// @brief Allocate local context of function i whose pad is widened by
+/// merged Pad, instead of allocate_function_context().
+/// @param[out] error Error of allocate function, when it is called.
+/// @return 1 if the local context is allocated, otherwise 0.
+int allocate_padded_function_context(nn_network_t *n, rt_context_t *c, int i,
+                                     rt_function_error_t *error);
+
+/// @brief Set epilogue of function i, or connect operands of its element
+/// wise chain and output of merged pooling, after its local context is
+/// allocated.
+rt_return_value_t set_fused_function_epilogue(nn_network_t *n,
+                                              rt_context_t *c, int i);
+
+/// @brief Set epilogue of activation merged into function i to f, which is
+/// function i or a copy of it.
+rt_return_value_t set_merged_activation(nn_network_t *n, rt_context_t *c,
+                                        int i, rt_function_t *f);
+
+/// @brief Run function i which is head of element wise chain.
+rt_function_error_t exec_function_chain(rt_context_t *c, int i);
+
+/// @brief Average output of function i into output of merged
+/// GlobalAveragePooling, after the function is executed.
+void exec_function_pooling(rt_context_t *c, int i);
+
+void free_function_fusion(rt_context_t *c);
+
+/// @brief Current time in nano seconds for profiling.
+uint64_t profile_now(void);
+
+/// @brief Allocate and clear profile of initialized context.
+rt_return_value_t allocate_profile(rt_context_t *c);
+void record_profile(rt_function_profile_t *profile, uint64_t elapsed);
+
+/// @brief Open hardware counters for threads of context. Counters of other
+/// threads are opened when they read them first.
+rt_return_value_t prepare_profile_counters(rt_context_t *c);
+void free_profile_counters(rt_context_t *c);
+
+/// @brief Read counters of calling thread, 0 for those not available.
+void read_profile_counters(profile_counters_t *p, uint64_t *values);
+void record_profile_counters(rt_function_profile_t *profile,
+                             const uint64_t *start, const uint64_t *end);
+
+/// @brief Start taking allocations of context c from beginning of its arena
+/// again. Chunks allocated before are reused.
+void rewind_context_arena(rt_context_t *c);
+
+/// @brief Allocate a chunk of given size for arena of context c, which has
+/// no block, so that initialization of the same network takes no more.
+rt_return_value_t reserve_context_arena(rt_context_t *c, size_t size);
+void free_context_arena(rt_context_t *c);
+
+/// @brief Take allocations of context c from block of given size at base,
+/// after context itself, or only count them if base is NULL.
+void init_static_block(rt_context_t *c, uint8_t *base, size_t size);
+
+/// @brief Remember memory used before initialization of static context.
+void mark_static_block(rt_context_t *c);
+
+/// @brief Give memory taken after mark back to block, after all of it is
+/// released, so that initializing context again takes the same memory.
+void rewind_static_block(rt_context_t *c);
+
+/// @brief Memory which lives as long as context, e.g. list of callbacks. It
+/// is taken from block of static context, or by rt_malloc_func.
+void *context_owned_malloc(rt_context_t *c, size_t size);
+void context_owned_free(rt_context_t *c, void *ptr);
 
 #endif // H_RUNTIME_INTERNAL_H_171220111925_
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Block sparse parameters are kept as they are in network when they are read
+ * only as weight of Affine or Convolution, whose kernels skip zero blocks.
+ * Parameters read by other functions are expanded into dense copies owned by
+ * context.
+ */
+
+static int is_valid_block_sparse(nn_network_t *n, nn_variable_t *var,
+                                 rt_variable_t *v) {
+  const nn_block_sparse_t *header;
+  const int32_t *row_offsets;
+  const int32_t *block_columns;
+  int i; // Iterator
+
+  if (var->data_index < 0 || v->type != NN_DATA_TYPE_FLOAT ||
+      v->shape.size < 1) {
+    return 0;
+  }
+  header = (const nn_block_sparse_t *)NN_GET(n, var->data_index);
+  if (header->rows != v->shape.data[0] || header->block_size < 1 ||
+      header->num_of_blocks < 0 ||
+      (size_t)header->rows * header->columns !=
+          calc_variable_data_size(v) / sizeof(float)) {
+    return 0;
+  }
+  row_offsets = (const int32_t *)(header + 1);
+  block_columns = row_offsets + header->rows + 1;
+  if (row_offsets[0] != 0 ||
+      row_offsets[header->rows] != header->num_of_blocks) {
+    return 0;
+  }
+  for (i = 0; i < header->rows; i++) {
+    if (row_offsets[i + 1] < row_offsets[i]) {
+      return 0;
+    }
+  }
+  for (i = 0; i < header->num_of_blocks; i++) {
+    if (block_columns[i] < 0 ||
+        block_columns[i] > header->columns - header->block_size) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Affine and Convolution read block sparse weight unless they may be replaced
+// by callbacks or backends.
+static int reads_sparse_weight(rt_context_t *c, nn_function_t *func,
+                               int input) {
+  if (input != 1 || (func->type != NN_FUNCTION_AFFINE &&
+                     func->type != NN_FUNCTION_CONVOLUTION_0 &&
+                     func->type != NN_FUNCTION_CONVOLUTION)) {
+    return 0;
+  }
+  return !has_user_function(c, func);
+}
+
+rt_return_value_t prepare_sparse_variables(nn_network_t *n, rt_context_t *c) {
+  int *variables = (int *)NN_GET(n, n->variables.list);
+  int *functions = (int *)NN_GET(n, n->functions.list);
+  int shared = c->source != 0 && c->source->dense_variables != 0;
+  size_t size = 0;
+  uint8_t *dense;
+  int i, j, k; // Iterator
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Check data and find variables read by other functions. Their layout is
+  // set to dense here, and their data is expanded below.
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, variables[i]));
+    if (c->variables[i].layout == NN_DATA_LAYOUT_DENSE) {
+      continue;
+    }
+    if (c->variables[i].layout != NN_DATA_LAYOUT_BLOCK_SPARSE ||
+        !is_valid_block_sparse(n, var, c->variables + i)) {
+      return RT_RET_ERROR_INIT_VARIABLE;
+    }
+  }
+  for (j = 0; j < n->functions.size; j++) {
+    nn_function_t *func = (nn_function_t *)(NN_GET(n, functions[j]));
+    rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+    for (k = 0; k < inputs.size; k++) {
+      rt_variable_t *v = c->variables + inputs.data[k];
+      if (v->layout == NN_DATA_LAYOUT_BLOCK_SPARSE &&
+          !reads_sparse_weight(c, func, k)) {
+        v->layout = NN_DATA_LAYOUT_DENSE;
+        size += calc_variable_data_size(v);
+      }
+    }
+  }
+  if (size == 0) {
+    return RT_RET_NOERROR;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Expand them into one area.
+  if (shared) {
+    // Variables expanded by source are placed in the same order.
+    c->dense_variables = c->source->dense_variables;
+  } else {
+    c->dense_variables = rt_malloc_func(size);
+  }
+  if (c->dense_variables == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  dense = c->dense_variables;
+  for (i = 0; i < c->num_of_variables; i++) {
+    nn_variable_t *var = (nn_variable_t *)(NN_GET(n, variables[i]));
+    rt_variable_t *v = c->variables + i;
+    if (var->layout == NN_DATA_LAYOUT_BLOCK_SPARSE &&
+        v->layout == NN_DATA_LAYOUT_DENSE) {
+      rt_variable_t sparse = *v;
+      sparse.layout = NN_DATA_LAYOUT_BLOCK_SPARSE;
+      if (!shared) {
+        rt_expand_block_sparse(&sparse, (float *)dense);
+      }
+      v->data = dense;
+      dense += calc_variable_data_size(v);
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+void free_sparse_variables(rt_context_t *c) {
+  // Those of clone are owned by source.
+  if (c->dense_variables &&
+      (c->source == 0 || c->source->dense_variables != c->dense_variables)) {
+    rt_free_func(c->dense_variables);
+  }
+  c->dense_variables = 0;
+}
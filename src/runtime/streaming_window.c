@@ -0,0 +1,599 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <string.h>
+
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Last axis of every network input is time, and each run gets the window of
+ * former run moved by hop columns. Each variable is then classified at
+ * initialization as
+ * - constant, which is same in every run,
+ * - moved, whose columns are those of former run moved by its own hop,
+ *   except head and tail columns, or
+ * - changed, which has no relation to former run.
+ * Convolution and pooling along time keep their output of former run, move
+ * it, and calculate head and tail columns only by narrow copies of
+ * themselves. Other functions run as they are, and element wise ones keep
+ * their inputs moved.
+ */
+
+typedef enum {
+  WINDOW_CONSTANT = 0,
+  WINDOW_MOVED,
+  WINDOW_CHANGED,
+} window_kind_t;
+
+typedef struct {
+  window_kind_t kind;
+  int hop;  ///< Columns moved in each run.
+  int head; ///< First columns which are calculated again.
+  int tail; ///< Last columns which are calculated again.
+} window_variable_t;
+
+/// Parameters of a function along time, the last axis.
+typedef struct {
+  int kernel;
+  int stride;
+  int dilation;
+  int pad;
+  size_t context_size; ///< Bytes of local context of function type.
+  size_t pad_offset;   ///< Offset of pad list in local context.
+  size_t data_offset;  ///< Offset of private data in local context.
+  rt_function_error_t (*allocate)(rt_function_t *f);
+  rt_function_error_t (*free)(rt_function_t *f);
+} window_axis_t;
+
+rt_return_value_t rt_set_streaming_window(rt_context_pointer context,
+                                          int hop) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  if (hop < 0) {
+    return RT_RET_ERROR_INVALID_SHAPE;
+  }
+  c->window_hop = hop;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t rt_reset_streaming_window(rt_context_pointer context) {
+  rt_context_t *c = context;
+  int i; // Iterator
+
+  if (c->network == 0) {
+    return RT_RET_ERROR_NOT_INITIALIZED;
+  }
+  if (c->window) {
+    for (i = 0; i < c->window->num_of_functions; i++) {
+      c->window->functions[i].primed = 0;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+static int variable_index(rt_context_t *c, const rt_variable_t *v) {
+  return v ? (int)(v - c->variables) : -1;
+}
+
+static int last_dim(const rt_variable_t *v) {
+  return v->shape.size > 0 ? v->shape.data[v->shape.size - 1] : 0;
+}
+
+static int is_same_shape(const rt_variable_t *a, const rt_variable_t *b) {
+  return a->shape.size == b->shape.size &&
+         memcmp(a->shape.data, b->shape.data, sizeof(int) * a->shape.size) ==
+             0;
+}
+
+static int is_float(const rt_variable_t *v) {
+  return v && v->type == NN_DATA_TYPE_FLOAT &&
+         v->layout == NN_DATA_LAYOUT_DENSE && !v->quantization;
+}
+
+#if defined(CONFIG_CONVOLUTION) || defined(CONFIG_MAXPOOLING) ||             \
+    defined(CONFIG_AVERAGEPOOLING) || defined(CONFIG_SUMPOOLING)
+static int last_of(rt_list_t list, int value) {
+  return list.size > 0 ? list.data[list.size - 1] : value;
+}
+#endif
+
+// Element wise functions with inputs of same shape as output.
+static int is_binary_elementwise(const nn_function_t *func) {
+  switch (func->type) {
+  case NN_FUNCTION_ADD2:
+  case NN_FUNCTION_SUB2:
+  case NN_FUNCTION_MUL2:
+  case NN_FUNCTION_DIV2:
+  case NN_FUNCTION_POW2:
+  case NN_FUNCTION_MAXIMUM2:
+  case NN_FUNCTION_MINIMUM2:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+// Parameters along time if function is calculated in float by runtime and
+// its output columns can be calculated by a narrow copy of it.
+static int get_window_axis(rt_context_t *c, int i, window_axis_t *axis) {
+  rt_function_t *f = &c->functions[i].func;
+
+  if (f->num_of_inputs < 1 || f->num_of_outputs != 1 ||
+      !is_float(f->inputs[0]) || !is_float(f->outputs[0]) ||
+      f->inputs[0]->shape.size < 3 ||
+      f->inputs[0]->shape.size != f->outputs[0]->shape.size) {
+    return 0;
+  }
+  switch (c->functions[i].info->type) {
+#ifdef CONFIG_CONVOLUTION
+  case NN_FUNCTION_CONVOLUTION: {
+    convolution_local_context_t *ctx = f->local_context;
+    if (f->exec_func != exec_convolution || ctx->channel_last ||
+        f->num_of_inputs < 2 || f->inputs[1]->shape.size < 1) {
+      return 0;
+    }
+    axis->kernel = last_dim(f->inputs[1]);
+    axis->stride = last_of(ctx->stride, 1);
+    axis->dilation = last_of(ctx->dilation, 1);
+    axis->pad = last_of(ctx->pad, 0);
+    axis->context_size = sizeof(convolution_local_context_t);
+    axis->pad_offset = offsetof(convolution_local_context_t, pad);
+    axis->data_offset = offsetof(convolution_local_context_t, data);
+    axis->allocate = allocate_convolution_local_context;
+    axis->free = free_convolution_local_context;
+    return 1;
+  }
+#endif /* CONFIG_CONVOLUTION */
+#ifdef CONFIG_MAXPOOLING
+  case NN_FUNCTION_MAX_POOLING: {
+    max_pooling_local_context_t *ctx = f->local_context;
+    axis->kernel = last_of(ctx->kernel, 1);
+    axis->stride = last_of(ctx->stride, axis->kernel);
+    axis->pad = last_of(ctx->pad, 0);
+    axis->context_size = sizeof(max_pooling_local_context_t);
+    axis->pad_offset = offsetof(max_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(max_pooling_local_context_t, data);
+    axis->allocate = allocate_max_pooling_local_context;
+    axis->free = free_max_pooling_local_context;
+    axis->dilation = 1;
+    // Padded elements of pooling are not zero, so windows must be inside
+    // input.
+    return !ctx->channel_last && axis->pad == 0;
+  }
+#endif /* CONFIG_MAXPOOLING */
+#ifdef CONFIG_AVERAGEPOOLING
+  case NN_FUNCTION_AVERAGE_POOLING: {
+    average_pooling_local_context_t *ctx = f->local_context;
+    axis->kernel = last_of(ctx->kernel, 1);
+    axis->stride = last_of(ctx->stride, axis->kernel);
+    axis->pad = last_of(ctx->pad, 0);
+    axis->context_size = sizeof(average_pooling_local_context_t);
+    axis->pad_offset = offsetof(average_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(average_pooling_local_context_t, data);
+    axis->allocate = allocate_average_pooling_local_context;
+    axis->free = free_average_pooling_local_context;
+    axis->dilation = 1;
+    return !ctx->channel_last && axis->pad == 0;
+  }
+#endif /* CONFIG_AVERAGEPOOLING */
+#ifdef CONFIG_SUMPOOLING
+  case NN_FUNCTION_SUM_POOLING: {
+    sum_pooling_local_context_t *ctx = f->local_context;
+    axis->kernel = last_of(ctx->kernel, 1);
+    axis->stride = last_of(ctx->stride, axis->kernel);
+    axis->pad = last_of(ctx->pad, 0);
+    axis->context_size = sizeof(sum_pooling_local_context_t);
+    axis->pad_offset = offsetof(sum_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(sum_pooling_local_context_t, data);
+    axis->allocate = allocate_sum_pooling_local_context;
+    axis->free = free_sum_pooling_local_context;
+    axis->dilation = 1;
+    return !ctx->channel_last && axis->pad == 0;
+  }
+#endif /* CONFIG_SUMPOOLING */
+  default:
+    return 0;
+  }
+}
+
+static void free_part(window_axis_t *axis, window_part_t *part) {
+  if (part->func.local_context) {
+    if (part->func.exec_func) {
+      axis->free(&part->func);
+    }
+    rt_list_t *pad = (rt_list_t *)((uint8_t *)part->func.local_context +
+                                   axis->pad_offset);
+    rt_free_func(pad->data);
+    rt_free_func(part->func.local_context);
+  }
+  rt_free_func(part->func.inputs);
+  rt_free_func(part->func.outputs);
+  rt_free_func(part->input.shape.data);
+  rt_free_func(part->output.shape.data);
+  variable_free(part->input.data);
+  variable_free(part->output.data);
+  memset(part, 0, sizeof(window_part_t));
+}
+
+static rt_variable_t narrow_variable(const rt_variable_t *v, int columns,
+                                     int *ok) {
+  rt_variable_t narrow = *v;
+  narrow.shape.data = rt_malloc_func(sizeof(int) * v->shape.size);
+  narrow.data = 0;
+  if (narrow.shape.data == 0) {
+    *ok = 0;
+    return narrow;
+  }
+  memcpy(narrow.shape.data, v->shape.data, sizeof(int) * v->shape.size);
+  narrow.shape.data[v->shape.size - 1] = columns;
+  narrow.data = variable_malloc(calc_variable_data_size(&narrow));
+  if (narrow.data == 0) {
+    *ok = 0;
+  }
+  return narrow;
+}
+
+// Copy of function i calculating output columns [first, first + columns)
+// from gathered input without padding along time.
+static int allocate_part(rt_context_t *c, int i, window_axis_t *axis,
+                         int first, int columns, window_part_t *part) {
+  rt_function_t *f = &c->functions[i].func;
+  int ok = 1;
+
+  memset(part, 0, sizeof(window_part_t));
+  part->first = first;
+  part->columns = columns;
+  part->start = first * axis->stride - axis->pad;
+  part->input = narrow_variable(
+      f->inputs[0], (columns - 1) * axis->stride + axis->dilation *
+                                                        (axis->kernel - 1) +
+                        1,
+      &ok);
+  part->output = narrow_variable(f->outputs[0], columns, &ok);
+  part->func.num_of_inputs = f->num_of_inputs;
+  part->func.num_of_outputs = 1;
+  part->func.inputs =
+      rt_malloc_func(sizeof(rt_variable_t *) * f->num_of_inputs);
+  part->func.outputs = rt_malloc_func(sizeof(rt_variable_t *));
+  part->func.local_context = rt_malloc_func(axis->context_size);
+  if (!ok || part->func.inputs == 0 || part->func.outputs == 0 ||
+      part->func.local_context == 0) {
+    free_part(axis, part);
+    return 0;
+  }
+  memcpy(part->func.inputs, f->inputs,
+         sizeof(rt_variable_t *) * f->num_of_inputs);
+  part->func.inputs[0] = &part->input;
+  part->func.outputs[0] = &part->output;
+
+  // Same parameters as function except padding along time.
+  memcpy(part->func.local_context, f->local_context, axis->context_size);
+  rt_list_t *pad =
+      (rt_list_t *)((uint8_t *)part->func.local_context + axis->pad_offset);
+  const rt_list_t *given =
+      (const rt_list_t *)((uint8_t *)f->local_context + axis->pad_offset);
+  pad->data = rt_malloc_func(sizeof(int) * (given->size > 0 ? given->size : 1));
+  if (pad->data == 0) {
+    free_part(axis, part);
+    return 0;
+  }
+  memcpy(pad->data, given->data, sizeof(int) * given->size);
+  if (pad->size > 0) {
+    pad->data[pad->size - 1] = 0;
+  }
+  *(void **)((uint8_t *)part->func.local_context + axis->data_offset) = 0;
+
+  if (axis->allocate(&part->func) != RT_FUNCTION_ERROR_NOERROR) {
+    // Partly allocated private data is left.
+    part->func.exec_func = 0;
+    free_part(axis, part);
+    return 0;
+  }
+  return 1;
+}
+
+// Columns calculated again and hop of output of function reading moved x.
+static void propagate_window(const window_axis_t *axis,
+                             const window_variable_t *x, int in_columns,
+                             int out_columns, window_variable_t *y) {
+  int reach = axis->dilation * (axis->kernel - 1);
+  int first_tail;
+
+  y->kind = WINDOW_MOVED;
+  y->hop = x->hop / axis->stride;
+  y->head = x->head + axis->pad > 0
+                ? (x->head + axis->pad + axis->stride - 1) / axis->stride
+                : 0;
+  // Output column j reads input columns from j * stride - pad to
+  // j * stride - pad + reach.
+  first_tail = in_columns - x->tail + axis->pad - reach;
+  first_tail = first_tail > 0 ? (first_tail + axis->stride - 1) / axis->stride
+                              : 0;
+  y->tail = out_columns - first_tail;
+  if (y->tail < y->hop) {
+    y->tail = y->hop;
+  }
+  if (y->head > out_columns) {
+    y->head = out_columns;
+  }
+}
+
+static int is_valid_window_axis(const window_axis_t *axis,
+                                const window_variable_t *x, int in_columns,
+                                int out_columns) {
+  int reach = axis->dilation * (axis->kernel - 1);
+  // Pooling which does not ignore border has another output for remaining
+  // columns, which is not a window of same size.
+  return axis->stride > 0 && axis->kernel > 0 && axis->dilation > 0 &&
+         x->hop % axis->stride == 0 &&
+         out_columns ==
+             (in_columns + 2 * axis->pad - reach - 1) / axis->stride + 1;
+}
+
+static rt_return_value_t add_window_function(rt_context_t *c, int i,
+                                             window_axis_t *axis,
+                                             const window_variable_t *y) {
+  streaming_window_t *w = c->window;
+  window_function_t *wf = w->functions + w->num_of_functions;
+  rt_function_t *f = &c->functions[i].func;
+
+  memset(wf, 0, sizeof(window_function_t));
+  wf->function = i;
+  wf->in_columns = last_dim(f->inputs[0]);
+  wf->out_columns = last_dim(f->outputs[0]);
+  wf->hop = y->hop;
+  if ((y->head > 0 &&
+       !allocate_part(c, i, axis, 0, y->head, &wf->head)) ||
+      !allocate_part(c, i, axis, wf->out_columns - y->tail, y->tail,
+                     &wf->tail)) {
+    free_part(axis, &wf->head);
+    // Function runs as it is.
+    return RT_RET_NOERROR;
+  }
+  wf->state = variable_malloc(calc_variable_data_size(f->outputs[0]));
+  if (wf->state == 0) {
+    free_part(axis, &wf->head);
+    free_part(axis, &wf->tail);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  w->index[i] = w->num_of_functions++;
+  return RT_RET_NOERROR;
+}
+
+// Classify outputs of function i from its inputs, and make it window
+// function if it calculates fewer columns by that.
+static rt_return_value_t classify_function(rt_context_t *c, int i,
+                                           window_variable_t *vars) {
+  rt_function_t *f = &c->functions[i].func;
+  const nn_function_t *info = c->functions[i].info;
+  window_variable_t y = {WINDOW_CONSTANT, 0, 0, 0};
+  window_axis_t axis;
+  int j; // Iterator
+
+  for (j = 0; j < f->num_of_inputs; j++) {
+    int index = variable_index(c, f->inputs[j]);
+    if (index >= 0 && vars[index].kind > y.kind) {
+      y.kind = vars[index].kind;
+    }
+  }
+  if (y.kind == WINDOW_MOVED) {
+    window_variable_t *x = vars + variable_index(c, f->inputs[0]);
+    int moved_params = 0;
+    for (j = 1; j < f->num_of_inputs; j++) {
+      int index = variable_index(c, f->inputs[j]);
+      if (index >= 0 && vars[index].kind != WINDOW_CONSTANT) {
+        moved_params = 1;
+      }
+    }
+    y.kind = WINDOW_CHANGED;
+    if (x->kind == WINDOW_MOVED && !moved_params &&
+        get_window_axis(c, i, &axis) &&
+        is_valid_window_axis(&axis, x, last_dim(f->inputs[0]),
+                             last_dim(f->outputs[0]))) {
+      int out_columns = last_dim(f->outputs[0]);
+      propagate_window(&axis, x, last_dim(f->inputs[0]), out_columns, &y);
+      if (y.head + y.tail < out_columns && !c->functions[i].alias &&
+          c->functions[i].backend < 0) {
+        rt_return_value_t ret = add_window_function(c, i, &axis, &y);
+        if (ret != RT_RET_NOERROR) {
+          return ret;
+        }
+      }
+    } else if (x->kind == WINDOW_MOVED && f->num_of_outputs == 1 &&
+               is_same_shape(f->inputs[0], f->outputs[0]) &&
+               (is_inplace_function(info) || is_binary_elementwise(info))) {
+      // Each output column is calculated from same column of inputs.
+      y = *x;
+      for (j = 1; j < f->num_of_inputs; j++) {
+        window_variable_t *v = vars + variable_index(c, f->inputs[j]);
+        if (is_inplace_function(info) && v->kind == WINDOW_CONSTANT) {
+          continue; // Parameters such as slope of PReLU.
+        }
+        if (v->kind != WINDOW_MOVED || v->hop != x->hop ||
+            !is_same_shape(f->inputs[j], f->outputs[0])) {
+          y.kind = WINDOW_CHANGED;
+          break;
+        }
+        y.head = v->head > y.head ? v->head : y.head;
+        y.tail = v->tail > y.tail ? v->tail : y.tail;
+      }
+    }
+  }
+  for (j = 0; j < f->num_of_outputs; j++) {
+    int index = variable_index(c, f->outputs[j]);
+    if (index >= 0) {
+      vars[index] = y;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t build_streaming_window(nn_network_t *n, rt_context_t *c) {
+  int i; // Iterator
+
+  c->window = 0;
+  if (c->window_hop == 0 || c->loader.load) {
+    return RT_RET_NOERROR;
+  }
+  window_variable_t *vars =
+      rt_malloc_func(sizeof(window_variable_t) * c->num_of_variables);
+  c->window = rt_malloc_func(sizeof(streaming_window_t));
+  if (vars == 0 || c->window == 0) {
+    rt_free_func(vars);
+    rt_free_func(c->window);
+    c->window = 0;
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  c->window->num_of_functions = 0;
+  c->window->functions =
+      rt_malloc_func(sizeof(window_function_t) * (c->num_of_functions + 1));
+  c->window->index = rt_malloc_func(sizeof(int) * (c->num_of_functions + 1));
+  if (c->window->functions == 0 || c->window->index == 0) {
+    rt_free_func(vars);
+    free_streaming_window(c);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  memset(vars, 0, sizeof(window_variable_t) * c->num_of_variables);
+  for (i = 0; i < c->num_of_functions; i++) {
+    c->window->index[i] = -1;
+  }
+
+  int *inputs = (int *)NN_GET(n, n->inputs.list);
+  for (i = 0; i < n->inputs.size; i++) {
+    window_variable_t *v = vars + inputs[i];
+    v->kind = last_dim(c->variables + inputs[i]) > c->window_hop
+                  ? WINDOW_MOVED
+                  : WINDOW_CHANGED;
+    v->hop = c->window_hop;
+    v->tail = c->window_hop;
+  }
+
+  rt_math_mode_t previous_mode =
+      rt_set_math_mode(c->fast_math ? RT_MATH_MODE_FAST : RT_MATH_MODE_EXACT);
+  rt_return_value_t ret = RT_RET_NOERROR;
+  for (i = 0; i < c->num_of_functions && ret == RT_RET_NOERROR; i++) {
+    ret = classify_function(c, i, vars);
+  }
+  rt_set_math_mode(previous_mode);
+  rt_free_func(vars);
+  return ret;
+}
+
+// Copy input columns of part, zero outside of input.
+static void gather_columns(const window_part_t *part, const float *x,
+                           int in_columns) {
+  int width = last_dim(&part->input);
+  int rows =
+      (int)(calc_variable_data_size(&part->input) / sizeof(float) / width);
+  float *dst = (float *)(part->input.data);
+  int begin = part->start < 0 ? -part->start : 0;
+  int end = in_columns - part->start < width ? in_columns - part->start
+                                             : width;
+  int r, j; // Iterator
+
+  for (r = 0; r < rows; r++) {
+    const float *src = x + (size_t)r * in_columns + part->start;
+    float *row = dst + (size_t)r * width;
+    for (j = 0; j < begin; j++) {
+      row[j] = 0.0f;
+    }
+    memcpy(row + begin, src + begin, sizeof(float) * (end - begin));
+    for (j = end; j < width; j++) {
+      row[j] = 0.0f;
+    }
+  }
+}
+
+static rt_function_error_t run_part(window_function_t *wf,
+                                    const window_part_t *part,
+                                    const float *x, int rows) {
+  const float *y = (const float *)(part->output.data);
+  int r; // Iterator
+
+  if (part->columns == 0) {
+    return RT_FUNCTION_ERROR_NOERROR;
+  }
+  gather_columns(part, x, wf->in_columns);
+  rt_function_error_t ret =
+      part->func.exec_func((rt_function_t *)&part->func);
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    return ret;
+  }
+  for (r = 0; r < rows; r++) {
+    memcpy(wf->state + (size_t)r * wf->out_columns + part->first,
+           y + (size_t)r * part->columns, sizeof(float) * part->columns);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+rt_function_error_t exec_window_function(rt_context_t *c, int i) {
+  window_function_t *wf = c->window->functions + c->window->index[i];
+  rt_function_t *f = &c->functions[i].func;
+  size_t size = calc_variable_data_size(f->outputs[0]);
+  int rows = (int)(size / sizeof(float) / wf->out_columns);
+  int r; // Iterator
+
+  if (!wf->primed) {
+    rt_function_error_t ret = f->exec_func(f);
+    if (ret == RT_FUNCTION_ERROR_NOERROR) {
+      memcpy(wf->state, f->outputs[0]->data, size);
+      wf->primed = 1;
+    }
+    return ret;
+  }
+  for (r = 0; r < rows; r++) {
+    float *row = wf->state + (size_t)r * wf->out_columns;
+    memmove(row, row + wf->hop,
+            sizeof(float) * (wf->out_columns - wf->hop));
+  }
+  const float *x = (const float *)(f->inputs[0]->data);
+  rt_function_error_t ret = run_part(wf, &wf->head, x, rows);
+  if (ret == RT_FUNCTION_ERROR_NOERROR) {
+    ret = run_part(wf, &wf->tail, x, rows);
+  }
+  if (ret != RT_FUNCTION_ERROR_NOERROR) {
+    wf->primed = 0;
+    return ret;
+  }
+  memcpy(f->outputs[0]->data, wf->state, size);
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_streaming_window(rt_context_t *c) {
+  int i; // Iterator
+
+  if (c->window == 0) {
+    return;
+  }
+  for (i = 0; i < c->window->num_of_functions; i++) {
+    window_function_t *wf = c->window->functions + i;
+    window_axis_t axis;
+    get_window_axis(c, wf->function, &axis);
+    free_part(&axis, &wf->head);
+    free_part(&axis, &wf->tail);
+    variable_free(wf->state);
+  }
+  rt_free_func(c->window->functions);
+  rt_free_func(c->window->index);
+  rt_free_func(c->window);
+  c->window = 0;
+}
@@ -0,0 +1,459 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+// 0 for threads which are not in pool.
+static RT_THREAD_LOCAL int thread_index = 0;
+
+int current_thread_index(void) { return thread_index; }
+
+#if defined(NNABLART_USE_OPENMP)
+
+#include <omp.h>
+
+/*
+ * Threads belong to OpenMP runtime and are shared by all contexts, pool only
+ * keeps how many of them a context uses and CPUs they are bound to. Each
+ * thread binds itself again when it runs for a pool with other CPUs.
+ */
+
+typedef struct {
+  int num_of_threads; ///< Number of threads including caller thread.
+  int id;             ///< Unique number of pool which threads are bound by.
+  int *cpus;          ///< CPUs which threads are bound to, or NULL.
+  int num_of_cpus;
+} thread_pool_t;
+
+static RT_THREAD_LOCAL int bound_pool = 0;
+
+// Thread r of team of pool takes its index, and CPUs if it is not caller.
+static void enter_pool(thread_pool_t *pool, int r) {
+  thread_index = r;
+  if (r > 0 && pool->cpus && bound_pool != pool->id) {
+    // Left unbound if it fails, e.g. CPUs are offline.
+    bind_current_thread(pool->cpus, pool->num_of_cpus);
+    bound_pool = pool->id;
+  }
+}
+
+void *create_thread_pool(int num_of_threads, const int *cpus,
+                         int num_of_cpus) {
+  static int num_of_pools = 0;
+  thread_pool_t *pool = rt_malloc_func(sizeof(thread_pool_t));
+  if (pool == 0) {
+    return 0;
+  }
+  pool->cpus = num_of_cpus > 0 ? rt_malloc_func(sizeof(int) * num_of_cpus) : 0;
+  if (num_of_cpus > 0 && pool->cpus == 0) {
+    rt_free_func(pool);
+    return 0;
+  }
+  if (pool->cpus) {
+    memcpy(pool->cpus, cpus, sizeof(int) * num_of_cpus);
+  }
+  pool->num_of_cpus = num_of_cpus;
+  pool->num_of_threads = num_of_threads;
+#pragma omp critical(nnablart_thread_pool)
+  pool->id = ++num_of_pools;
+  return pool;
+}
+
+void destroy_thread_pool(void *p) {
+  thread_pool_t *pool = p;
+  if (pool->cpus) {
+    rt_free_func(pool->cpus);
+  }
+  rt_free_func(pool);
+}
+
+void thread_pool_parallel_for(void *p, int size, rt_parallel_body_t body,
+                              void *arg) {
+  thread_pool_t *pool = p;
+  int caller = thread_index;
+  int num_of_ranges = size < pool->num_of_threads ? size : pool->num_of_threads;
+
+#pragma omp parallel num_threads(num_of_ranges)
+  {
+    // Team may be smaller than requested, e.g. in nested region.
+    int r = omp_get_thread_num();
+    int n = omp_get_num_threads();
+    enter_pool(pool, r);
+    body(arg, (int)((long long)size * r / n),
+         (int)((long long)size * (r + 1) / n));
+  }
+  thread_index = caller;
+}
+
+#if _OPENMP >= 201107
+
+typedef struct {
+  thread_pool_t *pool;
+  function_graph_t *graph;
+  rt_return_value_t (*run)(void *arg, int node);
+  void *arg;
+  rt_return_value_t error;
+} graph_job_t;
+
+// Each node is a task, which spawns successors whose dependencies are done.
+static void run_graph_node(graph_job_t *job, int node) {
+  function_graph_t *g = job->graph;
+  rt_return_value_t ret;
+  int error, remaining;
+  int i; // Iterator
+
+#pragma omp atomic read
+  error = job->error;
+  if (error != RT_RET_NOERROR) {
+    return;
+  }
+  enter_pool(job->pool, omp_get_thread_num());
+  ret = job->run(job->arg, node);
+  if (ret != RT_RET_NOERROR) {
+#pragma omp critical(nnablart_graph_error)
+    if (job->error == RT_RET_NOERROR) {
+      job->error = ret;
+    }
+    return;
+  }
+  for (i = g->successor_offsets[node]; i < g->successor_offsets[node + 1];
+       i++) {
+    int successor = g->successors[i];
+#pragma omp atomic capture
+    remaining = --g->remaining[successor];
+    if (remaining == 0) {
+#pragma omp task firstprivate(successor)
+      run_graph_node(job, successor);
+    }
+  }
+}
+
+rt_return_value_t thread_pool_run_graph(void *p, function_graph_t *graph,
+                                        rt_return_value_t (*run)(void *arg,
+                                                                 int node),
+                                        void *arg) {
+  thread_pool_t *pool = p;
+  graph_job_t job;
+  int caller = thread_index;
+  int i; // Iterator
+
+  job.pool = pool;
+  job.graph = graph;
+  job.run = run;
+  job.arg = arg;
+  job.error = RT_RET_NOERROR;
+  for (i = 0; i < graph->num_of_nodes; i++) {
+    graph->remaining[i] = graph->num_of_dependencies[i];
+  }
+
+#pragma omp parallel num_threads(pool->num_of_threads)
+#pragma omp single
+  for (i = 0; i < graph->num_of_nodes; i++) {
+    if (graph->num_of_dependencies[i] == 0) {
+#pragma omp task firstprivate(i)
+      run_graph_node(&job, i);
+    }
+  }
+  thread_index = caller;
+  return job.error;
+}
+
+#else /* _OPENMP >= 201107 */
+
+rt_return_value_t thread_pool_run_graph(void *pool, function_graph_t *graph,
+                                        rt_return_value_t (*run)(void *arg,
+                                                                 int node),
+                                        void *arg) {
+  int i; // Iterator
+  // Without tasks of OpenMP 3.1, nodes run in order on calling thread.
+  (void)pool;
+  for (i = 0; i < graph->num_of_nodes; i++) {
+    rt_return_value_t ret = run(arg, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+#endif /* _OPENMP >= 201107 */
+
+#elif defined(NNABLART_USE_PTHREAD)
+
+#include <pthread.h>
+
+typedef struct {
+  int num_of_threads; ///< Number of threads including caller thread.
+  pthread_t *threads;
+  pthread_mutex_t mutex;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  unsigned int generation;
+  int shutdown;
+  int num_of_started; ///< Number of threads which took their index.
+  int *cpus;          ///< CPUs which threads are bound to, or NULL.
+  int num_of_cpus;
+
+  // Current job
+  rt_parallel_body_t body;
+  void *arg;
+  int size;
+  int num_of_ranges;
+  int next_range;
+  int remaining;
+} thread_pool_t;
+
+// Run ranges of current job until no range left. Mutex must be locked.
+static void run_ranges(thread_pool_t *pool) {
+  while (pool->next_range < pool->num_of_ranges) {
+    int r = pool->next_range++;
+    int begin = (int)((long long)pool->size * r / pool->num_of_ranges);
+    int end = (int)((long long)pool->size * (r + 1) / pool->num_of_ranges);
+    pthread_mutex_unlock(&pool->mutex);
+    pool->body(pool->arg, begin, end);
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->remaining == 0) {
+      pthread_cond_signal(&pool->done);
+    }
+  }
+}
+
+static void *worker(void *arg) {
+  thread_pool_t *pool = arg;
+  unsigned int generation = 0;
+
+  if (pool->cpus) {
+    // Left unbound if it fails, e.g. CPUs are offline.
+    bind_current_thread(pool->cpus, pool->num_of_cpus);
+  }
+  pthread_mutex_lock(&pool->mutex);
+  thread_index = ++pool->num_of_started;
+  for (;;) {
+    while (pool->generation == generation && !pool->shutdown) {
+      pthread_cond_wait(&pool->start, &pool->mutex);
+    }
+    if (pool->shutdown) {
+      break;
+    }
+    generation = pool->generation;
+    run_ranges(pool);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  return 0;
+}
+
+void *create_thread_pool(int num_of_threads, const int *cpus,
+                         int num_of_cpus) {
+  int i; // Iterator
+  thread_pool_t *pool = rt_malloc_func(sizeof(thread_pool_t));
+  if (pool == 0) {
+    return 0;
+  }
+  pool->threads = rt_malloc_func(sizeof(pthread_t) * (num_of_threads - 1));
+  pool->cpus = num_of_cpus > 0 ? rt_malloc_func(sizeof(int) * num_of_cpus) : 0;
+  if (pool->threads == 0 || (num_of_cpus > 0 && pool->cpus == 0)) {
+    if (pool->threads) {
+      rt_free_func(pool->threads);
+    }
+    rt_free_func(pool);
+    return 0;
+  }
+  if (pool->cpus) {
+    memcpy(pool->cpus, cpus, sizeof(int) * num_of_cpus);
+  }
+  pool->num_of_cpus = num_of_cpus;
+  pool->num_of_threads = num_of_threads;
+  pool->generation = 0;
+  pool->shutdown = 0;
+  pool->num_of_started = 0;
+  pool->num_of_ranges = 0;
+  pool->next_range = 0;
+  pool->remaining = 0;
+  pthread_mutex_init(&pool->mutex, 0);
+  pthread_cond_init(&pool->start, 0);
+  pthread_cond_init(&pool->done, 0);
+
+  for (i = 0; i < num_of_threads - 1; i++) {
+    if (pthread_create(pool->threads + i, 0, worker, pool) != 0) {
+      pool->num_of_threads = i + 1;
+      destroy_thread_pool(pool);
+      return 0;
+    }
+  }
+  return pool;
+}
+
+void destroy_thread_pool(void *p) {
+  int i; // Iterator
+  thread_pool_t *pool = p;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->mutex);
+  for (i = 0; i < pool->num_of_threads - 1; i++) {
+    pthread_join(pool->threads[i], 0);
+  }
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->start);
+  pthread_mutex_destroy(&pool->mutex);
+  if (pool->cpus) {
+    rt_free_func(pool->cpus);
+  }
+  rt_free_func(pool->threads);
+  rt_free_func(pool);
+}
+
+void thread_pool_parallel_for(void *p, int size, rt_parallel_body_t body,
+                              void *arg) {
+  thread_pool_t *pool = p;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->body = body;
+  pool->arg = arg;
+  pool->size = size;
+  pool->num_of_ranges =
+      size < pool->num_of_threads ? size : pool->num_of_threads;
+  pool->next_range = 0;
+  pool->remaining = pool->num_of_ranges;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->start);
+
+  run_ranges(pool);
+  while (pool->remaining > 0) {
+    pthread_cond_wait(&pool->done, &pool->mutex);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+typedef struct {
+  function_graph_t *graph;
+  rt_return_value_t (*run)(void *arg, int node);
+  void *arg;
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  int head;     ///< Next position to take from graph->ready.
+  int tail;     ///< Next position to put into graph->ready.
+  int running;  ///< Number of nodes running now.
+  int finished; ///< Number of finished nodes.
+  rt_return_value_t error;
+} graph_job_t;
+
+// Every thread of the pool runs this until whole graph is finished.
+static void run_graph_nodes(void *arg, int begin, int end) {
+  graph_job_t *job = arg;
+  function_graph_t *g = job->graph;
+  int i; // Iterator
+
+  pthread_mutex_lock(&job->mutex);
+  for (;;) {
+    if (job->finished == g->num_of_nodes ||
+        (job->error != RT_RET_NOERROR && job->running == 0)) {
+      break;
+    }
+    if (job->error != RT_RET_NOERROR || job->head == job->tail) {
+      pthread_cond_wait(&job->changed, &job->mutex);
+      continue;
+    }
+    int node = g->ready[job->head++];
+    job->running++;
+    pthread_mutex_unlock(&job->mutex);
+    rt_return_value_t ret = job->run(job->arg, node);
+    pthread_mutex_lock(&job->mutex);
+    job->running--;
+    job->finished++;
+    if (ret != RT_RET_NOERROR) {
+      if (job->error == RT_RET_NOERROR) {
+        job->error = ret;
+      }
+    } else {
+      for (i = g->successor_offsets[node]; i < g->successor_offsets[node + 1];
+           i++) {
+        if (--g->remaining[g->successors[i]] == 0) {
+          g->ready[job->tail++] = g->successors[i];
+        }
+      }
+    }
+    pthread_cond_broadcast(&job->changed);
+  }
+  pthread_mutex_unlock(&job->mutex);
+}
+
+rt_return_value_t thread_pool_run_graph(void *p, function_graph_t *graph,
+                                        rt_return_value_t (*run)(void *arg,
+                                                                 int node),
+                                        void *arg) {
+  thread_pool_t *pool = p;
+  graph_job_t job;
+  int i; // Iterator
+
+  job.graph = graph;
+  job.run = run;
+  job.arg = arg;
+  job.head = 0;
+  job.tail = 0;
+  job.running = 0;
+  job.finished = 0;
+  job.error = RT_RET_NOERROR;
+  for (i = 0; i < graph->num_of_nodes; i++) {
+    graph->remaining[i] = graph->num_of_dependencies[i];
+    if (graph->remaining[i] == 0) {
+      graph->ready[job.tail++] = i;
+    }
+  }
+  pthread_mutex_init(&job.mutex, 0);
+  pthread_cond_init(&job.changed, 0);
+
+  thread_pool_parallel_for(pool, pool->num_of_threads, run_graph_nodes, &job);
+
+  pthread_cond_destroy(&job.changed);
+  pthread_mutex_destroy(&job.mutex);
+  return job.error;
+}
+
+#else /* NNABLART_USE_PTHREAD */
+
+void *create_thread_pool(int num_of_threads, const int *cpus,
+                         int num_of_cpus) {
+  return 0;
+}
+
+void destroy_thread_pool(void *pool) {}
+
+void thread_pool_parallel_for(void *pool, int size, rt_parallel_body_t body,
+                              void *arg) {
+  body(arg, 0, size);
+}
+
+rt_return_value_t thread_pool_run_graph(void *pool, function_graph_t *graph,
+                                        rt_return_value_t (*run)(void *arg,
+                                                                 int node),
+                                        void *arg) {
+  int i; // Iterator
+  // Dependencies always point to former functions.
+  for (i = 0; i < graph->num_of_nodes; i++) {
+    rt_return_value_t ret = run(arg, i);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  return RT_RET_NOERROR;
+}
+
+#endif /* NNABLART_USE_OPENMP */
@@ -0,0 +1,726 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <string.h>
+
+#include <nnablart/config.h>
+#include <nnablart/functions.h>
+#include <nnablart/network.h>
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Rows are the axis before the last one of 2D maps in channel first layout.
+ * Group of functions, each reading only output of former one, runs band by
+ * band of output rows of its last function. Band of each function is
+ * calculated by a copy of it without pad along rows, from input rows
+ * gathered from band of former function with zero outside of whole input.
+ * Band heights are fixed at initialization from receptive fields, and the
+ * last band is moved back to end at the last row. Functions with kernel 1
+ * and stride 1 along rows read band of former function as it is.
+ */
+
+/// Parameters of a function along rows.
+typedef struct {
+  int kernel;
+  int stride;
+  int dilation;
+  int pad;
+  size_t context_size; ///< Bytes of local context copied from function, or
+                       ///< 0 if copy is allocated from network.
+  size_t pad_offset;   ///< Offset of pad list in local context.
+  size_t data_offset;  ///< Offset of private data in local context.
+  rt_function_error_t (*allocate)(rt_function_t *f);
+  rt_function_error_t (*free)(rt_function_t *f);
+} tile_axis_t;
+
+rt_return_value_t rt_set_tiled_execution(rt_context_pointer context,
+                                         size_t cache_size) {
+  rt_context_t *c = context;
+  if (c->network != 0) {
+    return RT_RET_ERROR_INITIALIZE_CONTEXT_TWICE;
+  }
+  c->tile_cache_size = cache_size;
+  return RT_RET_NOERROR;
+}
+
+static nn_function_t *get_function(nn_network_t *n, int index) {
+  int *list = (int *)NN_GET(n, n->functions.list);
+  return (nn_function_t *)(NN_GET(n, list[index]));
+}
+
+static nn_variable_t *get_variable(nn_network_t *n, int index) {
+  int *list = (int *)NN_GET(n, n->variables.list);
+  return (nn_variable_t *)(NN_GET(n, list[index]));
+}
+
+static int is_in_list(rt_list_t list, int value) {
+  int i; // Iterator
+  for (i = 0; i < list.size; i++) {
+    if (list.data[i] == value) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int is_float(rt_context_t *c, int index) {
+  return index >= 0 && index < c->num_of_variables &&
+         c->variables[index].type == NN_DATA_TYPE_FLOAT &&
+         c->variables[index].layout == NN_DATA_LAYOUT_DENSE &&
+         !c->variables[index].quantization;
+}
+
+static int is_same_shape(const rt_variable_t *a, const rt_variable_t *b) {
+  return a->shape.size == b->shape.size &&
+         memcmp(a->shape.data, b->shape.data, sizeof(int) * a->shape.size) ==
+             0;
+}
+
+static int rows_of(const rt_variable_t *v) {
+  return v->shape.data[v->shape.size - 2];
+}
+
+static int last_dim(const rt_variable_t *v) {
+  return v->shape.data[v->shape.size - 1];
+}
+
+#if defined(CONFIG_CONVOLUTION) || defined(CONFIG_DEPTHWISECONVOLUTION) ||   \
+    defined(CONFIG_MAXPOOLING) || defined(CONFIG_AVERAGEPOOLING) ||          \
+    defined(CONFIG_SUMPOOLING)
+static int row_of(rt_list_t list, int value) {
+  return list.size >= 2 ? list.data[list.size - 2] : value;
+}
+#endif
+
+// Next function after i which is not removed by graph simplification, or
+// num_of_functions.
+static int next_live_function(rt_context_t *c, int i, int num_of_functions) {
+  for (i++; i < num_of_functions && is_removed_function(c, i); i++) {
+  }
+  return i;
+}
+
+// Last function merged into function k.
+static int merged_end(const function_fusion_t *fusion, int k) {
+  int end = k;
+  if (fusion->batch_normalization > end) {
+    end = fusion->batch_normalization;
+  }
+  if (fusion->activation > end) {
+    end = fusion->activation;
+  }
+  return end;
+}
+
+// Parameters along rows if function over 2D maps with channel first layout
+// can calculate a band of output rows by a copy of it. Element wise
+// functions have kernel 1 and their copies are allocated from network.
+static int get_tile_axis(nn_network_t *n, rt_context_t *c,
+                         nn_function_t *func, tile_axis_t *axis) {
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  const rt_variable_t *x = c->variables + inputs.data[0];
+  const rt_variable_t *y = c->variables + outputs.data[0];
+  int ndim = x->shape.size;
+
+  memset(axis, 0, sizeof(tile_axis_t));
+  axis->kernel = 1;
+  axis->stride = 1;
+  axis->dilation = 1;
+  if (ndim < 3 || y->shape.size != ndim) {
+    return 0;
+  }
+  switch (func->type) {
+#ifdef CONFIG_CONVOLUTION
+  case NN_FUNCTION_CONVOLUTION_0:
+  case NN_FUNCTION_CONVOLUTION: {
+    nn_function_convolution_t *conv = (nn_function_convolution_t *)func;
+    rt_list_t pad = create_rt_list_from_nn_list(n, conv->pad);
+    if ((func->type == NN_FUNCTION_CONVOLUTION && conv->channel_last) ||
+        pad.size != 2 || conv->base_axis != ndim - 3 || inputs.size < 2 ||
+        c->variables[inputs.data[1]].shape.size != 4) {
+      return 0;
+    }
+    axis->kernel = rows_of(c->variables + inputs.data[1]);
+    axis->stride = row_of(create_rt_list_from_nn_list(n, conv->stride), 1);
+    axis->dilation =
+        row_of(create_rt_list_from_nn_list(n, conv->dilation), 1);
+    axis->pad = pad.data[0];
+    axis->context_size = sizeof(convolution_local_context_t);
+    axis->pad_offset = offsetof(convolution_local_context_t, pad);
+    axis->data_offset = offsetof(convolution_local_context_t, data);
+    axis->allocate = allocate_convolution_local_context;
+    axis->free = free_convolution_local_context;
+    return 1;
+  }
+#endif /* CONFIG_CONVOLUTION */
+#ifdef CONFIG_DEPTHWISECONVOLUTION
+  case NN_FUNCTION_DEPTHWISE_CONVOLUTION: {
+    nn_function_depthwise_convolution_t *conv =
+        (nn_function_depthwise_convolution_t *)func;
+    rt_list_t pad = create_rt_list_from_nn_list(n, conv->pad);
+    if (pad.size != 2 || conv->base_axis != ndim - 3 || inputs.size < 2 ||
+        c->variables[inputs.data[1]].shape.size != 3) {
+      return 0;
+    }
+    axis->kernel = rows_of(c->variables + inputs.data[1]);
+    axis->stride = row_of(create_rt_list_from_nn_list(n, conv->stride), 1);
+    axis->dilation =
+        row_of(create_rt_list_from_nn_list(n, conv->dilation), 1);
+    axis->pad = pad.data[0];
+    axis->context_size = sizeof(depthwise_convolution_local_context_t);
+    axis->pad_offset = offsetof(depthwise_convolution_local_context_t, pad);
+    axis->data_offset = offsetof(depthwise_convolution_local_context_t, data);
+    axis->allocate = allocate_depthwise_convolution_local_context;
+    axis->free = free_depthwise_convolution_local_context;
+    return 1;
+  }
+#endif /* CONFIG_DEPTHWISECONVOLUTION */
+#ifdef CONFIG_MAXPOOLING
+  case NN_FUNCTION_MAX_POOLING: {
+    nn_function_max_pooling_t *pool = (nn_function_max_pooling_t *)func;
+    rt_list_t kernel = create_rt_list_from_nn_list(n, pool->kernel);
+    if (kernel.size != 2 || pool->channel_last) {
+      return 0;
+    }
+    axis->kernel = kernel.data[0];
+    axis->stride =
+        row_of(create_rt_list_from_nn_list(n, pool->stride), axis->kernel);
+    axis->pad = row_of(create_rt_list_from_nn_list(n, pool->pad), 0);
+    axis->context_size = sizeof(max_pooling_local_context_t);
+    axis->pad_offset = offsetof(max_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(max_pooling_local_context_t, data);
+    axis->allocate = allocate_max_pooling_local_context;
+    axis->free = free_max_pooling_local_context;
+    // Padded elements of pooling are not zero, so windows must be inside
+    // input.
+    return axis->pad == 0;
+  }
+#endif /* CONFIG_MAXPOOLING */
+#ifdef CONFIG_AVERAGEPOOLING
+  case NN_FUNCTION_AVERAGE_POOLING: {
+    nn_function_average_pooling_t *pool =
+        (nn_function_average_pooling_t *)func;
+    rt_list_t kernel = create_rt_list_from_nn_list(n, pool->kernel);
+    if (kernel.size != 2 || pool->channel_last) {
+      return 0;
+    }
+    axis->kernel = kernel.data[0];
+    axis->stride =
+        row_of(create_rt_list_from_nn_list(n, pool->stride), axis->kernel);
+    axis->pad = row_of(create_rt_list_from_nn_list(n, pool->pad), 0);
+    axis->context_size = sizeof(average_pooling_local_context_t);
+    axis->pad_offset = offsetof(average_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(average_pooling_local_context_t, data);
+    axis->allocate = allocate_average_pooling_local_context;
+    axis->free = free_average_pooling_local_context;
+    return axis->pad == 0;
+  }
+#endif /* CONFIG_AVERAGEPOOLING */
+#ifdef CONFIG_SUMPOOLING
+  case NN_FUNCTION_SUM_POOLING: {
+    nn_function_sum_pooling_t *pool = (nn_function_sum_pooling_t *)func;
+    rt_list_t kernel = create_rt_list_from_nn_list(n, pool->kernel);
+    if (kernel.size != 2 || pool->channel_last) {
+      return 0;
+    }
+    axis->kernel = kernel.data[0];
+    axis->stride =
+        row_of(create_rt_list_from_nn_list(n, pool->stride), axis->kernel);
+    axis->pad = row_of(create_rt_list_from_nn_list(n, pool->pad), 0);
+    axis->context_size = sizeof(sum_pooling_local_context_t);
+    axis->pad_offset = offsetof(sum_pooling_local_context_t, pad);
+    axis->data_offset = offsetof(sum_pooling_local_context_t, data);
+    axis->allocate = allocate_sum_pooling_local_context;
+    axis->free = free_sum_pooling_local_context;
+    return axis->pad == 0;
+  }
+#endif /* CONFIG_SUMPOOLING */
+  case NN_FUNCTION_BATCH_NORMALIZATION: {
+    // Inference mode normalizes each channel by its parameters.
+    rt_list_t axes = create_rt_list_from_nn_list(
+        n, ((nn_function_batch_normalization_t *)func)->axes);
+    return is_inplace_function(func) && axes.size == 1 &&
+           axes.data[0] == ndim - 3 && is_same_shape(x, y);
+  }
+  default:
+    return inputs.size == 1 && is_inplace_function(func) &&
+           !is_alias_function(func) && is_same_shape(x, y);
+  }
+}
+
+// Function k, with BatchNormalization and activation merged into it, as one
+// layer of tiled group. Returns variable written by the layer, or -1 if it
+// cannot be tiled. end is set to the last merged function.
+static int get_tile_layer(nn_network_t *n, rt_context_t *c,
+                          const function_fusion_t *fusions, int k, int *end,
+                          tile_axis_t *axis) {
+  nn_function_t *func = get_function(n, k);
+  const function_fusion_t *fusion = fusions + k;
+  rt_list_t inputs = create_rt_list_from_nn_list(n, func->inputs);
+  rt_list_t outputs = create_rt_list_from_nn_list(n, func->outputs);
+  int j; // Iterator
+
+  if (is_removed_function(c, k) || has_user_function(c, func) ||
+      fusion->skip || fusion->pooling >= 0 || fusion->chain >= 0 ||
+      fusion->pad >= 0 || fusion->mean_subtraction >= 0 ||
+      fusion->softmax >= 0 || fusion->transpose[0] >= 0 ||
+      fusion->transpose[1] >= 0 || fusion->view[0] >= 0 ||
+      fusion->view[1] >= 0 || inputs.size < 1 || outputs.size != 1 ||
+      !is_float(c, inputs.data[0]) || !is_float(c, outputs.data[0])) {
+    return -1;
+  }
+  // Other inputs are parameters, which every band reads whole.
+  for (j = 1; j < inputs.size; j++) {
+    if (!is_float(c, inputs.data[j]) ||
+        get_variable(n, inputs.data[j])->data_index < 0) {
+      return -1;
+    }
+  }
+  if (!get_tile_axis(n, c, func, axis)) {
+    return -1;
+  }
+  int in_rows = rows_of(c->variables + inputs.data[0]);
+  int out_rows = rows_of(c->variables + outputs.data[0]);
+  int reach = axis->dilation * (axis->kernel - 1);
+  // Pooling which does not ignore border has another output for remaining
+  // rows.
+  if (axis->kernel < 1 || axis->stride < 1 || axis->dilation < 1 ||
+      out_rows != (in_rows + 2 * axis->pad - reach - 1) / axis->stride + 1) {
+    return -1;
+  }
+  *end = merged_end(fusion, k);
+  return fusion->output >= 0 ? fusion->output : outputs.data[0];
+}
+
+int find_tiled_groups(nn_network_t *n, rt_context_t *c, const int *uses,
+                      function_fusion_t *fusions) {
+  int num_of_functions = n->functions.size;
+  rt_list_t net_inputs = create_rt_list_from_nn_list(n, n->inputs);
+  rt_list_t net_outputs = create_rt_list_from_nn_list(n, n->outputs);
+  int num_of_groups = 0;
+  int i = 0, k; // Iterator
+
+  // Last function writes output while bands are read from input of group,
+  // which planning keeps alive.
+  if (c->tile_cache_size == 0 ||
+      (!c->buffer_planning && !c->graph_simplification)) {
+    return 0;
+  }
+  while (i < num_of_functions) {
+    int layers = 0, spatial = 0, output = -1, last = -1, end;
+    tile_axis_t axis;
+    for (k = i; k < num_of_functions;
+         k = next_live_function(c, end, num_of_functions)) {
+      int y = get_tile_layer(n, c, fusions, k, &end, &axis);
+      if (y < 0) {
+        break;
+      }
+      if (layers > 0 &&
+          (create_rt_list_from_nn_list(n, get_function(n, k)->inputs)
+                   .data[0] != output ||
+           uses[output] != 1 || is_in_list(net_inputs, output) ||
+           is_in_list(net_outputs, output))) {
+        break;
+      }
+      spatial += axis.kernel > 1 || axis.stride > 1;
+      output = y;
+      last = k;
+      layers++;
+    }
+    if (layers >= 2 && spatial > 0) {
+      int j;
+      for (j = i; j < last; j = next_live_function(
+                                c, merged_end(fusions + j, j),
+                                num_of_functions)) {
+        fusions[j].skip = 1;
+      }
+      fusions[last].tile = i;
+      num_of_groups++;
+    }
+    i = layers > 0 ? k : i + 1;
+  }
+  return num_of_groups;
+}
+
+static void free_layer(tile_layer_t *layer) {
+  if (layer->func.local_context) {
+    if (layer->func.free_local_context_func) {
+      layer->func.free_local_context_func(&layer->func);
+    }
+    rt_free_func(layer->func.local_context);
+  }
+  rt_free_func(layer->pads);
+  rt_free_func(layer->func.inputs);
+  rt_free_func(layer->func.outputs);
+  rt_free_func(layer->input.shape.data);
+  rt_free_func(layer->output.shape.data);
+  variable_free(layer->input.data);
+  variable_free(layer->output.data);
+  memset(layer, 0, sizeof(tile_layer_t));
+}
+
+static rt_variable_t band_variable(const rt_variable_t *v, int rows,
+                                   int *ok) {
+  rt_variable_t band = *v;
+  band.shape.data = rt_malloc_func(sizeof(int) * v->shape.size);
+  band.data = 0;
+  if (band.shape.data == 0) {
+    *ok = 0;
+    return band;
+  }
+  memcpy(band.shape.data, v->shape.data, sizeof(int) * v->shape.size);
+  band.shape.data[v->shape.size - 2] = rows;
+  band.data = variable_malloc(calc_variable_data_size(&band));
+  if (band.data == 0) {
+    *ok = 0;
+  }
+  return band;
+}
+
+static size_t row_size(const rt_variable_t *v) {
+  return calc_variable_data_size(v) / rows_of(v);
+}
+
+static int input_rows(const tile_layer_t *layer) {
+  return (layer->rows - 1) * layer->stride +
+         layer->dilation * (layer->kernel - 1) + 1;
+}
+
+// Set band rows of each layer when the last one calculates rows, and return
+// bytes of their bands.
+static size_t plan_bands(rt_context_t *c, tiled_group_t *g, int rows) {
+  size_t size = 0;
+  int l; // Iterator
+
+  for (l = g->num_of_layers - 1; l >= 0; l--) {
+    tile_layer_t *layer = g->layers + l;
+    rt_function_t *f = &c->functions[layer->function].func;
+    layer->rows = rows;
+    size += rows * row_size(f->outputs[0]);
+    rows = input_rows(layer);
+    if (layer->gather) {
+      size += rows * row_size(f->inputs[0]);
+    }
+    if (rows > layer->in_rows) {
+      rows = layer->in_rows;
+    }
+  }
+  return size;
+}
+
+// Copy of function of layer l calculating its band.
+static rt_return_value_t allocate_layer(nn_network_t *n, rt_context_t *c,
+                                        tiled_group_t *g, int l) {
+  tile_layer_t *layer = g->layers + l;
+  rt_function_context_t *context = c->functions + layer->function;
+  rt_function_t *f = &context->func;
+  rt_function_error_t error;
+  tile_axis_t axis;
+  int ok = 1;
+
+  get_tile_axis(n, c, context->info, &axis);
+  if (layer->gather) {
+    layer->input = band_variable(f->inputs[0], input_rows(layer), &ok);
+  }
+  layer->output = band_variable(f->outputs[0], layer->rows, &ok);
+  layer->func.inputs =
+      rt_malloc_func(sizeof(rt_variable_t *) * f->num_of_inputs);
+  layer->func.outputs = rt_malloc_func(sizeof(rt_variable_t *));
+  if (!ok || layer->func.inputs == 0 || layer->func.outputs == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  layer->func.num_of_inputs = f->num_of_inputs;
+  layer->func.num_of_outputs = 1;
+  memcpy(layer->func.inputs, f->inputs,
+         sizeof(rt_variable_t *) * f->num_of_inputs);
+  layer->func.inputs[0] =
+      layer->gather ? &layer->input : &g->layers[l - 1].output;
+  layer->func.outputs[0] = &layer->output;
+
+  if (axis.context_size == 0) {
+    rt_function_context_t copy;
+    memset(&copy, 0, sizeof(copy));
+    copy.info = context->info;
+    copy.func = layer->func;
+    error = allocate_function_context(n, context->info, &copy);
+    layer->func = copy.func;
+  } else {
+    // Same parameters as function except pad along rows.
+    layer->func.local_context = rt_malloc_func(axis.context_size);
+    if (layer->func.local_context == 0) {
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    memcpy(layer->func.local_context, f->local_context, axis.context_size);
+    rt_list_t *pad = (rt_list_t *)((uint8_t *)layer->func.local_context +
+                                   axis.pad_offset);
+    layer->pads = rt_malloc_func(sizeof(int) * pad->size);
+    if (layer->pads == 0) {
+      // Local context refers private data of function.
+      rt_free_func(layer->func.local_context);
+      layer->func.local_context = 0;
+      return RT_RET_ERROR_ALLOCATE_CONTEXT;
+    }
+    memcpy(layer->pads, pad->data, sizeof(int) * pad->size);
+    layer->pads[pad->size - 2] = 0;
+    pad->data = layer->pads;
+    *(void **)((uint8_t *)layer->func.local_context + axis.data_offset) = 0;
+#ifdef CONFIG_DEPTHWISECONVOLUTION
+    if (context->info->type == NN_FUNCTION_DEPTHWISE_CONVOLUTION) {
+      // Allocation replaces multiplier by number of channels.
+      ((depthwise_convolution_local_context_t *)layer->func.local_context)
+          ->multiplier =
+          ((nn_function_depthwise_convolution_t *)context->info)->multiplier;
+    }
+#endif /* CONFIG_DEPTHWISECONVOLUTION */
+    layer->func.free_local_context_func = axis.free;
+    error = axis.allocate(&layer->func);
+  }
+  if (error == RT_FUNCTION_ERROR_MALLOC) {
+    // Free function does not know how far private data is allocated.
+    layer->func.free_local_context_func = 0;
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  if (error != RT_FUNCTION_ERROR_NOERROR || layer->func.exec_func == 0) {
+    return RT_RET_ERROR_NO_MATCHING_FUNCTION;
+  }
+  return set_merged_activation(n, c, layer->function, &layer->func);
+}
+
+// Input of group is appended to inputs of last function, so that dependency
+// graph keeps it until the group runs. Allocated local context does not read
+// it.
+static rt_return_value_t connect_tiled_input(rt_context_t *c, int i,
+                                             rt_variable_t *input) {
+  rt_function_t *f = &c->functions[i].func;
+  int k; // Iterator
+
+  rt_variable_t **inputs =
+      rt_malloc_func(sizeof(rt_variable_t *) * (f->num_of_inputs + 1));
+  if (inputs == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (k = 0; k < f->num_of_inputs; k++) {
+    inputs[k] = f->inputs[k];
+  }
+  inputs[k] = input;
+  rt_free_func(f->inputs);
+  f->inputs = inputs;
+  f->num_of_inputs++;
+  return RT_RET_NOERROR;
+}
+
+static rt_return_value_t add_tiled_group(nn_network_t *n, rt_context_t *c,
+                                         int i) {
+  const function_fusion_t *fusions = c->fusions;
+  tiled_group_t *g = c->tiles->groups + c->tiles->num_of_groups++;
+  int num_of_layers = 0;
+  int k, l; // Iterator
+
+  g->first = fusions[i].tile;
+  g->last = i;
+  g->num_of_layers = 0;
+  for (k = g->first; k < i;
+       k = next_live_function(c, merged_end(fusions + k, k),
+                              c->num_of_functions)) {
+    num_of_layers++;
+  }
+  g->layers = rt_malloc_func(sizeof(tile_layer_t) * (num_of_layers + 1));
+  if (g->layers == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  g->num_of_layers = num_of_layers + 1;
+  memset(g->layers, 0, sizeof(tile_layer_t) * g->num_of_layers);
+  for (k = g->first, l = 0; l < g->num_of_layers;
+       k = next_live_function(c, merged_end(fusions + k, k),
+                              c->num_of_functions),
+      l++) {
+    tile_layer_t *layer = g->layers + l;
+    rt_function_t *f = &c->functions[k].func;
+    tile_axis_t axis;
+    get_tile_axis(n, c, c->functions[k].info, &axis);
+    layer->function = k;
+    layer->kernel = axis.kernel;
+    layer->stride = axis.stride;
+    layer->dilation = axis.dilation;
+    layer->pad = axis.pad;
+    layer->in_rows = rows_of(f->inputs[0]);
+    layer->out_rows = rows_of(f->outputs[0]);
+    layer->gather =
+        l == 0 || axis.kernel != 1 || axis.stride != 1 || axis.pad != 0;
+  }
+
+  // The highest band whose layers fit cache.
+  tile_layer_t *last = g->layers + g->num_of_layers - 1;
+  int rows = last->out_rows;
+  while (rows > 1 && plan_bands(c, g, rows) > c->tile_cache_size) {
+    rows--;
+  }
+  plan_bands(c, g, rows);
+
+  for (l = 0; l < g->num_of_layers; l++) {
+    rt_return_value_t ret = allocate_layer(n, c, g, l);
+    if (ret != RT_RET_NOERROR) {
+      return ret;
+    }
+  }
+  rt_return_value_t ret =
+      connect_tiled_input(c, i, c->functions[g->first].func.inputs[0]);
+  if (ret != RT_RET_NOERROR) {
+    return ret;
+  }
+  c->tiles->index[i] = c->tiles->num_of_groups - 1;
+  return RT_RET_NOERROR;
+}
+
+rt_return_value_t build_tiled_execution(nn_network_t *n, rt_context_t *c) {
+  int num_of_groups = 0;
+  int i; // Iterator
+
+  c->tiles = 0;
+  if (c->fusions == 0) {
+    return RT_RET_NOERROR;
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    num_of_groups += c->fusions[i].tile >= 0;
+  }
+  if (num_of_groups == 0) {
+    return RT_RET_NOERROR;
+  }
+  c->tiles = rt_malloc_func(sizeof(tiled_execution_t));
+  if (c->tiles == 0) {
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  c->tiles->num_of_groups = 0;
+  c->tiles->groups = rt_malloc_func(sizeof(tiled_group_t) * num_of_groups);
+  c->tiles->index = rt_malloc_func(sizeof(int) * c->num_of_functions);
+  if (c->tiles->groups == 0 || c->tiles->index == 0) {
+    free_tiled_execution(c);
+    return RT_RET_ERROR_ALLOCATE_CONTEXT;
+  }
+  for (i = 0; i < c->num_of_functions; i++) {
+    c->tiles->index[i] = -1;
+  }
+
+  rt_math_mode_t previous_mode =
+      rt_set_math_mode(c->fast_math ? RT_MATH_MODE_FAST : RT_MATH_MODE_EXACT);
+  rt_return_value_t ret = RT_RET_NOERROR;
+  for (i = 0; i < c->num_of_functions && ret == RT_RET_NOERROR; i++) {
+    if (c->fusions[i].tile >= 0) {
+      ret = add_tiled_group(n, c, i);
+    }
+  }
+  rt_set_math_mode(previous_mode);
+  return ret;
+}
+
+// Copy input rows of band of layer, zero outside of whole input, from rows
+// [first, first + rows) of x which has them.
+static void gather_rows(const tile_layer_t *layer, const float *x, int first,
+                        int rows) {
+  const rt_variable_t *v = &layer->input;
+  int width = last_dim(v);
+  int band = rows_of(v);
+  int planes =
+      (int)(calc_variable_data_size(v) / sizeof(float) / band / width);
+  int start = layer->first * layer->stride - layer->pad;
+  int begin = start < 0 ? -start : 0;
+  int end = layer->in_rows - start < band ? layer->in_rows - start : band;
+  int p; // Iterator
+
+  for (p = 0; p < planes; p++) {
+    float *dst = (float *)v->data + (size_t)p * band * width;
+    const float *src =
+        x + ((size_t)p * rows + (start + begin - first)) * width;
+    memset(dst, 0, sizeof(float) * begin * width);
+    memcpy(dst + (size_t)begin * width, src,
+           sizeof(float) * (end - begin) * width);
+    memset(dst + (size_t)end * width, 0, sizeof(float) * (band - end) * width);
+  }
+}
+
+// Copy band of output rows of layer into whole output y.
+static void scatter_rows(const tile_layer_t *layer, float *y) {
+  const rt_variable_t *v = &layer->output;
+  int width = last_dim(v);
+  int planes = (int)(calc_variable_data_size(v) / sizeof(float) /
+                     layer->rows / width);
+  int p; // Iterator
+
+  for (p = 0; p < planes; p++) {
+    memcpy(y + ((size_t)p * layer->out_rows + layer->first) * width,
+           (const float *)v->data + (size_t)p * layer->rows * width,
+           sizeof(float) * layer->rows * width);
+  }
+}
+
+rt_function_error_t exec_tiled_group(rt_context_t *c, int i) {
+  tiled_group_t *g = c->tiles->groups + c->tiles->index[i];
+  tile_layer_t *last = g->layers + g->num_of_layers - 1;
+  const float *x = (const float *)c->functions[g->first].func.inputs[0]->data;
+  float *y = (float *)c->functions[i].func.outputs[0]->data;
+  int first, l; // Iterator
+
+  for (first = 0; first < last->out_rows; first += last->rows) {
+    last->first = first + last->rows > last->out_rows
+                      ? last->out_rows - last->rows
+                      : first;
+    // Bands of former layers which the band of next one reads.
+    for (l = g->num_of_layers - 1; l > 0; l--) {
+      tile_layer_t *layer = g->layers + l;
+      int start = layer->first * layer->stride - layer->pad;
+      int limit = layer->in_rows - layer[-1].rows;
+      layer[-1].first = start < 0 ? 0 : start > limit ? limit : start;
+    }
+    for (l = 0; l < g->num_of_layers; l++) {
+      tile_layer_t *layer = g->layers + l;
+      if (layer->gather) {
+        if (l == 0) {
+          gather_rows(layer, x, 0, layer->in_rows);
+        } else {
+          gather_rows(layer, (const float *)layer[-1].output.data,
+                      layer[-1].first, layer[-1].rows);
+        }
+      }
+      rt_function_error_t ret = layer->func.exec_func(&layer->func);
+      if (ret != RT_FUNCTION_ERROR_NOERROR) {
+        return ret;
+      }
+    }
+    scatter_rows(last, y);
+  }
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+void free_tiled_execution(rt_context_t *c) {
+  int i, l; // Iterator
+
+  if (c->tiles == 0) {
+    return;
+  }
+  for (i = 0; i < c->tiles->num_of_groups; i++) {
+    tiled_group_t *g = c->tiles->groups + i;
+    for (l = 0; l < g->num_of_layers; l++) {
+      free_layer(g->layers + l);
+    }
+    rt_free_func(g->layers);
+  }
+  rt_free_func(c->tiles->groups);
+  rt_free_func(c->tiles->index);
+  rt_free_func(c->tiles);
+  c->tiles = 0;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Sony Corporation. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <nnablart/runtime.h>
+
+#include "runtime_internal.h"
+
+/*
+ * Functions of a context record copies of weights they make, e.g. packed
+ * panels or Winograd kernels. Functions of its clone find them by data of
+ * weight, which is the same for both as parameters and folded weights are
+ * shared too, and use them instead of their own. Copies stay owned by the
+ * source, which outlives its clones.
+ */
+
+static weight_copy_t *find_copy(rt_context_t *c, const void *copy) {
+  int i; // Iterator
+  for (i = 0; i < c->weight_copies.size; i++) {
+    if (c->weight_copies.list[i].copy == copy) {
+      return c->weight_copies.list + i;
+    }
+  }
+  return 0;
+}
+
+static void *find(void *arg, const void *weight, int layout, size_t size) {
+  rt_context_t *s = ((rt_context_t *)arg)->source;
+  int i; // Iterator
+
+  for (i = 0; s && i < s->weight_copies.size; i++) {
+    weight_copy_t *w = s->weight_copies.list + i;
+    if (w->weight == weight && w->layout == layout && w->size == size) {
+      return w->copy;
+    }
+  }
+  return 0;
+}
+
+static void add(void *arg, const void *weight, int layout, size_t size,
+                void *copy) {
+  rt_context_t *c = (rt_context_t *)arg;
+  weight_copies_t *w = &c->weight_copies;
+
+  if (w->size == w->capacity) {
+    // Copy which cannot be recorded is used only by its function.
+    int capacity = w->capacity ? w->capacity * 2 : 16;
+    weight_copy_t *list = rt_malloc_func(sizeof(weight_copy_t) * capacity);
+    if (list == 0) {
+      return;
+    }
+    if (w->list) {
+      memcpy(list, w->list, sizeof(weight_copy_t) * w->size);
+      rt_free_func(w->list);
+    }
+    w->list = list;
+    w->capacity = capacity;
+  }
+  w->list[w->size].weight = weight;
+  w->list[w->size].layout = layout;
+  w->list[w->size].size = size;
+  w->list[w->size].copy = copy;
+  w->size++;
+}
+
+static int release(void *arg, void *copy) {
+  rt_context_t *c = (rt_context_t *)arg;
+  weight_copy_t *w;
+
+  if (c->source && find_copy(c->source, copy)) {
+    return 1;
+  }
+  w = find_copy(c, copy);
+  if (w) {
+    *w = c->weight_copies.list[--c->weight_copies.size];
+  }
+  return 0;
+}
+
+const rt_weight_copies_t *get_weight_copies(rt_context_t *c) {
+  c->weight_copies.store.find = find;
+  c->weight_copies.store.add = add;
+  c->weight_copies.store.release = release;
+  c->weight_copies.store.arg = c;
+  return &c->weight_copies.store;
+}
+
+void free_weight_copies(rt_context_t *c) {
+  if (c->weight_copies.list) {
+    rt_free_func(c->weight_copies.list);
+  }
+  c->weight_copies.list = 0;
+  c->weight_copies.size = 0;
+  c->weight_copies.capacity = 0;
+}